@@ -49,8 +49,10 @@
 #include "ros/message_event.h"
 #include "ros/serialization.h"
 
+#include <functional>
 #include <ios>
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
 #include <stdexcept>
@@ -111,6 +113,30 @@ public:
     void                                        setChunkThreshold(uint32_t chunk_threshold);  //!< Set the threshold for creating new chunks
     uint32_t                                    getChunkThreshold() const;                    //!< Get the threshold for creating new chunks
 
+    //! A finished chunk whose compression and writing is left to the caller, see setDeferredChunkCallback()
+    struct DeferredChunk {
+        ChunkInfo                                     info;                //!< pos is only known once the chunk is written
+        std::map<uint32_t, std::multiset<IndexEntry>> connection_indexes;  //!< message offsets within the uncompressed data
+        CompressionType                               compression;
+        Buffer                                        data;             //!< uncompressed chunk records
+        Buffer                                        compressed_data;  //!< filled by compressDeferredChunk()
+    };
+    typedef std::function<void(std::shared_ptr<DeferredChunk>)> DeferredChunkCallback;
+
+    //! Hand finished chunks to a callback instead of compressing and writing them inside write()
+    /*!
+     * In this mode write() only serializes the messages into the open chunk. The callback receives each chunk once it passes the chunk
+     * threshold; the caller compresses it (from any thread) and hands it back to writeDeferredChunk() in the order the chunks were received.
+     * The chunk still open when the bag is closed is compressed and written by close(), after the chunks handed out before.
+     */
+    void setDeferredChunkCallback(DeferredChunkCallback callback);
+
+    //! Compress the data of a deferred chunk, thread-safe. Supports uncompressed and LZ4 chunks.
+    static void compressDeferredChunk(DeferredChunk &chunk);
+
+    //! Append a compressed deferred chunk and its index records to the bag file
+    void writeDeferredChunk(DeferredChunk const &chunk);
+
     //! Write a message into the bag file
     /*!
      * \param topic The topic name
@@ -185,12 +211,13 @@ private:
     void                    writeConnectionRecord(ConnectionInfo const *connection_info);
     void                    appendConnectionRecordToBuffer(Buffer &buf, ConnectionInfo const *connection_info);
     template <class T> void writeMessageDataRecord(uint32_t conn_id, orbbecRosbag::Time const &time, T const &msg);
-    void                    writeIndexRecords();
+    void                    writeIndexRecords(std::map<uint32_t, std::multiset<IndexEntry>> const &indexes);
     void                    writeConnectionRecords();
     void                    writeChunkInfoRecords();
     void                    startWritingChunk(orbbecRosbag::Time time);
     void                    writeChunkHeader(CompressionType compression, uint32_t compressed_size, uint32_t uncompressed_size);
     void                    stopWritingChunk();
+    std::shared_ptr<DeferredChunk> takeDeferredChunk();
 
     // Reading
 
@@ -291,6 +318,8 @@ private:
 
     mutable Buffer *current_buffer_;
 
+    DeferredChunkCallback deferred_chunk_callback_;  //!< set in deferred chunk mode, see setDeferredChunkCallback()
+
     mutable uint64_t decompressed_chunk_;  //!< position of decompressed chunk
 };
 
@@ -490,8 +519,10 @@ void Bag::doWrite(std::string const &topic, orbbecRosbag::Time const &time, T co
 
     {
         // Seek to the end of the file (needed in case previous operation was a read)
-        seek(0, std::ios::end);
-        file_size_ = file_.getOffset();
+        if(!deferred_chunk_callback_) {
+            seek(0, std::ios::end);
+            file_size_ = file_.getOffset();
+        }
 
         // Write the chunk header if we're starting a new chunk
         if(!chunk_open_)
@@ -516,7 +547,8 @@ void Bag::doWrite(std::string const &topic, orbbecRosbag::Time const &time, T co
             }
             connections_[conn_id] = connection_info;
 
-            writeConnectionRecord(connection_info);
+            if(!deferred_chunk_callback_)
+                writeConnectionRecord(connection_info);
             appendConnectionRecordToBuffer(outgoing_chunk_buffer_, connection_info);
         }
 
@@ -528,8 +560,11 @@ void Bag::doWrite(std::string const &topic, orbbecRosbag::Time const &time, T co
 
         std::multiset<IndexEntry> &chunk_connection_index = curr_chunk_connection_indexes_[connection_info->id];
         chunk_connection_index.insert(chunk_connection_index.end(), index_entry);
-        std::multiset<IndexEntry> &connection_index = connection_indexes_[connection_info->id];
-        connection_index.insert(connection_index.end(), index_entry);
+        if(!deferred_chunk_callback_) {
+            // Deferred chunks are added to the connection indexes once their position is known, see writeDeferredChunk()
+            std::multiset<IndexEntry> &connection_index = connection_indexes_[connection_info->id];
+            connection_index.insert(connection_index.end(), index_entry);
+        }
 
         // Increment the connection count
         curr_chunk_info_.connection_counts[connection_info->id]++;
@@ -560,6 +595,23 @@ template <class T> void Bag::writeMessageDataRecord(uint32_t conn_id, orbbecRosb
     // Assemble message in memory first, because we need to write its length
     uint32_t msg_ser_len = orbbecRosbag::serialization::serializationLength(msg);
 
+    if(deferred_chunk_callback_) {
+        // Nothing goes to the file before the chunk is finished, serialize straight into the outgoing chunk
+        appendHeaderToBuffer(outgoing_chunk_buffer_, header);
+        appendDataLengthToBuffer(outgoing_chunk_buffer_, msg_ser_len);
+
+        uint32_t offset = outgoing_chunk_buffer_.getSize();
+        outgoing_chunk_buffer_.setSize(offset + msg_ser_len);
+        orbbecRosbag::serialization::OStream s(outgoing_chunk_buffer_.getData() + offset, msg_ser_len);
+        orbbecRosbag::serialization::serialize(s, msg);
+
+        if(time > curr_chunk_info_.end_time)
+            curr_chunk_info_.end_time = time;
+        else if(time < curr_chunk_info_.start_time)
+            curr_chunk_info_.start_time = time;
+        return;
+    }
+
     record_buffer_.setSize(msg_ser_len);
 
     orbbecRosbag::serialization::OStream s(record_buffer_.getData(), msg_ser_len);
@@ -46,11 +46,13 @@ public:
     Buffer();
     ~Buffer();
 
-    uint8_t* getData();
+    uint8_t*       getData();
+    uint8_t const* getData() const;
     uint32_t getCapacity() const;
     uint32_t getSize()     const;
 
     void setSize(uint32_t size);
+    void swap(Buffer& other);  //!< exchange the contents, without copying the data
 
 private:
     void ensureCapacity(uint32_t capacity);
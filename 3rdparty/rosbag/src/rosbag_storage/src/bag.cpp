@@ -295,8 +295,17 @@ void Bag::startWriting() {
 }
 
 void Bag::stopWriting() {
-    if(chunk_open_)
-        stopWritingChunk();
+    if(chunk_open_) {
+        if(deferred_chunk_callback_) {
+            // The chunks handed out before are written by now, finish the last one here
+            std::shared_ptr<DeferredChunk> chunk = takeDeferredChunk();
+            compressDeferredChunk(*chunk);
+            writeDeferredChunk(*chunk);
+        }
+        else {
+            stopWritingChunk();
+        }
+    }
 
     seek(0, std::ios::end);
 
@@ -441,7 +450,9 @@ void Bag::readFileHeaderRecord() {
 }
 
 uint32_t Bag::getChunkOffset() const {
-    if(compression_ == compression::Uncompressed)
+    if(deferred_chunk_callback_)
+        return outgoing_chunk_buffer_.getSize();
+    else if(compression_ == compression::Uncompressed)
         return static_cast<uint32_t>(file_.getOffset() - curr_chunk_data_pos_);
     else
         return file_.getCompressedBytesIn();
@@ -453,6 +464,13 @@ void Bag::startWritingChunk(Time time) {
     curr_chunk_info_.start_time = time;
     curr_chunk_info_.end_time   = time;
 
+    if(deferred_chunk_callback_) {
+        // The chunk is only assembled in outgoing_chunk_buffer_, its position is set by writeDeferredChunk()
+        curr_chunk_info_.pos = 0;
+        chunk_open_          = true;
+        return;
+    }
+
     // Write the chunk header, with a place-holder for the data sizes (we'll fill in when the chunk is finished)
     writeChunkHeader(compression_, 0, 0);
 
@@ -466,6 +484,11 @@ void Bag::startWritingChunk(Time time) {
 }
 
 void Bag::stopWritingChunk() {
+    if(deferred_chunk_callback_) {
+        deferred_chunk_callback_(takeDeferredChunk());
+        return;
+    }
+
     // Add this chunk to the index
     chunks_.push_back(curr_chunk_info_);
 
@@ -482,7 +505,7 @@ void Bag::stopWritingChunk() {
 
     // Write out the indexes and clear them
     seek(end_of_chunk_pos);
-    writeIndexRecords();
+    writeIndexRecords(curr_chunk_connection_indexes_);
     curr_chunk_connection_indexes_.clear();
 
     // Clear the connection counts
@@ -492,6 +515,76 @@ void Bag::stopWritingChunk() {
     chunk_open_ = false;
 }
 
+shared_ptr<Bag::DeferredChunk> Bag::takeDeferredChunk() {
+    shared_ptr<DeferredChunk> chunk = std::make_shared<DeferredChunk>();
+    chunk->info                     = curr_chunk_info_;
+    chunk->compression              = compression_;
+    chunk->connection_indexes.swap(curr_chunk_connection_indexes_);
+    chunk->data.swap(outgoing_chunk_buffer_);
+
+    curr_chunk_info_.connection_counts.clear();
+    chunk_open_ = false;
+
+    return chunk;
+}
+
+void Bag::setDeferredChunkCallback(DeferredChunkCallback callback) {
+    if(file_.isOpen() && chunk_open_)
+        stopWritingChunk();
+
+    deferred_chunk_callback_ = callback;
+}
+
+void Bag::compressDeferredChunk(DeferredChunk &chunk) {
+    switch(chunk.compression) {
+    case compression::Uncompressed:
+        break;
+    case compression::LZ4: {
+        // Same frame layout as LZ4Stream (block size id 6), start with room for incompressible data and grow if needed
+        unsigned int input_size = chunk.data.getSize();
+        unsigned int capacity   = input_size + input_size / 255 + 1024;
+        for(;;) {
+            chunk.compressed_data.setSize(capacity);
+            unsigned int output_size = capacity;
+            int ret = roslz4_buffToBuffCompress((char *)chunk.data.getData(), input_size, (char *)chunk.compressed_data.getData(), &output_size, 6);
+            if(ret == ROSLZ4_OK) {
+                chunk.compressed_data.setSize(output_size);
+                break;
+            }
+            if(ret != ROSLZ4_OUTPUT_SMALL)
+                throw BagException("Error compressing chunk: " + std::to_string(ret));
+            capacity *= 2;
+        }
+        break;
+    }
+    default:
+        throw BagException("Unsupported compression of a deferred chunk: " + std::to_string((int)chunk.compression));
+    }
+}
+
+void Bag::writeDeferredChunk(DeferredChunk const &chunk) {
+    seek(0, std::ios::end);
+
+    ChunkInfo chunk_info = chunk.info;
+    chunk_info.pos       = file_.getOffset();
+
+    Buffer const &data = chunk.compression == compression::Uncompressed ? chunk.data : chunk.compressed_data;
+    writeChunkHeader(chunk.compression, data.getSize(), chunk.data.getSize());
+    write((char const *)data.getData(), data.getSize());
+    writeIndexRecords(chunk.connection_indexes);
+
+    chunks_.push_back(chunk_info);
+    for(map<uint32_t, multiset<IndexEntry>>::const_iterator i = chunk.connection_indexes.begin(); i != chunk.connection_indexes.end(); i++) {
+        multiset<IndexEntry> &connection_index = connection_indexes_[i->first];
+        for(IndexEntry entry: i->second) {
+            entry.chunk_pos = chunk_info.pos;
+            connection_index.insert(connection_index.end(), entry);
+        }
+    }
+
+    file_size_ = file_.getOffset();
+}
+
 void Bag::writeChunkHeader(CompressionType compression, uint32_t compressed_size, uint32_t uncompressed_size) {
     ChunkHeader chunk_header;
     switch(compression) {
@@ -539,8 +632,8 @@ void Bag::readChunkHeader(ChunkHeader &chunk_header) const {
 
 // Index records
 
-void Bag::writeIndexRecords() {
-    for(map<uint32_t, multiset<IndexEntry>>::const_iterator i = curr_chunk_connection_indexes_.begin(); i != curr_chunk_connection_indexes_.end(); i++) {
+void Bag::writeIndexRecords(map<uint32_t, multiset<IndexEntry>> const &indexes) {
+    for(map<uint32_t, multiset<IndexEntry>>::const_iterator i = indexes.begin(); i != indexes.end(); i++) {
         uint32_t                    connection_id = i->first;
         multiset<IndexEntry> const &index         = i->second;
 
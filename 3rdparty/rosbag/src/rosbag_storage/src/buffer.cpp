@@ -34,6 +34,7 @@
 
 #include <stdlib.h>
 #include <assert.h>
+#include <utility>
 
 #include "rosbag/buffer.h"
 
@@ -48,6 +49,7 @@ Buffer::~Buffer() {
 }
 
 uint8_t* Buffer::getData()           { return buffer_;   }
+uint8_t const* Buffer::getData() const { return buffer_; }
 uint32_t Buffer::getCapacity() const { return capacity_; }
 uint32_t Buffer::getSize()     const { return size_;     }
 
@@ -56,6 +58,12 @@ void Buffer::setSize(uint32_t size) {
     ensureCapacity(size);
 }
 
+void Buffer::swap(Buffer& other) {
+    std::swap(buffer_, other.buffer_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+}
+
 void Buffer::ensureCapacity(uint32_t capacity) {
     if (capacity <= capacity_)
         return;
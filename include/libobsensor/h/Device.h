@@ -998,6 +998,28 @@ OB_EXPORT ob_device *ob_device_list_get_device_by_uid(const ob_device_list *list
  */
 OB_EXPORT ob_device *ob_device_list_get_device_by_uid_ex(const ob_device_list *list, const char *uid, ob_device_access_mode accessMode, ob_error **error);
 
+/**
+ * @brief Create several devices of the device list in parallel.
+ * @brief The devices are initialized at the same time, opening N devices takes about the time of the slowest device instead of the sum of them.
+ *
+ * @attention If a device has already been acquired and created elsewhere, its error is set in device_errors, as ob_device_list_get_device_ex() would
+ * return it.
+ *
+ * @param[in] list Device list object.
+ * @param[in] indices The indices of the devices to create, an array of count elements.
+ * @param[in] count The number of devices to create.
+ * @param[in] accessMode Device access mode of all the devices. @ref ob_device_access_mode.
+ * @param[in] max_parallel The maximum number of devices initialized at the same time, 0 to initialize all of them at the same time.
+ * @param[out] devices An array of count elements, set to the created devices (NULL for the devices that failed). Delete them with ob_delete_device().
+ * @param[out] device_errors An array of count elements, set to the errors of the devices (NULL for the created devices). Delete them with
+ * ob_delete_error(). NULL to ignore the errors.
+ * @param[out] error Pointer to an error object that will be set if an error occurs (invalid parameters), the devices are not created then.
+ *
+ * @return uint32_t The number of created devices.
+ */
+OB_EXPORT uint32_t ob_device_list_get_devices(const ob_device_list *list, const uint32_t *indices, uint32_t count, ob_device_access_mode accessMode,
+                                              uint32_t max_parallel, ob_device **devices, ob_error **device_errors, ob_error **error);
+
 /**
  * @brief Get the original parameter list of camera calibration saved on the device.
  *
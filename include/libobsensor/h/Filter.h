@@ -191,6 +191,21 @@ OB_EXPORT bool ob_filter_is_enabled(const ob_filter *filter, ob_error **error);
  */
 OB_EXPORT ob_frame *ob_filter_process(ob_filter *filter, const ob_frame *frame, ob_error **error);
 
+/**
+ * @brief Process the frame by several filters one after the other (synchronous interface), the disabled filters are skipped.
+ * @brief The frames created by the filters are only held by this function until it returns, so the filters changing the pixel values in place (threshold,
+ * pixel value scaler and offset, mirror, flip) update them instead of creating a new frame.
+ * @brief Several of these filters in a row on a Y16 depth frame run in a single pass over the frame, with the same result.
+ *
+ * @param[in] filters The filter objects, in processing order.
+ * @param[in] filter_count The number of filters.
+ * @param[in] frame Pointer to the frame object to be processed, it is not modified.
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ *
+ * @return The frame object processed by the filters, NULL if a filter returned no frame.
+ */
+OB_EXPORT ob_frame *ob_filter_chain_process(ob_filter **filters, uint32_t filter_count, const ob_frame *frame, ob_error **error);
+
 /**
  * @brief Set the processing result callback function for the filter (asynchronous callback interface).
  *
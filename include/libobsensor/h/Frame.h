@@ -255,6 +255,8 @@ OB_EXPORT uint64_t ob_frame_get_global_timestamp_us(const ob_frame *frame, ob_er
  *
  * @attention The returned data buffer is mutable, but it is not recommended to modify it directly. Modifying the data directly may cause issues if the frame is
  * being used in other threads  or future use. If you need to modify the data, it is recommended to create a new frame object.
+ * @attention The frames passed through unchanged by the filters may share the data buffer of their input frame, use @ref ob_frame_update_data to replace
+ * the data of such a frame.
  *
  * @param[in] frame The frame object from which to retrieve the data.
  * @param[out] error Pointer to an error object that will be set if an error occurs.
@@ -353,6 +355,19 @@ OB_EXPORT bool ob_frame_has_metadata(const ob_frame *frame, ob_frame_metadata_ty
  */
 OB_EXPORT int64_t ob_frame_get_metadata_value(const ob_frame *frame, ob_frame_metadata_type type, ob_error **error);
 
+/**
+ * @brief Get the values of all metadata types of the frame at once
+ * @brief The metadata is parsed once per frame and type, later queries of the same type on the frame are served from a cache.
+ *
+ * @param[in] frame frame object
+ * @param[out] values The metadata values indexed by metadata type, 0 for the types the frame does not contain
+ * @param[in] count The number of elements of values, OB_FRAME_METADATA_TYPE_COUNT for all types
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ *
+ * @return uint64_t The mask of the metadata types the frame contains: bit n is set if the frame contains type n
+ */
+OB_EXPORT uint64_t ob_frame_get_all_metadata_value(const ob_frame *frame, int64_t *values, uint32_t count, ob_error **error);
+
 /**
  * @brief Get the stream profile of the frame
  *
@@ -562,6 +577,16 @@ OB_EXPORT ob_gyro_value ob_gyro_frame_get_value(const ob_frame *frame, ob_error
  */
 OB_EXPORT float ob_gyro_frame_get_temperature(const ob_frame *frame, ob_error **error);
 
+/**
+ * @brief Get the samples of an IMU batch frame.
+ *
+ * @param[in] frame IMU batch frame (@ref OB_FRAME_IMU_BATCH), as delivered by @ref ob_sensor_start_batched.
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ *
+ * @return ob_imu_batch_data Return the sample arrays, valid until the frame is deleted.
+ */
+OB_EXPORT ob_imu_batch_data ob_imu_batch_frame_get_data(const ob_frame *frame, ob_error **error);
+
 /**
  * @brief Get the number of frames contained in the frameset
  *
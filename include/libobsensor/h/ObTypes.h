@@ -239,6 +239,7 @@ typedef enum {
     OB_FRAME_LIDAR_POINTS = 12, /**< LiDAR point3d cloud frame*/
     OB_FRAME_COLOR_LEFT   = 13, /**< Left Color frame */
     OB_FRAME_COLOR_RIGHT  = 14, /**< Right Color frame */
+    OB_FRAME_IMU_BATCH    = 15, /**< Batch of accelerometer or gyroscope samples, see @ref OBImuBatchData */
     OB_FRAME_TYPE_COUNT,        /**< The total number of frame types, is not a valid frame type */
 } OBFrameType,
     ob_frame_type;
@@ -299,6 +300,8 @@ typedef enum {
     OB_FORMAT_LIDAR_SPHERE_POINT = 36, /**< Spherical coordinate point format with LiDAR information, @ref OBLiDARSpherePoint */
     OB_FORMAT_LIDAR_SCAN         = 37, /**< LiDAR single-line scan mode data format, @ref OBLiDARScanPoint */
     OB_FORMAT_LIDAR_CALIBRATION  = 38, /**< LiDAR calibration mode point format */
+    OB_FORMAT_POINT_SOA_F16      = 39, /**< XYZ 3D coordinate points as planes of 16-bit half floats: all x, then all y, then all z */
+    OB_FORMAT_RGB_POINT_SOA_F16  = 40, /**< XYZ 3D coordinate points with RGB as planes of 16-bit half floats: x, y, z, r, g, b */
 } OBFormat,
     ob_format;
 
@@ -720,6 +723,19 @@ typedef struct {
     float z;  ///< Z-direction component
 } OBAccelValue, OBGyroValue, OBFloat3D, ob_accel_value, ob_gyro_value, ob_float_3d;
 
+/**
+ * @brief Samples of an IMU batch frame (@ref OB_FRAME_IMU_BATCH) in struct-of-arrays layout
+ * @brief The arrays belong to the frame and stay valid as long as the frame is not released.
+ */
+typedef struct {
+    uint32_t        count;        ///< Number of samples
+    const uint64_t *timestamp;    ///< Device timestamp of each sample, unit: microsecond
+    const float    *x;            ///< X-direction component of each sample, unit: g for accelerometer batches, dps for gyroscope batches
+    const float    *y;            ///< Y-direction component of each sample
+    const float    *z;            ///< Z-direction component of each sample
+    const float    *temperature;  ///< Temperature of each sample, unit: Celsius
+} OBImuBatchData, ob_imu_batch_data;
+
 /**
  * @brief Data structures for LiDAR scan rate
  */
@@ -1442,6 +1458,25 @@ typedef enum {
     OBFrameAggregateOutputMode, ob_frame_aggregate_output_mode;
 #define OB_FRAME_AGGREGATE_OUTPUT_FULL_FRAME_REQUIRE OB_FRAME_AGGREGATE_OUTPUT_ALL_TYPE_FRAME_REQUIRE
 
+/**
+ * @brief Frame aggregate engine, the implementation used by the pipeline to match the frames of the enabled streams into framesets
+ */
+typedef enum {
+    /**
+     * @brief Frames are matched on the capture thread that delivers them, all capture threads share the aggregator lock (default)
+     */
+    OB_FRAME_AGGREGATE_ENGINE_DEFAULT = 0,
+
+    /**
+     * @brief Each stream is pushed into its own lock-free queue and the frames are matched on a dedicated thread
+     * @brief Capture threads never block on each other, suitable for multi-stream configurations with high frame rate streams (e.g. IMU)
+     *
+     * @attention In this mode, the frameset callback is invoked on the matching thread instead of the capture threads
+     */
+    OB_FRAME_AGGREGATE_ENGINE_LOCK_FREE = 1,
+} OB_FRAME_AGGREGATE_ENGINE,
+    OBFrameAggregateEngine, ob_frame_aggregate_engine;
+
 /**
  * @brief Enumeration of point cloud coordinate system types
  */
@@ -2017,6 +2052,20 @@ typedef enum {
 } ob_playback_status,
     OBPlaybackStatus;
 
+/**
+ * @brief Statistics of a recording device, to watch the file writer keep up with the streams
+ */
+typedef struct {
+    uint32_t queueDepth;      ///< Frames waiting in the staging queue to be written
+    uint32_t queueCapacity;   ///< Maximum number of frames in the staging queue
+    uint64_t queuedBytes;     ///< Data size of the frames waiting in the staging queue, in bytes
+    uint64_t framesWritten;   ///< Frames written to the file
+    uint64_t framesDropped;   ///< Frames dropped because the staging queue was full
+    uint64_t bytesWritten;    ///< Size of the file written so far, after compression, in bytes
+    double   bytesPerSecond;  ///< File write rate in bytes per second, refreshed at most once per second by this call
+    uint32_t pendingChunks;   ///< File chunks waiting to be compressed or written
+} OBRecordStats, ob_record_stats;
+
 /**
  * @brief Intra-camera Sync Reference based on the exposure start time, the exposure middle time, or the exposure end time.
  */
@@ -327,6 +327,29 @@ OB_EXPORT void ob_config_set_depth_scale_after_align_require(ob_config *config,
  */
 OB_EXPORT void ob_config_set_frame_aggregate_output_mode(ob_config *config, ob_frame_aggregate_output_mode mode, ob_error **error);
 
+/**
+ * @brief Set whether to pre-allocate the frame buffers of the enabled streams when the pipeline is started
+ * @brief The number of buffers is calculated from the enabled stream profiles and the pipeline queue depths, and the buffers are allocated before the
+ * streams are turned on, avoiding allocations and page faults on the capture threads for the first frames. Pre-allocation is limited to half of the free
+ * frame memory (see MaxFrameBufferSize in the SDK configuration file). It can also be enabled for all pipelines by Memory.PreallocateFrameBuffers in the
+ * SDK configuration file.
+ *
+ * @param[in] config The pipeline configuration object
+ * @param[in] enable Whether to pre-allocate the frame buffers (default is false)
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ */
+OB_EXPORT void ob_config_set_frame_buffer_preallocate(ob_config *config, bool enable, ob_error **error);
+
+/**
+ * @brief Set the frame aggregate engine used by the pipeline to match the frames of the enabled streams into framesets
+ * @brief Both engines follow the frame aggregate output mode (@ref ob_config_set_frame_aggregate_output_mode) and the frame sync setting of the pipeline.
+ *
+ * @param[in] config The pipeline configuration object
+ * @param[in] engine The frame aggregate engine (default is OB_FRAME_AGGREGATE_ENGINE_DEFAULT)
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ */
+OB_EXPORT void ob_config_set_frame_aggregate_engine(ob_config *config, ob_frame_aggregate_engine engine, ob_error **error);
+
 /**
  * @brief Get current camera parameters
  * @attention If D2C is enabled, it will return the camera parameters after D2C, if not, it will return to the default parameters
@@ -51,6 +51,16 @@ OB_EXPORT void ob_record_device_pause(ob_record_device *recorder, ob_error **err
  */
 OB_EXPORT void ob_record_device_resume(ob_record_device *recorder, ob_error **error);
 
+/**
+ * @brief Get the statistics of the file writer of a recording device.
+ *
+ * @param[in] recorder The recording device.
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ *
+ * @return The queue depth, write rate and dropped frame counters of the recording.
+ */
+OB_EXPORT ob_record_stats ob_record_device_get_stats(const ob_record_device *recorder, ob_error **error);
+
 /**
  * @brief Create a playback device for the specified file path.
  *
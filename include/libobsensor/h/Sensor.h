@@ -44,6 +44,20 @@ OB_EXPORT ob_stream_profile_list *ob_sensor_get_stream_profile_list(const ob_sen
  */
 OB_EXPORT void ob_sensor_start(ob_sensor *sensor, const ob_stream_profile *profile, ob_frame_callback callback, void *user_data, ob_error **error);
 
+/**
+ * @brief Open an accelerometer or gyroscope sensor and deliver its samples in batches.
+ *
+ * @brief Instead of one frame per sample, the callback receives one IMU batch frame (@ref OB_FRAME_IMU_BATCH) with all the samples of a packet of the
+ * device, read them with @ref ob_imu_batch_frame_get_data. The stream is stopped with @ref ob_sensor_stop.
+ *
+ * @param[in] sensor The sensor object, of type @ref OB_SENSOR_ACCEL or @ref OB_SENSOR_GYRO.
+ * @param[in] profile The stream configuration information.
+ * @param[in] callback The callback function triggered when a batch of samples arrives.
+ * @param[in] user_data Any user data to pass in and get from the callback.
+ * @param[out] error Logs error messages.
+ */
+OB_EXPORT void ob_sensor_start_batched(ob_sensor *sensor, const ob_stream_profile *profile, ob_frame_callback callback, void *user_data, ob_error **error);
+
 /**
  * @brief Stop the sensor stream.
  *
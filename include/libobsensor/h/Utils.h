@@ -120,6 +120,19 @@ OB_EXPORT bool ob_calibration_2d_to_2d(const ob_calibration_param calibration_pa
  */
 OB_EXPORT bool ob_save_pointcloud_to_ply(const char *file_name, ob_frame *frame, bool save_binary, bool use_mesh, float mesh_threshold, ob_error **error);
 
+/**
+ * @brief save point cloud to a binary ply file with quantized coordinates.
+ * @brief The coordinates are saved as 16-bit integers in units of the quantization step (clamped to the 16-bit range), the colors as 8-bit integers.
+ *
+ * @param[in] file_name Point cloud save path
+ * @param[in] frame Point cloud frame, OB_FORMAT_POINT or OB_FORMAT_RGB_POINT
+ * @param[in] quantization_step Coordinate unit in the file, in the unit of the point cloud coordinates (e.g. 1.0 for millimeters)
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ *
+ * @return bool save point cloud result
+ */
+OB_EXPORT bool ob_save_pointcloud_to_quantized_ply(const char *file_name, ob_frame *frame, float quantization_step, ob_error **error);
+
 /**
  * @brief save LiDAR point cloud to ply file.
  *
@@ -16,6 +16,7 @@
 #include "libobsensor/hpp/Sensor.hpp"
 
 #include "Error.hpp"
+#include <exception>
 #include <memory>
 #include <string>
 #include <vector>
@@ -1676,6 +1677,54 @@ public:
         return std::make_shared<Device>(device);
     }
 
+    /**
+     * @brief The result of the creation of a device by getDevices(): the device, or the error of its creation
+     */
+    struct DeviceResult {
+        std::shared_ptr<Device> device;
+        std::exception_ptr      error;  // rethrow it with std::rethrow_exception() to get the ob::Error
+    };
+
+    /**
+     * @brief Get the device objects at the specified indices, the devices are created in parallel
+     * @brief Opening N devices takes about the time of the slowest device instead of the sum of them.
+     *
+     * @attention If a device has already been acquired and created elsewhere, its result holds the error that getDevice() would throw
+     *
+     * @param[in] indices the indices of the devices to create
+     * @param[in] accessMode Device access mode of all the devices. @ref ob_device_access_mode.
+     * @param[in] maxParallel the maximum number of devices initialized at the same time, 0 to initialize all of them at the same time
+     *
+     * @return std::vector<DeviceResult> the results, in the order of the indices
+     */
+    std::vector<DeviceResult> getDevices(const std::vector<uint32_t> &indices, OBDeviceAccessMode accessMode = OB_DEVICE_DEFAULT_ACCESS,
+                                         uint32_t maxParallel = 0) const {
+        std::vector<DeviceResult> results(indices.size());
+        if(indices.empty()) {
+            return results;
+        }
+
+        std::vector<ob_device *> devices(indices.size(), nullptr);
+        std::vector<ob_error *>  deviceErrors(indices.size(), nullptr);
+        ob_error                *error = nullptr;
+        ob_device_list_get_devices(impl_, indices.data(), static_cast<uint32_t>(indices.size()), accessMode, maxParallel, devices.data(), deviceErrors.data(),
+                                   &error);
+        Error::handle(&error);
+
+        for(size_t i = 0; i < indices.size(); i++) {
+            if(devices[i]) {
+                results[i].device = std::make_shared<Device>(devices[i]);
+            }
+            try {
+                Error::handle(&deviceErrors[i]);
+            }
+            catch(...) {
+                results[i].error = std::current_exception();
+            }
+        }
+        return results;
+    }
+
 public:
     // The following interfaces are deprecated and are retained here for compatibility purposes.
     uint32_t deviceCount() const {
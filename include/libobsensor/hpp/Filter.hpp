@@ -183,7 +183,32 @@ public:
         if(!result) {
             return nullptr;
         }
-        return std::make_shared<Frame>(result);
+        return makeFrame<Frame>(result);
+    }
+
+    /**
+     * @brief Processes a frame synchronously by several filters one after the other, the disabled filters are skipped.
+     * @brief The filters changing the pixel values (threshold, pixel value scaler and offset, mirror, flip) update the frames created by the
+     * previous filters in place instead of creating a new frame. Several of them in a row on a Y16 depth frame run in a single pass.
+     *
+     * @param[in] filters The filters, in processing order.
+     * @param[in] frame The frame to be processed, it is not modified.
+     *
+     * @return std::shared_ptr< Frame > The processed frame.
+     */
+    static std::shared_ptr<Frame> processChain(const std::vector<std::shared_ptr<Filter>> &filters, std::shared_ptr<const Frame> frame) {
+        std::vector<ob_filter *> impls;
+        impls.reserve(filters.size());
+        for(const auto &filter: filters) {
+            impls.push_back(filter->getImpl());
+        }
+        ob_error *error  = nullptr;
+        auto      result = ob_filter_chain_process(impls.data(), static_cast<uint32_t>(impls.size()), frame->getImpl(), &error);
+        Error::handle(&error);
+        if(!result) {
+            return nullptr;
+        }
+        return makeFrame<Frame>(result);
     }
 
     /**
@@ -269,7 +294,7 @@ public:
 private:
     static void filterCallback(ob_frame *frame, void *userData) {
         auto filter = static_cast<Filter *>(userData);
-        filter->callback_(std::make_shared<Frame>(frame));
+        filter->callback_(makeFrame<Frame>(frame));
     }
 
 public:
@@ -358,7 +383,8 @@ public:
     /**
      * @brief Set the output pointcloud frame format.
      *
-     * @param[in] format The point cloud frame format: OB_FORMAT_POINT or OB_FORMAT_RGB_POINT
+     * @param[in] format The point cloud frame format: OB_FORMAT_POINT, OB_FORMAT_RGB_POINT, or their half float planes OB_FORMAT_POINT_SOA_F16 and
+     * OB_FORMAT_RGB_POINT_SOA_F16
      */
     void setCreatePointFormat(OBFormat format) {
         setConfigValue("pointFormat", static_cast<double>(format));
@@ -469,6 +495,16 @@ public:
         setConfigValue("MatchTargetRes", state);
     }
 
+    /**
+     * @brief Sets the number of threads to run the alignment on.
+     *        The depth frame is split into horizontal tiles aligned in parallel, 1 (default) runs the alignment on the thread processing the frame.
+     *
+     * @param[in] threadCount The number of threads, in range [1, 16]; only 1 on the builds without SSSE3 or NEON, whose alignment is not tiled.
+     */
+    void setThreadCount(uint32_t threadCount) {
+        setConfigValue("ThreadCount", static_cast<double>(threadCount));
+    }
+
     /**
      * @brief Set the Align To Stream Profile
      * @brief  It is useful when the align target stream dose not started (without any frame to get intrinsics and extrinsics).
@@ -16,6 +16,10 @@
 #include <iostream>
 #include <typeinfo>
 #include <functional>
+#include <mutex>
+#include <vector>
+#include <new>
+#include <type_traits>
 
 /**
  *  Frame classis inheritance hierarchy:
@@ -38,6 +42,126 @@ namespace ob {
 class Device;
 class Sensor;
 
+/**
+ * @brief Allocator of the frame objects of the c++ wrapper (see makeFrame): the memory of the deleted objects is kept in free lists per type
+ * and reused for the next frames, instead of one heap allocation for each frame delivered to the user. Each thread has its own free list,
+ * the blocks beyond its capacity go to a free list shared by the threads (the frames are usually created and released on different threads).
+ *
+ * @tparam T The type of the allocated objects (the frame object and its shared pointer control block, see std::allocate_shared).
+ */
+template <typename T> class FrameAllocator {
+public:
+    typedef T value_type;
+
+    FrameAllocator() noexcept {}
+    template <typename U> FrameAllocator(const FrameAllocator<U> &) noexcept {}
+
+    T *allocate(size_t n) {
+        if(n == 1) {
+            if(!threadFreeListDestroyed()) {
+                auto &cache = threadFreeList();
+                if(!cache.empty()) {
+                    void *block = cache.back();
+                    cache.pop_back();
+                    return static_cast<T *>(block);
+                }
+            }
+            auto                       &shared = sharedFreeList();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            if(!shared.blocks.empty()) {
+                void *block = shared.blocks.back();
+                shared.blocks.pop_back();
+                return static_cast<T *>(block);
+            }
+        }
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, size_t n) {
+        if(n == 1) {
+            if(!threadFreeListDestroyed()) {
+                auto &cache = threadFreeList();
+                if(cache.size() < MAX_THREAD_FREE_BLOCKS) {
+                    cache.push_back(p);
+                    return;
+                }
+            }
+            releaseShared(p);
+            return;
+        }
+        ::operator delete(p);
+    }
+
+private:
+    static const size_t MAX_THREAD_FREE_BLOCKS = 64;
+    static const size_t MAX_SHARED_FREE_BLOCKS = 256;
+
+    struct SharedFreeList {
+        std::mutex          mutex;
+        std::vector<void *> blocks;
+    };
+
+    struct ThreadFreeList : std::vector<void *> {
+        ~ThreadFreeList() {
+            threadFreeListDestroyed() = true;
+            for(auto block: *this) {
+                releaseShared(block);
+            }
+        }
+    };
+
+    static SharedFreeList &sharedFreeList() {
+        // Never destroyed: frames may still be released by the destructors of other static objects
+        static SharedFreeList *list = new SharedFreeList();
+        return *list;
+    }
+
+    static ThreadFreeList &threadFreeList() {
+        static thread_local ThreadFreeList list;
+        return list;
+    }
+
+    // Frames released on a thread after the destruction of its free list (destructors of static objects) go to the shared free list
+    static bool &threadFreeListDestroyed() {
+        static thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    static void releaseShared(void *block) {
+        {
+            auto                       &shared = sharedFreeList();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            if(shared.blocks.size() < MAX_SHARED_FREE_BLOCKS) {
+                shared.blocks.push_back(block);
+                return;
+            }
+        }
+        ::operator delete(block);
+    }
+};
+
+template <typename T, typename U> bool operator==(const FrameAllocator<T> &, const FrameAllocator<U> &) noexcept {
+    return true;
+}
+
+template <typename T, typename U> bool operator!=(const FrameAllocator<T> &, const FrameAllocator<U> &) noexcept {
+    return false;
+}
+
+/**
+ * @brief Create the frame object owning the internal frame object, allocated by FrameAllocator.
+ *
+ * @tparam T The frame type (Frame, FrameSet, DepthFrame...).
+ *
+ * @param[in] impl The pointer to the internal frame object, it will be deleted when the frame object is destroyed.
+ *
+ * @return std::shared_ptr<T> The frame object.
+ */
+template <typename T> std::shared_ptr<T> makeFrame(const ob_frame *impl) {
+    typedef typename std::remove_const<T>::type FrameType;
+    return std::allocate_shared<FrameType>(FrameAllocator<FrameType>(), impl);
+}
+
 /**
  * @brief Define the frame class, which is the base class of all frame types.
  *
@@ -280,6 +404,22 @@ public:
         return value;
     }
 
+    /**
+     * @brief Get the values of all metadata types at once
+     *
+     * @param[out] values The metadata values indexed by metadata type, 0 for the types the frame does not contain
+     * @param[in] count The number of elements of values, OB_FRAME_METADATA_TYPE_COUNT for all types
+     *
+     * @return uint64_t The mask of the metadata types the frame contains: bit n is set if the frame contains type n
+     */
+    uint64_t getAllMetadataValue(int64_t *values, uint32_t count = OB_FRAME_METADATA_TYPE_COUNT) const {
+        ob_error *error = nullptr;
+        auto      mask  = ob_frame_get_all_metadata_value(impl_, values, count, &error);
+        Error::handle(&error);
+
+        return mask;
+    }
+
     /**
      * @brief get StreamProfile of the frame
      *
@@ -343,7 +483,7 @@ public:
         ob_frame_add_ref(impl_, &error);
         Error::handle(&error);
 
-        return std::make_shared<T>(impl_);
+        return makeFrame<T>(impl_);
     }
 
     /**
@@ -362,7 +502,7 @@ public:
         ob_frame_add_ref(impl_, &error);
         Error::handle(&error);
 
-        return std::make_shared<const T>(impl_);
+        return makeFrame<const T>(impl_);
     }
 
     /**
@@ -736,6 +876,8 @@ public:
  * @note The pointcloud data format can be obtained from the @ref Frame::getFormat() function. Witch can be one of the following formats:
  * - @ref OB_FORMAT_POINT : 32-bit float format with 3D point coordinates (x, y, z), @ref OBPoint
  * - @ref OB_FORMAT_RGB_POINT : 32-bit float format with 3D point coordinates (x, y, z) and point colors (r, g, b) @ref OBColorPoint
+ * - @ref OB_FORMAT_POINT_SOA_F16 : 16-bit half float planes of the point coordinates: all x, then all y, then all z
+ * - @ref OB_FORMAT_RGB_POINT_SOA_F16 : 16-bit half float planes of the point coordinates and colors: x, y, z, r, g, b
  */
 class PointsFrame : public Frame {
 
@@ -896,6 +1038,42 @@ public:
     }
 };
 
+/**
+ * @brief Define the ImuBatchFrame class, which inherits from the Frame class
+ * @brief An ImuBatchFrame carries consecutive samples of an accelerometer or gyroscope stream, see Sensor::startBatched().
+ *
+ * @note Whether the samples are accelerometer or gyroscope samples can be obtained from the @ref Frame::getFormat() function (@ref OB_FORMAT_ACCEL or
+ * @ref OB_FORMAT_GYRO).
+ */
+class ImuBatchFrame : public Frame {
+public:
+    explicit ImuBatchFrame(const ob_frame *impl) : Frame(impl) {};
+
+    ~ImuBatchFrame() noexcept override = default;
+
+    /**
+     * @brief Get the samples of the batch
+     *
+     * @return OBImuBatchData The sample arrays, valid as long as the frame is
+     */
+    OBImuBatchData getBatchData() const {
+        ob_error *error = nullptr;
+        auto      data  = ob_imu_batch_frame_get_data(impl_, &error);
+        Error::handle(&error);
+
+        return data;
+    }
+
+    /**
+     * @brief Get the number of samples in the batch
+     *
+     * @return uint32_t The number of samples
+     */
+    uint32_t getCount() const {
+        return getBatchData().count;
+    }
+};
+
 /**
  * @brief Define the LiDARPointsFrame class, which inherits from the Frame class
  * @brief The LiDARPointsFrame class is used to obtain LiDAR point cloud data.
@@ -961,7 +1139,7 @@ public:
             return nullptr;
         }
         Error::handle(&error);
-        return std::make_shared<Frame>(frame);
+        return makeFrame<Frame>(frame);
     }
 
     /**
@@ -978,7 +1156,7 @@ public:
             return nullptr;
         }
         Error::handle(&error);
-        return std::make_shared<Frame>(frame);
+        return makeFrame<Frame>(frame);
     }
 
     /**
@@ -1012,7 +1190,7 @@ public:
             return nullptr;
         }
         Error::handle(&error);
-        return std::make_shared<DepthFrame>(frame);
+        return makeFrame<DepthFrame>(frame);
     }
 
     /**
@@ -1027,7 +1205,7 @@ public:
             return nullptr;
         }
         Error::handle(&error);
-        return std::make_shared<ColorFrame>(frame);
+        return makeFrame<ColorFrame>(frame);
     }
 
     /**
@@ -1042,7 +1220,7 @@ public:
             return nullptr;
         }
         Error::handle(&error);
-        return std::make_shared<IRFrame>(frame);
+        return makeFrame<IRFrame>(frame);
     }
 
     /**
@@ -1057,7 +1235,7 @@ public:
             return nullptr;
         }
         Error::handle(&error);
-        return std::make_shared<PointsFrame>(frame);
+        return makeFrame<PointsFrame>(frame);
     }
 
 public:
@@ -1128,7 +1306,7 @@ public:
         auto      impl  = ob_create_frame(frameType, format, dataSize, &error);
         Error::handle(&error);
 
-        return std::make_shared<Frame>(impl);
+        return makeFrame<Frame>(impl);
     }
 
     /**
@@ -1148,7 +1326,7 @@ public:
         auto      impl  = ob_create_video_frame(frameType, format, width, height, stride, &error);
         Error::handle(&error);
 
-        auto frame = std::make_shared<Frame>(impl);
+        auto frame = makeFrame<Frame>(impl);
         return frame->as<VideoFrame>();
     }
 
@@ -1168,7 +1346,7 @@ public:
         auto      impl      = ob_create_frame_from_other_frame(otherImpl, shouldCopyData, &error);
         Error::handle(&error);
 
-        return std::make_shared<Frame>(impl);
+        return makeFrame<Frame>(impl);
     }
 
     /**
@@ -1183,7 +1361,7 @@ public:
         auto      impl  = ob_create_frame_from_stream_profile(profile->getImpl(), &error);
         Error::handle(&error);
 
-        return std::make_shared<Frame>(impl);
+        return makeFrame<Frame>(impl);
     }
 
     /**
@@ -1212,7 +1390,7 @@ public:
         auto      impl  = ob_create_frame_from_buffer(frameType, format, buffer, bufferSize, &FrameFactory::BufferDestroy, ctx, &error);
         Error::handle(&error);
 
-        return std::make_shared<Frame>(impl);
+        return makeFrame<Frame>(impl);
     }
 
     /**
@@ -1241,7 +1419,7 @@ public:
         auto impl = ob_create_video_frame_from_buffer(frameType, format, width, height, stride, buffer, bufferSize, &FrameFactory::BufferDestroy, ctx, &error);
         Error::handle(&error);
 
-        auto frame = std::make_shared<Frame>(impl);
+        auto frame = makeFrame<Frame>(impl);
         return frame->as<VideoFrame>();
     }
 
@@ -1258,7 +1436,7 @@ public:
         ob_error *error = nullptr;
         auto      impl  = ob_create_frameset(&error);
         Error::handle(&error);
-        return std::make_shared<FrameSet>(impl);
+        return makeFrame<FrameSet>(impl);
     }
 
 private:
@@ -1328,6 +1506,8 @@ template <typename T> bool Frame::is() const {
         return (typeid(T) == typeid(GyroFrame));
     case OB_FRAME_ACCEL:
         return (typeid(T) == typeid(AccelFrame));
+    case OB_FRAME_IMU_BATCH:
+        return (typeid(T) == typeid(ImuBatchFrame));
     case OB_FRAME_POINTS:
         return (typeid(T) == typeid(PointsFrame));
     case OB_FRAME_LIDAR_POINTS:
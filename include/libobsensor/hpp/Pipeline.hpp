@@ -277,6 +277,29 @@ public:
         ob_config_set_frame_aggregate_output_mode(impl_, mode, &error);
         Error::handle(&error);
     }
+
+    /**
+     * @brief Set whether to pre-allocate the frame buffers of the enabled streams when the pipeline is started
+     * @brief Avoids memory allocations and page faults on the capture threads for the first frames after the pipeline is started.
+     *
+     * @param[in] enable Whether to pre-allocate the frame buffers (default is false)
+     */
+    void setFrameBufferPreallocate(bool enable) const {
+        ob_error *error = nullptr;
+        ob_config_set_frame_buffer_preallocate(impl_, enable, &error);
+        Error::handle(&error);
+    }
+
+    /**
+     * @brief Set the frame aggregate engine used by the pipeline to match the frames of the enabled streams into framesets
+     *
+     * @param[in] engine The frame aggregate engine (default is OB_FRAME_AGGREGATE_ENGINE_DEFAULT)
+     */
+    void setFrameAggregateEngine(OBFrameAggregateEngine engine) const {
+        ob_error *error = nullptr;
+        ob_config_set_frame_aggregate_engine(impl_, engine, &error);
+        Error::handle(&error);
+    }
 };
 
 class Pipeline {
@@ -352,7 +375,7 @@ public:
 
     static void frameSetCallback(ob_frame_t *frameSet, void *userData) {
         auto pipeline = static_cast<Pipeline *>(userData);
-        pipeline->callback_(std::make_shared<FrameSet>(frameSet));
+        pipeline->callback_(makeFrame<FrameSet>(frameSet));
     }
 
     static void healthMonitorCallback(ob_pipeline_status status, void *userData) {
@@ -398,7 +421,7 @@ public:
             return nullptr;
         }
         Error::handle(&error);
-        return std::make_shared<FrameSet>(frameSet);
+        return makeFrame<FrameSet>(frameSet);
     }
 
     /**
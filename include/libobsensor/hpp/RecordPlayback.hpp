@@ -66,6 +66,17 @@ public:
         ob_record_device_resume(impl_, &error);
         Error::handle(&error);
     }
+
+    /**
+     * @brief Get the statistics of the file writer, see OBRecordStats.
+     * @brief Frames are dropped once the staging queue is full, which happens when the disk or the compression can not keep up with the streams.
+     */
+    OBRecordStats getStats() const {
+        ob_error *error = nullptr;
+        auto      stats = ob_record_device_get_stats(impl_, &error);
+        Error::handle(&error);
+        return stats;
+    }
 };
 
 class PlaybackDevice : public Device {
@@ -120,6 +120,21 @@ public:
         Error::handle(&error);
     }
 
+    /**
+     * @brief Open the stream of an accelerometer or gyroscope sensor and receive its samples in batches.
+     *
+     * @brief The callback receives an ImuBatchFrame with all the samples of a packet of the device instead of one frame per sample.
+     *
+     * @param[in] streamProfile The stream configuration.
+     * @param[in] callback The callback to set when a batch of samples arrives.
+     */
+    void startBatched(std::shared_ptr<StreamProfile> streamProfile, FrameCallback callback) {
+        ob_error *error = nullptr;
+        callback_       = std::move(callback);
+        ob_sensor_start_batched(impl_, const_cast<ob_stream_profile_t *>(streamProfile->getImpl()), &Sensor::frameCallback, this, &error);
+        Error::handle(&error);
+    }
+
     /**
      * @brief Stop the stream.
      */
@@ -143,7 +158,7 @@ public:
 private:
     static void frameCallback(ob_frame *frame, void *userData) {
         auto sensor = static_cast<Sensor *>(userData);
-        sensor->callback_(std::make_shared<Frame>(frame));
+        sensor->callback_(makeFrame<Frame>(frame));
     }
 
 public:
@@ -142,7 +142,7 @@ public:
 
         auto result = transformation_depth_frame_to_color_camera(device->getImpl(), unConstImpl, targetColorCameraWidth, targetColorCameraHeight, &error);
         Error::handle(&error);
-        return std::make_shared<ob::Frame>(result);
+        return makeFrame<Frame>(result);
     }
 
     static bool transformationInitXYTables(const OBCalibrationParam calibrationParam, const OBSensorType sensorType, float *data, uint32_t *dataSize,
@@ -187,6 +187,23 @@ public:
         return result;
     }
 
+    /**
+     * @brief save point cloud to a binary ply file with quantized coordinates: 16-bit integers in units of the quantization step.
+     *
+     * @param[in] fileName Point cloud save path
+     * @param[in] frame Point cloud frame
+     * @param[in] quantizationStep Coordinate unit in the file, in the unit of the point cloud coordinates (e.g. 1.0 for millimeters)
+     *
+     * @return bool save point cloud result
+     */
+    static bool savePointcloudToQuantizedPly(const char *fileName, std::shared_ptr<ob::Frame> frame, float quantizationStep = 1.0f) {
+        ob_error *error       = NULL;
+        auto      unConstImpl = const_cast<ob_frame *>(frame->getImpl());
+        bool      result      = ob_save_pointcloud_to_quantized_ply(fileName, unConstImpl, quantizationStep, &error);
+        Error::handle(&error, false);
+        return result;
+    }
+
     /**
      * @brief Save LiDAR point cloud to PLY file.
      *
@@ -31,6 +31,7 @@ public:
     virtual void                                  registerParser(OBFrameMetadataType type, std::shared_ptr<IFrameMetadataParser> phaser) = 0;
     virtual bool                                  isContained(OBFrameMetadataType type)                                                  = 0;
     virtual std::shared_ptr<IFrameMetadataParser> get(OBFrameMetadataType type)                                                          = 0;
+    virtual IFrameMetadataParser                 *find(OBFrameMetadataType type)                                                         = 0;  // nullptr if not registered
 };
 
 }  // namespace libobsensor
@@ -40,7 +41,11 @@ extern "C" {
 #endif
 struct ob_frame_t {
     std::shared_ptr<libobsensor::Frame> frame;
-    std::atomic<int>                    refCnt = { 1 };
+    std::atomic<int>                    refCnt = { 1 };  // ob_frame_add_ref, ob_delete_frame
+
+    // Handles are taken from and returned to libobsensor::FrameHandlePool
+    static void *operator new(size_t size);
+    static void  operator delete(void *ptr);
 };
 #ifdef __cplusplus
 }
@@ -7,9 +7,16 @@
 #include "stream/StreamProfile.hpp"
 #include "frame/FrameMemoryPool.hpp"
 #include "frame/FrameBufferManager.hpp"
+#include "frame/FrameFactory.hpp"
+
+#include <algorithm>
 
 namespace libobsensor {
 
+namespace {
+std::mutex sharedDataMutex;  // serializes the copy-on-write of the frames sharing the data of another frame
+}  // namespace
+
 FrameBackendLifeSpan::FrameBackendLifeSpan()
     : logger_(Logger::getInstance()), memoryPool_(FrameMemoryPool::getInstance()), memoryAllocator_(FrameMemoryAllocator::getInstance()) {}
 
@@ -33,9 +40,11 @@ Frame::Frame(uint8_t *data, size_t dataBufSize, OBFrameType type, FrameBufferRec
       frameToken_(0),
       deviceInfo_(nullptr),
       type_(type),
+      classMask_(FRAME_CLASS_FRAME),
       frameData_(data),
       dataBufSize_(dataBufSize),
-      bufferReclaimFunc_(bufferReclaimFunc) {}
+      bufferReclaimFunc_(bufferReclaimFunc),
+      dataShared_(false) {}
 
 Frame::Frame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc) : Frame(data, dataBufSize, OB_FRAME_UNKNOWN, bufferReclaimFunc) {}
 
@@ -48,6 +57,10 @@ Frame::~Frame() noexcept {
     }
 }
 
+uint32_t Frame::getClassMask() const {
+    return classMask_;
+}
+
 OBFrameType Frame::getType() const {
     return type_;
 }
@@ -80,6 +93,9 @@ const uint8_t *Frame::getData() const {
 }
 
 uint8_t *Frame::getDataMutable() const {
+    if(dataShared_.load(std::memory_order_acquire)) {
+        detachSharedData(true);
+    }
     return const_cast<uint8_t *>(frameData_);
 }
 
@@ -87,10 +103,47 @@ void Frame::updateData(const uint8_t *data, size_t dataSize) {
     if(dataSize > dataBufSize_) {
         THROW_MEMORY_EXCEPTION(utils::string::to_string() << "Update data size(" << dataSize << ") > data buffer size! (" << dataBufSize_ << ")");
     }
+    if(dataShared_.load(std::memory_order_acquire)) {
+        detachSharedData(false);
+    }
     dataSize_ = dataSize;
     memcpy(const_cast<uint8_t *>(frameData_), data, dataSize);
 }
 
+void Frame::markDataShared(std::shared_ptr<const Frame> owner) {
+    std::lock_guard<std::mutex> lock(sharedDataMutex);
+    dataOwner_       = owner;
+    sharedDataOwner_ = std::move(owner);
+    dataShared_.store(true, std::memory_order_release);
+}
+
+bool Frame::isDataShared() const {
+    return dataShared_.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<const Frame> Frame::getDataOwner(const uint8_t **data) const {
+    std::lock_guard<std::mutex> lock(sharedDataMutex);
+    *data = frameData_;
+    return dataOwner_;
+}
+
+void Frame::detachSharedData(bool copyData) const {
+    // The copy goes to a frame of the memory pool, so it is accounted in the frame memory budget and reuses the idle buffers
+    auto buffer = FrameFactory::createFrame(type_, getFormat(), dataBufSize_);
+
+    std::lock_guard<std::mutex> lock(sharedDataMutex);
+    if(!dataShared_.load(std::memory_order_relaxed)) {
+        return;  // copied by another thread meanwhile
+    }
+    auto data = buffer->getDataMutable();
+    if(copyData) {
+        memcpy(data, frameData_, dataSize_);
+    }
+    frameData_ = data;
+    dataOwner_ = std::move(buffer);
+    dataShared_.store(false, std::memory_order_release);
+}
+
 uint64_t Frame::getTimeStampUsec() const {
     return timeStampUsec_;
 }
@@ -180,6 +233,7 @@ size_t Frame::getMetadataSize() const {
 
 void Frame::setMetadataSize(size_t metadataSize) {
     metadataSize_ = metadataSize;
+    resetMetadataCache();
 }
 
 void Frame::updateMetadata(const uint8_t *metadata, size_t metadataSize) {
@@ -192,6 +246,7 @@ void Frame::updateMetadata(const uint8_t *metadata, size_t metadataSize) {
     }
     memcpy(metadata_, metadata, metadataSize);
     metadataSize_ = metadataSize;
+    resetMetadataCache();
 }
 
 void Frame::appendMetadata(const uint8_t *metadata, size_t metadataSize) {
@@ -204,6 +259,7 @@ void Frame::appendMetadata(const uint8_t *metadata, size_t metadataSize) {
     }
     memcpy(metadata_ + metadataSize_, metadata, metadataSize);
     metadataSize_ += metadataSize;
+    resetMetadataCache();
 }
 
 const uint8_t *Frame::getMetadata() const {
@@ -211,22 +267,26 @@ const uint8_t *Frame::getMetadata() const {
 }
 
 uint8_t *Frame::getMetadataMutable() const {
+    resetMetadataCache();  // the metadata is about to change
     return const_cast<uint8_t *>(metadata_);
 }
 
 void Frame::registerMetadataParsers(std::shared_ptr<IFrameMetadataParserContainer> parsers) {
     metadataPhasers_ = parsers;
+    resetMetadataCache();
 }
 
 bool Frame::hasMetadata(OBFrameMetadataType type) const {
-    if(!metadataPhasers_) {
+    if(!metadataPhasers_ || static_cast<uint32_t>(type) >= OB_FRAME_METADATA_TYPE_COUNT) {
         return false;
     }
-    if(!metadataPhasers_->isContained(type)) {
-        return false;
+    try {
+        int64_t value = 0;
+        return lookupMetadata(type, value);
+    }
+    catch(const std::exception &) {
+        return true;  // supported, but the value could not be parsed: getMetadataValue() reports the error
     }
-    auto parser = metadataPhasers_->get(type);
-    return parser->isSupported(metadata_, metadataSize_);
 }
 
 int64_t Frame::getMetadataValue(OBFrameMetadataType type) const {
@@ -234,11 +294,59 @@ int64_t Frame::getMetadataValue(OBFrameMetadataType type) const {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION(utils::string::to_string()
                                               << "Metadata phasers are not registered! Unsupported to get metadata for type: " << type);
     }
-    auto parser = metadataPhasers_->get(type);
-    if(!parser->isSupported(metadata_, metadataSize_)) {
-        THROW_UNSUPPORTED_OPERATION_EXCEPTION(utils::string::to_string() << "Current metadata does not contain metadata for type: " << type);
+    int64_t value = 0;
+    if(static_cast<uint32_t>(type) < OB_FRAME_METADATA_TYPE_COUNT && lookupMetadata(type, value)) {
+        return value;
     }
-    return parser->getValue(metadata_, metadataSize_);
+    if(static_cast<uint32_t>(type) >= OB_FRAME_METADATA_TYPE_COUNT || metadataPhasers_->find(type) == nullptr) {
+        THROW_UNSUPPORTED_OPERATION_EXCEPTION(utils::string::to_string() << "Not registered metadata parser for type: " << type);
+    }
+    THROW_UNSUPPORTED_OPERATION_EXCEPTION(utils::string::to_string() << "Current metadata does not contain metadata for type: " << type);
+}
+
+uint64_t Frame::getAllMetadataValue(int64_t *values, uint32_t count) const {
+    uint64_t presentMask = 0;
+    count                = std::min(count, static_cast<uint32_t>(OB_FRAME_METADATA_TYPE_COUNT));
+    for(uint32_t i = 0; i < count; i++) {
+        int64_t value   = 0;
+        bool    present = false;
+        if(metadataPhasers_) {
+            try {
+                present = lookupMetadata(static_cast<OBFrameMetadataType>(i), value);
+            }
+            catch(const std::exception &) {
+                present = false;  // reported as absent, getMetadataValue() reports the error
+            }
+        }
+        values[i] = present ? value : 0;
+        presentMask |= present ? (1ull << i) : 0;
+    }
+    return presentMask;
+}
+
+// Parses the value of a metadata type on its first lookup, later lookups are served from the cache. Two threads may both parse a value on
+// their first lookup, they store the same value.
+bool Frame::lookupMetadata(OBFrameMetadataType type, int64_t &value) const {
+    const uint64_t bit = 1ull << type;
+    if(metadataCache_.parsedMask.load(std::memory_order_acquire) & bit) {
+        value = metadataCache_.values[type].load(std::memory_order_relaxed);
+        return (metadataCache_.presentMask.load(std::memory_order_relaxed) & bit) != 0;
+    }
+
+    auto parser  = metadataPhasers_ ? metadataPhasers_->find(type) : nullptr;
+    bool present = parser != nullptr && parser->isSupported(metadata_, metadataSize_);
+    if(present) {
+        value = parser->getValue(metadata_, metadataSize_);  // nothing is cached if it throws
+        metadataCache_.values[type].store(value, std::memory_order_relaxed);
+        metadataCache_.presentMask.fetch_or(bit, std::memory_order_relaxed);
+    }
+    metadataCache_.parsedMask.fetch_or(bit, std::memory_order_release);
+    return present;
+}
+
+void Frame::resetMetadataCache() const {
+    metadataCache_.parsedMask.store(0, std::memory_order_relaxed);
+    metadataCache_.presentMask.store(0, std::memory_order_relaxed);
 }
 
 void Frame::setAuthToken(uint64_t token) {
@@ -278,6 +386,7 @@ void Frame::copyInfoFromOther(const std::shared_ptr<const Frame> otherFrame) {
     metadataPhasers_ = otherFrame->metadataPhasers_;
     frameToken_      = otherFrame->frameToken_;
     deviceInfo_      = otherFrame->deviceInfo_;
+    resetMetadataCache();
 }
 
 size_t Frame::getDataBufSize() const {
@@ -285,7 +394,9 @@ size_t Frame::getDataBufSize() const {
 }
 
 VideoFrame::VideoFrame(uint8_t *data, size_t dataBufSize, OBFrameType type, FrameBufferReclaimFunc bufferReclaimFunc)
-    : Frame(data, dataBufSize, type, bufferReclaimFunc), pixelType_(OB_PIXEL_UNKNOWN), availablePixelBitSize_(0) {}
+    : Frame(data, dataBufSize, type, bufferReclaimFunc), pixelType_(OB_PIXEL_UNKNOWN), availablePixelBitSize_(0) {
+    classMask_ |= FRAME_CLASS_VIDEO_FRAME;
+}
 
 void VideoFrame::setPixelType(OBPixelType pixelType) {
     pixelType_ = pixelType;
@@ -296,7 +407,9 @@ OBPixelType VideoFrame::getPixelType() const {
 }
 
 VideoFrame::VideoFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
-    : Frame(data, dataBufSize, OB_FRAME_VIDEO, bufferReclaimFunc), pixelType_(OB_PIXEL_UNKNOWN), availablePixelBitSize_(0) {}
+    : Frame(data, dataBufSize, OB_FRAME_VIDEO, bufferReclaimFunc), pixelType_(OB_PIXEL_UNKNOWN), availablePixelBitSize_(0) {
+    classMask_ |= FRAME_CLASS_VIDEO_FRAME;
+}
 
 uint8_t VideoFrame::getPixelAvailableBitSize() const {
     if(availablePixelBitSize_ == 0) {
@@ -321,16 +434,23 @@ void VideoFrame::copyInfoFromOther(std::shared_ptr<const Frame> sourceFrame) {
 }
 
 ColorFrame::ColorFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
-    : VideoFrame(data, dataBufSize, OB_FRAME_COLOR, bufferReclaimFunc) {}
+    : VideoFrame(data, dataBufSize, OB_FRAME_COLOR, bufferReclaimFunc) {
+    classMask_ |= FRAME_CLASS_COLOR_FRAME;
+}
 
 ColorLeftFrame::ColorLeftFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
-    : VideoFrame(data, dataBufSize, OB_FRAME_COLOR_LEFT, bufferReclaimFunc) {}
+    : VideoFrame(data, dataBufSize, OB_FRAME_COLOR_LEFT, bufferReclaimFunc) {
+    classMask_ |= FRAME_CLASS_COLOR_LEFT_FRAME;
+}
 
 ColorRightFrame::ColorRightFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
-    : VideoFrame(data, dataBufSize, OB_FRAME_COLOR_RIGHT, bufferReclaimFunc) {}
+    : VideoFrame(data, dataBufSize, OB_FRAME_COLOR_RIGHT, bufferReclaimFunc) {
+    classMask_ |= FRAME_CLASS_COLOR_RIGHT_FRAME;
+}
 
 DepthFrame::DepthFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
     : VideoFrame(data, dataBufSize, OB_FRAME_DEPTH, bufferReclaimFunc), valueScale_(1.0f) {
+    classMask_ |= FRAME_CLASS_DEPTH_FRAME;
     setPixelType(OB_PIXEL_DEPTH);  // set default pixel type to OB_PIXEL_DEPTH
 }
 
@@ -360,19 +480,29 @@ void DepthFrame::copyInfoFromOther(std::shared_ptr<const Frame> sourceFrame) {
 }
 
 ConfidenceFrame::ConfidenceFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
-    : VideoFrame(data, dataBufSize, OB_FRAME_CONFIDENCE, bufferReclaimFunc) {}
+    : VideoFrame(data, dataBufSize, OB_FRAME_CONFIDENCE, bufferReclaimFunc) {
+    classMask_ |= FRAME_CLASS_CONFIDENCE_FRAME;
+}
 
 IRFrame::IRFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc, OBFrameType frameType)
-    : VideoFrame(data, dataBufSize, frameType, bufferReclaimFunc) {}
+    : VideoFrame(data, dataBufSize, frameType, bufferReclaimFunc) {
+    classMask_ |= FRAME_CLASS_IR_FRAME;
+}
 
 IRLeftFrame::IRLeftFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
-    : IRFrame(data, dataBufSize, bufferReclaimFunc, OB_FRAME_IR_LEFT) {}
+    : IRFrame(data, dataBufSize, bufferReclaimFunc, OB_FRAME_IR_LEFT) {
+    classMask_ |= FRAME_CLASS_IR_LEFT_FRAME;
+}
 
 IRRightFrame::IRRightFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
-    : IRFrame(data, dataBufSize, bufferReclaimFunc, OB_FRAME_IR_RIGHT) {}
+    : IRFrame(data, dataBufSize, bufferReclaimFunc, OB_FRAME_IR_RIGHT) {
+    classMask_ |= FRAME_CLASS_IR_RIGHT_FRAME;
+}
 
 PointsFrame::PointsFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
-    : Frame(data, dataBufSize, OB_FRAME_POINTS, bufferReclaimFunc), coordValueScale_(0), width_(0), height_(0) {}
+    : Frame(data, dataBufSize, OB_FRAME_POINTS, bufferReclaimFunc), coordValueScale_(0), width_(0), height_(0) {
+    classMask_ |= FRAME_CLASS_POINTS_FRAME;
+}
 
 void PointsFrame::setCoordinateValueScale(float valueScale) {
     coordValueScale_ = valueScale;
@@ -397,7 +527,9 @@ uint32_t PointsFrame::getHeight() const {
 }
 
 AccelFrame::AccelFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
-    : Frame(data, dataBufSize, OB_FRAME_ACCEL, bufferReclaimFunc) {}
+    : Frame(data, dataBufSize, OB_FRAME_ACCEL, bufferReclaimFunc) {
+    classMask_ |= FRAME_CLASS_ACCEL_FRAME;
+}
 
 OBAccelValue AccelFrame::value() const {
     return *(OBAccelValue *)getData();
@@ -408,7 +540,9 @@ float AccelFrame::temperature() const {
 }
 
 GyroFrame::GyroFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
-    : Frame(data, dataBufSize, OB_FRAME_GYRO, bufferReclaimFunc) {}
+    : Frame(data, dataBufSize, OB_FRAME_GYRO, bufferReclaimFunc) {
+    classMask_ |= FRAME_CLASS_GYRO_FRAME;
+}
 
 OBGyroValue GyroFrame ::value() const {
     return *(OBGyroValue *)getData();
@@ -418,10 +552,78 @@ float GyroFrame ::temperature() const {
     return ((GyroFrame::Data *)getData())->temp;
 }
 
+namespace {
+// Header of the data buffer of an ImuBatchFrame, the sample arrays follow it
+struct ImuBatchHeader {
+    uint32_t count;
+    uint32_t reserved;
+};
+const size_t IMU_BATCH_SAMPLE_SIZE = sizeof(uint64_t) + 4 * sizeof(float);
+}  // namespace
+
+ImuBatchFrame::ImuBatchFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
+    : Frame(data, dataBufSize, OB_FRAME_IMU_BATCH, bufferReclaimFunc),
+      capacity_(dataBufSize < sizeof(ImuBatchHeader) ? 0 : static_cast<uint32_t>((dataBufSize - sizeof(ImuBatchHeader)) / IMU_BATCH_SAMPLE_SIZE)) {
+    classMask_ |= FRAME_CLASS_IMU_BATCH_FRAME;
+    if(capacity_ > 0) {
+        setSampleCount(0);
+    }
+}
+
+size_t ImuBatchFrame::calcDataSize(uint32_t capacity) {
+    return sizeof(ImuBatchHeader) + capacity * IMU_BATCH_SAMPLE_SIZE;
+}
+
+uint32_t ImuBatchFrame::getCapacity() const {
+    return capacity_;
+}
+
+uint32_t ImuBatchFrame::getSampleCount() const {
+    if(capacity_ == 0) {
+        return 0;
+    }
+    return std::min(reinterpret_cast<const ImuBatchHeader *>(getData())->count, capacity_);
+}
+
+void ImuBatchFrame::setSampleCount(uint32_t count) {
+    if(count > capacity_) {
+        THROW_INVALID_PARAM_EXCEPTION("Sample count exceeds the capacity of the imu batch frame!");
+    }
+    reinterpret_cast<ImuBatchHeader *>(getDataMutable())->count = count;
+}
+
+OBImuBatchData ImuBatchFrame::getBatchData() const {
+    auto           arrays = const_cast<ImuBatchFrame *>(this)->getArraysMutable();
+    OBImuBatchData data;
+    data.count       = getSampleCount();
+    data.timestamp   = arrays.timestamp;
+    data.x           = arrays.x;
+    data.y           = arrays.y;
+    data.z           = arrays.z;
+    data.temperature = arrays.temperature;
+    return data;
+}
+
+ImuBatchFrame::Arrays ImuBatchFrame::getArraysMutable() {
+    // The arrays are laid out for the capacity, so a copy of the data buffer keeps the layout
+    auto   base = getDataMutable() + sizeof(ImuBatchHeader);
+    Arrays arrays;
+    arrays.timestamp   = reinterpret_cast<uint64_t *>(base);
+    arrays.x           = reinterpret_cast<float *>(base + capacity_ * sizeof(uint64_t));
+    arrays.y           = arrays.x + capacity_;
+    arrays.z           = arrays.y + capacity_;
+    arrays.temperature = arrays.z + capacity_;
+    return arrays;
+}
+
 LiDARPointsFrame::LiDARPointsFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
-    : Frame(data, dataBufSize, OB_FRAME_LIDAR_POINTS, bufferReclaimFunc) {}
+    : Frame(data, dataBufSize, OB_FRAME_LIDAR_POINTS, bufferReclaimFunc) {
+    classMask_ |= FRAME_CLASS_LIDAR_POINTS_FRAME;
+}
 
-FrameSet::FrameSet(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc) : Frame(data, dataBufSize, OB_FRAME_SET, bufferReclaimFunc) {}
+FrameSet::FrameSet(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc) : Frame(data, dataBufSize, OB_FRAME_SET, bufferReclaimFunc) {
+    classMask_ |= FRAME_CLASS_FRAME_SET;
+}
 
 FrameSet::~FrameSet() noexcept {
     clearAllFrame();
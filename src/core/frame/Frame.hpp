@@ -12,6 +12,7 @@
 #include <mutex>
 #include <vector>
 #include <typeinfo>
+#include <type_traits>
 
 namespace libobsensor {
 
@@ -39,9 +40,75 @@ class DepthFrame;
 class IRFrame;
 class AccelFrame;
 class GyroFrame;
+class ColorLeftFrame;
+class ColorRightFrame;
+class ConfidenceFrame;
+class IRLeftFrame;
+class IRRightFrame;
+class ImuBatchFrame;
+class LiDARPointsFrame;
 
 using FrameBufferReclaimFunc = std::function<void(void)>;
 
+// Class of a frame object: each frame class has a bit, set by its constructor, so an object has the bits of its class and of all its base classes.
+// Frame::is<T>() and as<T>() test the bit of T instead of a dynamic_cast; classes without a bit fall back to the dynamic_cast.
+enum FrameClassBit : uint32_t {
+    FRAME_CLASS_FRAME              = 1u << 0,
+    FRAME_CLASS_VIDEO_FRAME        = 1u << 1,
+    FRAME_CLASS_COLOR_FRAME        = 1u << 2,
+    FRAME_CLASS_COLOR_LEFT_FRAME   = 1u << 3,
+    FRAME_CLASS_COLOR_RIGHT_FRAME  = 1u << 4,
+    FRAME_CLASS_DEPTH_FRAME        = 1u << 5,
+    FRAME_CLASS_CONFIDENCE_FRAME   = 1u << 6,
+    FRAME_CLASS_IR_FRAME           = 1u << 7,
+    FRAME_CLASS_IR_LEFT_FRAME      = 1u << 8,
+    FRAME_CLASS_IR_RIGHT_FRAME     = 1u << 9,
+    FRAME_CLASS_POINTS_FRAME       = 1u << 10,
+    FRAME_CLASS_ACCEL_FRAME        = 1u << 11,
+    FRAME_CLASS_GYRO_FRAME         = 1u << 12,
+    FRAME_CLASS_IMU_BATCH_FRAME    = 1u << 13,
+    FRAME_CLASS_LIDAR_POINTS_FRAME = 1u << 14,
+    FRAME_CLASS_FRAME_SET          = 1u << 15,
+};
+
+template <typename T> struct FrameClassOf {
+    static const uint32_t bit = 0;
+};
+
+#define OB_FRAME_CLASS_BIT(CLASS, BIT)       \
+    template <> struct FrameClassOf<CLASS> { \
+        static const uint32_t bit = BIT;     \
+    }
+
+class Frame;
+OB_FRAME_CLASS_BIT(Frame, FRAME_CLASS_FRAME);
+OB_FRAME_CLASS_BIT(VideoFrame, FRAME_CLASS_VIDEO_FRAME);
+OB_FRAME_CLASS_BIT(ColorFrame, FRAME_CLASS_COLOR_FRAME);
+OB_FRAME_CLASS_BIT(ColorLeftFrame, FRAME_CLASS_COLOR_LEFT_FRAME);
+OB_FRAME_CLASS_BIT(ColorRightFrame, FRAME_CLASS_COLOR_RIGHT_FRAME);
+OB_FRAME_CLASS_BIT(DepthFrame, FRAME_CLASS_DEPTH_FRAME);
+OB_FRAME_CLASS_BIT(ConfidenceFrame, FRAME_CLASS_CONFIDENCE_FRAME);
+OB_FRAME_CLASS_BIT(IRFrame, FRAME_CLASS_IR_FRAME);
+OB_FRAME_CLASS_BIT(IRLeftFrame, FRAME_CLASS_IR_LEFT_FRAME);
+OB_FRAME_CLASS_BIT(IRRightFrame, FRAME_CLASS_IR_RIGHT_FRAME);
+OB_FRAME_CLASS_BIT(PointsFrame, FRAME_CLASS_POINTS_FRAME);
+OB_FRAME_CLASS_BIT(AccelFrame, FRAME_CLASS_ACCEL_FRAME);
+OB_FRAME_CLASS_BIT(GyroFrame, FRAME_CLASS_GYRO_FRAME);
+OB_FRAME_CLASS_BIT(ImuBatchFrame, FRAME_CLASS_IMU_BATCH_FRAME);
+OB_FRAME_CLASS_BIT(LiDARPointsFrame, FRAME_CLASS_LIDAR_POINTS_FRAME);
+OB_FRAME_CLASS_BIT(FrameSet, FRAME_CLASS_FRAME_SET);
+
+#undef OB_FRAME_CLASS_BIT
+
+static_assert(OB_FRAME_METADATA_TYPE_COUNT <= 64, "The metadata cache masks have one bit per metadata type");
+
+// Metadata values of a frame, each parsed on its first access and reset when the metadata or the parsers change
+struct FrameMetadataCache {
+    std::atomic<uint64_t> parsedMask{ 0 };   // types looked up since the last reset
+    std::atomic<uint64_t> presentMask{ 0 };  // looked up types the metadata contains
+    std::atomic<int64_t>  values[OB_FRAME_METADATA_TYPE_COUNT];
+};
+
 class Frame : public std::enable_shared_from_this<Frame>, private FrameBackendLifeSpan {
 public:
     Frame(uint8_t *data, size_t dataBufSize, OBFrameType type, FrameBufferReclaimFunc bufferReclaimFunc = nullptr);
@@ -55,8 +122,18 @@ public:
     size_t         getDataSize() const;
     void           setDataSize(size_t dataSize);
     const uint8_t *getData() const;
-    uint8_t       *getDataMutable() const;
+    uint8_t       *getDataMutable() const;  // copies the data first if it is shared with another frame (see markDataShared)
     void           updateData(const uint8_t *data, size_t dataSize);
+    size_t         getDataBufSize() const;
+
+    // The data buffer belongs to owner (FrameFactory::createFrameView): it is read in place, and copied to a buffer of the frame memory pool on
+    // the first getDataMutable() or replaced on the first updateData(). The owner is kept until this frame is destroyed, so that a pointer
+    // returned by getData() before the copy stays valid.
+    void markDataShared(std::shared_ptr<const Frame> owner);
+    bool isDataShared() const;
+    // The frame owning the data buffer of this frame (nullptr if it is the frame itself) and the data, read together so that a concurrent
+    // copy-on-write can not separate them. A view of a view holds this owner instead of the intermediate view.
+    std::shared_ptr<const Frame> getDataOwner(const uint8_t **data) const;
     uint64_t       getTimeStampUsec() const;
     void           setTimeStampUsec(uint64_t ts);
     uint64_t       getSystemTimeStampUsec() const;
@@ -76,9 +153,10 @@ public:
     uint8_t *getMetadataMutable() const;  // use with caution, metadata may be changed while other threads are using it
     void     setMetadataSize(size_t metadataSize);
 
-    void    registerMetadataParsers(std::shared_ptr<IFrameMetadataParserContainer> parsers);
-    bool    hasMetadata(OBFrameMetadataType type) const;
-    int64_t getMetadataValue(OBFrameMetadataType type) const;
+    void     registerMetadataParsers(std::shared_ptr<IFrameMetadataParserContainer> parsers);
+    bool     hasMetadata(OBFrameMetadataType type) const;
+    int64_t  getMetadataValue(OBFrameMetadataType type) const;
+    uint64_t getAllMetadataValue(int64_t *values, uint32_t count) const;  // values indexed by type (0 if absent), returns the mask of the present types
 
     void                              setAuthToken(uint64_t token);
     uint64_t                          getAuthToken() const;
@@ -91,31 +169,60 @@ public:
 
     virtual void copyInfoFromOther(std::shared_ptr<const Frame> otherFrame);
 
+    uint32_t getClassMask() const;  // FrameClassBit of the class of the object and of its base classes
+
     template <typename T> bool is() const {
-        return std::dynamic_pointer_cast<const T>(shared_from_this()) != nullptr;
+        typedef typename std::remove_const<T>::type Type;
+        return isClass<Type>(std::integral_constant<bool, FrameClassOf<Type>::bit != 0>());
     }
 
-    // template <typename T> bool               is(){
-    //     return std::dynamic_pointer_cast<T>(shared_from_this()) != nullptr;
-    // }
+    // Raw pointer to the object as a T, nullptr if it is not a T: no reference count change, for the per-frame paths holding the frame
+    template <typename T> T *tryAs() {
+        return is<T>() ? castTo<T>(std::integral_constant<bool, FrameClassOf<typename std::remove_const<T>::type>::bit != 0>()) : nullptr;
+    }
+
+    template <typename T> const T *tryAs() const {
+        return const_cast<Frame *>(this)->tryAs<const T>();
+    }
 
     template <typename T> std::shared_ptr<T> as() {
-        if(!is<T>()) {
+        auto ptr = tryAs<T>();
+        if(!ptr) {
             THROW_UNSUPPORTED_OPERATION_EXCEPTION("unsupported operation, object's type is not require type");
         }
 
-        return std::dynamic_pointer_cast<T>(shared_from_this());
+        return std::shared_ptr<T>(shared_from_this(), ptr);
     }
 
     template <typename T> std::shared_ptr<const T> as() const {
-        if(!is<const T>())
+        auto ptr = tryAs<const T>();
+        if(!ptr)
             THROW_UNSUPPORTED_OPERATION_EXCEPTION("unsupported operation, object's type is not require type");
 
-        return std::dynamic_pointer_cast<const T>(shared_from_this());
+        return std::shared_ptr<const T>(shared_from_this(), ptr);
     }
 
-protected:
-    size_t getDataBufSize() const;
+private:
+    template <typename T> bool isClass(std::true_type) const {
+        return (classMask_ & FrameClassOf<T>::bit) != 0;
+    }
+
+    template <typename T> bool isClass(std::false_type) const {
+        return dynamic_cast<const T *>(this) != nullptr;
+    }
+
+    template <typename T> T *castTo(std::true_type) {
+        return static_cast<T *>(this);
+    }
+
+    template <typename T> T *castTo(std::false_type) {
+        return dynamic_cast<T *>(this);
+    }
+
+private:
+    bool lookupMetadata(OBFrameMetadataType type, int64_t &value) const;
+    void resetMetadataCache() const;
+    void detachSharedData(bool copyData) const;
 
 protected:
     size_t                                         dataSize_;
@@ -128,16 +235,21 @@ protected:
     size_t                                         metadataSize_;
     uint8_t                                        metadata_[12 + 255];  // standard uvc payload size is 12bytes, add some extra space for metadata
     std::shared_ptr<IFrameMetadataParserContainer> metadataPhasers_;
+    mutable FrameMetadataCache                     metadataCache_;
     std::shared_ptr<const StreamProfile>           streamProfile_;
     uint64_t                                       frameToken_ = 0;
     std::shared_ptr<const DeviceInfo>              deviceInfo_;
 
     const OBFrameType type_;  // Determined during construction, it is an inherent property of the object and cannot be changed.
+    uint32_t          classMask_;  // FrameClassBit, each constructor adds the bit of its class
 
 private:
-    uint8_t const         *frameData_;
-    const size_t           dataBufSize_;
-    FrameBufferReclaimFunc bufferReclaimFunc_;
+    mutable uint8_t const               *frameData_;
+    const size_t                         dataBufSize_;
+    mutable FrameBufferReclaimFunc       bufferReclaimFunc_;
+    mutable std::atomic<bool>            dataShared_;
+    mutable std::shared_ptr<const Frame> dataOwner_;        // frame owning the data buffer, see markDataShared
+    mutable std::shared_ptr<const Frame> sharedDataOwner_;  // owner of the shared data, kept after the copy-on-write
 };
 
 class VideoFrame : public Frame {
@@ -268,6 +380,35 @@ public:
     float       temperature() const;
 };
 
+// Consecutive samples of one IMU stream (accel or gyro), stored in the data buffer as a header followed by one array per field
+class ImuBatchFrame : public Frame {
+public:
+    // Mutable view of the sample arrays, see OBImuBatchData
+    typedef struct {
+        uint64_t *timestamp;
+        float    *x;
+        float    *y;
+        float    *z;
+        float    *temperature;
+    } Arrays;
+
+public:
+    ImuBatchFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc = nullptr);
+
+    // Data buffer size of a batch that holds up to capacity samples
+    static size_t calcDataSize(uint32_t capacity);
+
+    uint32_t getCapacity() const;
+    uint32_t getSampleCount() const;
+    void     setSampleCount(uint32_t count);  // throws if count exceeds the capacity
+
+    OBImuBatchData getBatchData() const;
+    Arrays         getArraysMutable();
+
+private:
+    uint32_t capacity_;
+};
+
 class LiDARPointsFrame : public Frame {
 public:
     LiDARPointsFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc = nullptr);
@@ -7,12 +7,24 @@
 #include "environment/EnvConfig.hpp"
 #include "exception/ObException.hpp"
 #include "logger/Logger.hpp"
+#include "utils/Utils.hpp"
+
+#include <algorithm>
 
 namespace libobsensor {
 
 #define DEFAULT_MAX_FRAME_MEMORY_SIZE ((uint64_t)2 * 1024 * 1024 * 1024)  // 2GB
+#define HUGE_PAGE_MIN_BUFFER_SIZE ((size_t)2 * 1024 * 1024)               // 2MB, size of a huge page on x86_64 and aarch64
 
-FrameMemoryAllocator::FrameMemoryAllocator() : maxSizeInByte_(DEFAULT_MAX_FRAME_MEMORY_SIZE), usedSize_(0), logger_(Logger::getInstance()) {
+FrameMemoryAllocator::FrameMemoryAllocator()
+    : maxSizeInByte_(DEFAULT_MAX_FRAME_MEMORY_SIZE),
+      usedSize_(0),
+      contentions_(0),
+      lockMemory_(false),
+      useHugePages_(false),
+      lockMemoryFailed_(false),
+      shardedCache_(nullptr),
+      logger_(Logger::getInstance()) {
     auto envConfig = EnvConfig::getInstance();
 
     if(envConfig->isNodeContained("Memory.MaxFrameBufferSize")) {
@@ -24,10 +36,27 @@ FrameMemoryAllocator::FrameMemoryAllocator() : maxSizeInByte_(DEFAULT_MAX_FRAME_
         }
         maxSizeInByte_ = static_cast<uint64_t>(frameBufferSize) * 1024 * 1024;  // MB to Byte
     }
-    LOG_DEBUG("FrameMemoryAllocator created! The max frame memory size has been set to {:.3f}MB", byteToMB(maxSizeInByte_));
+
+    envConfig->getBooleanValue("Memory.LockFrameBuffers", lockMemory_);
+    envConfig->getBooleanValue("Memory.UseHugePages", useHugePages_);
+
+    bool shardedAllocator = false;
+    envConfig->getBooleanValue("Memory.ShardedAllocator", shardedAllocator);
+    if(shardedAllocator) {
+        shardedCache_ = std::make_shared<ShardedFrameBufferCache>(this);
+    }
+    LOG_DEBUG("FrameMemoryAllocator created! The max frame memory size has been set to {:.3f}MB, sharded allocator mode: {}", byteToMB(maxSizeInByte_),
+              shardedAllocator);
 }
 
 FrameMemoryAllocator::~FrameMemoryAllocator() noexcept {
+    if(shardedCache_) {
+        auto stats = getStats();
+        LOG_DEBUG("Sharded frame buffer cache statistics: magazine hits={}, depot hits={}, misses={}, contentions={}", stats.magazineHits, stats.depotHits,
+                  stats.misses, stats.contentions);
+        shardedCache_->detach();
+        shardedCache_.reset();
+    }
     if(usedSize_ > 0) {
         LOG_WARN("FrameMemoryAllocator destroyed while still has memory used! usedSize={0:.3f}MB", byteToMB(usedSize_));
     }
@@ -46,55 +75,96 @@ std::shared_ptr<FrameMemoryAllocator> FrameMemoryAllocator::getInstance() {
 }
 
 void FrameMemoryAllocator::setMaxFrameMemorySize(uint64_t sizeInMb) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    maxSizeInByte_ = sizeInMb * 1024 * 1024;
-    if(maxSizeInByte_ < usedSize_) {
-        LOG_WARN("The max frame memory size you set is {:.3f}MB,  less than the current used size, will set to {:.3f}MB instead", byteToMB(maxSizeInByte_),
+    uint64_t maxSizeInByte = sizeInMb * 1024 * 1024;
+    if(maxSizeInByte < usedSize_) {
+        LOG_WARN("The max frame memory size you set is {:.3f}MB,  less than the current used size, will set to {:.3f}MB instead", byteToMB(maxSizeInByte),
                  byteToMB(usedSize_));
     }
     if(sizeInMb < 100) {  // 100 MB
         LOG_WARN("The size you is less than 100MB, size={:.3f}MB, will set to 100MB instead", (double)sizeInMb);
-        maxSizeInByte_ = 100 * 1024 * 1024;
+        maxSizeInByte = 100 * 1024 * 1024;
     }
+    maxSizeInByte_ = maxSizeInByte;
     LOG_DEBUG("FrameMemoryAllocator max frame memory size has been set to {:.3f}MB", byteToMB(maxSizeInByte_));
 }
 
+uint64_t FrameMemoryAllocator::getAvailableSize() const {
+    uint64_t maxSize  = maxSizeInByte_.load(std::memory_order_relaxed);
+    uint64_t usedSize = usedSize_.load(std::memory_order_relaxed);
+    return maxSize > usedSize ? maxSize - usedSize : 0;
+}
+
 uint8_t *FrameMemoryAllocator::allocate(size_t size) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    if(usedSize_ + size > maxSizeInByte_) {
-        LOG_WARN("FrameMemoryAllocator out of memory! require={0:.3f}MB, total usage: allocated={1:.3f}MB, max limit={2:.3f}MB", byteToMB(size),
-                 byteToMB(usedSize_), byteToMB(maxSizeInByte_));
-        return nullptr;
-    }
+    // Reserve the budget first, so that concurrent allocations never exceed the limit
+    uint64_t usedSize = usedSize_.load(std::memory_order_relaxed);
+    do {
+        if(usedSize + size > maxSizeInByte_.load(std::memory_order_relaxed)) {
+            LOG_WARN("FrameMemoryAllocator out of memory! require={0:.3f}MB, total usage: allocated={1:.3f}MB, max limit={2:.3f}MB", byteToMB(size),
+                     byteToMB(usedSize), byteToMB(maxSizeInByte_));
+            return nullptr;
+        }
+        if(usedSize_.compare_exchange_weak(usedSize, usedSize + size, std::memory_order_relaxed)) {
+            break;
+        }
+        contentions_.fetch_add(1, std::memory_order_relaxed);
+    } while(true);
 
     void *ptr = malloc(size);
     if(ptr == nullptr || reinterpret_cast<uintptr_t>(ptr) == 0xdddddddd) {
         LOG_ERROR("FrameMemoryAllocator malloc failed! ptr={0:x}", (uintptr_t)ptr);
+        usedSize_.fetch_sub(size, std::memory_order_relaxed);
         return nullptr;
     }
 
-    memset(ptr, 0, size);
-    usedSize_ += size;
-    LOG_DEBUG("New frame buffer allocated={0:.3f}MB, total usage: allocated={1:.3f}MB, max limit={2:.3f}MB", byteToMB(size), byteToMB(usedSize_),
+    if(useHugePages_ && size >= HUGE_PAGE_MIN_BUFFER_SIZE) {
+        utils::adviseHugePages(ptr, size);
+    }
+    memset(ptr, 0, size);  // also commits the pages
+    if(lockMemory_ && !lockMemoryFailed_.load(std::memory_order_relaxed) && !utils::lockMemory(ptr, size)) {
+        lockMemoryFailed_.store(true, std::memory_order_relaxed);
+        LOG_WARN("Failed to lock frame buffer in physical memory, the memory lock limit may be too small. Frame buffers will not be locked anymore.");
+    }
+    LOG_DEBUG("New frame buffer allocated={0:.3f}MB, total usage: allocated={1:.3f}MB, max limit={2:.3f}MB", byteToMB(size), byteToMB(usedSize + size),
               byteToMB(maxSizeInByte_));
     return (uint8_t *)ptr;
 }
 
 void FrameMemoryAllocator::deallocate(uint8_t *ptr, size_t size) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    usedSize_ -= size;
+    if(lockMemory_) {
+        utils::unlockMemory(ptr, size);
+    }
     free(ptr);
-    LOG_DEBUG("Frame buffer released={0:.3f}MB, total usage: allocated={1:.3f}MB, max limit={2:.3f}MB", byteToMB(size), byteToMB(usedSize_),
+    auto usedSize = usedSize_.fetch_sub(size, std::memory_order_relaxed) - size;
+    LOG_DEBUG("Frame buffer released={0:.3f}MB, total usage: allocated={1:.3f}MB, max limit={2:.3f}MB", byteToMB(size), byteToMB(usedSize),
               byteToMB(maxSizeInByte_));
 }
 
+std::shared_ptr<ShardedFrameBufferCache> FrameMemoryAllocator::getShardedCache() const {
+    return shardedCache_;
+}
+
+FrameMemoryAllocatorStats FrameMemoryAllocator::getStats() const {
+    FrameMemoryAllocatorStats stats{};
+    if(shardedCache_) {
+        shardedCache_->getStats(stats);
+    }
+    stats.contentions += contentions_.load(std::memory_order_relaxed);
+    stats.usedSize = usedSize_.load(std::memory_order_relaxed);
+    stats.maxSize  = maxSizeInByte_.load(std::memory_order_relaxed);
+    return stats;
+}
+
 FrameBufferManagerBase::FrameBufferManagerBase(size_t frameDataBufferSize, size_t frameObjSize)
-    : frameDataBufferSize_(frameDataBufferSize), frameObjSize_(frameObjSize), frameMemoryAllocator_(FrameMemoryAllocator::getInstance()) {
+    : frameDataBufferSize_(frameDataBufferSize),
+      frameObjSize_(frameObjSize),
+      frameMemoryAllocator_(FrameMemoryAllocator::getInstance()),
+      shardedCache_(frameMemoryAllocator_->getShardedCache()) {
     frameTotalSize_ = frameDataBufferSize_ + frameObjSize_ + FRAME_DATA_ALIGN_IN_BYTE
                       - 1;  // Apply for more FRAME_DATA_ALIGN_IN_BYTE-1 to facilitate offset part of the data address and achieve alignment
 }
 
 FrameBufferManagerBase::~FrameBufferManagerBase() noexcept {
+    // In sharded mode the idle buffers are kept by the shared size class cache, and can be reused by other buffer managers
     std::unique_lock<std::recursive_mutex> lock_(mutex_);
     while(!availableFrameBuffers_.empty()) {
         frameMemoryAllocator_->deallocate(availableFrameBuffers_.front(), frameTotalSize_);
@@ -103,52 +173,89 @@ FrameBufferManagerBase::~FrameBufferManagerBase() noexcept {
     LOG_DEBUG("FrameBufferManagerBase destroyed! manager type:{0},  obj addr:0x{1:x}", typeid(*this).name(), uint64_t(this));
 }
 
+uint8_t *FrameBufferManagerBase::allocateBuffer() {
+    if(shardedCache_) {
+        return shardedCache_->acquire(frameTotalSize_);
+    }
+    return frameMemoryAllocator_->allocate(frameTotalSize_);
+}
+
 uint8_t *FrameBufferManagerBase::acquireBuffer() {
-    std::unique_lock<std::recursive_mutex> lock_(mutex_);
-    uint8_t                               *bufferPtr = nullptr;
-    if(!availableFrameBuffers_.empty()) {
-        bufferPtr = *availableFrameBuffers_.begin();
-        availableFrameBuffers_.erase(availableFrameBuffers_.begin());
+    uint8_t *bufferPtr = nullptr;
+    if(!shardedCache_) {
+        std::unique_lock<std::recursive_mutex> lock_(mutex_);
+        if(!availableFrameBuffers_.empty()) {
+            bufferPtr = *availableFrameBuffers_.begin();
+            availableFrameBuffers_.erase(availableFrameBuffers_.begin());
+            return bufferPtr;
+        }
     }
-    else {
-        bufferPtr = frameMemoryAllocator_->allocate(frameTotalSize_);
+
+    bufferPtr = allocateBuffer();
+    if(bufferPtr == nullptr) {
+        LOG_WARN("allocBuffer failed! Will retry after release idle memory on FrameMemoryPool");
+        auto memoryPool = FrameMemoryPool::getInstance();
+        memoryPool->freeIdleMemory();
+        bufferPtr = allocateBuffer();
         if(bufferPtr == nullptr) {
-            LOG_WARN("allocBuffer failed! Will retry after release idle memory on FrameMemoryPool");
-            auto memoryPool = FrameMemoryPool::getInstance();
-            memoryPool->freeIdleMemory();
-            bufferPtr = frameMemoryAllocator_->allocate(frameTotalSize_);
-            if(bufferPtr == nullptr) {
-                auto msg = std::string("Alloc frame buffer failed! size=") + std::to_string(frameTotalSize_);
-                LOG_FATAL(msg);
-                THROW_MEMORY_EXCEPTION(msg);
-            }
+            auto msg = std::string("Alloc frame buffer failed! size=") + std::to_string(frameTotalSize_);
+            LOG_FATAL(msg);
+            THROW_MEMORY_EXCEPTION(msg);
         }
     }
     return bufferPtr;
 }
 
-std::unique_lock<std::recursive_mutex> FrameBufferManagerBase::lockBuffers() {
-    std::unique_lock<std::recursive_mutex> lock_(mutex_);
-    return lock_;
-}
-
 void FrameBufferManagerBase::reclaimBuffer(void *buffer) {
+    if(shardedCache_) {
+        shardedCache_->reclaim((uint8_t *)buffer, frameTotalSize_);
+        return;
+    }
+
     std::unique_lock<std::recursive_mutex> lock_(mutex_);
     availableFrameBuffers_.push_back((uint8_t *)buffer);
 
     if(availableFrameBuffers_.size() > 100) {
         // Release the memory in time when there are enough availableFrameBuffers_
-        // The current buffer cannot be deleted directly, which will cause frame destruction and crash.
         frameMemoryAllocator_->deallocate(availableFrameBuffers_.front(), frameTotalSize_);
         availableFrameBuffers_.erase(availableFrameBuffers_.begin());
     }
 }
 
+size_t FrameBufferManagerBase::getFrameBufferTotalSize() {
+    if(shardedCache_) {
+        auto sizeClass = ShardedFrameBufferCache::sizeClassOf(frameTotalSize_);
+        if(sizeClass != ShardedFrameBufferCache::kInvalidSizeClass) {
+            return ShardedFrameBufferCache::classSizeOf(sizeClass);
+        }
+    }
+    return frameTotalSize_;
+}
+
+size_t FrameBufferManagerBase::reserveBuffers(size_t count) {
+    if(shardedCache_) {
+        return shardedCache_->reserve(frameTotalSize_, count);
+    }
+
+    std::unique_lock<std::recursive_mutex> lock_(mutex_);
+    while(availableFrameBuffers_.size() < count) {
+        auto bufferPtr = frameMemoryAllocator_->allocate(frameTotalSize_);
+        if(bufferPtr == nullptr) {
+            break;
+        }
+        availableFrameBuffers_.push_back(bufferPtr);
+    }
+    return std::min(availableFrameBuffers_.size(), count);
+}
+
 void FrameBufferManagerBase::releaseIdleBuffer() {
+    if(shardedCache_) {
+        shardedCache_->releaseIdle(frameTotalSize_);
+        return;
+    }
+
     std::unique_lock<std::recursive_mutex> lock_(mutex_);
     while(!availableFrameBuffers_.empty()) {
-        // Release the memory in time when there are enough availableFrameBuffers_
-        // The current buffer cannot be deleted directly, which will cause frame destruction and crash.
         frameMemoryAllocator_->deallocate(availableFrameBuffers_.front(), frameTotalSize_);
         availableFrameBuffers_.erase(availableFrameBuffers_.begin());
     }
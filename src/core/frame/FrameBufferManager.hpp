@@ -3,10 +3,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <vector>
 #include "frame/Frame.hpp"
+#include "frame/ShardedFrameBufferCache.hpp"
 #include "logger/Logger.hpp"
 
 #define FRAME_DATA_ALIGN_IN_BYTE 16  // 16-byte alignment
@@ -25,13 +27,23 @@ public:
     ~FrameMemoryAllocator() noexcept;
 
     void     setMaxFrameMemorySize(uint64_t sizeInMb);
+    uint64_t getAvailableSize() const;
     uint8_t *allocate(size_t size);
     void     deallocate(uint8_t *ptr, size_t size);
 
+    // Returns the size class sharded buffer cache, or nullptr if the sharded allocator mode is disabled.
+    std::shared_ptr<ShardedFrameBufferCache> getShardedCache() const;
+    FrameMemoryAllocatorStats                getStats() const;
+
 private:
-    uint64_t   maxSizeInByte_;
-    uint64_t   usedSize_;
-    std::mutex mutex_;
+    std::atomic<uint64_t> maxSizeInByte_;
+    std::atomic<uint64_t> usedSize_;
+    std::atomic<uint64_t> contentions_;
+    bool                  lockMemory_;      // pin frame buffers in physical memory
+    bool                  useHugePages_;    // advise transparent huge pages for large frame buffers
+    std::atomic<bool>     lockMemoryFailed_;
+
+    std::shared_ptr<ShardedFrameBufferCache> shardedCache_;
 
     std::shared_ptr<Logger> logger_;  // Manages the lifecycle of the logger object.
 };
@@ -42,6 +54,12 @@ public:
     virtual void   reclaimBuffer(void *buffer) = 0;
     virtual void   releaseIdleBuffer()         = 0;
     virtual size_t getFrameDataBufferSize()    = 0;
+    // Memory taken by each buffer: the frame data, the frame object and the alignment padding, rounded up to the size class in sharded mode.
+    virtual size_t getFrameBufferTotalSize() = 0;
+
+    // Pre-allocate idle buffers until count buffers are available, so that the first frames do not pay for allocation and page faults.
+    // Returns the number of idle buffers available, less than count if the memory budget is exhausted or the idle buffer cache is full.
+    virtual size_t reserveBuffers(size_t count) = 0;
 
 private:
     virtual std::shared_ptr<Frame> acquireFrame() = 0;
@@ -62,12 +80,15 @@ public:
     size_t getFrameDataBufferSize() override {
         return frameDataBufferSize_;
     }
-
-    std::unique_lock<std::recursive_mutex> lockBuffers();
+    size_t getFrameBufferTotalSize() override;
+    size_t reserveBuffers(size_t count) override;
 
 protected:
     uint8_t *acquireBuffer();
 
+private:
+    uint8_t *allocateBuffer();
+
 protected:
     std::recursive_mutex mutex_;
     size_t               frameDataBufferSize_;
@@ -75,8 +96,9 @@ protected:
     size_t               frameTotalSize_;
 
 private:
-    std::vector<uint8_t *>                availableFrameBuffers_;
-    std::shared_ptr<FrameMemoryAllocator> frameMemoryAllocator_;
+    std::vector<uint8_t *>                   availableFrameBuffers_;
+    std::shared_ptr<FrameMemoryAllocator>    frameMemoryAllocator_;
+    std::shared_ptr<ShardedFrameBufferCache> shardedCache_;  // not null in sharded allocator mode, replaces availableFrameBuffers_
 };
 
 class FrameMemoryPool;
@@ -106,18 +128,14 @@ private:
             // 2. Custom deletion function construction of shared_ptr
             // 3. You need to pass bufMgr into the smart pointer custom deletion function lambda to add a reference, otherwise bufMgr may be destructed first
             // when frame->~T(), the memory will be recycled in advance, and the frame destructor will crash.
+            // 4. The buffer is reclaimed by the deletion function after the frame destructor has completed, so that it can not be handed out to a new
+            // frame while the original frame is still being destroyed. No lock is required on this path.
             auto bufMgr = this->shared_from_this();
             return std::shared_ptr<T>(new(bufferPtr) T(bufferPtr + frameObjSize_ + alignOffset, frameDataBufferSize_,
-                                                       [bufMgr, bufferPtr]() {  // Customized frame buffer release function
-                                                           bufMgr->reclaimBuffer(bufferPtr);
-                                                       }),
-                                      [bufMgr](T *frame) mutable {  // Custom shared_pt delete function
-                                          // Purpose of locking: To solve the problem of the buffer being used to create a new frame just after it is returned,
-                                          // causing the subsequent destruction operation of the original frame to modify the new frame and causing the program
-                                          // to crash.
-                                          auto lk = bufMgr->lockBuffers();
+                                                       []() {}),  // The frame buffer is owned by the buffer manager
+                                      [bufMgr, bufferPtr](T *frame) mutable {  // Custom shared_pt delete function
                                           frame->~T();
-                                          lk.unlock();
+                                          bufMgr->reclaimBuffer(bufferPtr);
                                           bufMgr.reset();
                                       });
         }
@@ -45,6 +45,14 @@ std::shared_ptr<Frame> FrameFactory::createFrameFromOtherFrame(std::shared_ptr<c
         }
         return newFrameSet;
     }
+    else if(frame->getType() == OB_FRAME_IMU_BATCH) {
+        auto newFrame = createImuBatchFrame(frame->getStreamProfile(), frame->as<ImuBatchFrame>()->getCapacity());
+        if(shouldCopyData) {
+            newFrame->updateData(frame->getData(), frame->getDataSize());
+        }
+        newFrame->copyInfoFromOther(frame);
+        return newFrame;
+    }
     else {
         auto newFrame = createFrameFromStreamProfile(frame->getStreamProfile());
         if(shouldCopyData) {
@@ -55,6 +63,50 @@ std::shared_ptr<Frame> FrameFactory::createFrameFromOtherFrame(std::shared_ptr<c
     }
 }
 
+std::shared_ptr<Frame> FrameFactory::createFrameView(std::shared_ptr<const Frame> frame) {
+    if(frame->is<FrameSet>()) {
+        auto newFrameSet = createFrameSet();
+        auto frameSet    = frame->as<FrameSet>();
+        auto frameCount  = frameSet->getCount();
+        for(uint32_t i = 0; i < frameCount; i++) {
+            newFrameSet->pushFrame(createFrameView(frameSet->getFrame(i)));
+        }
+        return newFrameSet;
+    }
+
+    switch(frame->getType()) {
+    case OB_FRAME_VIDEO:
+    case OB_FRAME_DEPTH:
+    case OB_FRAME_IR_LEFT:
+    case OB_FRAME_IR_RIGHT:
+    case OB_FRAME_IR:
+    case OB_FRAME_COLOR:
+    case OB_FRAME_COLOR_LEFT:
+    case OB_FRAME_COLOR_RIGHT:
+    case OB_FRAME_CONFIDENCE:
+    case OB_FRAME_ACCEL:
+    case OB_FRAME_GYRO:
+    case OB_FRAME_LIDAR_POINTS:
+        break;
+    default:
+        return createFrameFromOtherFrame(frame, true);
+    }
+
+    // The view holds the frame owning the data buffer: the source itself, or the owner of its data if the source is a view too, which may copy
+    // its data and drop its owner at any time
+    const uint8_t *data  = nullptr;
+    auto           owner = frame->getDataOwner(&data);
+    if(!owner) {
+        owner = frame;
+    }
+    auto newFrame = createFrameFromUserBuffer(frame->getType(), frame->getFormat(), const_cast<uint8_t *>(data), frame->getDataBufSize(), []() {});
+    newFrame->setStreamProfile(frame->getStreamProfile());
+    newFrame->setDataSize(frame->getDataSize());
+    newFrame->copyInfoFromOther(frame);
+    newFrame->markDataShared(std::move(owner));
+    return newFrame;
+}
+
 std::shared_ptr<Frame> FrameFactory::createVideoFrame(OBFrameType frameType, OBFormat frameFormat, uint32_t width, uint32_t height, uint32_t strideBytes) {
     if(frameType == OB_FRAME_UNKNOWN || frameType == OB_FRAME_ACCEL || frameType == OB_FRAME_GYRO || frameType == OB_FRAME_SET
        || frameType == OB_FRAME_LIDAR_POINTS) {
@@ -245,9 +297,30 @@ std::shared_ptr<Frame> FrameFactory::createFrameFromStreamProfile(std::shared_pt
     return frame;
 }
 
+std::shared_ptr<ImuBatchFrame> FrameFactory::createImuBatchFrame(std::shared_ptr<const StreamProfile> sp, uint32_t capacity) {
+    if(sp->getType() != OB_STREAM_ACCEL && sp->getType() != OB_STREAM_GYRO) {
+        THROW_INVALID_PARAM_EXCEPTION("Invalid stream type for imu batch frame.");
+    }
+
+    auto memoryPool    = libobsensor::FrameMemoryPool::getInstance();
+    auto bufferManager = memoryPool->createFrameBufferManager(OB_FRAME_IMU_BATCH, ImuBatchFrame::calcDataSize(capacity));
+
+    auto frame = bufferManager->acquireFrame();
+    if(frame == nullptr) {
+        THROW_MEMORY_EXCEPTION("Failed to create frame, out of memory or other memory allocation error.");
+    }
+
+    frame->setStreamProfile(sp);
+    return std::static_pointer_cast<ImuBatchFrame>(frame);
+}
+
+size_t FrameFactory::getFrameSetDataSize() {
+    return OB_FRAME_TYPE_COUNT * sizeof(std::shared_ptr<Frame>);
+}
+
 std::shared_ptr<FrameSet> FrameFactory::createFrameSet() {
     auto memoryPool            = libobsensor::FrameMemoryPool::getInstance();
-    auto frameSetBufferManager = memoryPool->createFrameBufferManager(OB_FRAME_SET, OB_FRAME_TYPE_COUNT * sizeof(std::shared_ptr<Frame>));
+    auto frameSetBufferManager = memoryPool->createFrameBufferManager(OB_FRAME_SET, getFrameSetDataSize());
 
     auto frame = frameSetBufferManager->acquireFrame();
     if(frame == nullptr) {
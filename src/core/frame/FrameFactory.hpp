@@ -14,6 +14,10 @@ public:
     static std::shared_ptr<Frame> createVideoFrame(OBFrameType frameType, OBFormat frameFormat, uint32_t width, uint32_t height, uint32_t strideBytes);
     static std::shared_ptr<Frame> createFrameFromOtherFrame(std::shared_ptr<const Frame> frame, bool shouldCopyData = false);
 
+    // Same as createFrameFromOtherFrame(frame, true) without copying the data: the new frame reads the data of frame (whose owner it keeps alive) and
+    // copies it on its first getDataMutable(), see Frame::markDataShared. For the pass-through and metadata-only stages of the filters.
+    static std::shared_ptr<Frame> createFrameView(std::shared_ptr<const Frame> frame);
+
     static std::shared_ptr<Frame> createFrameFromUserBuffer(OBFrameType frameType, OBFormat format, uint8_t *buffer, size_t bufferSize,
                                                             FrameBufferReclaimFunc bufferReclaimFunc);
     // todo: add commit for these overloads functions
@@ -26,6 +30,10 @@ public:
 
     static std::shared_ptr<Frame> createFrameFromStreamProfile(std::shared_ptr<const StreamProfile> sp);
 
+    // Creates an empty batch for up to capacity samples of the accel or gyro stream of sp
+    static std::shared_ptr<ImuBatchFrame> createImuBatchFrame(std::shared_ptr<const StreamProfile> sp, uint32_t capacity);
+
     static std::shared_ptr<FrameSet> createFrameSet();
+    static size_t                    getFrameSetDataSize();
 };
 }  // namespace libobsensor
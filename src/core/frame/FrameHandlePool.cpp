@@ -0,0 +1,89 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "FrameHandlePool.hpp"
+#include "IFrame.hpp"
+
+#include <new>
+
+namespace libobsensor {
+
+namespace {
+const size_t MAX_THREAD_FREE_HANDLES = 64;
+// Enough for the frames of several framesets in flight on all the streams
+const size_t MAX_SHARED_FREE_HANDLES = 1024;
+
+thread_local bool threadFreeListDestroyed = false;
+}  // namespace
+
+FrameHandlePool::ThreadFreeList::~ThreadFreeList() {
+    threadFreeListDestroyed = true;
+    for(auto handle: handles) {
+        releaseShared(handle);
+    }
+}
+
+FrameHandlePool::SharedFreeList &FrameHandlePool::sharedFreeList() {
+    // Never destroyed: frames may still be deleted by the destructors of other static objects
+    static SharedFreeList *list = new SharedFreeList();
+    return *list;
+}
+
+FrameHandlePool::ThreadFreeList *FrameHandlePool::threadFreeList() {
+    if(threadFreeListDestroyed) {
+        return nullptr;
+    }
+    thread_local ThreadFreeList list;
+    return &list;
+}
+
+void *FrameHandlePool::acquire(size_t handleSize) {
+    auto cache = threadFreeList();
+    if(cache && !cache->handles.empty()) {
+        void *handle = cache->handles.back();
+        cache->handles.pop_back();
+        return handle;
+    }
+
+    auto                       &shared = sharedFreeList();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    if(!shared.handles.empty()) {
+        void *handle = shared.handles.back();
+        shared.handles.pop_back();
+        return handle;
+    }
+    return ::operator new(handleSize);
+}
+
+void FrameHandlePool::release(void *handle) {
+    auto cache = threadFreeList();
+    if(cache && cache->handles.size() < MAX_THREAD_FREE_HANDLES) {
+        cache->handles.push_back(handle);
+        return;
+    }
+    releaseShared(handle);
+}
+
+void FrameHandlePool::releaseShared(void *handle) {
+    {
+        auto                       &shared = sharedFreeList();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        if(shared.handles.size() < MAX_SHARED_FREE_HANDLES) {
+            shared.handles.push_back(handle);
+            return;
+        }
+    }
+    ::operator delete(handle);
+}
+
+}  // namespace libobsensor
+
+void *ob_frame_t::operator new(size_t size) {
+    return libobsensor::FrameHandlePool::acquire(size);
+}
+
+void ob_frame_t::operator delete(void *ptr) {
+    if(ptr) {
+        libobsensor::FrameHandlePool::release(ptr);
+    }
+}
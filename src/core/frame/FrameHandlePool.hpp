@@ -0,0 +1,41 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace libobsensor {
+
+/**
+ * @brief Free lists of the memory of the ob_frame handles of the c api (see ob_frame_t::operator new): a frame handle is created for each
+ * frame delivered to the user, the memory of the deleted handles is reused instead of going back to the heap.
+ * @brief Each thread has its own free list, the handles beyond its capacity go to a free list shared by the threads: the handles are usually
+ * created on the stream threads and deleted on the user threads.
+ */
+class FrameHandlePool {
+public:
+    // Memory for one handle (handleSize is sizeof(ob_frame), all the handles have the same size), from the free lists if not empty
+    static void *acquire(size_t handleSize);
+    // Back to the free lists, or to the heap if they are full
+    static void release(void *handle);
+
+private:
+    struct SharedFreeList {
+        std::mutex          mutex;
+        std::vector<void *> handles;
+    };
+
+    struct ThreadFreeList {
+        std::vector<void *> handles;
+        ~ThreadFreeList();
+    };
+
+    static SharedFreeList &sharedFreeList();
+    static ThreadFreeList *threadFreeList();  // nullptr once destroyed on this thread
+    static void            releaseShared(void *handle);
+};
+
+}  // namespace libobsensor
@@ -25,6 +25,14 @@ void FrameMemoryPool::setMaxFrameMemorySize(uint64_t sizeInMB) {
     FrameMemoryAllocator::getInstance()->setMaxFrameMemorySize(sizeInMB);
 }
 
+FrameMemoryAllocatorStats FrameMemoryPool::getAllocatorStats() {
+    return FrameMemoryAllocator::getInstance()->getStats();
+}
+
+uint64_t FrameMemoryPool::getAvailableMemorySize() {
+    return FrameMemoryAllocator::getInstance()->getAvailableSize();
+}
+
 FrameMemoryPool::FrameMemoryPool() : logger_(Logger::getInstance()) {
     LOG_DEBUG("FrameMemoryPool created!");
 }
@@ -93,6 +101,10 @@ std::shared_ptr<IFrameBufferManager> FrameMemoryPool::createFrameBufferManager(O
         frameBufMgr = std::shared_ptr<FrameBufferManager<PointsFrame>>(new FrameBufferManager<PointsFrame>(frameBufferSize));
         LOG_DEBUG("PointsFrame bufferManager created!");
         break;
+    case OB_FRAME_IMU_BATCH:
+        frameBufMgr = std::shared_ptr<FrameBufferManager<ImuBatchFrame>>(new FrameBufferManager<ImuBatchFrame>(frameBufferSize));
+        LOG_DEBUG("ImuBatchFrame bufferManager created!");
+        break;
     case OB_FRAME_LIDAR_POINTS:
         frameBufMgr = std::shared_ptr<FrameBufferManager<LiDARPointsFrame>>(new FrameBufferManager<LiDARPointsFrame>(frameBufferSize));
         LOG_DEBUG("LiDARPointsFrame bufferManager created!");
@@ -168,6 +180,15 @@ void FrameMemoryPool::freeIdleMemory() {
         }
         vecIter++;
     }
+
+    // Size classes of the sharded cache may still hold buffers of the buffer managers released above
+    auto shardedCache = FrameMemoryAllocator::getInstance()->getShardedCache();
+    if(shardedCache) {
+        shardedCache->releaseAllIdle();
+        auto stats = FrameMemoryAllocator::getInstance()->getStats();
+        LOG_DEBUG("Sharded frame buffer cache statistics: magazine hits={}, depot hits={}, misses={}, contentions={}, used={:.3f}MB", stats.magazineHits,
+                  stats.depotHits, stats.misses, stats.contentions, byteToMB(stats.usedSize));
+    }
 }
 
 }  // namespace libobsensor
@@ -38,6 +38,8 @@ public:
     ~FrameMemoryPool() noexcept;
     static std::shared_ptr<FrameMemoryPool> getInstance();
     static void                             setMaxFrameMemorySize(uint64_t sizeInMB);
+    static FrameMemoryAllocatorStats        getAllocatorStats();
+    static uint64_t                         getAvailableMemorySize();
 
     std::shared_ptr<IFrameBufferManager> createFrameBufferManager(OBFrameType type, size_t frameBufferSize);
     std::shared_ptr<IFrameBufferManager> createFrameBufferManager(OBFrameType type, std::shared_ptr<const StreamProfile> streamProfile);
@@ -0,0 +1,358 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "frame/Frame.hpp"
+#include "frame/SpscFrameQueue.hpp"
+#include "exception/ObException.hpp"
+#include "utils/SteadyCondVar.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace libobsensor {
+
+// MPSC (Multi Producer Single Consumer) bounded frame queue with FrameQueue-compatible API.
+//
+// Design notes:
+//   - Bounded array queue with a sequence number per slot (D. Vyukov). Producers claim a slot with a single CAS on the enqueue index, the
+//     slot sequence number publishes the frame to the consumer. Physical buffer size is the next power of 2 of the capacity.
+//   - The dequeue side is also CAS based, which allows producers to evict the oldest frame in enforceEnqueue while the consumer is
+//     running. Several threads calling dequeue concurrently is therefore safe as well.
+//   - Logical capacity is checked before claiming a slot; with concurrent producers it may be exceeded by at most the number of
+//     producers, never beyond the physical buffer size.
+//   - enqueue / enforceEnqueue / dequeue fast paths are lock-free. The signal mutex is only taken to wake a sleeping consumer.
+template <typename T = Frame> class MpscFrameQueue {
+    static size_t nextPow2(size_t n) {
+        size_t p = 1;
+        while(p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    static constexpr size_t ATOMIC_SIZE     = sizeof(std::atomic<size_t>);
+    static constexpr size_t PADDING_SIZE    = (ATOMIC_SIZE >= CACHE_LINE_SIZE) ? 0 : (CACHE_LINE_SIZE - ATOMIC_SIZE);
+
+    struct CacheLineAtomicSizeT {
+        std::atomic<size_t>                 value;
+        SpscFrameQueuePadding<PADDING_SIZE> pad;
+    };
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        std::shared_ptr<T>  frame;
+    };
+
+public:
+    explicit MpscFrameQueue(size_t capacity)
+        : capacity_((std::max)(capacity, size_t(2))),
+          bufferSize_(nextPow2(capacity_)),
+          mask_(bufferSize_ - 1),
+          cells_(new Cell[bufferSize_]),
+          enqueueIdx_(),
+          dequeueIdx_(),
+          waiterCount_(0),
+          stopped_(true),
+          stopping_(false),
+          flushing_(false),
+          callback_(nullptr) {
+        for(size_t i = 0; i < bufferSize_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueueIdx_.value.store(0, std::memory_order_relaxed);
+        dequeueIdx_.value.store(0, std::memory_order_relaxed);
+    }
+
+    ~MpscFrameQueue() noexcept {
+        reset();
+    }
+
+    size_t capacity() const {
+        return capacity_.load(std::memory_order_relaxed);
+    }
+
+    // Change the capacity. Growing beyond the physical buffer size reallocates the buffer, which is only allowed while no other thread
+    // accesses the queue (async dequeue stopped, no producer running).
+    void resize(size_t capacity) {
+        capacity = (std::max)(capacity, size_t(2));
+        if(capacity > bufferSize_) {
+            if(isStarted()) {
+                THROW_WRONG_API_CALL_SEQUENCE_EXCEPTION("MpscFrameQueue can not grow while async dequeue is running!");
+            }
+            MpscFrameQueue<T> grown(capacity);
+            std::shared_ptr<T> frame;
+            while(tryDequeueFrame(frame)) {
+                grown.tryEnqueueFrame(frame);
+            }
+            std::swap(bufferSize_, grown.bufferSize_);
+            std::swap(mask_, grown.mask_);
+            std::swap(cells_, grown.cells_);
+            // The indices belong to the cells, swap them as well so that the old (empty) buffer is released consistently
+            auto enqueueIdx = enqueueIdx_.value.exchange(grown.enqueueIdx_.value.load());
+            auto dequeueIdx = dequeueIdx_.value.exchange(grown.dequeueIdx_.value.load());
+            grown.enqueueIdx_.value.store(enqueueIdx);
+            grown.dequeueIdx_.value.store(dequeueIdx);
+        }
+        capacity_.store(capacity, std::memory_order_relaxed);
+    }
+
+    size_t size() const {
+        const size_t r = dequeueIdx_.value.load(std::memory_order_acquire);
+        const size_t w = enqueueIdx_.value.load(std::memory_order_acquire);
+        return w > r ? w - r : 0;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    bool full() const {
+        return size() >= capacity();
+    }
+
+    // Lock-free. Returns false when stopping, flushing, or queue full.
+    bool enqueue(std::shared_ptr<T> frame) {
+        if(stopping_.load(std::memory_order_acquire) || flushing_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        if(!tryEnqueueFrame(frame)) {
+            return false;
+        }
+        notifyConsumer();
+        return true;
+    }
+
+    // Enqueue a frame, evicting the oldest frames until there is room for it.
+    // Returns false only when stopping or flushing.
+    // Sets dropped = true if an existing frame was evicted.
+    bool enforceEnqueue(std::shared_ptr<T> frame, bool &dropped) {
+        dropped = false;
+        if(stopping_.load(std::memory_order_acquire) || flushing_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        while(!tryEnqueueFrame(frame)) {
+            std::shared_ptr<T> evicted;
+            if(tryDequeueFrame(evicted)) {
+                dropped = true;
+            }
+            else {
+                // The oldest slot is claimed by a producer that has not published its frame yet
+                std::this_thread::yield();
+            }
+        }
+        notifyConsumer();
+        return true;
+    }
+
+    // Blocking dequeue for manual consumption.
+    // Returns nullptr on timeout, when no frame is available, or when async dequeue is running.
+    // Manual dequeue and async dequeue are mutually exclusive.
+    std::shared_ptr<T> dequeue(uint64_t timeoutMsec = 0) {
+        if(isStarted()) {
+            return nullptr;
+        }
+
+        std::shared_ptr<T> frame;
+        if(tryDequeueFrame(frame) || timeoutMsec == 0) {
+            return frame;
+        }
+
+        std::unique_lock<std::mutex> lock(signalMutex_);
+        waiterCount_.fetch_add(1);
+        signal_.wait_for(lock, std::chrono::milliseconds(timeoutMsec),
+                         [&] { return tryDequeueFrame(frame) || stopping_.load(std::memory_order_acquire); });
+        waiterCount_.fetch_sub(1);
+        return frame;
+    }
+
+    // Start async dequeue thread with callback.
+    // Manual dequeue and async dequeue are mutually exclusive.
+    void start(std::function<void(std::shared_ptr<T>)> callback) {
+        if(isStarted()) {
+            THROW_WRONG_API_CALL_SEQUENCE_EXCEPTION("MpscFrameQueue already started!");
+        }
+        callback_ = callback;
+        stopped_.store(false, std::memory_order_release);
+        stopping_.store(false, std::memory_order_release);
+        flushing_.store(false, std::memory_order_release);
+        dequeueThread_ = std::thread([this] {
+            while(true) {
+                std::shared_ptr<T> frame;
+                if(!tryDequeueFrame(frame)) {
+                    // Slow path: wait for signal
+                    std::unique_lock<std::mutex> lock(signalMutex_);
+                    waiterCount_.fetch_add(1);
+                    signal_.wait_for(lock, std::chrono::milliseconds(1000), [&] {
+                        return tryDequeueFrame(frame) || stopping_.load(std::memory_order_acquire) || flushing_.load(std::memory_order_acquire);
+                    });
+                    waiterCount_.fetch_sub(1);
+
+                    if(stopping_.load(std::memory_order_acquire)) {
+                        break;
+                    }
+                    if(!frame && flushing_.load(std::memory_order_acquire) && !tryDequeueFrame(frame)) {
+                        break;
+                    }
+                }
+
+                if(frame) {
+                    try {
+                        callback_(frame);
+                    }
+                    catch(...) {
+                    }
+                }
+            }
+            stopped_.store(true, std::memory_order_release);
+        });
+    }
+
+    bool isStarted() const {
+        return !stopped_.load(std::memory_order_acquire);
+    }
+
+    // Wait until all queued frames have been delivered to the async callback, then stop async dequeue.
+    void flush() {
+        {
+            std::unique_lock<std::mutex> lock(signalMutex_);
+            flushing_.store(true, std::memory_order_release);
+            signal_.notify_all();
+        }
+        std::thread t;
+        {
+            std::lock_guard<std::mutex> lock(threadMutex_);
+            t = std::move(dequeueThread_);
+        }
+        if(t.joinable()) {
+            t.join();
+        }
+        stopped_.store(true, std::memory_order_release);
+        flushing_.store(false, std::memory_order_release);
+    }
+
+    // Stop async dequeue immediately and discard currently queued frames.
+    // The queue remains reusable and can accept frames after stop() returns.
+    void stop() {
+        {
+            std::unique_lock<std::mutex> lock(signalMutex_);
+            stopping_.store(true, std::memory_order_release);
+            signal_.notify_all();
+        }
+        std::thread t;
+        {
+            std::lock_guard<std::mutex> lock(threadMutex_);
+            t = std::move(dequeueThread_);
+        }
+        if(t.joinable()) {
+            t.join();
+        }
+        clearQueue();
+        stopped_.store(true, std::memory_order_release);
+        stopping_.store(false, std::memory_order_release);
+    }
+
+    // Stop and reset to initial state.
+    void reset() {
+        stop();
+        callback_ = nullptr;
+        stopping_.store(false, std::memory_order_release);
+        flushing_.store(false, std::memory_order_release);
+        stopped_.store(true, std::memory_order_release);
+    }
+
+private:
+    bool tryEnqueueFrame(std::shared_ptr<T> &frame) {
+        size_t pos = enqueueIdx_.value.load(std::memory_order_relaxed);
+        while(true) {
+            const size_t r = dequeueIdx_.value.load(std::memory_order_acquire);
+            if(pos >= r && pos - r >= capacity_.load(std::memory_order_relaxed)) {
+                return false;
+            }
+
+            Cell          &cell = cells_[pos & mask_];
+            const size_t   seq  = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if(diff == 0) {
+                if(enqueueIdx_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.frame = std::move(frame);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(diff < 0) {
+                return false;  // buffer full
+            }
+            else {
+                pos = enqueueIdx_.value.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryDequeueFrame(std::shared_ptr<T> &frame) {
+        size_t pos = dequeueIdx_.value.load(std::memory_order_relaxed);
+        while(true) {
+            Cell          &cell = cells_[pos & mask_];
+            const size_t   seq  = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if(diff == 0) {
+                if(dequeueIdx_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    frame = std::move(cell.frame);
+                    cell.sequence.store(pos + bufferSize_, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(diff < 0) {
+                return false;  // empty, or the oldest slot is not published yet
+            }
+            else {
+                pos = dequeueIdx_.value.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void notifyConsumer() {
+        // Pairs with the waiter count increment of the consumer: either the consumer sees the frame in its wait predicate, or the
+        // producer sees the waiter and wakes it up under the signal mutex.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(waiterCount_.load() > 0) {
+            std::unique_lock<std::mutex> lock(signalMutex_);
+            signal_.notify_one();
+        }
+    }
+
+    void clearQueue() {
+        std::shared_ptr<T> frame;
+        while(tryDequeueFrame(frame)) {
+            frame.reset();
+        }
+    }
+
+    std::atomic<size_t>     capacity_;  // logical capacity
+    size_t                  bufferSize_;
+    size_t                  mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    CacheLineAtomicSizeT enqueueIdx_;
+    CacheLineAtomicSizeT dequeueIdx_;
+
+    std::mutex           signalMutex_;
+    utils::SteadyCondVar signal_;
+    std::atomic<int>     waiterCount_;
+    std::atomic<bool>    stopped_;
+    std::atomic<bool>    stopping_;
+    std::atomic<bool>    flushing_;
+
+    std::mutex                              threadMutex_;
+    std::thread                             dequeueThread_;
+    std::function<void(std::shared_ptr<T>)> callback_;
+};
+
+}  // namespace libobsensor
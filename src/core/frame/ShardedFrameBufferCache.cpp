@@ -0,0 +1,429 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "ShardedFrameBufferCache.hpp"
+#include "FrameBufferManager.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace libobsensor {
+
+namespace {
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+std::atomic<uint64_t> cacheGenerationCounter(0);
+
+// Single writer counter, readers may observe stale values.
+inline void increaseCounter(std::atomic<uint64_t> &counter, uint64_t value = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline size_t highestBitIndex(size_t value) {
+    size_t index = 0;
+    while(value >>= 1) {
+        index++;
+    }
+    return index;
+}
+
+}  // namespace
+
+// Bounded lock-free MPMC queue of free buffers (D. Vyukov's algorithm).
+class ShardedFrameBufferCache::Depot {
+    struct Cell {
+        std::atomic<size_t> sequence;
+        uint8_t            *data;
+    };
+
+public:
+    Depot() : enqueuePos_(0), dequeuePos_(0) {
+        for(size_t i = 0; i < kDepotCapacity; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+            cells_[i].data = nullptr;
+        }
+    }
+
+    bool push(uint8_t *data, uint64_t &contentions) {
+        Cell  *cell = nullptr;
+        size_t pos  = enqueuePos_.load(std::memory_order_relaxed);
+        while(true) {
+            cell          = &cells_[pos & (kDepotCapacity - 1)];
+            size_t   seq  = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if(diff == 0) {
+                if(enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+                contentions++;
+            }
+            else if(diff < 0) {
+                return false;  // full
+            }
+            else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = data;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate number of cached buffers, may be stale while other threads push or pop.
+    size_t size() const {
+        size_t enqueuePos = enqueuePos_.load(std::memory_order_acquire);
+        size_t dequeuePos = dequeuePos_.load(std::memory_order_acquire);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+    uint8_t *pop(uint64_t &contentions) {
+        Cell  *cell = nullptr;
+        size_t pos  = dequeuePos_.load(std::memory_order_relaxed);
+        while(true) {
+            cell          = &cells_[pos & (kDepotCapacity - 1)];
+            size_t   seq  = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if(diff == 0) {
+                if(dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+                contentions++;
+            }
+            else if(diff < 0) {
+                return nullptr;  // empty
+            }
+            else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        auto data = cell->data;
+        cell->sequence.store(pos + kDepotCapacity, std::memory_order_release);
+        return data;
+    }
+
+private:
+    Cell                cells_[kDepotCapacity];
+    char                pad0_[CACHE_LINE_SIZE];
+    std::atomic<size_t> enqueuePos_;
+    char                pad1_[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> dequeuePos_;
+    char                pad2_[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+};
+
+struct ShardedFrameBufferCache::ThreadMagazine {
+    explicit ThreadMagazine(size_t classCount)
+        : classCount(classCount), slots(new std::atomic<uint8_t *>[classCount * kMagazineCapacity]), magazineHits(0), depotHits(0), misses(0), contentions(0) {
+        for(size_t i = 0; i < classCount * kMagazineCapacity; i++) {
+            slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<uint8_t *> *classSlots(int sizeClass) {
+        return &slots[static_cast<size_t>(sizeClass) * kMagazineCapacity];
+    }
+
+    const size_t                              classCount;
+    std::unique_ptr<std::atomic<uint8_t *>[]> slots;
+
+    // Written by the owner thread only
+    std::atomic<uint64_t> magazineHits;
+    std::atomic<uint64_t> depotHits;
+    std::atomic<uint64_t> misses;
+    std::atomic<uint64_t> contentions;
+};
+
+struct ShardedFrameBufferCache::ThreadMagazineHolder {
+    ~ThreadMagazineHolder() {
+        auto cache = owner.lock();
+        if(cache && magazine) {
+            cache->flushThreadMagazine(magazine);
+        }
+    }
+
+    uint64_t                               generation = 0;
+    std::shared_ptr<ThreadMagazine>        magazine;
+    std::weak_ptr<ShardedFrameBufferCache> owner;
+};
+
+ShardedFrameBufferCache::ShardedFrameBufferCache(FrameMemoryAllocator *allocator)
+    : allocator_(allocator), generation_(++cacheGenerationCounter), depots_(new std::atomic<Depot *>[kSizeClassCount]), retiredStats_{} {
+    for(size_t i = 0; i < kSizeClassCount; i++) {
+        depots_[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+ShardedFrameBufferCache::~ShardedFrameBufferCache() noexcept {
+    detach();
+    for(size_t i = 0; i < kSizeClassCount; i++) {
+        delete depots_[i].load(std::memory_order_acquire);
+    }
+}
+
+int ShardedFrameBufferCache::sizeClassOf(size_t size) {
+    if(size <= (static_cast<size_t>(1) << kMinClassSizeShift)) {
+        return 0;
+    }
+    size_t n     = size - 1;
+    size_t shift = highestBitIndex(n);
+    if(shift > kMaxClassSizeShift) {
+        return kInvalidSizeClass;
+    }
+    size_t sub = (n >> (shift - kSubClassShift)) - (static_cast<size_t>(1) << kSubClassShift);
+    return static_cast<int>(1 + ((shift - kMinClassSizeShift) << kSubClassShift) + sub);
+}
+
+size_t ShardedFrameBufferCache::classSizeOf(int sizeClass) {
+    if(sizeClass == 0) {
+        return static_cast<size_t>(1) << kMinClassSizeShift;
+    }
+    size_t index = static_cast<size_t>(sizeClass - 1);
+    size_t shift = (index >> kSubClassShift) + kMinClassSizeShift;
+    size_t sub   = index & ((static_cast<size_t>(1) << kSubClassShift) - 1);
+    return (sub + 1 + (static_cast<size_t>(1) << kSubClassShift)) << (shift - kSubClassShift);
+}
+
+ShardedFrameBufferCache::Depot *ShardedFrameBufferCache::getDepot(int sizeClass, bool create) {
+    auto depot = depots_[sizeClass].load(std::memory_order_acquire);
+    if(depot || !create) {
+        return depot;
+    }
+    auto    newDepot = new Depot();
+    Depot *expected = nullptr;
+    if(depots_[sizeClass].compare_exchange_strong(expected, newDepot, std::memory_order_acq_rel)) {
+        return newDepot;
+    }
+    delete newDepot;  // another thread installed the depot first
+    return expected;
+}
+
+ShardedFrameBufferCache::ThreadMagazine *ShardedFrameBufferCache::getThreadMagazine() {
+    static thread_local ThreadMagazineHolder holder;
+    if(holder.generation != generation_) {
+        // First use on this thread, or the thread was attached to a cache that no longer exists
+        auto oldCache = holder.owner.lock();
+        if(oldCache && holder.magazine) {
+            oldCache->flushThreadMagazine(holder.magazine);
+        }
+        holder.magazine   = std::make_shared<ThreadMagazine>(static_cast<size_t>(sizeClassOf(kMagazineMaxClassSize) + 1));
+        holder.owner      = shared_from_this();
+        holder.generation = generation_;
+
+        std::lock_guard<std::mutex> lock(magazinesMutex_);
+        magazines_.push_back(holder.magazine);
+    }
+    return holder.magazine.get();
+}
+
+uint8_t *ShardedFrameBufferCache::acquire(size_t size) {
+    auto allocator = allocator_.load(std::memory_order_acquire);
+    if(!allocator) {
+        return nullptr;
+    }
+
+    int sizeClass = sizeClassOf(size);
+    if(sizeClass == kInvalidSizeClass) {
+        return allocator->allocate(size);
+    }
+
+    auto magazine = getThreadMagazine();
+    if(static_cast<size_t>(sizeClass) < magazine->classCount) {
+        auto slots = magazine->classSlots(sizeClass);
+        for(size_t i = 0; i < kMagazineCapacity; i++) {
+            if(slots[i].load(std::memory_order_relaxed) == nullptr) {
+                continue;
+            }
+            auto ptr = slots[i].exchange(nullptr, std::memory_order_acquire);
+            if(ptr) {
+                increaseCounter(magazine->magazineHits);
+                return ptr;
+            }
+        }
+    }
+
+    auto depot = getDepot(sizeClass, false);
+    if(depot) {
+        uint64_t contentions = 0;
+        auto     ptr         = depot->pop(contentions);
+        if(contentions) {
+            increaseCounter(magazine->contentions, contentions);
+        }
+        if(ptr) {
+            increaseCounter(magazine->depotHits);
+            return ptr;
+        }
+    }
+
+    increaseCounter(magazine->misses);
+    return allocator->allocate(classSizeOf(sizeClass));
+}
+
+void ShardedFrameBufferCache::reclaim(uint8_t *ptr, size_t size) {
+    auto allocator = allocator_.load(std::memory_order_acquire);
+    if(!allocator) {
+        // The allocator is being destroyed, nothing is accounted or cached any more
+        free(ptr);
+        return;
+    }
+
+    int sizeClass = sizeClassOf(size);
+    if(sizeClass == kInvalidSizeClass) {
+        allocator->deallocate(ptr, size);
+        return;
+    }
+
+    auto magazine = getThreadMagazine();
+    if(static_cast<size_t>(sizeClass) < magazine->classCount) {
+        auto slots = magazine->classSlots(sizeClass);
+        for(size_t i = 0; i < kMagazineCapacity; i++) {
+            uint8_t *expected = nullptr;
+            if(slots[i].load(std::memory_order_relaxed) == nullptr && slots[i].compare_exchange_strong(expected, ptr, std::memory_order_release)) {
+                return;
+            }
+        }
+    }
+
+    uint64_t contentions = 0;
+    bool     pushed      = getDepot(sizeClass, true)->push(ptr, contentions);
+    if(contentions) {
+        increaseCounter(magazine->contentions, contentions);
+    }
+    if(!pushed) {
+        // Enough idle buffers of this size class are cached already
+        allocator->deallocate(ptr, classSizeOf(sizeClass));
+    }
+}
+
+size_t ShardedFrameBufferCache::reserve(size_t size, size_t count) {
+    auto allocator = allocator_.load(std::memory_order_acquire);
+    int  sizeClass = sizeClassOf(size);
+    if(!allocator || sizeClass == kInvalidSizeClass) {
+        return 0;
+    }
+
+    auto depot     = getDepot(sizeClass, true);
+    auto classSize = classSizeOf(sizeClass);
+    count          = (std::min)(count, kDepotCapacity);
+    while(depot->size() < count) {
+        auto ptr = allocator->allocate(classSize);
+        if(!ptr) {
+            break;
+        }
+        uint64_t contentions = 0;
+        if(!depot->push(ptr, contentions)) {
+            allocator->deallocate(ptr, classSize);
+            break;
+        }
+    }
+    return (std::min)(depot->size(), count);
+}
+
+void ShardedFrameBufferCache::releaseDepot(int sizeClass) {
+    auto depot = getDepot(sizeClass, false);
+    if(!depot) {
+        return;
+    }
+    auto     classSize   = classSizeOf(sizeClass);
+    uint64_t contentions = 0;
+    uint8_t *ptr         = nullptr;
+    while((ptr = depot->pop(contentions)) != nullptr) {
+        allocator_.load(std::memory_order_relaxed)->deallocate(ptr, classSize);
+    }
+}
+
+void ShardedFrameBufferCache::releaseMagazine(int sizeClass, ThreadMagazine *magazine) {
+    if(static_cast<size_t>(sizeClass) >= magazine->classCount) {
+        return;
+    }
+    auto classSize = classSizeOf(sizeClass);
+    auto slots     = magazine->classSlots(sizeClass);
+    for(size_t i = 0; i < kMagazineCapacity; i++) {
+        auto ptr = slots[i].exchange(nullptr, std::memory_order_acquire);
+        if(ptr) {
+            allocator_.load(std::memory_order_relaxed)->deallocate(ptr, classSize);
+        }
+    }
+}
+
+void ShardedFrameBufferCache::releaseIdle(size_t size) {
+    int sizeClass = sizeClassOf(size);
+    if(sizeClass == kInvalidSizeClass) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(magazinesMutex_);
+    if(!allocator_) {
+        return;
+    }
+    releaseDepot(sizeClass);
+    for(auto &magazine: magazines_) {
+        releaseMagazine(sizeClass, magazine.get());
+    }
+}
+
+void ShardedFrameBufferCache::releaseAllIdle() {
+    std::lock_guard<std::mutex> lock(magazinesMutex_);
+    if(!allocator_) {
+        return;
+    }
+    for(size_t i = 0; i < kSizeClassCount; i++) {
+        releaseDepot(static_cast<int>(i));
+        for(auto &magazine: magazines_) {
+            releaseMagazine(static_cast<int>(i), magazine.get());
+        }
+    }
+}
+
+void ShardedFrameBufferCache::detach() {
+    releaseAllIdle();
+    std::lock_guard<std::mutex> lock(magazinesMutex_);
+    allocator_.store(nullptr, std::memory_order_release);
+}
+
+void ShardedFrameBufferCache::flushThreadMagazine(const std::shared_ptr<ThreadMagazine> &magazine) {
+    std::lock_guard<std::mutex> lock(magazinesMutex_);
+    auto                        iter = std::find(magazines_.begin(), magazines_.end(), magazine);
+    if(iter == magazines_.end()) {
+        return;
+    }
+    magazines_.erase(iter);
+
+    retiredStats_.magazineHits += magazine->magazineHits.load(std::memory_order_relaxed);
+    retiredStats_.depotHits += magazine->depotHits.load(std::memory_order_relaxed);
+    retiredStats_.misses += magazine->misses.load(std::memory_order_relaxed);
+    retiredStats_.contentions += magazine->contentions.load(std::memory_order_relaxed);
+
+    if(!allocator_) {
+        return;  // detached, all cached buffers have been released already
+    }
+
+    // Hand the buffers cached by the exiting thread over to the shared depots
+    for(size_t sizeClass = 0; sizeClass < magazine->classCount; sizeClass++) {
+        auto slots = magazine->classSlots(static_cast<int>(sizeClass));
+        for(size_t i = 0; i < kMagazineCapacity; i++) {
+            auto ptr = slots[i].exchange(nullptr, std::memory_order_acquire);
+            if(!ptr) {
+                continue;
+            }
+            uint64_t contentions = 0;
+            if(!getDepot(static_cast<int>(sizeClass), true)->push(ptr, contentions)) {
+                allocator_.load(std::memory_order_relaxed)->deallocate(ptr, classSizeOf(static_cast<int>(sizeClass)));
+            }
+        }
+    }
+}
+
+void ShardedFrameBufferCache::getStats(FrameMemoryAllocatorStats &stats) const {
+    std::lock_guard<std::mutex> lock(magazinesMutex_);
+    stats.magazineHits += retiredStats_.magazineHits;
+    stats.depotHits += retiredStats_.depotHits;
+    stats.misses += retiredStats_.misses;
+    stats.contentions += retiredStats_.contentions;
+    for(auto &magazine: magazines_) {
+        stats.magazineHits += magazine->magazineHits.load(std::memory_order_relaxed);
+        stats.depotHits += magazine->depotHits.load(std::memory_order_relaxed);
+        stats.misses += magazine->misses.load(std::memory_order_relaxed);
+        stats.contentions += magazine->contentions.load(std::memory_order_relaxed);
+    }
+}
+
+}  // namespace libobsensor
@@ -0,0 +1,91 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace libobsensor {
+
+class FrameMemoryAllocator;
+
+struct FrameMemoryAllocatorStats {
+    uint64_t magazineHits;  // buffers served from the calling thread's magazine
+    uint64_t depotHits;     // buffers served from the shared per size class free list
+    uint64_t misses;        // buffers that had to be allocated from the system
+    uint64_t contentions;   // failed CAS attempts on the free lists and on the memory budget
+    uint64_t usedSize;      // bytes currently allocated (in use + cached), in bytes
+    uint64_t maxSize;       // memory budget, in bytes
+};
+
+// Process wide cache of frame buffers, sharded by size class.
+//
+// Design notes:
+//   - Requested sizes are rounded up to one of kSizeClassCount size classes (8 steps per power of two, max waste 12.5%),
+//     so buffer managers with close frame sizes share the same free list.
+//   - Each size class owns a bounded lock-free MPMC free list (depot). Acquire/reclaim on the depot is a single CAS.
+//   - Small size classes (high rate frames such as IMU frames and frame sets) are additionally cached in per-thread
+//     magazines, which are only touched by the owner thread except when idle memory is released.
+//   - Budget accounting is delegated to FrameMemoryAllocator and covers both in-use and cached buffers.
+class ShardedFrameBufferCache : public std::enable_shared_from_this<ShardedFrameBufferCache> {
+public:
+    static constexpr size_t kMinClassSizeShift   = 8;   // 256 bytes
+    static constexpr size_t kMaxClassSizeShift   = 30;  // highest bit of the classes, buffers larger than 2GB are not cached
+    static constexpr size_t kSubClassShift       = 3;   // 8 size classes per power of two
+    static constexpr size_t kSizeClassCount      = 1 + (kMaxClassSizeShift - kMinClassSizeShift + 1) * (1 << kSubClassShift);
+    static constexpr size_t kDepotCapacity       = 64;          // must be a power of 2
+    static constexpr size_t kMagazineCapacity    = 8;           // per thread, per size class
+    static constexpr size_t kMagazineMaxClassSize = 256 * 1024;  // only small buffers are kept in thread magazines
+    static constexpr int    kInvalidSizeClass    = -1;
+
+    explicit ShardedFrameBufferCache(FrameMemoryAllocator *allocator);
+    ~ShardedFrameBufferCache() noexcept;
+
+    // Returns a buffer of at least size bytes, or nullptr if the memory budget is exhausted or the cache is detached.
+    uint8_t *acquire(size_t size);
+    // Returns a buffer previously acquired with the same size. Once the cache is detached the buffer is freed directly.
+    void reclaim(uint8_t *ptr, size_t size);
+    // Fill the shared free list of the size class that serves size up to count idle buffers, at most kDepotCapacity. Returns the number of
+    // idle buffers available in the free list, less than count if the memory budget is exhausted or count exceeds kDepotCapacity.
+    size_t reserve(size_t size, size_t count);
+
+    // Free the cached buffers of the size class that serves size.
+    void releaseIdle(size_t size);
+    // Free all cached buffers of all size classes and all threads.
+    void releaseAllIdle();
+    // Free all cached buffers and stop returning memory to the allocator. Called before the allocator is destroyed.
+    void detach();
+
+    void getStats(FrameMemoryAllocatorStats &stats) const;
+
+    static int    sizeClassOf(size_t size);
+    static size_t classSizeOf(int sizeClass);
+
+private:
+    class Depot;
+    struct ThreadMagazine;
+    struct ThreadMagazineHolder;
+
+    Depot          *getDepot(int sizeClass, bool create);
+    ThreadMagazine *getThreadMagazine();
+    // Called with magazinesMutex_ held while attached: detach() clears allocator_ under the same lock
+    void            releaseDepot(int sizeClass);
+    void            releaseMagazine(int sizeClass, ThreadMagazine *magazine);
+    void            flushThreadMagazine(const std::shared_ptr<ThreadMagazine> &magazine);
+
+private:
+    std::atomic<FrameMemoryAllocator *> allocator_;  // owns this object, nullptr once detached
+    const uint64_t                      generation_;
+
+    std::unique_ptr<std::atomic<Depot *>[]> depots_;
+
+    mutable std::mutex                           magazinesMutex_;  // only taken on thread registration and idle memory release
+    std::vector<std::shared_ptr<ThreadMagazine>> magazines_;
+    FrameMemoryAllocatorStats                    retiredStats_;  // counters of exited threads
+};
+
+}  // namespace libobsensor
@@ -0,0 +1,102 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "CalibrationSnapshot.hpp"
+#include "StreamExtrinsicsManager.hpp"
+#include "StreamIntrinsicsManager.hpp"
+
+namespace libobsensor {
+
+std::atomic<uint64_t>                      CalibrationSnapshot::version_(1);
+std::mutex                                 CalibrationSnapshot::latestMutex_;
+std::shared_ptr<const CalibrationSnapshot> CalibrationSnapshot::latest_;
+
+const std::shared_ptr<const CalibrationSnapshot> &CalibrationSnapshot::get() {
+    thread_local std::shared_ptr<const CalibrationSnapshot> cached;
+
+    uint64_t version = version_.load(std::memory_order_acquire);
+    if(cached && cached->snapshotVersion_ == version) {
+        return cached;
+    }
+
+    // The calibration changed since this thread's last call: the first thread builds the new snapshot, the others take it
+    std::lock_guard<std::mutex> lock(latestMutex_);
+    version = version_.load(std::memory_order_acquire);
+    if(!latest_ || latest_->snapshotVersion_ != version) {
+        latest_ = build(version);
+    }
+    cached = latest_;
+    return cached;
+}
+
+void CalibrationSnapshot::invalidate() {
+    version_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+std::shared_ptr<const CalibrationSnapshot> CalibrationSnapshot::build(uint64_t version) {
+    // The version is read before the calibration: a registration during the build invalidates this snapshot again
+    auto snapshot = std::make_shared<CalibrationSnapshot>(version);
+    StreamExtrinsicsManager::getInstance()->fillCalibrationSnapshot(*snapshot);
+    StreamIntrinsicsManager::getInstance()->fillCalibrationSnapshot(*snapshot);
+    return snapshot;
+}
+
+CalibrationSnapshot::CalibrationSnapshot(uint64_t version) : snapshotVersion_(version) {}
+
+uint64_t CalibrationSnapshot::getVersion() const {
+    return snapshotVersion_;
+}
+
+bool CalibrationSnapshot::getExtrinsics(uint64_t fromProfileId, uint64_t toProfileId, OBExtrinsic &extrinsics) const {
+    auto fromIter = profileNodes_.find(fromProfileId);
+    if(fromIter == profileNodes_.end()) {
+        return false;
+    }
+    auto toIter = profileNodes_.find(toProfileId);
+    if(toIter == profileNodes_.end()) {
+        return false;
+    }
+
+    size_t index = static_cast<size_t>(fromIter->second) * nodeExtrinsics_->nodeCount + toIter->second;
+    if(!nodeExtrinsics_->hasExtrinsics[index]) {
+        return false;
+    }
+    extrinsics = nodeExtrinsics_->extrinsics[index];
+    return true;
+}
+
+bool CalibrationSnapshot::getIntrinsic(uint64_t profileId, OBCameraIntrinsic &intrinsic) const {
+    auto iter = intrinsics_.find(profileId);
+    if(iter == intrinsics_.end()) {
+        return false;
+    }
+    intrinsic = iter->second;
+    return true;
+}
+
+bool CalibrationSnapshot::getDistortion(uint64_t profileId, OBCameraDistortion &distortion) const {
+    auto iter = distortions_.find(profileId);
+    if(iter == distortions_.end()) {
+        return false;
+    }
+    distortion = iter->second;
+    return true;
+}
+
+void CalibrationSnapshot::setNodeExtrinsics(std::shared_ptr<const NodeExtrinsics> nodeExtrinsics) {
+    nodeExtrinsics_ = nodeExtrinsics;
+}
+
+void CalibrationSnapshot::setProfileNode(uint64_t profileId, uint32_t node) {
+    profileNodes_[profileId] = node;
+}
+
+void CalibrationSnapshot::setIntrinsic(uint64_t profileId, const OBCameraIntrinsic &intrinsic) {
+    intrinsics_[profileId] = intrinsic;
+}
+
+void CalibrationSnapshot::setDistortion(uint64_t profileId, const OBCameraDistortion &distortion) {
+    distortions_[profileId] = distortion;
+}
+
+}  // namespace libobsensor
@@ -0,0 +1,73 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "libobsensor/h/ObTypes.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace libobsensor {
+
+/**
+ * @brief Immutable copy of the calibration of all stream profiles: the extrinsics between all pairs of profiles, the intrinsics and the
+ * distortion of the video stream profiles, keyed by StreamProfile::getInstanceId().
+ * @brief The managers (StreamExtrinsicsManager, StreamIntrinsicsManager) call invalidate() when a calibration is registered, the next get()
+ * builds a new snapshot. Otherwise get() only compares the version of the snapshot cached by the thread: the calibration is read per frame
+ * without locks and without searching the extrinsics graph.
+ */
+class CalibrationSnapshot {
+public:
+    /**
+     * @brief Snapshot of the current calibration, the reference stays valid until the next call of get() on the same thread
+     */
+    static const std::shared_ptr<const CalibrationSnapshot> &get();
+
+    /**
+     * @brief Mark the snapshots as outdated, called by the managers after changing the calibration (with their mutex locked)
+     */
+    static void invalidate();
+
+    uint64_t getVersion() const;
+
+    // false if the profile (or the pair) has no such calibration in the snapshot
+    bool getExtrinsics(uint64_t fromProfileId, uint64_t toProfileId, OBExtrinsic &extrinsics) const;
+    bool getIntrinsic(uint64_t profileId, OBCameraIntrinsic &intrinsic) const;
+    bool getDistortion(uint64_t profileId, OBCameraDistortion &distortion) const;
+
+    /**
+     * @brief Extrinsics between the nodes of the extrinsics graph (the profiles with identity extrinsics between them share a node), shared
+     * by the snapshots while the graph does not change
+     */
+    struct NodeExtrinsics {
+        uint32_t                 nodeCount;
+        std::vector<OBExtrinsic> extrinsics;  // nodeCount x nodeCount, from x to
+        std::vector<uint8_t>     hasExtrinsics;
+    };
+
+    // Building (see StreamExtrinsicsManager::fillCalibrationSnapshot and StreamIntrinsicsManager::fillCalibrationSnapshot)
+    explicit CalibrationSnapshot(uint64_t version);
+
+    void setNodeExtrinsics(std::shared_ptr<const NodeExtrinsics> nodeExtrinsics);
+    void setProfileNode(uint64_t profileId, uint32_t node);
+    void setIntrinsic(uint64_t profileId, const OBCameraIntrinsic &intrinsic);
+    void setDistortion(uint64_t profileId, const OBCameraDistortion &distortion);
+
+private:
+    static std::shared_ptr<const CalibrationSnapshot> build(uint64_t version);
+
+    static std::atomic<uint64_t>                      version_;
+    static std::mutex                                 latestMutex_;
+    static std::shared_ptr<const CalibrationSnapshot> latest_;
+
+    uint64_t                                         snapshotVersion_;
+    std::shared_ptr<const NodeExtrinsics>            nodeExtrinsics_;
+    std::unordered_map<uint64_t, uint32_t>           profileNodes_;
+    std::unordered_map<uint64_t, OBCameraIntrinsic>  intrinsics_;
+    std::unordered_map<uint64_t, OBCameraDistortion> distortions_;
+};
+
+}  // namespace libobsensor
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "StreamExtrinsicsManager.hpp"
+#include "CalibrationSnapshot.hpp"
 #include "logger/Logger.hpp"
 #include "exception/ObException.hpp"
 #include "utils/Utils.hpp"
@@ -171,6 +172,7 @@ void StreamExtrinsicsManager::registerExtrinsics(const std::shared_ptr<const Str
             extrinsicsGraph_[toId].push_back({ fromId, inverseExtrinsics(extrinsics) });  // add the inverse extrinsics to the graph: to -> from
         }
     }
+    CalibrationSnapshot::invalidate();
 }
 
 void StreamExtrinsicsManager::registerExtrinsics(const std::shared_ptr<const StreamProfile> &from, const OBStreamType &type, const OBExtrinsic &extrinsics) {
@@ -314,6 +316,177 @@ OBExtrinsic StreamExtrinsicsManager::getExtrinsics(std::shared_ptr<const StreamP
     return extrinsics;
 }
 
+namespace {
+
+typedef std::vector<std::pair<uint64_t, OBExtrinsic>> ExtrinsicsEdges;
+
+const ExtrinsicsEdges *findEdges(const std::map<uint64_t, ExtrinsicsEdges> &graph, uint64_t id) {
+    auto iter = graph.find(id);
+    return iter == graph.end() || iter->second.empty() ? nullptr : &iter->second;
+}
+
+bool sameEdges(const ExtrinsicsEdges *a, const ExtrinsicsEdges *b, size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        if((*a)[i].first != (*b)[i].first || memcmp(&(*a)[i].second, &(*b)[i].second, sizeof(OBExtrinsic)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+// The leaves (vertices with a single edge) whose edge was added, removed or replaced since the last snapshot. A new leaf is appended to
+// the edges of its neighbor and is a dead end for the paths between the other vertices, these paths do not change. False if the graph
+// changed otherwise.
+bool StreamExtrinsicsManager::findChangedLeaves(std::set<uint64_t> &changedLeaves) const {
+    std::set<uint64_t> ids;
+    for(const auto &entry: snapshotGraph_) {
+        ids.insert(entry.first);
+    }
+    for(const auto &entry: extrinsicsGraph_) {
+        ids.insert(entry.first);
+    }
+
+    std::vector<uint64_t> changedVertices;
+    for(auto id: ids) {
+        auto before = findEdges(snapshotGraph_, id);
+        auto after  = findEdges(extrinsicsGraph_, id);
+        if(!before && !after) {
+            continue;
+        }
+        if(before && after && before->size() == after->size() && sameEdges(before, after, before->size())) {
+            continue;
+        }
+        if((!before || before->size() == 1) && (!after || after->size() == 1)) {
+            changedLeaves.insert(id);
+        }
+        else {
+            changedVertices.push_back(id);
+        }
+    }
+
+    for(auto leaf: changedLeaves) {
+        auto before = findEdges(snapshotGraph_, leaf);
+        auto after  = findEdges(extrinsicsGraph_, leaf);
+        if((before && changedLeaves.count(before->front().first)) || (after && changedLeaves.count(after->front().first))) {
+            return false;  // two leaves of each other
+        }
+    }
+
+    // The other changed vertices keep their edges in the same order, without the edges to the changed leaves, which come last
+    for(auto id: changedVertices) {
+        ExtrinsicsEdges kept;
+        if(auto before = findEdges(snapshotGraph_, id)) {
+            for(const auto &edge: *before) {
+                if(!changedLeaves.count(edge.first)) {
+                    kept.push_back(edge);
+                }
+            }
+        }
+        auto after = findEdges(extrinsicsGraph_, id);
+        if(!after || after->size() < kept.size() || !sameEdges(&kept, after, kept.size())) {
+            return false;
+        }
+        for(size_t i = kept.size(); i < after->size(); i++) {
+            if(!changedLeaves.count((*after)[i].first)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void StreamExtrinsicsManager::fillCalibrationSnapshot(CalibrationSnapshot &snapshot) {
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+
+    // One node per graph vertex, the profiles with identity extrinsics between them share a vertex. The nodes of the vertices gone without
+    // edges stay (no extrinsics to the other nodes) until there are as many as live ones.
+    std::set<uint64_t> vertices;
+    for(const auto &entry: profileToIdMap_) {
+        vertices.insert(entry.second);
+    }
+    std::set<uint64_t> changedLeaves;
+    bool rebuild = !snapshotExtrinsics_ || snapshotNodes_.size() > 2 * vertices.size() + 16 || !findChangedLeaves(changedLeaves);
+    if(rebuild) {
+        snapshotNodes_.clear();
+        snapshotExtrinsics_.reset();
+    }
+
+    std::vector<uint64_t> updated;  // vertices whose row and column are searched again
+    for(auto vertex: vertices) {
+        if(snapshotNodes_.find(vertex) == snapshotNodes_.end()) {
+            auto node              = static_cast<uint32_t>(snapshotNodes_.size());
+            snapshotNodes_[vertex] = node;
+            updated.push_back(vertex);
+        }
+    }
+    for(auto leaf: changedLeaves) {
+        if(snapshotNodes_.find(leaf) != snapshotNodes_.end() && std::find(updated.begin(), updated.end(), leaf) == updated.end()) {
+            updated.push_back(leaf);
+        }
+    }
+
+    if(!updated.empty() || !snapshotExtrinsics_) {
+        // The snapshots taken before keep the former table
+        auto table       = std::make_shared<CalibrationSnapshot::NodeExtrinsics>();
+        auto nodeCount   = static_cast<uint32_t>(snapshotNodes_.size());
+        table->nodeCount = nodeCount;
+        table->extrinsics.assign(static_cast<size_t>(nodeCount) * nodeCount, OBExtrinsic());
+        table->hasExtrinsics.assign(static_cast<size_t>(nodeCount) * nodeCount, 0);
+        if(!rebuild) {
+            auto former = snapshotExtrinsics_;
+            for(uint32_t from = 0; from < former->nodeCount; from++) {
+                size_t src = static_cast<size_t>(from) * former->nodeCount;
+                size_t dst = static_cast<size_t>(from) * nodeCount;
+                std::copy(former->extrinsics.begin() + src, former->extrinsics.begin() + src + former->nodeCount, table->extrinsics.begin() + dst);
+                std::copy(former->hasExtrinsics.begin() + src, former->hasExtrinsics.begin() + src + former->nodeCount, table->hasExtrinsics.begin() + dst);
+            }
+        }
+
+        std::vector<uint8_t> isUpdated(nodeCount, 0);
+        for(auto vertex: updated) {
+            auto node = snapshotNodes_[vertex];
+            for(uint32_t other = 0; other < nodeCount; other++) {
+                table->hasExtrinsics[static_cast<size_t>(node) * nodeCount + other] = 0;
+                table->hasExtrinsics[static_cast<size_t>(other) * nodeCount + node] = 0;
+            }
+            isUpdated[node] = 1;
+        }
+
+        // Same paths and products as getExtrinsics()
+        auto setPair = [&](uint64_t fromId, uint32_t fromNode, uint64_t toId, uint32_t toNode) {
+            size_t index = static_cast<size_t>(fromNode) * nodeCount + toNode;
+            if(fromId == toId) {
+                table->extrinsics[index]    = IdentityExtrinsics;
+                table->hasExtrinsics[index] = 1;
+                return;
+            }
+            std::vector<std::pair<uint64_t, OBExtrinsic>> path = { { fromId, IdentityExtrinsics } };
+            if(searchPath(path, fromId, toId)) {
+                table->extrinsics[index]    = path.size() == 2 ? path[1].second : calculateExtrinsics(path);
+                table->hasExtrinsics[index] = 1;
+            }
+        };
+        for(auto vertex: updated) {
+            auto node = snapshotNodes_[vertex];
+            for(const auto &other: snapshotNodes_) {
+                setPair(vertex, node, other.first, other.second);
+                if(!isUpdated[other.second]) {
+                    setPair(other.first, other.second, vertex, node);
+                }
+            }
+        }
+        snapshotExtrinsics_ = table;
+    }
+    snapshotGraph_ = extrinsicsGraph_;
+
+    snapshot.setNodeExtrinsics(snapshotExtrinsics_);
+    for(const auto &entry: profileToIdMap_) {
+        snapshot.setProfileNode(entry.first, snapshotNodes_[entry.second]);
+    }
+}
+
 bool StreamExtrinsicsManager::searchPath(std::vector<std::pair<uint64_t, OBExtrinsic>> &path, uint64_t fromId, uint64_t toId) const {
 
     // LOG_TRACE("searchPath: {} -> {}", fromId, toId);
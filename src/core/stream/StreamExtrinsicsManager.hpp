@@ -5,12 +5,15 @@
 
 #include "libobsensor/h/ObTypes.h"
 #include "StreamProfile.hpp"
+#include "CalibrationSnapshot.hpp"
 #include <map>
 #include <memory>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
 namespace libobsensor {
+
 constexpr OBExtrinsic IdentityExtrinsics = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0, 0, 0 } };
 class StreamExtrinsicsManager {
 private:
@@ -34,12 +37,17 @@ public:
     bool        hasExtrinsics(std::shared_ptr<const StreamProfile> from, std::shared_ptr<const StreamProfile> to);
     OBExtrinsic getExtrinsics(std::shared_ptr<const StreamProfile> from, std::shared_ptr<const StreamProfile> to);
 
+    // Extrinsics of all pairs of registered stream profiles, see CalibrationSnapshot. The extrinsics between the graph vertices are kept for
+    // the next snapshots, only the rows and columns of the leaves added or removed since the last snapshot are searched again.
+    void fillCalibrationSnapshot(CalibrationSnapshot &snapshot);
+
 private:
     void cleanExpiredStreamProfiles();
     void eraseStreamProfile(std::shared_ptr<const StreamProfile> sp);
     void eraseNodeFromExtrinsicsGraph(uint64_t id);
 
     bool searchPath(std::vector<std::pair<uint64_t, OBExtrinsic>> &path, uint64_t fromId, uint64_t toId) const;
+    bool findChangedLeaves(std::set<uint64_t> &changedLeaves) const;
 
     uint64_t getOrRegisterStreamProfileId(std::shared_ptr<const StreamProfile> profile);
     uint64_t getStreamProfileId(std::shared_ptr<const StreamProfile> profile) const;
@@ -50,6 +58,11 @@ private:
     std::map<uint64_t, std::vector<std::pair<uint64_t, OBExtrinsic>>>   extrinsicsGraph_;   // graph adjacency list
 
     std::unordered_map<uint64_t, uint64_t> profileToIdMap_;
+
+    // State of the last snapshot: the graph, the node of each vertex and the extrinsics between the nodes
+    std::map<uint64_t, std::vector<std::pair<uint64_t, OBExtrinsic>>> snapshotGraph_;
+    std::map<uint64_t, uint32_t>                                      snapshotNodes_;
+    std::shared_ptr<const CalibrationSnapshot::NodeExtrinsics>        snapshotExtrinsics_;
 };
 
 }  // namespace libobsensor
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "StreamIntrinsicsManager.hpp"
+#include "CalibrationSnapshot.hpp"
 #include "logger/Logger.hpp"
 
 namespace libobsensor {
@@ -44,11 +45,13 @@ void StreamIntrinsicsManager::registerVideoStreamIntrinsics(const std::shared_pt
     for(auto &pair: videoStreamIntrinsicsMap_) {
         if(pair.first.lock() == profile) {
             pair.second = intrinsics;
+            CalibrationSnapshot::invalidate();
             return;
         }
     }
 
     videoStreamIntrinsicsMap_[std::weak_ptr<const StreamProfile>(profile)] = intrinsics;
+    CalibrationSnapshot::invalidate();
 }
 
 OBCameraIntrinsic StreamIntrinsicsManager::getVideoStreamIntrinsics(const std::shared_ptr<const StreamProfile> &profile) {
@@ -104,6 +107,7 @@ void StreamIntrinsicsManager::registerVideoStreamDistortion(const std::shared_pt
     }
 
     videoStreamDistortionMap_[std::weak_ptr<const StreamProfile>(profile)] = distortion;
+    CalibrationSnapshot::invalidate();
 }
 
 OBCameraDistortion StreamIntrinsicsManager::getVideoStreamDistortion(const std::shared_ptr<const StreamProfile> &profile) {
@@ -305,4 +309,21 @@ bool StreamIntrinsicsManager::containsDisparityBasedStreamDisparityParam(const s
     }
     return false;
 }
+
+void StreamIntrinsicsManager::fillCalibrationSnapshot(CalibrationSnapshot &snapshot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for(const auto &pair: videoStreamIntrinsicsMap_) {
+        auto profile = pair.first.lock();
+        if(profile) {
+            snapshot.setIntrinsic(profile->getInstanceId(), pair.second);
+        }
+    }
+    for(const auto &pair: videoStreamDistortionMap_) {
+        auto profile = pair.first.lock();
+        if(profile) {
+            snapshot.setDistortion(profile->getInstanceId(), pair.second);
+        }
+    }
+}
+
 }  // namespace libobsensor
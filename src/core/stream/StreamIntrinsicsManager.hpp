@@ -12,6 +12,8 @@
 
 namespace libobsensor {
 
+class CalibrationSnapshot;
+
 class StreamIntrinsicsManager {
 private:
     StreamIntrinsicsManager();
@@ -40,6 +42,9 @@ public:
     OBDisparityParam   getDisparityBasedStreamDisparityParam(const std::shared_ptr<const StreamProfile> &profile);
     bool               containsDisparityBasedStreamDisparityParam(const std::shared_ptr<const StreamProfile> &profile);
 
+    // Intrinsics and distortion of the video stream profiles, see CalibrationSnapshot
+    void fillCalibrationSnapshot(CalibrationSnapshot &snapshot);
+
 private:
     std::mutex mutex_;
 
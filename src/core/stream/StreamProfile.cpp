@@ -4,6 +4,7 @@
 #include "StreamProfile.hpp"
 #include "StreamExtrinsicsManager.hpp"
 #include "StreamIntrinsicsManager.hpp"
+#include "CalibrationSnapshot.hpp"
 #include "utils/PublicTypeHelper.hpp"
 
 #include "frame/Frame.hpp"
@@ -92,6 +93,11 @@ std::shared_ptr<StreamProfile> StreamProfile::clone(OBFormat newFormat) const {
 }
 
 OBExtrinsic StreamProfile::getExtrinsicTo(std::shared_ptr<const StreamProfile> targetStreamProfile) const {
+    // Per frame calls: read without locks from the snapshot, the manager only reports the missing extrinsics
+    OBExtrinsic extrinsic;
+    if(targetStreamProfile && CalibrationSnapshot::get()->getExtrinsics(instanceId_, targetStreamProfile->getInstanceId(), extrinsic)) {
+        return extrinsic;
+    }
     auto extrinsicsMgr = StreamExtrinsicsManager::getInstance();
     return extrinsicsMgr->getExtrinsics(shared_from_this(), targetStreamProfile);
 }
@@ -136,6 +142,10 @@ OBHardwareDecimationConfig VideoStreamProfile::getDecimationConfig() const {
 }
 
 OBCameraIntrinsic VideoStreamProfile::getIntrinsic() const {
+    OBCameraIntrinsic intrinsic;
+    if(CalibrationSnapshot::get()->getIntrinsic(instanceId_, intrinsic)) {
+        return intrinsic;
+    }
     auto intrinsicsMgr = StreamIntrinsicsManager::getInstance();
     return intrinsicsMgr->getVideoStreamIntrinsics(shared_from_this());
 }
@@ -146,6 +156,10 @@ void VideoStreamProfile::bindIntrinsic(const OBCameraIntrinsic &intrinsic) {
 }
 
 OBCameraDistortion VideoStreamProfile::getDistortion() const {
+    OBCameraDistortion distortion;
+    if(CalibrationSnapshot::get()->getDistortion(instanceId_, distortion)) {
+        return distortion;
+    }
     auto intrinsicsMgr = StreamIntrinsicsManager::getInstance();
     return intrinsicsMgr->getVideoStreamDistortion(shared_from_this());
 }
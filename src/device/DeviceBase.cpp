@@ -246,6 +246,9 @@ void DeviceBase::deactivate() {
         tempComponents.erase(tempComponents.end() - 1);
     }
     sensorPortInfos_.clear();
+
+    TRY_EXECUTE({ waitSourcePortsOpened(); });
+    openedSourcePorts_.clear();
 }
 
 void DeviceBase::reboot() {
@@ -612,6 +615,28 @@ std::shared_ptr<ISourcePort> DeviceBase::getSourcePort(std::shared_ptr<const Sou
     return platform->getSourcePort(sourcePortInfo);
 }
 
+void DeviceBase::openSourcePortsAsync(const std::vector<std::shared_ptr<const SourcePortInfo>> &portInfos) {
+    waitSourcePortsOpened();
+    sourcePortsOpening_ = std::async(std::launch::async, [this, portInfos]() {
+        utils::PhaseTimer timer;
+        for(auto &portInfo: portInfos) {
+            try {
+                openedSourcePorts_.push_back(getSourcePort(portInfo));
+            }
+            catch(const std::exception &e) {
+                LOG_DEBUG("Open source port in advance failed, port type: {}, {}", static_cast<int>(portInfo->portType), e.what());
+            }
+        }
+        LOG_DEBUG("Source ports opened in advance: {} of {}, {}", openedSourcePorts_.size(), portInfos.size(), timer.toString());
+    });
+}
+
+void DeviceBase::waitSourcePortsOpened() {
+    if(sourcePortsOpening_.valid()) {
+        sourcePortsOpening_.get();
+    }
+}
+
 OBDeviceAccessMode DeviceBase::normalizeMode(OBDeviceAccessMode mode) {
     if(mode == OB_DEVICE_DEFAULT_ACCESS) {
         LOG_DEBUG("Convert access mode from default access to control access");
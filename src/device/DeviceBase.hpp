@@ -9,6 +9,7 @@
 #include <memory>
 #include <map>
 #include <atomic>
+#include <future>
 
 namespace libobsensor {
 
@@ -123,6 +124,20 @@ protected:
 
     std::shared_ptr<ISourcePort> getSourcePort(std::shared_ptr<const SourcePortInfo> sourcePortInfo) const;
 
+    /**
+     * @brief Open source ports on a separate thread while the initialization continues on the other ports (e.g. the color and imu ports are
+     * opened while the calibration is read through the depth port). The ports are kept open for the sensors, which are created later on them.
+     *
+     * @note Must be called after fetchDeviceInfo(), the uvc backend of the port depends on the device name. A port failing to open is left to the
+     * creation of its sensor, which reports the error.
+     */
+    void openSourcePortsAsync(const std::vector<std::shared_ptr<const SourcePortInfo>> &portInfos);
+
+    /**
+     * @brief Wait for the ports of openSourcePortsAsync(), called at the end of the initialization
+     */
+    void waitSourcePortsOpened();
+
     /**
      * @brief Enable heartbeat if "DefaultHeartBeat" config is true.
      *        Reads the "DefaultHeartBeat" option from config and starts heartbeat if enabled.
@@ -164,6 +179,9 @@ private:
 
     std::atomic<bool>                     isFirmwareUpdating_;
     std::shared_ptr<DeviceRebootCallback> rebootCallback_;
+
+    std::vector<std::shared_ptr<ISourcePort>> openedSourcePorts_;  // see openSourcePortsAsync
+    std::future<void>                         sourcePortsOpening_;  // last member: waits for the opening thread before the others are destroyed
 };
 
 }  // namespace libobsensor
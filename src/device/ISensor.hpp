@@ -58,6 +58,14 @@ public:
     virtual uint64_t                     getAndResetDroppedFrameStatus() = 0;
 };
 
+// Implemented by the accel and gyro sensors that can deliver their samples in batches (ImuBatchFrame) instead of one frame per sample
+class IImuBatchSensor {
+public:
+    virtual ~IImuBatchSensor() noexcept = default;
+
+    virtual void startBatched(std::shared_ptr<const StreamProfile> sp, FrameCallback callback) = 0;  // stopped with ISensor::stop()
+};
+
 struct LazySensor {
     explicit LazySensor(IDevice *device, OBSensorType type) : device(device), sensorType(type) {}
     IDevice     *device;  // sensor is lazy create base on device
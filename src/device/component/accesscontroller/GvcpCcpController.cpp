@@ -251,13 +251,13 @@ void GvcpCcpController::acquireControl(OBDeviceAccessMode accessMode) {
             // Read CCP register to keepalive
             res = gvcpTransmit_->readRegister(GVCP_CCP_REGISTER);
             if(res.first != GEV_STATUS_SUCCESS) {
-                LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP Keepalive", 3000, spdlog::level::warn, "[{}] CCP register read failed, ignored. Status code: {:#04x}",
+                LOG_INTVL(LOG_INTVL_OBJECT_TAG, 3000, spdlog::level::warn, "[{}] CCP register read failed, ignored. Status code: {:#04x}",
                            portInfo_->serialNumber, res.first);
             }
             else {
                 res.second = (res.second & GVCP_CCP_MASK);
                 if(res.second != ccpValue) {
-                    LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP Keepalive", 3000, spdlog::level::warn,
+                    LOG_INTVL(LOG_INTVL_OBJECT_TAG, 3000, spdlog::level::warn,
                                "[{}] CCP register mismatch: expected {:#04x}, got {:#04x}. Ignored", portInfo_->serialNumber, ccpValue, res.second);
                 }
             }
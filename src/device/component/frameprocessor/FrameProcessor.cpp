@@ -150,7 +150,7 @@ std::shared_ptr<Frame> FrameProcessor::process(std::shared_ptr<const Frame> fram
     std::shared_ptr<Frame> resultFrame;
 
     if(!context_->process_frame || !privateProcessor_) {
-        resultFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+        resultFrame = FrameFactory::createFrameView(frame);
     }
     else {
         checkAndUpdateConfig();
@@ -168,7 +168,7 @@ std::shared_ptr<Frame> FrameProcessor::process(std::shared_ptr<const Frame> fram
 
         if(error) {
             delete error;
-            resultFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+            resultFrame = FrameFactory::createFrameView(frame);
         }
     }
 
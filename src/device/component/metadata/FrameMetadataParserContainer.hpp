@@ -8,7 +8,6 @@
 #include "exception/ObException.hpp"
 #include "utils/Utils.hpp"
 
-#include <map>
 
 namespace libobsensor {
 
@@ -18,11 +17,14 @@ public:
     virtual ~FrameMetadataParserContainer() override = default;
 
     virtual void registerParser(OBFrameMetadataType type, std::shared_ptr<IFrameMetadataParser> phaser) override {
+        if(static_cast<uint32_t>(type) >= OB_FRAME_METADATA_TYPE_COUNT) {
+            THROW_INVALID_PARAM_EXCEPTION(utils::string::to_string() << "Invalid metadata type: " << type);
+        }
         parsers[type] = phaser;
     }
 
     virtual bool isContained(OBFrameMetadataType type) override {
-        return parsers.find(type) != parsers.end();
+        return find(type) != nullptr;
     }
 
     virtual std::shared_ptr<IFrameMetadataParser> get(OBFrameMetadataType type) override {
@@ -32,8 +34,12 @@ public:
         return parsers[type];
     }
 
+    virtual IFrameMetadataParser *find(OBFrameMetadataType type) override {
+        return static_cast<uint32_t>(type) < OB_FRAME_METADATA_TYPE_COUNT ? parsers[type].get() : nullptr;
+    }
+
 protected:
-    std::map<OBFrameMetadataType, std::shared_ptr<IFrameMetadataParser>> parsers;
+    std::shared_ptr<IFrameMetadataParser> parsers[OB_FRAME_METADATA_TYPE_COUNT];  // indexed by metadata type
 
 private:
     IDevice *owner_ = nullptr;
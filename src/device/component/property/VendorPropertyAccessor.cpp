@@ -81,10 +81,23 @@ void VendorPropertyAccessor::setStructureData(uint32_t propertyId, const std::ve
     auto     port         = std::dynamic_pointer_cast<IVendorDataPort>(backend_);
     uint16_t reqDataSize  = static_cast<uint16_t>(sizeof(*req) + data.size() - 1);
     executeAndCheck(port, sendData_.data(), reqDataSize, recvData_.data(), &respDataSize, propertyId);
+    if(queryCache_) {
+        queryCache_->erase(propertyId);
+    }
 }
 
 std::vector<uint8_t> VendorPropertyAccessor::getStructureData(uint32_t propertyId, utils::TransferTiming *timing) {
     std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<uint8_t>        data;
+    if(getCachedData(VendorQueryCache::QUERY_STRUCTURE_DATA, propertyId, 0, data)) {
+        return data;
+    }
+    data = doGetStructureData(propertyId, timing);
+    putCachedData(VendorQueryCache::QUERY_STRUCTURE_DATA, propertyId, 0, data);
+    return data;
+}
+
+std::vector<uint8_t> VendorPropertyAccessor::doGetStructureData(uint32_t propertyId, utils::TransferTiming *timing) {
     clearBuffers();
     auto req = protocol::initGetStructureDataReq(sendData_.data(), propertyId);
 
@@ -108,6 +121,19 @@ std::vector<uint8_t> VendorPropertyAccessor::getStructureData(uint32_t propertyI
 
 void VendorPropertyAccessor::getRawData(uint32_t propertyId, GetDataCallback callback) {
     std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<uint8_t>        cachedData;
+    if(getCachedData(VendorQueryCache::QUERY_RAW_DATA, propertyId, 0, cachedData)) {
+        // Delivered in a single chunk
+        OBDataChunk dataChunk = { cachedData.data(), static_cast<uint32_t>(cachedData.size()), 0, static_cast<uint32_t>(cachedData.size()) };
+        if(callback && !cachedData.empty()) {
+            callback(DATA_TRAN_STAT_TRANSFERRING, &dataChunk);
+        }
+        dataChunk = { nullptr, 0, static_cast<uint32_t>(cachedData.size()), static_cast<uint32_t>(cachedData.size()) };
+        callback(DATA_TRAN_STAT_DONE, &dataChunk);
+        return;
+    }
+    bool cacheable = queryCache_ && VendorQueryCache::isCacheable(propertyId);
+
     clearBuffers();
     OBDataTranState tranState = DATA_TRAN_STAT_TRANSFERRING;
     OBDataChunk     dataChunk = { sendData_.data(), 0, 0, 0 };
@@ -133,6 +159,10 @@ void VendorPropertyAccessor::getRawData(uint32_t propertyId, GetDataCallback cal
         auto     port         = std::dynamic_pointer_cast<IVendorDataPort>(backend_);
         executeAndCheck(port, sendData_.data(), sizeof(*req), recvData_.data(), &respDataSize, propertyId);
 
+        if(cacheable) {
+            auto packetData = recvData_.data() + sizeof(protocol::RespHeader);
+            cachedData.insert(cachedData.end(), packetData, packetData + packetLen);
+        }
         if(callback) {
             dataChunk.data         = recvData_.data() + sizeof(protocol::RespHeader);
             dataChunk.size         = packetLen;
@@ -150,6 +180,9 @@ void VendorPropertyAccessor::getRawData(uint32_t propertyId, GetDataCallback cal
         auto     port         = std::dynamic_pointer_cast<IVendorDataPort>(backend_);
         executeAndCheck(port, sendData_.data(), sizeof(*req), recvData_.data(), &respDataSize, propertyId);
     }
+    if(cacheable) {
+        putCachedData(VendorQueryCache::QUERY_RAW_DATA, propertyId, 0, cachedData);
+    }
     dataChunk.data         = nullptr;
     dataChunk.size         = 0;
     dataChunk.offset       = dataSize;
@@ -206,11 +239,19 @@ void VendorPropertyAccessor::setStructureDataProtoV1_1(uint32_t propertyId, cons
     auto     port         = std::dynamic_pointer_cast<IVendorDataPort>(backend_);
     uint16_t reqDataSize  = static_cast<uint16_t>(sizeof(*req) + data.size() - 1);
     executeAndCheck(port, sendData_.data(), reqDataSize, recvData_.data(), &respDataSize, propertyId);
+    if(queryCache_) {
+        queryCache_->erase(propertyId);
+    }
 }
 
 std::vector<uint8_t> VendorPropertyAccessor::getStructureDataListProtoV1_1(uint32_t propertyId, uint16_t cmdVersion) {
     std::lock_guard<std::mutex> lock(mutex_);
-    uint32_t                    dataSize = 0;
+    std::vector<uint8_t>        cachedData;
+    if(getCachedData(VendorQueryCache::QUERY_STRUCTURE_DATA_LIST_V1_1, propertyId, cmdVersion, cachedData)) {
+        return cachedData;
+    }
+
+    uint32_t dataSize = 0;
     clearBuffers();
     auto     req          = protocol::initStartGetStructureDataListReq(sendData_.data(), propertyId);
     uint16_t respDataSize = 64;
@@ -246,6 +287,35 @@ std::vector<uint8_t> VendorPropertyAccessor::getStructureDataListProtoV1_1(uint3
     }
 
     protocol::checkStatus(propertyId, res);
+    putCachedData(VendorQueryCache::QUERY_STRUCTURE_DATA_LIST_V1_1, propertyId, cmdVersion, outputData);
+    return outputData;
+}
+
+std::vector<uint8_t> VendorPropertyAccessor::doGetStructureDataListHead(uint32_t propertyId) {
+    clearBuffers();
+    auto     req          = protocol::initStartGetStructureDataListReq(sendData_.data(), propertyId);
+    uint16_t respDataSize = 64;
+    auto     port         = std::dynamic_pointer_cast<IVendorDataPort>(backend_);
+    executeAndCheck(port, sendData_.data(), sizeof(*req), recvData_.data(), &respDataSize, propertyId);
+
+    auto     resp       = protocol::parseStartStructureDataListResp(recvData_.data(), respDataSize);
+    uint32_t dataSize   = resp->dataSize;
+    uint32_t packetSize = std::min(structListDataTransferPacketSize_, dataSize);
+
+    std::vector<uint8_t> outputData(sizeof(dataSize));
+    memcpy(outputData.data(), &dataSize, sizeof(dataSize));
+    if(packetSize > 0) {
+        clearBuffers();
+        auto req1    = protocol::initGetStructureDataListReq(sendData_.data(), propertyId, 0, packetSize);
+        respDataSize = 1024;
+        executeAndCheck(port, sendData_.data(), sizeof(*req1), recvData_.data(), &respDataSize, propertyId);
+        auto packetData = recvData_.data() + sizeof(protocol::RespHeader);
+        outputData.insert(outputData.end(), packetData, packetData + packetSize);
+    }
+
+    clearBuffers();
+    auto req2 = protocol::initFinishGetStructureDataListReq(sendData_.data(), propertyId);
+    executeAndCheck(port, sendData_.data(), sizeof(*req2), recvData_.data(), &respDataSize, propertyId);
     return outputData;
 }
 
@@ -253,6 +323,28 @@ void VendorPropertyAccessor::setAutoRebootEnabled(bool enable) {
     autoRebootEnabled_ = enable;
 }
 
+void VendorPropertyAccessor::setQueryCache(std::shared_ptr<VendorQueryCache> cache) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queryCache_ = cache;
+}
+
+bool VendorPropertyAccessor::getCachedData(VendorQueryCache::QueryType type, uint32_t propertyId, uint16_t cmdVersion, std::vector<uint8_t> &data) {
+    if(!queryCache_ || !VendorQueryCache::isCacheable(propertyId)) {
+        return false;
+    }
+    // The first cacheable query reads the OB_STRUCT_VERSION data that selects and validates the cache file of the device, and the head of the
+    // depth calibration list (rewritten by every calibration of the device) that validates it too
+    queryCache_->open([this]() { return doGetStructureData(OB_STRUCT_VERSION, nullptr); },
+                      [this]() { return doGetStructureDataListHead(OB_RAW_DATA_DEPTH_CALIB_PARAM); });
+    return queryCache_->get(type, propertyId, cmdVersion, data);
+}
+
+void VendorPropertyAccessor::putCachedData(VendorQueryCache::QueryType type, uint32_t propertyId, uint16_t cmdVersion, const std::vector<uint8_t> &data) {
+    if(queryCache_ && VendorQueryCache::isCacheable(propertyId)) {
+        queryCache_->put(type, propertyId, cmdVersion, data);
+    }
+}
+
 void VendorPropertyAccessor::triggerReboot() {
     // Ensure reboot is triggered at most once per accessor instance.
     if(rebootTriggered_.exchange(true)) {
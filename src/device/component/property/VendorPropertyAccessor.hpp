@@ -4,6 +4,7 @@
 #pragma once
 #include "IProperty.hpp"
 #include "ISourcePort.hpp"
+#include "VendorQueryCache.hpp"
 #include "IDevice.hpp"
 #include "IDeviceComponent.hpp"
 #include "protocol/Protocol.hpp"  // protocol::HpStatus - required for executeAndCheck return type
@@ -47,6 +48,9 @@ public:
     // getXu IO fault (LIBUSB_ERROR_IO) is detected. Default: false (disabled).
     void setAutoRebootEnabled(bool enable);
 
+    // The results of the cacheable queries (VendorQueryCache::isCacheable) are read from and written to the cache, nullptr to disable
+    void setQueryCache(std::shared_ptr<VendorQueryCache> cache);
+
 private:
     // Unified execute + fault detection + checkStatus entry point.
     // Replaces all protocol::execute() + protocol::checkStatus() call pairs.
@@ -61,6 +65,14 @@ private:
 
     void clearBuffers();
 
+    std::vector<uint8_t> doGetStructureData(uint32_t propertyId, utils::TransferTiming *timing);  // with mutex_ locked
+    // With mutex_ locked, the size of a structure data list followed by its first packet, without reading the rest of the list
+    std::vector<uint8_t> doGetStructureDataListHead(uint32_t propertyId);
+
+    // With mutex_ locked, false if the property is not cacheable or not in the cache
+    bool getCachedData(VendorQueryCache::QueryType type, uint32_t propertyId, uint16_t cmdVersion, std::vector<uint8_t> &data);
+    void putCachedData(VendorQueryCache::QueryType type, uint32_t propertyId, uint16_t cmdVersion, const std::vector<uint8_t> &data);
+
 private:
     IDevice                     *owner_;
     std::shared_ptr<ISourcePort> backend_;
@@ -72,5 +84,7 @@ private:
 
     bool              autoRebootEnabled_{ false };  // controlled by setAutoRebootEnabled()
     std::atomic<bool> rebootTriggered_{ false };    // prevents duplicate reboot triggers
+
+    std::shared_ptr<VendorQueryCache> queryCache_;
 };
 }  // namespace libobsensor
@@ -0,0 +1,293 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "VendorQueryCache.hpp"
+#include "InternalProperty.hpp"
+#include "InternalTypes.hpp"
+#include "environment/EnvConfig.hpp"
+#include "exception/ObException.hpp"
+#include "logger/Logger.hpp"
+#include "utils/FileUtils.hpp"
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#ifdef WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace libobsensor {
+
+namespace {
+
+const uint32_t CACHE_FILE_MAGIC   = 0x4351424f;  // OBQC
+const uint32_t CACHE_FILE_VERSION = 2;
+
+#pragma pack(push, 1)
+typedef struct {
+    uint32_t magic;
+    uint32_t fileVersion;
+    uint32_t versionChecksum;      // of the OB_STRUCT_VERSION data
+    uint32_t calibrationChecksum;  // of the head of the calibration data
+    uint32_t entryCount;
+} CacheFileHeader;
+
+typedef struct {
+    uint8_t  type;
+    uint32_t propertyId;
+    uint16_t cmdVersion;
+    uint32_t dataSize;  // followed by the data
+} CacheFileEntryHeader;
+#pragma pack(pop)
+
+uint32_t crc32(const uint8_t *data, size_t size) {
+    uint32_t crc = 0xFFFFFFFF;
+    for(size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for(int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+std::string fixedString(const char *str, size_t maxSize) {
+    std::string result(str, strnlen(str, maxSize));
+    for(auto &c: result) {
+        if(!isalnum(static_cast<unsigned char>(c)) && c != '.' && c != '-') {
+            c = '_';
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+std::shared_ptr<VendorQueryCache> VendorQueryCache::createFromConfig() {
+    auto envConfig = EnvConfig::getInstance();
+    bool enable    = false;
+    envConfig->getBooleanValue("Device.OpenCache", enable);
+    if(!enable) {
+        return nullptr;
+    }
+    std::string directory = "DeviceCache/";
+    envConfig->getStringValue("Device.OpenCacheDir", directory);
+    return std::make_shared<VendorQueryCache>(directory);
+}
+
+VendorQueryCache::VendorQueryCache(const std::string &directory)
+    : openCalled_(false), dirty_(false), directory_(directory), versionChecksum_(0), calibrationChecksum_(0) {}
+
+VendorQueryCache::~VendorQueryCache() noexcept {
+    TRY_EXECUTE(flush());
+}
+
+bool VendorQueryCache::isCacheable(uint32_t propertyId) {
+    // Data written at calibration or production time only, a firmware upgrade changes the OB_STRUCT_VERSION data and a calibration the head of
+    // the calibration data
+    switch(propertyId) {
+    case OB_RAW_DATA_DEPTH_CALIB_PARAM:
+    case OB_RAW_DATA_ALIGN_CALIB_PARAM:
+    case OB_RAW_DATA_IMU_CALIB_PARAM:
+    case OB_RAW_DATA_D2C_ALIGN_SUPPORT_PROFILE_LIST:
+    case OB_RAW_DATA_D2C_ALIGN_COLOR_PRE_PROCESS_PROFILE_LIST:
+    case OB_RAW_DATA_STREAM_PROFILE_LIST:
+    case OB_STRUCT_GET_GYRO_PRESETS_ODR_LIST:
+    case OB_STRUCT_GET_ACCEL_PRESETS_ODR_LIST:
+    case OB_STRUCT_GET_GYRO_PRESETS_FULL_SCALE_LIST:
+    case OB_STRUCT_GET_ACCEL_PRESETS_FULL_SCALE_LIST:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void VendorQueryCache::open(const std::function<std::vector<uint8_t>()> &readVersionData, const std::function<std::vector<uint8_t>()> &readCalibrationHead) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(openCalled_) {
+        return;
+    }
+    openCalled_ = true;
+
+    std::vector<uint8_t> versionData;
+    BEGIN_TRY_EXECUTE({ versionData = readVersionData(); })
+    CATCH_EXCEPTION_AND_EXECUTE({
+        LOG_WARN("Device open cache disabled: read version data failed");
+        return;
+    })
+    if(versionData.size() < sizeof(OBVersionInfo)) {
+        LOG_WARN("Device open cache disabled: invalid version data size {}", versionData.size());
+        return;
+    }
+    auto versionInfo = reinterpret_cast<const OBVersionInfo *>(versionData.data());
+    auto serial      = fixedString(versionInfo->serialNumber, sizeof(versionInfo->serialNumber));
+    auto firmware    = fixedString(versionInfo->firmwareVersion, sizeof(versionInfo->firmwareVersion));
+    if(serial.empty()) {
+        LOG_WARN("Device open cache disabled: the device has no serial number");
+        return;
+    }
+
+    std::vector<uint8_t> calibrationHead;
+    BEGIN_TRY_EXECUTE({ calibrationHead = readCalibrationHead(); })
+    CATCH_EXCEPTION_AND_EXECUTE({
+        LOG_WARN("Device open cache disabled: read calibration data failed");
+        return;
+    })
+
+    filePath_            = utils::joinPaths(directory_, serial + "_" + firmware + ".bin");
+    versionChecksum_     = crc32(versionData.data(), versionData.size());
+    calibrationChecksum_ = crc32(calibrationHead.data(), calibrationHead.size());
+    load();
+}
+
+bool VendorQueryCache::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !filePath_.empty();
+}
+
+bool VendorQueryCache::get(QueryType type, uint32_t propertyId, uint16_t cmdVersion, std::vector<uint8_t> &data) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto                        iter = entries_.find(EntryKey(type, propertyId, cmdVersion));
+    if(iter == entries_.end()) {
+        return false;
+    }
+    data = iter->second;
+    return true;
+}
+
+void VendorQueryCache::put(QueryType type, uint32_t propertyId, uint16_t cmdVersion, const std::vector<uint8_t> &data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(filePath_.empty()) {
+        return;
+    }
+    entries_[EntryKey(type, propertyId, cmdVersion)] = data;
+    dirty_                                           = true;
+}
+
+void VendorQueryCache::erase(uint32_t propertyId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool                        erased = false;
+    for(auto iter = entries_.begin(); iter != entries_.end();) {
+        if(std::get<1>(iter->first) == propertyId) {
+            iter   = entries_.erase(iter);
+            erased = true;
+        }
+        else {
+            ++iter;
+        }
+    }
+    if(erased && !filePath_.empty()) {
+        save();
+    }
+}
+
+void VendorQueryCache::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(dirty_ && !filePath_.empty()) {
+        save();
+    }
+}
+
+void VendorQueryCache::load() {  // with mutex_ locked
+    entries_.clear();
+    if(!utils::fileExists(filePath_.c_str())) {
+        return;
+    }
+
+    auto content = utils::readFile(filePath_);
+    if(content.size() < sizeof(CacheFileHeader) + sizeof(uint32_t)) {
+        LOG_WARN("Device open cache {} ignored: invalid size", filePath_);
+        return;
+    }
+    auto     dataSize = content.size() - sizeof(uint32_t);
+    uint32_t fileCrc  = 0;
+    memcpy(&fileCrc, content.data() + dataSize, sizeof(fileCrc));
+    if(fileCrc != crc32(content.data(), dataSize)) {
+        LOG_WARN("Device open cache {} ignored: checksum mismatch", filePath_);
+        return;
+    }
+
+    CacheFileHeader header;
+    memcpy(&header, content.data(), sizeof(header));
+    if(header.magic != CACHE_FILE_MAGIC || header.fileVersion != CACHE_FILE_VERSION) {
+        LOG_WARN("Device open cache {} ignored: unsupported file", filePath_);
+        return;
+    }
+    if(header.versionChecksum != versionChecksum_) {
+        LOG_DEBUG("Device open cache {} outdated: the device version data changed", filePath_);
+        return;
+    }
+    if(header.calibrationChecksum != calibrationChecksum_) {
+        LOG_DEBUG("Device open cache {} outdated: the device was calibrated again", filePath_);
+        return;
+    }
+
+    size_t offset = sizeof(header);
+    for(uint32_t i = 0; i < header.entryCount; i++) {
+        CacheFileEntryHeader entryHeader;
+        if(offset + sizeof(entryHeader) > dataSize) {
+            entries_.clear();
+            LOG_WARN("Device open cache {} ignored: truncated", filePath_);
+            return;
+        }
+        memcpy(&entryHeader, content.data() + offset, sizeof(entryHeader));
+        offset += sizeof(entryHeader);
+        if(offset + entryHeader.dataSize > dataSize) {
+            entries_.clear();
+            LOG_WARN("Device open cache {} ignored: truncated", filePath_);
+            return;
+        }
+        entries_[EntryKey(entryHeader.type, entryHeader.propertyId, entryHeader.cmdVersion)].assign(content.data() + offset,
+                                                                                                   content.data() + offset + entryHeader.dataSize);
+        offset += entryHeader.dataSize;
+    }
+    LOG_DEBUG("Device open cache {} loaded, {} entries", filePath_, entries_.size());
+}
+
+void VendorQueryCache::save() {
+    dirty_ = false;  // not retried if the file cannot be written
+
+    std::vector<uint8_t> content(sizeof(CacheFileHeader));
+    CacheFileHeader      header = { CACHE_FILE_MAGIC, CACHE_FILE_VERSION, versionChecksum_, calibrationChecksum_, static_cast<uint32_t>(entries_.size()) };
+    memcpy(content.data(), &header, sizeof(header));
+    for(const auto &entry: entries_) {
+        CacheFileEntryHeader entryHeader = { std::get<0>(entry.first), std::get<1>(entry.first), std::get<2>(entry.first),
+                                             static_cast<uint32_t>(entry.second.size()) };
+        auto                 begin       = reinterpret_cast<const uint8_t *>(&entryHeader);
+        content.insert(content.end(), begin, begin + sizeof(entryHeader));
+        content.insert(content.end(), entry.second.begin(), entry.second.end());
+    }
+    uint32_t crc = crc32(content.data(), content.size());
+    content.insert(content.end(), reinterpret_cast<const uint8_t *>(&crc), reinterpret_cast<const uint8_t *>(&crc) + sizeof(crc));
+
+    if(!utils::checkDir(directory_.c_str())) {
+        utils::mkDirs(directory_.c_str());
+    }
+
+    // Written to a temporary file of this process and renamed: other processes opening the same device never read a partial file, nor write
+    // the same temporary file
+#ifdef WIN32
+    auto pid = _getpid();
+#else
+    auto pid = getpid();
+#endif
+    auto          tmpPath = filePath_ + "." + std::to_string(pid) + ".tmp";
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if(!file.write(reinterpret_cast<const char *>(content.data()), content.size())) {
+        LOG_WARN("Device open cache {} not written", filePath_);
+        return;
+    }
+    file.close();
+#ifdef WIN32
+    std::remove(filePath_.c_str());  // rename does not replace an existing file
+#endif
+    if(std::rename(tmpPath.c_str(), filePath_.c_str()) != 0) {
+        LOG_WARN("Device open cache {} not written", filePath_);
+        std::remove(tmpPath.c_str());
+    }
+}
+
+}  // namespace libobsensor
@@ -0,0 +1,80 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace libobsensor {
+
+/**
+ * @brief On-disk cache of the results of the read-only vendor queries of a device (calibration parameters, stream profile lists, see
+ * isCacheable), used by VendorPropertyAccessor to skip the control transfers of these queries when the device is opened again.
+ * @brief One file per device, named after the serial number and the firmware version of the OB_STRUCT_VERSION data. The file also holds a
+ * checksum of the whole OB_STRUCT_VERSION data and one of the head of the calibration data: the cache is only used if the device returns the
+ * same data for both at open. The OB_STRUCT_VERSION data does not change when a device is re-calibrated with the same firmware, the head of
+ * the calibration data does. Calibration data written through the SDK erases its entries.
+ * @brief The entries added during an open are written to the file once, by flush() (called by the device at the end of its initialization)
+ * or by the destructor.
+ * @brief Opt-in, see createFromConfig (Device.OpenCache in the config file). Thread safe, shared by the vendor property accessors of a device.
+ */
+class VendorQueryCache {
+public:
+    enum QueryType : uint8_t {
+        QUERY_STRUCTURE_DATA           = 0,  // getStructureData
+        QUERY_STRUCTURE_DATA_LIST_V1_1 = 1,  // getStructureDataListProtoV1_1
+        QUERY_RAW_DATA                 = 2,  // getRawData
+    };
+
+    /**
+     * @brief Cache in the directory of the config file (Device.OpenCacheDir), nullptr if not enabled (Device.OpenCache)
+     */
+    static std::shared_ptr<VendorQueryCache> createFromConfig();
+
+    explicit VendorQueryCache(const std::string &directory);
+    ~VendorQueryCache() noexcept;
+
+    static bool isCacheable(uint32_t propertyId);
+
+    /**
+     * @brief Select the file of the device and load its entries if it was written for the same OB_STRUCT_VERSION data and calibration head,
+     * only done by the first call (the cache stays closed if it fails)
+     *
+     * @param[in] readVersionData Reads the OB_STRUCT_VERSION data from the device
+     * @param[in] readCalibrationHead Reads a small part of the calibration data from the device, which changes when the device is re-calibrated
+     */
+    void open(const std::function<std::vector<uint8_t>()> &readVersionData, const std::function<std::vector<uint8_t>()> &readCalibrationHead);
+    bool isOpen() const;
+
+    // false if not open or not cached
+    bool get(QueryType type, uint32_t propertyId, uint16_t cmdVersion, std::vector<uint8_t> &data) const;
+    // Adds the entry, written to the file by the next flush (nothing if not open)
+    void put(QueryType type, uint32_t propertyId, uint16_t cmdVersion, const std::vector<uint8_t> &data);
+    // Removes the entries of the property (written to the device) and writes the file
+    void erase(uint32_t propertyId);
+    // Writes the file if entries were added since it was loaded or written
+    void flush();
+
+private:
+    void load();
+    void save();  // with mutex_ locked
+
+    typedef std::tuple<uint8_t, uint32_t, uint16_t> EntryKey;  // type, property id, command version
+
+    mutable std::mutex                       mutex_;
+    bool                                     openCalled_;
+    bool                                     dirty_;  // entries not written to the file yet
+    std::string                              directory_;
+    std::string                              filePath_;  // empty until opened
+    uint32_t                                 versionChecksum_;
+    uint32_t                                 calibrationChecksum_;
+    std::map<EntryKey, std::vector<uint8_t>> entries_;
+};
+
+}  // namespace libobsensor
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "AccelSensor.hpp"
+#include "ImuStreamer.hpp"
 #include "IDevice.hpp"
 #include "property/InternalProperty.hpp"
 #include "stream/StreamProfileFactory.hpp"
@@ -60,6 +61,19 @@ AccelSensor::~AccelSensor() noexcept {
 }
 
 void AccelSensor::start(std::shared_ptr<const StreamProfile> sp, FrameCallback callback) {
+    start(sp, callback, false);
+}
+
+void AccelSensor::startBatched(std::shared_ptr<const StreamProfile> sp, FrameCallback callback) {
+    start(sp, callback, true);
+}
+
+void AccelSensor::start(std::shared_ptr<const StreamProfile> sp, FrameCallback callback, bool batched) {
+    auto imuStreamer = std::dynamic_pointer_cast<ImuStreamer>(streamer_);
+    if(batched && !imuStreamer) {
+        THROW_UNSUPPORTED_OPERATION_EXCEPTION("Batched streaming is not supported by the accel sensor of this device!");
+    }
+
     // validate device state
     validateDeviceState(sp);
 
@@ -76,14 +90,20 @@ void AccelSensor::start(std::shared_ptr<const StreamProfile> sp, FrameCallback c
     propServer->setPropertyValueT(OB_PROP_ACCEL_SWITCH_BOOL, true);
 
     BEGIN_TRY_EXECUTE({
-        streamer_->startStream(sp, [this](std::shared_ptr<Frame> frame) {
+        MutableFrameCallback streamCallback = [this](std::shared_ptr<Frame> frame) {
             if(streamState_ != STREAM_STATE_STREAMING && streamState_ != STREAM_STATE_STARTING) {
                 return;
             }
             updateStreamState(STREAM_STATE_STREAMING);
 
             outputFrame(frame);
-        });
+        };
+        if(batched) {
+            imuStreamer->startBatchStream(sp, streamCallback);
+        }
+        else {
+            streamer_->startStream(sp, streamCallback);
+        }
     })
     CATCH_EXCEPTION_AND_EXECUTE({
         activatedStreamProfile_.reset();
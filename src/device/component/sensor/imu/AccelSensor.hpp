@@ -7,7 +7,7 @@
 #include "IStreamer.hpp"
 
 namespace libobsensor {
-class AccelSensor : public SensorBase {
+class AccelSensor : public SensorBase, public IImuBatchSensor {
 public:
     AccelSensor(IDevice *owner, const std::shared_ptr<ISourcePort> &backend, const std::shared_ptr<IStreamer> &streamer);
     ~AccelSensor() noexcept override;
@@ -15,6 +15,12 @@ public:
     void start(std::shared_ptr<const StreamProfile> sp, FrameCallback callback) override;
     void stop() override;
 
+    // Requires an ImuStreamer
+    void startBatched(std::shared_ptr<const StreamProfile> sp, FrameCallback callback) override;
+
+private:
+    void start(std::shared_ptr<const StreamProfile> sp, FrameCallback callback, bool batched);
+
 private:
     std::shared_ptr<IStreamer> streamer_;
 };
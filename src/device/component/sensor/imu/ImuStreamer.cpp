@@ -14,13 +14,22 @@ namespace libobsensor {
 
 const size_t IMU_FILTER_FRAME_QUEUE_SIZE = 100;
 
+// A packet carries at most 255 samples (OBImuHeader::groupCount), so every batch frame has room for a whole packet and uses one pool
+const uint32_t IMU_BATCH_CAPACITY = UINT8_MAX;
+
 ImuStreamer::ImuStreamer(IDevice *owner, const std::shared_ptr<IDataStreamPort> &backend, const std::shared_ptr<IFilter> &filter,
                          std::shared_ptr<IImuCalculator> imuCalculator)
     : ImuStreamer(owner, backend, std::vector<std::shared_ptr<IFilter>>({ filter }), imuCalculator) {}
 
 ImuStreamer::ImuStreamer(IDevice *owner, const std::shared_ptr<IDataStreamPort> &backend, std::vector<std::shared_ptr<IFilter>> filters,
                          std::shared_ptr<IImuCalculator> imuCalculator)
-    : owner_(owner), backend_(backend), filters_(std::move(filters)), calculator_(imuCalculator), running_(false), frameIndex_(0) {
+    : owner_(owner),
+      backend_(backend),
+      filters_(std::move(filters)),
+      calculator_(imuCalculator),
+      streams_(std::make_shared<Streams>()),
+      running_(false),
+      frameIndex_(0) {
 
     if(!calculator_) {
         // default to ICM42668P
@@ -47,7 +56,7 @@ ImuStreamer::ImuStreamer(IDevice *owner, const std::shared_ptr<IDataStreamPort>
 ImuStreamer::~ImuStreamer() noexcept {
     {
         std::lock_guard<std::mutex> lock(cbMtx_);
-        callbacks_.clear();
+        streams_ = std::make_shared<Streams>();
     }
 
     if(running_) {
@@ -60,9 +69,19 @@ ImuStreamer::~ImuStreamer() noexcept {
 }
 
 void ImuStreamer::startStream(std::shared_ptr<const StreamProfile> sp, MutableFrameCallback callback) {
+    startStream(sp, callback, false);
+}
+
+void ImuStreamer::startBatchStream(std::shared_ptr<const StreamProfile> sp, MutableFrameCallback callback) {
+    startStream(sp, callback, true);
+}
+
+void ImuStreamer::startStream(std::shared_ptr<const StreamProfile> sp, MutableFrameCallback callback, bool batched) {
     {
         std::lock_guard<std::mutex> lock(cbMtx_);
-        callbacks_[sp] = callback;
+        auto                        callbacks = streams_->callbacks;
+        callbacks[sp]                         = { callback, batched };
+        updateStreams(std::move(callbacks));
         if(running_) {
             return;
         }
@@ -100,13 +119,15 @@ void ImuStreamer::stopStream(std::shared_ptr<const StreamProfile> sp) {
     LOG_DEBUG("ImuStreamer stop....");
     {
         std::lock_guard<std::mutex> lock(cbMtx_);
-        auto                        iter = callbacks_.find(sp);
-        if(iter == callbacks_.end()) {
+        auto                        callbacks = streams_->callbacks;
+        auto                        iter      = callbacks.find(sp);
+        if(iter == callbacks.end()) {
             THROW_ITEM_NOT_FOUND_EXCEPTION("Stop stream failed, stream profile not found.");
         }
 
-        callbacks_.erase(iter);
-        if(!callbacks_.empty()) {
+        callbacks.erase(iter);
+        updateStreams(std::move(callbacks));
+        if(!streams_->callbacks.empty()) {
             return;
         }
     }
@@ -122,6 +143,20 @@ void ImuStreamer::stopStream(std::shared_ptr<const StreamProfile> sp) {
     LOG_DEBUG("ImuStreamer stop finished.");
 }
 
+void ImuStreamer::updateStreams(StreamCallbackMap callbacks) {
+    auto streams = std::make_shared<Streams>();
+    for(const auto &iter: callbacks) {
+        if(iter.first->is<AccelStreamProfile>()) {
+            (iter.second.batched ? streams->batchAccelProfile : streams->accelProfile) = iter.first->as<AccelStreamProfile>();
+        }
+        else if(iter.first->is<GyroStreamProfile>()) {
+            (iter.second.batched ? streams->batchGyroProfile : streams->gyroProfile) = iter.first->as<GyroStreamProfile>();
+        }
+    }
+    streams->callbacks = std::move(callbacks);
+    streams_           = streams;
+}
+
 void ImuStreamer::parseIMUData(std::shared_ptr<Frame> frame) {
     auto         data     = frame->getData();
     OBImuHeader *header   = (OBImuHeader *)data;
@@ -162,21 +197,33 @@ void ImuStreamer::parseIMUData(std::shared_ptr<Frame> frame) {
         }
     }
 
-    std::shared_ptr<const AccelStreamProfile> accelStreamProfile;
-    std::shared_ptr<const GyroStreamProfile>  gyroStreamProfile;
+    std::shared_ptr<const Streams> streams;
     {
         std::lock_guard<std::mutex> lock(cbMtx_);
-        for(const auto &iter: callbacks_) {
-            if(iter.first->is<libobsensor::AccelStreamProfile>()) {
-                accelStreamProfile = iter.first->as<libobsensor::AccelStreamProfile>();
-            }
-            else if(iter.first->is<libobsensor::GyroStreamProfile>()) {
-                gyroStreamProfile = iter.first->as<libobsensor::GyroStreamProfile>();
-            }
-        }
+        streams = streams_;
     }
+    const auto &accelStreamProfile = streams->accelProfile;
+    const auto &gyroStreamProfile  = streams->gyroProfile;
 
     uint8_t *imuOrgData = (uint8_t *)data + sizeof(OBImuHeader);
+    if(streams->batchAccelProfile || streams->batchGyroProfile) {
+        auto samples    = (const OBImuOriginData *)imuOrgData + discardCount;
+        auto count      = static_cast<uint32_t>(header->groupCount - discardCount);
+        auto firstIndex = frameIndex_;
+        if(streams->batchAccelProfile) {
+            auto fs = static_cast<uint8_t>(streams->batchAccelProfile->getFullScaleRange());
+            outputBatch(streams->batchAccelProfile, fs, samples, count, firstIndex, frame);
+        }
+        if(streams->batchGyroProfile) {
+            auto fs = static_cast<uint8_t>(streams->batchGyroProfile->getFullScaleRange());
+            outputBatch(streams->batchGyroProfile, fs, samples, count, firstIndex, frame);
+        }
+        if(!accelStreamProfile && !gyroStreamProfile) {
+            frameIndex_ += count;
+            return;
+        }
+    }
+
     for(int groupIndex = discardCount; groupIndex < header->groupCount; groupIndex++) {
         auto frameSet = FrameFactory::createFrameSet();
 
@@ -218,12 +265,51 @@ void ImuStreamer::parseIMUData(std::shared_ptr<Frame> frame) {
             gyroFrame->setSteadyTimeStampUsec(steadyTspUs);
             frameSet->pushFrame(gyroFrame);
         }
-        if(!filters_.empty()) {
-            filters_.front()->pushFrame(frameSet);
+        pushFrame(frameSet);
+    }
+}
+
+void ImuStreamer::outputBatch(const std::shared_ptr<const StreamProfile> &profile, uint8_t fullScaleRange, const OBImuOriginData *samples, uint32_t count,
+                              uint64_t firstIndex, const std::shared_ptr<Frame> &packet) {
+    if(count == 0) {
+        // no sample to timestamp the batch with
+        return;
+    }
+
+    auto batchFrame = FrameFactory::createImuBatchFrame(profile, IMU_BATCH_CAPACITY);
+    auto arrays     = batchFrame->getArraysMutable();
+    bool isAccel    = profile->getType() == OB_STREAM_ACCEL;
+    for(uint32_t i = 0; i < count; i++) {
+        const auto &sample  = samples[i];
+        arrays.timestamp[i] = (uint64_t)sample.timestamp[0] | ((uint64_t)sample.timestamp[1] << 32);
+        if(isAccel) {
+            arrays.x[i] = calculator_->calculateAccelGravity(sample.accelX, fullScaleRange);
+            arrays.y[i] = calculator_->calculateAccelGravity(sample.accelY, fullScaleRange);
+            arrays.z[i] = calculator_->calculateAccelGravity(sample.accelZ, fullScaleRange);
         }
         else {
-            outputFrame(frameSet);
+            arrays.x[i] = calculator_->calculateGyroDPS(sample.gyroX, fullScaleRange);
+            arrays.y[i] = calculator_->calculateGyroDPS(sample.gyroY, fullScaleRange);
+            arrays.z[i] = calculator_->calculateGyroDPS(sample.gyroZ, fullScaleRange);
         }
+        arrays.temperature[i] = calculator_->calculateRegisterTemperature(sample.temperature);
+    }
+    batchFrame->setSampleCount(count);
+
+    // The batch is numbered and timestamped by its first sample
+    batchFrame->setNumber(firstIndex);
+    batchFrame->setTimeStampUsec(arrays.timestamp[0]);
+    batchFrame->setSystemTimeStampUsec(packet->getSystemTimeStampUsec());
+    batchFrame->setSteadyTimeStampUsec(packet->getSteadyTimeStampUsec());
+    pushFrame(batchFrame);
+}
+
+void ImuStreamer::pushFrame(std::shared_ptr<Frame> frame) {
+    if(!filters_.empty()) {
+        filters_.front()->pushFrame(frame);
+    }
+    else {
+        outputFrame(frame);
     }
 }
 
@@ -231,15 +317,19 @@ void ImuStreamer::outputFrame(std::shared_ptr<Frame> frame) {
     if(!frame) {
         return;
     }
-    std::map<std::shared_ptr<const StreamProfile>, MutableFrameCallback> callbacks;
+    std::shared_ptr<const Streams> streams;
     {
         std::lock_guard<std::mutex> lock(cbMtx_);
-        callbacks = callbacks_;
+        streams = streams_;
     }
 
-    for(auto &callback: callbacks) {
+    bool isBatch = frame->getType() == OB_FRAME_IMU_BATCH;
+    for(auto &callback: streams->callbacks) {
+        if(callback.second.batched != isBatch) {
+            continue;
+        }
         std::shared_ptr<Frame> callbackFrame = frame;
-        if(frame->is<FrameSet>()) {
+        if(frame->getType() == OB_FRAME_SET) {
             auto frameSet  = frame->as<FrameSet>();
             auto frameType = utils::mapStreamTypeToFrameType(callback.first->getType());
             callbackFrame  = frameSet->getFrameMutable(frameType);
@@ -250,7 +340,7 @@ void ImuStreamer::outputFrame(std::shared_ptr<Frame> frame) {
         if(callbackFrame->getFormat() != callback.first->getFormat()) {
             continue;
         }
-        callback.second(callbackFrame);
+        callback.second.callback(callbackFrame);
     }
 }
 
@@ -8,6 +8,7 @@
 #include "IDeviceComponent.hpp"
 #include "ImuCalculator.hpp"
 #include "IStreamer.hpp"
+#include "stream/StreamProfile.hpp"
 
 #include <atomic>
 #include <map>
@@ -47,20 +48,48 @@ public:
     virtual void startStream(std::shared_ptr<const StreamProfile> profile, MutableFrameCallback callback) override;
     virtual void stopStream(std::shared_ptr<const StreamProfile> profile) override;
 
+    /**
+     * @brief Starts a stream that delivers the samples in batches: one ImuBatchFrame with all the samples of the stream in a packet of the device,
+     * instead of one frame per sample. Stopped with stopStream().
+     */
+    void startBatchStream(std::shared_ptr<const StreamProfile> profile, MutableFrameCallback callback);
+
     IDevice *getOwner() const override;
 
 private:
+    struct StreamCallback {
+        MutableFrameCallback callback;
+        bool                 batched;
+    };
+    typedef std::map<std::shared_ptr<const StreamProfile>, StreamCallback> StreamCallbackMap;
+
+    // Started streams, replaced as a whole when a stream starts or stops, so the packet thread only takes a reference under the lock
+    struct Streams {
+        StreamCallbackMap                         callbacks;
+        std::shared_ptr<const AccelStreamProfile> accelProfile;  // per-sample streams
+        std::shared_ptr<const GyroStreamProfile>  gyroProfile;
+        std::shared_ptr<const AccelStreamProfile> batchAccelProfile;  // batched streams
+        std::shared_ptr<const GyroStreamProfile>  batchGyroProfile;
+    };
+
+    void startStream(std::shared_ptr<const StreamProfile> profile, MutableFrameCallback callback, bool batched);
+    void updateStreams(StreamCallbackMap callbacks);  // call with cbMtx_ held
+
     virtual void parseIMUData(std::shared_ptr<Frame> frame);
     virtual void outputFrame(std::shared_ptr<Frame> frame);
 
+    void outputBatch(const std::shared_ptr<const StreamProfile> &profile, uint8_t fullScaleRange, const OBImuOriginData *samples, uint32_t count,
+                     uint64_t firstIndex, const std::shared_ptr<Frame> &packet);
+    void pushFrame(std::shared_ptr<Frame> frame);
+
 private:
     IDevice                              *owner_;
     std::shared_ptr<IDataStreamPort>      backend_;
     std::vector<std::shared_ptr<IFilter>> filters_;
     std::shared_ptr<IImuCalculator>       calculator_;
 
-    std::mutex                                                           cbMtx_;
-    std::map<std::shared_ptr<const StreamProfile>, MutableFrameCallback> callbacks_;
+    std::mutex                     cbMtx_;
+    std::shared_ptr<const Streams> streams_;
 
     std::atomic_bool running_;
     uint64_t         frameIndex_;
@@ -144,12 +144,14 @@ std::shared_ptr<IDevice> DeviceManager::createDevice(const std::shared_ptr<const
     LOG_DEBUG("DeviceManager createDevice with access mode: {}...", accessMode);
     accessMode = DeviceBase::normalizeMode(accessMode);
 
-    // check if the device has been created
+    // check if the device has been created, or wait for the creation of the device by another thread (see ob_device_list_get_devices)
+    auto uid = info->getUid();
     {
         std::unique_lock<std::mutex> lock(createdDevicesMutex_);
-        auto                         iter = createdDevices_.begin();
+        createdDevicesCv_.wait(lock, [&]() { return creatingDevices_.find(uid) == creatingDevices_.end(); });
+        auto iter = createdDevices_.begin();
         for(; iter != createdDevices_.end(); ++iter) {
-            if(iter->first == info->getUid()) {
+            if(iter->first == uid) {
                 auto dev = iter->second.lock();
                 if(!dev) {
                     createdDevices_.erase(iter);
@@ -168,36 +170,56 @@ std::shared_ptr<IDevice> DeviceManager::createDevice(const std::shared_ptr<const
                 return dev;
             }
         }
+        creatingDevices_.insert(uid);
     }
 
-    // create device
-    auto device = info->createDevice(accessMode);
-    if(!device->hasAccessControl()) {
-        LOG_DEBUG("Access control is not supported on this device. Access mode '{}' was ignored", accessMode);
-    }
+    // the devices are created without the lock: different devices are created in parallel
+    auto finishCreating = [&]() {
+        std::unique_lock<std::mutex> lock(createdDevicesMutex_);
+        creatingDevices_.erase(uid);
+        createdDevicesCv_.notify_all();
+    };
+
+    std::shared_ptr<IDevice> device;
+    utils::PhaseTimer        timer;
+    try {
+        // create device
+        device = info->createDevice(accessMode);
+        timer.mark("construct");
+        if(!device->hasAccessControl()) {
+            LOG_DEBUG("Access control is not supported on this device. Access mode '{}' was ignored", accessMode);
+        }
 
-    // remove activity for the device
-    deviceActivityManager_->removeActivity(info->getUid());
-    // register callback for reboot
-    device->registerRebootCallback([&](const std::shared_ptr<IDevice> device) {
-        if(!destroy_ && device && deviceActivityManager_) {
-            deviceActivityManager_->notifyDeviceReboot(device->getInfo()->uid_);
+        // remove activity for the device
+        deviceActivityManager_->removeActivity(uid);
+        // register callback for reboot
+        device->registerRebootCallback([&](const std::shared_ptr<IDevice> device) {
+            if(!destroy_ && device && deviceActivityManager_) {
+                deviceActivityManager_->notifyDeviceReboot(device->getInfo()->uid_);
+            }
+        });
+        // add to createdDevices_
+        {
+            std::unique_lock<std::mutex> lock(createdDevicesMutex_);
+            createdDevices_.insert({ uid, device });
         }
-    });
-    // add to createdDevices_
-    {
-        std::unique_lock<std::mutex> lock(createdDevicesMutex_);
-        createdDevices_.insert({ info->getUid(), device });
-    }
 
-    if(!isCustomConnectedDevice_) {
-        // initialization that can only be performed after construction is complete
-        device->postInitialize();
+        if(!isCustomConnectedDevice_) {
+            // initialization that can only be performed after construction is complete
+            device->postInitialize();
+            timer.mark("postInitialize");
+        }
+    }
+    catch(...) {
+        finishCreating();
+        throw;
     }
+    finishCreating();
 
     auto devInfo = device->getInfo();
     LOG_INFO("Device created successfully! Name: {0}, PID: 0x{1:04x}, SN/ID: {2} FW: {3}", devInfo->name_, devInfo->pid_, devInfo->deviceSn_,
              devInfo->fwVersion_);
+    LOG_DEBUG("Device creation time of {0}: {1}", devInfo->deviceSn_, timer.toString());
     return device;
 }
 
@@ -8,7 +8,9 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
 #include <mutex>
+#include <condition_variable>
 #include <thread>
 #include "utils/SteadyCondVar.hpp"
 #include <atomic>
@@ -65,7 +67,9 @@ private:
     std::unordered_map<OBCallbackId, DeviceChangedCallback> devChangedCallbacks_;
 
     std::map<std::string, std::weak_ptr<IDevice>> createdDevices_;
+    std::set<std::string>                         creatingDevices_;  // uid of the devices being created, the other callers wait for them
     std::mutex                                    createdDevicesMutex_;
+    std::condition_variable                       createdDevicesCv_;
 
     std::thread          multiDeviceSyncThread_;
     utils::SteadyCondVar multiDeviceSyncCv_;
@@ -51,6 +51,7 @@
 #include "G330SensorStreamStrategy.hpp"
 #include "G330PropertyAccessors.hpp"
 #include "property/HardwareD2CPropertyAccessor.hpp"
+#include "property/VendorQueryCache.hpp"
 #include "G330FrameMetadataParserContainer.hpp"
 #include "utils/BufferParser.hpp"
 #include "G330FrameInterleaveManager.hpp"
@@ -77,8 +78,12 @@ constexpr uint8_t  INTERFACE_COLOR        = 4;
 constexpr uint8_t  INTERFACE_DEPTH        = 0;
 constexpr uint16_t GMSL_MAX_CMD_DATA_SIZE = 232;
 
-G330Device::G330Device(const std::shared_ptr<const IDeviceEnumInfo> &info) : DeviceBase(info), isGmslDevice_(info->getConnectionType() == "GMSL2") {
+G330Device::G330Device(const std::shared_ptr<const IDeviceEnumInfo> &info)
+    : DeviceBase(info), isGmslDevice_(info->getConnectionType() == "GMSL2"), vendorQueryCache_(VendorQueryCache::createFromConfig()) {
     init();
+    if(vendorQueryCache_) {
+        vendorQueryCache_->flush();  // the queries of the initialization are written to the cache file at once
+    }
 
     // check and start heartbeat after initialization is complete
     checkAndStartHeartbeat();
@@ -87,6 +92,7 @@ G330Device::G330Device(const std::shared_ptr<const IDeviceEnumInfo> &info) : Dev
 G330Device::~G330Device() noexcept {}
 
 void G330Device::init() {
+    utils::PhaseTimer timer;
     if(isGmslDevice_) {
         LOG_DEBUG("G330Device::init() for GMSL2 device");
         initSensorListGMSL();
@@ -94,9 +100,27 @@ void G330Device::init() {
     else {
         initSensorList();
     }
+    timer.mark("initSensorList");
     initProperties();
+    timer.mark("initProperties");
     fetchDeviceInfo();
+    timer.mark("fetchDeviceInfo");
+
+    if(!isGmslDevice_) {
+        // The rest of the initialization (extension info, calibration, depth work modes...) runs on the depth port (uvc xu), the ports of the
+        // other sensors are opened meanwhile
+        std::vector<std::shared_ptr<const SourcePortInfo>> otherPortInfos;
+        for(auto &portInfo: enumInfo_->getSourcePortInfoList()) {
+            auto usbPortInfo = std::dynamic_pointer_cast<const USBSourcePortInfo>(portInfo);
+            if(usbPortInfo && !(portInfo->portType == SOURCE_PORT_USB_UVC && usbPortInfo->infIndex == INTERFACE_DEPTH)) {
+                otherPortInfos.push_back(portInfo);
+            }
+        }
+        openSourcePortsAsync(otherPortInfos);
+    }
+
     fetchExtensionInfo();
+    timer.mark("fetchExtensionInfo");
 
     videoFrameTimestampCalculatorCreator_ = [this]() {
         auto vid          = deviceInfo_->vid_;
@@ -113,9 +137,11 @@ void G330Device::init() {
 
     auto algParamManager = std::make_shared<G330AlgParamManager>(this);
     registerComponent(OB_DEV_COMPONENT_ALG_PARAM_MANAGER, algParamManager);
+    timer.mark("fetchCalibration");
 
     auto depthWorkModeManager = std::make_shared<G330DepthWorkModeManager>(this);
     registerComponent(OB_DEV_COMPONENT_DEPTH_WORK_MODE_MANAGER, depthWorkModeManager);
+    timer.mark("fetchDepthWorkModes");
 
     if(getFirmwareVersionInt() >= 10441) {
         // support custom presets upgrade
@@ -304,6 +330,11 @@ void G330Device::init() {
         false);
 
     fetchDeviceErrorState();
+    timer.mark("initComponents");
+
+    waitSourcePortsOpened();
+    timer.mark("waitSourcePortsOpened");
+    LOG_DEBUG("G330 device initialization time: {}", timer.toString());
 }
 
 void G330Device::fetchDeviceInfo() {
@@ -621,6 +652,7 @@ void G330Device::initSensorList() {
             auto uvcDevicePort = std::dynamic_pointer_cast<UvcDevicePort>(port);
             uvcDevicePort->updateXuUnit(OB_G330_XU_UNIT);  // update xu unit to g330 xu unit
             auto accessor = std::make_shared<VendorPropertyAccessor>(this, port);
+            accessor->setQueryCache(vendorQueryCache_);
 
             auto        envConfig    = EnvConfig::getInstance();
             std::string deviceName   = utils::string::removeSpace(deviceInfo_->name_);
@@ -865,6 +897,7 @@ void                 G330Device::initSensorListGMSL() {
             auto uvcDevicePort = std::dynamic_pointer_cast<UvcDevicePort>(port);
             uvcDevicePort->updateXuUnit(OB_G330_XU_UNIT);  // update xu unit to g330 xu unit
             auto accessor = std::make_shared<VendorPropertyAccessor>(this, port);
+            accessor->setQueryCache(vendorQueryCache_);
             accessor->setRawdataTransferPacketSize(GMSL_MAX_CMD_DATA_SIZE);
             accessor->setStructListDataTransferPacketSize(GMSL_MAX_CMD_DATA_SIZE);
             return accessor;
@@ -1465,8 +1498,12 @@ static uint16_t calcG335LeMaxDepthValue(OBFormat format, float depthUnit, bool h
     return maxValue > 65535 ? 65535 : static_cast<uint16_t>(maxValue);
 }
 
-G330NetDevice::G330NetDevice(const std::shared_ptr<const IDeviceEnumInfo> &info, OBDeviceAccessMode accessMode) : DeviceBase(info, accessMode) {
+G330NetDevice::G330NetDevice(const std::shared_ptr<const IDeviceEnumInfo> &info, OBDeviceAccessMode accessMode)
+    : DeviceBase(info, accessMode), vendorQueryCache_(VendorQueryCache::createFromConfig()) {
     init();
+    if(vendorQueryCache_) {
+        vendorQueryCache_->flush();  // the queries of the initialization are written to the cache file at once
+    }
 
     // check and start heartbeat after initialization is complete
     checkAndStartHeartbeat();
@@ -2021,6 +2058,7 @@ void G330NetDevice::initSensorList() {
         registerComponent(OB_DEV_COMPONENT_MAIN_PROPERTY_ACCESSOR, [this, vendorPortInfo]() {
             auto port     = getSourcePort(vendorPortInfo);
             auto accessor = std::make_shared<VendorPropertyAccessor>(this, port);
+            accessor->setQueryCache(vendorQueryCache_);
             return accessor;
         });
 
@@ -2185,6 +2223,7 @@ void G330NetDevice::initProperties() {
             auto vendorPropertyAccessor = std::make_shared<LazySuperPropertyAccessor>([this, &sourcePortInfo]() {
                 auto port     = getSourcePort(sourcePortInfo);
                 auto accessor = std::make_shared<VendorPropertyAccessor>(this, port);
+                accessor->setQueryCache(vendorQueryCache_);
                 return accessor;
             });
 
@@ -2210,6 +2249,7 @@ void G330NetDevice::initProperties() {
             auto vendorPropertyAccessor = std::make_shared<LazySuperPropertyAccessor>([this, &sourcePortInfo]() {
                 auto port     = getSourcePort(sourcePortInfo);
                 auto accessor = std::make_shared<VendorPropertyAccessor>(this, port);
+                accessor->setQueryCache(vendorQueryCache_);
                 return accessor;
             });
 
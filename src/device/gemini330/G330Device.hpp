@@ -16,6 +16,8 @@
 
 namespace libobsensor {
 
+class VendorQueryCache;
+
 class G330Device : public DeviceBase {
 public:
     G330Device(const std::shared_ptr<const IDeviceEnumInfo> &info);
@@ -45,6 +47,7 @@ private:
     std::function<std::shared_ptr<IFrameTimestampCalculator>()> videoFrameTimestampCalculatorCreator_;
     std::shared_ptr<IFrameTimestampCalculator>                  intraCameraSyncTimestampAdjuster_;
     bool                                                        isGmslDevice_;
+    std::shared_ptr<VendorQueryCache>                           vendorQueryCache_;  // shared by the vendor property accessors, nullptr if disabled
 };
 
 #if defined(BUILD_NET_PAL)
@@ -84,6 +87,7 @@ private:
     std::function<std::shared_ptr<IFrameTimestampCalculator>()> videoFrameTimestampCalculatorCreator_;
     std::shared_ptr<IFrameTimestampCalculator>                  intraCameraSyncTimestampAdjuster_;
     std::shared_ptr<GvcpCcpController>                          ccpController_;
+    std::shared_ptr<VendorQueryCache>                           vendorQueryCache_;  // shared by the vendor property accessors, nullptr if disabled
 
     StreamProfileList allNetProfileList_;
 
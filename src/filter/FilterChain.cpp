@@ -0,0 +1,64 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "FilterChain.hpp"
+#include "PixelOpProgram.hpp"
+#include "frame/FrameFactory.hpp"
+
+namespace libobsensor {
+
+std::shared_ptr<Frame> FilterChain::process(const std::vector<std::shared_ptr<IFilter>> &filters, std::shared_ptr<const Frame> frame) {
+    if(!frame) {
+        return nullptr;
+    }
+
+    std::shared_ptr<Frame> current;  // output of the last filter, nullptr while no filter ran
+    for(size_t i = 0; i < filters.size(); i++) {
+        const auto &filter = filters[i];
+        if(!filter->isEnabled()) {
+            continue;
+        }
+
+        // Only this chain holds the frame: nobody can see it change
+        bool                         exclusive = current && current.use_count() == 1;
+        std::shared_ptr<const Frame> input     = current ? current : frame;
+        if(PixelOpProgram::isSupported(input)) {
+            // Several per-pixel filters in a row: one pass over the frame for all of them
+            PixelOpProgram program(input);
+            size_t         fused = 0;
+            size_t         next  = i;
+            for(; next < filters.size(); next++) {
+                if(filters[next]->isEnabled()) {
+                    if(!filters[next]->appendPixelOp(program)) {
+                        break;
+                    }
+                    fused++;
+                }
+            }
+            if(fused >= 2) {
+                if(!exclusive) {
+                    current = FrameFactory::createFrameFromOtherFrame(input);
+                }
+                program.run(input, current);
+                i = next - 1;
+                continue;
+            }
+        }
+
+        if(exclusive && filter->isInPlaceCapable() && filter->processInPlace(current)) {
+            continue;
+        }
+
+        current = filter->process(input);
+        if(!current) {
+            return nullptr;
+        }
+    }
+
+    if(!current) {
+        return FrameFactory::createFrameView(frame);
+    }
+    return current;
+}
+
+}  // namespace libobsensor
@@ -0,0 +1,33 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "IFilter.hpp"
+#include <memory>
+#include <vector>
+
+namespace libobsensor {
+
+/**
+ * @brief Synchronous processing of a frame by filters one after the other, e.g. the recommended depth post-processing filters.
+ * @brief The frames created by the filters of the chain are held by the chain only: the in-place capable filters
+ * (IFilterBase::isInPlaceCapable) process them in place instead of allocating a new frame. The input frame of the chain and the frames
+ * also held elsewhere (e.g. returned unchanged by a filter) go through IFilterBase::process().
+ * @brief Consecutive enabled filters appending their operation to a PixelOpProgram (threshold, pixel value scale and offset, mirror, flip of
+ * a Y16 depth frame) run in a single pass over the frame when there are at least two of them.
+ */
+class FilterChain {
+public:
+    /**
+     * @brief Process the frame by the enabled filters
+     *
+     * @param[in] filters filters in processing order, the disabled ones are skipped
+     * @param[in] frame frame to process, never modified
+     *
+     * @return the processed frame, a view of the input frame if no filter is enabled (see FrameFactory::createFrameView), nullptr if a
+     * filter returns no frame
+     */
+    static std::shared_ptr<Frame> process(const std::vector<std::shared_ptr<IFilter>> &filters, std::shared_ptr<const Frame> frame);
+};
+
+}  // namespace libobsensor
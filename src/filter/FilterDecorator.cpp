@@ -11,7 +11,7 @@ namespace libobsensor {
 const size_t DEFAULT_FRAME_QUEUE_CAPACITY = 10;
 
 FilterExtension::FilterExtension(const std::string &name) : name_(name), enabled_(true), configChanged_(false) {
-    srcFrameQueue_ = std::make_shared<FrameQueue<const Frame>>(DEFAULT_FRAME_QUEUE_CAPACITY);  // todo: read from config file to set the size of frame queue
+    srcFrameQueue_ = std::make_shared<MpscFrameQueue<const Frame>>(DEFAULT_FRAME_QUEUE_CAPACITY);  // todo: read from config file to set the size of frame queue
     LOG_DEBUG("Filter {} created with frame queue capacity {}", name_, srcFrameQueue_->capacity());
 }
 
@@ -38,7 +38,7 @@ void FilterExtension::pushFrame(std::shared_ptr<const Frame> frame) {
                     })
                 }
                 else {
-                    rstFrame = FrameFactory::createFrameFromOtherFrame(frameToProcess, true);
+                    rstFrame = FrameFactory::createFrameView(frameToProcess);
                 }
                 std::unique_lock<std::mutex> lock(callbackMutex_);
                 if(callback_ && rstFrame) {
@@ -325,6 +325,28 @@ std::shared_ptr<Frame> FilterDecorator::process(std::shared_ptr<const Frame> fra
     return baseFilter_->process(frame);
 }
 
+bool FilterDecorator::isInPlaceCapable() const {
+    return baseFilter_->isInPlaceCapable();
+}
+
+bool FilterDecorator::processInPlace(std::shared_ptr<Frame> frame) {
+    if(!frame) {
+        return false;
+    }
+
+    checkAndUpdateConfig();
+
+    std::unique_lock<std::mutex> lock(processMutex_);
+    return baseFilter_->processInPlace(frame);
+}
+
+bool FilterDecorator::appendPixelOp(PixelOpProgram &program) {
+    checkAndUpdateConfig();
+
+    std::unique_lock<std::mutex> lock(processMutex_);
+    return baseFilter_->appendPixelOp(program);
+}
+
 std::shared_ptr<IDevice> FilterDecorator::getActivatedDevice() const {
     return baseFilter_->getActivatedDevice();
 }
@@ -3,7 +3,7 @@
 
 #pragma once
 #include "IFilter.hpp"
-#include "frame/FrameQueue.hpp"
+#include "frame/MpscFrameQueue.hpp"
 #include "stream/StreamProfile.hpp"
 #include <atomic>
 #include <memory>
@@ -47,7 +47,7 @@ private:
     std::mutex     callbackMutex_;
     FilterCallback callback_;
 
-    std::shared_ptr<FrameQueue<const Frame>> srcFrameQueue_;
+    std::shared_ptr<MpscFrameQueue<const Frame>> srcFrameQueue_;  // frames may be pushed from several threads
 
     std::recursive_mutex                  configMutex_;
     std::atomic<bool>                     configChanged_;
@@ -66,6 +66,9 @@ public:
     virtual void                   setConfigData(void *data, uint32_t size) override;
     virtual const std::string     &getConfigSchema() const override;
     virtual std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override;
+    bool                           isInPlaceCapable() const override;
+    bool                           processInPlace(std::shared_ptr<Frame> frame) override;
+    bool                           appendPixelOp(PixelOpProgram &program) override;
     std::shared_ptr<IDevice>       getActivatedDevice() const override;
     void                           activate(std::shared_ptr<IDevice> device, const ob_priv_filter_activate_options *options = nullptr) override;
 
@@ -16,6 +16,7 @@
 namespace libobsensor {
 
 class IDevice;
+class PixelOpProgram;
 
 typedef std::function<void(std::shared_ptr<Frame>)> FilterCallback;
 
@@ -33,6 +34,24 @@ public:
     // Synchronize
     virtual std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) = 0;
 
+    // In place (opt-in): a filter keeping the size and format of the frames can also process a frame nobody else holds instead of allocating
+    // the output frame, see FilterChain. processInPlace() returns false if it does not process this frame, process() is then used.
+    virtual bool isInPlaceCapable() const {
+        return false;
+    }
+
+    virtual bool processInPlace(std::shared_ptr<Frame> frame) {
+        (void)frame;
+        return false;
+    }
+
+    // Fusion (opt-in): a filter computing each pixel of a Y16 depth frame from one input pixel appends its operation to a program run in a
+    // single pass for several filters, see PixelOpProgram and FilterChain. Returns false if the operation cannot be fused.
+    virtual bool appendPixelOp(PixelOpProgram &program) {
+        (void)program;
+        return false;
+    }
+
     virtual std::shared_ptr<IDevice> getActivatedDevice() const {
         return nullptr;
     }
@@ -0,0 +1,271 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "PixelOpProgram.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OB_PIXEL_OP_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON) || defined(__NEON__)
+#include <arm_neon.h>
+#define OB_PIXEL_OP_NEON
+#endif
+
+namespace libobsensor {
+
+PixelOpProgram::PixelOpProgram(std::shared_ptr<const Frame> frame) : mirror_(false), flip_(false) {
+    auto depthFrame = frame->tryAs<DepthFrame>();
+    width_          = depthFrame->getWidth();
+    height_         = depthFrame->getHeight();
+    valueScale_     = depthFrame->getValueScale();
+    pixelBitSize_   = depthFrame->getPixelAvailableBitSize();
+    streamProfile_  = frame->getStreamProfile();
+}
+
+bool PixelOpProgram::isSupported(std::shared_ptr<const Frame> frame) {
+    return frame && frame->getType() == OB_FRAME_DEPTH && frame->getFormat() == OB_FORMAT_Y16 && frame->tryAs<DepthFrame>() != nullptr
+           && frame->getStreamProfile() != nullptr;
+}
+
+void PixelOpProgram::addThreshold(uint32_t min, uint32_t max) {
+    Op op = { OP_THRESHOLD, 0, 0, 0.0f, 0 };
+    if(min >= max || min > 0xFFFF) {
+        op.type = OP_ZERO;
+    }
+    else {
+        op.min = static_cast<uint16_t>(min);
+        op.max = static_cast<uint16_t>(std::min<uint32_t>(max, 0xFFFF));
+    }
+    ops_.push_back(op);
+}
+
+void PixelOpProgram::addScale(float scale) {
+    Op op = { OP_SCALE, 0, 0, scale, 0 };
+    ops_.push_back(op);
+    valueScale_ *= scale;
+}
+
+void PixelOpProgram::addOffset(int8_t offset) {
+    if(offset == 0) {
+        return;
+    }
+    Op op = { offset > 0 ? OP_SHIFT_RIGHT : OP_SHIFT_LEFT, 0, 0, 0.0f, offset > 0 ? offset : -offset };
+    ops_.push_back(op);
+    pixelBitSize_ = static_cast<uint8_t>(pixelBitSize_ - offset);
+}
+
+void PixelOpProgram::addMirror(std::shared_ptr<const StreamProfile> streamProfile) {
+    mirror_        = !mirror_;
+    streamProfile_ = streamProfile;
+}
+
+void PixelOpProgram::addFlip(std::shared_ptr<const StreamProfile> streamProfile) {
+    flip_          = !flip_;
+    streamProfile_ = streamProfile;
+}
+
+float PixelOpProgram::getValueScale() const {
+    return valueScale_;
+}
+
+std::shared_ptr<const StreamProfile> PixelOpProgram::getStreamProfile() const {
+    return streamProfile_;
+}
+
+namespace {
+
+// Same operations as the filters of FramePixelValueProcess.cpp, pixel by pixel
+void applyOpScalar(const PixelOpProgram::Op &op, const uint16_t *src, uint16_t *dst, uint32_t begin, uint32_t count) {
+    for(uint32_t j = begin; j < count; j++) {
+        uint16_t value = src[j];
+        switch(op.type) {
+        case PixelOpProgram::OP_ZERO:
+            value = 0;
+            break;
+        case PixelOpProgram::OP_THRESHOLD:
+            value = (value < op.min || value > op.max) ? 0 : value;
+            break;
+        case PixelOpProgram::OP_SCALE:
+            value = (uint16_t)(value * op.scale);
+            break;
+        case PixelOpProgram::OP_SHIFT_RIGHT:
+            value = static_cast<uint16_t>(value >> op.shift);
+            break;
+        case PixelOpProgram::OP_SHIFT_LEFT:
+            value = static_cast<uint16_t>(value << op.shift);
+            break;
+        }
+        dst[j] = value;
+    }
+}
+
+// One operation on count pixels, src may be dst
+void applyOp(const PixelOpProgram::Op &op, const uint16_t *src, uint16_t *dst, uint32_t count) {
+    uint32_t j = 0;
+#if defined(OB_PIXEL_OP_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    switch(op.type) {
+    case PixelOpProgram::OP_ZERO:
+        for(; j + 8 <= count; j += 8) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j), zero);
+        }
+        break;
+    case PixelOpProgram::OP_THRESHOLD: {
+        // Unsigned compare with the signed instructions
+        const __m128i bias = _mm_set1_epi16(static_cast<short>(0x8000));
+        const __m128i min  = _mm_xor_si128(_mm_set1_epi16(static_cast<short>(op.min)), bias);
+        const __m128i max  = _mm_xor_si128(_mm_set1_epi16(static_cast<short>(op.max)), bias);
+        for(; j + 8 <= count; j += 8) {
+            __m128i value  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + j));
+            __m128i biased = _mm_xor_si128(value, bias);
+            __m128i out    = _mm_or_si128(_mm_cmplt_epi16(biased, min), _mm_cmpgt_epi16(biased, max));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j), _mm_andnot_si128(out, value));
+        }
+    } break;
+    case PixelOpProgram::OP_SCALE: {
+        const __m128 scale = _mm_set1_ps(op.scale);
+        for(; j + 8 <= count; j += 8) {
+            __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + j));
+            __m128i lo    = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(value, zero)), scale));
+            __m128i hi    = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(value, zero)), scale));
+            // Keep the low 16 bits as the scalar cast does, the signed pack then does not saturate
+            lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+            hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j), _mm_packs_epi32(lo, hi));
+        }
+    } break;
+    case PixelOpProgram::OP_SHIFT_RIGHT:
+    case PixelOpProgram::OP_SHIFT_LEFT: {
+        const __m128i shift = _mm_cvtsi32_si128(op.shift);
+        bool          right = op.type == PixelOpProgram::OP_SHIFT_RIGHT;
+        for(; j + 8 <= count; j += 8) {
+            __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + j));
+            value         = right ? _mm_srl_epi16(value, shift) : _mm_sll_epi16(value, shift);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j), value);
+        }
+    } break;
+    }
+#elif defined(OB_PIXEL_OP_NEON)
+    switch(op.type) {
+    case PixelOpProgram::OP_ZERO:
+        for(; j + 8 <= count; j += 8) {
+            vst1q_u16(dst + j, vdupq_n_u16(0));
+        }
+        break;
+    case PixelOpProgram::OP_THRESHOLD: {
+        const uint16x8_t min = vdupq_n_u16(op.min);
+        const uint16x8_t max = vdupq_n_u16(op.max);
+        for(; j + 8 <= count; j += 8) {
+            uint16x8_t value = vld1q_u16(src + j);
+            vst1q_u16(dst + j, vbicq_u16(value, vorrq_u16(vcltq_u16(value, min), vcgtq_u16(value, max))));
+        }
+    } break;
+    case PixelOpProgram::OP_SCALE: {
+        const float32x4_t scale = vdupq_n_f32(op.scale);
+        for(; j + 8 <= count; j += 8) {
+            uint16x8_t value = vld1q_u16(src + j);
+            int32x4_t  lo    = vcvtq_s32_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(value))), scale));
+            int32x4_t  hi    = vcvtq_s32_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(value))), scale));
+            vst1q_u16(dst + j, vcombine_u16(vmovn_u32(vreinterpretq_u32_s32(lo)), vmovn_u32(vreinterpretq_u32_s32(hi))));
+        }
+    } break;
+    case PixelOpProgram::OP_SHIFT_RIGHT:
+    case PixelOpProgram::OP_SHIFT_LEFT: {
+        const int16x8_t shift = vdupq_n_s16(static_cast<int16_t>(op.type == PixelOpProgram::OP_SHIFT_RIGHT ? -op.shift : op.shift));
+        for(; j + 8 <= count; j += 8) {
+            vst1q_u16(dst + j, vshlq_u16(vld1q_u16(src + j), shift));
+        }
+    } break;
+    }
+#endif
+    applyOpScalar(op, src, dst, j, count);
+}
+
+// dst[j] = src[count - 1 - j], src is not dst
+void reverseRow(const uint16_t *src, uint16_t *dst, uint32_t count) {
+    uint32_t j = 0;
+#if defined(OB_PIXEL_OP_SSE2)
+    for(; j + 8 <= count; j += 8) {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + count - j - 8));
+        value         = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+        value         = _mm_shufflelo_epi16(value, _MM_SHUFFLE(0, 1, 2, 3));
+        value         = _mm_shufflehi_epi16(value, _MM_SHUFFLE(0, 1, 2, 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j), value);
+    }
+#elif defined(OB_PIXEL_OP_NEON)
+    for(; j + 8 <= count; j += 8) {
+        uint16x8_t value = vrev64q_u16(vld1q_u16(src + count - j - 8));
+        vst1q_u16(dst + j, vcombine_u16(vget_high_u16(value), vget_low_u16(value)));
+    }
+#endif
+    for(; j < count; j++) {
+        dst[j] = src[count - 1 - j];
+    }
+}
+
+}  // namespace
+
+// The operations run one after the other on a row, which stays in the L1 cache: one pass over the frame memory for all of them
+void PixelOpProgram::runRow(const uint16_t *src, uint16_t *dst, uint16_t *rowBuffer) const {
+    uint16_t *out = mirror_ ? rowBuffer : dst;
+    if(ops_.empty()) {
+        if(mirror_) {
+            if(src == dst) {
+                memcpy(rowBuffer, src, width_ * sizeof(uint16_t));
+                src = rowBuffer;
+            }
+            reverseRow(src, dst, width_);
+        }
+        else if(src != dst) {
+            memcpy(dst, src, width_ * sizeof(uint16_t));
+        }
+        return;
+    }
+
+    applyOp(ops_[0], src, out, width_);
+    for(size_t i = 1; i < ops_.size(); i++) {
+        applyOp(ops_[i], out, out, width_);
+    }
+    if(mirror_) {
+        reverseRow(out, dst, width_);
+    }
+}
+
+void PixelOpProgram::run(std::shared_ptr<const Frame> src, std::shared_ptr<Frame> dst) const {
+    // dst first: getDataMutable() may detach dst from a shared buffer, src is then read from its own copy
+    auto dstData = reinterpret_cast<uint16_t *>(dst->getDataMutable());
+    auto srcData = reinterpret_cast<const uint16_t *>(src->getData());
+
+    std::vector<uint16_t> rowBuffer(width_);
+    if(srcData != dstData || !flip_) {
+        // In place without flip, each row is read before being written: the mirrored row is built in the row buffer
+        for(uint32_t h = 0; h < height_; h++) {
+            runRow(srcData + h * width_, dstData + (flip_ ? height_ - 1 - h : h) * width_, rowBuffer.data());
+        }
+    }
+    else {
+        // In place with flip: the top and bottom rows of a pair are processed before being written back
+        std::vector<uint16_t> top(width_);
+        for(uint32_t h = 0; h < height_ / 2; h++) {
+            uint32_t other = height_ - 1 - h;
+            runRow(srcData + h * width_, top.data(), rowBuffer.data());
+            runRow(srcData + other * width_, dstData + h * width_, rowBuffer.data());
+            memcpy(dstData + other * width_, top.data(), width_ * sizeof(uint16_t));
+        }
+        if(height_ % 2) {
+            uint32_t middle = height_ / 2;
+            runRow(srcData + middle * width_, dstData + middle * width_, rowBuffer.data());
+        }
+    }
+
+    auto depthFrame = dst->tryAs<DepthFrame>();
+    depthFrame->setValueScale(valueScale_);
+    depthFrame->setPixelAvailableBitSize(pixelBitSize_);
+    dst->setStreamProfile(streamProfile_);
+}
+
+}  // namespace libobsensor
@@ -0,0 +1,73 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "frame/Frame.hpp"
+#include <memory>
+#include <vector>
+
+namespace libobsensor {
+
+/**
+ * @brief Per-pixel operations of several filters compiled into one pass over a Y16 depth frame (see IFilterBase::appendPixelOp and
+ * FilterChain): the operations run in order on each pixel while it is in registers, mirror and flip only change where the row is written.
+ * @brief The output is the same as the one of the filters run one after the other: the program also follows the value scale, the pixel
+ * available bit size and the stream profile of the frame through the operations.
+ */
+class PixelOpProgram {
+public:
+    /**
+     * @brief Empty program for the frame, which must be a Y16 depth frame (see isSupported)
+     */
+    explicit PixelOpProgram(std::shared_ptr<const Frame> frame);
+
+    static bool isSupported(std::shared_ptr<const Frame> frame);
+
+    // Pixels out of [min, max] (raw values) are set to 0, all pixels if min >= max
+    void addThreshold(uint32_t min, uint32_t max);
+    // Pixels are multiplied by scale and truncated, the value scale of the frame is multiplied by scale
+    void addScale(float scale);
+    // Pixels are shifted right by offset bits (left if offset < 0), the pixel available bit size of the frame is reduced by offset
+    void addOffset(int8_t offset);
+    // Rows are reversed (mirror) or written bottom up (flip), streamProfile is the stream profile of the transformed frame
+    void addMirror(std::shared_ptr<const StreamProfile> streamProfile);
+    void addFlip(std::shared_ptr<const StreamProfile> streamProfile);
+
+    // State of the frame after the operations added so far
+    float                                getValueScale() const;
+    std::shared_ptr<const StreamProfile> getStreamProfile() const;
+
+    /**
+     * @brief Run the program on the data of src and write the result and the frame state to dst
+     *
+     * @param[in] src Y16 depth frame of the program
+     * @param[out] dst frame of the same size and format, src itself to run in place
+     */
+    void run(std::shared_ptr<const Frame> src, std::shared_ptr<Frame> dst) const;
+
+    enum OpType { OP_ZERO, OP_THRESHOLD, OP_SCALE, OP_SHIFT_RIGHT, OP_SHIFT_LEFT };
+
+    struct Op {
+        OpType   type;
+        uint16_t min;  // OP_THRESHOLD
+        uint16_t max;
+        float    scale;  // OP_SCALE
+        int      shift;  // OP_SHIFT_RIGHT, OP_SHIFT_LEFT
+    };
+
+private:
+    // rowBuffer: width pixels, used for the mirrored rows
+    void runRow(const uint16_t *src, uint16_t *dst, uint16_t *rowBuffer) const;
+
+    uint32_t        width_;
+    uint32_t        height_;
+    std::vector<Op> ops_;
+    bool            mirror_;
+    bool            flip_;
+
+    float                                valueScale_;
+    uint8_t                              pixelBitSize_;
+    std::shared_ptr<const StreamProfile> streamProfile_;
+};
+
+}  // namespace libobsensor
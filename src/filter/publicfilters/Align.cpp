@@ -15,6 +15,13 @@
 namespace libobsensor {
 
 #define IS_FEMTO_MEGA_SERIES(pid) (pid == 0x0669 || pid == 0x066B || pid == 0x06C0)
+#if defined(__ARM_NEON__) || defined(__NEON__) || defined(__SSSE3__)
+#define ALIGN_MAX_THREAD_COUNT 16
+#else  // the generic implementation runs on the calling thread only
+#define ALIGN_MAX_THREAD_COUNT 1
+#endif
+#define ALIGN_STR_(x) #x
+#define ALIGN_STR(x) ALIGN_STR_(x)
 
 const std::map<OBStreamType, OBFrameType> streamTypeToFrameType = { { OB_STREAM_COLOR, OB_FRAME_COLOR },
                                                                     { OB_STREAM_COLOR_LEFT, OB_FRAME_COLOR_LEFT },
@@ -46,9 +53,9 @@ Align::~Align() noexcept {
 }
 
 void Align::updateConfig(std::vector<std::string> &params) {
-    // AlignType, TargetDistortion, GapFillCopy, matchTargetRes
+    // AlignType, TargetDistortion, GapFillCopy, matchTargetRes, ThreadCount (optional, for the callers using the former schema)
     std::lock_guard<std::recursive_mutex> lock(alignMutex_);
-    if(params.size() != 4) {
+    if(params.size() != 4 && params.size() != 5) {
         THROW_INVALID_PARAM_EXCEPTION("Align config error: params size not match");
     }
     try {
@@ -59,6 +66,15 @@ void Align::updateConfig(std::vector<std::string> &params) {
         addTargetDistortion_ = bool(std::stoi(params[1]));
         gapFillCopy_         = bool(std::stoi(params[2]));
         matchTargetRes_      = bool(std::stoi(params[3]));
+        if(params.size() > 4) {
+            int threadCount = std::stoi(params[4]);
+            if(threadCount < 1 || threadCount > ALIGN_MAX_THREAD_COUNT) {
+                THROW_INVALID_PARAM_EXCEPTION("ThreadCount out of range");
+            }
+#if defined(__ARM_NEON__) || defined(__NEON__) || defined(__SSSE3__)
+            std::static_pointer_cast<AlignImpl>(impl_)->setThreadCount(static_cast<uint32_t>(threadCount));
+#endif
+        }
     }
     catch(const std::exception &e) {
         THROW_INVALID_PARAM_EXCEPTION("Align config error: " + std::string(e.what()));
@@ -75,7 +91,8 @@ const std::string &Align::getConfigSchema() const {
     static const std::string schema = "AlignType, integer, 1, 7, 1, 2, align to the type of data stream\n"
                                       "TargetDistortion, boolean, 0, 1, 1, 0, add distortion of the target stream\n"
                                       "GapFillCopy, boolean, 0, 1, 1, 0, enable gap fill\n"
-                                      "MatchTargetRes, boolean, 0, 1, 1, 1, enable match the output resolution to the align target resolution\n";
+                                      "MatchTargetRes, boolean, 0, 1, 1, 1, enable match the output resolution to the align target resolution\n"
+                                      "ThreadCount, integer, 1, " ALIGN_STR(ALIGN_MAX_THREAD_COUNT) ", 1, 1, number of threads to run the alignment on\n";
     return schema;
 }
 
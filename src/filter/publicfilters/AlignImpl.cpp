@@ -4,7 +4,9 @@
 #if defined(__ARM_NEON__) || defined(__NEON__) || defined(__SSSE3__)
 
 #include "AlignImpl.hpp"
+#include "AlignImplAVX2.hpp"
 #include "logger/Logger.hpp"
+#include "utils/CpuFeatures.hpp"
 #include "exception/ObException.hpp"
 #include <fstream>
 #include <algorithm>
@@ -14,6 +16,12 @@
 
 namespace libobsensor {
 
+// Row granularity of the tiles of the multi-threaded alignment, a multiple of the 8-pixel SSE chunk
+#define ALIGN_TILE_ROW_STEP 16
+
+// Chunks of 8 pixels projected per call of the AVX2 kernel before they are filled into the output
+#define ALIGN_AVX2_BATCH_CHUNKS 32
+
 static inline void addDistortion(const OBCameraDistortion &distort_param, const float pt_ud[2], float pt_d[2]) {
     float k1 = distort_param.k1, k2 = distort_param.k2, k3 = distort_param.k3;
     float k4 = distort_param.k4, k5 = distort_param.k5, k6 = distort_param.k6;
@@ -81,7 +89,7 @@ const __m128  AlignImpl::AlignImplSSEData::TWO        = _mm_set_ps1(2);
 const __m128i AlignImpl::AlignImplSSEData::ZERO       = _mm_setzero_si128();
 const __m128  AlignImpl::AlignImplSSEData::ZERO_F     = _mm_set_ps1(0.0);
 
-AlignImpl::AlignImpl() : initialized_(false) {
+AlignImpl::AlignImpl() : initialized_(false), thread_count_(1) {
 #if(defined(WIN32) || defined(_WIN32) || defined(WINCE))
     sseData_ = static_cast<AlignImplSSEData *>( _aligned_malloc(sizeof(AlignImplSSEData), 16));
 #else
@@ -162,9 +170,31 @@ void AlignImpl::initialize(OBCameraIntrinsic depth_intrin, OBCameraDistortion de
 
 void AlignImpl::reset() {
     clearMatrixCache();
+    tile_depth_bufs_.clear();
     initialized_ = false;
 }
 
+void AlignImpl::setThreadCount(uint32_t thread_count) {
+    thread_count = std::max(thread_count, 1u);
+    if(thread_count == thread_count_) {
+        return;
+    }
+    thread_count_ = thread_count;
+    worker_pool_.reset();
+    if(thread_count_ > 1) {
+        worker_pool_.reset(new utils::WorkerPool(thread_count_));
+    }
+    tile_depth_bufs_.clear();
+}
+
+uint32_t AlignImpl::getTileCount(int rows) const {
+    // Tiles are made of whole groups of ALIGN_TILE_ROW_STEP rows, so the 8-pixel SSE chunks never cross a tile border
+    if(!worker_pool_) {
+        return 1;
+    }
+    return std::max(1u, std::min(thread_count_, static_cast<uint32_t>(rows / ALIGN_TILE_ROW_STEP)));
+}
+
 float polynomial(float x, float a, float b, float c, float d) {
     return (a * x * x * x + b * x * x + c * x + d);
 }
@@ -479,27 +509,25 @@ void AlignImpl::BMDistortedWithoutSSE(const float pt_ud[2], float pt_d[2]) {
 }
 
 void AlignImpl::K3DistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                                         const float *coeff_mat_z[2], int *map) {
-    int          channel = (gap_fill_copy_ ? 1 : 2);
+                                         const float *coeff_mat_z[2], int *map, int row_begin, int row_end) {
+    int          channel     = (gap_fill_copy_ ? 1 : 2);
+    int          depth_width = depth_intric_.width;
+    int          rgb_width   = rgb_intric_.width;
+    int          rgb_height  = rgb_intric_.height;
     const float *ptr_coeff_x[2];
     const float *ptr_coeff_y[2];
     const float *ptr_coeff_z[2];
     for(int i = 0; i < channel; i++) {
-        ptr_coeff_x[i] = coeff_mat_x[i];
-        ptr_coeff_y[i] = coeff_mat_y[i];
-        ptr_coeff_z[i] = coeff_mat_z[i];
+        ptr_coeff_x[i] = coeff_mat_x[i] + row_begin * depth_width;
+        ptr_coeff_y[i] = coeff_mat_y[i] + row_begin * depth_width;
+        ptr_coeff_z[i] = coeff_mat_z[i] + row_begin * depth_width;
     }
-    const uint16_t *ptr_depth = depth_buffer;
-
-    int depth_width  = depth_intric_.width;
-    int depth_height = depth_intric_.height;
-    int rgb_width    = rgb_intric_.width;
-    int rgb_height   = rgb_intric_.height;
+    const uint16_t *ptr_depth = depth_buffer + row_begin * depth_width;
 
     float pixelx_f[2], pixely_f[2], dst[2];
 
     if(gap_fill_copy_) {
-        for(int v = 0; v < depth_height; v++) {
+        for(int v = row_begin; v < row_end; v++) {
             int depth_idx = v * depth_width;
             for(int u = 0; u < depth_width; u++) {
                 uint16_t depth = *ptr_depth++;
@@ -516,7 +544,7 @@ void AlignImpl::K3DistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint16_t
         }
     }
     else {
-        for(int v = 0; v < depth_height; v++) {
+        for(int v = row_begin; v < row_end; v++) {
             int depth_idx = v * depth_width;
             for(int u = 0; u < depth_width; u++) {
                 uint16_t depth = *ptr_depth++;
@@ -535,27 +563,25 @@ void AlignImpl::K3DistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint16_t
 }
 
 void AlignImpl::K6DistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                                         const float *coeff_mat_z[2], int *map) {
-    int          channel = (gap_fill_copy_ ? 1 : 2);
+                                         const float *coeff_mat_z[2], int *map, int row_begin, int row_end) {
+    int          channel     = (gap_fill_copy_ ? 1 : 2);
+    int          depth_width = depth_intric_.width;
+    int          rgb_width   = rgb_intric_.width;
+    int          rgb_height  = rgb_intric_.height;
     const float *ptr_coeff_x[2];
     const float *ptr_coeff_y[2];
     const float *ptr_coeff_z[2];
     for(int i = 0; i < channel; i++) {
-        ptr_coeff_x[i] = coeff_mat_x[i];
-        ptr_coeff_y[i] = coeff_mat_y[i];
-        ptr_coeff_z[i] = coeff_mat_z[i];
+        ptr_coeff_x[i] = coeff_mat_x[i] + row_begin * depth_width;
+        ptr_coeff_y[i] = coeff_mat_y[i] + row_begin * depth_width;
+        ptr_coeff_z[i] = coeff_mat_z[i] + row_begin * depth_width;
     }
-    const uint16_t *ptr_depth = depth_buffer;
-
-    int depth_width  = depth_intric_.width;
-    int depth_height = depth_intric_.height;
-    int rgb_width    = rgb_intric_.width;
-    int rgb_height   = rgb_intric_.height;
+    const uint16_t *ptr_depth = depth_buffer + row_begin * depth_width;
 
     float pixelx_f[2], pixely_f[2], dst[2];
 
     if(gap_fill_copy_) {
-        for(int v = 0; v < depth_height; v++) {
+        for(int v = row_begin; v < row_end; v++) {
             int depth_idx = v * depth_width;
             for(int u = 0; u < depth_width; u++) {
                 uint16_t depth = *ptr_depth++;
@@ -572,7 +598,7 @@ void AlignImpl::K6DistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint16_t
         }
     }
     else {
-        for(int v = 0; v < depth_height; v++) {
+        for(int v = row_begin; v < row_end; v++) {
             int depth_idx = v * depth_width;
             for(int u = 0; u < depth_width; u++) {
                 uint16_t depth = *ptr_depth++;
@@ -591,27 +617,25 @@ void AlignImpl::K6DistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint16_t
 }
 
 void AlignImpl::KBDistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                                         const float *coeff_mat_z[2], int *map) {
-    int          channel = (gap_fill_copy_ ? 1 : 2);
+                                         const float *coeff_mat_z[2], int *map, int row_begin, int row_end) {
+    int          channel     = (gap_fill_copy_ ? 1 : 2);
+    int          depth_width = depth_intric_.width;
+    int          rgb_width   = rgb_intric_.width;
+    int          rgb_height  = rgb_intric_.height;
     const float *ptr_coeff_x[2];
     const float *ptr_coeff_y[2];
     const float *ptr_coeff_z[2];
     for(int i = 0; i < channel; i++) {
-        ptr_coeff_x[i] = coeff_mat_x[i];
-        ptr_coeff_y[i] = coeff_mat_y[i];
-        ptr_coeff_z[i] = coeff_mat_z[i];
+        ptr_coeff_x[i] = coeff_mat_x[i] + row_begin * depth_width;
+        ptr_coeff_y[i] = coeff_mat_y[i] + row_begin * depth_width;
+        ptr_coeff_z[i] = coeff_mat_z[i] + row_begin * depth_width;
     }
-    const uint16_t *ptr_depth = depth_buffer;
-
-    int depth_width  = depth_intric_.width;
-    int depth_height = depth_intric_.height;
-    int rgb_width    = rgb_intric_.width;
-    int rgb_height   = rgb_intric_.height;
+    const uint16_t *ptr_depth = depth_buffer + row_begin * depth_width;
 
     float pixelx_f[2], pixely_f[2], dst[2];
 
     if(gap_fill_copy_) {
-        for(int v = 0; v < depth_height; v++) {
+        for(int v = row_begin; v < row_end; v++) {
             int depth_idx = v * depth_width;
             for(int u = 0; u < depth_width; u++) {
                 uint16_t depth = *ptr_depth++;
@@ -628,7 +652,7 @@ void AlignImpl::KBDistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint16_t
         }
     }
     else {
-        for(int v = 0; v < depth_height; v++) {
+        for(int v = row_begin; v < row_end; v++) {
             int depth_idx = v * depth_width;
             for(int u = 0; u < depth_width; u++) {
                 uint16_t depth = *ptr_depth++;
@@ -647,27 +671,25 @@ void AlignImpl::KBDistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint16_t
 }
 
 void AlignImpl::LinearDistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                                             const float *coeff_mat_z[2], int *map) {
-    int          channel = (gap_fill_copy_ ? 1 : 2);
+                                             const float *coeff_mat_z[2], int *map, int row_begin, int row_end) {
+    int          channel     = (gap_fill_copy_ ? 1 : 2);
+    int          depth_width = depth_intric_.width;
+    int          rgb_width   = rgb_intric_.width;
+    int          rgb_height  = rgb_intric_.height;
     const float *ptr_coeff_x[2];
     const float *ptr_coeff_y[2];
     const float *ptr_coeff_z[2];
     for(int i = 0; i < channel; i++) {
-        ptr_coeff_x[i] = coeff_mat_x[i];
-        ptr_coeff_y[i] = coeff_mat_y[i];
-        ptr_coeff_z[i] = coeff_mat_z[i];
+        ptr_coeff_x[i] = coeff_mat_x[i] + row_begin * depth_width;
+        ptr_coeff_y[i] = coeff_mat_y[i] + row_begin * depth_width;
+        ptr_coeff_z[i] = coeff_mat_z[i] + row_begin * depth_width;
     }
-    const uint16_t *ptr_depth = depth_buffer;
-
-    int depth_width  = depth_intric_.width;
-    int depth_height = depth_intric_.height;
-    int rgb_width    = rgb_intric_.width;
-    int rgb_height   = rgb_intric_.height;
+    const uint16_t *ptr_depth = depth_buffer + row_begin * depth_width;
 
     float pixelx_f[2], pixely_f[2], dst[2];
 
     if(gap_fill_copy_) {
-        for(int v = 0; v < depth_height; v++) {
+        for(int v = row_begin; v < row_end; v++) {
             int depth_idx = v * depth_width;
             for(int u = 0; u < depth_width; u++) {
                 uint16_t depth = *ptr_depth++;
@@ -684,7 +706,7 @@ void AlignImpl::LinearDistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint1
         }
     }
     else {
-        for(int v = 0; v < depth_height; v++) {
+        for(int v = row_begin; v < row_end; v++) {
             int depth_idx = v * depth_width;
             for(int u = 0; u < depth_width; u++) {
                 uint16_t depth = *ptr_depth++;
@@ -928,11 +950,12 @@ void AlignImpl::FillMultiChannelWithoutSSE(const float *pixelx_f, const float *p
 }
 
 void AlignImpl::K3DistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                                      const float *coeff_mat_z[2], int *map) {
-    int channel      = (gap_fill_copy_ ? 1 : 2);
-    int total_pixels = depth_intric_.width * depth_intric_.height;
-    int width        = rgb_intric_.width;
-    int height       = rgb_intric_.height;
+                                      const float *coeff_mat_z[2], int *map, int row_begin, int row_end) {
+    int channel = (gap_fill_copy_ ? 1 : 2);
+    int width   = rgb_intric_.width;
+    int height  = rgb_intric_.height;
+    int begin   = row_begin * depth_intric_.width;  // tile borders fall on 8-pixel chunks, see ALIGN_TILE_ROW_STEP
+    int end     = row_end * depth_intric_.width;
 
     float x_lo[8] = { 0 };
     float y_lo[8] = { 0 };
@@ -944,7 +967,7 @@ void AlignImpl::K3DistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *ou
     // center
     if(gap_fill_copy_) {
         // processing full chunks of 8 pixels
-        for(int i = 0; i < total_pixels; i += 8) {
+        for(int i = begin; i < end; i += 8) {
             K3ProcessWithSSE(depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, x_lo, y_lo, z_lo, x_hi, y_hi, z_hi, i, channel);
 
             FillSingleChannelWithSSE(x_lo, y_lo, z_lo, out_depth, map, i, width, height);
@@ -952,7 +975,7 @@ void AlignImpl::K3DistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *ou
         }
     }
     else {  // top - left - and-bottom - right
-        for(int i = 0; i < total_pixels; i += 8) {
+        for(int i = begin; i < end; i += 8) {
             K3ProcessWithSSE(depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, x_lo, y_lo, z_lo, x_hi, y_hi, z_hi, i, channel);
 
             FillMultiChannelWithSSE(x_lo, y_lo, z_lo, out_depth, map, i, width, height);
@@ -962,11 +985,12 @@ void AlignImpl::K3DistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *ou
 }
 
 void AlignImpl::K6DistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                                      const float *coeff_mat_z[2], int *map) {
-    int channel      = (gap_fill_copy_ ? 1 : 2);
-    int total_pixels = depth_intric_.width * depth_intric_.height;
-    int width        = rgb_intric_.width;
-    int height       = rgb_intric_.height;
+                                      const float *coeff_mat_z[2], int *map, int row_begin, int row_end) {
+    int channel = (gap_fill_copy_ ? 1 : 2);
+    int width   = rgb_intric_.width;
+    int height  = rgb_intric_.height;
+    int begin   = row_begin * depth_intric_.width;  // tile borders fall on 8-pixel chunks, see ALIGN_TILE_ROW_STEP
+    int end     = row_end * depth_intric_.width;
 
     float x_lo[8] = { 0 };
     float y_lo[8] = { 0 };
@@ -978,7 +1002,7 @@ void AlignImpl::K6DistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *ou
     if(depth_format_ != OB_FORMAT_Y12C4) {
         if(gap_fill_copy_) {
             // processing full chunks of 8 pixels
-            for(int i = 0; i < total_pixels; i += 8) {
+            for(int i = begin; i < end; i += 8) {
                 K6ProcessWithSSE(depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, x_lo, y_lo, z_lo, x_hi, y_hi, z_hi, i, channel);
 
                 FillSingleChannelWithSSE(x_lo, y_lo, z_lo, out_depth, map, i, width, height);
@@ -986,7 +1010,7 @@ void AlignImpl::K6DistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *ou
             }
         }
         else {  // top - left - and-bottom - right
-            for(int i = 0; i < total_pixels; i += 8) {
+            for(int i = begin; i < end; i += 8) {
                 K6ProcessWithSSE(depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, x_lo, y_lo, z_lo, x_hi, y_hi, z_hi, i, channel);
 
                 FillMultiChannelWithSSE(x_lo, y_lo, z_lo, out_depth, map, i, width, height);
@@ -997,7 +1021,7 @@ void AlignImpl::K6DistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *ou
     else {
         if(gap_fill_copy_) {
             // processing full chunks of 8 pixels
-            for(int i = 0; i < total_pixels; i += 8) {
+            for(int i = begin; i < end; i += 8) {
                 K6ProcessWithSSEOnY12C4(depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, x_lo, y_lo, z_lo, x_hi, y_hi, z_hi, i, channel);
 
                 FillSingleChannelWithSSE(x_lo, y_lo, z_lo, out_depth, map, i, width, height);
@@ -1005,7 +1029,7 @@ void AlignImpl::K6DistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *ou
             }
         }
         else {  // top - left - and-bottom - right
-            for(int i = 0; i < total_pixels; i += 8) {
+            for(int i = begin; i < end; i += 8) {
                 K6ProcessWithSSEOnY12C4(depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, x_lo, y_lo, z_lo, x_hi, y_hi, z_hi, i, channel);
 
                 FillMultiChannelWithSSE(x_lo, y_lo, z_lo, out_depth, map, i, width, height);
@@ -1018,11 +1042,12 @@ void AlignImpl::K6DistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *ou
 }
 
 void AlignImpl::KBDistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                                      const float *coeff_mat_z[2], int *map) {
-    int channel      = (gap_fill_copy_ ? 1 : 2);
-    int total_pixels = depth_intric_.width * depth_intric_.height;
-    int width        = rgb_intric_.width;
-    int height       = rgb_intric_.height;
+                                      const float *coeff_mat_z[2], int *map, int row_begin, int row_end) {
+    int channel = (gap_fill_copy_ ? 1 : 2);
+    int width   = rgb_intric_.width;
+    int height  = rgb_intric_.height;
+    int begin   = row_begin * depth_intric_.width;  // tile borders fall on 8-pixel chunks, see ALIGN_TILE_ROW_STEP
+    int end     = row_end * depth_intric_.width;
 
     float x_lo[8] = { 0 };
     float y_lo[8] = { 0 };
@@ -1034,7 +1059,7 @@ void AlignImpl::KBDistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *ou
     // center
     if(gap_fill_copy_) {
         // processing full chunks of 8 pixels
-        for(int i = 0; i < total_pixels; i += 8) {
+        for(int i = begin; i < end; i += 8) {
             KBProcessWithSSE(depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, x_lo, y_lo, z_lo, x_hi, y_hi, z_hi, i, channel);
 
             FillSingleChannelWithSSE(x_lo, y_lo, z_lo, out_depth, map, i, width, height);
@@ -1042,7 +1067,7 @@ void AlignImpl::KBDistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *ou
         }
     }
     else {  // top - left - and-bottom - right
-        for(int i = 0; i < total_pixels; i += 8) {
+        for(int i = begin; i < end; i += 8) {
             KBProcessWithSSE(depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, x_lo, y_lo, z_lo, x_hi, y_hi, z_hi, i, channel);
 
             FillMultiChannelWithSSE(x_lo, y_lo, z_lo, out_depth, map, i, width, height);
@@ -1052,11 +1077,12 @@ void AlignImpl::KBDistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *ou
 }
 
 void AlignImpl::LinearD2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                                 const float *coeff_mat_z[2], int *map) {
-    int channel      = (gap_fill_copy_ ? 1 : 2);
-    int total_pixels = depth_intric_.width * depth_intric_.height;
-    int width        = rgb_intric_.width;
-    int height       = rgb_intric_.height;
+                                 const float *coeff_mat_z[2], int *map, int row_begin, int row_end) {
+    int channel = (gap_fill_copy_ ? 1 : 2);
+    int width   = rgb_intric_.width;
+    int height  = rgb_intric_.height;
+    int begin   = row_begin * depth_intric_.width;  // tile borders fall on 8-pixel chunks, see ALIGN_TILE_ROW_STEP
+    int end     = row_end * depth_intric_.width;
 
     float x_lo[8] = { 0 };
     float y_lo[8] = { 0 };
@@ -1069,7 +1095,7 @@ void AlignImpl::LinearD2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_dep
     if(depth_format_ != OB_FORMAT_Y12C4) {
         if(gap_fill_copy_) {
             // processing full chunks of 8 pixels
-            for(int i = 0; i < total_pixels; i += 8) {
+            for(int i = begin; i < end; i += 8) {
                 LinearProcessWithSSE(depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, x_lo, y_lo, z_lo, x_hi, y_hi, z_hi, i, channel);
 
                 FillSingleChannelWithSSE(x_lo, y_lo, z_lo, out_depth, map, i, width, height);
@@ -1077,7 +1103,7 @@ void AlignImpl::LinearD2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_dep
             }
         }
         else {  // top - left - and-bottom - right
-            for(int i = 0; i < total_pixels; i += 8) {
+            for(int i = begin; i < end; i += 8) {
                 LinearProcessWithSSE(depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, x_lo, y_lo, z_lo, x_hi, y_hi, z_hi, i, channel);
 
                 FillMultiChannelWithSSE(x_lo, y_lo, z_lo, out_depth, map, i, width, height);
@@ -1088,7 +1114,7 @@ void AlignImpl::LinearD2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_dep
     else {
         if(gap_fill_copy_) {
             // processing full chunks of 8 pixels
-            for(int i = 0; i < total_pixels; i += 8) {
+            for(int i = begin; i < end; i += 8) {
                 LinearProcessWithSSEOnY12C4(depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, x_lo, y_lo, z_lo, x_hi, y_hi, z_hi, i, channel);
 
                 FillSingleChannelWithSSE(x_lo, y_lo, z_lo, out_depth, map, i, width, height);
@@ -1096,7 +1122,7 @@ void AlignImpl::LinearD2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_dep
             }
         }
         else {  // top - left - and-bottom - right
-            for(int i = 0; i < total_pixels; i += 8) {
+            for(int i = begin; i < end; i += 8) {
                 LinearProcessWithSSEOnY12C4(depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, x_lo, y_lo, z_lo, x_hi, y_hi, z_hi, i, channel);
 
                 FillMultiChannelWithSSE(x_lo, y_lo, z_lo, out_depth, map, i, width, height);
@@ -1187,7 +1213,7 @@ inline void AlignImpl::K6ProcessWithSSE(const uint16_t *depth_buffer, const floa
         depth_o_lo = _mm_and_ps(depth_o_lo, flag_lo);
         BMDistortedWithSSE(nx_lo, ny_lo, x2_lo, y2_lo, r2_lo);
         depth_o_hi = _mm_and_ps(depth_o_hi, flag_hi);
-        BMDistortedWithSSE(nx_hi, ny_hi, x2_hi, y2_hi, r2_lo);
+        BMDistortedWithSSE(nx_hi, ny_hi, x2_hi, y2_hi, r2_hi);
 
         __m128 pixelx_lo = _mm_add_ps(_mm_mul_ps(nx_lo, sseData_->color_fx_), sseData_->color_cx_);
         __m128 pixely_lo = _mm_add_ps(_mm_mul_ps(ny_lo, sseData_->color_fy_), sseData_->color_cy_);
@@ -1242,7 +1268,7 @@ inline void AlignImpl::K6ProcessWithSSEOnY12C4(const uint16_t *depth_buffer, con
         depth_o_lo = _mm_and_ps(depth_o_lo, flag_lo);
         BMDistortedWithSSE(nx_lo, ny_lo, x2_lo, y2_lo, r2_lo);
         depth_o_hi = _mm_and_ps(depth_o_hi, flag_hi);
-        BMDistortedWithSSE(nx_hi, ny_hi, x2_hi, y2_hi, r2_lo);
+        BMDistortedWithSSE(nx_hi, ny_hi, x2_hi, y2_hi, r2_hi);
 
         __m128 pixelx_lo = _mm_add_ps(_mm_mul_ps(nx_lo, sseData_->color_fx_), sseData_->color_cx_);
         __m128 pixely_lo = _mm_add_ps(_mm_mul_ps(ny_lo, sseData_->color_fy_), sseData_->color_cy_);
@@ -1497,6 +1523,128 @@ inline void AlignImpl::FillMultiChannelWithSSE(const float *x, const float *y, c
     }
 }
 
+bool AlignImpl::D2CWithAVX2(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
+                            const float *coeff_mat_z[2], int *map, int row_begin, int row_end) {
+    AlignAVX2Model model = ALIGN_AVX2_LINEAR;
+    if(add_target_distortion_) {
+        switch(rgb_disto_.model) {
+        case OB_DISTORTION_BROWN_CONRADY:
+            model = ALIGN_AVX2_K3;
+            break;
+        case OB_DISTORTION_BROWN_CONRADY_K6:
+            model = ALIGN_AVX2_K6;
+            break;
+        case OB_DISTORTION_KANNALA_BRANDT4:
+            model = ALIGN_AVX2_KB;
+            break;
+        default:
+            return false;
+        }
+    }
+    // As the SSE kernels, only the linear and K6 models keep the low bits of Y12C4 depth
+    bool y12c4 = depth_format_ == OB_FORMAT_Y12C4 && (model == ALIGN_AVX2_LINEAR || model == ALIGN_AVX2_K6);
+
+    // The values of the SSE registers, color_fx_ etc. are changed by D2C when the output is scaled
+    AlignAVX2Params params;
+    params.fx              = _mm_cvtss_f32(sseData_->color_fx_);
+    params.fy              = _mm_cvtss_f32(sseData_->color_fy_);
+    params.cx              = _mm_cvtss_f32(sseData_->color_cx_);
+    params.cy              = _mm_cvtss_f32(sseData_->color_cy_);
+    params.k1              = _mm_cvtss_f32(sseData_->color_k1_);
+    params.k2              = _mm_cvtss_f32(sseData_->color_k2_);
+    params.k3              = _mm_cvtss_f32(sseData_->color_k3_);
+    params.k4              = _mm_cvtss_f32(sseData_->color_k4_);
+    params.k5              = _mm_cvtss_f32(sseData_->color_k5_);
+    params.k6              = _mm_cvtss_f32(sseData_->color_k6_);
+    params.p1              = _mm_cvtss_f32(sseData_->color_p1_);
+    params.p2              = _mm_cvtss_f32(sseData_->color_p2_);
+    params.scaled_trans[0] = _mm_cvtss_f32(sseData_->scaled_trans_1_);
+    params.scaled_trans[1] = _mm_cvtss_f32(sseData_->scaled_trans_2_);
+    params.scaled_trans[2] = _mm_cvtss_f32(sseData_->scaled_trans_3_);
+    params.r2_max_loc      = (model == ALIGN_AVX2_K6) ? _mm_cvtss_f32(sseData_->r2_max_loc_sse_) : 0.0f;
+
+    int channel = (gap_fill_copy_ ? 1 : 2);
+    int width   = rgb_intric_.width;
+    int height  = rgb_intric_.height;
+    int begin   = row_begin * depth_intric_.width;
+    int end     = row_end * depth_intric_.width;
+
+    float chunks[ALIGN_AVX2_BATCH_CHUNKS * ALIGN_AVX2_CHUNK_FLOATS];
+    for(int i = begin; i < end; i += 8 * ALIGN_AVX2_BATCH_CHUNKS) {
+        // same chunks as the SSE loops, including a last partial one
+        int chunk_count = std::min(ALIGN_AVX2_BATCH_CHUNKS, (end - i + 7) / 8);
+        if(!projectDepthChunksAVX2(params, model, y12c4, depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, channel, i, chunk_count, chunks)) {
+            return false;  // only on the first batch: the kernels are either built in or not
+        }
+
+        for(int n = 0; n < chunk_count; n++) {
+            const float *chunk = chunks + n * ALIGN_AVX2_CHUNK_FLOATS;
+            int          idx   = i + 8 * n;
+            if(gap_fill_copy_) {
+                FillSingleChannelWithSSE(chunk, chunk + 8, chunk + 16, out_depth, map, idx, width, height);
+                FillSingleChannelWithSSE(chunk + 24, chunk + 32, chunk + 40, out_depth, map, idx + 4, width, height);
+            }
+            else {
+                FillMultiChannelWithSSE(chunk, chunk + 8, chunk + 16, out_depth, map, idx, width, height);
+                FillMultiChannelWithSSE(chunk + 24, chunk + 32, chunk + 40, out_depth, map, idx + 4, width, height);
+            }
+        }
+    }
+    return true;
+}
+
+void AlignImpl::D2CTile(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
+                        const float *coeff_mat_z[2], int *map, int row_begin, int row_end, bool withSSE) {
+    if(withSSE && utils::getSimdLevel() >= utils::SIMD_LEVEL_AVX2
+       && D2CWithAVX2(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, row_begin, row_end)) {
+        return;
+    }
+
+    if(withSSE) {
+        if(add_target_distortion_) {
+            switch(rgb_disto_.model) {
+            case OB_DISTORTION_BROWN_CONRADY:
+                K3DistortedD2CWithSSE(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, row_begin, row_end);
+                break;
+            case OB_DISTORTION_BROWN_CONRADY_K6:
+                K6DistortedD2CWithSSE(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, row_begin, row_end);
+                break;
+            case OB_DISTORTION_KANNALA_BRANDT4:
+                KBDistortedD2CWithSSE(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, row_begin, row_end);
+                break;
+            default:
+                LOG_ERROR("Distortion model not supported yet");
+                break;
+            }
+        }
+        else {
+            LinearD2CWithSSE(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, row_begin, row_end);
+        }
+    }
+    else {
+        if(add_target_distortion_) {
+            switch(rgb_disto_.model) {
+            case OB_DISTORTION_BROWN_CONRADY:
+                K3DistortedD2CWithoutSSE(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, row_begin, row_end);
+                break;
+            case OB_DISTORTION_BROWN_CONRADY_K6:
+                K6DistortedD2CWithoutSSE(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, row_begin, row_end);
+                break;
+            case OB_DISTORTION_KANNALA_BRANDT4:
+                KBDistortedD2CWithoutSSE(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, row_begin, row_end);
+                break;
+            default:
+                LOG_ERROR("Distortion model not supported yet");
+                break;
+            }
+        }
+        else {
+            LOG_DEBUG("LinearDistortedD2CWithoutSSE");
+            LinearDistortedD2CWithoutSSE(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, row_begin, row_end);
+        }
+    }
+}
+
 void AlignImpl::D2CPostProcess(const uint16_t *ptr_src, const int in_width, const int in_height, const float scale, uint16_t *ptr_dst, int out_width,
                                int out_height) {
 
@@ -1598,55 +1746,64 @@ int AlignImpl::D2C(const uint16_t *depth_buffer, int depth_width, int depth_heig
     if(static_cast<int>(depth_work_buf_.size()) < depthPixelCount) {
         depth_work_buf_.resize(depthPixelCount);
     }
-    memcpy(depth_work_buf_.data(), depth_buffer, depthPixelCount * sizeof(uint16_t));
-    for(int i = 0; i < depthPixelCount; i++) {
-        if(depth_work_buf_[i] >= max_invalid_value_) {
-            depth_work_buf_[i] = 0;
-        }
-    }
-    const uint16_t *workBuf = depth_work_buf_.data();
-
-    if(withSSE) {
-        if(add_target_distortion_) {
-            switch(rgb_disto_.model) {
-            case OB_DISTORTION_BROWN_CONRADY:
-                K3DistortedD2CWithSSE(workBuf, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map);
-                break;
-            case OB_DISTORTION_BROWN_CONRADY_K6:
-                K6DistortedD2CWithSSE(workBuf, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map);
-                break;
-            case OB_DISTORTION_KANNALA_BRANDT4:
-                KBDistortedD2CWithSSE(workBuf, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map);
-                break;
-            default:
-                LOG_ERROR("Distortion model not supported yet");
-                break;
+    const uint16_t *workBuf     = depth_work_buf_.data();
+    auto            prepareRows = [&](int row_begin, int row_end) {
+        uint16_t *dst = depth_work_buf_.data() + row_begin * depth_width;
+        int       num = (row_end - row_begin) * depth_width;
+        memcpy(dst, depth_buffer + row_begin * depth_width, num * sizeof(uint16_t));
+        for(int i = 0; i < num; i++) {
+            if(dst[i] >= max_invalid_value_) {
+                dst[i] = 0;
             }
         }
-        else {
-            LinearD2CWithSSE(workBuf, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map);
-        }
+    };
+
+    uint32_t tile_count = getTileCount(depth_height);
+    if(tile_count == 1) {
+        prepareRows(0, depth_height);
+        D2CTile(workBuf, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, 0, depth_height, withSSE);
     }
     else {
-        if(add_target_distortion_) {
-            switch(rgb_disto_.model) {
-            case OB_DISTORTION_BROWN_CONRADY:
-                K3DistortedD2CWithoutSSE(workBuf, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map);
-                break;
-            case OB_DISTORTION_BROWN_CONRADY_K6:
-                K6DistortedD2CWithoutSSE(workBuf, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map);
-                break;
-            case OB_DISTORTION_KANNALA_BRANDT4:
-                KBDistortedD2CWithoutSSE(workBuf, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map);
-                break;
-            default:
-                LOG_ERROR("Distortion model not supported yet");
-                break;
+        // Pixels of different tiles may land on the same target pixel (z-buffer collision), and the gap filling of a pixel touches its right and
+        // bottom neighbours. The first tile renders into out_depth and the others into their own z-buffer, the nearest depth is kept on merge.
+        if(out_depth) {
+            tile_depth_bufs_.resize(tile_count - 1);
+            for(auto &buf: tile_depth_bufs_) {
+                buf.resize(pixnum);
             }
         }
-        else {
-            LOG_DEBUG("LinearDistortedD2CWithoutSSE");
-            LinearDistortedD2CWithoutSSE(workBuf, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map);
+        worker_pool_->run(tile_count, [&](uint32_t tile) {
+            int row_begin = ALIGN_TILE_ROW_STEP * static_cast<int>((depth_height / ALIGN_TILE_ROW_STEP) * tile / tile_count);
+            int row_end   = (tile + 1 == tile_count) ? depth_height
+                                                     : ALIGN_TILE_ROW_STEP * static_cast<int>((depth_height / ALIGN_TILE_ROW_STEP) * (tile + 1) / tile_count);
+            prepareRows(row_begin, row_end);
+
+            uint16_t *tile_out = out_depth;
+            if(out_depth && tile > 0) {
+                tile_out = tile_depth_bufs_[tile - 1].data();
+                memset(tile_out, 0xff, pixnum * sizeof(uint16_t));
+            }
+            D2CTile(workBuf, tile_out, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, row_begin, row_end, withSSE);
+        });
+
+        if(out_depth) {
+            worker_pool_->run(tile_count, [&](uint32_t band) {
+                int begin = static_cast<int>(static_cast<int64_t>(pixnum) * band / tile_count);
+                int end   = static_cast<int>(static_cast<int64_t>(pixnum) * (band + 1) / tile_count);
+                for(uint32_t i = 0; i + 1 < tile_count; i++) {
+                    const uint16_t *src = tile_depth_bufs_[i].data();
+                    for(int idx = begin; idx < end; idx++) {
+                        out_depth[idx] = std::min(out_depth[idx], src[idx]);
+                    }
+                }
+                if(!use_scale_) {
+                    for(int idx = begin; idx < end; idx++) {
+                        if(max_invalid_value_ <= out_depth[idx]) {
+                            out_depth[idx] = 0;
+                        }
+                    }
+                }
+            });
         }
     }
 
@@ -1673,7 +1830,7 @@ int AlignImpl::D2C(const uint16_t *depth_buffer, int depth_width, int depth_heig
         sseData_->color_cy_          = _mm_set_ps1(rgb_intric_.cy);
     }
     pixnum = rgb_intric_.width * rgb_intric_.height;
-    if(out_depth) {
+    if(out_depth && (tile_count == 1 || use_scale_)) {  // already done on merge of the tiles otherwise
         for(int idx = 0; idx < pixnum; idx++) {
             if(max_invalid_value_ <= out_depth[idx]) {
                 out_depth[idx] = 0;
@@ -1735,16 +1892,27 @@ int AlignImpl::C2D(const uint16_t *depth_buffer, int depth_width, int depth_heig
 
 template <typename T>
 void AlignImpl::mapPixel(const int *map, const T *src_buffer, int src_width, int src_height, T *dst_buffer, int dst_width, int dst_height) {
-    for(int v = 0; v < dst_height; v++) {
-        for(int u = 0; u < dst_width; u++) {
-            int id = v * dst_width + u;
-            int us = map[2 * id], vs = map[2 * id + 1];
-            if((us < 0) || (us > src_width - 1) || (vs < 0) || (vs > src_height - 1))
-                continue;
-            int is         = vs * src_width + us;
-            dst_buffer[id] = src_buffer[is];
+    auto mapRows = [&](int row_begin, int row_end) {
+        for(int v = row_begin; v < row_end; v++) {
+            for(int u = 0; u < dst_width; u++) {
+                int id = v * dst_width + u;
+                int us = map[2 * id], vs = map[2 * id + 1];
+                if((us < 0) || (us > src_width - 1) || (vs < 0) || (vs > src_height - 1))
+                    continue;
+                int is         = vs * src_width + us;
+                dst_buffer[id] = src_buffer[is];
+            }
         }
+    };
+
+    uint32_t tile_count = getTileCount(dst_height);
+    if(tile_count == 1) {
+        mapRows(0, dst_height);
+        return;
     }
+    worker_pool_->run(tile_count, [&](uint32_t tile) {
+        mapRows(static_cast<int>(dst_height * tile / tile_count), static_cast<int>(dst_height * (tile + 1) / tile_count));
+    });
 }
 
 }  // namespace libobsensor
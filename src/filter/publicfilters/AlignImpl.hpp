@@ -12,6 +12,7 @@
 #include <vector>
 #include "libobsensor/h/ObTypes.h"
 #include "IAlignImpl.hpp"
+#include "utils/WorkerPool.hpp"
 
 #if (defined(__ARM_NEON__) || defined(__aarch64__) || defined(__arm__))
 #include "SSE2NEON.h"
@@ -77,6 +78,13 @@ public:
      */
     void prepareDepthResolution() override;
 
+    /**
+     * @brief Set the number of threads to run the alignment on
+     *
+     * @param[in] thread_count number of threads, the depth frame is split into as many tiles; 1 runs the alignment on the calling thread
+     */
+    void setThreadCount(uint32_t thread_count);
+
     /**
      * @brief Clear buffer and de-initialize
      */
@@ -121,14 +129,25 @@ private:
     void clearMatrixCache();
     void setLimitROI();
 
+    uint32_t getTileCount(int rows) const;
+    void     D2CTile(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2], const float *coeff_mat_z[2],
+                     int *map, int row_begin, int row_end, bool withSSE);
+
+    /**
+     * @brief Run the SSE alignment of a tile with the 8-wide AVX2 projection kernel
+     *
+     * @retval false the AVX2 kernels are not built in or the distortion model is not supported, nothing is done
+     */
+    bool D2CWithAVX2(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
+                     const float *coeff_mat_z[2], int *map, int row_begin, int row_end);
     void        K3DistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                                         const float *coeff_mat_z[2], int *map = nullptr);
+                                         const float *coeff_mat_z[2], int *map, int row_begin, int row_end);
     void        K6DistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                                         const float *coeff_mat_z[2], int *map = nullptr);
+                                         const float *coeff_mat_z[2], int *map, int row_begin, int row_end);
     void        KBDistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                                         const float *coeff_mat_z[2], int *map = nullptr);
+                                         const float *coeff_mat_z[2], int *map, int row_begin, int row_end);
     void        LinearDistortedD2CWithoutSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                                             const float *coeff_mat_z[2], int *map = nullptr);
+                                             const float *coeff_mat_z[2], int *map, int row_begin, int row_end);
     inline bool K3ProcessWithoutSSE(uint16_t depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2], const float *coeff_mat_z[2], int channel,
                                     float *pixelx_f, float *pixely_f, float *dst);
     inline bool K6ProcessWithoutSSE(uint16_t depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2], const float *coeff_mat_z[2], int channel,
@@ -142,13 +161,13 @@ private:
     void FillMultiChannelWithoutSSE(const float *pixelx_f, const float *pixely_f, const float *dst, uint16_t *out_depth, int *map, int depth_idx, int width,
                                     int height);
     void K3DistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                               const float *coeff_mat_z[2], int *map = nullptr);
+                               const float *coeff_mat_z[2], int *map, int row_begin, int row_end);
     void K6DistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                               const float *coeff_mat_z[2], int *map = nullptr);
+                               const float *coeff_mat_z[2], int *map, int row_begin, int row_end);
     void KBDistortedD2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                               const float *coeff_mat_z[2], int *map = nullptr);
+                               const float *coeff_mat_z[2], int *map, int row_begin, int row_end);
     void LinearD2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x[2], const float *coeff_mat_y[2],
-                          const float *coeff_mat_z[2], int *map = nullptr);
+                          const float *coeff_mat_z[2], int *map, int row_begin, int row_end);
     inline void K3ProcessWithSSE(const uint16_t *depth_buffer, const float *coeff_mat_x[2], const float *coeff_mat_y[2], const float *coeff_mat_z[2],
                                  float *x_lo, float *y_lo, float *z_lo, float *x_hi, float *y_hi, float *z_hi, int start_idx, int channel);
     inline void K6ProcessWithSSE(const uint16_t *depth_buffer, const float *coeff_mat_x[2], const float *coeff_mat_y[2], const float *coeff_mat_z[2],
@@ -218,6 +237,11 @@ private:
     std::vector<uint16_t> depth_work_buf_;  // copy of input depth with invalid pixels zeroed
     std::vector<uint16_t> scale_work_buf_;  // intermediate buffer for D2C post-process scale step
 
+    // multi-threaded alignment: the depth frame is split into horizontal tiles, one per thread
+    uint32_t                           thread_count_;
+    std::unique_ptr<utils::WorkerPool> worker_pool_;
+    std::vector<std::vector<uint16_t>> tile_depth_bufs_;  // z-buffers of the tiles after the first one, merged into the output
+
     // members for SSE
     bool     use_scale_ = false;
     OBFormat depth_format_;
@@ -0,0 +1,201 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Built with AVX2 enabled and only called after a runtime check of the CPU (utils::getSimdLevel()). Nothing inline or templated from the
+// C++ headers is used here, so no AVX2 copy of a shared function can be picked by the linker for the code running on older CPUs.
+// No FMA: a fused multiply-add rounds differently from the SSE kernels.
+
+#include "AlignImplAVX2.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#include <math.h>
+#endif
+
+namespace libobsensor {
+
+#if defined(__AVX2__)
+
+namespace {
+
+struct AVX2Data {
+    __m256 fx, fy, cx, cy;
+    __m256 k1, k2, k3, k4, k5, k6;
+    __m256 p1, p2;
+    __m256 trans1, trans2, trans3;
+    __m256 r2_max_loc;
+    __m256 one, two, zero;
+};
+
+void loadData(const AlignAVX2Params &params, AVX2Data &data) {
+    data.fx         = _mm256_set1_ps(params.fx);
+    data.fy         = _mm256_set1_ps(params.fy);
+    data.cx         = _mm256_set1_ps(params.cx);
+    data.cy         = _mm256_set1_ps(params.cy);
+    data.k1         = _mm256_set1_ps(params.k1);
+    data.k2         = _mm256_set1_ps(params.k2);
+    data.k3         = _mm256_set1_ps(params.k3);
+    data.k4         = _mm256_set1_ps(params.k4);
+    data.k5         = _mm256_set1_ps(params.k5);
+    data.k6         = _mm256_set1_ps(params.k6);
+    data.p1         = _mm256_set1_ps(params.p1);
+    data.p2         = _mm256_set1_ps(params.p2);
+    data.trans1     = _mm256_set1_ps(params.scaled_trans[0]);
+    data.trans2     = _mm256_set1_ps(params.scaled_trans[1]);
+    data.trans3     = _mm256_set1_ps(params.scaled_trans[2]);
+    data.r2_max_loc = _mm256_set1_ps(params.r2_max_loc);
+    data.one        = _mm256_set1_ps(1);
+    data.two        = _mm256_set1_ps(2);
+    data.zero       = _mm256_setzero_ps();
+}
+
+// AlignImpl::distortedWithSSE
+inline void distorted(const AVX2Data &d, __m256 &tx, __m256 &ty, const __m256 x2, const __m256 y2, const __m256 r2) {
+    __m256 xy = _mm256_mul_ps(tx, ty);
+    __m256 r4 = _mm256_mul_ps(r2, r2);
+    __m256 r6 = _mm256_mul_ps(r4, r2);
+
+    __m256 k_jx = _mm256_add_ps(d.one, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(d.k1, r2), _mm256_mul_ps(d.k2, r4)), _mm256_mul_ps(d.k3, r6)));
+    __m256 x_qx = _mm256_add_ps(_mm256_mul_ps(d.p2, _mm256_add_ps(_mm256_mul_ps(x2, d.two), r2)), _mm256_mul_ps(_mm256_mul_ps(d.p1, xy), d.two));
+    __m256 y_qx = _mm256_add_ps(_mm256_mul_ps(d.p1, _mm256_add_ps(_mm256_mul_ps(y2, d.two), r2)), _mm256_mul_ps(_mm256_mul_ps(d.p2, xy), d.two));
+
+    tx = _mm256_add_ps(_mm256_mul_ps(tx, k_jx), x_qx);
+    ty = _mm256_add_ps(_mm256_mul_ps(ty, k_jx), y_qx);
+}
+
+// AlignImpl::BMDistortedWithSSE
+inline void BMDistorted(const AVX2Data &d, __m256 &tx, __m256 &ty, const __m256 x2, const __m256 y2, const __m256 r2) {
+    __m256 xy = _mm256_mul_ps(tx, ty);
+    __m256 r4 = _mm256_mul_ps(r2, r2);
+    __m256 r6 = _mm256_mul_ps(r4, r2);
+
+    __m256 k_jx = _mm256_div_ps(_mm256_add_ps(d.one, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(d.k1, r2), _mm256_mul_ps(d.k2, r4)), _mm256_mul_ps(d.k3, r6))),
+                                _mm256_add_ps(d.one, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(d.k4, r2), _mm256_mul_ps(d.k5, r4)), _mm256_mul_ps(d.k6, r6))));
+    __m256 x_qx = _mm256_add_ps(_mm256_mul_ps(d.p2, _mm256_add_ps(_mm256_mul_ps(x2, d.two), r2)), _mm256_mul_ps(_mm256_mul_ps(d.p1, xy), d.two));
+    __m256 y_qx = _mm256_add_ps(_mm256_mul_ps(d.p1, _mm256_add_ps(_mm256_mul_ps(y2, d.two), r2)), _mm256_mul_ps(_mm256_mul_ps(d.p2, xy), d.two));
+
+    tx = _mm256_add_ps(_mm256_mul_ps(tx, k_jx), x_qx);
+    ty = _mm256_add_ps(_mm256_mul_ps(ty, k_jx), y_qx);
+}
+
+// AlignImpl::KBDistortedWithSSE, atan is evaluated per lane in double precision like the SSE kernel
+inline void KBDistorted(const AVX2Data &d, __m256 &tx, __m256 &ty, const __m256 r2) {
+    __m256 r = _mm256_sqrt_ps(r2);
+
+    float r_[8];
+    float theta_[8];
+    _mm256_storeu_ps(r_, r);
+    for(int i = 0; i < 8; i++) {
+        theta_[i] = static_cast<float>(atan(static_cast<double>(r_[i])));
+    }
+
+    __m256 theta  = _mm256_loadu_ps(theta_);
+    __m256 theta2 = _mm256_mul_ps(theta, theta);
+    __m256 theta3 = _mm256_mul_ps(theta, theta2);
+    __m256 theta5 = _mm256_mul_ps(theta2, theta3);
+    __m256 theta7 = _mm256_mul_ps(theta2, theta5);
+    __m256 theta9 = _mm256_mul_ps(theta2, theta7);
+
+    __m256 theta_jx = _mm256_add_ps(
+        _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(theta, _mm256_mul_ps(d.k1, theta3)), _mm256_mul_ps(d.k2, theta5)), _mm256_mul_ps(d.k3, theta7)),
+        _mm256_mul_ps(d.k4, theta9));
+
+    tx = _mm256_mul_ps(_mm256_div_ps(theta_jx, r), tx);
+    ty = _mm256_mul_ps(_mm256_div_ps(theta_jx, r), ty);
+}
+
+inline void projectChunk(const AVX2Data &d, AlignAVX2Model model, bool y12c4, const uint16_t *depth_buffer, const float *const coeff_mat_x[2],
+                         const float *const coeff_mat_y[2], const float *const coeff_mat_z[2], int channel, int start_idx, float *out) {
+    float *x_lo = out;
+    float *y_lo = out + 8;
+    float *z_lo = out + 16;
+    float *x_hi = out + 24;
+    float *y_hi = out + 32;
+    float *z_hi = out + 40;
+
+    __m256i depth_i = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(depth_buffer + start_idx)));
+    __m256  depth_f = _mm256_cvtepi32_ps(y12c4 ? _mm256_srli_epi32(depth_i, 4) : depth_i);
+
+    for(int fold = 0; fold < channel; fold++) {
+        __m256 coeff1 = _mm256_loadu_ps(coeff_mat_x[fold] + start_idx);
+        __m256 coeff2 = _mm256_loadu_ps(coeff_mat_y[fold] + start_idx);
+        __m256 coeff3 = _mm256_loadu_ps(coeff_mat_z[fold] + start_idx);
+
+        // AlignImpl::CalcNormCorrdWithSSE
+        __m256 Y       = _mm256_add_ps(_mm256_mul_ps(depth_f, coeff2), d.trans2);
+        __m256 X       = _mm256_add_ps(_mm256_mul_ps(depth_f, coeff1), d.trans1);
+        __m256 depth_o = _mm256_add_ps(_mm256_mul_ps(depth_f, coeff3), d.trans3);
+        __m256 nx      = _mm256_div_ps(X, depth_o);
+        __m256 ny      = _mm256_div_ps(Y, depth_o);
+
+        if(model != ALIGN_AVX2_LINEAR) {
+            __m256 x2 = _mm256_mul_ps(nx, nx);
+            __m256 y2 = _mm256_mul_ps(ny, ny);
+            __m256 r2 = _mm256_add_ps(x2, y2);
+
+            switch(model) {
+            case ALIGN_AVX2_K3:
+                distorted(d, nx, ny, x2, y2, r2);
+                break;
+            case ALIGN_AVX2_K6: {
+                __m256 flag = _mm256_or_ps(_mm256_cmp_ps(d.zero, d.r2_max_loc, _CMP_GE_OS), _mm256_cmp_ps(r2, d.r2_max_loc, _CMP_LT_OS));
+                depth_o     = _mm256_and_ps(depth_o, flag);
+                BMDistorted(d, nx, ny, x2, y2, r2);
+            } break;
+            default:
+                KBDistorted(d, nx, ny, r2);
+                break;
+            }
+        }
+
+        __m256 pixelx = _mm256_add_ps(_mm256_mul_ps(nx, d.fx), d.cx);
+        __m256 pixely = _mm256_add_ps(_mm256_mul_ps(ny, d.fy), d.cy);
+
+        if(y12c4) {
+            __m256i shifted = _mm256_slli_epi32(_mm256_cvttps_epi32(depth_o), 4);
+            __m256i low     = _mm256_and_si256(depth_i, _mm256_set1_epi32(0x0000000F));
+            depth_o         = _mm256_cvtepi32_ps(_mm256_or_si256(shifted, low));
+        }
+
+        _mm_storeu_ps(x_lo + fold * 4, _mm256_castps256_ps128(pixelx));
+        _mm_storeu_ps(y_lo + fold * 4, _mm256_castps256_ps128(pixely));
+        _mm_storeu_ps(z_lo + fold * 4, _mm256_castps256_ps128(depth_o));
+        _mm_storeu_ps(x_hi + fold * 4, _mm256_extractf128_ps(pixelx, 1));
+        _mm_storeu_ps(y_hi + fold * 4, _mm256_extractf128_ps(pixely, 1));
+        _mm_storeu_ps(z_hi + fold * 4, _mm256_extractf128_ps(depth_o, 1));
+    }
+}
+
+}  // namespace
+
+bool projectDepthChunksAVX2(const AlignAVX2Params &params, AlignAVX2Model model, bool y12c4, const uint16_t *depth_buffer, const float *const coeff_mat_x[2],
+                            const float *const coeff_mat_y[2], const float *const coeff_mat_z[2], int channel, int start_idx, int chunk_count, float *out) {
+    AVX2Data data;
+    loadData(params, data);
+    for(int n = 0; n < chunk_count; n++) {
+        projectChunk(data, model, y12c4, depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, channel, start_idx + 8 * n, out + ALIGN_AVX2_CHUNK_FLOATS * n);
+    }
+    return true;
+}
+
+#else
+
+bool projectDepthChunksAVX2(const AlignAVX2Params &params, AlignAVX2Model model, bool y12c4, const uint16_t *depth_buffer, const float *const coeff_mat_x[2],
+                            const float *const coeff_mat_y[2], const float *const coeff_mat_z[2], int channel, int start_idx, int chunk_count, float *out) {
+    (void)params;
+    (void)model;
+    (void)y12c4;
+    (void)depth_buffer;
+    (void)coeff_mat_x;
+    (void)coeff_mat_y;
+    (void)coeff_mat_z;
+    (void)channel;
+    (void)start_idx;
+    (void)chunk_count;
+    (void)out;
+    return false;
+}
+
+#endif  // __AVX2__
+
+}  // namespace libobsensor
@@ -0,0 +1,51 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <stdint.h>
+
+namespace libobsensor {
+
+// Number of floats written per chunk of 8 depth pixels: the x_lo, y_lo, z_lo, x_hi, y_hi, z_hi arrays of the SSE kernels, 8 floats each
+#define ALIGN_AVX2_CHUNK_FLOATS 48
+
+typedef enum {
+    ALIGN_AVX2_LINEAR = 0,
+    ALIGN_AVX2_K3     = 1,  // OB_DISTORTION_BROWN_CONRADY
+    ALIGN_AVX2_K6     = 2,  // OB_DISTORTION_BROWN_CONRADY_K6
+    ALIGN_AVX2_KB     = 3,  // OB_DISTORTION_KANNALA_BRANDT4
+} AlignAVX2Model;
+
+/**
+ * @brief Parameters of the projection to the color camera, the same values as the broadcast registers of AlignImpl::AlignImplSSEData
+ */
+typedef struct {
+    float fx, fy, cx, cy;
+    float k1, k2, k3, k4, k5, k6;
+    float p1, p2;
+    float scaled_trans[3];
+    float r2_max_loc;
+} AlignAVX2Params;
+
+/**
+ * @brief Project chunks of 8 depth pixels to the color camera with 8-wide AVX2, one chunk per step of the SSE kernels of AlignImpl
+ * @brief The operations are the same as the SSE kernels in the same order, so the results are bit-exact.
+ *
+ * @param[in] params projection parameters
+ * @param[in] model distortion model of the color camera
+ * @param[in] y12c4 depth pixels are Y12C4, the 4 low bits are kept in the projected depth
+ * @param[in] depth_buffer depth pixels in row-major order
+ * @param[in] coeff_mat_x rotation LUTs, one per channel
+ * @param[in] coeff_mat_y rotation LUTs, one per channel
+ * @param[in] coeff_mat_z rotation LUTs, one per channel
+ * @param[in] channel 1 for gap filling with copy, 2 for the top-left and bottom-right corners
+ * @param[in] start_idx index of the first depth pixel
+ * @param[in] chunk_count number of chunks
+ * @param[out] out ALIGN_AVX2_CHUNK_FLOATS floats per chunk
+ *
+ * @return false if the library is built without the AVX2 kernels, nothing is written then
+ */
+bool projectDepthChunksAVX2(const AlignAVX2Params &params, AlignAVX2Model model, bool y12c4, const uint16_t *depth_buffer, const float *const coeff_mat_x[2],
+                            const float *const coeff_mat_y[2], const float *const coeff_mat_z[2], int channel, int start_idx, int chunk_count, float *out);
+
+}  // namespace libobsensor
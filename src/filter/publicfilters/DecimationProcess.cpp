@@ -262,13 +262,13 @@ std::shared_ptr<Frame> DecimationFilter::process(std::shared_ptr<const Frame> fr
 
     if(frame->is<FrameSet>()) {
         LOG_WARN_INTVL("The Frame processed by DecimationFilter cannot be FrameSet!");
-        auto outFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+        auto outFrame = FrameFactory::createFrameView(frame);
         return outFrame;
     }
 
     if(!isFrameFormatTypeSupported(frame->getFormat())) {
         LOG_WARN_INTVL("Unsupported decimation filter processing frame format @{}.", frame->getFormat());
-        auto outFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+        auto outFrame = FrameFactory::createFrameView(frame);
         return outFrame;
     }
 
@@ -11,6 +11,8 @@
 #include "utils/Utils.hpp"
 #include <libyuv.h>
 #include <turbojpeg.h>
+#include <algorithm>
+#include <thread>
 
 #if defined(__linux__)
 #include <sys/mman.h>
@@ -19,7 +21,13 @@
 
 namespace libobsensor {
 
-FormatConverter::FormatConverter() : convertType_(FORMAT_YUYV_TO_RGB) {}
+// Frames from this size on (720p and up) are converted in row bands on several threads
+#define FORMAT_CONVERT_PARALLEL_MIN_PIXELS (1280 * 720)
+#define FORMAT_CONVERT_MAX_THREADS 4
+
+FormatConverter::FormatConverter() : convertType_(FORMAT_YUYV_TO_RGB) {
+    threadCount_ = std::max(1u, std::min(std::thread::hardware_concurrency(), static_cast<uint32_t>(FORMAT_CONVERT_MAX_THREADS)));
+}
 FormatConverter::~FormatConverter() noexcept {
     clearTempDataBuf();
 }
@@ -185,50 +193,26 @@ std::shared_ptr<Frame> FormatConverter::process(std::shared_ptr<const Frame> fra
         break;
     default:
         LOG_WARN_INTVL("Unsupported data format conversion.");
-        return FrameFactory::createFrameFromOtherFrame(frame, true);
+        return FrameFactory::createFrameView(frame);
         break;
     }
     return tarFrame;
 }
 
 void FormatConverter::yuyvToRgb(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
-    const size_t preferSize = width * height * 3 / 2;
-    allocateTempDataBufIfNeeded(preferSize);
-    uint8_t *yData = tempDataBuf_;
-    uint8_t *uData = tempDataBuf_ + width * height;
-    uint8_t *vData = tempDataBuf_ + width * height * 5 / 4;
-    libyuv::YUY2ToI420(src, width * 2, yData, width, uData, width / 2, vData, width / 2, width, height);
-    libyuv::I420ToRAW(yData, width, uData, width / 2, vData, width / 2, target, width * 3, width, height);
+    packedYuvToRgb(src, false, target, OB_FORMAT_RGB, width, height);
 }
 
 void FormatConverter::yuyvToRgba(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
-    const size_t preferSize = width * height * 4;
-    allocateTempDataBufIfNeeded(preferSize);
-    uint8_t *yData = tempDataBuf_;
-    uint8_t *uData = tempDataBuf_ + width * height;
-    uint8_t *vData = tempDataBuf_ + width * height * 5 / 4;
-    libyuv::YUY2ToI420(src, width * 2, yData, width, uData, width / 2, vData, width / 2, width, height);
-    libyuv::I420ToABGR(yData, width, uData, width / 2, vData, width / 2, target, width * 4, width, height);
+    packedYuvToRgb(src, false, target, OB_FORMAT_RGBA, width, height);
 }
 
 void FormatConverter::yuyvToBgr(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
-    const size_t preferSize = width * height * 3 / 2;
-    allocateTempDataBufIfNeeded(static_cast<size_t>(preferSize));
-    uint8_t *yData = tempDataBuf_;
-    uint8_t *uData = tempDataBuf_ + width * height;
-    uint8_t *vData = tempDataBuf_ + width * height * 5 / 4;
-    libyuv::YUY2ToI420(src, width * 2, yData, width, uData, width / 2, vData, width / 2, width, height);
-    libyuv::I420ToRGB24(yData, width, uData, width / 2, vData, width / 2, target, width * 3, width, height);
+    packedYuvToRgb(src, false, target, OB_FORMAT_BGR, width, height);
 }
 
 void FormatConverter::yuyvToBgra(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
-    const size_t preferSize = width * height * 4;
-    allocateTempDataBufIfNeeded(preferSize);
-    uint8_t *yData = tempDataBuf_;
-    uint8_t *uData = tempDataBuf_ + width * height;
-    uint8_t *vData = tempDataBuf_ + width * height * 5 / 4;
-    libyuv::YUY2ToI420(src, width * 2, yData, width, uData, width / 2, vData, width / 2, width, height);
-    libyuv::I420ToARGB(yData, width, uData, width / 2, vData, width / 2, target, width * 4, width, height);
+    packedYuvToRgb(src, false, target, OB_FORMAT_BGRA, width, height);
 }
 
 void FormatConverter::yuyvToy16(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
@@ -266,13 +250,80 @@ void FormatConverter::yuyvToy8(uint8_t *src, uint8_t *target, uint32_t width, ui
 }
 
 void FormatConverter::uyvyToRgb(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
-    const size_t preferSize = width * height * 3 / 2;
-    allocateTempDataBufIfNeeded(preferSize);
-    uint8_t *yData = tempDataBuf_;
-    uint8_t *uData = tempDataBuf_ + width * height;
-    uint8_t *vData = tempDataBuf_ + width * height * 5 / 4;
-    libyuv::UYVYToI420(src, width * 2, yData, width, uData, width / 2, vData, width / 2, width, height);
-    libyuv::I420ToRAW(yData, width, uData, width / 2, vData, width / 2, target, width * 3, width, height);
+    packedYuvToRgb(src, true, target, OB_FORMAT_RGB, width, height);
+}
+
+void FormatConverter::packedYuvToRgb(const uint8_t *src, bool uyvy, uint8_t *target, OBFormat dstFormat, uint32_t width, uint32_t height) {
+    // Single pass with the full 4:2:2 chroma: the packed YUV rows are converted to BGRA (libyuv ARGB) and swizzled to the target format while
+    // the row is still in the cache, there is no I420 intermediate frame.
+    const int srcStride  = static_cast<int>(width * 2);
+    const int bgraStride = static_cast<int>(width * 4);
+    const int w          = static_cast<int>(width);
+    auto      toBgra     = [&](const uint8_t *srcRows, uint8_t *bgraRows, int rows) {
+        if(uyvy) {
+            libyuv::UYVYToARGB(srcRows, srcStride, bgraRows, bgraStride, w, rows);
+        }
+        else {
+            libyuv::YUY2ToARGB(srcRows, srcStride, bgraRows, bgraStride, w, rows);
+        }
+    };
+
+    if(dstFormat == OB_FORMAT_BGRA) {
+        convertInRowBands(width, height, 0, [&](uint32_t rowBegin, uint32_t rowEnd, uint8_t *rowBuf) {
+            utils::unusedVar(rowBuf);
+            toBgra(src + rowBegin * srcStride, target + rowBegin * bgraStride, static_cast<int>(rowEnd - rowBegin));
+        });
+        return;
+    }
+
+    const int dstStride = static_cast<int>(width * (dstFormat == OB_FORMAT_RGBA ? 4 : 3));
+    convertInRowBands(width, height, width * 4, [&](uint32_t rowBegin, uint32_t rowEnd, uint8_t *rowBuf) {
+        for(uint32_t row = rowBegin; row < rowEnd; row++) {
+            uint8_t *dstRow = target + row * dstStride;
+            toBgra(src + row * srcStride, rowBuf, 1);
+            switch(dstFormat) {
+            case OB_FORMAT_RGB:
+                libyuv::ARGBToRAW(rowBuf, bgraStride, dstRow, dstStride, w, 1);
+                break;
+            case OB_FORMAT_BGR:
+                libyuv::ARGBToRGB24(rowBuf, bgraStride, dstRow, dstStride, w, 1);
+                break;
+            default:  // OB_FORMAT_RGBA
+                libyuv::ARGBToABGR(rowBuf, bgraStride, dstRow, dstStride, w, 1);
+                break;
+            }
+        }
+    });
+}
+
+void FormatConverter::convertInRowBands(uint32_t width, uint32_t height, size_t rowBufSize,
+                                        const std::function<void(uint32_t rowBegin, uint32_t rowEnd, uint8_t *rowBuf)> &convertRows) {
+    uint32_t bandCount = 1;
+    if(width * height >= FORMAT_CONVERT_PARALLEL_MIN_PIXELS && threadCount_ > 1) {
+        if(!workerPool_) {
+            workerPool_.reset(new utils::WorkerPool(threadCount_));
+        }
+        bandCount = std::min(threadCount_, height);
+    }
+
+    if(rowBufs_.size() < bandCount) {
+        rowBufs_.resize(bandCount);
+    }
+    for(uint32_t i = 0; i < bandCount; i++) {
+        if(rowBufs_[i].size() < rowBufSize) {
+            rowBufs_[i].resize(rowBufSize);
+        }
+    }
+
+    if(bandCount == 1) {
+        convertRows(0, height, rowBufs_[0].data());
+        return;
+    }
+    workerPool_->run(bandCount, [&](uint32_t band) {
+        uint32_t rowBegin = static_cast<uint32_t>(static_cast<uint64_t>(height) * band / bandCount);
+        uint32_t rowEnd   = static_cast<uint32_t>(static_cast<uint64_t>(height) * (band + 1) / bandCount);
+        convertRows(rowBegin, rowEnd, rowBufs_[band].data());
+    });
 }
 
 void FormatConverter::i420ToRgb(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
@@ -3,7 +3,11 @@
 
 #pragma once
 #include "IFilter.hpp"
+#include "utils/WorkerPool.hpp"
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace libobsensor {
 
@@ -42,6 +46,10 @@ private:
     void bgraToBgr(uint8_t *src, uint32_t src_len, uint8_t *target, uint32_t width, uint32_t height);
     void y16ToRgb(uint8_t *src, uint32_t src_len, uint8_t *target, uint32_t width, uint32_t height);
     void y8ToRgb(uint8_t *src, uint32_t src_len, uint8_t *target, uint32_t width, uint32_t height);
+    void packedYuvToRgb(const uint8_t *src, bool uyvy, uint8_t *target, OBFormat dstFormat, uint32_t width, uint32_t height);
+    // Run convertRows on bands of rows, on the worker pool for large frames. Each band gets its own rowBufSize bytes scratch buffer.
+    void convertInRowBands(uint32_t width, uint32_t height, size_t rowBufSize,
+                           const std::function<void(uint32_t rowBegin, uint32_t rowEnd, uint8_t *rowBuf)> &convertRows);
     void clearTempDataBuf();
     void allocateTempDataBufIfNeeded(const size_t preferSize);
 
@@ -51,6 +59,10 @@ protected:
     OBConvertFormat                      convertType_;
     uint8_t                             *tempDataBuf_     = nullptr;
     size_t                               tempDataBufSize_ = 0;
+
+    uint32_t                           threadCount_;
+    std::unique_ptr<utils::WorkerPool> workerPool_;  // created on the first large frame
+    std::vector<std::vector<uint8_t>>  rowBufs_;     // one scratch row per band
 };
 
 }  // namespace libobsensor
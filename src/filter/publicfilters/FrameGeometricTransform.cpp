@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "FrameGeometricTransform.hpp"
+#include "PixelOpProgram.hpp"
 #include "exception/ObException.hpp"
 #include "frame/FrameFactory.hpp"
 #include "libobsensor/h/ObTypes.h"
@@ -9,6 +10,7 @@
 #include "utils/Utils.hpp"
 #include <libyuv.h>
 #include <turbojpeg.h>
+#include <algorithm>
 
 namespace libobsensor {
 void mirrorRGBImage(const uint8_t *src, uint8_t *dst, uint32_t width, uint32_t height) {
@@ -75,6 +77,23 @@ void mirrorUYVYImage(uint8_t *src, uint8_t *dst, int width, int height) {
     }
 }
 
+// Mirror of YUYV (y0 = 0, y1 = 2) or UYVY (y0 = 1, y1 = 3) in place: the macro pixels are reversed, then their two Y swapped
+void mirrorPackedYUVImageInPlace(uint8_t *data, uint32_t width, uint32_t height, int y0, int y1) {
+    imageMirrorInPlace<uint32_t>(reinterpret_cast<uint32_t *>(data), width / 2, height);
+    uint8_t *pixel = data;
+    for(uint32_t i = 0; i < width / 2 * height; i++) {
+        std::swap(pixel[y0], pixel[y1]);
+        pixel += 4;
+    }
+}
+
+void flipImageInPlace(uint8_t *data, uint32_t rowSize, uint32_t height) {
+    for(uint32_t h = 0; h < height / 2; h++) {
+        uint8_t *top = data + h * rowSize;
+        std::swap_ranges(top, top + rowSize, data + (height - h - 1) * rowSize);
+    }
+}
+
 void flipRGBImage(int pixelSize, const uint8_t *src, uint8_t *dst, uint32_t width, uint32_t height) {
     // const uint32_t pixelSize = 3;  // RGB888 format occupies 3 bytes per pixel
     const uint32_t rowSize = width * static_cast<uint32_t>(pixelSize);
@@ -251,7 +270,7 @@ std::shared_ptr<Frame> FrameMirror::process(std::shared_ptr<const Frame> frame)
     }
 
     if(frame->is<FrameSet>()) {
-        auto outFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+        auto outFrame = FrameFactory::createFrameView(frame);
         return outFrame;
     }
 
@@ -293,42 +312,101 @@ std::shared_ptr<Frame> FrameMirror::process(std::shared_ptr<const Frame> frame)
         break;
     }
 
-    try {
-        if(isMirrorSupport) {
-            auto streampProfile = frame->getStreamProfile();
-            if(!srcStreamProfile_ || srcStreamProfile_ != streampProfile) {
-                srcStreamProfile_          = streampProfile;
-                auto srcVideoStreamProfile = srcStreamProfile_->as<VideoStreamProfile>();
-                auto srcIntrinsic          = srcVideoStreamProfile->getIntrinsic();
-                auto rstIntrinsic          = mirrorOBCameraIntrinsic(srcIntrinsic);
-                auto srcDistortion         = srcVideoStreamProfile->getDistortion();
-                auto rstDistortion         = mirrorOBCameraDistortion(srcDistortion);
-                rstStreamProfile_          = srcVideoStreamProfile->clone()->as<VideoStreamProfile>();
-                rstStreamProfile_->bindIntrinsic(rstIntrinsic);
-                rstStreamProfile_->bindDistortion(rstDistortion);
+    if(isMirrorSupport) {
+        outFrame->setStreamProfile(getMirroredStreamProfile(frame->getStreamProfile()));
+    }
 
-                OBExtrinsic rstExtrinsic = { {
-                                                 -1,
-                                                 0,
-                                                 0,
-                                                 0,
-                                                 1,
-                                                 0,
-                                                 0,
-                                                 0,
-                                                 1,
-                                             },
-                                             { 0, 0, 0 } };
-                rstStreamProfile_->bindExtrinsicTo(srcStreamProfile_, rstExtrinsic);
-            }
-            outFrame->setStreamProfile(rstStreamProfile_);
+    return outFrame;
+}
+
+std::shared_ptr<const StreamProfile> FrameMirror::getMirroredStreamProfile(std::shared_ptr<const StreamProfile> streamProfile) {
+    try {
+        if(!srcStreamProfile_ || srcStreamProfile_ != streamProfile) {
+            auto srcVideoStreamProfile = streamProfile->as<VideoStreamProfile>();
+            auto srcIntrinsic          = srcVideoStreamProfile->getIntrinsic();
+            auto rstIntrinsic          = mirrorOBCameraIntrinsic(srcIntrinsic);
+            auto srcDistortion         = srcVideoStreamProfile->getDistortion();
+            auto rstDistortion         = mirrorOBCameraDistortion(srcDistortion);
+            auto rstStreamProfile      = srcVideoStreamProfile->clone()->as<VideoStreamProfile>();
+            rstStreamProfile->bindIntrinsic(rstIntrinsic);
+            rstStreamProfile->bindDistortion(rstDistortion);
+
+            OBExtrinsic rstExtrinsic = { {
+                                             -1,
+                                             0,
+                                             0,
+                                             0,
+                                             1,
+                                             0,
+                                             0,
+                                             0,
+                                             1,
+                                         },
+                                         { 0, 0, 0 } };
+            rstStreamProfile->bindExtrinsicTo(streamProfile, rstExtrinsic);
+            srcStreamProfile_ = streamProfile;
+            rstStreamProfile_ = rstStreamProfile;
         }
+        return rstStreamProfile_;
     }
     catch(libobsensor_exception &error) {
         LOG_WARN_INTVL("Frame mirror camera intrinsic conversion failed{0}, exception type: {1}", error.getMessage(), error.getExceptionType());
+        // remember the failure: the next frames of the profile pass it through without converting (and throwing) again
+        srcStreamProfile_ = streamProfile;
+        rstStreamProfile_ = streamProfile;
     }
+    return streamProfile;
+}
 
-    return outFrame;
+bool FrameMirror::processInPlace(std::shared_ptr<Frame> frame) {
+    auto videoFrame = frame->tryAs<VideoFrame>();
+    if(!videoFrame) {
+        return false;
+    }
+
+    auto width  = videoFrame->getWidth();
+    auto height = videoFrame->getHeight();
+    switch(frame->getFormat()) {
+    case OB_FORMAT_Y8:
+        imageMirrorInPlace<uint8_t>(frame->getDataMutable(), width, height);
+        break;
+    case OB_FORMAT_Y12C4:
+    case OB_FORMAT_Y16:
+        imageMirrorInPlace<uint16_t>(reinterpret_cast<uint16_t *>(frame->getDataMutable()), width, height);
+        break;
+    case OB_FORMAT_YUYV:
+        if(is_color_frame(frame->getType())) {
+            mirrorPackedYUVImageInPlace(frame->getDataMutable(), width, height, 0, 2);
+        }
+        else {
+            imageMirrorInPlace<uint32_t>(reinterpret_cast<uint32_t *>(frame->getDataMutable()), width / 2, height);
+        }
+        break;
+    case OB_FORMAT_UYVY:
+        if(!is_color_frame(frame->getType())) {
+            return false;
+        }
+        mirrorPackedYUVImageInPlace(frame->getDataMutable(), width, height, 1, 3);
+        break;
+    case OB_FORMAT_RGB:
+    case OB_FORMAT_BGR:
+        imageMirrorInPlace<RGBPixel>(reinterpret_cast<RGBPixel *>(frame->getDataMutable()), width, height);
+        break;
+    case OB_FORMAT_RGBA:
+    case OB_FORMAT_BGRA:
+        imageMirrorInPlace<uint32_t>(reinterpret_cast<uint32_t *>(frame->getDataMutable()), width, height);
+        break;
+    default:
+        return false;
+    }
+
+    frame->setStreamProfile(getMirroredStreamProfile(frame->getStreamProfile()));
+    return true;
+}
+
+bool FrameMirror::appendPixelOp(PixelOpProgram &program) {
+    program.addMirror(getMirroredStreamProfile(program.getStreamProfile()));
+    return true;
 }
 
 OBCameraIntrinsic FrameMirror::mirrorOBCameraIntrinsic(const OBCameraIntrinsic &src) {
@@ -380,7 +458,7 @@ std::shared_ptr<Frame> FrameFlip::process(std::shared_ptr<const Frame> frame) {
     }
 
     if(frame->is<FrameSet>()) {
-        auto outFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+        auto outFrame = FrameFactory::createFrameView(frame);
         return outFrame;
     }
 
@@ -411,31 +489,78 @@ std::shared_ptr<Frame> FrameFlip::process(std::shared_ptr<const Frame> frame) {
         break;
     }
 
-    try {
-        if(isSupportFlip) {
-            auto streampProfile = frame->getStreamProfile();
-            if(!srcStreamProfile_ || srcStreamProfile_ != streampProfile) {
-                srcStreamProfile_          = streampProfile;
-                auto srcVideoStreamProfile = srcStreamProfile_->as<VideoStreamProfile>();
-                auto srcIntrinsic          = srcVideoStreamProfile->getIntrinsic();
-                auto rstIntrinsic          = flipOBCameraIntrinsic(srcIntrinsic);
-                auto srcDistortion         = srcVideoStreamProfile->getDistortion();
-                auto rstDistortion         = flipOBCameraDistortion(srcDistortion);
-                rstStreamProfile_          = srcVideoStreamProfile->clone()->as<VideoStreamProfile>();
-                rstStreamProfile_->bindIntrinsic(rstIntrinsic);
-                rstStreamProfile_->bindDistortion(rstDistortion);
+    if(isSupportFlip) {
+        outFrame->setStreamProfile(getFlippedStreamProfile(frame->getStreamProfile()));
+    }
 
-                OBExtrinsic rstExtrinsic = { { 1, 0, 0, 0, -1, 0, 0, 0, 1 }, { 0, 0, 0 } };
-                rstStreamProfile_->bindExtrinsicTo(srcStreamProfile_, rstExtrinsic);
-            }
-            outFrame->setStreamProfile(rstStreamProfile_);
+    return outFrame;
+}
+
+std::shared_ptr<const StreamProfile> FrameFlip::getFlippedStreamProfile(std::shared_ptr<const StreamProfile> streamProfile) {
+    try {
+        if(!srcStreamProfile_ || srcStreamProfile_ != streamProfile) {
+            auto srcVideoStreamProfile = streamProfile->as<VideoStreamProfile>();
+            auto srcIntrinsic          = srcVideoStreamProfile->getIntrinsic();
+            auto rstIntrinsic          = flipOBCameraIntrinsic(srcIntrinsic);
+            auto srcDistortion         = srcVideoStreamProfile->getDistortion();
+            auto rstDistortion         = flipOBCameraDistortion(srcDistortion);
+            auto rstStreamProfile      = srcVideoStreamProfile->clone()->as<VideoStreamProfile>();
+            rstStreamProfile->bindIntrinsic(rstIntrinsic);
+            rstStreamProfile->bindDistortion(rstDistortion);
+
+            OBExtrinsic rstExtrinsic = { { 1, 0, 0, 0, -1, 0, 0, 0, 1 }, { 0, 0, 0 } };
+            rstStreamProfile->bindExtrinsicTo(streamProfile, rstExtrinsic);
+            srcStreamProfile_ = streamProfile;
+            rstStreamProfile_ = rstStreamProfile;
         }
+        return rstStreamProfile_;
     }
     catch(libobsensor_exception &error) {
         LOG_WARN_INTVL("Frame flip camera intrinsic conversion failed{0}, exception type: {1}", error.getMessage(), error.getExceptionType());
+        // remember the failure: the next frames of the profile pass it through without converting (and throwing) again
+        srcStreamProfile_ = streamProfile;
+        rstStreamProfile_ = streamProfile;
     }
+    return streamProfile;
+}
 
-    return outFrame;
+bool FrameFlip::processInPlace(std::shared_ptr<Frame> frame) {
+    auto videoFrame = frame->tryAs<VideoFrame>();
+    if(!videoFrame) {
+        return false;
+    }
+
+    uint32_t pixelSize = 0;
+    switch(frame->getFormat()) {
+    case OB_FORMAT_Y8:
+        pixelSize = 1;
+        break;
+    case OB_FORMAT_YUYV:
+    case OB_FORMAT_Y12C4:
+    case OB_FORMAT_UYVY:
+    case OB_FORMAT_Y16:
+        pixelSize = 2;
+        break;
+    case OB_FORMAT_BGR:
+    case OB_FORMAT_RGB:
+        pixelSize = 3;
+        break;
+    case OB_FORMAT_RGBA:
+    case OB_FORMAT_BGRA:
+        pixelSize = 4;
+        break;
+    default:
+        return false;
+    }
+
+    flipImageInPlace(frame->getDataMutable(), videoFrame->getWidth() * pixelSize, videoFrame->getHeight());
+    frame->setStreamProfile(getFlippedStreamProfile(frame->getStreamProfile()));
+    return true;
+}
+
+bool FrameFlip::appendPixelOp(PixelOpProgram &program) {
+    program.addFlip(getFlippedStreamProfile(program.getStreamProfile()));
+    return true;
 }
 
 OBCameraIntrinsic FrameFlip::flipOBCameraIntrinsic(const OBCameraIntrinsic &src) {
@@ -493,7 +618,7 @@ std::shared_ptr<Frame> FrameRotate::process(std::shared_ptr<const Frame> frame)
     }
 
     if(frame->is<FrameSet>()) {
-        auto outFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+        auto outFrame = FrameFactory::createFrameView(frame);
         return outFrame;
     }
 
@@ -6,6 +6,7 @@
 #include "stream/StreamProfile.hpp"
 #include "logger/LoggerInterval.hpp"
 
+#include <algorithm>
 #include <mutex>
 #include <thread>
 #include <atomic>
@@ -16,6 +17,12 @@ void mirrorRGBAImage(const uint8_t *src, uint8_t *dst, uint32_t width, uint32_t
 void mirrorYUYVImage(uint8_t *src, uint8_t *dst, int width, int height);
 void flipRGBImage(int pixelSize, const uint8_t *src, uint8_t *dst, uint32_t width, uint32_t height);
 void yuyvImageRotate(uint8_t *src, uint8_t *dst, uint32_t width, uint32_t height, uint32_t rotateDegree);
+void mirrorPackedYUVImageInPlace(uint8_t *data, uint32_t width, uint32_t height, int y0, int y1);
+void flipImageInPlace(uint8_t *data, uint32_t rowSize, uint32_t height);
+
+struct RGBPixel {
+    uint8_t value[3];
+};
 
 template <typename T> void imageMirror(const T *src, T *dst, uint32_t width, uint32_t height) {
     const T *srcPixel;
@@ -31,6 +38,12 @@ template <typename T> void imageMirror(const T *src, T *dst, uint32_t width, uin
     }
 }
 
+template <typename T> void imageMirrorInPlace(T *data, uint32_t width, uint32_t height) {
+    for(uint32_t h = 0; h < height; h++) {
+        std::reverse(data + h * width, data + (h + 1) * width);
+    }
+}
+
 template <typename T> void imageFlip(const T *src, T *dst, uint32_t width, uint32_t height) {
 
     const T *flipSrc = src + (width * height);
@@ -153,16 +166,22 @@ public:
     void               setConfigData(void *data, uint32_t size) override;
     const std::string &getConfigSchema() const override;
     void               reset() override;
+    bool               isInPlaceCapable() const override {
+        return true;
+    }
 
 private:
-    std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override;
+    std::shared_ptr<Frame>               process(std::shared_ptr<const Frame> frame) override;
+    bool                                 processInPlace(std::shared_ptr<Frame> frame) override;
+    bool                                 appendPixelOp(PixelOpProgram &program) override;
+    std::shared_ptr<const StreamProfile> getMirroredStreamProfile(std::shared_ptr<const StreamProfile> streamProfile);
 
     static OBCameraIntrinsic  mirrorOBCameraIntrinsic(const OBCameraIntrinsic &src);
     static OBCameraDistortion mirrorOBCameraDistortion(const OBCameraDistortion &src);
 
 protected:
     std::shared_ptr<const StreamProfile> srcStreamProfile_;
-    std::shared_ptr<VideoStreamProfile>  rstStreamProfile_;
+    std::shared_ptr<const StreamProfile> rstStreamProfile_;  // the source profile itself if its conversion failed
 };
 
 class FrameFlip : public IFilterBase {
@@ -174,16 +193,22 @@ public:
     void               setConfigData(void *data, uint32_t size) override;
     const std::string &getConfigSchema() const override;
     void               reset() override;
+    bool               isInPlaceCapable() const override {
+        return true;
+    }
 
 private:
-    std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override;
+    std::shared_ptr<Frame>               process(std::shared_ptr<const Frame> frame) override;
+    bool                                 processInPlace(std::shared_ptr<Frame> frame) override;
+    bool                                 appendPixelOp(PixelOpProgram &program) override;
+    std::shared_ptr<const StreamProfile> getFlippedStreamProfile(std::shared_ptr<const StreamProfile> streamProfile);
 
     static OBCameraIntrinsic  flipOBCameraIntrinsic(const OBCameraIntrinsic &src);
     static OBCameraDistortion flipOBCameraDistortion(const OBCameraDistortion &src);
 
 protected:
     std::shared_ptr<const StreamProfile> srcStreamProfile_;
-    std::shared_ptr<VideoStreamProfile>  rstStreamProfile_;
+    std::shared_ptr<const StreamProfile> rstStreamProfile_;  // the source profile itself if its conversion failed
 };
 
 class FrameRotate : public IFilterBase {
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "FramePixelValueProcess.hpp"
+#include "PixelOpProgram.hpp"
 #include "exception/ObException.hpp"
 #include "logger/LoggerInterval.hpp"
 #include "frame/FrameFactory.hpp"
@@ -124,6 +125,25 @@ std::shared_ptr<Frame> PixelValueScaler::process(std::shared_ptr<const Frame> fr
     return outFrame;
 }
 
+bool PixelValueScaler::processInPlace(std::shared_ptr<Frame> frame) {
+    auto depthFrame = frame->tryAs<DepthFrame>();
+    if(!depthFrame || frame->getType() != OB_FRAME_DEPTH || frame->getFormat() != OB_FORMAT_Y16) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> scaleLock(mtx_);
+    auto                        data = reinterpret_cast<uint16_t *>(frame->getDataMutable());
+    imagePixelValueScale<uint16_t>(data, data, depthFrame->getWidth(), depthFrame->getHeight(), scale_);
+    depthFrame->setValueScale(depthFrame->getValueScale() * scale_);
+    return true;
+}
+
+bool PixelValueScaler::appendPixelOp(PixelOpProgram &program) {
+    std::lock_guard<std::mutex> scaleLock(mtx_);
+    program.addScale(scale_);
+    return true;
+}
+
 ThresholdFilter::ThresholdFilter() {}
 ThresholdFilter::~ThresholdFilter() noexcept {}
 
@@ -212,6 +232,36 @@ std::shared_ptr<Frame> ThresholdFilter::process(std::shared_ptr<const Frame> fra
     return outFrame;
 }
 
+bool ThresholdFilter::processInPlace(std::shared_ptr<Frame> frame) {
+    auto depth = frame->tryAs<DepthFrame>();
+    if(!depth || (frame->getFormat() != OB_FORMAT_Y16 && frame->getFormat() != OB_FORMAT_Y8)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> cutOffLock(mtx_);
+    float                       scale = depth->getValueScale();
+    if(max_ != 65535) {
+        if(frame->getFormat() == OB_FORMAT_Y16) {
+            auto data = reinterpret_cast<uint16_t *>(frame->getDataMutable());
+            imagePixelValueThreshold(data, data, depth->getWidth(), depth->getHeight(), (uint32_t)(min_ / scale), (uint32_t)(max_ / scale));
+        }
+        else {
+            auto data = frame->getDataMutable();
+            imagePixelValueThreshold(data, data, depth->getWidth(), depth->getHeight(), (uint32_t)(min_ / scale), (uint32_t)(max_ / scale));
+        }
+    }
+    return true;
+}
+
+bool ThresholdFilter::appendPixelOp(PixelOpProgram &program) {
+    std::lock_guard<std::mutex> cutOffLock(mtx_);
+    if(max_ != 65535) {
+        float scale = program.getValueScale();
+        program.addThreshold((uint32_t)(min_ / scale), (uint32_t)(max_ / scale));
+    }
+    return true;
+}
+
 PixelValueOffset::PixelValueOffset() {}
 PixelValueOffset::~PixelValueOffset() noexcept {}
 
@@ -245,25 +295,54 @@ std::shared_ptr<Frame> PixelValueOffset::process(std::shared_ptr<const Frame> fr
     }
 
     std::lock_guard<std::mutex> offsetLock(mtx_);
-    auto                        videoFrame = frame->as<VideoFrame>();
-    auto                        outFrame   = FrameFactory::createFrameFromOtherFrame(frame);
-    if(offset_ != 0) {
-        switch(frame->getFormat()) {
-        case OB_FORMAT_Y16:
-            imagePixelValueOffset((uint16_t *)frame->getData(), (uint16_t *)outFrame->getData(), videoFrame->getWidth(), videoFrame->getHeight(), offset_);
-            break;
-        case OB_FORMAT_Y8:
-            imagePixelValueOffset((uint8_t *)frame->getData(), (uint8_t *)outFrame->getData(), videoFrame->getWidth(), videoFrame->getHeight(), offset_);
-            break;
-        default:
-            LOG_ERROR_INTVL("PixelValueOffset: unsupported format: {}", frame->getFormat());
-            break;
-        }
+    if(offset_ == 0) {
+        return FrameFactory::createFrameView(frame);
+    }
 
-        uint8_t bitSize = frame->as<VideoFrame>()->getPixelAvailableBitSize();
-        outFrame->as<VideoFrame>()->setPixelAvailableBitSize(bitSize - offset_);
+    auto videoFrame = frame->as<VideoFrame>();
+    auto outFrame   = FrameFactory::createFrameFromOtherFrame(frame);
+    switch(frame->getFormat()) {
+    case OB_FORMAT_Y16:
+        imagePixelValueOffset((uint16_t *)frame->getData(), (uint16_t *)outFrame->getData(), videoFrame->getWidth(), videoFrame->getHeight(), offset_);
+        break;
+    case OB_FORMAT_Y8:
+        imagePixelValueOffset((uint8_t *)frame->getData(), (uint8_t *)outFrame->getData(), videoFrame->getWidth(), videoFrame->getHeight(), offset_);
+        break;
+    default:
+        LOG_ERROR_INTVL("PixelValueOffset: unsupported format: {}", frame->getFormat());
+        break;
     }
+
+    uint8_t bitSize = videoFrame->getPixelAvailableBitSize();
+    outFrame->tryAs<VideoFrame>()->setPixelAvailableBitSize(bitSize - offset_);
     return outFrame;
 }
 
+bool PixelValueOffset::processInPlace(std::shared_ptr<Frame> frame) {
+    auto videoFrame = frame->tryAs<VideoFrame>();
+    if(!videoFrame || (frame->getFormat() != OB_FORMAT_Y16 && frame->getFormat() != OB_FORMAT_Y8)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> offsetLock(mtx_);
+    if(offset_ != 0) {
+        if(frame->getFormat() == OB_FORMAT_Y16) {
+            auto data = reinterpret_cast<uint16_t *>(frame->getDataMutable());
+            imagePixelValueOffset(data, data, videoFrame->getWidth(), videoFrame->getHeight(), offset_);
+        }
+        else {
+            auto data = frame->getDataMutable();
+            imagePixelValueOffset(data, data, videoFrame->getWidth(), videoFrame->getHeight(), offset_);
+        }
+        videoFrame->setPixelAvailableBitSize(videoFrame->getPixelAvailableBitSize() - offset_);
+    }
+    return true;
+}
+
+bool PixelValueOffset::appendPixelOp(PixelOpProgram &program) {
+    std::lock_guard<std::mutex> offsetLock(mtx_);
+    program.addOffset(offset_);
+    return true;
+}
+
 }  // namespace libobsensor
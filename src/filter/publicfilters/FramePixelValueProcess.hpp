@@ -16,9 +16,14 @@ public:
     void               setConfigData(void *data, uint32_t size) override;
     const std::string &getConfigSchema() const override;
     void               reset() override {}
+    bool               isInPlaceCapable() const override {
+        return true;
+    }
 
 private:
     std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override;
+    bool                   processInPlace(std::shared_ptr<Frame> frame) override;
+    bool                   appendPixelOp(PixelOpProgram &program) override;
 
 protected:
     std::mutex mtx_;
@@ -34,9 +39,14 @@ public:
     void               setConfigData(void *data, uint32_t size) override;
     const std::string &getConfigSchema() const override;
     void               reset() override {}
+    bool               isInPlaceCapable() const override {
+        return true;
+    }
 
 private:
     std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override;
+    bool                   processInPlace(std::shared_ptr<Frame> frame) override;
+    bool                   appendPixelOp(PixelOpProgram &program) override;
 
 protected:
     std::mutex mtx_;
@@ -53,9 +63,14 @@ public:
     void               setConfigData(void *data, uint32_t size) override;
     const std::string &getConfigSchema() const override;
     void               reset() override {}
+    bool               isInPlaceCapable() const override {
+        return true;
+    }
 
 private:
     std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override;
+    bool                   processInPlace(std::shared_ptr<Frame> frame) override;
+    bool                   appendPixelOp(PixelOpProgram &program) override;
 
 protected:
     std::mutex mtx_;
@@ -67,6 +67,10 @@ std::shared_ptr<Frame> IMUCorrector::process(std::shared_ptr<const Frame> frame)
     }
 
     auto newFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+    if(newFrame->getType() == OB_FRAME_IMU_BATCH) {
+        correctBatch(newFrame->as<ImuBatchFrame>());
+        return newFrame;
+    }
     if(!frame->is<FrameSet>()) {
         return newFrame;
     }
@@ -95,6 +99,30 @@ std::shared_ptr<Frame> IMUCorrector::process(std::shared_ptr<const Frame> frame)
     return newFrame;
 }
 
+void IMUCorrector::correctBatch(std::shared_ptr<ImuBatchFrame> batchFrame) {
+    auto sp     = batchFrame->getStreamProfile();
+    auto arrays = batchFrame->getArraysMutable();
+    auto count  = batchFrame->getSampleCount();
+    if(sp->getType() == OB_STREAM_ACCEL) {
+        auto intrinsic = sp->as<AccelStreamProfile>()->getIntrinsic();
+        for(uint32_t i = 0; i < count; i++) {
+            auto value  = correctAccel({ arrays.x[i], arrays.y[i], arrays.z[i] }, &intrinsic);
+            arrays.x[i] = value.x;
+            arrays.y[i] = value.y;
+            arrays.z[i] = value.z;
+        }
+    }
+    else if(sp->getType() == OB_STREAM_GYRO) {
+        auto intrinsic = sp->as<GyroStreamProfile>()->getIntrinsic();
+        for(uint32_t i = 0; i < count; i++) {
+            auto value  = correctGyro({ arrays.x[i], arrays.y[i], arrays.z[i] }, &intrinsic);
+            arrays.x[i] = value.x;
+            arrays.y[i] = value.y;
+            arrays.z[i] = value.z;
+        }
+    }
+}
+
 OBAccelValue IMUCorrector::correctAccel(const OBAccelValue &accelValue, OBAccelIntrinsic *intrinsic) {
     double M_acc[3][3];
     double bias_acc[3];
@@ -8,6 +8,7 @@
 #include "InternalTypes.hpp"
 
 namespace libobsensor {
+class ImuBatchFrame;
 
 class IMUCorrector : public IFilterBase {
 public:
@@ -27,6 +28,7 @@ public:
 
 private:
     std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override;
+    void                   correctBatch(std::shared_ptr<ImuBatchFrame> batchFrame);
 
     OBAccelValue correctAccel(const OBAccelValue &accelValue, OBAccelIntrinsic *intrinsic);
     OBGyroValue  correctGyro(const OBGyroValue &gyroValue, OBGyroIntrinsic *intrinsic);
@@ -37,6 +37,10 @@ std::shared_ptr<Frame> IMUFrameReversion::process(std::shared_ptr<const Frame> f
     }
 
     auto newFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+    if(newFrame->getType() == OB_FRAME_IMU_BATCH) {
+        reverseBatch(newFrame->as<ImuBatchFrame>());
+        return newFrame;
+    }
     if(!frame->is<FrameSet>()) {
         return newFrame;
     }
@@ -61,4 +65,14 @@ std::shared_ptr<Frame> IMUFrameReversion::process(std::shared_ptr<const Frame> f
     return newFrame;
 }
 
+void IMUFrameReversion::reverseBatch(std::shared_ptr<ImuBatchFrame> batchFrame) {
+    auto arrays = batchFrame->getArraysMutable();
+    auto count  = batchFrame->getSampleCount();
+    for(uint32_t i = 0; i < count; i++) {
+        arrays.x[i] *= -1;
+        arrays.y[i] *= -1;
+        arrays.z[i] *= -1;
+    }
+}
+
 }  // namespace libobsensor
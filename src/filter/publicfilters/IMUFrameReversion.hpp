@@ -7,6 +7,8 @@
 
 namespace libobsensor {
 
+class ImuBatchFrame;
+
 class IMUFrameReversion : public IFilterBase {
 public:
     IMUFrameReversion();
@@ -19,6 +21,7 @@ public:
 
 private:
     std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override;
+    void                   reverseBatch(std::shared_ptr<ImuBatchFrame> batchFrame);
 };
 
 }  // namespace libobsensor
@@ -9,16 +9,25 @@
 #include "libobsensor/h/ObTypes.h"
 #include "utils/CoordinateUtil.hpp"
 #include "utils/Utils.hpp"
+#include <algorithm>
 #include <cstddef>
+#include <thread>
 
 namespace libobsensor {
 
+#define POINT_CLOUD_MAX_THREADS 4
+
+static bool isHalfPlaneFormat(OBFormat format) {
+    return format == OB_FORMAT_POINT_SOA_F16 || format == OB_FORMAT_RGB_POINT_SOA_F16;
+}
+
 PointCloudFilter::PointCloudFilter()
     : pointFormat_(OB_FORMAT_POINT),
       positionDataScale_(1.0f),
       coordinateSystemType_(OB_RIGHT_HAND_COORDINATE_SYSTEM),
       isColorDataNormalization_(false),
       isOutputZeroPoint_(true),
+      threadCount_(std::max(1u, std::min(std::thread::hardware_concurrency(), static_cast<uint32_t>(POINT_CLOUD_MAX_THREADS)))),
       depthTablesDataSize_(0),
       depthTablesData_(nullptr),
       rgbdTablesDataSize_(0),
@@ -76,8 +85,8 @@ void PointCloudFilter::updateConfig(std::vector<std::string> &params) {
     }
     try {
         OBFormat type = (OBFormat)std::stoi(params[0]);
-        if(type != OB_FORMAT_POINT && type != OB_FORMAT_RGB_POINT) {
-            LOG_ERROR("Invalid type, the pointType must be OB_FORMAT_POINT or OB_FORMAT_RGB_POINT");
+        if(type != OB_FORMAT_POINT && type != OB_FORMAT_RGB_POINT && !isHalfPlaneFormat(type)) {
+            LOG_ERROR("Invalid type, the pointType must be OB_FORMAT_POINT, OB_FORMAT_RGB_POINT, OB_FORMAT_POINT_SOA_F16 or OB_FORMAT_RGB_POINT_SOA_F16");
         }
         else {
             pointFormat_ = type;
@@ -122,7 +131,8 @@ void PointCloudFilter::setConfigData(void *data, uint32_t size) {
 
 const std::string &PointCloudFilter::getConfigSchema() const {
     // csv format: name, type,  min, max, step, default, description
-    static const std::string schema = "pointFormat, integer, 19, 20, 1, 19, create point type: 19 is OB_FORMAT_POINT; 20 is OB_FORMAT_RGB_POINT\n"
+    static const std::string schema = "pointFormat, integer, 19, 40, 1, 19, create point type: 19 is OB_FORMAT_POINT; 20 is OB_FORMAT_RGB_POINT; "
+                                      "39 is OB_FORMAT_POINT_SOA_F16; 40 is OB_FORMAT_RGB_POINT_SOA_F16\n"
                                       "coordinateDataScale, float, 0.00000001, 100, 0.00001, 1.0, coordinate data scale\n"
                                       "colorDataNormalization, integer, 0, 1, 1, 0, color data normal state\n"
                                       "coordinateSystemType, integer, 0, 1, 1, 1, Coordinate system representation type: 0 is left hand; 1 is right hand\n"
@@ -160,14 +170,13 @@ std::shared_ptr<Frame> PointCloudFilter::createDepthPointCloud(std::shared_ptr<c
     auto depthVideoStreamProfile = depthVideoFrame->getStreamProfile()->as<VideoStreamProfile>();
     auto depthWidth              = depthVideoFrame->getWidth();
     auto depthHeight             = depthVideoFrame->getHeight();
-    auto pointDataSize           = depthWidth * depthHeight * sizeof(OBPoint);
 
-    auto pointFrame = FrameFactory::createFrame(OB_FRAME_POINTS, OB_FORMAT_POINT, pointDataSize);
+    void *pointData  = nullptr;
+    auto  pointFrame = createPointsFrame(pointFormat_, depthWidth * depthHeight, 3, &pointData);
     if(pointFrame == nullptr) {
         LOG_ERROR_INTVL("Acquire point cloud frame failed!");
         return nullptr;
     }
-    memset((void *)pointFrame->getData(), 0, pointFrame->getDataSize());
 
     // Create xytables
     OBCameraIntrinsic depthIntrinsic = depthVideoStreamProfile->getIntrinsic();
@@ -193,16 +202,12 @@ std::shared_ptr<Frame> PointCloudFilter::createDepthPointCloud(std::shared_ptr<c
     pointFrame->as<PointsFrame>()->setHeight(height);
 
     uint32_t validPointCount = 0;
-    CoordinateUtil::transformationDepthToPointCloud(&depthXyTables_, depthFrame->getData(), (void *)pointFrame->getData(), isOutputZeroPoint_, &validPointCount,
-                                                    positionDataScale_, coordinateSystemType_, depthFrame->getFormat() == OB_FORMAT_Y12C4, decimationFactor_,
-                                                    width);
+    size_t   halfPlaneStride = getHalfPlaneStride(pointFrame, 3, width * height);
+    CoordinateUtil::transformationDepthToPointCloud(&depthXyTables_, depthFrame->getData(), pointData, isOutputZeroPoint_, &validPointCount, positionDataScale_,
+                                                    coordinateSystemType_, depthFrame->getFormat() == OB_FORMAT_Y12C4, decimationFactor_, width,
+                                                    getWorkerPool(depthWidth * depthHeight / (decimationFactor_ * decimationFactor_)), halfPlaneStride);
 
-    if(!isOutputZeroPoint_) {
-        pointFrame->setDataSize(validPointCount * sizeof(OBPoint));
-    }
-    else {
-        pointFrame->setDataSize(width * height * sizeof(OBPoint));
-    }
+    finishPointsFrame(pointFrame, isOutputZeroPoint_ ? width * height : validPointCount, 3, halfPlaneStride);
     float depthValueScale = depthFrame->as<DepthFrame>()->getValueScale();
     pointFrame->copyInfoFromOther(depthFrame);
     // Actual coordinate scaling = Depth scaling factor / Set coordinate scaling factor.
@@ -240,12 +245,12 @@ std::shared_ptr<Frame> PointCloudFilter::createRGBDPointCloud(std::shared_ptr<co
     OBCameraDistortion dstDistortion         = dstVideoStreamProfile->getDistortion();
 
     // Create an RGBD point cloud frame
-    auto pointFrame = FrameFactory::createFrame(OB_FRAME_POINTS, OB_FORMAT_RGB_POINT, dstWidth * dstHeight * sizeof(OBColorPoint));
+    void *pointData  = nullptr;
+    auto  pointFrame = createPointsFrame(pointFormat_, dstWidth * dstHeight, 6, &pointData);
     if(pointFrame == nullptr) {
         LOG_WARN_INTVL("Acquire point cloud frame failed!");
         return nullptr;
     }
-    memset((void *)pointFrame->getData(), 0, pointFrame->getDataSize());
 
     // decode rgb frame
     if(formatConverter_ == nullptr) {
@@ -363,24 +368,22 @@ std::shared_ptr<Frame> PointCloudFilter::createRGBDPointCloud(std::shared_ptr<co
     pointFrame->as<PointsFrame>()->setHeight(height);
 
     uint32_t validPointCount = 0;
+    size_t   halfPlaneStride = getHalfPlaneStride(pointFrame, 6, width * height);
+    auto     workerPool      = getWorkerPool(dstWidth * dstHeight / (decimationFactor_ * decimationFactor_));
     if(distortionType == OBPointCloudDistortionType::OB_POINT_CLOUD_ADD_DISTORTION_TYPE) {
-        CoordinateUtil::transformationDepthToRGBDPointCloudByUVTables(
-            dstIntrinsic, &rgbdXyTables_, depthFrame->getData(), colorData, (void *)pointFrame->getData(), isOutputZeroPoint_, &validPointCount,
-            positionDataScale_, coordinateSystemType_, isColorDataNormalization_, depthFrame->getFormat() == OB_FORMAT_Y12C4, decimationFactor_, width);
+        CoordinateUtil::transformationDepthToRGBDPointCloudByUVTables(dstIntrinsic, &rgbdXyTables_, depthFrame->getData(), colorData, pointData, isOutputZeroPoint_,
+                                                                      &validPointCount, positionDataScale_, coordinateSystemType_, isColorDataNormalization_,
+                                                                      depthFrame->getFormat() == OB_FORMAT_Y12C4, decimationFactor_, width, workerPool,
+                                                                      halfPlaneStride);
     }
     else {
-        CoordinateUtil::transformationDepthToRGBDPointCloud(&rgbdXyTables_, depthFrame->getData(), colorData, (void *)pointFrame->getData(), isOutputZeroPoint_,
-                                                            &validPointCount, positionDataScale_, coordinateSystemType_, isColorDataNormalization_,
-                                                            colorVideoFrame->getWidth(), colorVideoFrame->getHeight(),
-                                                            depthFrame->getFormat() == OB_FORMAT_Y12C4, decimationFactor_, width);
+        CoordinateUtil::transformationDepthToRGBDPointCloud(&rgbdXyTables_, depthFrame->getData(), colorData, pointData, isOutputZeroPoint_, &validPointCount,
+                                                            positionDataScale_, coordinateSystemType_, isColorDataNormalization_, colorVideoFrame->getWidth(),
+                                                            colorVideoFrame->getHeight(), depthFrame->getFormat() == OB_FORMAT_Y12C4, decimationFactor_, width,
+                                                            workerPool, halfPlaneStride);
     }
 
-    if(!isOutputZeroPoint_) {
-        pointFrame->setDataSize(validPointCount * sizeof(OBColorPoint));
-    }
-    else {
-        pointFrame->setDataSize(width * height * sizeof(OBColorPoint));
-    }
+    finishPointsFrame(pointFrame, isOutputZeroPoint_ ? width * height : validPointCount, 6, halfPlaneStride);
     float depthValueScale = depthVideoFrame->as<DepthFrame>()->getValueScale();
     pointFrame->copyInfoFromOther(depthFrame);
     // Actual coordinate scaling = Depth scaling factor / Set coordinate scaling factor.
@@ -395,7 +398,7 @@ std::shared_ptr<Frame> PointCloudFilter::process(std::shared_ptr<const Frame> fr
     }
 
     std::shared_ptr<Frame> pointsFrame = nullptr;
-    if(pointFormat_ == OB_FORMAT_POINT) {
+    if(pointFormat_ == OB_FORMAT_POINT || pointFormat_ == OB_FORMAT_POINT_SOA_F16) {
         pointsFrame = createDepthPointCloud(frame);
     }
     else {
@@ -404,6 +407,51 @@ std::shared_ptr<Frame> PointCloudFilter::process(std::shared_ptr<const Frame> fr
     return pointsFrame;
 }
 
+utils::WorkerPool *PointCloudFilter::getWorkerPool(uint32_t pixelCount) {
+    if(pixelCount < POINT_CLOUD_PARALLEL_MIN_PIXELS || threadCount_ <= 1) {
+        return nullptr;
+    }
+    if(!workerPool_) {
+        workerPool_.reset(new utils::WorkerPool(threadCount_));
+    }
+    return workerPool_.get();
+}
+
+// The points are computed straight into the frame: interleaved floats, or planes of half floats for the half float plane formats
+std::shared_ptr<Frame> PointCloudFilter::createPointsFrame(OBFormat format, uint32_t pointCount, uint32_t pointFloats, void **pointData) {
+    size_t valueSize  = isHalfPlaneFormat(format) ? sizeof(uint16_t) : sizeof(float);
+    auto   pointFrame = FrameFactory::createFrame(OB_FRAME_POINTS, format, static_cast<size_t>(pointCount) * pointFloats * valueSize);
+    if(pointFrame) {
+        memset((void *)pointFrame->getData(), 0, pointFrame->getDataSize());
+        *pointData = (void *)pointFrame->getData();
+    }
+    return pointFrame;
+}
+
+// Distance of the half float planes while the points are computed (0 for the float formats): the final point count if all the points are
+// output, the capacity of the frame otherwise, finishPointsFrame() moves the planes together once the number of valid points is known
+size_t PointCloudFilter::getHalfPlaneStride(std::shared_ptr<Frame> pointFrame, uint32_t pointFloats, uint32_t outputPointCount) const {
+    if(!isHalfPlaneFormat(pointFrame->getFormat())) {
+        return 0;
+    }
+    size_t capacity = pointFrame->getDataSize() / (pointFloats * sizeof(uint16_t));
+    return isOutputZeroPoint_ ? std::min<size_t>(outputPointCount, capacity) : capacity;
+}
+
+void PointCloudFilter::finishPointsFrame(std::shared_ptr<Frame> pointFrame, uint32_t pointCount, uint32_t pointFloats, size_t halfPlaneStride) {
+    if(halfPlaneStride == 0) {
+        pointFrame->setDataSize(static_cast<size_t>(pointCount) * pointFloats * sizeof(float));
+        return;
+    }
+
+    pointCount      = static_cast<uint32_t>(std::min<size_t>(pointCount, halfPlaneStride));
+    uint16_t *plane = (uint16_t *)pointFrame->getData();
+    for(uint32_t c = 1; c < pointFloats && pointCount != halfPlaneStride; c++) {
+        memmove(plane + static_cast<size_t>(c) * pointCount, plane + c * halfPlaneStride, static_cast<size_t>(pointCount) * sizeof(uint16_t));
+    }
+    pointFrame->setDataSize(static_cast<size_t>(pointCount) * pointFloats * sizeof(uint16_t));
+}
+
 PointCloudFilter::OBPointCloudDistortionType PointCloudFilter::getDistortionType(OBCameraDistortion colorDistortion, OBCameraDistortion depthDistortion) {
     OBPointCloudDistortionType type;
     OBCameraDistortion         zeroDistortion;
@@ -5,8 +5,11 @@
 #include "IFilter.hpp"
 #include "FormatConverterProcess.hpp"
 #include "stream/StreamProfile.hpp"
+#include "utils/WorkerPool.hpp"
 #include <mutex>
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace libobsensor {
 
@@ -47,6 +50,11 @@ private:
 
     void updateOutputProfile(const std::shared_ptr<const Frame> frame);
 
+    utils::WorkerPool     *getWorkerPool(uint32_t pixelCount);
+    std::shared_ptr<Frame> createPointsFrame(OBFormat format, uint32_t pointCount, uint32_t pointFloats, void **pointData);
+    size_t                 getHalfPlaneStride(std::shared_ptr<Frame> pointFrame, uint32_t pointFloats, uint32_t outputPointCount) const;
+    void                   finishPointsFrame(std::shared_ptr<Frame> pointFrame, uint32_t pointCount, uint32_t pointFloats, size_t halfPlaneStride);
+
 protected:
     OBFormat               pointFormat_;
     float                  positionDataScale_;
@@ -56,6 +64,9 @@ protected:
 
     std::shared_ptr<FormatConverter> formatConverter_;
 
+    uint32_t                           threadCount_;
+    std::unique_ptr<utils::WorkerPool> workerPool_;  // created on the first large frame
+
     // data for depth
     OBCameraIntrinsic      depthDstIntrinsic_{};
     uint32_t               depthTablesDataSize_;
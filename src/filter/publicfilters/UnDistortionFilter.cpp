@@ -303,7 +303,7 @@ std::shared_ptr<Frame> UnDistortionFilter::process(std::shared_ptr<const Frame>
     }
 
     // Unrecognised frame type - pass through
-    return FrameFactory::createFrameFromOtherFrame(frame, true);
+    return FrameFactory::createFrameView(frame);
 }
 
 }  // namespace libobsensor
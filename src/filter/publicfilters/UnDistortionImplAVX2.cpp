@@ -0,0 +1,138 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Built with AVX2 enabled and only called after a runtime check of the CPU (utils::getSimdLevel()). Nothing inline or templated from the
+// C++ headers is used here, so no AVX2 copy of a shared function can be picked by the linker for the code running on older CPUs.
+
+#include "UnDistortionImplAVX2.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace libobsensor {
+
+#if defined(__AVX2__)
+
+// 5-bit fractions, the weights of the 4 neighbours sum up to 1024 (UnDistortionImplGeneric::INTER_BITS)
+#define REMAP_INTER_BITS 5
+#define REMAP_INTER_TAB (1 << REMAP_INTER_BITS)
+
+int remapRowBilinearAVX2(const uint8_t *src, uint8_t *dst, const int16_t *mapX, const int16_t *mapY, const uint16_t *mapAlpha, int count, int srcW, int srcH,
+                         int ch) {
+    if(ch != 1 && ch != 4) {
+        return 0;
+    }
+
+    const __m256i zero  = _mm256_setzero_si256();
+    const __m256i one   = _mm256_set1_epi32(1);
+    const __m256i cTab  = _mm256_set1_epi32(REMAP_INTER_TAB);
+    const __m256i cMask = _mm256_set1_epi32(REMAP_INTER_TAB - 1);
+    const __m256i c512  = _mm256_set1_epi32(REMAP_INTER_TAB * REMAP_INTER_TAB / 2);
+    const __m256i maxX  = _mm256_set1_epi32(srcW - 1);
+    const __m256i maxY  = _mm256_set1_epi32(srcH - 1);
+    const __m256i width = _mm256_set1_epi32(srcW);
+
+    int n = 0;
+    for(; n + 8 <= count; n += 8) {
+        __m256i x0 = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(mapX + n)));
+        __m256i y0 = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(mapY + n)));
+        __m256i a  = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(mapAlpha + n)));
+        __m256i fx = _mm256_and_si256(a, cMask);
+        __m256i fy = _mm256_srli_epi32(a, REMAP_INTER_BITS);
+
+        __m256i x1   = _mm256_min_epi32(_mm256_add_epi32(x0, one), maxX);
+        __m256i y1   = _mm256_min_epi32(_mm256_add_epi32(y0, one), maxY);
+        __m256i row0 = _mm256_mullo_epi32(y0, width);
+        __m256i row1 = _mm256_mullo_epi32(y1, width);
+        __m256i i00  = _mm256_add_epi32(row0, x0);
+        __m256i i10  = _mm256_add_epi32(row0, x1);
+        __m256i i01  = _mm256_add_epi32(row1, x0);
+        __m256i i11  = _mm256_add_epi32(row1, x1);
+
+        if(ch == 4) {
+            // Gather the 4 neighbours of 8 pixels, 4 channels in each 32-bit lane
+            const int *base = reinterpret_cast<const int *>(src);
+            __m256i    p00  = _mm256_i32gather_epi32(base, i00, 4);
+            __m256i    p10  = _mm256_i32gather_epi32(base, i10, 4);
+            __m256i    p01  = _mm256_i32gather_epi32(base, i01, 4);
+            __m256i    p11  = _mm256_i32gather_epi32(base, i11, 4);
+
+            // Horizontal step as in the SSE kernel: maddubs of the interleaved left/right bytes with the (32 - fx, fx) byte pairs
+            __m256i wh16 = _mm256_or_si256(_mm256_sub_epi32(cTab, fx), _mm256_slli_epi32(fx, 8));
+            __m256i wh   = _mm256_or_si256(wh16, _mm256_slli_epi32(wh16, 16));
+            __m256i whLo = _mm256_unpacklo_epi32(wh, wh);  // pixels 0, 1 | 4, 5
+            __m256i whHi = _mm256_unpackhi_epi32(wh, wh);  // pixels 2, 3 | 6, 7
+
+            __m256i topLo = _mm256_maddubs_epi16(_mm256_unpacklo_epi8(p00, p10), whLo);
+            __m256i topHi = _mm256_maddubs_epi16(_mm256_unpackhi_epi8(p00, p10), whHi);
+            __m256i botLo = _mm256_maddubs_epi16(_mm256_unpacklo_epi8(p01, p11), whLo);
+            __m256i botHi = _mm256_maddubs_epi16(_mm256_unpackhi_epi8(p01, p11), whHi);
+
+            // Vertical step: madd of the interleaved top/bottom sums with the (32 - fy, fy) word pairs of each pixel
+            __m256i wv = _mm256_or_si256(_mm256_sub_epi32(cTab, fy), _mm256_slli_epi32(fy, 16));
+            __m256i s0 = _mm256_madd_epi16(_mm256_unpacklo_epi16(topLo, botLo), _mm256_shuffle_epi32(wv, 0x00));  // pixel 0 | 4
+            __m256i s1 = _mm256_madd_epi16(_mm256_unpackhi_epi16(topLo, botLo), _mm256_shuffle_epi32(wv, 0x55));  // pixel 1 | 5
+            __m256i s2 = _mm256_madd_epi16(_mm256_unpacklo_epi16(topHi, botHi), _mm256_shuffle_epi32(wv, 0xAA));  // pixel 2 | 6
+            __m256i s3 = _mm256_madd_epi16(_mm256_unpackhi_epi16(topHi, botHi), _mm256_shuffle_epi32(wv, 0xFF));  // pixel 3 | 7
+            s0         = _mm256_srli_epi32(_mm256_add_epi32(s0, c512), 10);
+            s1         = _mm256_srli_epi32(_mm256_add_epi32(s1, c512), 10);
+            s2         = _mm256_srli_epi32(_mm256_add_epi32(s2, c512), 10);
+            s3         = _mm256_srli_epi32(_mm256_add_epi32(s3, c512), 10);
+
+            // The packs work per 128-bit lane, which puts pixels 0-3 in the low lane and 4-7 in the high lane
+            __m256i out = _mm256_packus_epi16(_mm256_packs_epi32(s0, s1), _mm256_packs_epi32(s2, s3));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + n * 4), out);
+        }
+        else {
+            // A 32-bit gather of single bytes could read past the end of the image, the neighbours are loaded one by one
+            alignas(32) int32_t idx[4][8];
+            alignas(32) int32_t val[4][8];
+            _mm256_store_si256(reinterpret_cast<__m256i *>(idx[0]), i00);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(idx[1]), i10);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(idx[2]), i01);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(idx[3]), i11);
+            for(int k = 0; k < 8; k++) {
+                val[0][k] = src[idx[0][k]];
+                val[1][k] = src[idx[1][k]];
+                val[2][k] = src[idx[2][k]];
+                val[3][k] = src[idx[3][k]];
+            }
+
+            __m256i fxi = _mm256_sub_epi32(cTab, fx);
+            __m256i fyi = _mm256_sub_epi32(cTab, fy);
+            __m256i sum = _mm256_add_epi32(
+                _mm256_add_epi32(_mm256_mullo_epi32(_mm256_mullo_epi32(fxi, fyi), _mm256_load_si256(reinterpret_cast<const __m256i *>(val[0]))),
+                                 _mm256_mullo_epi32(_mm256_mullo_epi32(fx, fyi), _mm256_load_si256(reinterpret_cast<const __m256i *>(val[1])))),
+                _mm256_add_epi32(_mm256_mullo_epi32(_mm256_mullo_epi32(fxi, fy), _mm256_load_si256(reinterpret_cast<const __m256i *>(val[2]))),
+                                 _mm256_mullo_epi32(_mm256_mullo_epi32(fx, fy), _mm256_load_si256(reinterpret_cast<const __m256i *>(val[3])))));
+            sum = _mm256_srli_epi32(_mm256_add_epi32(sum, c512), 10);
+
+            // pixels 0-3 in the low 4 bytes of the low lane, 4-7 in the low 4 bytes of the high lane
+            __m256i packed                             = _mm256_packus_epi16(_mm256_packs_epi32(sum, zero), zero);
+            *reinterpret_cast<uint32_t *>(dst + n)     = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm256_castsi256_si128(packed)));
+            *reinterpret_cast<uint32_t *>(dst + n + 4) = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm256_extracti128_si256(packed, 1)));
+        }
+    }
+    return n;
+}
+
+#else
+
+int remapRowBilinearAVX2(const uint8_t *src, uint8_t *dst, const int16_t *mapX, const int16_t *mapY, const uint16_t *mapAlpha, int count, int srcW, int srcH,
+                         int ch) {
+    (void)src;
+    (void)dst;
+    (void)mapX;
+    (void)mapY;
+    (void)mapAlpha;
+    (void)count;
+    (void)srcW;
+    (void)srcH;
+    (void)ch;
+    return 0;
+}
+
+#endif  // __AVX2__
+
+}  // namespace libobsensor
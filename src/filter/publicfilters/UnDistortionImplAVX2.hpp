@@ -0,0 +1,28 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <stdint.h>
+
+namespace libobsensor {
+
+/**
+ * @brief 8-wide AVX2 bilinear remap of one output row, same LUT and fixed-point weights as UnDistortionImplGeneric::remapNChannelBilinear
+ * @brief Only whole groups of 8 pixels are remapped, the caller finishes the row.
+ *
+ * @param[in] src source image
+ * @param[out] dst first output pixel of the row
+ * @param[in] mapX LUT entries of the first output pixel (UnDistortionImplGeneric::mapXi_ etc.)
+ * @param[in] mapY LUT entries of the first output pixel
+ * @param[in] mapAlpha LUT entries of the first output pixel
+ * @param[in] count number of pixels left in the row
+ * @param[in] srcW width of the source image
+ * @param[in] srcH height of the source image
+ * @param[in] ch channels, 1 or 4; other channel counts are not handled
+ *
+ * @return number of pixels remapped, 0 if the library is built without the AVX2 kernels
+ */
+int remapRowBilinearAVX2(const uint8_t *src, uint8_t *dst, const int16_t *mapX, const int16_t *mapY, const uint16_t *mapAlpha, int count, int srcW, int srcH,
+                         int ch);
+
+}  // namespace libobsensor
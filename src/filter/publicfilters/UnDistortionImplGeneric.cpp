@@ -10,6 +10,8 @@
 
 #if defined(__ARM_NEON__) || defined(__NEON__) || defined(__SSSE3__) || (defined(_MSC_VER) && (defined(_M_AMD64) || defined(_M_X64)))
 #include "UnDistortionImplSSE.hpp"
+#include "UnDistortionImplAVX2.hpp"
+#include "utils/CpuFeatures.hpp"
 #endif
 
 namespace libobsensor {
@@ -472,6 +474,9 @@ void UnDistortionImplSSE::remapNChannelBilinear(const uint8_t *src, uint8_t *dst
     const int srcW = srcW_;
     const int srcH = srcH_;
 
+    // 1 and 4 channels have an 8-wide AVX2 kernel, it leaves the last pixels of each row to the SSE loop below
+    const bool useAVX2 = (ch == 1 || ch == 4) && utils::getSimdLevel() >= utils::SIMD_LEVEL_AVX2;
+
     // Process rows [vBegin, vEnd) on the calling thread.
     // Uses std::async so idle threads truly sleep (no OMP spin-wait overhead).
     auto processRows = [&](int vBegin, int vEnd) {
@@ -485,6 +490,10 @@ void UnDistortionImplSSE::remapNChannelBilinear(const uint8_t *src, uint8_t *dst
             const int row_end   = row_start + w;
             int       idx       = row_start;
 
+            if(useAVX2) {
+                idx += remapRowBilinearAVX2(src, dst + idx * ch, &mapXi_[idx], &mapYi_[idx], &mapAlpha_[idx], w, srcW, srcH, ch);
+            }
+
             for(; idx <= row_end - 4; idx += 4) {
                 // Software prefetch for source pixels ahead
                 if(idx + PF + 4 <= row_end) {
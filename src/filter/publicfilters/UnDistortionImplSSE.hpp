@@ -25,7 +25,8 @@ namespace libobsensor {
  * Inherits LUT build and all format dispatch from UnDistortionImplGeneric.
  * Overrides remapNChannelBilinear to process 4 output pixels per iteration
  * using SSE2/SSE4.1 integer intrinsics for weight computation and
- * weighted-sum reduction.
+ * weighted-sum reduction. On CPUs with AVX2, 1 and 4 channel rows run
+ * 8 pixels per iteration (remapRowBilinearAVX2).
  */
 class UnDistortionImplSSE : public UnDistortionImplGeneric {
 public:
@@ -7,6 +7,7 @@
 #include "exception/ObException.hpp"
 #include "firmwareupdater/FirmwareUpdater.hpp"
 #include "shared/utils/Utils.hpp"
+#include "shared/utils/WorkerPool.hpp"
 
 #include "IDeviceManager.hpp"
 #include "devicemanager/DeviceManager.hpp"
@@ -339,6 +340,48 @@ ob_device *ob_device_list_get_device_by_uid_ex(const ob_device_list *list, const
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, list, uid, accessMode)
 
+uint32_t ob_device_list_get_devices(const ob_device_list *list, const uint32_t *indices, uint32_t count, ob_device_access_mode accessMode,
+                                    uint32_t max_parallel, ob_device **devices, ob_error **device_errors, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(list);
+    VALIDATE_NOT_NULL(indices);
+    VALIDATE_NOT_NULL(devices);
+    VALIDATE_NOT_EQUAL(accessMode, OB_DEVICE_ACCESS_DENIED);
+    for(uint32_t i = 0; i < count; i++) {
+        VALIDATE_UNSIGNED_INDEX(indices[i], list->list.size());
+        VALIDATE_NOT_NULL(list->list[indices[i]]->getDeviceManager());
+    }
+    if(count == 0) {
+        return 0;
+    }
+
+    // The devices are initialized by the threads of the pool (the calling thread is one of them), each thread takes the next device of the list.
+    // The device manager creates different devices in parallel, and makes the threads creating the same device wait for the first one.
+    uint32_t                       threadCount = (max_parallel == 0 || max_parallel > count) ? count : max_parallel;
+    libobsensor::utils::WorkerPool workerPool(threadCount);
+    std::atomic<uint32_t>          createdCount(0);
+    workerPool.run(count, [&](uint32_t i) {
+        devices[i] = nullptr;
+        if(device_errors) {
+            device_errors[i] = nullptr;
+        }
+        try {
+            auto &info   = list->list[indices[i]];
+            auto  device = info->getDeviceManager()->createDevice(info, accessMode);
+            auto  impl   = new ob_device();
+            impl->device = device;
+            devices[i]   = impl;
+            createdCount++;
+        }
+        catch(...) {
+            std::ostringstream ss;
+            libobsensor::utils::string::ArgsToStream(ss, "index, accessMode", indices[i], accessMode);
+            translate_exception("ob_device_list_get_devices", ss.str(), device_errors ? &device_errors[i] : nullptr);
+        }
+    });
+    return createdCount;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, list, indices, count, accessMode, max_parallel)
+
 void ob_delete_device(ob_device *device, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(device);
     delete device;
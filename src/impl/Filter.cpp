@@ -7,6 +7,7 @@
 #include "FilterFactory.hpp"
 #include "publicfilters/Align.hpp"
 #include "FilterDecorator.hpp"
+#include "FilterChain.hpp"
 #include "IDevice.hpp"
 
 #include "libobsensor/hpp/Filter.hpp"
@@ -158,6 +159,27 @@ ob_frame *ob_filter_process(ob_filter *filter, const ob_frame *frame, ob_error *
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, filter, frame)
 
+ob_frame *ob_filter_chain_process(ob_filter **filters, uint32_t filter_count, const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(frame);
+    if(filter_count > 0) {
+        VALIDATE_NOT_NULL(filters);
+    }
+    std::vector<std::shared_ptr<libobsensor::IFilter>> filterList;
+    filterList.reserve(filter_count);
+    for(uint32_t i = 0; i < filter_count; i++) {
+        VALIDATE_NOT_NULL(filters[i]);
+        filterList.push_back(filters[i]->filter);
+    }
+    auto result = libobsensor::FilterChain::process(filterList, frame->frame);
+    if(result == nullptr) {
+        return nullptr;
+    }
+    auto frameImpl   = new ob_frame();
+    frameImpl->frame = result;
+    return frameImpl;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, filters, filter_count, frame)
+
 void ob_filter_set_callback(ob_filter *filter, ob_filter_callback callback, void *user_data, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(filter);
     filter->filter->setCallback([callback, user_data](std::shared_ptr<libobsensor::Frame> frame) {
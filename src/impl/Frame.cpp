@@ -106,8 +106,8 @@ HANDLE_EXCEPTIONS_NO_RETURN(frame)
 void ob_delete_frame(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frame);
     auto unConstFrame = const_cast<ob_frame *>(frame);
-    if(unConstFrame->refCnt > 1) {
-        unConstFrame->refCnt -= 1;
+    // The last reference deletes the handle, checking and decrementing separately could let two threads both see the count above 1
+    if(unConstFrame->refCnt.fetch_sub(1, std::memory_order_acq_rel) > 1) {
         return;
     }
     delete frame;
@@ -129,19 +129,21 @@ HANDLE_EXCEPTIONS_AND_RETURN(uint64_t(0), frame)
 
 uint32_t ob_video_frame_get_width(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frame);
-    if(!frame->frame->is<libobsensor::VideoFrame>()) {
+    auto videoFrame = frame->frame->tryAs<libobsensor::VideoFrame>();
+    if(!videoFrame) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a video frame!");
     }
-    return frame->frame->as<libobsensor::VideoFrame>()->getWidth();
+    return videoFrame->getWidth();
 }
 HANDLE_EXCEPTIONS_AND_RETURN(uint32_t(0), frame)
 
 uint32_t ob_video_frame_get_height(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frame);
-    if(!frame->frame->is<libobsensor::VideoFrame>()) {
+    auto videoFrame = frame->frame->tryAs<libobsensor::VideoFrame>();
+    if(!videoFrame) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a video frame!");
     }
-    return frame->frame->as<libobsensor::VideoFrame>()->getHeight();
+    return videoFrame->getHeight();
 }
 HANDLE_EXCEPTIONS_AND_RETURN(uint32_t(0), frame)
 
@@ -269,6 +271,13 @@ int64_t ob_frame_get_metadata_value(const ob_frame *frame, ob_frame_metadata_typ
 }
 HANDLE_EXCEPTIONS_AND_RETURN(-1, frame)
 
+uint64_t ob_frame_get_all_metadata_value(const ob_frame *frame, int64_t *values, uint32_t count, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_NOT_NULL(values);
+    return frame->frame->getAllMetadataValue(values, count);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(uint64_t(0), frame, values, count)
+
 ob_stream_profile *ob_frame_get_stream_profile(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frame);
     auto innerProfile = frame->frame->getStreamProfile();
@@ -410,55 +419,71 @@ HANDLE_EXCEPTIONS_AND_RETURN(OB_SENSOR_UNKNOWN, frame)
 
 ob_accel_value ob_accel_frame_get_value(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frame);
-    if(!frame->frame->is<libobsensor::AccelFrame>()) {
+    auto accelFrame = frame->frame->tryAs<libobsensor::AccelFrame>();
+    if(!accelFrame) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a accel frame!");
     }
-    return frame->frame->as<libobsensor::AccelFrame>()->value();
+    return accelFrame->value();
 }
 HANDLE_EXCEPTIONS_AND_RETURN(ob_accel_value(), frame)
 
 float ob_accel_frame_get_temperature(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frame);
-    if(!frame->frame->is<libobsensor::AccelFrame>()) {
+    auto accelFrame = frame->frame->tryAs<libobsensor::AccelFrame>();
+    if(!accelFrame) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a accel frame!");
     }
-    return frame->frame->as<libobsensor::AccelFrame>()->temperature();
+    return accelFrame->temperature();
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0.0f, frame)
 
 ob_gyro_value ob_gyro_frame_get_value(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frame);
-    if(!frame->frame->is<libobsensor::GyroFrame>()) {
+    auto gyroFrame = frame->frame->tryAs<libobsensor::GyroFrame>();
+    if(!gyroFrame) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a gyro frame!");
     }
-    return frame->frame->as<libobsensor::GyroFrame>()->value();
+    return gyroFrame->value();
 }
 HANDLE_EXCEPTIONS_AND_RETURN(ob_gyro_value(), frame)
 
 float ob_gyro_frame_get_temperature(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frame);
-    if(!frame->frame->is<libobsensor::GyroFrame>()) {
+    auto gyroFrame = frame->frame->tryAs<libobsensor::GyroFrame>();
+    if(!gyroFrame) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a gyro frame!");
     }
-    return frame->frame->as<libobsensor::GyroFrame>()->temperature();
+    return gyroFrame->temperature();
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0.0f, frame)
 
+ob_imu_batch_data ob_imu_batch_frame_get_data(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(frame);
+    auto batchFrame = frame->frame->tryAs<libobsensor::ImuBatchFrame>();
+    if(!batchFrame) {
+        THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not an imu batch frame!");
+    }
+    return batchFrame->getBatchData();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(ob_imu_batch_data(), frame)
+
 uint32_t ob_frameset_get_count(const ob_frame *frameset, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frameset);
-    if(!frameset->frame->is<libobsensor::FrameSet>()) {
+    auto innerFrameSet = frameset->frame->tryAs<libobsensor::FrameSet>();
+    if(!innerFrameSet) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a frameset!");
     }
-    return frameset->frame->as<libobsensor::FrameSet>()->getCount();
+    return innerFrameSet->getCount();
 }
 HANDLE_EXCEPTIONS_AND_RETURN(uint32_t(0), frameset)
 
 ob_frame *ob_frameset_get_depth_frame(const ob_frame *frameset, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frameset);
-    if(!frameset->frame->is<libobsensor::FrameSet>()) {
+    auto innerFrameSet = frameset->frame->tryAs<libobsensor::FrameSet>();
+    if(!innerFrameSet) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a frameset!");
     }
-    auto innerFrame = frameset->frame->as<libobsensor::FrameSet>()->getFrame(OB_FRAME_DEPTH);
+    auto innerFrame = innerFrameSet->getFrame(OB_FRAME_DEPTH);
     if(innerFrame == nullptr) {
         return nullptr;
     }
@@ -470,10 +495,11 @@ HANDLE_EXCEPTIONS_AND_RETURN(nullptr, frameset)
 
 ob_frame *ob_frameset_get_color_frame(const ob_frame *frameset, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frameset);
-    if(!frameset->frame->is<libobsensor::FrameSet>()) {
+    auto innerFrameSet = frameset->frame->tryAs<libobsensor::FrameSet>();
+    if(!innerFrameSet) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a frameset!");
     }
-    auto innerFrame = frameset->frame->as<libobsensor::FrameSet>()->getFrame(OB_FRAME_COLOR);
+    auto innerFrame = innerFrameSet->getFrame(OB_FRAME_COLOR);
     if(innerFrame == nullptr) {
         return nullptr;
     }
@@ -485,10 +511,11 @@ HANDLE_EXCEPTIONS_AND_RETURN(nullptr, frameset)
 
 ob_frame *ob_frameset_get_ir_frame(const ob_frame *frameset, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frameset);
-    if(!frameset->frame->is<libobsensor::FrameSet>()) {
+    auto innerFrameSet = frameset->frame->tryAs<libobsensor::FrameSet>();
+    if(!innerFrameSet) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a frameset!");
     }
-    auto innerFrame = frameset->frame->as<libobsensor::FrameSet>()->getFrame(OB_FRAME_IR);
+    auto innerFrame = innerFrameSet->getFrame(OB_FRAME_IR);
     if(innerFrame == nullptr) {
         return nullptr;
     }
@@ -500,10 +527,11 @@ HANDLE_EXCEPTIONS_AND_RETURN(nullptr, frameset)
 
 ob_frame *ob_frameset_get_points_frame(const ob_frame *frameset, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frameset);
-    if(!frameset->frame->is<libobsensor::FrameSet>()) {
+    auto innerFrameSet = frameset->frame->tryAs<libobsensor::FrameSet>();
+    if(!innerFrameSet) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a frameset!");
     }
-    auto innerFrame = frameset->frame->as<libobsensor::FrameSet>()->getFrame(OB_FRAME_POINTS);
+    auto innerFrame = innerFrameSet->getFrame(OB_FRAME_POINTS);
     if(innerFrame == nullptr) {
         return nullptr;
     }
@@ -515,10 +543,11 @@ HANDLE_EXCEPTIONS_AND_RETURN(nullptr, frameset)
 
 ob_frame *ob_frameset_get_frame(const ob_frame *frameset, ob_frame_type frame_type, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frameset);
-    if(!frameset->frame->is<libobsensor::FrameSet>()) {
+    auto innerFrameSet = frameset->frame->tryAs<libobsensor::FrameSet>();
+    if(!innerFrameSet) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a frameset!");
     }
-    auto innerFrame = frameset->frame->as<libobsensor::FrameSet>()->getFrame(frame_type);
+    auto innerFrame = innerFrameSet->getFrame(frame_type);
     if(innerFrame == nullptr) {
         return nullptr;
     }
@@ -530,10 +559,11 @@ HANDLE_EXCEPTIONS_AND_RETURN(nullptr, frameset)
 
 ob_frame *ob_frameset_get_frame_by_index(const ob_frame *frameset, uint32_t index, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frameset);
-    if(!frameset->frame->is<libobsensor::FrameSet>()) {
+    auto innerFrameSet = frameset->frame->tryAs<libobsensor::FrameSet>();
+    if(!innerFrameSet) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a frameset!");
     }
-    auto innerFrame = frameset->frame->as<libobsensor::FrameSet>()->getFrame(index);
+    auto innerFrame = innerFrameSet->getFrame(index);
     if(innerFrame == nullptr) {
         return nullptr;
     }
@@ -554,19 +584,21 @@ HANDLE_EXCEPTIONS_NO_RETURN(frameset, frame)
 
 uint32_t ob_point_cloud_frame_get_width(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frame);
-    if(!frame->frame->is<libobsensor::PointsFrame>()) {
+    auto pointsFrame = frame->frame->tryAs<libobsensor::PointsFrame>();
+    if(!pointsFrame) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a video frame!");
     }
-    return frame->frame->as<libobsensor::PointsFrame>()->getWidth();
+    return pointsFrame->getWidth();
 }
 HANDLE_EXCEPTIONS_AND_RETURN(uint32_t(0), frame)
 
 uint32_t ob_point_cloud_frame_get_height(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frame);
-    if(!frame->frame->is<libobsensor::PointsFrame>()) {
+    auto pointsFrame = frame->frame->tryAs<libobsensor::PointsFrame>();
+    if(!pointsFrame) {
         THROW_UNSUPPORTED_OPERATION_EXCEPTION("It's not a video frame!");
     }
-    return frame->frame->as<libobsensor::PointsFrame>()->getHeight();
+    return pointsFrame->getHeight();
 }
 HANDLE_EXCEPTIONS_AND_RETURN(uint32_t(0), frame)
 
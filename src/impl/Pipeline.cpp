@@ -275,6 +275,19 @@ void ob_config_set_frame_aggregate_output_mode(ob_config *config, ob_frame_aggre
 }
 HANDLE_EXCEPTIONS_NO_RETURN(config, mode)
 
+void ob_config_set_frame_buffer_preallocate(ob_config *config, bool enable, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(config);
+    config->config->setFrameBufferPreallocateEnabled(enable);
+}
+HANDLE_EXCEPTIONS_NO_RETURN(config, enable)
+
+void ob_config_set_frame_aggregate_engine(ob_config *config, ob_frame_aggregate_engine engine, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(config);
+    VALIDATE_RANGE(engine, OB_FRAME_AGGREGATE_ENGINE_DEFAULT, OB_FRAME_AGGREGATE_ENGINE_LOCK_FREE);
+    config->config->setFrameAggregateEngine(engine);
+}
+HANDLE_EXCEPTIONS_NO_RETURN(config, engine)
+
 ob_pipeline_status ob_pipeline_get_status(ob_pipeline *pipeline, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(pipeline);
     return pipeline->pipeline->getStatus();
@@ -43,6 +43,12 @@ void ob_record_device_resume(ob_record_device *recorder, ob_error **error) BEGIN
 }
 HANDLE_EXCEPTIONS_NO_RETURN(recorder)
 
+ob_record_stats ob_record_device_get_stats(const ob_record_device *recorder, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(recorder);
+    return recorder->recorder->getStats();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(ob_record_stats(), recorder)
+
 ob_device *ob_create_playback_device(const char *file_path, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(file_path);
     auto device = std::make_shared<libobsensor::PlaybackDevice>(file_path);
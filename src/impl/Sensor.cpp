@@ -42,6 +42,23 @@ void ob_sensor_start(ob_sensor *sensor, const ob_stream_profile *profile, ob_fra
 }
 HANDLE_EXCEPTIONS_NO_RETURN(sensor, profile, callback, user_data)
 
+void ob_sensor_start_batched(ob_sensor *sensor, const ob_stream_profile *profile, ob_frame_callback callback, void *user_data, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(sensor);
+    VALIDATE_NOT_NULL(profile);
+    VALIDATE_NOT_NULL(callback);
+    auto internalSensor = sensor->device->getSensor(sensor->type);
+    auto batchSensor    = std::dynamic_pointer_cast<libobsensor::IImuBatchSensor>(internalSensor.get());
+    if(!batchSensor) {
+        THROW_UNSUPPORTED_OPERATION_EXCEPTION("Batched streaming is only supported by the accel and gyro sensors!");
+    }
+    batchSensor->startBatched(profile->profile, [callback, user_data](std::shared_ptr<const libobsensor::Frame> frame) {
+        auto implFrame   = new ob_frame();
+        implFrame->frame = std::const_pointer_cast<libobsensor::Frame>(frame);
+        callback(implFrame, user_data);
+    });
+}
+HANDLE_EXCEPTIONS_NO_RETURN(sensor, profile, callback, user_data)
+
 void ob_sensor_stop(ob_sensor *sensor, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(sensor);
     auto internalSensor = sensor->device->getSensor(sensor->type);
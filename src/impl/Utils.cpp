@@ -248,6 +248,14 @@ bool ob_save_pointcloud_to_ply(const char *file_name, ob_frame *frame, bool save
 }
 HANDLE_EXCEPTIONS_AND_RETURN(false, file_name, frame, save_binary, use_mesh, mesh_threshold)
 
+bool ob_save_pointcloud_to_quantized_ply(const char *file_name, ob_frame *frame, float quantization_step, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(file_name);
+    VALIDATE_NOT_NULL(frame);
+    auto point_cloud_frame = frame->frame;
+    return libobsensor::PointCloudSaveUtil::streamPointCloudToPly(file_name, point_cloud_frame, libobsensor::PLY_ENCODING_BINARY_QUANTIZED, quantization_step);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(false, file_name, frame, quantization_step)
+
 bool ob_save_lidar_pointcloud_to_ply(const char *file_name, ob_frame *frame, bool save_binary, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(file_name);
     VALIDATE_NOT_NULL(frame);
@@ -227,9 +227,9 @@ void PlaybackDevicePort::playbackLoop() {
     }
 }
 
-std::shared_ptr<FrameQueue<Frame>> &PlaybackDevicePort::getFrameQueue(OBSensorType sensorType) {
+std::shared_ptr<MpscFrameQueue<Frame>> &PlaybackDevicePort::getFrameQueue(OBSensorType sensorType) {
     if(frameQueues_.count(sensorType) == 0) {
-        frameQueues_.insert({ sensorType, std::make_shared<FrameQueue<Frame>>(maxFrameQueueSize_) });
+        frameQueues_.insert({ sensorType, std::make_shared<MpscFrameQueue<Frame>>(maxFrameQueueSize_) });
     }
 
     return frameQueues_[sensorType];
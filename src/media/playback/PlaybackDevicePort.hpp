@@ -6,7 +6,7 @@
 #include "libobsensor/h/ObTypes.h"
 #include "ISourcePort.hpp"
 #include "StateMachineBase.hpp"
-#include "frame/FrameQueue.hpp"
+#include "frame/MpscFrameQueue.hpp"
 #include "ros/RosbagReader.hpp"
 #include "component/DeviceComponentBase.hpp"
 
@@ -88,10 +88,10 @@ private:
     void startAsyncThread();
     void stopAsyncThread();
 
-    std::shared_ptr<FrameQueue<Frame>> &getFrameQueue(OBSensorType sensorType);
+    std::shared_ptr<MpscFrameQueue<Frame>> &getFrameQueue(OBSensorType sensorType);
 
 private:
-    std::map<OBSensorType, std::shared_ptr<FrameQueue<Frame>>> frameQueues_;
+    std::map<OBSensorType, std::shared_ptr<MpscFrameQueue<Frame>>> frameQueues_;  // fed by the playback thread and by seek()
     std::bitset<OB_SENSOR_TYPE_COUNT>                          activeSensors_;
 
     StreamProfileList        streamProfileList_;
@@ -3,7 +3,6 @@
 
 #include "RecordDevice.hpp"
 #include "common/DevicePids.hpp"
-#include "frame/FrameFactory.hpp"
 #include "DeviceBase.hpp"
 #include "IAlgParamManager.hpp"
 #include "property/InternalProperty.hpp"
@@ -16,7 +15,7 @@
 namespace libobsensor {
 
 RecordDevice::RecordDevice(std::shared_ptr<IDevice> device, const std::string &filePath, bool compressionsEnabled)
-    : device_(device), filePath_(filePath), isCompressionsEnabled_(compressionsEnabled), maxFrameQueueSize_(UINT16_MAX), isPaused_(false) {
+    : device_(device), filePath_(filePath), isCompressionsEnabled_(compressionsEnabled), isPaused_(false) {
 
     writer_ = std::make_shared<RosWriter>(filePath_, isCompressionsEnabled_);
     writeAllProperties();
@@ -24,7 +23,6 @@ RecordDevice::RecordDevice(std::shared_ptr<IDevice> device, const std::string &f
     const auto &sensorTypeList = device_->getSensorTypeList();
     for(const auto &sensorType: sensorTypeList) {
         device_->getSensor(sensorType)->setFrameRecordingCallback([this](std::shared_ptr<const Frame> frame) { onFrameRecordingCallback(frame); });
-        sensorOnceFlags_[sensorType] = std::unique_ptr<std::once_flag>(new std::once_flag());
     }
 }
 
@@ -35,15 +33,12 @@ RecordDevice::~RecordDevice() {
         device_->getSensor(sensorType)->setFrameRecordingCallback(nullptr);
     }
 
-    for(auto &item: frameQueueMap_) {
-        while(!item.second->empty()) {
-            std::this_thread::sleep_for(std::chrono::nanoseconds(100));
-        }
-    }
-
     // stop recorder and write device&frame info
     bool hasError = false;
-    BEGIN_TRY_EXECUTE({ stopRecord(); })
+    BEGIN_TRY_EXECUTE({
+        writer_->flush();
+        stopRecord();
+    })
     CATCH_EXCEPTION_AND_EXECUTE({
         LOG_DEBUG("RecordDevice Destructor: set bag state to error");
         hasError = true;
@@ -57,16 +52,8 @@ void RecordDevice::onFrameRecordingCallback(std::shared_ptr<const Frame> frame)
         return;
     }
 
-    auto sensorType = utils::mapFrameTypeToSensorType(frame->getType());
-    initializeFrameQueueOnce(sensorType, frame);
-
-    auto copy = FrameFactory::createFrameFromOtherFrame(frame, true);
-    {
-        std::unique_lock<std::mutex> lock(frameCallbackMutex_);
-        if(frameQueueMap_.count(sensorType)) {
-            frameQueueMap_[sensorType]->enqueue(copy);
-        }
-    }
+    // The writer copies the frame into its staging queue, or drops it when it falls behind
+    writer_->writeFrame(frame);
 }
 
 void RecordDevice::pause() {
@@ -79,13 +66,8 @@ void RecordDevice::resume() {
     isPaused_ = false;
 }
 
-void RecordDevice::initializeFrameQueueOnce(OBSensorType sensorType, std::shared_ptr<const Frame> frame) {
-    // todo: change lazy initialization to eager initialization
-    std::call_once(*sensorOnceFlags_[sensorType], [this, sensorType, frame]() {
-        std::unique_lock<std::mutex> lock(frameQueueInitMutex_);
-        frameQueueMap_[sensorType] = std::make_shared<FrameQueue<const Frame>>(maxFrameQueueSize_);
-        frameQueueMap_[sensorType]->start([this, sensorType](std::shared_ptr<const Frame> frame) { writer_->writeFrame(sensorType, frame); });
-    });
+OBRecordStats RecordDevice::getStats() const {
+    return writer_->getStats();
 }
 
 void RecordDevice::writeAllProperties() {
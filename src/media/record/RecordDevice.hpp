@@ -4,7 +4,6 @@
 #pragma once
 
 #include "IDevice.hpp"
-#include "frame/FrameQueue.hpp"
 #include "ros/RosbagWriter.hpp"
 #include "component/property/PropertyHelper.hpp"
 
@@ -25,6 +24,8 @@ public:
     void pause();
     void resume();
 
+    OBRecordStats getStats() const;
+
 private:
     template <typename T> void writePropertyT(uint32_t id) {
         auto server = device_->getPropertyServer();
@@ -76,22 +77,13 @@ private:
 
     void onFrameRecordingCallback(std::shared_ptr<const Frame>);
 
-    void initializeSensorOnce(OBSensorType sensorType);
-    void initializeFrameQueueOnce(OBSensorType sensorType, std::shared_ptr<const Frame> frame);
-
     void stopRecord();
 private:
     std::shared_ptr<IDevice> device_;
     std::string              filePath_;
     bool                     isCompressionsEnabled_;
-    size_t                   maxFrameQueueSize_;
     std::atomic<bool>        isPaused_;
     std::shared_ptr<IWriter> writer_;
-    std::mutex               frameCallbackMutex_;
-    std::mutex               frameQueueInitMutex_;
-
-    std::map<OBSensorType, std::shared_ptr<FrameQueue<const Frame>>> frameQueueMap_;
-    std::map<OBSensorType, std::unique_ptr<std::once_flag>>          sensorOnceFlags_;
 
     const uint32_t rangeOffset_       = UINT16_MAX;  // used to record property range
     const uint32_t versionPropertyId_ = 0;           // used to record version of recording file
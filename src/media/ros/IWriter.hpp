@@ -19,11 +19,15 @@ class IWriter {
 public:
     virtual ~IWriter() = default;
 
-    virtual void writeFrame(const OBSensorType &sensorType, std::shared_ptr<const Frame> curFrame) = 0;
-    virtual void writeDeviceInfo(const std::shared_ptr<const DeviceInfo> &deviceInfo)              = 0;
-    virtual void writeProperty(uint32_t propertyID, const uint8_t *data, const uint32_t datasize)  = 0;
-    virtual void writeStreamProfiles()                                                             = 0;
-    virtual void stop(bool hasError)                                                               = 0;
+    // writeFrame() queues the frame and never blocks, frames are dropped when the writer falls behind. The sensor type is derived from the
+    // frame type.
+    virtual void          writeFrame(std::shared_ptr<const Frame> curFrame)                                = 0;
+    virtual void          writeDeviceInfo(const std::shared_ptr<const DeviceInfo> &deviceInfo)             = 0;
+    virtual void          writeProperty(uint32_t propertyID, const uint8_t *data, const uint32_t datasize) = 0;
+    virtual void          writeStreamProfiles()                                                            = 0;
+    virtual void          flush()                                                                          = 0;  // writes all the queued frames
+    virtual OBRecordStats getStats()                                                                       = 0;
+    virtual void          stop(bool hasError)                                                              = 0;
 };
 
 }  // namespace libobsensor
\ No newline at end of file
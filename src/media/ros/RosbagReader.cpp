@@ -3,28 +3,57 @@
 
 #include "RosbagReader.hpp"
 
+#include <algorithm>
+
 namespace libobsensor {
 const uint64_t INVALID_DURATION = 6ULL * 60ULL * 60ULL * 1000000ULL;  // 6 hours
-RosReader::RosReader(const std::string &filePath) : filePath_(filePath), totalDuration_(0), unit_(0.0), baseline_(0.0) {
+
+// Frames decoded ahead of the read position
+const size_t PREFETCH_FRAME_COUNT = 16;
+
+RosReader::RosReader(const std::string &filePath)
+    : filePath_(filePath),
+      totalDuration_(0),
+      unit_(0.0),
+      baseline_(0.0),
+      readPos_(0),
+      prefetchPos_(0),
+      prefetchGeneration_(0),
+      prefetchStopped_(false) {
     initView();
     queryDeviceInfo();
     querySreamProfileList();
     queryProperty();
     bindStreamProfileExtrinsic();
+    prefetchThread_ = std::thread(&RosReader::prefetchLoop, this);
+}
+
+RosReader::~RosReader() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(readMutex_);
+        prefetchStopped_ = true;
+        prefetchCv_.notify_all();
+    }
+    if(prefetchThread_.joinable()) {
+        prefetchThread_.join();
+    }
 }
+
 void RosReader::initView() try {
     file_.open(filePath_, rosbag::BagMode::Read);
-    sensorView_            = std::unique_ptr<rosbag::View>(new rosbag::View(file_, FrameQuery()));
-    sensorIterator_        = sensorView_->begin();
-    startTime_             = sensorView_->getBeginTime();
-    auto streamingDuration = sensorView_->getEndTime() - sensorView_->getBeginTime();
-    for(rosbag::ConnectionInfo const *info: sensorView_->getConnections()) {
-        enabledStreamsTopics_.push_back(info->topic);
+
+    // Iterating the view only merges the index entries of the frame topics, no message data is read
+    rosbag::View sensorView(file_, FrameQuery());
+    startTime_             = sensorView.getBeginTime();
+    auto streamingDuration = sensorView.getEndTime() - sensorView.getBeginTime();
+    for(auto &msg: sensorView) {
+        frameIndex_.push_back(msg);
     }
     totalDuration_ = std::chrono::nanoseconds(streamingDuration.toNSec());
     if(static_cast<uint64_t>(totalDuration_.count() / 1000) >= INVALID_DURATION) {
         THROW_IO_EXCEPTION("The streaming duration is too long, please check the rosbag file.");
     }
+    LOG_DEBUG("Indexed {} frames of the rosbag file {}", frameIndex_.size(), filePath_);
 }
 catch(const rosbag::BagException &e) {
     THROW_IO_EXCEPTION(e.what());
@@ -289,32 +318,78 @@ inline orbbecRosbag::Time toRosTime(const std::chrono::nanoseconds &time, const
     return orbbecRosbag::Time(timeAsSecs.count() + startTimeSec);
 }
 
+size_t RosReader::findFrameIndex(const orbbecRosbag::Time &time) const {
+    auto iter = std::lower_bound(frameIndex_.begin(), frameIndex_.end(), time,
+                                 [](const rosbag::MessageInstance &msg, const orbbecRosbag::Time &t) { return msg.getTime() < t; });
+    return static_cast<size_t>(iter - frameIndex_.begin());
+}
+
 void RosReader::seekToTime(const std::chrono::nanoseconds &seekTime) {
-    std::lock_guard<std::mutex> lock(readMutex_);
     if(seekTime > totalDuration_) {
         THROW_INVALID_PARAM_EXCEPTION("Seek time is greater than total duration");
     }
-    auto seekTimeAsRostime = toRosTime(seekTime, startTime_.toSec());
-    sensorView_.reset(new rosbag::View(file_, FalseQuery()));
-    for(auto topic: enabledStreamsTopics_) {
-        sensorView_->addQuery(file_, rosbag::TopicQuery(topic), seekTimeAsRostime);
-    }
-    sensorIterator_ = sensorView_->begin();
+    size_t pos = findFrameIndex(toRosTime(seekTime, startTime_.toSec()));
+
+    std::lock_guard<std::mutex> lock(readMutex_);
+    readPos_ = pos;
+    repositionPrefetch(pos);
 }
 
 void RosReader::stop() {
     std::lock_guard<std::mutex> lock(readMutex_);
-
-    sensorView_.reset(new rosbag::View(file_, FalseQuery()));
-    for(auto topic: enabledStreamsTopics_) {
-        sensorView_->addQuery(file_, rosbag::TopicQuery(topic));
-    }
-    sensorIterator_ = sensorView_->begin();
+    readPos_ = 0;
+    repositionPrefetch(0);
 }
 
 bool RosReader::getIsEndOfFile() {
     std::lock_guard<std::mutex> lock(readMutex_);
-    return sensorIterator_ == sensorView_->end();
+    return readPos_ >= frameIndex_.size();
+}
+
+void RosReader::repositionPrefetch(size_t pos) {
+    // Called under readMutex_. Keeps the frames of the window from pos on, restarts the prefetch at pos if it is not in the window.
+    while(!prefetchedFrames_.empty() && prefetchedFrames_.front().pos < pos) {
+        prefetchedFrames_.pop_front();
+    }
+    bool inWindow = prefetchedFrames_.empty() ? prefetchPos_ == pos : prefetchedFrames_.front().pos == pos;
+    if(!inWindow) {
+        prefetchedFrames_.clear();
+        prefetchPos_ = pos;
+        prefetchGeneration_++;
+    }
+    prefetchCv_.notify_all();
+}
+
+void RosReader::prefetchLoop() {
+    std::unique_lock<std::mutex> lock(readMutex_);
+    while(true) {
+        prefetchCv_.wait(lock, [this] {
+            return prefetchStopped_ || (prefetchPos_ < frameIndex_.size() && prefetchedFrames_.size() < PREFETCH_FRAME_COUNT);
+        });
+        if(prefetchStopped_) {
+            break;
+        }
+
+        PrefetchedFrame prefetched;
+        prefetched.pos      = prefetchPos_;
+        uint64_t generation = prefetchGeneration_;
+        lock.unlock();
+        try {
+            std::lock_guard<std::mutex> bagLock(bagMutex_);
+            prefetched.frame = createFrame(frameIndex_[prefetched.pos]);
+        }
+        catch(...) {
+            // Handed to readNextData(), which reports it on the playback thread
+            prefetched.error = std::current_exception();
+        }
+        lock.lock();
+
+        if(generation == prefetchGeneration_) {
+            prefetchedFrames_.push_back(prefetched);
+            prefetchPos_ = prefetched.pos + 1;
+            prefetchCv_.notify_all();
+        }
+    }
 }
 
 std::shared_ptr<Frame> RosReader::createFrame(const rosbag::MessageInstance &msg) {
@@ -333,40 +408,56 @@ std::shared_ptr<Frame> RosReader::createFrame(const rosbag::MessageInstance &msg
 }
 
 std::shared_ptr<Frame> RosReader::readNextData() {
-    std::lock_guard<std::mutex> lock(readMutex_);
-    if(!sensorView_) {
-        sensorView_ = std::unique_ptr<rosbag::View>(new rosbag::View(file_, FalseQuery()));
-    }
-    if(sensorIterator_ == sensorView_->end()) {
+    std::unique_lock<std::mutex> lock(readMutex_);
+    if(readPos_ >= frameIndex_.size()) {
         LOG_DEBUG("End of file reached");
+        return nullptr;
+    }
+
+    size_t pos = readPos_++;
+    repositionPrefetch(pos);
+    uint64_t generation = prefetchGeneration_;
+    prefetchCv_.wait(lock, [&] {
+        return prefetchStopped_ || generation != prefetchGeneration_ || (!prefetchedFrames_.empty() && prefetchedFrames_.front().pos == pos);
+    });
+    if(prefetchStopped_ || generation != prefetchGeneration_) {
+        // Seek or stop while waiting, the frame belongs to the old position
+        return nullptr;
     }
 
-    rosbag::MessageInstance nextMsg = *sensorIterator_;
-    ++sensorIterator_;
+    PrefetchedFrame prefetched = prefetchedFrames_.front();
+    prefetchedFrames_.pop_front();
+    prefetchCv_.notify_all();
+    lock.unlock();
 
-    return createFrame(nextMsg);
+    if(prefetched.error) {
+        std::rethrow_exception(prefetched.error);
+    }
+    return prefetched.frame;
 }
 
 std::vector<std::shared_ptr<Frame>> RosReader::readLastDatas(const std::chrono::nanoseconds &startTime, const std::chrono::nanoseconds &endTime) {
-    std::vector<std::shared_ptr<Frame>> result;
-    rosbag::View                        view(file_, FalseQuery());
-    auto                                rosStartTime = toRosTime(startTime, startTime_.toSec());
-    auto                                rosEndTime   = toRosTime(endTime, startTime_.toSec());
-
-    for(auto topic: enabledStreamsTopics_) {
-        view.addQuery(file_, rosbag::TopicQuery(topic), rosStartTime, rosEndTime);
-    }
-    std::map<std::string, orbbecRosbag::Time> last_frames;
-    for(auto &&m: view) {
-        if(m.isType<sensor_msgs::Image>() || m.isType<sensor_msgs::Imu>()) {
-            auto id         = m.getTopic();
-            last_frames[id] = m.getTime();
+    auto rosStartTime = toRosTime(startTime, startTime_.toSec());
+    auto rosEndTime   = toRosTime(endTime, startTime_.toSec());
+
+    // Walk back from the end time to find the last image or IMU message of each topic
+    std::map<std::string, const rosbag::MessageInstance *> lastMessages;
+    auto iter = std::upper_bound(frameIndex_.begin(), frameIndex_.end(), rosEndTime,
+                                 [](const orbbecRosbag::Time &t, const rosbag::MessageInstance &msg) { return t < msg.getTime(); });
+    while(iter != frameIndex_.begin()) {
+        --iter;
+        if(iter->getTime() < rosStartTime) {
+            break;
+        }
+        if(iter->isType<sensor_msgs::Image>() || iter->isType<sensor_msgs::Imu>()) {
+            lastMessages.insert({ iter->getTopic(), &*iter });
         }
     }
-    for(auto &&kvp: last_frames) {
-        rosbag::View currenView(file_, rosbag::TopicQuery(kvp.first), kvp.second, kvp.second);
-        auto         msg   = currenView.begin();
-        auto         frame = createFrame(*msg);
+
+    std::vector<std::shared_ptr<Frame>> result;
+    std::lock_guard<std::mutex>         lock(bagMutex_);
+    for(auto &&kvp: lastMessages) {
+        auto frame = createFrame(*kvp.second);
         if(frame) {
             result.push_back(frame);
         }
@@ -446,10 +537,10 @@ std::shared_ptr<Frame> RosReader::createLiDARPointCloud(const rosbag::MessageIns
 
 std::chrono::nanoseconds RosReader::getCurTime() {
     std::lock_guard<std::mutex> lock(readMutex_);
-    if(sensorIterator_ == sensorView_->end()) {
+    if(readPos_ >= frameIndex_.size()) {
         return getDuration();
     }
-    return static_cast<std::chrono::nanoseconds>(sensorIterator_->getTime().toNSec() - startTime_.toNSec());
+    return static_cast<std::chrono::nanoseconds>(frameIndex_[readPos_].getTime().toNSec() - startTime_.toNSec());
 }
 
 bool RosReader::isPropertySupported(uint32_t propertyId) const {
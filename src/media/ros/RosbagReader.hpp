@@ -10,6 +10,7 @@
 #include "exception/ObException.hpp"
 #include "stream/StreamProfile.hpp"
 #include "libobsensor/h/ObTypes.h"
+#include "utils/SteadyCondVar.hpp"
 
 #include "RosFileFormat.hpp"
 #include "rosbag/bag.h"
@@ -29,17 +30,26 @@
 #include "custom_msg/OBProperty.h"
 
 #include <chrono>
+#include <deque>
+#include <exception>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace libobsensor {
 
+/**
+ * @brief Reads a recording from a rosbag file.
+ *
+ * The frame messages of all the streams are indexed once at open, in time order, from the index records of the bag, so seekToTime() is a
+ * binary search. A prefetch thread decodes the frames following the read position ahead of readNextData().
+ */
 class RosReader : public IReader {
 public:
     RosReader(const std::string &file);
-    virtual ~RosReader() noexcept override = default;
+    virtual ~RosReader() noexcept override;
 
     virtual std::shared_ptr<DeviceInfo>    getDeviceInfo() override;
     virtual std::chrono::nanoseconds       getDuration() override;
@@ -67,21 +77,40 @@ private:
     void                   queryProperty();
     void                   bindStreamProfileExtrinsic();
     std::shared_ptr<Frame> createFrame(const rosbag::MessageInstance &msg);
+    size_t                 findFrameIndex(const orbbecRosbag::Time &time) const;
+    void                   repositionPrefetch(size_t pos);
+    void                   prefetchLoop();
 
 private:
     std::string                                            filePath_;
     rosbag::Bag                                            file_;
     std::chrono::nanoseconds                               totalDuration_;
-    std::mutex                                             readMutex_;
+    std::mutex                                             bagMutex_;  // rosbag::Bag reads are not thread safe
     orbbecRosbag::Time                                     startTime_;
-    std::unique_ptr<rosbag::View>                          sensorView_;
-    rosbag::View::iterator                                 sensorIterator_;
-    std::vector<std::string>                               enabledStreamsTopics_;
     std::shared_ptr<DeviceInfo>                            deviceInfo_;
     float                                                  unit_;
     float                                                  baseline_;
     std::map<OBStreamType, std::shared_ptr<StreamProfile>> streamProfileList_;
     std::map<uint32_t, std::vector<uint8_t>>               propertyList_;
+
+    // Frame messages of all the streams in time order, built at open and never changed afterwards
+    std::vector<rosbag::MessageInstance> frameIndex_;
+
+    // Read position and read-ahead window, guarded by readMutex_. The prefetch thread decodes frameIndex_[prefetchPos_] while the
+    // window holds less than PREFETCH_FRAME_COUNT frames; a seek outside of the window restarts it (new generation).
+    struct PrefetchedFrame {
+        size_t                 pos;
+        std::shared_ptr<Frame> frame;
+        std::exception_ptr     error;
+    };
+    std::mutex                  readMutex_;
+    utils::SteadyCondVar        prefetchCv_;
+    size_t                      readPos_;
+    std::deque<PrefetchedFrame> prefetchedFrames_;
+    size_t                      prefetchPos_;
+    uint64_t                    prefetchGeneration_;
+    bool                        prefetchStopped_;
+    std::thread                 prefetchThread_;
 };
 
 }  // namespace libobsensor
\ No newline at end of file
@@ -2,26 +2,96 @@
 // Licensed under the MIT License.
 
 #include "RosbagWriter.hpp"
+#include "frame/FrameFactory.hpp"
+#include "logger/LoggerInterval.hpp"
+#include "utils/PublicTypeHelper.hpp"
 
+#include <algorithm>
 #include <cstdio>
 
 namespace libobsensor {
 const uint64_t INVALID_DIFF = 6ULL * 60ULL * 60ULL * 1000000ULL;  // 6 hours
 
-RosWriter::RosWriter(const std::string &file, bool compressWhileRecord) : filePath_(file), startTime_(0), minFrameTime_(0), maxFrameTime_(0) {
+// Staging ring limits, frames arriving while either one is reached are dropped
+const size_t   MAX_STAGED_FRAMES = 2048;  // IMU streams run at up to 1kHz per sensor
+const uint64_t MAX_STAGED_BYTES  = 512ULL * 1024ULL * 1024ULL;
+
+// Chunks waiting for compression or writing before the serializer stops taking frames from the ring
+const size_t   MAX_PENDING_CHUNKS  = 16;
+const uint32_t MAX_COMPRESS_THREADS = 4;
+
+RosWriter::RosWriter(const std::string &file, bool compressWhileRecord)
+    : filePath_(file),
+      startTime_(0),
+      minFrameTime_(0),
+      maxFrameTime_(0),
+      stagingQueue_(MAX_STAGED_FRAMES),
+      stagedBytes_(0),
+      framesWritten_(0),
+      framesDropped_(0),
+      compressStopped_(false),
+      bytesWritten_(0),
+      rateSampleTime_(std::chrono::steady_clock::now()),
+      rateSampleBytes_(0),
+      bytesPerSecond_(0) {
     file_ = std::make_shared<rosbag::Bag>();
     file_->open(filePath_, rosbag::BagMode::Write);
     if(compressWhileRecord) {
         file_->setCompression(rosbag::CompressionType::LZ4);
     }
+    file_->setDeferredChunkCallback([this](std::shared_ptr<rosbag::Bag::DeferredChunk> chunk) { onChunkFinished(chunk); });
+    bytesWritten_ = file_->getSize();
+
+    uint32_t threadCount = std::min(std::max(std::thread::hardware_concurrency(), 1u), MAX_COMPRESS_THREADS);
+    compressPool_.reset(new utils::WorkerPool(threadCount));
+    compressThread_ = std::thread([this] { compressLoop(); });
+
+    stagingQueue_.start([this](std::shared_ptr<const Frame> frame) {
+        stagedBytes_ -= frame->getDataSize();
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        if(!file_) {
+            return;
+        }
+        try {
+            serializeFrame(frame);
+            writeCompressedChunks(MAX_PENDING_CHUNKS);
+        }
+        catch(const std::exception &e) {
+            LOG_WARN_INTVL("Write frame to rosbag failed: {}", e.what());
+        }
+    });
 }
 
 RosWriter::~RosWriter() {
     stop(false);
 }
 
+void RosWriter::flush() {
+    stagingQueue_.flush();
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    if(file_) {
+        writeCompressedChunks(0);
+    }
+}
+
 void RosWriter::stop(bool hasError) {
-    if (file_) {
+    flush();
+
+    {
+        std::lock_guard<std::mutex> lock(chunkMutex_);
+        compressStopped_ = true;
+        compressCv_.notify_all();
+    }
+    if(compressThread_.joinable()) {
+        compressThread_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    if(file_) {
+        // Closing the bag compresses and writes the last chunk, all the chunks before it are written by flush()
+        BEGIN_TRY_EXECUTE({ file_->close(); })
+        CATCH_EXCEPTION_AND_EXECUTE({ hasError = true; })
         file_.reset();
         file_ = nullptr;
 
@@ -45,12 +115,137 @@ void RosWriter::stop(bool hasError) {
             LOG_WARN("Error when saving rosbag file! There are abnormal timestamp data frames during recording!");
             markFileAsError(filePath_);
         }
+        LOG_DEBUG("Rosbag writer stopped, {} frames written, {} frames dropped", framesWritten_.load(), framesDropped_.load());
     }
 }
 
-void RosWriter::writeFrame(const OBSensorType &sensorType, std::shared_ptr<const Frame> curFrame) {
-    std::lock_guard<std::mutex> lock(writeMutex_);
-    auto                        curTime = curFrame->getTimeStampUsec();
+void RosWriter::writeFrame(std::shared_ptr<const Frame> curFrame) {
+    // Reserve the staging budget before copying, a frame that does not fit is dropped without touching its data
+    uint64_t size = curFrame->getDataSize();
+    if(stagedBytes_.fetch_add(size) + size > MAX_STAGED_BYTES) {
+        stagedBytes_ -= size;
+        framesDropped_++;
+        LOG_WARN_INTVL("Record staging queue is full ({} bytes), drop frame!", MAX_STAGED_BYTES);
+        return;
+    }
+
+    // The copy gives the frame buffer back to the device right away
+    std::shared_ptr<const Frame> copy = FrameFactory::createFrameFromOtherFrame(curFrame, true);
+    if(!stagingQueue_.enqueue(copy)) {
+        stagedBytes_ -= size;
+        framesDropped_++;
+        LOG_WARN_INTVL("Record staging queue is full ({} frames), drop frame!", stagingQueue_.capacity());
+    }
+}
+
+OBRecordStats RosWriter::getStats() {
+    OBRecordStats stats;
+    stats.queueDepth    = static_cast<uint32_t>(stagingQueue_.size());
+    stats.queueCapacity = static_cast<uint32_t>(stagingQueue_.capacity());
+    stats.queuedBytes   = stagedBytes_.load();
+    stats.framesWritten = framesWritten_.load();
+    stats.framesDropped = framesDropped_.load();
+    stats.bytesWritten  = bytesWritten_.load();
+    {
+        std::lock_guard<std::mutex> lock(chunkMutex_);
+        stats.pendingChunks = static_cast<uint32_t>(pendingChunks_.size());
+    }
+    {
+        // The rate is refreshed at most once per second, over the time since the previous refresh
+        std::lock_guard<std::mutex> lock(rateMutex_);
+        auto                        now     = std::chrono::steady_clock::now();
+        double                      elapsed = std::chrono::duration<double>(now - rateSampleTime_).count();
+        if(elapsed >= 1.0) {
+            bytesPerSecond_  = static_cast<double>(stats.bytesWritten - rateSampleBytes_) / elapsed;
+            rateSampleTime_  = now;
+            rateSampleBytes_ = stats.bytesWritten;
+        }
+        stats.bytesPerSecond = bytesPerSecond_;
+    }
+    return stats;
+}
+
+void RosWriter::onChunkFinished(std::shared_ptr<rosbag::Bag::DeferredChunk> chunk) {
+    // Called by the bag from write(), under writeMutex_
+    std::lock_guard<std::mutex> lock(chunkMutex_);
+    pendingChunks_.push_back({ chunk, false, false });
+    compressCv_.notify_one();
+}
+
+void RosWriter::compressLoop() {
+    std::vector<rosbag::Bag::DeferredChunk *> batch;
+    while(true) {
+        {
+            std::unique_lock<std::mutex> lock(chunkMutex_);
+            compressCv_.wait(lock, [this] {
+                return compressStopped_
+                       || std::any_of(pendingChunks_.begin(), pendingChunks_.end(), [](const PendingChunk &item) { return !item.compressing; });
+            });
+            if(compressStopped_) {
+                break;
+            }
+            for(auto &item: pendingChunks_) {
+                if(!item.compressing) {
+                    item.compressing = true;
+                    batch.push_back(item.chunk.get());
+                }
+            }
+        }
+
+        compressPool_->run(static_cast<uint32_t>(batch.size()), [this, &batch](uint32_t index) {
+            auto chunk = batch[index];
+            try {
+                rosbag::Bag::compressDeferredChunk(*chunk);
+            }
+            catch(const std::exception &e) {
+                // The data is still valid, keep it uncompressed
+                LOG_WARN_INTVL("Compress rosbag chunk failed, write it uncompressed: {}", e.what());
+                chunk->compression = rosbag::CompressionType::Uncompressed;
+            }
+        });
+
+        {
+            std::lock_guard<std::mutex> lock(chunkMutex_);
+            for(auto &item: pendingChunks_) {
+                if(item.compressing) {
+                    item.compressed = true;
+                }
+            }
+            compressedCv_.notify_all();
+        }
+        batch.clear();
+    }
+}
+
+void RosWriter::writeCompressedChunks(size_t maxPendingChunks) {
+    // Called under writeMutex_. Writes the compressed chunks at the head of the queue, and waits for the head to be compressed while more
+    // than maxPendingChunks chunks are pending.
+    while(true) {
+        std::shared_ptr<rosbag::Bag::DeferredChunk> chunk;
+        {
+            std::unique_lock<std::mutex> lock(chunkMutex_);
+            if(pendingChunks_.empty()) {
+                return;
+            }
+            if(!pendingChunks_.front().compressed) {
+                if(pendingChunks_.size() <= maxPendingChunks) {
+                    return;
+                }
+                compressedCv_.wait(lock, [this] { return pendingChunks_.front().compressed; });
+            }
+            chunk = pendingChunks_.front().chunk;
+        }
+
+        file_->writeDeferredChunk(*chunk);
+        bytesWritten_ = file_->getSize();
+
+        std::lock_guard<std::mutex> lock(chunkMutex_);
+        pendingChunks_.pop_front();
+    }
+}
+
+void RosWriter::serializeFrame(std::shared_ptr<const Frame> curFrame) {
+    auto curTime = curFrame->getTimeStampUsec();
     if(curTime == 0) {
         LOG_WARN("Invalid timestamp frame! curFrame device timestamp: {}", curFrame->getTimeStampUsec());
         return;
@@ -64,7 +259,11 @@ void RosWriter::writeFrame(const OBSensorType &sensorType, std::shared_ptr<const
         maxFrameTime_ = std::max(maxFrameTime_, curTime);
     }
 
-    if(sensorType == OB_SENSOR_GYRO || sensorType == OB_SENSOR_ACCEL) {
+    auto sensorType = utils::mapFrameTypeToSensorType(curFrame->getType());
+    if(curFrame->getType() == OB_FRAME_IMU_BATCH) {
+        writeImuBatchFrame(curFrame);
+    }
+    else if(sensorType == OB_SENSOR_GYRO || sensorType == OB_SENSOR_ACCEL) {
         writeImuFrame(sensorType, curFrame);
     }
     else if(sensorType == OB_SENSOR_LIDAR) {
@@ -73,7 +272,9 @@ void RosWriter::writeFrame(const OBSensorType &sensorType, std::shared_ptr<const
     else {
         writeVideoFrame(sensorType, curFrame);
     }
+    framesWritten_++;
 }
+
 void RosWriter::writeImuFrame(const OBSensorType &sensorType, std::shared_ptr<const Frame> curFrame) {
     if(startTime_ == 0) {
         startTime_ = curFrame->getTimeStampUsec();
@@ -114,6 +315,52 @@ void RosWriter::writeImuFrame(const OBSensorType &sensorType, std::shared_ptr<co
     }
 }
 
+void RosWriter::writeImuBatchFrame(std::shared_ptr<const Frame> curFrame) {
+    // Written sample by sample on the topic of the per-sample stream, so the recording plays back like one of a per-sample stream
+    auto batch = curFrame->as<ImuBatchFrame>()->getBatchData();
+    if(batch.count == 0) {
+        return;
+    }
+    if(startTime_ == 0) {
+        startTime_ = curFrame->getTimeStampUsec();
+    }
+    maxFrameTime_ = std::max(maxFrameTime_, batch.timestamp[batch.count - 1]);
+
+    bool isAccel    = curFrame->getStreamProfile()->getType() == OB_STREAM_ACCEL;
+    auto sensorType = isAccel ? OB_SENSOR_ACCEL : OB_SENSOR_GYRO;
+    auto frameType  = isAccel ? OB_FRAME_ACCEL : OB_FRAME_GYRO;
+    auto imuTopic   = RosTopic::imuDataTopic((uint8_t)sensorType, (uint8_t)frameType);
+    streamProfileMap_.insert({ sensorType, curFrame->getStreamProfile() });
+
+    for(uint32_t i = 0; i < batch.count; i++) {
+        AccelFrame::Data data;  // same layout as GyroFrame::Data
+        data.value = { batch.x[i], batch.y[i], batch.z[i] };
+        data.temp  = batch.temperature[i];
+
+        std::chrono::duration<double, std::micro> timestampUs(batch.timestamp[i]);
+        sensor_msgs::ImuPtr                       imuMsg(new sensor_msgs::Imu());
+        imuMsg->header.stamp = orbbecRosbag::Time(std::chrono::duration<double>(timestampUs).count());
+        if(isAccel) {
+            imuMsg->linear_acceleration.x = static_cast<double>(data.value.x);
+            imuMsg->linear_acceleration.y = static_cast<double>(data.value.y);
+            imuMsg->linear_acceleration.z = static_cast<double>(data.value.z);
+        }
+        else {
+            imuMsg->angular_velocity.x = static_cast<double>(data.value.x);
+            imuMsg->angular_velocity.y = static_cast<double>(data.value.y);
+            imuMsg->angular_velocity.z = static_cast<double>(data.value.z);
+        }
+        imuMsg->data.assign(reinterpret_cast<const uint8_t *>(&data), reinterpret_cast<const uint8_t *>(&data) + sizeof(data));
+        imuMsg->datasize             = static_cast<uint32_t>(sizeof(data));
+        imuMsg->number               = curFrame->getNumber() + i;
+        imuMsg->temperature          = data.temp;
+        imuMsg->timestamp_usec       = batch.timestamp[i];
+        imuMsg->timestamp_systemusec = curFrame->getSystemTimeStampUsec();
+        imuMsg->timestamp_globalusec = curFrame->getGlobalTimeStampUsec();
+        file_->write(imuTopic, imuMsg->header.stamp, imuMsg);
+    }
+}
+
 void RosWriter::writeLiDARFrame(std::shared_ptr<const Frame> curFrame) {
     if(startTime_ == 0) {
         startTime_ = curFrame->getTimeStampUsec();
@@ -214,17 +461,18 @@ void RosWriter::writeVideoFrame(const OBSensorType &sensorType, std::shared_ptr<
         sensor_msgs::ImagePtr imageMsg(new sensor_msgs::Image());
         imageMsg->header.stamp = orbbecRosbag::Time(std::chrono::duration<double>(timestampUs).count());
 
-        imageMsg->width                = curFrame->as<VideoFrame>()->getWidth();
-        imageMsg->height               = curFrame->as<VideoFrame>()->getHeight();
+        auto videoFrame                = curFrame->as<VideoFrame>();
+        imageMsg->width                = videoFrame->getWidth();
+        imageMsg->height               = videoFrame->getHeight();
         imageMsg->number               = curFrame->getNumber();
         imageMsg->timestamp_usec       = curFrame->getTimeStampUsec();
         imageMsg->timestamp_systemusec = curFrame->getSystemTimeStampUsec();
         imageMsg->timestamp_globalusec = curFrame->getGlobalTimeStampUsec();
-        imageMsg->step                 = curFrame->as<VideoFrame>()->getStride();
+        imageMsg->step                 = videoFrame->getStride();
         imageMsg->metadatasize         = static_cast<uint32_t>(curFrame->getMetadataSize());
         float bytesPerPixel            = 0.0f;
         if(utils::getBytesPerPixelNoexcept(curFrame->getFormat(), bytesPerPixel)) {
-            imageMsg->pixel_bit_size = curFrame->as<VideoFrame>()->getPixelAvailableBitSize();
+            imageMsg->pixel_bit_size = videoFrame->getPixelAvailableBitSize();
         }
 
         imageMsg->data.clear();
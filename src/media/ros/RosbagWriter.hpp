@@ -10,6 +10,9 @@
 #include "libobsensor/h/ObTypes.h"
 #include "logger/Logger.hpp"
 #include "stream/StreamProfile.hpp"
+#include "frame/MpscFrameQueue.hpp"
+#include "utils/SteadyCondVar.hpp"
+#include "utils/WorkerPool.hpp"
 
 #include "rosbag/bag.h"
 #include "rosbag/view.h"
@@ -27,28 +30,46 @@
 #include "custom_msg/OBDisparityParam.h"
 #include "custom_msg/OBProperty.h"
 
+#include <atomic>
 #include <chrono>
+#include <deque>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace libobsensor {
 
+/**
+ * @brief Writes the recording to a rosbag file off the streaming threads.
+ *
+ * writeFrame() only puts the frame in a bounded staging ring (frame count and data size). The dequeue thread of the ring serializes the
+ * frames into bag chunks, the finished chunks are compressed in parallel on a worker pool and written to the file in order by the
+ * serializer. When the compression or the disk can not keep up, the serializer waits for the chunks in flight, the ring fills up and new
+ * frames are dropped, see getStats().
+ */
 class RosWriter : public IWriter {
 public:
     explicit RosWriter(const std::string &file, bool compressWhileRecord);
     virtual ~RosWriter() noexcept override;
 
-    virtual void writeFrame(const OBSensorType &sensorType, std::shared_ptr<const Frame> curFrame) override;
-    virtual void writeDeviceInfo(const std::shared_ptr<const DeviceInfo> &deviceInfo) override;
-    virtual void writeProperty(uint32_t propertyID, const uint8_t *data, const uint32_t datasize) override;
-    virtual void writeStreamProfiles() override;
-    virtual void stop(bool hasError) override;
+    virtual void          writeFrame(std::shared_ptr<const Frame> curFrame) override;
+    virtual void          writeDeviceInfo(const std::shared_ptr<const DeviceInfo> &deviceInfo) override;
+    virtual void          writeProperty(uint32_t propertyID, const uint8_t *data, const uint32_t datasize) override;
+    virtual void          writeStreamProfiles() override;
+    virtual void          flush() override;
+    virtual OBRecordStats getStats() override;
+    virtual void          stop(bool hasError) override;
 
 private:
+    void serializeFrame(std::shared_ptr<const Frame> curFrame);
+    void onChunkFinished(std::shared_ptr<rosbag::Bag::DeferredChunk> chunk);
+    void compressLoop();
+    void writeCompressedChunks(size_t maxPendingChunks);
     void writeVideoFrame(const OBSensorType &sensorType, std::shared_ptr<const Frame> curFrame);
     void writeImuFrame(const OBSensorType &sensorType, std::shared_ptr<const Frame> curFrame);
+    void writeImuBatchFrame(std::shared_ptr<const Frame> curFrame);
     void writeVideoStreamProfile(const OBSensorType sensorType, const std::shared_ptr<const StreamProfile> &streamProfile);
     void writeLiDARFrame(std::shared_ptr<const Frame> curFrame);
     void writeAccelStreamProfile(const std::shared_ptr<const StreamProfile> &streamProfile);
@@ -67,6 +88,32 @@ private:
 
     uint64_t minFrameTime_;
     uint64_t maxFrameTime_;
+
+    // Staging ring between the sensor threads and the serializer (the dequeue thread of the ring)
+    MpscFrameQueue<const Frame> stagingQueue_;
+    std::atomic<uint64_t>       stagedBytes_;
+    std::atomic<uint64_t>       framesWritten_;
+    std::atomic<uint64_t>       framesDropped_;
+
+    // Chunks finished by the bag in file order, compressed by compressThread_ and written by writeCompressedChunks()
+    struct PendingChunk {
+        std::shared_ptr<rosbag::Bag::DeferredChunk> chunk;
+        bool                                        compressing;
+        bool                                        compressed;
+    };
+    std::mutex                         chunkMutex_;
+    utils::SteadyCondVar               compressCv_;    // new chunks to compress, or stopping
+    utils::SteadyCondVar               compressedCv_;  // chunks compressed
+    std::deque<PendingChunk>           pendingChunks_;
+    bool                               compressStopped_;
+    std::unique_ptr<utils::WorkerPool> compressPool_;
+    std::thread                        compressThread_;
+
+    std::atomic<uint64_t>                 bytesWritten_;
+    std::mutex                            rateMutex_;
+    std::chrono::steady_clock::time_point rateSampleTime_;
+    uint64_t                              rateSampleBytes_;
+    double                                bytesPerSecond_;
 };
 
 }  // namespace libobsensor
\ No newline at end of file
@@ -101,8 +101,24 @@ OBFrameAggregateOutputMode Config::getFrameAggregateOutputMode() const {
     return frameAggregateOutputMode_;
 }
 
+void Config::setFrameBufferPreallocateEnabled(bool enable) {
+    frameBufferPreallocate_ = enable;
+}
+
+bool Config::isFrameBufferPreallocateEnabled() const {
+    return frameBufferPreallocate_;
+}
+
+void Config::setFrameAggregateEngine(OBFrameAggregateEngine engine) {
+    frameAggregateEngine_ = engine;
+}
+
+OBFrameAggregateEngine Config::getFrameAggregateEngine() const {
+    return frameAggregateEngine_;
+}
+
 bool Config::operator==(const Config &cmp) const {
-    if(cmp.alignMode_ != alignMode_ || cmp.depthScaleRequire_ != depthScaleRequire_
+    if(cmp.alignMode_ != alignMode_ || cmp.depthScaleRequire_ != depthScaleRequire_ || cmp.frameAggregateEngine_ != frameAggregateEngine_
        || cmp.enabledStreamProfileList_.size() != enabledStreamProfileList_.size()) {
         return false;
     }
@@ -134,6 +150,8 @@ std::shared_ptr<Config> Config::clone() const {
     config->depthScaleRequire_        = depthScaleRequire_;
     config->enabledStreamProfileList_ = enabledStreamProfileList_;
     config->frameAggregateOutputMode_ = frameAggregateOutputMode_;
+    config->frameBufferPreallocate_   = frameBufferPreallocate_;
+    config->frameAggregateEngine_     = frameAggregateEngine_;
     return config;
 }
 
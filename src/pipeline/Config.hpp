@@ -37,6 +37,12 @@ public:
     void                       setFrameAggregateOutputMode(OBFrameAggregateOutputMode mode);
     OBFrameAggregateOutputMode getFrameAggregateOutputMode() const;
 
+    void setFrameBufferPreallocateEnabled(bool enable);
+    bool isFrameBufferPreallocateEnabled() const;
+
+    void                   setFrameAggregateEngine(OBFrameAggregateEngine engine);
+    OBFrameAggregateEngine getFrameAggregateEngine() const;
+
     bool operator==(const Config &cmp) const;
     bool operator!=(const Config &cmp) const;
 
@@ -47,5 +53,7 @@ private:
     OBAlignMode                alignMode_{ ALIGN_DISABLE };
     bool                       depthScaleRequire_        = true;
     OBFrameAggregateOutputMode frameAggregateOutputMode_ = OB_FRAME_AGGREGATE_OUTPUT_ANY_SITUATION;
+    bool                       frameBufferPreallocate_   = false;
+    OBFrameAggregateEngine     frameAggregateEngine_     = OB_FRAME_AGGREGATE_ENGINE_DEFAULT;
 };
 }  // namespace libobsensor
@@ -12,9 +12,6 @@
 
 namespace libobsensor {
 
-#define MAX_FRAME_DELAY 0.5f  // 0.3s max delay diff + 0.1s max frame gap
-#define MAX_NORMAL_MODE_QUEUE_SIZE 3
-
 typedef std::map<OBFrameType, SourceFrameQueue>::iterator FrameQueuePair;
 
 const std::map<OBStreamType, OBFrameType> STREAM_FRAME_TYPE_MAP = {
@@ -31,6 +28,36 @@ uint64_t getFrameTimestampMsec(const std::shared_ptr<const Frame> &frame, FrameS
     return frame->getTimeStampUsec() / 1000;
 }
 
+void calcSourceFrameQueueParam(const std::shared_ptr<const StreamProfile> &profile, float maxFrameDelay, OBFrameAggregateOutputMode outputMode,
+                               uint32_t &maxSyncQueueSize, uint32_t &halfTspGap) {
+    float fps = 0;
+    if(profile->is<const VideoStreamProfile>()) {
+        auto videoProfile = profile->as<const VideoStreamProfile>();
+        fps               = (float)videoProfile->getFps();
+    }
+    else if(profile->is<const AccelStreamProfile>()) {
+        auto accelStreamProfile = profile->as<const AccelStreamProfile>();
+        fps                     = utils::mapIMUSampleRateToValue(accelStreamProfile->getSampleRate());
+    }
+    else if(profile->is<const GyroStreamProfile>()) {
+        auto gyroStreamProfile = profile->as<const GyroStreamProfile>();
+        fps                    = utils::mapIMUSampleRateToValue(gyroStreamProfile->getSampleRate());
+    }
+    else if(profile->is<const LiDARStreamProfile>()) {
+        auto lidarStreamProfile = profile->as<const LiDARStreamProfile>();
+        fps                     = utils::mapLiDARScanRateToValue(lidarStreamProfile->getScanRate());
+    }
+
+    float queueSize = fps * maxFrameDelay + 1;
+    queueSize += ((queueSize - (int)queueSize) > 0 ? 1 : 0);
+    if(outputMode == OB_FRAME_AGGREGATE_OUTPUT_DISABLE) {
+        queueSize = 1;
+    }
+
+    maxSyncQueueSize = (uint32_t)queueSize;
+    halfTspGap       = static_cast<uint32_t>(500.0f / fps + 0.5);  // +0.5 to complete rounding
+}
+
 FrameAggregator::FrameAggregator(float maxFrameDelay)
     : frameSyncMode_(FrameSyncModeDisable),
       miniTimeStamp_(0),
@@ -60,39 +87,14 @@ void FrameAggregator::updateConfig(std::shared_ptr<const Config> config, const b
     frameAggregateOutputMode_ = config->getFrameAggregateOutputMode();
     matchingRateFirst_        = matchingRateFirst;
     reset();
-    auto profiles = config->getEnabledStreamProfileList();
+    maxNormalModeQueueSize_ = frameAggregateOutputMode_ == OB_FRAME_AGGREGATE_OUTPUT_DISABLE ? 1 : MAX_NORMAL_MODE_QUEUE_SIZE;
+    auto profiles           = config->getEnabledStreamProfileList();
     for(auto &profile: profiles) {
-        float fps = 0;
-        if(profile->is<const VideoStreamProfile>()) {
-            auto videoProfile = profile->as<const VideoStreamProfile>();
-            fps               = (float)videoProfile->getFps();
-        }
-        else if(profile->is<const AccelStreamProfile>()) {
-            auto accelStreamProfile = profile->as<const AccelStreamProfile>();
-            fps                     = utils::mapIMUSampleRateToValue(accelStreamProfile->getSampleRate());
-        }
-        else if(profile->is<const GyroStreamProfile>()) {
-            auto gyroStreamProfile = profile->as<const GyroStreamProfile>();
-            fps                    = utils::mapIMUSampleRateToValue(gyroStreamProfile->getSampleRate());
-        }
-        else if(profile->is<const LiDARStreamProfile>()) {
-            auto lidarStreamProfile = profile->as<const LiDARStreamProfile>();
-            fps                     = utils::mapLiDARScanRateToValue(lidarStreamProfile->getScanRate());
-        }
-
-        float maxSyncQueueSize = fps * maxFrameDelay_ + 1;
-        maxSyncQueueSize += ((maxSyncQueueSize - (int)maxSyncQueueSize) > 0 ? 1 : 0);
-        if(frameAggregateOutputMode_ == OB_FRAME_AGGREGATE_OUTPUT_DISABLE) {
-            maxSyncQueueSize        = 1;
-            maxNormalModeQueueSize_ = 1;
-        }
-        else {
-            maxNormalModeQueueSize_ = MAX_NORMAL_MODE_QUEUE_SIZE;
-        }
-
-        auto halfTspGap = static_cast<uint32_t>(500.0f / fps + 0.5);  // +0.5 to complete rounding
+        uint32_t maxSyncQueueSize = 0;
+        uint32_t halfTspGap       = 0;
+        calcSourceFrameQueueParam(profile, maxFrameDelay_, frameAggregateOutputMode_, maxSyncQueueSize, halfTspGap);
         srcFrameQueueMap_.insert(
-            { STREAM_FRAME_TYPE_MAP.find(profile->getType())->second, { std::queue<std::shared_ptr<const Frame>>(), (uint32_t)maxSyncQueueSize, halfTspGap } });
+            { STREAM_FRAME_TYPE_MAP.find(profile->getType())->second, { std::queue<std::shared_ptr<const Frame>>(), maxSyncQueueSize, halfTspGap } });
     }
 }
 
@@ -328,6 +330,15 @@ void FrameAggregator::clearAllFrameQueue() {
     withOverflowQueue_ = false;
 }
 
+uint32_t FrameAggregator::getMaxQueueSize(OBFrameType frameType) {
+    std::unique_lock<std::recursive_mutex> lk(srcFrameQueueMutex_);
+    auto                                   iter = srcFrameQueueMap_.find(frameType);
+    if(iter == srcFrameQueueMap_.end()) {
+        return 0;
+    }
+    return frameSyncMode_ == FrameSyncModeDisable ? maxNormalModeQueueSize_ : iter->second.maxSyncQueueSize_;
+}
+
 void FrameAggregator::reset() {
     std::unique_lock<std::recursive_mutex> lk(srcFrameQueueMutex_);
     clearAllFrameQueue();
@@ -6,6 +6,7 @@
 #include "libobsensor/h/ObTypes.h"
 #include "frame/Frame.hpp"
 #include "Config.hpp"
+#include "IFrameAggregator.hpp"
 
 #include <map>
 #include <queue>
@@ -15,7 +16,8 @@
 
 namespace libobsensor {
 
-class IPipelineStatusCollector;
+#define MAX_FRAME_DELAY 0.5f  // 0.3s max delay diff + 0.1s max frame gap
+#define MAX_NORMAL_MODE_QUEUE_SIZE 3
 
 struct SourceFrameQueue {
     std::queue<std::shared_ptr<const Frame>> queue;
@@ -23,26 +25,30 @@ struct SourceFrameQueue {
     uint32_t                                 halfTspGap;
 };
 
-enum FrameSyncMode {
-    FrameSyncModeDisable,
-    FrameSyncModeSyncAccordingFrameTimestamp,
-    FrameSyncModeSyncAccordingSystemTimestamp,
-};
-class FrameAggregator {
+// Timestamp used to match the frames, in milliseconds
+uint64_t getFrameTimestampMsec(const std::shared_ptr<const Frame> &frame, FrameSyncMode syncMode);
+
+// Sync queue depth and half frame interval (ms) of the stream, shared by all aggregator engines
+void calcSourceFrameQueueParam(const std::shared_ptr<const StreamProfile> &profile, float maxFrameDelay, OBFrameAggregateOutputMode outputMode,
+                               uint32_t &maxSyncQueueSize, uint32_t &halfTspGap);
+
+class FrameAggregator : public IFrameAggregator {
 public:
 public:
     FrameAggregator(float maxFrameDelay = 0.0f);
-    ~FrameAggregator() noexcept;
+    ~FrameAggregator() noexcept override;
+
+    void updateConfig(std::shared_ptr<const Config> config, const bool matchingRateFirst) override;
+    void pushFrame(std::shared_ptr<const Frame> frame) override;
+    void enableFrameSync(FrameSyncMode mode) override;
+    void setCallback(FrameCallback callback) override;
 
-    void updateConfig(std::shared_ptr<const Config> config, const bool matchingRateFirst);
-    void pushFrame(std::shared_ptr<const Frame> frame);
-    void enableFrameSync(FrameSyncMode mode);
-    void setCallback(FrameCallback callback);
+    void clearFrameQueue(OBFrameType frameType) override;
+    void clearAllFrameQueue() override;
 
-    void clearFrameQueue(OBFrameType frameType);
-    void clearAllFrameQueue();
+    uint32_t getMaxQueueSize(OBFrameType frameType) override;
 
-    void setPipelineStatusCollector(std::shared_ptr<IPipelineStatusCollector> collector);
+    void setPipelineStatusCollector(std::shared_ptr<IPipelineStatusCollector> collector) override;
 
 private:
     void outputFrameset(std::shared_ptr<const FrameSet> frameSet);
@@ -0,0 +1,46 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "libobsensor/h/ObTypes.h"
+#include "frame/Frame.hpp"
+#include "Config.hpp"
+
+#include <memory>
+
+namespace libobsensor {
+
+class IPipelineStatusCollector;
+
+enum FrameSyncMode {
+    FrameSyncModeDisable,
+    FrameSyncModeSyncAccordingFrameTimestamp,
+    FrameSyncModeSyncAccordingSystemTimestamp,
+};
+
+/**
+ * @brief Interface of the pipeline frame aggregator, which matches the frames of the enabled streams into framesets.
+ *
+ * pushFrame may be called concurrently from the capture threads of different streams, the frames of one stream are always pushed from one
+ * thread at a time. The other methods are called from the pipeline control thread.
+ */
+class IFrameAggregator {
+public:
+    virtual ~IFrameAggregator() noexcept = default;
+
+    virtual void updateConfig(std::shared_ptr<const Config> config, const bool matchingRateFirst) = 0;
+    virtual void pushFrame(std::shared_ptr<const Frame> frame)                                   = 0;
+    virtual void enableFrameSync(FrameSyncMode mode)                                               = 0;
+    virtual void setCallback(FrameCallback callback)                                               = 0;
+
+    virtual void clearFrameQueue(OBFrameType frameType) = 0;
+    virtual void clearAllFrameQueue()                   = 0;
+
+    // Max number of frames of the given type held by the aggregator, 0 if the frame type is not configured
+    virtual uint32_t getMaxQueueSize(OBFrameType frameType) = 0;
+
+    virtual void setPipelineStatusCollector(std::shared_ptr<IPipelineStatusCollector> collector) = 0;
+};
+
+}  // namespace libobsensor
@@ -0,0 +1,379 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "LockFreeFrameAggregator.hpp"
+#include "FrameAggregator.hpp"
+#include "IPipelineStatusCollector.hpp"
+#include "frame/FrameFactory.hpp"
+#include "logger/Logger.hpp"
+#include "logger/LoggerInterval.hpp"
+#include "utils/PublicTypeHelper.hpp"
+
+#include <algorithm>
+
+namespace libobsensor {
+
+#define MATCHER_IDLE_WAIT_MSEC 100
+
+static bool isColorFrameType(OBFrameType frameType) {
+    return frameType == OB_FRAME_COLOR || frameType == OB_FRAME_COLOR_LEFT || frameType == OB_FRAME_COLOR_RIGHT;
+}
+
+void LockFreeFrameAggregator::FrameWindow::reset(size_t capacity) {
+    clear();
+    if(frames_.size() != capacity) {
+        frames_.clear();
+        frames_.resize(capacity);
+    }
+}
+
+void LockFreeFrameAggregator::FrameWindow::push(std::shared_ptr<const Frame> frame) {
+    frames_[(head_ + size_) % frames_.size()] = std::move(frame);
+    size_++;
+}
+
+const std::shared_ptr<const Frame> &LockFreeFrameAggregator::FrameWindow::front() const {
+    return frames_[head_];
+}
+
+std::shared_ptr<const Frame> LockFreeFrameAggregator::FrameWindow::pop() {
+    auto frame = std::move(frames_[head_]);
+    head_      = (head_ + 1) % frames_.size();
+    size_--;
+    return frame;
+}
+
+void LockFreeFrameAggregator::FrameWindow::clear() {
+    while(size_ > 0) {
+        pop();
+    }
+    head_ = 0;
+}
+
+LockFreeFrameAggregator::LockFreeFrameAggregator(float maxFrameDelay)
+    : activeSlots_(),
+      activeCount_(0),
+      sortedSlots_(),
+      frameSyncMode_(FrameSyncModeDisable),
+      frameSetCallbackFunc_(nullptr),
+      frameAggregateOutputMode_(OB_FRAME_AGGREGATE_OUTPUT_ANY_SITUATION),
+      matchingRateFirst_(true),
+      maxNormalModeQueueSize_(MAX_NORMAL_MODE_QUEUE_SIZE),
+      maxFrameDelay_(maxFrameDelay > 0 ? maxFrameDelay : MAX_FRAME_DELAY),
+      waiterCount_(0),
+      pending_(false),
+      stopped_(false) {
+    matcherThread_ = std::thread(&LockFreeFrameAggregator::matcherLoop, this);
+}
+
+LockFreeFrameAggregator::~LockFreeFrameAggregator() noexcept {
+    {
+        std::unique_lock<std::mutex> lk(signalMutex_);
+        stopped_.store(true);
+        signal_.notify_all();
+    }
+    if(matcherThread_.joinable()) {
+        matcherThread_.join();
+    }
+
+    std::unique_lock<std::recursive_mutex> lk(controlMutex_);
+    for(auto &slot: slots_) {
+        slot.enabled.store(false);
+        clearSlot(slot);
+    }
+}
+
+void LockFreeFrameAggregator::updateConfig(std::shared_ptr<const Config> config, const bool matchingRateFirst) {
+    std::unique_lock<std::recursive_mutex> lk(controlMutex_);
+    for(size_t i = 0; i < activeCount_; i++) {
+        activeSlots_[i]->enabled.store(false, std::memory_order_release);
+        clearSlot(*activeSlots_[i]);
+    }
+    activeCount_ = 0;
+
+    frameAggregateOutputMode_ = config->getFrameAggregateOutputMode();
+    matchingRateFirst_        = matchingRateFirst;
+    maxNormalModeQueueSize_   = frameAggregateOutputMode_ == OB_FRAME_AGGREGATE_OUTPUT_DISABLE ? 1 : MAX_NORMAL_MODE_QUEUE_SIZE;
+
+    auto profiles = config->getEnabledStreamProfileList();
+    for(auto &profile: profiles) {
+        auto frameType = utils::mapStreamTypeToFrameType(profile->getType());
+        if(frameType <= OB_FRAME_UNKNOWN || frameType >= OB_FRAME_TYPE_COUNT) {
+            continue;
+        }
+        auto &slot = slots_[frameType];
+        if(std::find(activeSlots_.begin(), activeSlots_.begin() + activeCount_, &slot) != activeSlots_.begin() + activeCount_) {
+            continue;
+        }
+
+        slot.frameType = frameType;
+        calcSourceFrameQueueParam(profile, maxFrameDelay_, frameAggregateOutputMode_, slot.maxSyncQueueSize, slot.halfTspGap);
+        slot.window.reset((std::max)(slot.maxSyncQueueSize, maxNormalModeQueueSize_));
+        if(!slot.ring) {
+            slot.ring.reset(new SpscFrameQueue<const Frame>(kRingCapacity));
+        }
+        activeSlots_[activeCount_++] = &slot;
+    }
+
+    for(size_t i = 0; i < activeCount_; i++) {
+        activeSlots_[i]->enabled.store(true, std::memory_order_release);
+    }
+}
+
+void LockFreeFrameAggregator::pushFrame(std::shared_ptr<const Frame> frame) {
+    auto frameType = frame->getType();
+    if(frameType <= OB_FRAME_UNKNOWN || frameType >= OB_FRAME_TYPE_COUNT) {
+        return;
+    }
+
+    auto &slot = slots_[frameType];
+    if(!slot.enabled.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    bool dropped = false;
+    slot.ring->enforceEnqueue(std::move(frame), dropped);
+    if(dropped) {
+        LOG_WARN_INTVL("Frame aggregator input queue of {} is full, drop oldest frame!", utils::obFrameToStr(frameType));
+        if(pipelineStatusCollector_) {
+            pipelineStatusCollector_->reportSdkStatus(OB_SDK_STATUS_FRAME_QUEUE_OVERFLOW);
+        }
+    }
+    notifyMatcher();
+}
+
+void LockFreeFrameAggregator::notifyMatcher() {
+    // Only the first producer after the matcher has drained the rings signals it, and only if it is sleeping. The signal mutex is taken so
+    // that the wakeup can not be lost between the predicate check and the wait of the matcher.
+    if(!pending_.exchange(true) && waiterCount_.load() > 0) {
+        std::unique_lock<std::mutex> lk(signalMutex_);
+        signal_.notify_one();
+    }
+}
+
+void LockFreeFrameAggregator::matcherLoop() {
+    while(!stopped_.load()) {
+        pending_.store(false);
+
+        bool drained = false;
+        {
+            std::unique_lock<std::recursive_mutex> lk(controlMutex_);
+            drained = drainRings();
+        }
+        if(drained) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lk(signalMutex_);
+        waiterCount_.fetch_add(1);
+        signal_.wait_for(lk, std::chrono::milliseconds(MATCHER_IDLE_WAIT_MSEC), [this] { return pending_.load() || stopped_.load(); });
+        waiterCount_.fetch_sub(1);
+    }
+}
+
+size_t LockFreeFrameAggregator::getWindowLimit(const StreamSlot &slot) const {
+    return frameSyncMode_ == FrameSyncModeDisable ? maxNormalModeQueueSize_ : slot.maxSyncQueueSize;
+}
+
+bool LockFreeFrameAggregator::drainRings() {
+    bool drained = false;
+    while(true) {
+        bool moved = false;
+        for(size_t i = 0; i < activeCount_; i++) {
+            auto  &slot  = *activeSlots_[i];
+            size_t limit = getWindowLimit(slot);
+            while(slot.window.size() < limit) {
+                auto frame = slot.ring->dequeue(0);
+                if(!frame) {
+                    break;
+                }
+                slot.window.push(std::move(frame));
+                moved = true;
+            }
+        }
+        if(!moved) {
+            break;
+        }
+        drained = true;
+        tryAggregator();
+    }
+    return drained;
+}
+
+void LockFreeFrameAggregator::tryAggregator() {
+    if(activeCount_ == 0) {
+        return;
+    }
+
+    while(true) {
+        bool withEmptyQueue    = false;
+        bool withOverflowQueue = false;
+        for(size_t i = 0; i < activeCount_; i++) {
+            auto &slot = *activeSlots_[i];
+            if(slot.window.empty()) {
+                withEmptyQueue = true;
+            }
+            else if(slot.window.size() >= getWindowLimit(slot)) {
+                withOverflowQueue = true;
+            }
+        }
+        if(withEmptyQueue && !withOverflowQueue) {
+            break;
+        }
+
+        auto frameSet = FrameFactory::createFrameSet();
+        if(!frameSet) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));  // Wait for 100ms and then try again to see if the request can succeed.
+            continue;
+        }
+
+        uint32_t frameCnt       = 0;
+        bool     withColorFrame = false;
+        auto     takeFrame      = [&](StreamSlot &slot) {
+            frameSet->pushFrame(slot.window.pop());
+            frameCnt++;
+            withColorFrame |= isColorFrameType(slot.frameType);
+        };
+
+        if(activeCount_ > 1 && frameSyncMode_) {
+            // Timestamp merge of the window heads, insertion sort on a fixed buffer (a few streams at most)
+            size_t sortedCount = 0;
+            for(size_t i = 0; i < activeCount_; i++) {
+                auto slot = activeSlots_[i];
+                if(slot->window.empty()) {
+                    continue;
+                }
+                auto   tsp = getFrameTimestampMsec(slot->window.front(), frameSyncMode_);
+                size_t pos = sortedCount++;
+                while(pos > 0 && getFrameTimestampMsec(sortedSlots_[pos - 1]->window.front(), frameSyncMode_) > tsp) {
+                    sortedSlots_[pos] = sortedSlots_[pos - 1];
+                    pos--;
+                }
+                sortedSlots_[pos] = slot;
+            }
+
+            auto refTsp        = getFrameTimestampMsec(sortedSlots_[0]->window.front(), frameSyncMode_);
+            auto refHalfTspGap = sortedSlots_[0]->halfTspGap;
+            if(matchingRateFirst_ && activeCount_ != 2) {  // Match rate priority
+                for(size_t i = 0; i < sortedCount; i++) {
+                    auto    &slot       = *sortedSlots_[i];
+                    uint32_t tspHalfGap = (std::min)(slot.halfTspGap, refHalfTspGap);
+                    auto     tarTsp     = getFrameTimestampMsec(slot.window.front(), frameSyncMode_);
+                    if(tarTsp - refTsp > tspHalfGap) {
+                        break;
+                    }
+                    refTsp        = tarTsp;  // After dequeuing, save the current reference timestamp to use as a reference for the next loop.
+                    refHalfTspGap = slot.halfTspGap;
+                    takeFrame(slot);
+                }
+            }
+            else {  // Match precision priority, the reference is the oldest frame
+                for(size_t i = 0; i < sortedCount; i++) {
+                    auto    &slot       = *sortedSlots_[i];
+                    uint32_t tspHalfGap = (std::min)(slot.halfTspGap, refHalfTspGap);
+                    auto     tarTsp     = getFrameTimestampMsec(slot.window.front(), frameSyncMode_);
+                    if(tarTsp - refTsp <= tspHalfGap) {
+                        takeFrame(slot);
+                    }
+                }
+            }
+        }
+        else {
+            // Asynchronous matching
+            for(size_t i = 0; i < activeCount_; i++) {
+                auto &slot = *activeSlots_[i];
+                if(!slot.window.empty() && (!withEmptyQueue || slot.window.size() >= maxNormalModeQueueSize_)) {
+                    takeFrame(slot);
+                }
+            }
+        }
+        outputFrameset(frameSet, frameCnt, withColorFrame);
+    }
+}
+
+void LockFreeFrameAggregator::outputFrameset(std::shared_ptr<const FrameSet> frameSet, uint32_t frameCnt, bool withColorFrame) {
+    if(!frameSetCallbackFunc_) {
+        return;
+    }
+
+    if(activeCount_ == 1 || frameAggregateOutputMode_ == OB_FRAME_AGGREGATE_OUTPUT_ANY_SITUATION) {
+        frameSetCallbackFunc_(frameSet);
+    }
+    else if(frameAggregateOutputMode_ == OB_FRAME_AGGREGATE_OUTPUT_COLOR_FRAME_REQUIRE && withColorFrame) {
+        frameSetCallbackFunc_(frameSet);
+    }
+    else if(frameAggregateOutputMode_ == OB_FRAME_AGGREGATE_OUTPUT_ALL_TYPE_FRAME_REQUIRE && frameCnt == activeCount_) {
+        frameSetCallbackFunc_(frameSet);
+    }
+    else if(frameAggregateOutputMode_ == OB_FRAME_AGGREGATE_OUTPUT_DISABLE) {
+        frameSetCallbackFunc_(frameSet);
+    }
+    else {
+        uint32_t count = frameSet->getCount();
+        for(uint32_t i = 0; i < count; i++) {
+            auto frame = frameSet->getFrame(i);
+            if(frame != nullptr) {
+                LOG_DEBUG("The frame {} was dropped, frameCnt:{}, system timestamp:{}, device timestamp:{}, index:{}", utils::obFrameToStr(frame->getType()),
+                          frameCnt, frame->getSystemTimeStampUsec(), frame->getTimeStampUsec(), frame->getNumber());
+            }
+        }
+        if(pipelineStatusCollector_) {
+            pipelineStatusCollector_->reportSdkStatus(OB_SDK_STATUS_FRAME_DROP_MATCH);
+        }
+    }
+}
+
+void LockFreeFrameAggregator::enableFrameSync(FrameSyncMode mode) {
+    std::unique_lock<std::recursive_mutex> lk(controlMutex_);
+    if(frameSyncMode_ != mode) {
+        frameSyncMode_ = mode;
+        clearAllFrameQueue();
+    }
+}
+
+void LockFreeFrameAggregator::setCallback(FrameCallback callback) {
+    std::unique_lock<std::recursive_mutex> lk(controlMutex_);
+    frameSetCallbackFunc_ = callback;
+}
+
+void LockFreeFrameAggregator::setPipelineStatusCollector(std::shared_ptr<IPipelineStatusCollector> collector) {
+    std::unique_lock<std::recursive_mutex> lk(controlMutex_);
+    pipelineStatusCollector_ = std::move(collector);
+}
+
+void LockFreeFrameAggregator::clearSlot(StreamSlot &slot) {
+    if(slot.ring) {
+        while(slot.ring->dequeue(0)) {
+        }
+    }
+    slot.window.clear();
+}
+
+void LockFreeFrameAggregator::clearFrameQueue(OBFrameType frameType) {
+    if(frameType <= OB_FRAME_UNKNOWN || frameType >= OB_FRAME_TYPE_COUNT) {
+        return;
+    }
+    std::unique_lock<std::recursive_mutex> lk(controlMutex_);
+    clearSlot(slots_[frameType]);
+}
+
+void LockFreeFrameAggregator::clearAllFrameQueue() {
+    std::unique_lock<std::recursive_mutex> lk(controlMutex_);
+    for(size_t i = 0; i < activeCount_; i++) {
+        clearSlot(*activeSlots_[i]);
+    }
+}
+
+uint32_t LockFreeFrameAggregator::getMaxQueueSize(OBFrameType frameType) {
+    if(frameType <= OB_FRAME_UNKNOWN || frameType >= OB_FRAME_TYPE_COUNT) {
+        return 0;
+    }
+    std::unique_lock<std::recursive_mutex> lk(controlMutex_);
+    auto                                   &slot = slots_[frameType];
+    if(!slot.enabled.load()) {
+        return 0;
+    }
+    return static_cast<uint32_t>(getWindowLimit(slot));
+}
+
+}  // namespace libobsensor
@@ -0,0 +1,112 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "libobsensor/h/ObTypes.h"
+#include "frame/Frame.hpp"
+#include "frame/SpscFrameQueue.hpp"
+#include "utils/SteadyCondVar.hpp"
+#include "IFrameAggregator.hpp"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace libobsensor {
+
+// Frame aggregator with lock-free multi-producer input (OB_FRAME_AGGREGATE_ENGINE_LOCK_FREE).
+//
+// Design notes:
+//   - Each frame type owns a SPSC ring (SpscFrameQueue), pushFrame only enqueues into the ring of the frame type, so capture threads of
+//     different streams never wait for each other nor for the matching. When the matcher falls behind, the oldest frame of the ring is
+//     dropped and OB_SDK_STATUS_FRAME_QUEUE_OVERFLOW is reported.
+//   - A single matcher thread drains the rings into fixed-size per-stream windows and merges them by timestamp with the same rules as
+//     FrameAggregator (match rate priority / match precision priority / asynchronous), so the output follows the same
+//     OBFrameAggregateOutputMode semantics. Windows and ordering buffers are sized in updateConfig, the matching loop does not allocate.
+//   - The matcher thread holds controlMutex_ while matching, control calls (updateConfig, clearAllFrameQueue, enableFrameSync, ...) take
+//     the same lock so that they never run concurrently with the matching and the frameset callback.
+class LockFreeFrameAggregator : public IFrameAggregator {
+public:
+    LockFreeFrameAggregator(float maxFrameDelay = 0.0f);
+    ~LockFreeFrameAggregator() noexcept override;
+
+    void updateConfig(std::shared_ptr<const Config> config, const bool matchingRateFirst) override;
+    void pushFrame(std::shared_ptr<const Frame> frame) override;
+    void enableFrameSync(FrameSyncMode mode) override;
+    void setCallback(FrameCallback callback) override;
+
+    void clearFrameQueue(OBFrameType frameType) override;
+    void clearAllFrameQueue() override;
+
+    uint32_t getMaxQueueSize(OBFrameType frameType) override;
+
+    void setPipelineStatusCollector(std::shared_ptr<IPipelineStatusCollector> collector) override;
+
+private:
+    // Fixed capacity FIFO of the frames of one stream waiting to be matched, only accessed with controlMutex_ held
+    class FrameWindow {
+    public:
+        void                                reset(size_t capacity);
+        void                                push(std::shared_ptr<const Frame> frame);
+        const std::shared_ptr<const Frame> &front() const;
+        std::shared_ptr<const Frame>        pop();
+        void                                clear();
+        size_t                              size() const {
+            return size_;
+        }
+        bool empty() const {
+            return size_ == 0;
+        }
+
+    private:
+        std::vector<std::shared_ptr<const Frame>> frames_;
+        size_t                                    head_ = 0;
+        size_t                                    size_ = 0;
+    };
+
+    struct StreamSlot {
+        std::atomic<bool>                            enabled{ false };
+        std::unique_ptr<SpscFrameQueue<const Frame>> ring;  // created on first use and kept until destruction, producers may hold it
+        FrameWindow                                  window;
+        OBFrameType                                  frameType        = OB_FRAME_UNKNOWN;
+        uint32_t                                     maxSyncQueueSize = 0;
+        uint32_t                                     halfTspGap       = 0;
+    };
+
+    void   matcherLoop();
+    bool   drainRings();
+    void   tryAggregator();
+    void   outputFrameset(std::shared_ptr<const FrameSet> frameSet, uint32_t frameCnt, bool withColorFrame);
+    void   clearSlot(StreamSlot &slot);
+    size_t getWindowLimit(const StreamSlot &slot) const;
+    void   notifyMatcher();
+
+private:
+    static constexpr size_t kRingCapacity = 64;
+
+    std::array<StreamSlot, OB_FRAME_TYPE_COUNT>   slots_;
+    std::array<StreamSlot *, OB_FRAME_TYPE_COUNT> activeSlots_;
+    size_t                                        activeCount_;
+    std::array<StreamSlot *, OB_FRAME_TYPE_COUNT> sortedSlots_;  // scratch buffer of the timestamp merge
+
+    std::recursive_mutex       controlMutex_;
+    FrameSyncMode              frameSyncMode_;
+    FrameCallback              frameSetCallbackFunc_;
+    OBFrameAggregateOutputMode frameAggregateOutputMode_;
+    bool                       matchingRateFirst_;
+    uint32_t                   maxNormalModeQueueSize_;
+    float                      maxFrameDelay_;
+
+    std::mutex           signalMutex_;
+    utils::SteadyCondVar signal_;
+    std::atomic<int>     waiterCount_;
+    std::atomic<bool>    pending_;  // set by producers, cleared by the matcher before draining the rings
+    std::atomic<bool>    stopped_;
+    std::thread          matcherThread_;
+
+    std::shared_ptr<IPipelineStatusCollector> pipelineStatusCollector_;
+};
+}  // namespace libobsensor
@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "Pipeline.hpp"
+#include "FrameAggregator.hpp"
+#include "LockFreeFrameAggregator.hpp"
 
 #include "common/DevicePids.hpp"
 #include "context/Context.hpp"
@@ -12,9 +14,12 @@
 #include "exception/ObException.hpp"
 #include "IAlgParamManager.hpp"
 #include "frameprocessor/FrameProcessor.hpp"
+#include "frame/FrameFactory.hpp"
+#include "frame/FrameMemoryPool.hpp"
 
 #include <cmath>
 #include <algorithm>
+#include <thread>
 
 #include "logger/LoggerSnWrapper.hpp"  // Must be included last to override log macros
 
@@ -22,7 +27,28 @@ namespace libobsensor {
 
 #define GetCurrentSN() device_->getSn()
 
-Pipeline::Pipeline(std::shared_ptr<IDevice> dev) : device_(dev), config_(nullptr), streamState_(STREAM_STATE_STOPPED), pipelineCallback_(nullptr) {
+namespace {
+
+// Nesting of the frameset callbacks on this thread, see releaseRetiredFrameAggregators
+thread_local int outputCallbackDepth = 0;
+
+struct OutputCallbackScope {
+    OutputCallbackScope() {
+        outputCallbackDepth++;
+    }
+    ~OutputCallbackScope() {
+        outputCallbackDepth--;
+    }
+};
+
+}  // namespace
+
+Pipeline::Pipeline(std::shared_ptr<IDevice> dev)
+    : device_(dev),
+      config_(nullptr),
+      streamState_(STREAM_STATE_STOPPED),
+      pipelineCallback_(nullptr),
+      statusCollector_(std::make_shared<PipelineStatusCollector>(dev.get())) {
     LOG_DEBUG("Pipeline init ...");
     auto sensorTypeList = device_->getSensorTypeList();
     if(sensorTypeList.empty()) {
@@ -31,10 +57,10 @@ Pipeline::Pipeline(std::shared_ptr<IDevice> dev) : device_(dev), config_(nullptr
 
     loadFrameQueueSizeConfig();
     loadMaxFrameDelayConfig();
+    loadFrameBufferPreallocateConfig();
 
-    outputFrameQueue_ = std::make_shared<FrameQueue<const Frame>>(maxFrameQueueSize_);
+    outputFrameQueue_ = std::make_shared<MpscFrameQueue<const Frame>>(maxFrameQueueSize_);
 
-    statusCollector_ = std::make_shared<PipelineStatusCollector>(device_.get());
     statusCollector_->setExternalCollector([this]() {
         for(auto &sensor: activeSensors_) {
             uint64_t dropStatus = sensor->getAndResetDroppedFrameStatus();
@@ -44,9 +70,7 @@ Pipeline::Pipeline(std::shared_ptr<IDevice> dev) : device_(dev), config_(nullptr
         }
     });
 
-    frameAggregator_ = std::make_shared<FrameAggregator>(maxFrameDelay_);
-    frameAggregator_->setCallback([&](std::shared_ptr<const Frame> frame) { outputFrame(frame); });
-    frameAggregator_->setPipelineStatusCollector(statusCollector_);
+    createFrameAggregator(OB_FRAME_AGGREGATE_ENGINE_DEFAULT);
 
     TRY_EXECUTE(enableFrameSync());
 
@@ -61,6 +85,11 @@ Pipeline::~Pipeline() noexcept {
         TRY_EXECUTE(stop());
     }
 
+    auto aggregator = std::atomic_exchange(&frameAggregator_, std::shared_ptr<IFrameAggregator>());
+    if(aggregator) {
+        retiredFrameAggregators_.push_back(std::move(aggregator));
+    }
+    releaseRetiredFrameAggregators();
     outputFrameQueue_->reset();
     LOG_INFO("Pipeline destroyed! @0x{:X}", (uint64_t)this);
 }
@@ -151,6 +180,12 @@ void Pipeline::loadFrameQueueSizeConfig() {
     LOG_DEBUG("loadFrameQueueSizeConfig() config queue size: {}", maxFrameQueueSize_);
 }
 
+void Pipeline::loadFrameBufferPreallocateConfig() {
+    auto envConfig = EnvConfig::getInstance();
+    envConfig->getBooleanValue("Memory.PreallocateFrameBuffers", frameBufferPreallocate_);
+    LOG_DEBUG("loadFrameBufferPreallocateConfig() config frame buffer preallocate: {}", frameBufferPreallocate_);
+}
+
 void Pipeline::loadMaxFrameDelayConfig() {
     auto envConfig = EnvConfig::getInstance();
 
@@ -238,6 +273,9 @@ void Pipeline::start(std::shared_ptr<const Config> cfg) {
         configAlignMode();
     }
 
+    if(config_->getFrameAggregateEngine() != frameAggregateEngine_) {
+        createFrameAggregator(config_->getFrameAggregateEngine());
+    }
     frameAggregator_->updateConfig(config_, true);
 
     streamState_ = STREAM_STATE_STARTING;
@@ -270,6 +308,10 @@ void Pipeline::startStream() {
     statusCollector_->clearActivePorts();
     activeSensors_.clear();
 
+    if(frameBufferPreallocate_ || config_->isFrameBufferPreallocateEnabled()) {
+        TRY_EXECUTE(reserveFrameBuffers());
+    }
+
     auto spList = config_->getEnabledStreamProfileList();
     for(const auto &sp: spList) {
         auto streamType = sp->getType();
@@ -293,11 +335,59 @@ void Pipeline::startStream() {
     LOG_INFO("Start streams done!");
 }
 
+void Pipeline::reserveFrameBuffers() {
+    // Frames that can be alive at the same time for each stream:
+    //   the frame aggregator queue + the frames held by the pipeline output queue (or by the user callback)
+    //   + frames in flight (being captured, being converted/processed by the sensor and being used by the user)
+    const size_t inFlightFrameCount = 3;
+    const size_t outputFrameCount   = pipelineCallback_ ? 1 : static_cast<size_t>(maxFrameQueueSize_);
+    const size_t maxBufferCount     = 100;  // same as the max idle buffers kept by a frame buffer manager
+
+    auto memoryPool = FrameMemoryPool::getInstance();
+    // Do not let pre-allocated buffers take more than half of the remaining frame memory budget
+    uint64_t budget    = FrameMemoryPool::getAvailableMemorySize() / 2;
+    uint64_t allocated = 0;
+
+    auto reserve = [&](OBFrameType frameType, std::shared_ptr<IFrameBufferManager> bufMgr, size_t count) {
+        auto bufferSize = bufMgr->getFrameBufferTotalSize();
+        auto remaining  = allocated < budget ? budget - allocated : 0;
+        count           = std::min<size_t>(count, maxBufferCount);
+        if(bufferSize * count > remaining) {
+            count = static_cast<size_t>(remaining / bufferSize);
+            LOG_WARN("Frame memory budget is not enough to pre-allocate all frame buffers, frameType={}, count={}", frameType, count);
+        }
+        auto reserved = bufMgr->reserveBuffers(count);
+        if(reserved < count) {
+            LOG_WARN("Only {} of {} frame buffers pre-allocated, frameType={}, the remaining ones will be allocated on demand", reserved, count, frameType);
+        }
+        allocated += reserved * bufferSize;
+        LOG_DEBUG("Pre-allocated frame buffers: frameType={}, bufferSize={}, count={}", frameType, bufferSize, reserved);
+    };
+
+    auto spList = config_->getEnabledStreamProfileList();
+    for(const auto &sp: spList) {
+        auto frameType = utils::mapStreamTypeToFrameType(sp->getType());
+        auto bufMgr    = memoryPool->createFrameBufferManager(frameType, sp);
+        if(!bufMgr) {
+            continue;
+        }
+        auto count = frameAggregator_->getMaxQueueSize(frameType) + outputFrameCount + inFlightFrameCount;
+        reserve(frameType, bufMgr, count);
+    }
+
+    auto frameSetBufMgr = memoryPool->createFrameBufferManager(OB_FRAME_SET, FrameFactory::getFrameSetDataSize());
+    reserve(OB_FRAME_SET, frameSetBufMgr, outputFrameCount + inFlightFrameCount);
+
+    LOG_INFO("Frame buffers pre-allocated for {} streams, total size={:.3f}MB", spList.size(), byteToMB(allocated));
+}
+
 void Pipeline::onFrameCallback(std::shared_ptr<const Frame> frame) {
-    std::unique_lock<std::mutex> lk(streamMutex_);
-    if(streamState_ != STREAM_STATE_STOPPED && streamState_ != STREAM_STATE_STOPPING) {
-        if(streamState_ == STREAM_STATE_STARTING) {
-            streamState_ = STREAM_STATE_STREAMING;
+    // Called concurrently by the capture threads of all streams, the frame aggregator does its own synchronization. The aggregator is
+    // taken with atomic_load: createFrameAggregator() may replace it while the callbacks of the previous streams are still running.
+    auto state = streamState_.load();
+    if(state != STREAM_STATE_STOPPED && state != STREAM_STATE_STOPPING) {
+        if(state == STREAM_STATE_STARTING) {
+            streamState_.compare_exchange_strong(state, STREAM_STATE_STREAMING);
         }
 
         auto sp = frame->getStreamProfile();
@@ -305,10 +395,13 @@ void Pipeline::onFrameCallback(std::shared_ptr<const Frame> frame) {
             statusCollector_->reportFrameReceived(sp->getType());
         }
 
-        frameAggregator_->pushFrame(frame);
+        auto aggregator = std::atomic_load(&frameAggregator_);
+        if(aggregator) {
+            aggregator->pushFrame(frame);
+        }
     }
     auto frameType = frame->getType();
-    LOG_INTVL(LOG_INTVL_OBJECT_TAG + std::to_string(frameType), DEF_MIN_LOG_INTVL, spdlog::level::debug, "[{}] Frame received on pipeline! type={}",
+    LOG_INTVL(LOG_INTVL_OBJECT_TAG + frameType, DEF_MIN_LOG_INTVL, spdlog::level::debug, "[{}] Frame received on pipeline! type={}",
               GetCurrentSN(), frameType);
 }
 
@@ -316,16 +409,17 @@ void Pipeline::outputFrame(std::shared_ptr<const Frame> frame) {
     LOG_FREQ_CALC(DEBUG, 5000, "Pipeline {}, frameset output rate={freq}fps", STREAM_STATE_STR(streamState_));
     if(streamState_ == STREAM_STATE_STREAMING) {
         if(pipelineCallback_ != nullptr) {
+            OutputCallbackScope scope;
             pipelineCallback_(frame);
             return;
         }
 
-        if(outputFrameQueue_->fulled()) {
+        bool dropped = false;
+        outputFrameQueue_->enforceEnqueue(std::move(frame), dropped);
+        if(dropped) {
             LOG_WARN_INTVL("[{}] Output frameset queue is full, drop oldest frameset!", GetCurrentSN());
             statusCollector_->reportSdkStatus(OB_SDK_STATUS_FRAME_QUEUE_OVERFLOW);
-            outputFrameQueue_->dequeue();
         }
-        outputFrameQueue_->enqueue(std::move(frame));
     }
 }
 
@@ -389,6 +483,8 @@ void Pipeline::stop() {
     // clear callback
     pipelineCallback_ = nullptr;
 
+    releaseRetiredFrameAggregators();
+
     streamState_ = STREAM_STATE_STOPPED;
     LOG_INFO("Stop pipeline done!");
 }
@@ -607,16 +703,56 @@ OBCalibrationParam Pipeline::getCalibrationParam(std::shared_ptr<Config> cfg) {
 
 void Pipeline::enableFrameSync() {
     if(device_->getExtensionInfo("AllSensorsUsingSameClock") == "true") {
-        frameAggregator_->enableFrameSync(FrameSyncModeSyncAccordingFrameTimestamp);
+        frameSyncMode_ = FrameSyncModeSyncAccordingFrameTimestamp;
     }
     else {
         LOG_WARN("Frame sync is not supported for sensors with different clocks! Use system timestamp instead, the accuracy may be lower!");
-        frameAggregator_->enableFrameSync(FrameSyncModeSyncAccordingSystemTimestamp);
+        frameSyncMode_ = FrameSyncModeSyncAccordingSystemTimestamp;
     }
+    frameAggregator_->enableFrameSync(frameSyncMode_);
 }
 
 void Pipeline::disableFrameSync() {
-    frameAggregator_->enableFrameSync(FrameSyncModeDisable);
+    frameSyncMode_ = FrameSyncModeDisable;
+    frameAggregator_->enableFrameSync(frameSyncMode_);
+}
+
+void Pipeline::createFrameAggregator(OBFrameAggregateEngine engine) {
+    std::shared_ptr<IFrameAggregator> aggregator;
+    if(engine == OB_FRAME_AGGREGATE_ENGINE_LOCK_FREE) {
+        aggregator = std::make_shared<LockFreeFrameAggregator>(maxFrameDelay_);
+    }
+    else {
+        aggregator = std::make_shared<FrameAggregator>(maxFrameDelay_);
+    }
+    aggregator->setCallback([&](std::shared_ptr<const Frame> frame) { outputFrame(frame); });
+    aggregator->setPipelineStatusCollector(statusCollector_);
+    aggregator->enableFrameSync(frameSyncMode_);
+
+    // Publish the configured engine at once. A frame callback still running with the previous engine keeps it alive until its pushFrame
+    // returns, the previous engine is retired and destroyed (its matcher thread joined) on the control thread.
+    auto previous = std::atomic_exchange(&frameAggregator_, aggregator);
+    if(previous) {
+        retiredFrameAggregators_.push_back(std::move(previous));
+    }
+    releaseRetiredFrameAggregators();
+    frameAggregateEngine_ = engine;
+    LOG_DEBUG("Frame aggregator created, engine={}", engine == OB_FRAME_AGGREGATE_ENGINE_LOCK_FREE ? "lock-free" : "default");
+}
+
+void Pipeline::releaseRetiredFrameAggregators() {
+    // The frameset callback may run on the matcher thread of a retired aggregator, which its destructor joins: keep them until the next call
+    // from outside of the callback
+    if(outputCallbackDepth > 0) {
+        return;
+    }
+    for(auto &aggregator: retiredFrameAggregators_) {
+        // Let the capture threads still pushing into it return, they must not release it and join its matcher thread
+        while(aggregator.use_count() > 1) {
+            std::this_thread::yield();
+        }
+    }
+    retiredFrameAggregators_.clear();
 }
 
 void Pipeline::checkHardwareD2CConfig() {
@@ -5,11 +5,13 @@
 #include "IPipeline.hpp"
 #include "IDevice.hpp"
 #include "IFrame.hpp"
-#include "frame/FrameQueue.hpp"
+#include "frame/MpscFrameQueue.hpp"
 #include "Config.hpp"
-#include "FrameAggregator.hpp"
+#include "IFrameAggregator.hpp"
 #include "PipelineStatusCollector.hpp"
 
+#include <atomic>
+
 namespace libobsensor {
 class Config;
 class ISensor;
@@ -52,6 +54,12 @@ private:
     void loadDefaultConfig();
     void loadFrameQueueSizeConfig();
     void loadMaxFrameDelayConfig();
+    void loadFrameBufferPreallocateConfig();
+
+    void reserveFrameBuffers();
+
+    void createFrameAggregator(OBFrameAggregateEngine engine);
+    void releaseRetiredFrameAggregators();
 
     void configAlignMode();
     void resetAlignMode();
@@ -67,19 +75,25 @@ private:
     std::shared_ptr<IDevice>      device_;
     std::shared_ptr<const Config> config_;
 
-    OBStreamState streamState_;
-    std::mutex    streamMutex_;
+    std::atomic<OBStreamState> streamState_;
+    std::mutex                 streamMutex_;
+
+    std::shared_ptr<MpscFrameQueue<const Frame>> outputFrameQueue_;
+    FrameCallback                                pipelineCallback_;
 
-    std::shared_ptr<FrameQueue<const Frame>> outputFrameQueue_;
-    FrameCallback                            pipelineCallback_;
+    std::shared_ptr<IFrameAggregator> frameAggregator_;  // replaced with atomic_exchange, read with atomic_load by the frame callbacks
+    OBFrameAggregateEngine            frameAggregateEngine_ = OB_FRAME_AGGREGATE_ENGINE_DEFAULT;
+    FrameSyncMode                     frameSyncMode_        = FrameSyncModeDisable;
 
-    std::shared_ptr<FrameAggregator> frameAggregator_;
+    std::vector<std::shared_ptr<IFrameAggregator>> retiredFrameAggregators_;  // replaced aggregators, destroyed on the control thread
 
-    std::shared_ptr<PipelineStatusCollector> statusCollector_;
+    // Created with the pipeline and never replaced, the frame callbacks use it without synchronization (it synchronizes internally)
+    const std::shared_ptr<PipelineStatusCollector> statusCollector_;
     std::vector<std::shared_ptr<ISensor>>    activeSensors_;
 
-    int   maxFrameQueueSize_ = 10;
-    float maxFrameDelay_     = 0.0f;
+    int   maxFrameQueueSize_      = 10;
+    float maxFrameDelay_          = 0.0f;
+    bool  frameBufferPreallocate_ = false;  // loaded from Memory.PreallocateFrameBuffers
 };
 
 }  // namespace libobsensor
@@ -0,0 +1,71 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "SourcePortMap.hpp"
+
+#include <algorithm>
+
+namespace libobsensor {
+
+std::shared_ptr<ISourcePort> SourcePortMap::getOrOpen(const std::shared_ptr<const SourcePortInfo> &portInfo, const OpenPortFunc &openPort) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto                         port = findOrReserve(lock, portInfo);
+        if(port != nullptr) {
+            return port;
+        }
+    }
+
+    std::shared_ptr<ISourcePort> port;
+    try {
+        port = openPort();
+    }
+    catch(...) {
+        finishOpening(portInfo, nullptr);
+        throw;
+    }
+    finishOpening(portInfo, port);
+    return port;
+}
+
+std::shared_ptr<ISourcePort> SourcePortMap::findOrReserve(std::unique_lock<std::mutex> &lock, const std::shared_ptr<const SourcePortInfo> &portInfo) {
+    auto isOpening = [&]() {
+        return std::any_of(openingPorts_.begin(), openingPorts_.end(),
+                           [&](const std::shared_ptr<const SourcePortInfo> &openingPort) { return openingPort->equal(portInfo); });
+    };
+    openingCv_.wait(lock, [&]() { return !isOpening(); });
+
+    // clear expired weak_ptr
+    for(auto it = ports_.begin(); it != ports_.end();) {
+        if(it->second.expired()) {
+            it = ports_.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    // check if the port already exists in the map
+    for(const auto &pair: ports_) {
+        if(pair.first->equal(portInfo)) {
+            auto port = pair.second.lock();
+            if(port != nullptr) {
+                return port;
+            }
+        }
+    }
+
+    openingPorts_.push_back(portInfo);
+    return nullptr;
+}
+
+void SourcePortMap::finishOpening(const std::shared_ptr<const SourcePortInfo> &portInfo, std::shared_ptr<ISourcePort> port) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if(port != nullptr) {
+        ports_.insert(std::make_pair(portInfo, port));
+    }
+    openingPorts_.erase(std::find(openingPorts_.begin(), openingPorts_.end(), portInfo));
+    openingCv_.notify_all();
+}
+
+}  // namespace libobsensor
@@ -0,0 +1,41 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "ISourcePort.hpp"
+#include "SourcePortInfo.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace libobsensor {
+
+// Open source ports of a pal, shared by the devices and sensors using the same port.
+// The ports are opened without the lock, so that the ports of different devices open in parallel; the threads opening the same port wait for
+// the first one and get its port.
+class SourcePortMap {
+public:
+    typedef std::function<std::shared_ptr<ISourcePort>()> OpenPortFunc;
+
+    // Returns the open port of portInfo, else opens it with openPort. Exceptions of openPort are rethrown, the next caller opens the port again.
+    std::shared_ptr<ISourcePort> getOrOpen(const std::shared_ptr<const SourcePortInfo> &portInfo, const OpenPortFunc &openPort);
+
+private:
+    // Returns the open port, else waits if another thread is opening the port, else marks the port as opening by the caller, who must then
+    // call finishOpening
+    std::shared_ptr<ISourcePort> findOrReserve(std::unique_lock<std::mutex> &lock, const std::shared_ptr<const SourcePortInfo> &portInfo);
+    void                         finishOpening(const std::shared_ptr<const SourcePortInfo> &portInfo, std::shared_ptr<ISourcePort> port);
+
+private:
+    std::mutex                                                                  mutex_;
+    std::map<std::shared_ptr<const SourcePortInfo>, std::weak_ptr<ISourcePort>> ports_;
+    std::vector<std::shared_ptr<const SourcePortInfo>>                          openingPorts_;
+    std::condition_variable                                                     openingCv_;
+};
+
+}  // namespace libobsensor
@@ -19,7 +19,6 @@
 
 #endif
 
-#include <thread>
 #include <algorithm>
 #include <iostream>
 #include <string>
@@ -70,91 +69,9 @@ GVCPClient::~GVCPClient() {
 std::vector<GVCPDeviceInfo> GVCPClient::queryNetDeviceList() {
     std::lock_guard<std::mutex> lck(queryMtx_);
 
-    auto tmpList = devInfoList_;
-    devInfoList_.clear();
-
     checkAndUpdateSockets();
-    std::vector<std::thread> threads;
-    try {
-        for(int i = 0; i < sockCount_; ++i) {
-            threads.emplace_back(&GVCPClient::sendGVCPDiscovery, this, socketInfos_[i]);
-        }
-    }
-    catch(const std::exception &e) {
-        LOG_ERROR("GVCPClient: failed to create discovery thread: {}", e.what());
-        for(auto &t: threads) {
-            if(t.joinable()) {
-                t.join();
-            }
-        }
-        return tmpList;
-    }
-
-    for(auto &thread: threads) {
-        thread.join();
-    }
-
-    // devInfoList_ remove duplication
-    if(!devInfoList_.empty()) {
-        auto iter = devInfoList_.begin();
-        while(iter != devInfoList_.end()) {
-            auto it = std::find_if(iter + 1, devInfoList_.end(), [&](const GVCPDeviceInfo &other) { return *iter == other; });
-            if(it != devInfoList_.end()) {
-                devInfoList_.erase(it);
-                continue;
-            }
-            iter++;
-        }
-    }
-    // devInfoList_ remove duplication from different virtual netinterface bind to the same physical netinterface
-    if(devInfoList_.size() > 1) {
-        // devInfoList_ to map
-        std::map<std::string, std::vector<GVCPDeviceInfo>> groups;
-        for(auto &info: devInfoList_) {
-            groups[info.mac].push_back(info);
-        }
-        devInfoList_.clear();
-        for(auto &infos: groups) {
-            GVCPDeviceInfo *best = nullptr;
-            for(auto &info: infos.second) {
-                if(utils::isSameSubnet(info.localIp, info.ip, info.localSubnetLength)) {
-                    best = &info;
-                    break;
-                }
-            }
-            if(!best) {
-                std::sort(infos.second.begin(), infos.second.end(), [](const GVCPDeviceInfo &a, const GVCPDeviceInfo &b) { return a.localIp < b.localIp; });
-                best = &infos.second[0];
-            }
-            devInfoList_.push_back(*best);
-        }
-    }
-
-    // Compare two std::vector:
-    // 1. elements are unique in both vectors
-    // 2. order of the item may be different
-    auto compare = [](const std::vector<GVCPDeviceInfo> &vec1, std::vector<GVCPDeviceInfo> &vec2) -> bool {
-        if(vec1.size() != vec2.size()) {
-            return false;
-        }
-        // For small vectors, linear search might be faster
-        for(const auto &item: vec2) {
-            if(std::find(vec1.begin(), vec1.end(), item) == vec1.end()) {
-                return false;
-            }
-        }
-
-        return true;
-    };
-
-    if(!compare(tmpList, devInfoList_)) {
-        LOG_DEBUG("queryNetDevice completed ({}):", devInfoList_.size());
-        for(auto &&info: devInfoList_) {
-            LOG_DEBUG("\t- mac:{}, ip:{}, sn:{}, pid:0x{:04x}, localIp: {}", info.mac, info.ip, info.sn, info.pid, info.localIp);
-        }
-    }
-
-    return devInfoList_;
+    std::vector<GVCPSocketInfo> socketInfos(socketInfos_, socketInfos_ + sockCount_);
+    return discoveryEngine_.discover(socketInfos, runtimeConfig_->getGvcpPort());
 }
 
 bool GVCPClient::forceIpConfig(std::string macAddress, const OBNetIpConfig &config) {
@@ -460,7 +377,7 @@ SOCKET GVCPClient::openClientSocket(SOCKADDR_IN addr) {
     // addr.sin_addr.s_addr = inet_addr("0.0.0.0");
 #endif
     std::string ip = inet_ntoa(addr.sin_addr);
-    LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP bind", MAX_LOG_INTERVAL, spdlog::level::debug, "bind {}:{}", ip, ntohs(addr.sin_port));
+    LOG_INTVL(LOG_INTVL_OBJECT_TAG, MAX_LOG_INTERVAL, spdlog::level::debug, "bind {}:{}", ip, ntohs(addr.sin_port));
     err = bind(sock, (SOCKADDR *)&addr, sizeof(SOCKADDR));
     if(err == SOCKET_ERROR) {
         closesocket(sock);
@@ -470,208 +387,6 @@ SOCKET GVCPClient::openClientSocket(SOCKADDR_IN addr) {
     return sock;
 }
 
-int GVCPClient::recvAndParseGVCPResponse(SOCKET sock, const GVCPSocketInfo &socketInfo, uint16_t dstPort) {
-    char recvBuf[1024] = { 0 };
-
-    // Receive data
-    SOCKADDR_IN srcAddr;
-    socklen_t   srcAddrLen = sizeof(srcAddr);
-
-    auto err = recvfrom(sock, recvBuf, sizeof(recvBuf), 0, (SOCKADDR *)&srcAddr, &srcAddrLen);
-    if(err == SOCKET_ERROR || err < 0) {
-        LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP recvfrom", DEF_MIN_LOG_INTVL, spdlog::level::err, "recvfrom failed with error: {}", GET_LAST_ERROR());
-        return err;
-    }
-
-    if(dstPort != ntohs(srcAddr.sin_port)) {
-        LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP parse response port", MAX_LOG_INTERVAL, spdlog::level::debug,
-                  "GVCP response port mismatch: expected dst_port={}, received src_port={}", dstPort, ntohs(srcAddr.sin_port));
-        return 0;
-    }
-
-    uint32_t respLen = static_cast<uint32_t>(err);
-    // Parse response data
-    if(respLen < sizeof(gvcp_ack_header)) {
-        LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP parse response", MAX_LOG_INTERVAL, spdlog::level::debug, "invalid response data, len={}", respLen);
-        return 0;
-    }
-
-    gvcp_ack_header *ackHeader = reinterpret_cast<gvcp_ack_header *>(recvBuf);
-    respLen -= sizeof(gvcp_ack_header);
-
-    uint16_t status = ntohs(ackHeader->wStatus);
-    uint16_t ack    = ntohs(ackHeader->wAck);
-    uint16_t len    = ntohs(ackHeader->wLen);
-    uint16_t reqID  = ntohs(ackHeader->wReqID);
-
-    if(status == GEV_STATUS_SUCCESS && ack == GVCP_DISCOVERY_ACK && reqID == GVCP_REQUEST_ID) {
-        gvcp_discover_ack_payload *ackPayload = reinterpret_cast<gvcp_discover_ack_payload *>(recvBuf + sizeof(gvcp_ack_header));
-        if(respLen < sizeof(gvcp_discover_ack_payload)) {
-            LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP parse gvcp payload", MAX_LOG_INTERVAL, spdlog::level::debug, "invalid payload len: {}", respLen);
-            return 0;
-        }
-
-        // auto specVer  = ntohl(ackPayload->dwSpecVer);
-        // auto devMode  = ntohl(ackPayload->dwDevMode);
-        // auto supIpSet = ntohl(ackPayload->dwSupIpSet);
-        auto curIpSet = ntohl(ackPayload->dwCurIpSet);
-        auto curPID   = ntohl(ackPayload->dwPID);
-
-        // Get Mac address
-        char macStr[18];
-        sprintf(macStr, "%02X:%02X:%02X:%02X:%02X:%02X", ackPayload->Mac[2], ackPayload->Mac[3], ackPayload->Mac[4], ackPayload->Mac[5], ackPayload->Mac[6],
-                ackPayload->Mac[7]);
-
-        // Read CurIP field
-        uint32_t curIP = *((uint32_t *)&ackPayload->CurIP[12]);
-        char     curIPStr[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &curIP, curIPStr, INET_ADDRSTRLEN);
-
-        // Read the SubMask field
-        uint32_t subMask = *((uint32_t *)&ackPayload->SubMask[12]);
-        char     subMaskStr[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &subMask, subMaskStr, INET_ADDRSTRLEN);
-
-        // Read the Gateway field
-        uint32_t gateway = *((uint32_t *)&ackPayload->Gateway[12]);
-        char     gatewayStr[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &gateway, gatewayStr, INET_ADDRSTRLEN);
-
-        // LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP get ack info", DEF_MIN_LOG_INTVL, spdlog::level::info, "{},{}, {},{}, {},{}, {}, {}, {}, {}, {}, {}, {}, {},
-        // {}",
-        //           specVer, devMode, std::string(macStr), supIpSet, curIpSet, curPID, std::string(curIPStr), std::string(subMaskStr), std::string(gatewayStr),
-        //           std::string(ackPayload->szFacName), std::string(ackPayload->szModelName), std::string(ackPayload->szDevVer),
-        //           std::string(ackPayload->szFacInfo), std::string(ackPayload->szSerial), std::string(ackPayload->szUserName));
-
-        // Filter non-Orbbec devices
-        std::string deviceManufacturer = ackPayload->szFacName;
-        auto        it                 = libobsensor::manufacturerVidMap.find(deviceManufacturer);
-        uint32_t    curVID             = 0;
-        if(it == manufacturerVidMap.end()) {
-            if(!isSupportedOemBootloaderNetworkDevice(deviceManufacturer, curPID, curVID)) {
-                return 0;
-            }
-        }
-        else {
-            curVID = it->second;
-        }
-
-        GVCPDeviceInfo info;
-        info.netInterfaceName  = socketInfo.netInterfaceName;
-        info.localIp           = socketInfo.address;
-        info.localMac          = socketInfo.mac;
-        info.localGateway      = socketInfo.gateway;
-        info.localSubnetLength = socketInfo.subnetLength;
-        info.mac               = macStr;
-        info.ip                = curIPStr;
-        info.mask              = subMaskStr;
-        info.gateway           = gatewayStr;
-        info.sn                = ackPayload->szSerial;
-        info.name              = ackPayload->szModelName;
-        info.pid               = curPID;
-        info.vid               = curVID;
-        info.devVersion        = ackPayload->szDevVer;
-        info.curIpConfig       = curIpSet;
-        info.userName          = std::string(ackPayload->szUserName, strnlen(ackPayload->szUserName, sizeof(ackPayload->szUserName)));
-        // info.manufacturer      = ackPayload->szFacName;
-
-        if(info.vid == ORBBEC_DEVICE_VID && info.pid == 0x0000 && info.name == "OI-BC300I") {
-            // TODO: Treat OI-BC300I (pid=0x0000) as Femto Mega I (pid=0x06c0) for compatibility
-            info.pid = 0x06c0;
-        }
-
-        std::lock_guard<std::mutex> lock(devInfoListMtx_);
-        devInfoList_.push_back(info);
-        return 1;
-    }
-    else {
-        LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP get info", DEF_MIN_LOG_INTVL, spdlog::level::debug,
-                  "GVCP response error: status:{}, ack:{}, device response reqID:{}, response len:{}", status, ack, reqID, len);
-    }
-    return 0;
-}
-
-void GVCPClient::sendGVCPDiscovery(GVCPSocketInfo socketInfo) {
-    // LOG_TRACE("send gvcp discovery {}", socketInfo.sock);
-    gvcp_discover_cmd discoverCmd;
-    auto              gvcpPort = runtimeConfig_->getGvcpPort();
-
-    SOCKADDR_IN destAddr;
-    destAddr.sin_family      = AF_INET;
-    destAddr.sin_addr.s_addr = INADDR_BROADCAST;  // Broadcast address
-    destAddr.sin_port        = htons(gvcpPort);
-
-    // device discovery
-    gvcp_cmd_header cmdHeader;
-    cmdHeader.cMsgKeyCode = GVCP_KEY_CODE;
-    cmdHeader.cFlag       = GVCP_DISCOVERY_FLAGS;
-    cmdHeader.wCmd        = htons(GVCP_DISCOVERY_CMD);
-    cmdHeader.wLen        = htons(0);
-    cmdHeader.wReqID      = htons(1);
-
-    discoverCmd.header = cmdHeader;
-
-    // Get local ip
-    // struct sockaddr_in addr;
-    // socklen_t addrLen = sizeof(addr);
-
-    // Get the address information of the socket
-    // if(getsockname(socketInfo.sock, (struct sockaddr *)&addr, &addrLen) == 0) {
-    //     LOG_INFO("cur addr {}:{}", inet_ntoa(addr.sin_addr), ntohs(addr.sin_port));
-    // }
-
-    // send data
-    int err = sendto(socketInfo.sock, (const char *)&discoverCmd, sizeof(discoverCmd), 0, (SOCKADDR *)&destAddr, sizeof(destAddr));
-    if(err == SOCKET_ERROR) {
-        LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP sendto", MAX_LOG_INTERVAL, spdlog::level::debug, "sendto failed with error:{}", GET_LAST_ERROR());
-    }
-    // LOG_INFO("sendto get info with error:{}", GET_LAST_ERROR());
-
-    int res;
-    int failedCount = 100;
-    do {
-        struct timeval timeout;
-        timeout.tv_sec  = 1;
-        timeout.tv_usec = 0;
-
-        int    nfds = 0;
-        fd_set readfs;
-        FD_ZERO(&readfs);
-        nfds = static_cast<int>(socketInfo.sock) + 1;
-        FD_SET(socketInfo.sock, &readfs);
-        if(socketInfo.sockRecv > 0) {
-            FD_SET(socketInfo.sockRecv, &readfs);
-            if(socketInfo.sockRecv > socketInfo.sock) {
-                nfds = static_cast<int>(socketInfo.sockRecv) + 1;
-            }
-        }
-
-        res = select(nfds, &readfs, 0, 0, &timeout);
-        if(res > 0) {
-            if(FD_ISSET(socketInfo.sock, &readfs)) {
-                err = recvAndParseGVCPResponse(socketInfo.sock, socketInfo, gvcpPort);
-                if(err == SOCKET_ERROR) {
-                    if(failedCount-- < 0) {
-                        LOG_WARN("GVCP recvfrom failed!!!");
-                        break;
-                    }
-                }
-            }
-            if(socketInfo.sockRecv > 0 && FD_ISSET(socketInfo.sockRecv, &readfs)) {
-                err = recvAndParseGVCPResponse(socketInfo.sockRecv, socketInfo, gvcpPort);
-                if(err == SOCKET_ERROR) {
-                    if(failedCount-- < 0) {
-                        LOG_WARN("GVCP recvfrom failed!!!");
-                        break;
-                    }
-                }
-            }
-            FD_SET(socketInfo.sock, &readfs);
-        }
-    } while(res > 0);
-    // LOG_INFO("finish gvcp discovery {}", sock);
-}
-
 bool GVCPClient::sendGVCPForceIP(GVCPSocketInfo socketInfo, std::string mac, const OBNetIpConfig &config) {
     gvcp_forceip_cmd forceIPCmd;
     // gvcp_forceip_ack forceIPAck;
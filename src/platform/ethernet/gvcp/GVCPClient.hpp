@@ -7,6 +7,7 @@
 #include "common/DeviceSeriesInfo.hpp"
 #include "GVCPTypes.hpp"
 #include "GVCPRuntimeConfig.hpp"
+#include "GVCPDiscoveryEngine.hpp"
 #include <vector>
 #include <string>
 #include <mutex>
@@ -14,41 +15,6 @@
 
 namespace libobsensor {
 
-struct GVCPDeviceInfo {
-    std::string netInterfaceName  = "unknown";
-    std::string localIp           = "unknown";
-    std::string localMac          = "unknown";
-    std::string localGateway      = "unknown";
-    uint8_t     localSubnetLength = 0;
-    std::string mac               = "unknown";
-    std::string ip                = "unknown";
-    std::string mask              = "unknown";
-    std::string gateway           = "unknown";
-    std::string sn                = "unknown";
-    std::string name              = "unknown";
-    uint32_t    pid               = 0;
-    uint32_t    vid               = 0;
-    std::string devVersion        = "0.0.0.0";
-    uint32_t    curIpConfig       = 0;
-    std::string userName          = "unknown";
-    // std::string manufacturer = "";
-
-    virtual bool operator==(const GVCPDeviceInfo &other) const {
-        return other.mac == mac && other.sn == sn && other.ip == ip && other.localIp == localIp;
-    }
-    virtual ~GVCPDeviceInfo() {}
-};
-
-struct GVCPSocketInfo {
-    std::string mac              = "unknown";
-    std::string address          = "unknown";
-    std::string netInterfaceName = "unknown";
-    std::string gateway          = "unknown";
-    uint8_t     subnetLength     = 0;
-    SOCKET      sock             = 0;
-    SOCKET      sockRecv         = 0;
-};
-
 #define MAX_SOCKETS 32
 
 class GVCPClient {
@@ -63,16 +29,6 @@ private:
     int    openClientSockets();
     void   closeClientSockets();
     SOCKET openClientSocket(SOCKADDR_IN addr);
-    /**
-     * @brief receive parse gvcp response
-     *
-     * @param[in] socketInfo socket info
-     *
-     * @return < 0: error
-     *         other: device count
-     */
-    int  recvAndParseGVCPResponse(SOCKET sock, const GVCPSocketInfo &socketInfo, uint16_t dstPort);
-    void sendGVCPDiscovery(GVCPSocketInfo socketInfo);
     bool sendGVCPForceIP(GVCPSocketInfo socketInfo, std::string mac, const OBNetIpConfig &config);
 
 #if defined(__APPLE__)
@@ -85,12 +41,11 @@ private:
     SOCKET openClientRecvSocket(SOCKET srcSock);
 
 private:
-    SOCKET                      socks_[MAX_SOCKETS];
-    GVCPSocketInfo              socketInfos_[MAX_SOCKETS];
-    int                         sockCount_ = 0;
-    std::vector<GVCPDeviceInfo> devInfoList_;
-    std::mutex                  queryMtx_;
-    std::mutex                  devInfoListMtx_;
+    SOCKET              socks_[MAX_SOCKETS];
+    GVCPSocketInfo      socketInfos_[MAX_SOCKETS];
+    int                 sockCount_ = 0;
+    std::mutex          queryMtx_;
+    GVCPDiscoveryEngine discoveryEngine_;
 
     std::shared_ptr<GVCPRuntimeConfig> runtimeConfig_;
 
@@ -0,0 +1,285 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "GVCPDiscoveryEngine.hpp"
+#include "common/DeviceSeriesInfo.hpp"
+#include "logger/Logger.hpp"
+#include "logger/LoggerInterval.hpp"
+#include "utils/Utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace libobsensor {
+
+namespace {
+
+const int MAX_SOCKET_ERRORS = 100;  // a socket failing more often is not used for the rest of the discovery
+
+bool isValidSocket(SOCKET sock) {
+    return sock != 0 && sock != INVALID_SOCKET;
+}
+
+// The device is reached through the interface on its subnet, else through the interface of the lowest address
+bool isBetterInterface(const GVCPDeviceInfo &candidate, const GVCPDeviceInfo &current) {
+    bool candidateOnSubnet = utils::isSameSubnet(candidate.localIp, candidate.ip, candidate.localSubnetLength);
+    bool currentOnSubnet   = utils::isSameSubnet(current.localIp, current.ip, current.localSubnetLength);
+    if(candidateOnSubnet != currentOnSubnet) {
+        return candidateOnSubnet;
+    }
+    return !currentOnSubnet && candidate.localIp < current.localIp;
+}
+
+std::string ipToString(const uint8_t *field) {
+    uint32_t addr;
+    memcpy(&addr, field, sizeof(addr));
+    char addrStr[INET_ADDRSTRLEN] = { 0 };
+    inet_ntop(AF_INET, &addr, addrStr, INET_ADDRSTRLEN);
+    return addrStr;
+}
+
+}  // namespace
+
+void GVCPDiscoveryEngine::setIdleTimeout(uint32_t timeoutMs) {
+    idleTimeoutMs_ = timeoutMs;
+}
+
+void GVCPDiscoveryEngine::setDeviceChangedCallback(GVCPDeviceChangedCallback callback) {
+    deviceChangedCallback_ = callback;
+}
+
+std::vector<GVCPDeviceInfo> GVCPDiscoveryEngine::discover(const std::vector<GVCPSocketInfo> &socketInfos, uint16_t gvcpPort, uint32_t destAddress) {
+    struct RecvSocket {
+        SOCKET                sock;
+        const GVCPSocketInfo *socketInfo;
+        int                   errorCount;
+    };
+
+    // send the discovery on all the interfaces, the devices reply while the next commands are sent
+    std::vector<RecvSocket> recvSockets;
+    for(auto &socketInfo: socketInfos) {
+        if(!isValidSocket(socketInfo.sock)) {
+            continue;
+        }
+        sendDiscovery(socketInfo, gvcpPort, destAddress);
+        recvSockets.push_back({ socketInfo.sock, &socketInfo, 0 });
+        if(isValidSocket(socketInfo.sockRecv)) {
+            recvSockets.push_back({ socketInfo.sockRecv, &socketInfo, 0 });
+        }
+    }
+#if !(defined(WIN32) || defined(_WIN32) || defined(WINCE))
+    // fd_set only holds the descriptors below FD_SETSIZE
+    recvSockets.erase(std::remove_if(recvSockets.begin(), recvSockets.end(),
+                                     [](const RecvSocket &recvSocket) {
+                                         if(recvSocket.sock >= FD_SETSIZE) {
+                                             LOG_WARN("GVCP socket {} exceeds FD_SETSIZE, the replies on it are ignored", recvSocket.sock);
+                                             return true;
+                                         }
+                                         return false;
+                                     }),
+                      recvSockets.end());
+#endif
+
+    // receive the replies of all the interfaces until none came for the idle timeout
+    DeviceTable devices;
+    uint64_t    start     = utils::getSteadyTimeMs();
+    uint64_t    lastReply = start;
+    while(!recvSockets.empty()) {
+        uint64_t now = utils::getSteadyTimeMs();
+        if(now - lastReply >= idleTimeoutMs_ || now - start >= GVCP_DISCOVERY_MAX_DURATION_MS) {
+            break;
+        }
+        uint64_t waitMs = std::min<uint64_t>(lastReply + idleTimeoutMs_ - now, start + GVCP_DISCOVERY_MAX_DURATION_MS - now);
+
+        fd_set readfs;
+        FD_ZERO(&readfs);
+        SOCKET maxSock = 0;
+        for(auto &recvSocket: recvSockets) {
+            FD_SET(recvSocket.sock, &readfs);
+            maxSock = std::max(maxSock, recvSocket.sock);
+        }
+
+        struct timeval timeout;
+        timeout.tv_sec  = static_cast<long>(waitMs / 1000);
+        timeout.tv_usec = static_cast<long>((waitMs % 1000) * 1000);
+        int res         = select(static_cast<int>(maxSock) + 1, &readfs, nullptr, nullptr, &timeout);
+        if(res == SOCKET_ERROR) {
+            LOG_INTVL(LOG_INTVL_OBJECT_TAG, DEF_MIN_LOG_INTVL, spdlog::level::err, "GVCP discovery select failed with error: {}", GET_LAST_ERROR());
+            break;
+        }
+        if(res == 0) {
+            break;
+        }
+
+        lastReply = utils::getSteadyTimeMs();
+        for(auto iter = recvSockets.begin(); iter != recvSockets.end();) {
+            if(FD_ISSET(iter->sock, &readfs) && recvReply(iter->sock, *iter->socketInfo, gvcpPort, devices) < 0 && ++iter->errorCount > MAX_SOCKET_ERRORS) {
+                LOG_WARN("GVCP recvfrom failed!!!");
+                iter = recvSockets.erase(iter);
+                continue;
+            }
+            ++iter;
+        }
+    }
+
+    updateDeviceTable(devices);
+
+    std::vector<GVCPDeviceInfo> devInfoList;
+    devInfoList.reserve(devices_.size());
+    for(auto &item: devices_) {
+        devInfoList.push_back(item.second);
+    }
+    std::sort(devInfoList.begin(), devInfoList.end(), [](const GVCPDeviceInfo &a, const GVCPDeviceInfo &b) { return a.mac < b.mac; });
+    return devInfoList;
+}
+
+void GVCPDiscoveryEngine::updateDeviceTable(DeviceTable &devices) {
+    std::vector<GVCPDeviceInfo> added;
+    std::vector<GVCPDeviceInfo> removed;
+    for(auto &item: devices) {
+        auto iter = devices_.find(item.first);
+        if(iter == devices_.end() || !(iter->second == item.second)) {
+            added.push_back(item.second);
+        }
+    }
+    for(auto &item: devices_) {
+        auto iter = devices.find(item.first);
+        if(iter == devices.end() || !(iter->second == item.second)) {
+            removed.push_back(item.second);
+        }
+    }
+    devices_.swap(devices);
+
+    if(added.empty() && removed.empty()) {
+        return;
+    }
+    LOG_DEBUG("queryNetDevice completed ({}), added: {}, removed: {}", devices_.size(), added.size(), removed.size());
+    for(auto &item: devices_) {
+        auto &info = item.second;
+        LOG_DEBUG("\t- mac:{}, ip:{}, sn:{}, pid:0x{:04x}, localIp: {}", info.mac, info.ip, info.sn, info.pid, info.localIp);
+    }
+    if(deviceChangedCallback_) {
+        deviceChangedCallback_(removed, added);
+    }
+}
+
+void GVCPDiscoveryEngine::sendDiscovery(const GVCPSocketInfo &socketInfo, uint16_t gvcpPort, uint32_t destAddress) {
+    SOCKADDR_IN destAddr;
+    memset(&destAddr, 0, sizeof(destAddr));
+    destAddr.sin_family      = AF_INET;
+    destAddr.sin_addr.s_addr = destAddress;
+    destAddr.sin_port        = htons(gvcpPort);
+
+    gvcp_discover_cmd discoverCmd;
+    discoverCmd.header.cMsgKeyCode = GVCP_KEY_CODE;
+    discoverCmd.header.cFlag       = GVCP_DISCOVERY_FLAGS;
+    discoverCmd.header.wCmd        = htons(GVCP_DISCOVERY_CMD);
+    discoverCmd.header.wLen        = htons(0);
+    discoverCmd.header.wReqID      = htons(GVCP_REQUEST_ID);
+
+    int err = sendto(socketInfo.sock, (const char *)&discoverCmd, sizeof(discoverCmd), 0, (SOCKADDR *)&destAddr, sizeof(destAddr));
+    if(err == SOCKET_ERROR) {
+        LOG_INTVL(LOG_INTVL_OBJECT_TAG, MAX_LOG_INTERVAL, spdlog::level::debug, "sendto failed with error:{}", GET_LAST_ERROR());
+    }
+}
+
+int GVCPDiscoveryEngine::recvReply(SOCKET sock, const GVCPSocketInfo &socketInfo, uint16_t gvcpPort, DeviceTable &devices) {
+    uint8_t     recvBuf[1024] = { 0 };
+    SOCKADDR_IN srcAddr;
+    socklen_t   srcAddrLen = sizeof(srcAddr);
+
+    auto err = recvfrom(sock, (char *)recvBuf, sizeof(recvBuf), 0, (SOCKADDR *)&srcAddr, &srcAddrLen);
+    if(err == SOCKET_ERROR || err < 0) {
+        LOG_INTVL(LOG_INTVL_OBJECT_TAG, DEF_MIN_LOG_INTVL, spdlog::level::err, "recvfrom failed with error: {}", GET_LAST_ERROR());
+        return -1;
+    }
+
+    if(gvcpPort != ntohs(srcAddr.sin_port)) {
+        LOG_INTVL(LOG_INTVL_OBJECT_TAG, MAX_LOG_INTERVAL, spdlog::level::debug, "GVCP response port mismatch: expected dst_port={}, received src_port={}",
+                  gvcpPort, ntohs(srcAddr.sin_port));
+        return 0;
+    }
+
+    GVCPDeviceInfo info;
+    if(!parseDiscoveryAck(recvBuf, static_cast<uint32_t>(err), socketInfo, info)) {
+        return 0;
+    }
+
+    auto iter = devices.find(info.mac);
+    if(iter == devices.end()) {
+        devices.emplace(info.mac, info);
+    }
+    else if(isBetterInterface(info, iter->second)) {
+        iter->second = info;
+    }
+    return 1;
+}
+
+bool GVCPDiscoveryEngine::parseDiscoveryAck(const uint8_t *data, uint32_t size, const GVCPSocketInfo &socketInfo, GVCPDeviceInfo &info) {
+    if(size < sizeof(gvcp_ack_header)) {
+        LOG_INTVL(LOG_INTVL_OBJECT_TAG, MAX_LOG_INTERVAL, spdlog::level::debug, "invalid response data, len={}", size);
+        return false;
+    }
+
+    gvcp_ack_header ackHeader;
+    memcpy(&ackHeader, data, sizeof(ackHeader));
+    uint16_t status = ntohs(ackHeader.wStatus);
+    uint16_t ack    = ntohs(ackHeader.wAck);
+    uint16_t len    = ntohs(ackHeader.wLen);
+    uint16_t reqID  = ntohs(ackHeader.wReqID);
+    if(status != GEV_STATUS_SUCCESS || ack != GVCP_DISCOVERY_ACK || reqID != GVCP_REQUEST_ID) {
+        LOG_INTVL(LOG_INTVL_OBJECT_TAG, DEF_MIN_LOG_INTVL, spdlog::level::debug,
+                  "GVCP response error: status:{}, ack:{}, device response reqID:{}, response len:{}", status, ack, reqID, len);
+        return false;
+    }
+
+    if(size - sizeof(gvcp_ack_header) < sizeof(gvcp_discover_ack_payload)) {
+        LOG_INTVL(LOG_INTVL_OBJECT_TAG, MAX_LOG_INTERVAL, spdlog::level::debug, "invalid payload len: {}", size - sizeof(gvcp_ack_header));
+        return false;
+    }
+    gvcp_discover_ack_payload ackPayload;
+    memcpy(&ackPayload, data + sizeof(gvcp_ack_header), sizeof(ackPayload));
+
+    // Filter non-Orbbec devices
+    auto        curPID             = ntohl(ackPayload.dwPID);
+    std::string deviceManufacturer = std::string(ackPayload.szFacName, strnlen(ackPayload.szFacName, sizeof(ackPayload.szFacName)));
+    auto        it                 = manufacturerVidMap.find(deviceManufacturer);
+    uint32_t    curVID             = 0;
+    if(it == manufacturerVidMap.end()) {
+        if(!isSupportedOemBootloaderNetworkDevice(deviceManufacturer, curPID, curVID)) {
+            return false;
+        }
+    }
+    else {
+        curVID = it->second;
+    }
+
+    char macStr[18];
+    snprintf(macStr, sizeof(macStr), "%02X:%02X:%02X:%02X:%02X:%02X", ackPayload.Mac[2], ackPayload.Mac[3], ackPayload.Mac[4], ackPayload.Mac[5],
+             ackPayload.Mac[6], ackPayload.Mac[7]);
+
+    info.netInterfaceName  = socketInfo.netInterfaceName;
+    info.localIp           = socketInfo.address;
+    info.localMac          = socketInfo.mac;
+    info.localGateway      = socketInfo.gateway;
+    info.localSubnetLength = socketInfo.subnetLength;
+    info.mac               = macStr;
+    info.ip                = ipToString(&ackPayload.CurIP[12]);
+    info.mask              = ipToString(&ackPayload.SubMask[12]);
+    info.gateway           = ipToString(&ackPayload.Gateway[12]);
+    info.sn                = std::string(ackPayload.szSerial, strnlen(ackPayload.szSerial, sizeof(ackPayload.szSerial)));
+    info.name              = std::string(ackPayload.szModelName, strnlen(ackPayload.szModelName, sizeof(ackPayload.szModelName)));
+    info.pid               = curPID;
+    info.vid               = curVID;
+    info.devVersion        = std::string(ackPayload.szDevVer, strnlen(ackPayload.szDevVer, sizeof(ackPayload.szDevVer)));
+    info.curIpConfig       = ntohl(ackPayload.dwCurIpSet);
+    info.userName          = std::string(ackPayload.szUserName, strnlen(ackPayload.szUserName, sizeof(ackPayload.szUserName)));
+
+    if(info.vid == ORBBEC_DEVICE_VID && info.pid == 0x0000 && info.name == "OI-BC300I") {
+        // TODO: Treat OI-BC300I (pid=0x0000) as Femto Mega I (pid=0x06c0) for compatibility
+        info.pid = 0x06c0;
+    }
+    return true;
+}
+
+}  // namespace libobsensor
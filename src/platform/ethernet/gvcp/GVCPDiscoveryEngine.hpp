@@ -0,0 +1,96 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "libobsensor/h/ObTypes.h"
+#include "ethernet/socket/SocketTypes.hpp"
+#include "GVCPTypes.hpp"
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace libobsensor {
+
+struct GVCPDeviceInfo {
+    std::string netInterfaceName  = "unknown";
+    std::string localIp           = "unknown";
+    std::string localMac          = "unknown";
+    std::string localGateway      = "unknown";
+    uint8_t     localSubnetLength = 0;
+    std::string mac               = "unknown";
+    std::string ip                = "unknown";
+    std::string mask              = "unknown";
+    std::string gateway           = "unknown";
+    std::string sn                = "unknown";
+    std::string name              = "unknown";
+    uint32_t    pid               = 0;
+    uint32_t    vid               = 0;
+    std::string devVersion        = "0.0.0.0";
+    uint32_t    curIpConfig       = 0;
+    std::string userName          = "unknown";
+    // std::string manufacturer = "";
+
+    virtual bool operator==(const GVCPDeviceInfo &other) const {
+        return other.mac == mac && other.sn == sn && other.ip == ip && other.localIp == localIp;
+    }
+    virtual ~GVCPDeviceInfo() {}
+};
+
+struct GVCPSocketInfo {
+    std::string mac              = "unknown";
+    std::string address          = "unknown";
+    std::string netInterfaceName = "unknown";
+    std::string gateway          = "unknown";
+    uint8_t     subnetLength     = 0;
+    SOCKET      sock             = 0;
+    SOCKET      sockRecv         = 0;
+};
+
+#define GVCP_DISCOVERY_IDLE_TIMEOUT_MS (1000)  // the discovery ends when no reply came for this time
+#define GVCP_DISCOVERY_MAX_DURATION_MS (5000)  // and at the latest after this time, if replies keep coming
+
+typedef std::function<void(const std::vector<GVCPDeviceInfo> &removed, const std::vector<GVCPDeviceInfo> &added)> GVCPDeviceChangedCallback;
+
+/**
+ * @brief Discovery of the GVCP devices on all the network interfaces, from the calling thread
+ * @brief The discovery command is sent on all the sockets at once, then one select() loop receives the replies of all the sockets until no
+ * reply came for the idle timeout. Each reply updates the device table (by device mac) when it arrives: a device seen from several local
+ * interfaces is kept once, from the interface on its subnet, else from the interface of the lowest address. The devices added to and
+ * removed from the table since the previous discovery are reported to the device changed callback.
+ */
+class GVCPDiscoveryEngine {
+public:
+    GVCPDiscoveryEngine() = default;
+
+    /**
+     * @brief Discover the devices
+     *
+     * @param[in] socketInfos the sockets of the local interfaces, a socket with a receive socket (sockRecv) gets the replies on both. The
+     * sockets are not owned and stay open.
+     * @param[in] gvcpPort the GVCP port of the devices, the replies from other ports are ignored
+     * @param[in] destAddress the destination of the discovery command, in network byte order
+     *
+     * @return the devices, sorted by mac
+     */
+    std::vector<GVCPDeviceInfo> discover(const std::vector<GVCPSocketInfo> &socketInfos, uint16_t gvcpPort, uint32_t destAddress = INADDR_BROADCAST);
+
+    void setIdleTimeout(uint32_t timeoutMs);
+    void setDeviceChangedCallback(GVCPDeviceChangedCallback callback);
+
+private:
+    typedef std::unordered_map<std::string, GVCPDeviceInfo> DeviceTable;
+
+    void sendDiscovery(const GVCPSocketInfo &socketInfo, uint16_t gvcpPort, uint32_t destAddress);
+    // < 0: socket error, 0: not a reply of a device, 1: device added to the table
+    int  recvReply(SOCKET sock, const GVCPSocketInfo &socketInfo, uint16_t gvcpPort, DeviceTable &devices);
+    bool parseDiscoveryAck(const uint8_t *data, uint32_t size, const GVCPSocketInfo &socketInfo, GVCPDeviceInfo &info);
+    void updateDeviceTable(DeviceTable &devices);
+
+private:
+    uint32_t                  idleTimeoutMs_ = GVCP_DISCOVERY_IDLE_TIMEOUT_MS;
+    DeviceTable               devices_;  // devices of the last discovery, by mac
+    GVCPDeviceChangedCallback deviceChangedCallback_;
+};
+
+}  // namespace libobsensor
@@ -144,7 +144,7 @@ std::vector<MDNSSocketInfo> MDNSDiscovery::openClientSockets() {
 
     ret = GetAdaptersAddresses(AF_INET, GAA_FLAG_INCLUDE_PREFIX, NULL, NULL, &size);
     if(ret != ERROR_BUFFER_OVERFLOW) {
-        LOG_INTVL(LOG_INTVL_OBJECT_TAG + "openClientSockets", MAX_LOG_INTERVAL, spdlog::level::debug, "GetAdaptersAddresses failed with error:{}",
+        LOG_INTVL(LOG_INTVL_OBJECT_TAG, MAX_LOG_INTERVAL, spdlog::level::debug, "GetAdaptersAddresses failed with error:{}",
                   GET_LAST_ERROR());
         return socks;
     }
@@ -152,7 +152,7 @@ std::vector<MDNSSocketInfo> MDNSDiscovery::openClientSockets() {
 
     ret = GetAdaptersAddresses(AF_INET, GAA_FLAG_INCLUDE_PREFIX, NULL, adapterAddresses.get(), &size);
     if(ret != ERROR_SUCCESS) {
-        LOG_INTVL(LOG_INTVL_OBJECT_TAG + "openClientSockets", MAX_LOG_INTERVAL, spdlog::level::debug, "GetAdaptersAddresses failed with error:{}",
+        LOG_INTVL(LOG_INTVL_OBJECT_TAG, MAX_LOG_INTERVAL, spdlog::level::debug, "GetAdaptersAddresses failed with error:{}",
                   GET_LAST_ERROR());
         return socks;
     }
@@ -183,7 +183,7 @@ std::vector<MDNSSocketInfo> MDNSDiscovery::openClientSockets() {
                     socks.push_back(sockInfo);
                 }
                 else {
-                    LOG_INTVL(LOG_INTVL_OBJECT_TAG + "openClientSockets", MAX_LOG_INTERVAL, spdlog::level::debug, "open ip({}) failed with error:{}", ipStr,
+                    LOG_INTVL(LOG_INTVL_OBJECT_TAG, MAX_LOG_INTERVAL, spdlog::level::debug, "open ip({}) failed with error:{}", ipStr,
                               GET_LAST_ERROR());
                 }
             }
@@ -209,7 +209,7 @@ std::vector<MDNSSocketInfo> MDNSDiscovery::openClientSockets() {
     int             family, n;
 
     if(getifaddrs(&ifaddr) == -1) {
-        LOG_INTVL(LOG_INTVL_OBJECT_TAG + "openClientSockets", MAX_LOG_INTERVAL, spdlog::level::debug, "getifaddrs failed with error:{}", GET_LAST_ERROR());
+        LOG_INTVL(LOG_INTVL_OBJECT_TAG, MAX_LOG_INTERVAL, spdlog::level::debug, "getifaddrs failed with error:{}", GET_LAST_ERROR());
         return socks;
     }
 
@@ -243,7 +243,7 @@ std::vector<MDNSSocketInfo> MDNSDiscovery::openClientSockets() {
                 socks.push_back(sockInfo);
             }
             else {
-                LOG_INTVL(LOG_INTVL_OBJECT_TAG + "openClientSockets", MAX_LOG_INTERVAL, spdlog::level::debug, "open ip({}) failed with error:{}", ipStr,
+                LOG_INTVL(LOG_INTVL_OBJECT_TAG, MAX_LOG_INTERVAL, spdlog::level::debug, "open ip({}) failed with error:{}", ipStr,
                           GET_LAST_ERROR());
             }
         }
@@ -313,7 +313,7 @@ bool MDNSDiscovery::receiveMDNSResponses(const std::vector<MDNSSocketInfo> &sock
 
                     receivedData = true;
                     if(ack.name.find("_oradar_udp") == std::string::npos || ack.ip.empty()) {
-                        LOG_INTVL(LOG_INTVL_OBJECT_TAG + "receiveMDNSResponses", MAX_LOG_INTERVAL, spdlog::level::debug,
+                        LOG_INTVL(LOG_INTVL_OBJECT_TAG, MAX_LOG_INTERVAL, spdlog::level::debug,
                                   "Invalid device, srv name: {}, ip: {}, port: {}", ack.name, ack.ip, ack.port);
                         continue;
                     }
@@ -426,7 +426,7 @@ MDNSDeviceInfo MDNSDiscovery::parseDeviceInfo(const MDNSAckData &ack) {
         catch(const std::exception &e) {
             (void)e;
             info.pid = 0;
-            LOG_INTVL(LOG_INTVL_OBJECT_TAG + "sendAndRecvMDNSQuery", MAX_LOG_INTERVAL, spdlog::level::debug, "Parse PID failed. pid: {}, ip: {}, port, {}", pid,
+            LOG_INTVL(LOG_INTVL_OBJECT_TAG, MAX_LOG_INTERVAL, spdlog::level::debug, "Parse PID failed. pid: {}, ip: {}, port, {}", pid,
                       ack.ip, ack.port);
         }
     }
@@ -38,6 +38,13 @@ void ObRTPClient::stop() {
     }
 }
 
+RTPStreamStats ObRTPClient::getStats() {
+    if(udpClient_) {
+        return udpClient_->getStats();
+    }
+    return RTPStreamStats();
+}
+
 void ObRTPClient::close() {
     if(udpClient_) {
         udpClient_->close();
@@ -17,6 +17,8 @@ public:
     void     stop();
     void     close();
 
+    RTPStreamStats getStats();
+
 private:
     std::shared_ptr<ObRTPUDPClient> udpClient_;
 
@@ -1,159 +1,222 @@
 #include "ObRTPPacketProcessor.hpp"
 #include "logger/Logger.hpp"
+#include "logger/LoggerInterval.hpp"
+#include "exception/ObException.hpp"
 #include "ethernet/socket/SocketTypes.hpp"
+#include "frame/FrameFactory.hpp"
+#include "stream/StreamProfile.hpp"
+#include "utils/Utils.hpp"
 #include <algorithm>
-#include <limits>
+#include <cstring>
 
-#define START_RTP_TAG 0x0
 #define END_RTP_TAG 0x1
-#define OB_RTP_PACKET_REV_TIMEOUT 10
 
 namespace libobsensor {
 
-ObRTPPacketProcessor::ObRTPPacketProcessor()
-    : foundStartPacket_(false), revDataComplete_(false), revDataError_(false), frameNumber_(0), dataSize_(0), rtpBuffer_(nullptr), fameSequenceNumberCount_(0) {
+const uint32_t ObRTPPacketProcessor::RTP_HEADER_SIZE;
+const uint32_t ObRTPPacketProcessor::RTP_PAYLOAD_SIZE;
+const uint32_t ObRTPPacketProcessor::RTP_FIX_METADATA_SIZE;
+const uint32_t ObRTPPacketProcessor::RTP_FIX_METADATA_OFFSET;
 
-    maxPacketSize_  = MAX_RTP_FIX_SIZE - RTP_FIX_SIZE;
-    maxPacketCount_ = MAX_RTP_FRAME_SIZE / maxPacketSize_ + 1;
-    maxCacheSize_   = maxPacketCount_ * maxPacketSize_;
-    rtpBuffer_      = new uint8_t[maxCacheSize_];
-    memset(rtpBuffer_, 0, maxCacheSize_);
+ObRTPPacketProcessor::ObRTPPacketProcessor()
+    : swapDepthBytes_(false),
+      frameData_(nullptr),
+      frameCapacity_(0),
+      maxPacketCount_(0),
+      timestamp_(0),
+      receivedCount_(0),
+      receivedSize_(0),
+      highestSequenceNumber_(0),
+      endSequenceNumber_(0),
+      endReceived_(false),
+      frameNumber_(0) {
+    memset(metadata_, 0, sizeof(metadata_));
+    memset(&stats_, 0, sizeof(stats_));
 }
 
-ObRTPPacketProcessor::~ObRTPPacketProcessor() noexcept {
-    release();
+void ObRTPPacketProcessor::reset(std::shared_ptr<const StreamProfile> profile) {
+    frame_.reset();
+    frameData_      = nullptr;
+    profile_        = profile;
+    swapDepthBytes_ = profile && profile->getType() == OB_STREAM_DEPTH && profile->getFormat() == OB_FORMAT_Y16;
+    frameNumber_    = 0;
+    memset(&stats_, 0, sizeof(stats_));
 }
 
-void ObRTPPacketProcessor::OnStartOfFrame() {
-    foundStartPacket_        = true;
-    dataSize_                = 0;
-    fameSequenceNumberCount_ = 0;
-    memset(rtpBuffer_, 0, maxCacheSize_);
+uint16_t ObRTPPacketProcessor::getNextSequenceNumber() const {
+    return frame_ ? static_cast<uint16_t>(highestSequenceNumber_ + 1) : 0;
 }
 
-bool ObRTPPacketProcessor::foundStartPacket() {
-    return foundStartPacket_;
+uint8_t *ObRTPPacketProcessor::getPayloadSlot(uint16_t sequenceNumber) const {
+    // packet 0 carries the metadata and always goes through process()
+    if(!frame_ || sequenceNumber == 0) {
+        return nullptr;
+    }
+    uint64_t offset = static_cast<uint64_t>(sequenceNumber) * RTP_PAYLOAD_SIZE - RTP_FIX_METADATA_SIZE;
+    if(offset + RTP_PAYLOAD_SIZE > frameCapacity_) {
+        return nullptr;
+    }
+    return frameData_ + offset;
 }
 
-bool ObRTPPacketProcessor::process(RTPHeader *header, uint8_t *recvData, uint32_t length, uint32_t type, OBFormat format) {
-    // Critical initialization check - buffer must be allocated
-    if(rtpBuffer_ == nullptr) {
-        LOG_WARN("RTP buffer allocation failed");
+bool ObRTPPacketProcessor::openFrame(uint32_t timestamp) {
+    if(!profile_) {
         return false;
     }
 
-    if(length < RTP_FIX_SIZE) {
-        LOG_WARN("RTP packet too small to contain header: {} bytes", length);
-        return false;
+    try {
+        frame_ = FrameFactory::createFrameFromStreamProfile(profile_);
     }
-
-    if(fameSequenceNumberCount_ >= maxPacketCount_) {
-        LOG_WARN("RTP data buffer overflow!");
-        reset();
+    catch(const std::exception &e) {
+        // the frame memory pool is exhausted while the application holds on to the frames, drop until buffers come back
+        LOG_WARN_INTVL("{} failed to acquire a frame buffer, frame dropped: {}", profile_->getType(), e.what());
+        frame_.reset();
+        stats_.framesDropped++;
         return false;
     }
 
-    uint8_t  marker         = header->marker;
-    uint16_t sequenceNumber = ntohs(header->sequenceNumber);
-    rtpType_                = type;
-    // LOG_DEBUG("marker-{}, sequenceNumber-{},length-{}, type-{}", marker, sequenceNumber, length, type);
-    if(sequenceNumber == START_RTP_TAG) {
-        timestamp_ = header->timestamp;
-        OnStartOfFrame();
+    frameData_      = frame_->getDataMutable();
+    frameCapacity_  = static_cast<uint32_t>(frame_->getDataSize());
+    maxPacketCount_ = (frameCapacity_ + RTP_FIX_METADATA_SIZE + RTP_PAYLOAD_SIZE - 1) / RTP_PAYLOAD_SIZE;
+    if(receivedPackets_.size() < maxPacketCount_) {
+        receivedPackets_.resize(maxPacketCount_);
     }
+    std::fill(receivedPackets_.begin(), receivedPackets_.begin() + maxPacketCount_, static_cast<uint8_t>(0));
+
+    timestamp_             = timestamp;
+    receivedCount_         = 0;
+    receivedSize_          = 0;
+    highestSequenceNumber_ = 0;
+    endSequenceNumber_     = 0;
+    endReceived_           = false;
+    return true;
+}
 
-    if(!foundStartPacket()) {
-        return false;
+void ObRTPPacketProcessor::dropFrame() {
+    if(!frame_) {
+        return;
     }
-
-    fameSequenceNumberCount_++;
-
-    // Protect against invalid sequence numbers / out-of-range writes.
-    if(sequenceNumber >= maxPacketCount_) {
-        LOG_WARN("RTP sequence number {} exceeds max packet count {}", sequenceNumber, maxPacketCount_);
-        reset();
-        return false;
+    uint32_t expectedCount = (endReceived_ ? endSequenceNumber_ : highestSequenceNumber_) + 1;
+    if(expectedCount > receivedCount_) {
+        stats_.lostPackets += expectedCount - receivedCount_;
     }
+    stats_.framesDropped++;
+    frame_.reset();
+    frameData_ = nullptr;
+}
 
-    uint32_t dataLen = length - RTP_FIX_SIZE;
-    uint32_t offset  = RTP_FIX_METADATA_OFFSET + (uint32_t)sequenceNumber * maxPacketSize_;
-    if(offset + dataLen > maxCacheSize_) {
-        LOG_WARN("RTP packet data overruns buffer (offset={} dataLen={} max={})", offset, dataLen, maxCacheSize_);
-        reset();
-        return false;
+std::shared_ptr<Frame> ObRTPPacketProcessor::process(const RTPHeader *header, const uint8_t *payload, uint32_t payloadSize, bool inPlace) {
+    uint16_t sequenceNumber = ntohs(header->sequenceNumber);
+    if(sequenceNumber == 0) {
+        if(frame_) {
+            LOG_DEBUG("{} rtp frame incomplete, {} of {} packets received", profile_->getType(), receivedCount_,
+                      (endReceived_ ? endSequenceNumber_ : highestSequenceNumber_) + 1);
+            dropFrame();
+        }
+        openFrame(header->timestamp);
+    }
+    else if(frame_ && header->timestamp != timestamp_) {
+        // packet of another frame while the end of the open one was lost (and packet 0 of the other one too), neither can be completed
+        LOG_DEBUG("{} rtp packet {} of timestamp {} received for the frame of timestamp {}", profile_->getType(), sequenceNumber, header->timestamp,
+                  timestamp_);
+        dropFrame();
     }
 
-    if(dataLen > 0) {
-        memcpy(rtpBuffer_ + offset, recvData + RTP_FIX_SIZE, dataLen);
-        dataSize_ += dataLen;
+    if(!frame_) {
+        stats_.discardedPackets++;
+        return nullptr;
     }
 
-    if(marker == END_RTP_TAG) {
-        OnEndOfFrame(sequenceNumber, format);
+    uint64_t streamOffset = static_cast<uint64_t>(sequenceNumber) * RTP_PAYLOAD_SIZE;
+    if(sequenceNumber >= maxPacketCount_ || streamOffset + payloadSize > RTP_FIX_METADATA_SIZE + static_cast<uint64_t>(frameCapacity_)) {
+        LOG_WARN_INTVL("{} rtp packet {} overruns the frame buffer ({} bytes)", profile_->getType(), sequenceNumber, frameCapacity_);
+        dropFrame();
+        return nullptr;
     }
 
-    return true;
-}
+    if(receivedPackets_[sequenceNumber]) {
+        stats_.duplicatePackets++;
+        return nullptr;
+    }
 
-void ObRTPPacketProcessor::OnEndOfFrame(uint16_t sequenceNumber, OBFormat format) {
-    // If the number of received data packets equals the end frame's SN (sequence number),
-    // it indicates that all RTP packets for the frame have been successfully received. Otherwise,
-    // it means that some RTP packets for the frame are still missing, and you will need to wait
-    // for 10ms to receive additional data before proceeding.
-    if(fameSequenceNumberCount_ == (uint32_t)(sequenceNumber + 1)) {
-        if(rtpType_ == OB_STREAM_DEPTH && format == OB_FORMAT_Y16) {
-            convertBigEndianToLittleEndian(getFrameData(), getFrameDataSize());
+    if(!inPlace) {
+        const uint8_t *src    = payload;
+        uint32_t       size   = payloadSize;
+        uint32_t       offset = static_cast<uint32_t>(streamOffset);
+        if(offset < RTP_FIX_METADATA_SIZE) {
+            uint32_t metaSize = std::min(size, RTP_FIX_METADATA_SIZE - offset);
+            memcpy(metadata_ + RTP_FIX_METADATA_OFFSET + offset, src, metaSize);
+            src += metaSize;
+            size -= metaSize;
+            offset += metaSize;
         }
-        revDataComplete_ = true;
-        revDataError_    = false;
-        ++frameNumber_;
+        if(size > 0) {
+            memcpy(frameData_ + offset - RTP_FIX_METADATA_SIZE, src, size);
+        }
+        stats_.copiedPackets++;
+    }
+
+    receivedPackets_[sequenceNumber] = 1;
+    receivedCount_++;
+    receivedSize_ += payloadSize;
+    stats_.packets++;
+    stats_.bytes += payloadSize;
+    if(sequenceNumber < highestSequenceNumber_) {
+        stats_.reorderedPackets++;
     }
     else {
-        revDataComplete_ = false;
-        revDataError_    = true;
-        LOG_WARN("Received rtp packet count does not match sequenceNumber!");
+        highestSequenceNumber_ = sequenceNumber;
     }
-}
 
-void ObRTPPacketProcessor::convertBigEndianToLittleEndian(uint8_t *recvData, uint32_t size) {
-    uint16_t *data      = reinterpret_cast<uint16_t *>(recvData);
-    uint32_t  numPixels = size / 2;
-    for(uint32_t i = 0; i < numPixels; ++i) {
-        data[i] = (data[i] >> 8) | (data[i] << 8);
+    if(header->marker == END_RTP_TAG) {
+        endSequenceNumber_ = sequenceNumber;
+        endReceived_       = true;
     }
-}
 
-uint8_t *ObRTPPacketProcessor::getMetaData() {
-    uint32_t *data      = reinterpret_cast<uint32_t *>(rtpBuffer_ + RTP_FIX_METADATA_OFFSET);
-    uint32_t  numPixels = RTP_FIX_METADATA_SIZE / 4;
-    for(uint32_t i = 0; i < numPixels; ++i) {
-        data[i] = ((data[i] >> 24) & 0x000000FF) | ((data[i] >> 8) & 0x0000FF00) | ((data[i] << 8) & 0x00FF0000) | ((data[i] << 24) & 0xFF000000);
+    if(endReceived_) {
+        // The marker packet may overtake some packets of its frame, the frame is complete once all of them arrived
+        if(highestSequenceNumber_ > endSequenceNumber_) {
+            LOG_WARN_INTVL("{} rtp packet {} received after the end of the frame ({})", profile_->getType(), highestSequenceNumber_, endSequenceNumber_);
+            dropFrame();
+        }
+        else if(receivedCount_ == endSequenceNumber_ + 1) {
+            return completeFrame();
+        }
     }
-    return rtpBuffer_;
-}
-
-bool ObRTPPacketProcessor::processError() {
-    return revDataError_;
+    return nullptr;
 }
 
-bool ObRTPPacketProcessor::processComplete() {
-    return revDataComplete_;
-}
+std::shared_ptr<Frame> ObRTPPacketProcessor::completeFrame() {
+    auto frame = std::move(frame_);
+    frameData_ = nullptr;
+    if(receivedSize_ < RTP_FIX_METADATA_SIZE) {
+        LOG_WARN_INTVL("{} rtp frame too small to contain the metadata: {} bytes", profile_->getType(), receivedSize_);
+        stats_.framesDropped++;
+        return nullptr;
+    }
 
-void ObRTPPacketProcessor::reset() {
-    foundStartPacket_        = false;
-    revDataComplete_         = false;
-    revDataError_            = false;
-    dataSize_                = 0;
-    fameSequenceNumberCount_ = 0;
-    memset(rtpBuffer_, 0, maxCacheSize_);
-}
+    uint32_t dataSize = receivedSize_ - RTP_FIX_METADATA_SIZE;
+    frame->setDataSize(dataSize);
+    if(swapDepthBytes_) {
+        uint16_t *data      = reinterpret_cast<uint16_t *>(frame->getDataMutable());
+        uint32_t  numPixels = dataSize / 2;
+        for(uint32_t i = 0; i < numPixels; ++i) {
+            data[i] = static_cast<uint16_t>((data[i] >> 8) | (data[i] << 8));
+        }
+    }
 
-void ObRTPPacketProcessor::release() {
-    if(rtpBuffer_ != nullptr) {
-        delete rtpBuffer_;
-        rtpBuffer_ = nullptr;
+    uint32_t *metadata = reinterpret_cast<uint32_t *>(metadata_ + RTP_FIX_METADATA_OFFSET);
+    for(uint32_t i = 0; i < RTP_FIX_METADATA_SIZE / 4; ++i) {
+        metadata[i] = ntohl(metadata[i]);
     }
+    frame->updateMetadata(metadata_, sizeof(metadata_));
+
+    frame->setSystemTimeStampUsec(utils::getNowTimesUs());
+    frame->setSteadyTimeStampUsec(utils::getSteadyTimeUs());
+    frame->setTimeStampUsec(timestamp_);
+    frame->setNumber(++frameNumber_);
+    stats_.framesCompleted++;
+    return frame;
 }
 
-}
\ No newline at end of file
+}  // namespace libobsensor
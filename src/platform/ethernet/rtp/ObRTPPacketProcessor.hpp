@@ -1,12 +1,11 @@
 #pragma once
 
 #include "libobsensor/h/ObTypes.h"
-#include <iostream>
-#include <mutex>
-#include <unordered_set>
+#include "IStreamProfile.hpp"
+#include "IFrame.hpp"
+#include <memory>
 #include <vector>
 
-
 namespace libobsensor {
 
 struct RTPHeader {
@@ -21,91 +20,102 @@ struct RTPHeader {
     uint32_t ssrc;
 };
 
-struct OBRTPPacket {
-    uint8_t              marker;
-    uint8_t              payloadType;
-    uint16_t             sequenceNumber;
-    std::vector<uint8_t> payload;
-
-    OBRTPPacket(uint8_t marker, uint8_t payloadType, uint16_t seqNum, const std::vector<uint8_t> &data)
-        : marker(marker), payloadType(payloadType), sequenceNumber(seqNum), payload(data) {}
+// Packet and frame counters of one RTP stream, accumulated from start() to stop()
+struct RTPStreamStats {
+    uint64_t packets;           // packets accepted into a frame
+    uint64_t bytes;             // payload bytes accepted into a frame
+    uint64_t framesCompleted;   // frames handed to the frame callback
+    uint64_t framesDropped;     // frames dropped because of missing or invalid packets
+    uint64_t lostPackets;       // packets missing from the dropped frames
+    uint64_t reorderedPackets;  // packets received after a higher sequence number of the same frame
+    uint64_t duplicatePackets;  // packets whose sequence number was already received for the frame
+    uint64_t copiedPackets;     // packets not received in place and copied into the frame afterwards
+    uint64_t discardedPackets;  // packets received while no frame was open, or truncated packets
+    uint64_t foreignPackets;    // packets from another source address
+    uint64_t queueDropped;      // completed frames dropped because the frame callback fell behind
 };
 
+/**
+ * @brief Assembles the RTP packets of a video stream directly in a frame from FrameFactory.
+ *
+ * Packet n of a frame carries bytes [n * RTP_PAYLOAD_SIZE, (n + 1) * RTP_PAYLOAD_SIZE) of the payload stream, which is 96 bytes of big endian
+ * metadata followed by the frame data. Packet 0 opens a new frame, the packet with the RTP marker bit set is the last one of the frame. All the
+ * packets of a frame carry its RTP timestamp, a packet of another timestamp drops the open frame and is discarded.
+ *
+ * The receiver asks getPayloadSlot() where the payload of the next packets will go and receives them straight into the frame buffer. Packets that
+ * end up somewhere else (reordered, first or last packet of a frame, ...) are passed to process() with inPlace = false and copied.
+ */
 class ObRTPPacketProcessor {
+public:
+    static const uint32_t RTP_HEADER_SIZE       = 12;
+    static const uint32_t RTP_PAYLOAD_SIZE      = 1460;  // MTU 1500 - IP(20) - UDP(8) - RTP(12)
+    static const uint32_t RTP_FIX_METADATA_SIZE = 96;
 
 public:
     ObRTPPacketProcessor();
-
-    ~ObRTPPacketProcessor() noexcept;
-
-    bool process(RTPHeader *header, uint8_t *recvData, uint32_t length, uint32_t type, OBFormat format);
-
-    uint8_t *getFrameData() {
-        return rtpBuffer_ + static_cast<size_t>(RTP_FIX_METADATA_OFFSET) + RTP_FIX_METADATA_SIZE;
-    }
-
-    uint32_t getFrameDataSize() {
-        return dataSize_ - RTP_FIX_METADATA_SIZE;
-    }
-
-    uint8_t *getMetaData();
-
-    uint32_t getMetaDataSize() {
-        return (RTP_FIX_METADATA_OFFSET + RTP_FIX_METADATA_SIZE);
+    ~ObRTPPacketProcessor() noexcept = default;
+
+    /**
+     * @brief Drops the open frame and prepares for a new stream. The frame number restarts from 0.
+     */
+    void reset(std::shared_ptr<const StreamProfile> profile);
+
+    /**
+     * @brief Sequence number following the highest one received for the open frame.
+     */
+    uint16_t getNextSequenceNumber() const;
+
+    /**
+     * @brief Frame buffer position of a whole packet (RTP_PAYLOAD_SIZE bytes) of the open frame.
+     *
+     * @return nullptr if no frame is open, or the packet is the first one or does not fit in the frame buffer completely
+     */
+    uint8_t *getPayloadSlot(uint16_t sequenceNumber) const;
+
+    /**
+     * @brief Processes one packet.
+     *
+     * @param[in] header RTP header of the packet
+     * @param[in] payload payload of the packet, for inPlace packets it is already at getPayloadSlot(sequenceNumber)
+     * @param[in] payloadSize payload size in bytes
+     * @param[in] inPlace whether the payload was received at getPayloadSlot() of the open frame
+     *
+     * @return the frame completed by this packet, nullptr otherwise
+     */
+    std::shared_ptr<Frame> process(const RTPHeader *header, const uint8_t *payload, uint32_t payloadSize, bool inPlace);
+
+    const RTPStreamStats &getStats() const {
+        return stats_;
     }
 
-    uint64_t getNumber() {
-        return frameNumber_;
-    }
-
-    void resetNumber() {
-        frameNumber_ = 0;
-    }
-
-    uint64_t getTimestamp() {
-        return timestamp_;
-    }
-
-    bool processError();
-
-    bool processComplete();
-
-    void reset();
-
-    void release();
-
 private:
-    void OnStartOfFrame();
-    bool foundStartPacket();
-    void OnEndOfFrame(uint16_t sequenceNumber, OBFormat format);
-    void convertBigEndianToLittleEndian(uint8_t *recvData, uint32_t size);
+    bool                   openFrame(uint32_t timestamp);
+    void                   dropFrame();
+    std::shared_ptr<Frame> completeFrame();
 
 private:
-    const uint32_t MAX_RTP_FRAME_SIZE      = 4 * 1920 * 1080;
-    const uint32_t MAX_RTP_FIX_SIZE        = 1472;
-    const uint32_t RTP_FIX_SIZE            = 12;
-    const uint32_t RTP_FIX_METADATA_OFFSET = 12;
-    const uint32_t RTP_FIX_METADATA_SIZE   = 96;
-
-    bool foundStartPacket_;
-    bool revDataComplete_;
-    bool revDataError_;
-
-    uint64_t frameNumber_;
-    uint32_t maxPacketCount_;
-    uint32_t maxCacheSize_;
-    uint32_t maxPacketSize_;
-    uint64_t timestamp_;
-
-    //metadataSize(96) + framedataSize
-    uint32_t dataSize_;
-    // metadata(96) + framedata
-    uint8_t *rtpBuffer_;
-
-    uint32_t rtpType_;
-
-    uint32_t fameSequenceNumberCount_;
+    // 12 reserved bytes ahead of the metadata, the metadata parsers of the network devices expect this layout
+    static const uint32_t RTP_FIX_METADATA_OFFSET = 12;
+
+    std::shared_ptr<const StreamProfile> profile_;
+    bool                                 swapDepthBytes_;
+
+    std::shared_ptr<Frame> frame_;
+    uint8_t               *frameData_;
+    uint32_t               frameCapacity_;
+    uint32_t               maxPacketCount_;
+    uint32_t               timestamp_;
+    uint8_t                metadata_[RTP_FIX_METADATA_OFFSET + RTP_FIX_METADATA_SIZE];
+
+    std::vector<uint8_t> receivedPackets_;  // per sequence number of the open frame
+    uint32_t             receivedCount_;
+    uint32_t             receivedSize_;
+    uint32_t             highestSequenceNumber_;
+    uint32_t             endSequenceNumber_;
+    bool                 endReceived_;
+
+    uint64_t       frameNumber_;
+    RTPStreamStats stats_;
 };
 
-}
-
+}  // namespace libobsensor
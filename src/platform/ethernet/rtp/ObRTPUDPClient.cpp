@@ -3,16 +3,44 @@
 #include "utils/Utils.hpp"
 #include "exception/ObException.hpp"
 #include "logger/LoggerInterval.hpp"
-#include "utils/Utils.hpp"
 #include "frame/FrameFactory.hpp"
 #include "stream/StreamProfile.hpp"
 
+#include <cstring>
+
 #define OB_UDP_BUFFER_SIZE 1500
+// Datagrams taken per recvmmsg call
+#define OB_RTP_RECV_BATCH_SIZE 64
+// Completed frames waiting for the frame callback
+#define OB_RTP_FRAME_QUEUE_SIZE 16
 
 namespace libobsensor {
 
 ObRTPUDPClient::ObRTPUDPClient(std::string localAddress, std::string address, uint16_t port)
-    : localIp_(localAddress), serverIp_(address), serverPort_(port), startReceive_(false), recvSocket_(INVALID_SOCKET) {
+    : localIp_(localAddress),
+      serverIp_(address),
+      serverPort_(port),
+      startReceive_(false),
+      recvSocket_(INVALID_SOCKET),
+      frameQueue_(OB_RTP_FRAME_QUEUE_SIZE),
+      foreignPackets_(0),
+      invalidPackets_(0),
+      queueDropped_(0) {
+    memset(&stats_, 0, sizeof(stats_));
+    memset(&serverAddr_, 0, sizeof(serverAddr_));
+    // packets are filtered by comparing the binary source address
+    if(inet_pton(AF_INET, serverIp_.c_str(), &serverAddr_) != 1) {
+        LOG_WARN("Invalid rtp server address: {}", serverIp_);
+    }
+
+    packets_.resize(OB_RTP_RECV_BATCH_SIZE);
+    scratchBuf_.resize(static_cast<size_t>(OB_RTP_RECV_BATCH_SIZE) * OB_UDP_BUFFER_SIZE);
+#if defined(__linux__)
+    headerBuf_.resize(static_cast<size_t>(OB_RTP_RECV_BATCH_SIZE) * ObRTPPacketProcessor::RTP_HEADER_SIZE);
+    msgs_.resize(OB_RTP_RECV_BATCH_SIZE);
+    iovecs_.resize(2 * OB_RTP_RECV_BATCH_SIZE);
+    srcAddrs_.resize(OB_RTP_RECV_BATCH_SIZE);
+#endif
     socketConnect();
 }
 
@@ -85,15 +113,21 @@ void ObRTPUDPClient::start(std::shared_ptr<const StreamProfile> profile, Mutable
         return;
     }
 
-    startReceive_.store(true);
     // Clear any stale data from previous runs
-    rtpQueue_.reset();
-    rtpProcessor_.reset();
-    rtpProcessor_.resetNumber();
+    rtpProcessor_.reset(profile);
+    foreignPackets_ = 0;
+    invalidPackets_ = 0;
+    queueDropped_   = 0;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        memset(&stats_, 0, sizeof(stats_));
+    }
+
     currentProfile_ = profile;
     frameCallback_  = callback;
+    frameQueue_.start(frameCallback_);
+    startReceive_.store(true);
     receiverThread_ = std::thread(&ObRTPUDPClient::frameReceive, this);
-    callbackThread_ = std::thread(&ObRTPUDPClient::frameProcess, this);
 }
 
 void ObRTPUDPClient::socketClose() {
@@ -109,12 +143,9 @@ void ObRTPUDPClient::socketClose() {
 
 void ObRTPUDPClient::frameReceive() {
     LOG_DEBUG("start udp data receive thread...");
-    sockaddr_in          serverAddr;
-    socklen_t            serverAddrSize = sizeof(serverAddr);
-    std::vector<uint8_t> buffer(OB_UDP_BUFFER_SIZE);
     while(startReceive_.load()) {
-        int recvLen = recvfrom(recvSocket_, (char *)buffer.data(), (int)buffer.size(), 0, (sockaddr *)&serverAddr, &serverAddrSize);
-        if(recvLen < 0) {
+        int count = receiveBatch();
+        if(count < 0) {
             int error = GET_LAST_ERROR();
 #if (defined(WIN32) || defined(_WIN32) || defined(WINCE))
             if(error == WSAETIMEDOUT) {
@@ -134,18 +165,168 @@ void ObRTPUDPClient::frameReceive() {
             continue;
         }
 
-        if(recvLen > 0) {
-            char server_ip[INET_ADDRSTRLEN];
-            inet_ntop(AF_INET, &serverAddr.sin_addr, server_ip, sizeof(server_ip));
-            std::string serverIpString(server_ip);
-            if(serverIpString == serverIp_) {
-                std::vector<uint8_t> data(buffer.begin(), buffer.begin() + recvLen);
-                rtpQueue_.push(data);
+        processBatch(count);
+
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_                = rtpProcessor_.getStats();
+        stats_.foreignPackets = foreignPackets_;
+        stats_.queueDropped   = queueDropped_;
+        stats_.discardedPackets += invalidPackets_;
+    }
+
+    LOG_DEBUG("Exit udp data receive thread...");
+}
+
+int ObRTPUDPClient::receiveBatch() {
+#if defined(__linux__)
+    // Each datagram is scattered into a header slot and a payload slot. The payload slots of the packets expected next are their positions in the
+    // frame buffer, so packets arriving in order are received in place.
+    uint16_t nextSequenceNumber = rtpProcessor_.getNextSequenceNumber();
+    for(uint32_t i = 0; i < OB_RTP_RECV_BATCH_SIZE; i++) {
+        auto    &packet = packets_[i];
+        uint8_t *slot   = currentProfile_ ? rtpProcessor_.getPayloadSlot(static_cast<uint16_t>(nextSequenceNumber + i)) : nullptr;
+
+        packet.expectedSequenceNumber = static_cast<uint16_t>(nextSequenceNumber + i);
+        packet.inFrame                = slot != nullptr;
+        packet.inPlace                = false;
+        packet.payload                = slot ? slot : scratchBuf_.data() + i * OB_UDP_BUFFER_SIZE;
+
+        iovecs_[2 * i].iov_base     = headerBuf_.data() + i * ObRTPPacketProcessor::RTP_HEADER_SIZE;
+        iovecs_[2 * i].iov_len      = ObRTPPacketProcessor::RTP_HEADER_SIZE;
+        iovecs_[2 * i + 1].iov_base = packet.payload;
+        iovecs_[2 * i + 1].iov_len  = slot ? ObRTPPacketProcessor::RTP_PAYLOAD_SIZE : OB_UDP_BUFFER_SIZE - ObRTPPacketProcessor::RTP_HEADER_SIZE;
+
+        auto &msg                  = msgs_[i];
+        msg.msg_hdr.msg_name       = &srcAddrs_[i];
+        msg.msg_hdr.msg_namelen    = sizeof(sockaddr_in);
+        msg.msg_hdr.msg_iov        = &iovecs_[2 * i];
+        msg.msg_hdr.msg_iovlen     = 2;
+        msg.msg_hdr.msg_control    = nullptr;
+        msg.msg_hdr.msg_controllen = 0;
+        msg.msg_hdr.msg_flags      = 0;
+        msg.msg_len                = 0;
+    }
+
+    // Blocks (up to the socket receive timeout) for the first datagram only, then takes whatever else is queued
+    int count = recvmmsg(recvSocket_, msgs_.data(), OB_RTP_RECV_BATCH_SIZE, MSG_WAITFORONE, nullptr);
+    if(count < 0) {
+        return -1;
+    }
+
+    for(int i = 0; i < count; i++) {
+        auto &packet = packets_[i];
+        auto &msg    = msgs_[i];
+        packet.header      = nullptr;
+        packet.payloadSize = 0;
+        if(srcAddrs_[i].sin_addr.s_addr != serverAddr_.s_addr) {
+            foreignPackets_++;
+            continue;
+        }
+        if(msg.msg_len < ObRTPPacketProcessor::RTP_HEADER_SIZE || (msg.msg_hdr.msg_flags & MSG_TRUNC)) {
+            invalidPackets_++;
+            continue;
+        }
+        packet.header      = reinterpret_cast<const RTPHeader *>(iovecs_[2 * i].iov_base);
+        packet.payloadSize = msg.msg_len - ObRTPPacketProcessor::RTP_HEADER_SIZE;
+    }
+    return count;
+#else
+    // No recvmmsg, one datagram at a time into the scratch buffer
+    auto       &packet      = packets_[0];
+    sockaddr_in srcAddr     = {};
+    socklen_t   srcAddrSize = sizeof(srcAddr);
+    int         recvLen     = recvfrom(recvSocket_, (char *)scratchBuf_.data(), OB_UDP_BUFFER_SIZE, 0, (sockaddr *)&srcAddr, &srcAddrSize);
+    if(recvLen < 0) {
+        return -1;
+    }
+
+    packet.inFrame     = false;
+    packet.inPlace     = false;
+    packet.header      = nullptr;
+    packet.payload     = scratchBuf_.data() + ObRTPPacketProcessor::RTP_HEADER_SIZE;
+    packet.payloadSize = 0;
+    if(srcAddr.sin_addr.s_addr != serverAddr_.s_addr) {
+        foreignPackets_++;
+    }
+    else if(recvLen < static_cast<int>(ObRTPPacketProcessor::RTP_HEADER_SIZE)) {
+        invalidPackets_++;
+    }
+    else {
+        packet.header      = reinterpret_cast<const RTPHeader *>(scratchBuf_.data());
+        packet.payloadSize = static_cast<uint32_t>(recvLen) - ObRTPPacketProcessor::RTP_HEADER_SIZE;
+    }
+    return 1;
+#endif
+}
+
+void ObRTPUDPClient::processBatch(int count) {
+    if(currentProfile_ == nullptr) {
+        // imu, one frame per packet
+        for(int i = 0; i < count; i++) {
+            auto &packet = packets_[i];
+            if(packet.header == nullptr) {
+                continue;
             }
+            auto frame = FrameFactory::createFrame(OB_FRAME_UNKNOWN, OB_FORMAT_UNKNOWN, OB_UDP_BUFFER_SIZE);
+            frame->updateData(packet.payload, packet.payloadSize);
+            frame->setTimeStampUsec(packet.header->timestamp);
+            frame->setSystemTimeStampUsec(utils::getNowTimesUs());
+            frame->setSteadyTimeStampUsec(utils::getSteadyTimeUs());
+            outputFrame(frame);
         }
+        return;
     }
 
-    LOG_DEBUG("Exit udp data receive thread...");
+    // A payload is in place if it landed at the slot of its own sequence number, and no packet before it in the batch ended the frame or
+    // started a new one.
+    bool sameFrame = true;
+    for(int i = 0; i < count; i++) {
+        auto &packet = packets_[i];
+        if(packet.header == nullptr) {
+            continue;
+        }
+        uint16_t sequenceNumber = ntohs(packet.header->sequenceNumber);
+        if(sequenceNumber == 0) {
+            sameFrame = false;
+        }
+        packet.inPlace = sameFrame && packet.inFrame && sequenceNumber == packet.expectedSequenceNumber;
+        if(packet.header->marker) {
+            sameFrame = false;
+        }
+    }
+
+    // Move the misplaced payloads out of the frame buffer before any other payload is copied into it
+    for(int i = 0; i < count; i++) {
+        auto &packet = packets_[i];
+        if(packet.header != nullptr && packet.inFrame && !packet.inPlace) {
+            uint8_t *scratch = scratchBuf_.data() + i * OB_UDP_BUFFER_SIZE;
+            memcpy(scratch, packet.payload, packet.payloadSize);
+            packet.payload = scratch;
+        }
+    }
+
+    for(int i = 0; i < count; i++) {
+        auto &packet = packets_[i];
+        if(packet.header == nullptr) {
+            continue;
+        }
+        auto frame = rtpProcessor_.process(packet.header, packet.payload, packet.payloadSize, packet.inPlace);
+        if(frame) {
+            outputFrame(frame);
+        }
+    }
+}
+
+void ObRTPUDPClient::outputFrame(std::shared_ptr<Frame> frame) {
+    if(!frameQueue_.enqueue(frame)) {
+        queueDropped_++;
+        LOG_WARN_INTVL("Frame callback too slow, rtp frame dropped!");
+    }
+}
+
+RTPStreamStats ObRTPUDPClient::getStats() {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return stats_;
 }
 
 void ObRTPUDPClient::flush() {
@@ -180,59 +361,6 @@ void ObRTPUDPClient::flush() {
     } while(elapsed < 3000);
 }
 
-void ObRTPUDPClient::frameProcess() {
-    LOG_DEBUG("start frame process thread...");
-    std::vector<uint8_t> data;
-    while(startReceive_.load()) {
-        if(rtpQueue_.pop(data)) {
-            RTPHeader *header = (RTPHeader *)data.data();
-            if(currentProfile_ != nullptr) {
-                rtpProcessor_.process(header, data.data(), (uint32_t)data.size(), currentProfile_->getType(), currentProfile_->getFormat());
-                if(rtpProcessor_.processComplete()) {
-                    uint32_t frameDataSize = rtpProcessor_.getFrameDataSize();
-                    uint32_t metaDataSize  = rtpProcessor_.getMetaDataSize();
-                    // LOG_DEBUG("Callback new frame dataSize: {}, number: {}", dataSize, rtpProcessor_.getNumber());
-
-                    auto     frame        = FrameFactory::createFrameFromStreamProfile(currentProfile_);
-                    uint32_t expectedSize = static_cast<uint32_t>(frame->getDataSize());
-                    if(frameDataSize > expectedSize) {
-                        LOG_WARN_INTVL("{} Receive data size({}) >  expected data size! ({})", currentProfile_->getType(), frameDataSize, expectedSize);
-                        rtpProcessor_.reset();
-                        continue;
-                    }
-
-                    frame->setSystemTimeStampUsec(utils::getNowTimesUs());
-                    frame->setSteadyTimeStampUsec(utils::getSteadyTimeUs());
-                    frame->setTimeStampUsec(rtpProcessor_.getTimestamp());
-                    frame->setNumber(rtpProcessor_.getNumber());
-                    frame->updateMetadata(rtpProcessor_.getMetaData(), metaDataSize);
-                    frame->updateData(rtpProcessor_.getFrameData(), frameDataSize);
-
-                    frameCallback_(frame);
-                    rtpProcessor_.reset();
-                }
-                else {
-                    if(rtpProcessor_.processError()) {
-                        LOG_DEBUG("{} rtp frame process error...", currentProfile_->getType());
-                        rtpProcessor_.reset();
-                    }
-                }
-            }
-            else {
-                // imu
-                auto frame = FrameFactory::createFrame(OB_FRAME_UNKNOWN, OB_FORMAT_UNKNOWN, OB_UDP_BUFFER_SIZE);
-                frame->updateData(data.data() + 12, data.size() - 12);
-                frame->setTimeStampUsec(header->timestamp);
-                frame->setSystemTimeStampUsec(utils::getNowTimesUs());
-                frame->setSteadyTimeStampUsec(utils::getSteadyTimeUs());
-                frameCallback_(frame);
-            }
-        }
-    }
-
-    LOG_DEBUG("Exit frame process thread...");
-}
-
 void ObRTPUDPClient::stop() {
     LOG_DEBUG("stop stream start...");
     startReceive_.store(false);
@@ -241,13 +369,14 @@ void ObRTPUDPClient::stop() {
         flush();
     }
 
-    // Ensure any buffered RTP packets are discarded when stopping
-    rtpQueue_.destroy();
-    rtpProcessor_.reset();
+    // Ensure any pending frames are discarded when stopping
+    frameQueue_.stop();
+    rtpProcessor_.reset(nullptr);
 
-    if(callbackThread_.joinable()) {
-        callbackThread_.join();
-    }
+    auto stats = getStats();
+    LOG_DEBUG("rtp stream stats: frames {} completed / {} dropped, packets {} received / {} lost / {} reordered / {} duplicate / {} copied",
+              stats.framesCompleted, stats.framesDropped, stats.packets, stats.lostPackets, stats.reorderedPackets, stats.duplicatePackets,
+              stats.copiedPackets);
     LOG_DEBUG("stop stream end...");
 }
 
@@ -3,13 +3,18 @@
 #include "IStreamProfile.hpp"
 #include "IFrame.hpp"
 #include "ethernet/socket/SocketTypes.hpp"
+#include "frame/SpscFrameQueue.hpp"
 #include "ObRTPPacketProcessor.hpp"
-#include "ObRTPPacketQueue.hpp"
 
 #include <string>
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/uio.h>
+#endif
 
 namespace libobsensor {
 
@@ -23,16 +28,32 @@ public:
     void     close();
     uint16_t getPort();
 
+    // Counters of the current (or last) stream, see RTPStreamStats
+    RTPStreamStats getStats();
+
 private:
+    // One received datagram of a batch
+    struct RecvPacket {
+        const RTPHeader *header;
+        uint8_t         *payload;
+        uint32_t         payloadSize;
+        uint16_t         expectedSequenceNumber;  // sequence number the payload position was chosen for
+        bool             inFrame;                 // payload received into the frame buffer
+        bool             inPlace;                 // payload received into the frame buffer at its final position
+    };
+
     void socketConnect();
     void socketClose();
     void frameReceive();
+    int  receiveBatch();
+    void processBatch(int count);
+    void outputFrame(std::shared_ptr<Frame> frame);
     void flush();
-    void frameProcess();
-    
+
 private:
     std::string       localIp_;
     std::string       serverIp_;
+    in_addr           serverAddr_;
     uint16_t          serverPort_;
     std::atomic<bool> startReceive_;
     SOCKET            recvSocket_;
@@ -42,10 +63,25 @@ private:
     MutableFrameCallback                 frameCallback_;
 
     std::thread receiverThread_;
-    std::thread callbackThread_;
 
-    ObRTPPacketQueue    rtpQueue_;
+    // Receive buffers of one batch, only used by the receiver thread
+    std::vector<RecvPacket> packets_;
+    std::vector<uint8_t>    scratchBuf_;
+#if defined(__linux__)
+    std::vector<uint8_t>     headerBuf_;
+    std::vector<mmsghdr>     msgs_;
+    std::vector<iovec>       iovecs_;
+    std::vector<sockaddr_in> srcAddrs_;
+#endif
+
     ObRTPPacketProcessor rtpProcessor_;
+    SpscFrameQueue<Frame> frameQueue_;
+
+    std::mutex     statsMutex_;
+    RTPStreamStats stats_;
+    uint64_t       foreignPackets_;
+    uint64_t       invalidPackets_;
+    uint64_t       queueDropped_;
 };
 
 }  // namespace libobsensor
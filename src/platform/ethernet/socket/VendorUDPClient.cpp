@@ -142,7 +142,7 @@ int VendorUDPClient::read(uint8_t *data, const uint32_t dataLen) {
                 continue;
             }
             else {
-                LOG_ERROR_INTVL(utils::string::to_string() << "VendorUDPClient read data failed! socket=" << socketFd_ << ", err_code=" << rst);
+                LOG_ERROR_INTVL("VendorUDPClient read data failed! socket={}, err_code={}", socketFd_, rst);
                 continue;
             }
         }
@@ -74,7 +74,7 @@ void HidDevicePort::startStream(MutableFrameCallback callback) {
             auto res = libusb_interrupt_transfer(libusbDevHandle, endpointAddress_, frame->getDataMutable(), static_cast<int>(frame->getDataSize()),
                                                  &transferred, 1000);
             if(res != LIBUSB_SUCCESS && isStreaming_) {
-                LOG_WARN_INTVL(utils::string::to_string() << "interrupt transfer failed, error: " << libusb_strerror(res));
+                LOG_WARN_INTVL("interrupt transfer failed, error: {}", libusb_strerror(res));
                 continue;
             }
             frame->setSystemTimeStampUsec(utils::getNowTimesUs());
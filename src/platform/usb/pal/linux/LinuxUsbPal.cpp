@@ -142,29 +142,11 @@ LinuxUsbPal::LinuxUsbPal() {
 LinuxUsbPal::~LinuxUsbPal() noexcept {}
 
 std::shared_ptr<ISourcePort> LinuxUsbPal::getSourcePort(std::shared_ptr<const SourcePortInfo> portInfo) {
-    std::unique_lock<std::mutex> lock(sourcePortMapMutex_);
-    std::shared_ptr<ISourcePort> port;
-
-    // clear expired weak_ptr
-    for(auto it = sourcePortMap_.begin(); it != sourcePortMap_.end();) {
-        if(it->second.expired()) {
-            it = sourcePortMap_.erase(it);
-        }
-        else {
-            ++it;
-        }
-    }
-
-    // check if the port already exists in the map
-    for(const auto &pair: sourcePortMap_) {
-        if(pair.first->equal(portInfo)) {
-            port = pair.second.lock();
-            if(port != nullptr) {
-                return port;
-            }
-        }
-    }
+    return sourcePortMap_.getOrOpen(portInfo, [&]() { return openSourcePort(portInfo); });
+}
 
+std::shared_ptr<ISourcePort> LinuxUsbPal::openSourcePort(std::shared_ptr<const SourcePortInfo> portInfo) {
+    std::shared_ptr<ISourcePort> port;
     switch(portInfo->portType) {
     case SOURCE_PORT_USB_VENDOR: {
         auto url    = std::dynamic_pointer_cast<const USBSourcePortInfo>(portInfo)->url;
@@ -241,9 +223,6 @@ std::shared_ptr<ISourcePort> LinuxUsbPal::getSourcePort(std::shared_ptr<const So
         THROW_INVALID_PARAM_EXCEPTION("unsupported source port type!");
         break;
     }
-    if(port != nullptr) {
-        sourcePortMap_.insert(std::make_pair(portInfo, port));
-    }
     return port;
 }
 
@@ -252,28 +231,11 @@ std::shared_ptr<ISourcePort> LinuxUsbPal::getUvcSourcePort(std::shared_ptr<const
         THROW_INVALID_PARAM_EXCEPTION("unsupported source port type!");
     }
 
-    std::unique_lock<std::mutex> lock(sourcePortMapMutex_);
-    std::shared_ptr<ISourcePort> port;
-
-    // clear expired weak_ptr
-    for(auto it = sourcePortMap_.begin(); it != sourcePortMap_.end();) {
-        if(it->second.expired()) {
-            it = sourcePortMap_.erase(it);
-        }
-        else {
-            ++it;
-        }
-    }
+    return sourcePortMap_.getOrOpen(portInfo, [&]() { return openUvcSourcePort(portInfo, backendHint); });
+}
 
-    // check if the port already exists in the map
-    for(const auto &pair: sourcePortMap_) {
-        if(pair.first->equal(portInfo)) {
-            port = pair.second.lock();
-            if(port != nullptr) {
-                return port;
-            }
-        }
-    }
+std::shared_ptr<ISourcePort> LinuxUsbPal::openUvcSourcePort(std::shared_ptr<const SourcePortInfo> portInfo, OBUvcBackendType backendHint) {
+    std::shared_ptr<ISourcePort> port;
 
     auto usbPortInfo = std::dynamic_pointer_cast<const USBSourcePortInfo>(portInfo);
     auto backend     = uvcBackendType_;
@@ -319,10 +281,6 @@ std::shared_ptr<ISourcePort> LinuxUsbPal::getUvcSourcePort(std::shared_ptr<const
         port = std::make_shared<ObLibuvcDevicePort>(usbDev, std::dynamic_pointer_cast<const USBSourcePortInfo>(portInfo));
         LOG_DEBUG("UVC device have been create with LibUVC backend! dev: {}, inf: {}", usbPortInfo->url, usbPortInfo->infUrl);
     }
-
-    if(port != nullptr) {
-        sourcePortMap_.insert(std::make_pair(portInfo, port));
-    }
     return port;
 }
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "IPal.hpp"
+#include "SourcePortMap.hpp"
 #include "logger/Logger.hpp"
 #include "exception/ObException.hpp"
 #include "usb/enumerator/IUsbEnumerator.hpp"
@@ -30,13 +31,15 @@ public:
 private:
     void loadXmlConfig();
 
+    std::shared_ptr<ISourcePort> openSourcePort(std::shared_ptr<const SourcePortInfo> portInfo);
+    std::shared_ptr<ISourcePort> openUvcSourcePort(std::shared_ptr<const SourcePortInfo> portInfo, OBUvcBackendType backendHint);
+
     std::shared_ptr<IUsbEnumerator> usbEnumerator_;
 
     OBUvcBackendType uvcBackendType_ = OB_UVC_BACKEND_TYPE_LIBUVC;
 
 private:
-    std::mutex                                                                  sourcePortMapMutex_;
-    std::map<std::shared_ptr<const SourcePortInfo>, std::weak_ptr<ISourcePort>> sourcePortMap_;
+    SourcePortMap sourcePortMap_;  // the ports of different devices are opened in parallel
 };
 
 }  // namespace libobsensor
@@ -491,7 +491,8 @@ std::string fourccToStringGmsl(uint32_t id) {
     return fourcc_buff;
 }
 
-ObV4lGmslDevicePort::ObV4lGmslDevicePort(std::shared_ptr<const USBSourcePortInfo> portInfo) : portInfo_(portInfo) {
+ObV4lGmslDevicePort::ObV4lGmslDevicePort(std::shared_ptr<const USBSourcePortInfo> portInfo)
+    : portInfo_(portInfo), captureConfig_(loadV4lCaptureConfig(DEFAULT_BUFFER_COUNT_GMSL, MAX_BUFFER_COUNT_GMSL)) {
     LOG_DEBUG("-Entry ObV4lGmslDevicePort-");
 
     auto devs = queryRelatedDevices(portInfo_);
@@ -646,7 +647,7 @@ void ObV4lGmslDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandleGmsl> devHa
             xioctlGmsl(devHandle->metadataFd, VIDIOC_QBUF, &buf);
         }
 
-        if(devHandle->fd >= 0) {
+        if(devHandle->fd >= 0 && !devHandle->framePoolBuffers) {
             v4l2_buffer buf = {};
             memset(&buf, 0, sizeof(buf));
             buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -679,10 +680,10 @@ void ObV4lGmslDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandleGmsl> devHa
             int val = select(max_fd + 1, &fds, nullptr, nullptr, &remaining);
             if(val < 0) {
                 if(errno == EINTR) {
-                    LOG_INTVL(LOG_INTVL_OBJECT_TAG + "captureLoop", 5000, spdlog::level::debug, "select interrupted: {}", strerror(errno));
+                    LOG_INTVL(LOG_INTVL_OBJECT_TAG, 5000, spdlog::level::debug, "select interrupted: {}", strerror(errno));
                 }
                 else {
-                    LOG_INTVL(LOG_INTVL_OBJECT_TAG + "captureLoop", 5000, spdlog::level::debug, "select failed: {}", strerror(errno));
+                    LOG_INTVL(LOG_INTVL_OBJECT_TAG, 5000, spdlog::level::debug, "select failed: {}", strerror(errno));
                 }
                 continue;
             }
@@ -708,7 +709,7 @@ void ObV4lGmslDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandleGmsl> devHa
                 buf.type   = LOCAL_V4L2_BUF_TYPE_META_CAPTURE_GMSL;
                 buf.memory = USE_MEMORY_MMAP ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
                 if(xioctlGmsl(devHandle->metadataFd, VIDIOC_DQBUF, &buf) < 0) {
-                    LOG_INTVL(LOG_INTVL_OBJECT_TAG + "captureLoop", 5000, spdlog::level::err, "devHandle->metadataFd VIDIOC_DQBUF failed, {}, {}",
+                    LOG_INTVL(LOG_INTVL_OBJECT_TAG, 5000, spdlog::level::err, "devHandle->metadataFd VIDIOC_DQBUF failed, {}, {}",
                               strerror(errno), devHandle->metadataInfo->name);
                 }
 
@@ -720,7 +721,7 @@ void ObV4lGmslDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandleGmsl> devHa
 
                 if(devHandle->isCapturing) {
                     if(xioctlGmsl(devHandle->metadataFd, VIDIOC_QBUF, &buf) < 0) {
-                        LOG_INTVL(LOG_INTVL_OBJECT_TAG + "captureLoop", 5000, spdlog::level::err, "devHandle->metadataFd VIDIOC_QBUF failed, {}, {}",
+                        LOG_INTVL(LOG_INTVL_OBJECT_TAG, 5000, spdlog::level::err, "devHandle->metadataFd VIDIOC_QBUF failed, {}, {}",
                                   strerror(errno), devHandle->metadataInfo->name);
                     }
                 }
@@ -728,27 +729,37 @@ void ObV4lGmslDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandleGmsl> devHa
 
             if(FD_ISSET(devHandle->fd, &fds)) {
                 FD_CLR(devHandle->fd, &fds);
-                v4l2_buffer buf = {};
+                auto       &poolBuffers = devHandle->framePoolBuffers;
+                v4l2_buffer buf         = {};
                 memset(&buf, 0, sizeof(buf));
                 buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-                buf.memory = USE_MEMORY_MMAP ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
+                buf.memory = poolBuffers ? V4L2_MEMORY_USERPTR : (USE_MEMORY_MMAP ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR);
                 // reader buffer
-                if(xioctlGmsl(devHandle->fd, VIDIOC_DQBUF, &buf) < 0) {
-                    LOG_INTVL(LOG_INTVL_OBJECT_TAG + "captureLoop", 5000, spdlog::level::err, "devHandle->fd VIDIOC_DQBUF failed, {}, {}", strerror(errno),
+                bool dequeued = xioctlGmsl(devHandle->fd, VIDIOC_DQBUF, &buf) >= 0;
+                if(!dequeued) {
+                    LOG_INTVL(LOG_INTVL_OBJECT_TAG, 5000, spdlog::level::err, "devHandle->fd VIDIOC_DQBUF failed, {}, {}", strerror(errno),
                               devHandle->info->name);
                 }
 
-                if((buf.bytesused) && (!(buf.flags & V4L2_BUF_FLAG_ERROR))) {
+                // captured straight into the frame, a new frame from the pool is queued in its place
+                std::shared_ptr<VideoFrame> pooledFrame;
+                if(poolBuffers && dequeued) {
+                    pooledFrame = poolBuffers->take(buf);
+                }
+
+                if((buf.bytesused) && (!(buf.flags & V4L2_BUF_FLAG_ERROR)) && (!poolBuffers || pooledFrame)) {
                     TRY_EXECUTE({
-                        auto rawframe   = FrameFactory::createFrameFromStreamProfile(devHandle->profile);
-                        auto videoFrame = rawframe->as<VideoFrame>();
-                        // if((DetectPlatform() == Platform::Xavier) || (DetectPlatform() == Platform::Orin))
-                        if(1 > 0)  // Modify the default setting to apply special resolution processing to all NVIDIA platforms
-                        {
-                            handleSpecialResolution(devHandle, devHandle->buffers[buf.index].ptr, buf.bytesused, videoFrame);
-                        }
-                        else {
-                            videoFrame->updateData(devHandle->buffers[buf.index].ptr, buf.bytesused);
+                        auto videoFrame = pooledFrame;
+                        if(!videoFrame) {
+                            videoFrame = FrameFactory::createFrameFromStreamProfile(devHandle->profile)->as<VideoFrame>();
+                            // if((DetectPlatform() == Platform::Xavier) || (DetectPlatform() == Platform::Orin))
+                            if(1 > 0)  // Modify the default setting to apply special resolution processing to all NVIDIA platforms
+                            {
+                                handleSpecialResolution(devHandle, devHandle->buffers[buf.index].ptr, buf.bytesused, videoFrame);
+                            }
+                            else {
+                                videoFrame->updateData(devHandle->buffers[buf.index].ptr, buf.bytesused);
+                            }
                         }
 
                         if(metadataBufferIndex >= 0) {
@@ -792,9 +803,9 @@ void ObV4lGmslDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandleGmsl> devHa
                     });
                 }
 
-                if(devHandle->isCapturing) {
+                if(devHandle->isCapturing && !poolBuffers) {
                     if(xioctlGmsl(devHandle->fd, VIDIOC_QBUF, &buf) < 0) {
-                        LOG_INTVL(LOG_INTVL_OBJECT_TAG + "captureLoop", 5000, spdlog::level::err, "devHandle->fd VIDIOC_QBUF failed, {}, {}", strerror(errno),
+                        LOG_INTVL(LOG_INTVL_OBJECT_TAG, 5000, spdlog::level::err, "devHandle->fd VIDIOC_QBUF failed, {}, {}", strerror(errno),
                                   devHandle->info->name);
                     }
                 }
@@ -806,6 +817,13 @@ void ObV4lGmslDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandleGmsl> devHa
     }
 }
 
+// Resolutions the driver delivers with padded lines, see handleSpecialResolution()
+static bool isPaddedResolution(std::shared_ptr<const VideoStreamProfile> profile) {
+    auto width  = profile->getWidth();
+    auto height = profile->getHeight();
+    return (width % 424) == 0 || (width == 480 && height == 270);
+}
+
 void ObV4lGmslDevicePort::handleSpecialResolution(std::shared_ptr<V4lDeviceHandleGmsl> devHandle, const uint8_t *srcData, uint32_t srcSize,
                                                   std::shared_ptr<VideoFrame> videoFrame) {
     // LOG_DEBUG("-Entry handleSpecialResolution");
@@ -963,7 +981,7 @@ void ObV4lGmslDevicePort::startStream(std::shared_ptr<const StreamProfile> profi
         }
 
         struct v4l2_requestbuffers req = { 0 };
-        req.count                      = MAX_BUFFER_COUNT_GMSL;
+        req.count                      = captureConfig_.bufferCount;
         req.type                       = LOCAL_V4L2_BUF_TYPE_META_CAPTURE_GMSL;
         req.memory                     = USE_MEMORY_MMAP ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
         if(xioctlGmsl(devHandle->metadataFd, VIDIOC_REQBUFS, &req) < 0) {
@@ -1068,50 +1086,64 @@ void ObV4lGmslDevicePort::startStream(std::shared_ptr<const StreamProfile> profi
     }
 #endif
 
-    struct v4l2_requestbuffers req = {};
-    req.count                      = MAX_BUFFER_COUNT_GMSL;
-    req.type                       = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    req.memory                     = USE_MEMORY_MMAP ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
-    if(xioctlGmsl(devHandle->fd, VIDIOC_REQBUFS, &req) < 0) {
-        auto err = errno;
-        stopStream(devHandle);
-        THROW_IO_EXCEPTION("Failed to request buffers!" + devHandle->info->name + ", " + strerror(err));
-    }
-    for(uint32_t i = 0; i < req.count && i < MAX_BUFFER_COUNT_GMSL; i++) {
-        struct v4l2_buffer buf = {};
-        memset(&buf, 0, sizeof(buf));
-        buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-        buf.memory = USE_MEMORY_MMAP ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
-        buf.index  = i;
-        if(xioctlGmsl(devHandle->fd, VIDIOC_QUERYBUF, &buf) < 0) {
+    // The special resolutions are cropped into a new frame, they gain nothing from capturing into frames of the pool
+    devHandle->framePoolBuffers.reset();
+    if(captureConfig_.zeroCopy && !isPaddedResolution(videoProfile)) {
+        auto poolBuffers = std::make_shared<V4lFramePoolBuffers>(devHandle->fd, videoProfile);
+        if(poolBuffers->start(captureConfig_.bufferCount, fmt.fmt.pix.sizeimage)) {
+            devHandle->framePoolBuffers = poolBuffers;
+        }
+        else {
+            LOG_INFO("Zero-copy capture is not supported by {}, using mmap buffers", devHandle->info->name);
+        }
+    }
+
+    if(!devHandle->framePoolBuffers) {
+        struct v4l2_requestbuffers req = {};
+        req.count                      = captureConfig_.bufferCount;
+        req.type                       = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        req.memory                     = USE_MEMORY_MMAP ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
+        if(xioctlGmsl(devHandle->fd, VIDIOC_REQBUFS, &req) < 0) {
             auto err = errno;
             stopStream(devHandle);
-            THROW_IO_EXCEPTION("Failed to query buffer!" + devHandle->info->name + ", " + strerror(err));
+            THROW_IO_EXCEPTION("Failed to request buffers!" + devHandle->info->name + ", " + strerror(err));
         }
-
-        if(USE_MEMORY_MMAP) {
-            devHandle->buffers[i].ptr    = (uint8_t *)mmap(NULL, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, devHandle->fd, buf.m.offset);
-            devHandle->buffers[i].length = buf.length;
-            if(devHandle->buffers[i].ptr == MAP_FAILED) {
-                LOG_ERROR(" mmap, errnoStr:{}, errno:{}, line:{} ", strerror(errno), errno, __LINE__);
+        for(uint32_t i = 0; i < req.count && i < MAX_BUFFER_COUNT_GMSL; i++) {
+            struct v4l2_buffer buf = {};
+            memset(&buf, 0, sizeof(buf));
+            buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = USE_MEMORY_MMAP ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
+            buf.index  = i;
+            if(xioctlGmsl(devHandle->fd, VIDIOC_QUERYBUF, &buf) < 0) {
+                auto err = errno;
+                stopStream(devHandle);
+                THROW_IO_EXCEPTION("Failed to query buffer!" + devHandle->info->name + ", " + strerror(err));
             }
-        }
-        else {
-            uint8_t  md_extra            = (V4L2_BUF_TYPE_VIDEO_CAPTURE == buf.type) ? MAX_META_DATA_SIZE : 0;
-            uint32_t _length             = buf.length + md_extra;
-            devHandle->buffers[i].ptr    = static_cast<uint8_t *>(malloc(_length));
-            devHandle->buffers[i].length = _length;
 
-            if(!devHandle->buffers[i].ptr) {
-                LOG_ERROR(" User_p allocation failed!, errnoStr:{}, errno:{}, line:{} ", strerror(errno), errno, __LINE__);
+            if(USE_MEMORY_MMAP) {
+                devHandle->buffers[i].ptr    = (uint8_t *)mmap(NULL, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, devHandle->fd, buf.m.offset);
+                devHandle->buffers[i].length = buf.length;
+                if(devHandle->buffers[i].ptr == MAP_FAILED) {
+                    LOG_ERROR(" mmap, errnoStr:{}, errno:{}, line:{} ", strerror(errno), errno, __LINE__);
+                }
             }
-            memset(devHandle->buffers[i].ptr, 0, _length);
+            else {
+                uint8_t  md_extra            = (V4L2_BUF_TYPE_VIDEO_CAPTURE == buf.type) ? MAX_META_DATA_SIZE : 0;
+                uint32_t _length             = buf.length + md_extra;
+                devHandle->buffers[i].ptr    = static_cast<uint8_t *>(malloc(_length));
+                devHandle->buffers[i].length = _length;
 
-            buf.m.userptr = reinterpret_cast<unsigned long>(devHandle->buffers[i].ptr);
-        }
+                if(!devHandle->buffers[i].ptr) {
+                    LOG_ERROR(" User_p allocation failed!, errnoStr:{}, errno:{}, line:{} ", strerror(errno), errno, __LINE__);
+                }
+                memset(devHandle->buffers[i].ptr, 0, _length);
 
-        if(xioctlGmsl(devHandle->fd, VIDIOC_QBUF, &buf) < 0) {
-            LOG_ERROR(" VIDIOC_QBUF, errnoStr:{}, errno:{}, line:{} ", strerror(errno), errno, __LINE__);
+                buf.m.userptr = reinterpret_cast<unsigned long>(devHandle->buffers[i].ptr);
+            }
+
+            if(xioctlGmsl(devHandle->fd, VIDIOC_QBUF, &buf) < 0) {
+                LOG_ERROR(" VIDIOC_QBUF, errnoStr:{}, errno:{}, line:{} ", strerror(errno), errno, __LINE__);
+            }
         }
     }
 
@@ -1263,13 +1295,19 @@ void ObV4lGmslDevicePort::stopStream(std::shared_ptr<V4lDeviceHandleGmsl> devHan
     clearUp(devHandle);
 
     struct v4l2_requestbuffers req = {};
-    req.count                      = 0;
-    req.type                       = type;
-    req.memory                     = USE_MEMORY_MMAP ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
-    if(xioctlGmsl(devHandle->fd, VIDIOC_REQBUFS, &req) < 0) {
-        auto err = errno;
-        LOG_ERROR("Failed to request buffers! Device: {}, error: {}", devHandle->info->name, std::string(strerror(err)));
-        // continue to clean others
+    if(devHandle->framePoolBuffers) {
+        devHandle->framePoolBuffers->stop();
+        devHandle->framePoolBuffers.reset();
+    }
+    else {
+        req.count  = 0;
+        req.type   = type;
+        req.memory = USE_MEMORY_MMAP ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
+        if(xioctlGmsl(devHandle->fd, VIDIOC_REQBUFS, &req) < 0) {
+            auto err = errno;
+            LOG_ERROR("Failed to request buffers! Device: {}, error: {}", devHandle->info->name, std::string(strerror(err)));
+            // continue to clean others
+        }
     }
 
     if(devHandle->metadataFd >= 0) {
@@ -11,6 +11,7 @@
 
 #include "utils/SteadyCondVar.hpp"
 #include "UvcDevicePort.hpp"
+#include "V4lFramePoolBuffers.hpp"
 #include "usb/enumerator/IUsbEnumerator.hpp"
 #include "frame/Frame.hpp"
 
@@ -47,7 +48,8 @@ static const std::string GMSL_SN_DEFAULT      = "0123456789";
 static const std::string GMSL_ASIC_SN_DEFAULT = "12345";
 
 static const uint32_t MAX_META_DATA_SIZE_GMSL = 255;
-static const uint32_t MAX_BUFFER_COUNT_GMSL   = 8;  // 4; //v4l3_buf default 4 buf. opt to 4->8
+static const uint32_t MAX_BUFFER_COUNT_GMSL     = 32;  // VIDEO_MAX_FRAME, upper limit of Device.LinuxV4L2BufferCount
+static const uint32_t DEFAULT_BUFFER_COUNT_GMSL = 8;   // 4; //v4l3_buf default 4 buf. opt to 4->8
 
 static const uint32_t LOCAL_V4L2_META_FMT_D4XX_GMSL = v4l2_fourcc('G', '2', 'X', 'X');  // borrows from videodev2.h, using for getting extention metadata
 
@@ -101,6 +103,7 @@ struct V4lDeviceHandleGmsl {
     std::shared_ptr<V4lDeviceInfoGmsl>                     info;
     int                                                    fd;
     std::array<V4L2FrameBufferGmsl, MAX_BUFFER_COUNT_GMSL> buffers;
+    std::shared_ptr<V4lFramePoolBuffers>                   framePoolBuffers;  // replaces the mmap buffers in zero-copy mode
 
     std::shared_ptr<V4lDeviceInfoGmsl>                     metadataInfo;
     int                                                    metadataFd;
@@ -169,6 +172,7 @@ private:
     std::vector<std::shared_ptr<V4lDeviceHandleGmsl>> deviceHandles_;
     std::recursive_mutex                              streamMutex_;
     bool                                              isDaBaiADevice_ = false;
+    V4lCaptureConfig                                  captureConfig_;
 };
 
 }  // namespace libobsensor
@@ -325,7 +325,8 @@ std::string fourccToString(uint32_t id) {
     return fourcc_buff;
 }
 
-ObV4lUvcDevicePort::ObV4lUvcDevicePort(std::shared_ptr<const USBSourcePortInfo> portInfo) : portInfo_(portInfo) {
+ObV4lUvcDevicePort::ObV4lUvcDevicePort(std::shared_ptr<const USBSourcePortInfo> portInfo)
+    : portInfo_(portInfo), captureConfig_(loadV4lCaptureConfig(DEFAULT_BUFFER_COUNT, MAX_BUFFER_COUNT)) {
     auto devs = queryRelatedDevices(portInfo_);
     if(devs.empty()) {
         THROW_DEVICE_UNAVAILABLE_EXCEPTION("No v4l device found for port: " + portInfo_->infUrl);
@@ -398,7 +399,7 @@ void ObV4lUvcDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandle> devHandle)
         int max_fd = std::max({ devHandle->fd, devHandle->metadataFd, devHandle->stopPipeFd[0], devHandle->stopPipeFd[1] });
 
         if(devHandle->metadataFd >= 0) {
-            for(uint32_t i = 0; i < MAX_BUFFER_COUNT; i++) {
+            for(uint32_t i = 0; i < devHandle->metadataBufferCount; i++) {
                 v4l2_buffer buf = {};
                 buf.type        = LOCAL_V4L2_BUF_TYPE_META_CAPTURE;
                 buf.memory      = V4L2_MEMORY_MMAP;
@@ -407,8 +408,9 @@ void ObV4lUvcDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandle> devHandle)
             }
         }
 
-        if(devHandle->fd >= 0) {
-            for(uint32_t i = 0; i < MAX_BUFFER_COUNT; i++) {
+        // the frame pool buffers are queued on startStream
+        if(devHandle->fd >= 0 && !devHandle->framePoolBuffers) {
+            for(uint32_t i = 0; i < devHandle->bufferCount; i++) {
                 v4l2_buffer buf = {};
                 buf.type        = V4L2_BUF_TYPE_VIDEO_CAPTURE;
                 buf.memory      = V4L2_MEMORY_MMAP;
@@ -442,10 +444,10 @@ void ObV4lUvcDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandle> devHandle)
             int            val       = select(max_fd + 1, &fds, nullptr, nullptr, &remaining);
             if(val < 0) {
                 if(errno == EINTR) {
-                    LOG_INTVL(LOG_INTVL_OBJECT_TAG + "captureLoop", 5000, spdlog::level::debug, "select interrupted: {}", strerror(errno));
+                    LOG_INTVL(LOG_INTVL_OBJECT_TAG, 5000, spdlog::level::debug, "select interrupted: {}", strerror(errno));
                 }
                 else {
-                    LOG_INTVL(LOG_INTVL_OBJECT_TAG + "captureLoop", 5000, spdlog::level::debug, "select failed: {}", strerror(errno));
+                    LOG_INTVL(LOG_INTVL_OBJECT_TAG, 5000, spdlog::level::debug, "select failed: {}", strerror(errno));
                 }
                 continue;
             }
@@ -469,7 +471,7 @@ void ObV4lUvcDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandle> devHandle)
                 buf.type        = LOCAL_V4L2_BUF_TYPE_META_CAPTURE;
                 buf.memory      = V4L2_MEMORY_MMAP;
                 if(xioctl(devHandle->metadataFd, VIDIOC_DQBUF, &buf) < 0) {
-                    LOG_INTVL(LOG_INTVL_OBJECT_TAG + "captureLoop", 5000, spdlog::level::err, "devHandle->metadataFd VIDIOC_DQBUF failed, {}, {}",
+                    LOG_INTVL(LOG_INTVL_OBJECT_TAG, 5000, spdlog::level::err, "devHandle->metadataFd VIDIOC_DQBUF failed, {}, {}",
                               strerror(errno), devHandle->metadataInfo->name);
                 }
                 if(buf.bytesused) {
@@ -483,20 +485,35 @@ void ObV4lUvcDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandle> devHandle)
 
             if(FD_ISSET(devHandle->fd, &fds)) {
                 FD_CLR(devHandle->fd, &fds);
-                v4l2_buffer buf = {};
-                buf.type        = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-                buf.memory      = V4L2_MEMORY_MMAP;
+                auto       &poolBuffers = devHandle->framePoolBuffers;
+                v4l2_buffer buf         = {};
+                buf.type                = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                buf.memory              = poolBuffers ? V4L2_MEMORY_USERPTR : V4L2_MEMORY_MMAP;
                 // reader buffer
                 if(xioctl(devHandle->fd, VIDIOC_DQBUF, &buf) < 0) {
-                    LOG_INTVL(LOG_INTVL_OBJECT_TAG + "captureLoop", 5000, spdlog::level::err, "devHandle->fd VIDIOC_DQBUF failed, {}, {}", strerror(errno),
+                    LOG_INTVL(LOG_INTVL_OBJECT_TAG, 5000, spdlog::level::err, "devHandle->fd VIDIOC_DQBUF failed, {}, {}", strerror(errno),
                               devHandle->info->name);
+                    continue;
                 }
 
-                if(buf.bytesused) {
+                std::shared_ptr<VideoFrame> videoFrame;
+                if(poolBuffers) {
+                    // captured straight into the frame, a new frame from the pool is queued in its place
+                    videoFrame = poolBuffers->take(buf);
+                }
+                else {
+                    if(buf.bytesused) {
+                        TRY_EXECUTE({
+                            auto rawframe = FrameFactory::createFrameFromStreamProfile(devHandle->profile);
+                            videoFrame    = rawframe->as<VideoFrame>();
+                            videoFrame->updateData(static_cast<const uint8_t *>(devHandle->buffers[buf.index].ptr), buf.bytesused);
+                        })
+                    }
+                    xioctl(devHandle->fd, VIDIOC_QBUF, &buf);
+                }
+
+                if(videoFrame) {
                     TRY_EXECUTE({
-                        auto rawframe   = FrameFactory::createFrameFromStreamProfile(devHandle->profile);
-                        auto videoFrame = rawframe->as<VideoFrame>();
-                        videoFrame->updateData(static_cast<const uint8_t *>(devHandle->buffers[buf.index].ptr), buf.bytesused);
                         if(metadataBufferIndex >= 0 && devHandle->metadataBuffers[metadataBufferIndex].sequence == buf.sequence) {
                             auto uvc_payload_header     = devHandle->metadataBuffers[metadataBufferIndex].ptr + sizeof(V4L2UvcMetaHeader);
                             auto uvc_payload_header_len = devHandle->metadataBuffers[metadataBufferIndex].actual_length - sizeof(V4L2UvcMetaHeader);
@@ -516,8 +533,6 @@ void ObV4lUvcDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandle> devHandle)
                         devHandle->loopFrameIndex++;
                     })
                 }
-
-                xioctl(devHandle->fd, VIDIOC_QBUF, &buf);
             }
         }
     }
@@ -601,7 +616,7 @@ void ObV4lUvcDevicePort::startStream(std::shared_ptr<const StreamProfile> profil
         }
 
         struct v4l2_requestbuffers req = {};
-        req.count                      = MAX_BUFFER_COUNT;
+        req.count                      = captureConfig_.bufferCount;
         req.type                       = LOCAL_V4L2_BUF_TYPE_META_CAPTURE;
         req.memory                     = V4L2_MEMORY_MMAP;
         if(xioctl(devHandle->metadataFd, VIDIOC_REQBUFS, &req) < 0) {
@@ -618,6 +633,7 @@ void ObV4lUvcDevicePort::startStream(std::shared_ptr<const StreamProfile> profil
             devHandle->metadataBuffers[i].ptr    = (uint8_t *)mmap(NULL, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, devHandle->metadataFd, buf.m.offset);
             devHandle->metadataBuffers[i].length = buf.length;
         }
+        devHandle->metadataBufferCount = std::min(req.count, MAX_BUFFER_COUNT);
 
         v4l2_buf_type bufType = LOCAL_V4L2_BUF_TYPE_META_CAPTURE;
         if(xioctl(devHandle->metadataFd, VIDIOC_STREAMON, &bufType) < 0) {
@@ -664,27 +680,42 @@ void ObV4lUvcDevicePort::startStream(std::shared_ptr<const StreamProfile> profil
         THROW_IO_EXCEPTION("Failed to get streamparm!" + devHandle->info->name + ", " + strerror(err));
     }
 
-    struct v4l2_requestbuffers req = {};
-    req.count                      = MAX_BUFFER_COUNT;
-    req.type                       = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    req.memory                     = V4L2_MEMORY_MMAP;
-    if(xioctl(devHandle->fd, VIDIOC_REQBUFS, &req) < 0) {
-        auto err = errno;
-        stopStream(devHandle);
-        THROW_IO_EXCEPTION("Failed to request buffers!" + devHandle->info->name + ", " + strerror(err));
-    }
-    for(uint32_t i = 0; i < req.count && i < MAX_BUFFER_COUNT; i++) {
-        struct v4l2_buffer buf = {};
-        buf.type               = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-        buf.memory             = V4L2_MEMORY_MMAP;
-        buf.index              = i;
-        if(xioctl(devHandle->fd, VIDIOC_QUERYBUF, &buf) < 0) {
+    devHandle->framePoolBuffers.reset();
+    if(captureConfig_.zeroCopy) {
+        auto poolBuffers = std::make_shared<V4lFramePoolBuffers>(devHandle->fd, videoProfile);
+        if(poolBuffers->start(captureConfig_.bufferCount, fmt.fmt.pix.sizeimage)) {
+            devHandle->framePoolBuffers = poolBuffers;
+            devHandle->bufferCount      = poolBuffers->getBufferCount();
+        }
+        else {
+            LOG_INFO("Zero-copy capture is not supported by {}, using mmap buffers", devHandle->info->name);
+        }
+    }
+
+    if(!devHandle->framePoolBuffers) {
+        struct v4l2_requestbuffers req = {};
+        req.count                      = captureConfig_.bufferCount;
+        req.type                       = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        req.memory                     = V4L2_MEMORY_MMAP;
+        if(xioctl(devHandle->fd, VIDIOC_REQBUFS, &req) < 0) {
             auto err = errno;
             stopStream(devHandle);
-            THROW_IO_EXCEPTION("Failed to query buffer!" + devHandle->info->name + ", " + strerror(err));
+            THROW_IO_EXCEPTION("Failed to request buffers!" + devHandle->info->name + ", " + strerror(err));
+        }
+        for(uint32_t i = 0; i < req.count && i < MAX_BUFFER_COUNT; i++) {
+            struct v4l2_buffer buf = {};
+            buf.type               = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory             = V4L2_MEMORY_MMAP;
+            buf.index              = i;
+            if(xioctl(devHandle->fd, VIDIOC_QUERYBUF, &buf) < 0) {
+                auto err = errno;
+                stopStream(devHandle);
+                THROW_IO_EXCEPTION("Failed to query buffer!" + devHandle->info->name + ", " + strerror(err));
+            }
+            devHandle->buffers[i].ptr    = (uint8_t *)mmap(NULL, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, devHandle->fd, buf.m.offset);
+            devHandle->buffers[i].length = buf.length;
         }
-        devHandle->buffers[i].ptr    = (uint8_t *)mmap(NULL, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, devHandle->fd, buf.m.offset);
-        devHandle->buffers[i].length = buf.length;
+        devHandle->bufferCount = std::min(req.count, MAX_BUFFER_COUNT);
     }
 
     if(pipe(devHandle->stopPipeFd) < 0) {
@@ -802,14 +833,22 @@ void ObV4lUvcDevicePort::stopStream(std::shared_ptr<V4lDeviceHandle> devHandle)
     clearUp(devHandle);
 
     struct v4l2_requestbuffers req = {};
-    req.count                      = 0;
-    req.type                       = type;
-    req.memory                     = V4L2_MEMORY_MMAP;
-    if(xioctl(devHandle->fd, VIDIOC_REQBUFS, &req) < 0) {
-        auto err = errno;
-        LOG_ERROR("Failed to request buffers! Device: {}, error: {}", devHandle->info->name, std::string(strerror(err)));
-        // continue to clean others
+    if(devHandle->framePoolBuffers) {
+        devHandle->framePoolBuffers->stop();
+        devHandle->framePoolBuffers.reset();
+    }
+    else {
+        req.count  = 0;
+        req.type   = type;
+        req.memory = V4L2_MEMORY_MMAP;
+        if(xioctl(devHandle->fd, VIDIOC_REQBUFS, &req) < 0) {
+            auto err = errno;
+            LOG_ERROR("Failed to request buffers! Device: {}, error: {}", devHandle->info->name, std::string(strerror(err)));
+            // continue to clean others
+        }
     }
+    devHandle->bufferCount         = 0;
+    devHandle->metadataBufferCount = 0;
 
     if(devHandle->metadataFd >= 0) {
         type = LOCAL_V4L2_BUF_TYPE_META_CAPTURE;
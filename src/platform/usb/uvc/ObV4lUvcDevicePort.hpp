@@ -11,6 +11,7 @@
 
 #include "utils/SteadyCondVar.hpp"
 #include "UvcDevicePort.hpp"
+#include "V4lFramePoolBuffers.hpp"
 #include "stream/StreamProfile.hpp"
 
 #include <linux/uvcvideo.h>
@@ -35,8 +36,11 @@ constexpr bool metadata_node = false;
 
 namespace libobsensor {
 
+int xioctl(int fh, unsigned long request, void *arg);
+
 static const uint32_t MAX_META_DATA_SIZE       = 255;
-static const uint32_t MAX_BUFFER_COUNT         = 4;
+static const uint32_t MAX_BUFFER_COUNT         = 32;  // VIDEO_MAX_FRAME, upper limit of Device.LinuxV4L2BufferCount
+static const uint32_t DEFAULT_BUFFER_COUNT     = 4;
 static const uint32_t LOCAL_V4L2_META_FMT_D4XX = v4l2_fourcc('D', '4', 'X', 'X');  // borrows from videodev2.h, using for getting extention metadata
 #define LOCAL_V4L2_BUF_TYPE_META_CAPTURE ((v4l2_buf_type)13)
 
@@ -70,10 +74,13 @@ struct V4lDeviceHandle {
     std::shared_ptr<V4lDeviceInfo>                info;
     int                                           fd = -1;
     std::array<V4L2FrameBuffer, MAX_BUFFER_COUNT> buffers;
+    uint32_t                                      bufferCount = 0;    // buffers requested on startStream
+    std::shared_ptr<V4lFramePoolBuffers>          framePoolBuffers;   // replaces the mmap buffers in zero-copy mode
 
     std::shared_ptr<V4lDeviceInfo>                metadataInfo;
     int                                           metadataFd = -1;
     std::array<V4L2FrameBuffer, MAX_BUFFER_COUNT> metadataBuffers;
+    uint32_t                                      metadataBufferCount = 0;
 
     MutableFrameCallback                      frameCallback;
     std::shared_ptr<const VideoStreamProfile> profile = nullptr;
@@ -130,6 +137,7 @@ private:
     std::vector<std::shared_ptr<V4lDeviceHandle>> deviceHandles_;
     std::recursive_mutex                          ctrlMutex_;
     std::recursive_mutex                          streamMutex_;
+    V4lCaptureConfig                              captureConfig_;
 };
 
 }  // namespace libobsensor
@@ -0,0 +1,122 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "V4lFramePoolBuffers.hpp"
+#include "ObV4lUvcDevicePort.hpp"
+
+#include "logger/Logger.hpp"
+#include "logger/LoggerInterval.hpp"
+#include "environment/EnvConfig.hpp"
+#include "frame/FrameFactory.hpp"
+#include "utils/PublicTypeHelper.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace libobsensor {
+
+V4lCaptureConfig loadV4lCaptureConfig(uint32_t defaultBufferCount, uint32_t maxBufferCount) {
+    auto             envConfig = EnvConfig::getInstance();
+    V4lCaptureConfig config    = { defaultBufferCount, false };
+
+    int bufferCount = 0;
+    if(envConfig->getIntValue("Device.LinuxV4L2BufferCount", bufferCount) && bufferCount > 0) {
+        // The driver needs one buffer to capture into while another one is processed
+        config.bufferCount = std::min(std::max(static_cast<uint32_t>(bufferCount), 2u), maxBufferCount);
+    }
+    envConfig->getBooleanValue("Device.LinuxV4L2ZeroCopy", config.zeroCopy);
+    return config;
+}
+
+V4lFramePoolBuffers::V4lFramePoolBuffers(int fd, std::shared_ptr<const VideoStreamProfile> profile)
+    : fd_(fd), profile_(profile), frameType_(utils::mapStreamTypeToFrameType(profile->getType())), frameSize_(0) {}
+
+bool V4lFramePoolBuffers::start(uint32_t bufferCount, uint32_t imageSize) {
+    // The driver rejects buffers smaller than the image size, which may be larger than the frame size of the pool (compressed formats)
+    frameSize_ = std::max<size_t>(imageSize, utils::calcVideoFrameMaxDataSize(profile_->getFormat(), profile_->getWidth(), profile_->getHeight()));
+
+    struct v4l2_requestbuffers req = {};
+    req.count                      = bufferCount;
+    req.type                       = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory                     = V4L2_MEMORY_USERPTR;
+    if(xioctl(fd_, VIDIOC_REQBUFS, &req) < 0 || req.count == 0) {
+        LOG_DEBUG("USERPTR capture buffers are not supported: {}", strerror(errno));
+        return false;
+    }
+
+    try {
+        frames_.resize(req.count);
+        for(uint32_t i = 0; i < req.count; i++) {
+            frames_[i] = createFrame();
+            if(!queue(i)) {
+                LOG_DEBUG("Failed to queue a USERPTR capture buffer: {}", strerror(errno));
+                stop();
+                return false;
+            }
+        }
+    }
+    catch(const std::exception &e) {
+        LOG_WARN("Failed to allocate the frames of the capture buffers: {}", e.what());
+        stop();
+        return false;
+    }
+    LOG_DEBUG("Capturing into {} frames of the frame memory pool, frame size {}", frames_.size(), frameSize_);
+    return true;
+}
+
+void V4lFramePoolBuffers::stop() {
+    struct v4l2_requestbuffers req = {};
+    req.count                      = 0;
+    req.type                       = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory                     = V4L2_MEMORY_USERPTR;
+    if(xioctl(fd_, VIDIOC_REQBUFS, &req) < 0) {
+        LOG_ERROR("Failed to release USERPTR capture buffers: {}", strerror(errno));
+    }
+    frames_.clear();
+}
+
+std::shared_ptr<VideoFrame> V4lFramePoolBuffers::take(const v4l2_buffer &buf) {
+    if(buf.index >= frames_.size() || !frames_[buf.index]) {
+        return nullptr;
+    }
+
+    std::shared_ptr<Frame> captured;
+    if(buf.bytesused > 0 && !(buf.flags & V4L2_BUF_FLAG_ERROR)) {
+        try {
+            auto frame         = createFrame();
+            captured           = std::move(frames_[buf.index]);
+            frames_[buf.index] = std::move(frame);
+        }
+        catch(const std::exception &e) {
+            LOG_WARN_INTVL("{} failed to acquire a frame buffer, frame dropped: {}", profile_->getType(), e.what());
+        }
+    }
+
+    if(!queue(buf.index)) {
+        LOG_WARN_INTVL("Failed to queue USERPTR capture buffer {}: {}", buf.index, strerror(errno));
+    }
+    if(!captured) {
+        return nullptr;
+    }
+    captured->setDataSize(std::min<size_t>(buf.bytesused, frameSize_));
+    return captured->as<VideoFrame>();
+}
+
+std::shared_ptr<Frame> V4lFramePoolBuffers::createFrame() {
+    auto frame = FrameFactory::createFrame(frameType_, profile_->getFormat(), frameSize_);
+    frame->setStreamProfile(profile_);
+    return frame;
+}
+
+bool V4lFramePoolBuffers::queue(uint32_t index) {
+    auto       &frame = frames_[index];
+    v4l2_buffer buf   = {};
+    buf.type          = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory        = V4L2_MEMORY_USERPTR;
+    buf.index         = index;
+    buf.m.userptr     = reinterpret_cast<unsigned long>(frame->getDataMutable());
+    buf.length        = static_cast<uint32_t>(frameSize_);
+    return xioctl(fd_, VIDIOC_QBUF, &buf) >= 0;
+}
+
+}  // namespace libobsensor
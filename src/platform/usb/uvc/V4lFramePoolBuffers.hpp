@@ -0,0 +1,81 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "frame/Frame.hpp"
+#include "stream/StreamProfile.hpp"
+
+#include <linux/videodev2.h>
+
+namespace libobsensor {
+
+// Capture settings of the V4L2 device ports, read from the Device node of the config file
+struct V4lCaptureConfig {
+    uint32_t bufferCount;  // number of capture buffers requested from the driver
+    bool     zeroCopy;     // capture straight into frames of the frame memory pool, see V4lFramePoolBuffers
+};
+
+/**
+ * @brief Loads Device.LinuxV4L2BufferCount and Device.LinuxV4L2ZeroCopy.
+ *
+ * @param[in] defaultBufferCount buffer count used if the config file does not set one
+ * @param[in] maxBufferCount upper limit of the buffer count
+ */
+V4lCaptureConfig loadV4lCaptureConfig(uint32_t defaultBufferCount, uint32_t maxBufferCount);
+
+/**
+ * @brief V4L2_MEMORY_USERPTR capture buffers backed by frames of the frame memory pool.
+ *
+ * The data buffer of a frame is queued to the driver and the driver captures straight into it, so the dequeued frame is handed out without copying
+ * and a new frame from the pool takes its place in the queue. If the pool can not provide a new frame (the application holds on to too many
+ * frames), the dequeued frame is queued again and its image is dropped.
+ *
+ * Only used by the capture thread once started; stop() must be called after VIDIOC_STREAMOFF.
+ */
+class V4lFramePoolBuffers {
+public:
+    V4lFramePoolBuffers(int fd, std::shared_ptr<const VideoStreamProfile> profile);
+    ~V4lFramePoolBuffers() noexcept = default;
+
+    /**
+     * @brief Requests the USERPTR buffers and queues a frame in each of them.
+     *
+     * @param[in] bufferCount number of buffers to request
+     * @param[in] imageSize image size of the format set on the device (v4l2_pix_format::sizeimage)
+     *
+     * @return false if the driver does not accept USERPTR buffers or the frames, nothing stays requested in that case
+     */
+    bool start(uint32_t bufferCount, uint32_t imageSize);
+
+    /**
+     * @brief Releases the buffers, the frames that were handed out stay valid.
+     */
+    void stop();
+
+    /**
+     * @brief Takes the frame of a dequeued buffer and queues a new frame in its place.
+     *
+     * @return the captured frame with its data size set to buf.bytesused, nullptr if it had to be queued again
+     */
+    std::shared_ptr<VideoFrame> take(const v4l2_buffer &buf);
+
+    uint32_t getBufferCount() const {
+        return static_cast<uint32_t>(frames_.size());
+    }
+
+private:
+    std::shared_ptr<Frame> createFrame();
+    bool                   queue(uint32_t index);
+
+private:
+    int                                       fd_;
+    std::shared_ptr<const VideoStreamProfile> profile_;
+    OBFrameType                               frameType_;
+    size_t                                    frameSize_;
+    std::vector<std::shared_ptr<Frame>>       frames_;  // frame queued in each buffer
+};
+
+}  // namespace libobsensor
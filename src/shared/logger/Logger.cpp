@@ -22,10 +22,6 @@
 
 #include <map>
 
-std::map<std::string, std::shared_ptr<ObLogIntvlRecord>> logIntvlRecordMap;
-std::mutex                                               logIntvlRecordMapMtx;
-std::atomic<bool>                                        logIntvlRecordMapDestroyed(false);
-
 namespace libobsensor {
 
 const std::map<OBLogSeverity, spdlog::level::level_enum> OBLogSeverityToSpdlogLevel = {
@@ -57,6 +53,7 @@ const std::string   OB_DEFAULT_LOG_FMT       = "[%m/%d %H:%M:%S.%f][%l][%t][%s:%
 const uint64_t      OB_DEFAULT_MAX_FILE_SIZE = 1024 * 1024 * 100;
 const uint16_t      OB_DEFAULT_MAX_FILE_NUM  = 3;
 const std::string   OB_DEFAULT_LOG_FILE_NAME = "OrbbecSDK.log.txt";
+const size_t        OB_LOG_INTVL_QUEUE_SIZE  = 1024;
 
 struct Logger::LoggerConfig {
     bool          loadFileLogSeverityFromEnvConfig = true;
@@ -97,26 +94,28 @@ std::shared_ptr<Logger> Logger::getInstance() {
 
 Logger::Logger() : spdlogRegistry_(spdlog::details::registry::instance_ptr()) {
     spdlog::set_pattern(OB_DEFAULT_LOG_FMT);
-
-    std::lock_guard<std::mutex> lock(logIntvlRecordMapMtx);
-    logIntvlRecordMapDestroyed = false;
     loadEnvConfig();
+
+    // Queue of the interval controlled logs, a single thread keeps them in order. The interval controlled logs are called on hot paths (capture
+    // loops), they never block on the sinks: the oldest queued message is dropped if the queue is full
+    intvlThreadPool_ = std::make_shared<spdlog::details::thread_pool>(OB_LOG_INTVL_QUEUE_SIZE, 1);
+    intvlSink_       = std::make_shared<spdlog::sinks::dist_sink_mt>();
+    intvlLogger_     = std::make_shared<spdlog::async_logger>(sdkLibName_, intvlSink_, intvlThreadPool_, spdlog::async_overflow_policy::overrun_oldest);
+    intvlLogger_->set_level(spdlog::level::trace);
     createConsoleSink();
     createFileSink();
     createCallbackSink();
     updateDefaultSpdLogger();
+    log_intvl_start_flusher();
 }
 
 Logger::~Logger() noexcept {
-    {
-        std::lock_guard<std::mutex> lock(logIntvlRecordMapMtx);
-        logIntvlRecordMapDestroyed = true;
-        for(auto &it: logIntvlRecordMap) {
-            it.second->flush();
-            it.second.reset();
-        }
-        logIntvlRecordMap.clear();
-    }
+    log_intvl_stop_flusher();
+    log_intvl_set_logger(nullptr);  // a thread still logging keeps intvlLogger_ alive, its message is lost once the thread pool is gone
+    intvlLogger_->flush();
+    intvlLogger_.reset();
+    intvlSink_.reset();
+    intvlThreadPool_.reset();
 
     spdlog::set_default_logger(std::make_shared<spdlog::logger>("EmptySinksLogger"));
 
@@ -235,6 +234,11 @@ void Logger::updateDefaultSpdLogger() {
                                               // level)
     spdlog::flush_on(config_.periodicFlush ? spdlog::level::warn : spdlog::level::trace);  // Set the flush log level
     spdlog::set_pattern(OB_DEFAULT_LOG_FMT);
+
+    // The interval controlled logs keep their logger, only its sinks change
+    intvlSink_->set_sinks(sinks);
+    intvlLogger_->flush_on(config_.periodicFlush ? spdlog::level::warn : spdlog::level::trace);
+    log_intvl_set_logger(intvlLogger_);
 }
 
 void Logger::loadEnvConfig() {
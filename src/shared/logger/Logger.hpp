@@ -42,11 +42,19 @@
 #include <atomic>
 #include <string>
 #include <memory>
+#include <vector>
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/ostr.h>
+#include <spdlog/sinks/dist_sink.h>
 #include "LoggerTypeHelper.hpp"
 #include <libobsensor/h/ObTypes.h>
 
+namespace spdlog {
+namespace details {
+class thread_pool;
+}
+}  // namespace spdlog
+
 namespace libobsensor {
 typedef std::function<void(OBLogSeverity severity, const std::string &logMsg)> LogCallback;
 
@@ -89,6 +97,12 @@ private:
     spdlog::sink_ptr fileSink_;
     spdlog::sink_ptr callbackSink_;
 
+    // Async logger of the interval controlled logs (LoggerInterval.hpp), created once: updateDefaultSpdLogger() swaps the sinks of intvlSink_,
+    // so the logging threads keep a valid raw pointer to it until the destructor
+    std::shared_ptr<spdlog::details::thread_pool> intvlThreadPool_;
+    std::shared_ptr<spdlog::sinks::dist_sink_mt>  intvlSink_;
+    std::shared_ptr<spdlog::logger>               intvlLogger_;
+
     std::shared_ptr<spdlog::details::registry> spdlogRegistry_;  // handle spdlog registry instance to control it's life cycle
 };
 }  // namespace libobsensor
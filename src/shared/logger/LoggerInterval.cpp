@@ -0,0 +1,178 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "LoggerInterval.hpp"
+#include "utils/SteadyCondVar.hpp"
+
+#include <chrono>
+#include <ctime>
+#include <mutex>
+
+namespace {
+
+const uint64_t FLUSH_PERIOD_MSEC = 100;                   // period of the flusher thread
+const uint64_t SLOT_IDLE_MSEC    = 2 * MAX_LOG_INTERVAL;  // a slot unused for this long is released for other tags
+
+std::atomic<ObLogIntvlSite *>   logIntvlSites(nullptr);
+std::shared_ptr<spdlog::logger> logIntvlLogger;  // accessed with std::atomic_load/std::atomic_store only
+
+std::mutex                        flusherMtx;
+libobsensor::utils::SteadyCondVar flusherCv;
+std::thread                       flusherThread;
+bool                              flusherStopped = true;
+
+void initSlot(ObLogIntvlSlot &slot, uint64_t interval) {
+    slot.tag          = 0;
+    slot.lastOutputMs = 0;
+    slot.interval     = interval;
+    slot.count        = 0;
+    slot.lastCallUs   = 0;
+    slot.msgLock.clear();
+    slot.msgSize = 0;
+}
+
+void flushSlot(const ObLogIntvlSite &site, ObLogIntvlSlot &slot, uint64_t nowTime, bool force) {
+    uint64_t last = slot.lastOutputMs.load(std::memory_order_relaxed);
+    if(slot.count.load(std::memory_order_acquire) == 0) {
+        // Release the slot of a tag that is no longer used (e.g. the object was destroyed)
+        if(slot.tag.load(std::memory_order_relaxed) != 0 && last != 0 && nowTime - last > SLOT_IDLE_MSEC) {
+            slot.interval.store(site.minIntvlMsec, std::memory_order_relaxed);
+            slot.lastOutputMs.store(0, std::memory_order_relaxed);
+            slot.tag.store(0, std::memory_order_release);
+        }
+        return;
+    }
+    if(!force && nowTime - last <= slot.interval.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // The message is still being written: retry on the next period
+    if(slot.msgLock.test_and_set(std::memory_order_acquire)) {
+        return;
+    }
+    if(slot.msgSize == 0 || !slot.lastOutputMs.compare_exchange_strong(last, nowTime, std::memory_order_acq_rel)) {
+        slot.msgLock.clear(std::memory_order_release);
+        return;
+    }
+
+    uint32_t count = slot.count.exchange(0, std::memory_order_acq_rel);
+    if(count > 0) {
+        uint64_t duration = nowTime - last;
+        uint64_t lastCall = slot.lastCallUs.load(std::memory_order_relaxed);
+        time_t   seconds  = static_cast<time_t>(lastCall / 1000000);
+        char     timestampStr[32];
+        std::strftime(timestampStr, sizeof(timestampStr), "%H:%M:%S", std::localtime(&seconds));
+
+        ObLogIntvlLoggerRef logger;
+        logger->log(site.srcLoc, site.level, "{} [**{} logs in {}ms, last: {}.{:06d}**]", fmt::string_view(slot.msg, slot.msgSize), count,
+                    duration, timestampStr, lastCall % 1000000);
+        log_intvl_update_interval(site, slot, duration, count);
+    }
+    slot.msgSize = 0;
+    slot.msgLock.clear(std::memory_order_release);
+}
+
+void flushSites(bool force) {
+    uint64_t nowTime = log_intvl_steady_msec();
+    for(auto site = logIntvlSites.load(std::memory_order_acquire); site != nullptr; site = site->next) {
+        for(auto &slot: site->slots) {
+            flushSlot(*site, slot, nowTime, force);
+        }
+        flushSlot(*site, site->overflow, nowTime, force);
+    }
+}
+
+}  // namespace
+
+ObLogIntvlSite::ObLogIntvlSite(const char *file, int line, const char *func, spdlog::level::level_enum lvl, uint64_t minIntvl)
+    : srcLoc(file, line, func), level(lvl), minIntvlMsec(minIntvl), next(nullptr) {
+    for(auto &slot: slots) {
+        initSlot(slot, minIntvlMsec);
+    }
+    initSlot(overflow, minIntvlMsec);
+
+    // Sites are never unregistered, they are statics
+    next = logIntvlSites.load(std::memory_order_relaxed);
+    while(!logIntvlSites.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+ObLogIntvlSlot &ObLogIntvlSite::getSlot(uint64_t tag) {
+    if(tag == 0) {
+        tag = 1;  // 0 marks a free slot
+    }
+    auto start = static_cast<size_t>((tag ^ (tag >> 17) ^ (tag >> 31)) % LOG_INTVL_SITE_SLOTS);
+    for(size_t i = 0; i < LOG_INTVL_SITE_SLOTS; i++) {
+        auto    &slot    = slots[(start + i) % LOG_INTVL_SITE_SLOTS];
+        uint64_t slotTag = slot.tag.load(std::memory_order_acquire);
+        if(slotTag == tag) {
+            return slot;
+        }
+        if(slotTag == 0) {
+            if(slot.tag.compare_exchange_strong(slotTag, tag, std::memory_order_acq_rel) || slotTag == tag) {
+                return slot;
+            }
+        }
+    }
+    return overflow;
+}
+
+ObLogIntvlLoggerRef::ObLogIntvlLoggerRef() : logger_(std::atomic_load(&logIntvlLogger)) {
+    if(!logger_) {
+        logger_ = spdlog::default_logger();
+    }
+}
+
+void log_intvl_set_logger(std::shared_ptr<spdlog::logger> logger) {
+    std::atomic_store(&logIntvlLogger, std::move(logger));
+}
+
+void log_intvl_start_flusher() {
+    std::unique_lock<std::mutex> lock(flusherMtx);
+    if(!flusherStopped) {
+        return;
+    }
+    flusherStopped = false;
+    flusherThread  = std::thread([]() {
+        std::unique_lock<std::mutex> threadLock(flusherMtx);
+        while(!flusherStopped) {
+            flusherCv.wait_for(threadLock, std::chrono::milliseconds(FLUSH_PERIOD_MSEC), []() { return flusherStopped; });
+            threadLock.unlock();
+            flushSites(false);
+            threadLock.lock();
+        }
+    });
+}
+
+void log_intvl_stop_flusher() {
+    {
+        std::unique_lock<std::mutex> lock(flusherMtx);
+        if(flusherStopped) {
+            return;
+        }
+        flusherStopped = true;
+    }
+    flusherCv.notify_all();
+    if(flusherThread.joinable()) {
+        flusherThread.join();
+    }
+    flushSites(true);
+}
+
+uint64_t log_intvl_steady_msec() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint64_t log_intvl_system_usec() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+void log_intvl_update_interval(const ObLogIntvlSite &site, ObLogIntvlSlot &slot, uint64_t duration, uint32_t count) {
+    uint64_t interval = slot.interval.load(std::memory_order_relaxed);
+    if(duration / count < interval) {  // Reduce the log output frequency
+        interval = std::min<uint64_t>(interval * 2, MAX_LOG_INTERVAL);
+    }
+    else {
+        interval = site.minIntvlMsec;  // Restore the log output frequency
+    }
+    slot.interval.store(interval, std::memory_order_relaxed);
+}
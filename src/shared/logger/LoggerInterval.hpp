@@ -6,180 +6,141 @@
 #include "Logger.hpp"
 #include <spdlog/common.h>
 #include <spdlog/fmt/fmt.h>
-#include <spdlog/fmt/chrono.h>
-#include <map>
-#include <sstream>
-#include <string>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <thread>
-#include <mutex>
-#include <ctime>
-#include "utils/SteadyCondVar.hpp"
 
-#define LOG_RECORD_MAP_SIZE_LIMIT 500  // Maximum number of log entries
-#define MAX_LOG_INTERVAL 60 * 1000     // Maximum log output interval: 60000ms
-#define DEF_MIN_LOG_INTVL 3000         // Default minimum log output interval: 3000ms
-#define LOG_INTVL_OBJECT_TAG std::string(__FILE__) + std::to_string(__LINE__) + std::to_string((uint64_t)this)
+#define MAX_LOG_INTERVAL 60 * 1000  // Maximum log output interval: 60000ms
+#define DEF_MIN_LOG_INTVL 3000      // Default minimum log output interval: 3000ms
+#define LOG_INTVL_SITE_SLOTS 8      // Number of tags (objects, threads) rate limited separately at one call site
+#define LOG_INTVL_MSG_SIZE 256      // Maximum length of the suppressed message output by the flusher thread
+#define LOG_INTVL_OBJECT_TAG reinterpret_cast<uintptr_t>(this)
+
+// Rate limiting state of one tag at a call site, shared lock-free by the logging threads and the flusher thread
+struct ObLogIntvlSlot {
+    std::atomic<uint64_t> tag;           // 0 if the slot is free
+    std::atomic<uint64_t> lastOutputMs;  // steady clock time of the last output, 0 if nothing was output yet
+    std::atomic<uint64_t> interval;      // current output interval in ms
+    std::atomic<uint32_t> count;         // number of calls suppressed since the last output
+    std::atomic<uint64_t> lastCallUs;    // system clock time of the last suppressed call
+    std::atomic_flag      msgLock;       // held while msg is written or output
+    uint32_t              msgSize;
+    char                  msg[LOG_INTVL_MSG_SIZE];  // first message suppressed since the last output
+};
 
-struct ObLogIntvlRecord {
-    uint32_t                              count    = 0;
-    uint64_t                              interval = 0;
-    std::chrono::system_clock::time_point lastInvokeTime;
-    std::chrono::system_clock::time_point lastLogTime;
-    std::thread                           invokeThread;
-    std::mutex                            mtx;
-    libobsensor::utils::SteadyCondVar     cv;
-    void                                  flush() {
-        cv.notify_all();
-        if(invokeThread.joinable()) {
-            invokeThread.join();
-        }
-    }
-    ~ObLogIntvlRecord() {
-        flush();
-    }
+// Rate limiting state of one LOG_INTVL call site, a function local static: no allocation and no lookup in a shared map on the logging path.
+// All members are trivially destructible, so the flusher thread may still walk the sites during static destruction.
+struct ObLogIntvlSite {
+    ObLogIntvlSite(const char *file, int line, const char *func, spdlog::level::level_enum level, uint64_t minIntvlMsec);
+
+    // Slot of the tag, the tags that find no free slot share the overflow slot
+    ObLogIntvlSlot &getSlot(uint64_t tag);
+
+    spdlog::source_loc        srcLoc;
+    spdlog::level::level_enum level;
+    uint64_t                  minIntvlMsec;
+    ObLogIntvlSlot            slots[LOG_INTVL_SITE_SLOTS];
+    ObLogIntvlSlot            overflow;
+    ObLogIntvlSite           *next;  // next registered site, see log_intvl_flush
 };
 
-extern std::atomic<bool>                                        logIntvlRecordMapDestroyed;
-extern std::map<std::string, std::shared_ptr<ObLogIntvlRecord>> logIntvlRecordMap;
-extern std::mutex                                               logIntvlRecordMapMtx;
+// Logger of the interval controlled logs: an async logger with a bounded queue that drops the oldest messages instead of blocking the caller,
+// the default logger before the Logger instance is created. The logging threads hold a reference to it while they output: a logger replaced
+// by log_intvl_set_logger() is destroyed by the last thread done with it, the setter never waits for them.
+class ObLogIntvlLoggerRef {
+public:
+    ObLogIntvlLoggerRef();
 
-inline void log_intvl_invoke(std::shared_ptr<ObLogIntvlRecord> record, uint64_t minIntvlMsec, spdlog::source_loc src_loc, spdlog::level::level_enum level,
-                             std::string msg) {
-    std::unique_lock<std::mutex> lock(record->mtx);
-    record->cv.wait_for(lock, std::chrono::milliseconds(record->interval));
-    if(record->count > 0) {
-        auto     nowTime  = std::chrono::system_clock::now();
-        uint64_t duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(nowTime - record->lastInvokeTime).count());
+    ObLogIntvlLoggerRef(const ObLogIntvlLoggerRef &)            = delete;
+    ObLogIntvlLoggerRef &operator=(const ObLogIntvlLoggerRef &) = delete;
 
-        char   timestampStr[100];
-        time_t timestamp = std::chrono::duration_cast<std::chrono::seconds>(record->lastLogTime.time_since_epoch()).count();
-        std::strftime(timestampStr, sizeof(timestampStr), "%H:%M:%S", std::localtime(&timestamp));
+    spdlog::logger *operator->() const {
+        return logger_.get();
+    }
 
-        auto us    = std::chrono::duration_cast<std::chrono::microseconds>(record->lastLogTime.time_since_epoch()).count() % 1000000;
-        auto usStr = fmt::format("{:06d}", us);
+private:
+    std::shared_ptr<spdlog::logger> logger_;
+};
 
-        std::string final_msg =
-            msg + " [**" + std::to_string(record->count) + " logs in " + std::to_string(duration) + "ms, last: " + timestampStr + "." + usStr + "**]";
-        spdlog::default_logger_raw()->log(src_loc, level, "{}", final_msg);
+void log_intvl_set_logger(std::shared_ptr<spdlog::logger> logger);
 
-        uint64_t avgInterval = duration / record->count;
-        if(avgInterval < record->interval) {  // Reduce log output frequency
-            record->interval *= 2;
-            if(record->interval > MAX_LOG_INTERVAL) {
-                record->interval = MAX_LOG_INTERVAL;
-            }
-        }
-        else {
-            avgInterval = minIntvlMsec;  // Restore log output frequency
-        }
+// Starts and stops the flusher thread shared by all sites, it outputs the suppressed messages once their interval has elapsed.
+// Stopping it outputs all pending messages.
+void log_intvl_start_flusher();
+void log_intvl_stop_flusher();
 
-        record->lastInvokeTime = nowTime;
-        record->count          = 0;
-    }
-}
+uint64_t log_intvl_steady_msec();
+uint64_t log_intvl_system_usec();
+
+// Adapts the interval of a slot after an output covering count calls in duration ms
+void log_intvl_update_interval(const ObLogIntvlSite &site, ObLogIntvlSlot &slot, uint64_t duration, uint32_t count);
 
 // Control log output at intervals; when log_intvl is called repeatedly within the interval time, only one log entry is output
 // When log_intvl is called frequently in succession, the log output frequency will decrease (intervals will lengthen) until the maximum interval, MAX_INTERVAL, is reached
-template <typename... Args>
-void log_intvl(std::shared_ptr<ObLogIntvlRecord> record, uint64_t minIntvlMsec, spdlog::source_loc src_loc, spdlog::level::level_enum level, std::string fmt,
-               Args &&...args) {
-    if(minIntvlMsec == 0) {
-        spdlog::default_logger_raw()->log(src_loc, level, fmt, std::forward<Args>(args)...);
+// The first suppressed message is kept in the slot and output with the number of suppressed calls by the flusher thread once the interval has elapsed
+template <typename... Args> void log_intvl(ObLogIntvlSite &site, uint64_t tag, fmt::string_view fmt, Args &&...args) {
+    if(site.minIntvlMsec == 0) {
+        ObLogIntvlLoggerRef logger;
+        logger->log(site.srcLoc, site.level, fmt, std::forward<Args>(args)...);
+        return;
     }
-    else {
-        std::string msg;
+
+    auto    &slot    = site.getSlot(tag);
+    uint64_t nowTime = log_intvl_steady_msec();
+    uint64_t last    = slot.lastOutputMs.load(std::memory_order_relaxed);
+    if((last == 0 || nowTime - last > slot.interval.load(std::memory_order_relaxed))
+       && slot.lastOutputMs.compare_exchange_strong(last, nowTime, std::memory_order_acq_rel)) {
+        uint32_t           suppressed = slot.count.exchange(0, std::memory_order_acq_rel);
+        fmt::memory_buffer buf;  // inline storage, only long messages allocate
         try {
-            msg = fmt::vformat(fmt, fmt::make_format_args(args...));
+            fmt::vformat_to(fmt::appender(buf), fmt, fmt::make_format_args(args...));
+            if(last != 0) {
+                log_intvl_update_interval(site, slot, nowTime - last, suppressed + 1);
+                if(suppressed > 0) {
+                    fmt::format_to(fmt::appender(buf), " [**{} logs in {}ms**]", suppressed + 1, nowTime - last);
+                }
+            }
         }
         catch(const std::exception &e) {
-            spdlog::default_logger_raw()->error("Log format error: {}", e.what());
+            ObLogIntvlLoggerRef logger;
+            logger->error("Log format error: {}", e.what());
             return;
         }
+        ObLogIntvlLoggerRef logger;
+        logger->log(site.srcLoc, site.level, spdlog::string_view_t(buf.data(), buf.size()));
+        return;
+    }
 
-        std::unique_lock<std::mutex> lock(record->mtx);
-        auto                         nowTime = std::chrono::system_clock::now();
-        record->lastLogTime                  = nowTime;
-        record->count++;
-        uint64_t duration           = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(nowTime - record->lastInvokeTime).count());
-        bool     zeroLastInvokeTime = record->lastInvokeTime.time_since_epoch() == std::chrono::system_clock::duration::zero();
-        if(duration > record->interval || zeroLastInvokeTime) {
-            if(!zeroLastInvokeTime) {
-                uint64_t avgInterval = duration / record->count;
-                if(avgInterval < record->interval) {  // Reduce the log output frequency
-                    record->interval *= 2;
-                    if(record->interval > MAX_LOG_INTERVAL) {
-                        record->interval = MAX_LOG_INTERVAL;
-                    }
-                }
-                else {
-                    record->interval = minIntvlMsec;  // Restore the log output frequency
-                }
-
-                if(record->count > 1) {
-                    fmt = fmt + " [**" + std::to_string(record->count) + " logs in " + std::to_string(duration) + "ms**]";
-                }
-            }
-
-            spdlog::default_logger_raw()->log(src_loc, level, fmt, std::forward<Args>(args)...);
-            record->count          = 0;
-            record->lastInvokeTime = nowTime;
-            lock.unlock();
-            if(record->invokeThread.joinable())  // Notify the thread to exit (resources will be automatically released after the thread exits)
-            {
-                record->cv.notify_all();
-                record->invokeThread.join();
-            }
+    // Suppressed, the first call of the interval keeps its message for the flusher thread. The flusher may still hold the message lock while
+    // it outputs the previous interval: wait for it (it only formats one log), the count of this interval would be output without message.
+    if(slot.count.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        while(slot.msgLock.test_and_set(std::memory_order_acquire)) {
+            std::this_thread::yield();
         }
-        else if(record->count == 1) {
-            lock.unlock();
-            if(record->invokeThread.joinable()) {
-                record->invokeThread.join();
-            }
-
-            record->invokeThread =
-                std::thread([record, minIntvlMsec, src_loc, level, msg]() mutable { log_intvl_invoke(record, minIntvlMsec, src_loc, level, msg); });
+        try {
+            auto result  = fmt::vformat_to_n(slot.msg, sizeof(slot.msg), fmt, fmt::make_format_args(args...));
+            slot.msgSize = static_cast<uint32_t>(std::min(result.size, sizeof(slot.msg)));
+        }
+        catch(const std::exception &) {
+            slot.msgSize = 0;
         }
+        slot.msgLock.clear(std::memory_order_release);
     }
+    slot.lastCallUs.store(log_intvl_system_usec(), std::memory_order_relaxed);
 }
 
 // Control the log output interval in milliseconds; 0 means no control
-#define LOG_INTVL(tag, minIntvlMsec, level, ...)                                                                                                            \
-    do {                                                                                                                                                    \
-        std::unique_lock<std::mutex> logIntvlRecordMapLock(logIntvlRecordMapMtx);                                                                           \
-        if(logIntvlRecordMapDestroyed) {                                                                                                                    \
-            break;                                                                                                                                          \
-        }                                                                                                                                                   \
-        if(logIntvlRecordMap.size() > LOG_RECORD_MAP_SIZE_LIMIT) {                                                                                          \
-            LOG_WARN("logIntvlRecordMap size {} > {}, clear it!", logIntvlRecordMap.size(), LOG_RECORD_MAP_SIZE_LIMIT);                                     \
-            auto nowTime = std::chrono::system_clock::now();                                                                                                \
-            for(auto logIntvlRecordMapIter = logIntvlRecordMap.begin(); logIntvlRecordMapIter != logIntvlRecordMap.end();) {                                \
-                uint64_t duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(nowTime - logIntvlRecordMapIter->second->lastInvokeTime).count()); \
-                if(logIntvlRecordMapIter->second->count == 0 && duration > logIntvlRecordMapIter->second->interval) {                                       \
-                    logIntvlRecordMapIter = logIntvlRecordMap.erase(logIntvlRecordMapIter);                                                                 \
-                }                                                                                                                                           \
-                else {                                                                                                                                      \
-                    logIntvlRecordMapIter++;                                                                                                                \
-                }                                                                                                                                           \
-            }                                                                                                                                               \
-        }                                                                                                                                                   \
-        auto logIntvlRecordMapIter = logIntvlRecordMap.find(tag);                                                                                           \
-        if(logIntvlRecordMapIter == logIntvlRecordMap.end()) {                                                                                              \
-            auto record      = std::make_shared<ObLogIntvlRecord>();                                                                                        \
-            record->count    = 0;                                                                                                                           \
-            record->interval = minIntvlMsec;                                                                                                                \
-            logIntvlRecordMap.insert(std::make_pair(tag, record));                                                                                          \
-            logIntvlRecordMapIter = logIntvlRecordMap.find(tag);                                                                                            \
-        }                                                                                                                                                   \
-        log_intvl(logIntvlRecordMapIter->second, minIntvlMsec, spdlog::source_loc{ __FILE__, __LINE__, SPDLOG_FUNCTION }, level, __VA_ARGS__);              \
+// The state lives in a static of the call site, tag selects one of its slots: calls with the same tag at the same call site share an interval
+#define LOG_INTVL(tag, minIntvlMsec, level, ...)                                                      \
+    do {                                                                                              \
+        static ObLogIntvlSite logIntvlSite(__FILE__, __LINE__, SPDLOG_FUNCTION, level, minIntvlMsec); \
+        log_intvl(logIntvlSite, static_cast<uint64_t>(tag), __VA_ARGS__);                             \
     } while(0)
 
-#define LOG_INTVL_ON_THREAD(minIntvlMsec, level, ...)                                  \
-    do {                                                                               \
-        std::stringstream ss;                                                          \
-        ss << std::this_thread::get_id();                                              \
-        std::string tag = std::string(__FILE__) + std::to_string(__LINE__) + ss.str(); \
-        LOG_INTVL(tag, minIntvlMsec, level, __VA_ARGS__);                              \
-    } while(0)
+#define LOG_INTVL_ON_THREAD(minIntvlMsec, level, ...) LOG_INTVL(std::hash<std::thread::id>()(std::this_thread::get_id()), minIntvlMsec, level, __VA_ARGS__)
 
 // The LOG_XXX_INTVL macro can only be used within class member functions because it uses the `this` pointer as a tag (log output interval control is bound to a specific object)
 // The LOG_XXX_INTVL_THREAD macro uses the current thread ID as a tag and can be used in class member functions and regular functions (log output interval control is bound to a specific thread)
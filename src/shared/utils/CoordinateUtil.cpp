@@ -2,12 +2,95 @@
 // Licensed under the MIT License.
 
 #include "CoordinateUtil.hpp"
+#include "PointCloudKernels.hpp"
 #include "logger/Logger.hpp"
 #include "logger/LoggerInterval.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <functional>
+#include <vector>
 
 namespace libobsensor {
+
+// Destination of the point cloud conversions: interleaved float points, or planes of half floats planeStride values apart (planes != nullptr)
+struct PointCloudOutput {
+    float    *points;
+    uint16_t *planes;
+    size_t    planeStride;
+    uint32_t  pointFloats;
+
+    uint32_t writeRow(const utils::PointCloudRow &row, const utils::PointCloudRowColor *color, uint32_t count, int step, bool outputZeroPoint,
+                      size_t index) const {
+        if(planes) {
+            return utils::depthRowToHalfPlanes(row, color, count, step, outputZeroPoint, planes + index, planeStride);
+        }
+        return utils::depthRowToPoints(row, color, count, step, outputZeroPoint, points + index * pointFloats);
+    }
+
+    void writePoint(size_t index, const float *values) const {
+        for(uint32_t c = 0; c < pointFloats; c++) {
+            if(planes) {
+                planes[c * planeStride + index] = utils::floatToHalf(values[c]);
+            }
+            else {
+                points[index * pointFloats + c] = values[c];
+            }
+        }
+    }
+
+    void movePoints(size_t dstIndex, size_t srcIndex, size_t count) const {
+        if(!planes) {
+            memmove(points + dstIndex * pointFloats, points + srcIndex * pointFloats, count * pointFloats * sizeof(float));
+            return;
+        }
+        for(uint32_t c = 0; c < pointFloats; c++) {
+            memmove(planes + c * planeStride + dstIndex, planes + c * planeStride + srcIndex, count * sizeof(uint16_t));
+        }
+    }
+};
+
+static PointCloudOutput makePointCloudOutput(void *pointCloudData, uint32_t pointFloats, size_t halfPlaneStride) {
+    PointCloudOutput output;
+    output.points      = halfPlaneStride == 0 ? static_cast<float *>(pointCloudData) : nullptr;
+    output.planes      = halfPlaneStride == 0 ? nullptr : static_cast<uint16_t *>(pointCloudData);
+    output.planeStride = halfPlaneStride;
+    output.pointFloats = pointFloats;
+    return output;
+}
+
+// Runs convertRows(rowBegin, rowEnd, firstPoint) on bands of the sampled rows, which returns the number of points it has written from point
+// firstPoint of output on. With outputZeroPoint, each row has rowPoints points and the band starts at its first row. Otherwise the points are
+// compacted: each band writes from the number of pixels sampled before it, which the points of the bands before never exceed, and the bands are
+// moved together afterwards.
+static uint32_t convertInRowBands(uint32_t sampledRows, uint32_t sampledCols, uint32_t rowPoints, bool outputZeroPoint, utils::WorkerPool *workerPool,
+                                  const PointCloudOutput &output, const std::function<uint32_t(uint32_t, uint32_t, size_t)> &convertRows) {
+    uint32_t bandCount = 1;
+    if(workerPool && workerPool->getThreadCount() > 1 && sampledRows * sampledCols >= POINT_CLOUD_PARALLEL_MIN_PIXELS) {
+        bandCount = std::min(workerPool->getThreadCount(), sampledRows);
+    }
+    if(bandCount <= 1) {
+        return convertRows(0, sampledRows, 0);
+    }
+
+    uint32_t              bandRowPoints = outputZeroPoint ? rowPoints : sampledCols;
+    std::vector<uint32_t> bandPoints(bandCount, 0);
+    auto                  bandBegin = [&](uint32_t band) { return static_cast<uint32_t>(static_cast<uint64_t>(sampledRows) * band / bandCount); };
+    workerPool->run(bandCount, [&](uint32_t band) {
+        uint32_t rowBegin = bandBegin(band);
+        bandPoints[band]  = convertRows(rowBegin, bandBegin(band + 1), static_cast<size_t>(rowBegin) * bandRowPoints);
+    });
+
+    uint32_t pointCount = 0;
+    for(uint32_t band = 0; band < bandCount; band++) {
+        if(!outputZeroPoint && pointCount != bandBegin(band) * bandRowPoints) {
+            output.movePoints(pointCount, static_cast<size_t>(bandBegin(band)) * bandRowPoints, bandPoints[band]);
+        }
+        pointCount += bandPoints[band];
+    }
+    return pointCount;
+}
 static bool judgeTransformValid(OBD2CTransform cameraRotParam) {
     // Orthogonality of rotation matrix
     // r1 .*r2 = 0 ;
@@ -567,62 +650,44 @@ bool CoordinateUtil::transformationInitAddDistortionUVTables(const OBCameraIntri
     return true;
 }
 
-void CoordinateUtil::transformationDepthToPointCloud(OBXYTables *xyTables, const void *depthImageData, void *pointCloudData, 
-                                                    bool outputZeroPoint,uint32_t *validPointCount,float positionDataScale, OBCoordinateSystemType type, bool isDepthImageY12C4,
-                                                     int step, uint32_t width) {
-    const uint16_t *imageData = (const uint16_t *)depthImageData;
-    float *         xyzData   = (float *)pointCloudData;
-    float           x, y, z;
-    int             coordinateSystemCoefficient = type == OB_LEFT_HAND_COORDINATE_SYSTEM ? -1 : 1;
-
-    int validCount = 0;
-    //TODO: step decimation factor: 1, 2, ..., 8
-	for(int h = 0; h < xyTables->height; h+=step) {
-		for(int w = 0; w < xyTables->width; w+=step) {
-            int i = h * xyTables->width + w;
-			float x_tab = xyTables->xTable[i];
-
-			uint16_t depthValue = imageData[i];
-			if(isDepthImageY12C4) {
-				depthValue = depthValue >> 4;
-				if(depthValue == 0x0FFF) {
-					depthValue = 0xFFFF;
-				}
-			}
-			if(!std::isnan(x_tab) && depthValue != 65535) {
-				z = (float)depthValue;
-				x = x_tab * (float)z;
-				y = xyTables->yTable[i] * (float)z * coordinateSystemCoefficient;
-
-				z *= positionDataScale;
-				x *= positionDataScale;
-				y *= positionDataScale;
-			}
-			else {
-				x = 0.0;
-				y = 0.0;
-				z = 0.0;
-			}
-
-			if(!outputZeroPoint && x == 0.0f && y == 0.0f && z == 0.0f) {
-				continue;
-			}
-
-            if(!outputZeroPoint) {
-                xyzData[3 * validCount + 0] = x;
-                xyzData[3 * validCount + 1] = y;
-                xyzData[3 * validCount + 2] = z;
-                validCount++;
-            }
-            else {
-                uint32_t pid         = h / step * width + w / step;
-                xyzData[3 * pid + 0] = x;
-                xyzData[3 * pid + 1] = y;
-                xyzData[3 * pid + 2] = z;
-                validCount++;
-            }
-		}
-    }
+void CoordinateUtil::transformationDepthToPointCloud(OBXYTables *xyTables, const void *depthImageData, void *pointCloudData, bool outputZeroPoint,
+                                                     uint32_t *validPointCount, float positionDataScale, OBCoordinateSystemType type, bool isDepthImageY12C4,
+                                                     int step, uint32_t width, utils::WorkerPool *workerPool, size_t halfPlaneStride) {
+    const uint16_t  *imageData = (const uint16_t *)depthImageData;
+    PointCloudOutput output    = makePointCloudOutput(pointCloudData, 3, halfPlaneStride);
+
+    utils::PointCloudRow row;
+    row.scale  = positionDataScale;
+    row.yCoeff = type == OB_LEFT_HAND_COORDINATE_SYSTEM ? -1.0f : 1.0f;
+    row.y12c4  = isDepthImageY12C4;
+
+    // Point of pixel (h, w): h / step * width + w / step, the points past the width of a row are dropped
+    uint32_t tableWidth  = static_cast<uint32_t>(xyTables->width);
+    uint32_t sampledRows = (static_cast<uint32_t>(xyTables->height) + step - 1) / step;
+    uint32_t sampledCols = (tableWidth + step - 1) / step;
+    uint32_t rowPoints   = width != 0 ? std::min(width, sampledCols) : sampledCols;
+    uint32_t rowPixels   = std::min(tableWidth, rowPoints * step);
+    uint32_t stride      = width != 0 ? width : sampledCols;
+
+    if(halfPlaneStride != 0) {
+        sampledRows = std::min<uint32_t>(sampledRows, static_cast<uint32_t>(halfPlaneStride / stride));  // the rows past the planes are dropped
+    }
+
+    uint32_t validCount = convertInRowBands(sampledRows, sampledCols, stride, outputZeroPoint, workerPool, output,
+                                            [&](uint32_t rowBegin, uint32_t rowEnd, size_t firstPoint) {
+                                                uint32_t written = 0;
+                                                for(uint32_t r = rowBegin; r < rowEnd; r++) {
+                                                    size_t               offset  = static_cast<size_t>(r) * step * tableWidth;
+                                                    utils::PointCloudRow rowData = row;
+                                                    rowData.depth                = imageData + offset;
+                                                    rowData.xTable               = xyTables->xTable + offset;
+                                                    rowData.yTable               = xyTables->yTable + offset;
+
+                                                    size_t rowPoint = firstPoint + (outputZeroPoint ? static_cast<size_t>(r - rowBegin) * stride : written);
+                                                    written += output.writeRow(rowData, nullptr, rowPixels, step, outputZeroPoint, rowPoint);
+                                                }
+                                                return written;
+                                            });
 
     if(validPointCount != nullptr) {
         *validPointCount = validCount;
@@ -630,19 +695,14 @@ void CoordinateUtil::transformationDepthToPointCloud(OBXYTables *xyTables, const
 }
 
 void CoordinateUtil::transformationDepthToRGBDPointCloud(OBXYTables *xyTables, const void *depthImageData, const void *colorImageData, void *pointCloudData,
-                                                         bool outputZeroPoint,uint32_t *validPointCount,float positionDataScale, OBCoordinateSystemType type,
+                                                         bool outputZeroPoint, uint32_t *validPointCount, float positionDataScale, OBCoordinateSystemType type,
                                                          bool colorDataNormalization, uint32_t colorWidth, uint32_t colorHeight, bool isDepthImageY12C4,
-                                                         int step,  uint32_t width) {
-    const uint16_t *dImageData = (const uint16_t *)depthImageData;
-    const uint8_t * cImageData = (const uint8_t *)colorImageData;
-    float *         xyzrgbData = (float *)pointCloudData;
-    float           x, y, z;
-    float           r, g, b;
-    int             coordinateSystemCoefficient = type == OB_LEFT_HAND_COORDINATE_SYSTEM ? -1 : 1;
-    float           colorDivCoeff               = colorDataNormalization ? 255.0f : 1.0f;
-    float           colorScaleX                 = 1.f;
-    float           colorScaleY                 = 1.f;
-    int validCount = 0;
+                                                         int step, uint32_t width, utils::WorkerPool *workerPool, size_t halfPlaneStride) {
+    const uint16_t  *dImageData  = (const uint16_t *)depthImageData;
+    const uint8_t   *cImageData  = (const uint8_t *)colorImageData;
+    PointCloudOutput output      = makePointCloudOutput(pointCloudData, 6, halfPlaneStride);
+    float            colorScaleX = 1.f;
+    float            colorScaleY = 1.f;
     if((xyTables->width != (int)colorWidth) || (xyTables->height != (int)colorHeight)) {
         colorScaleX = 1.f * colorWidth / xyTables->width;
         colorScaleY = 1.f * colorHeight / xyTables->height;
@@ -652,69 +712,46 @@ void CoordinateUtil::transformationDepthToRGBDPointCloud(OBXYTables *xyTables, c
         colorScaleY = s;
     }
 
-    //TODO: step decimation factor: 1, 2, ..., 8
-    for(int i = 0; i < xyTables->height; i+=step) {
-        int id = i * xyTables->width;
-        int ic = static_cast<int>(colorScaleX * i * colorWidth);
-        for(int j = 0; j < xyTables->width; j+=step) {
-            int   idc   = id + j;
-            float x_tab = xyTables->xTable[idc];
-
-            uint16_t depthValue = dImageData[idc];
-            if(isDepthImageY12C4) {
-                depthValue = depthValue >> 4;
-                if(depthValue == 0x0FFF) {
-                    depthValue = 0xFFFF;
-                }
-            }
-            if(!std::isnan(x_tab) && depthValue != 65535) {
-                z = (float)depthValue;
-                x = x_tab * (float)z;
-                y = xyTables->yTable[idc] * (float)z * coordinateSystemCoefficient;
-
-                z *= positionDataScale;
-                x *= positionDataScale;
-                y *= positionDataScale;
-
-                int icc = static_cast<int>(ic + j * colorScaleY);
-                r       = cImageData[3 * icc + 0] / colorDivCoeff;
-                g       = cImageData[3 * icc + 1] / colorDivCoeff;
-                b       = cImageData[3 * icc + 2] / colorDivCoeff;
-            }
-            else {
-                x = 0.0;
-                y = 0.0;
-                z = 0.0;
-                r = 0.0;
-                g = 0.0;
-                b = 0.0;
-            }
-
-            if(!outputZeroPoint && x == 0.0f && y == 0.0f && z == 0.0f && r == 0.0f && g == 0.0f && b == 0.0f) {
-                continue;
-            }
-            
-            if(!outputZeroPoint) {
-                xyzrgbData[6 * validCount + 0] = x;
-                xyzrgbData[6 * validCount + 1] = y;
-                xyzrgbData[6 * validCount + 2] = z;
-                xyzrgbData[6 * validCount + 3] = r;
-                xyzrgbData[6 * validCount + 4] = g;
-                xyzrgbData[6 * validCount + 5] = b;
-                validCount++;
-            }
-            else {
-                uint32_t pid            = i / step * width + j / step;
-                xyzrgbData[6 * pid + 0] = x;
-                xyzrgbData[6 * pid + 1] = y;
-                xyzrgbData[6 * pid + 2] = z;
-                xyzrgbData[6 * pid + 3] = r;
-                xyzrgbData[6 * pid + 4] = g;
-                xyzrgbData[6 * pid + 5] = b;
-                validCount++;
-            }
-        }
-    }
+    utils::PointCloudRow row;
+    row.scale  = positionDataScale;
+    row.yCoeff = type == OB_LEFT_HAND_COORDINATE_SYSTEM ? -1.0f : 1.0f;
+    row.y12c4  = isDepthImageY12C4;
+
+    utils::PointCloudRowColor color;
+    color.rgb      = cImageData;
+    color.scale    = colorScaleY;
+    color.divCoeff = colorDataNormalization ? 255.0f : 1.0f;
+
+    // Point of pixel (h, w): h / step * width + w / step, the points past the width of a row are dropped
+    uint32_t tableWidth  = static_cast<uint32_t>(xyTables->width);
+    uint32_t sampledRows = (static_cast<uint32_t>(xyTables->height) + step - 1) / step;
+    uint32_t sampledCols = (tableWidth + step - 1) / step;
+    uint32_t rowPoints   = width != 0 ? std::min(width, sampledCols) : sampledCols;
+    uint32_t rowPixels   = std::min(tableWidth, rowPoints * step);
+    uint32_t stride      = width != 0 ? width : sampledCols;
+
+    if(halfPlaneStride != 0) {
+        sampledRows = std::min<uint32_t>(sampledRows, static_cast<uint32_t>(halfPlaneStride / stride));  // the rows past the planes are dropped
+    }
+
+    uint32_t validCount = convertInRowBands(sampledRows, sampledCols, stride, outputZeroPoint, workerPool, output,
+                                            [&](uint32_t rowBegin, uint32_t rowEnd, size_t firstPoint) {
+                                                uint32_t written = 0;
+                                                for(uint32_t r = rowBegin; r < rowEnd; r++) {
+                                                    int                       i       = static_cast<int>(r) * step;
+                                                    size_t                    offset  = static_cast<size_t>(i) * tableWidth;
+                                                    utils::PointCloudRow      rowData = row;
+                                                    utils::PointCloudRowColor rowColor = color;
+                                                    rowData.depth                      = dImageData + offset;
+                                                    rowData.xTable                     = xyTables->xTable + offset;
+                                                    rowData.yTable                     = xyTables->yTable + offset;
+                                                    rowColor.offset                    = static_cast<int>(colorScaleX * i * colorWidth);
+
+                                                    size_t rowPoint = firstPoint + (outputZeroPoint ? static_cast<size_t>(r - rowBegin) * stride : written);
+                                                    written += output.writeRow(rowData, &rowColor, rowPixels, step, outputZeroPoint, rowPoint);
+                                                }
+                                                return written;
+                                            });
 
     if(validPointCount != nullptr) {
         *validPointCount = validCount;
@@ -722,87 +759,88 @@ void CoordinateUtil::transformationDepthToRGBDPointCloud(OBXYTables *xyTables, c
 }
 
 void CoordinateUtil::transformationDepthToRGBDPointCloudByUVTables(const OBCameraIntrinsic rgbIntrinsic, OBXYTables *uvTables, const void *depthImageData,
-                                                                   const void *colorImageData, void *pointCloudData,bool outputZeroPoint,
-                                                                   uint32_t *validPointCount,float positionDataScale,OBCoordinateSystemType type,
-                                                                   bool colorDataNormalization, bool isDepthImageY12C4, int step, uint32_t width) {
-    const uint16_t *dImageData = (const uint16_t *)depthImageData;
-    const uint8_t * cImageData = (const uint8_t *)colorImageData;
-    float *         xyzrgbData = (float *)pointCloudData;
-    float           x, y, z;
-    float           r, g, b;
-    int             coordinateSystemCoefficient = type == OB_LEFT_HAND_COORDINATE_SYSTEM ? -1 : 1;
-    float           colorDivCoeff               = colorDataNormalization ? 255.0f : 1.0f;
-    int validCount = 0;
-    float colorScale = 1.f;
+                                                                   const void *colorImageData, void *pointCloudData, bool outputZeroPoint,
+                                                                   uint32_t *validPointCount, float positionDataScale, OBCoordinateSystemType type,
+                                                                   bool colorDataNormalization, bool isDepthImageY12C4, int step, uint32_t width,
+                                                                   utils::WorkerPool *workerPool, size_t halfPlaneStride) {
+    const uint16_t  *dImageData                  = (const uint16_t *)depthImageData;
+    const uint8_t   *cImageData                  = (const uint8_t *)colorImageData;
+    PointCloudOutput output                      = makePointCloudOutput(pointCloudData, 6, halfPlaneStride);
+    int              coordinateSystemCoefficient = type == OB_LEFT_HAND_COORDINATE_SYSTEM ? -1 : 1;
+    float            colorDivCoeff               = colorDataNormalization ? 255.0f : 1.0f;
+    float            colorScale                  = 1.f;
     if((uvTables->width != (int)rgbIntrinsic.width) || (uvTables->height != (int)rgbIntrinsic.height)) {
         float colorScaleX = 1.f * rgbIntrinsic.width / uvTables->width, colorScaleY = 1.f * rgbIntrinsic.height / uvTables->height;
-        colorScale = colorScaleX > colorScaleY ? colorScaleX : colorScaleY;
-        colorScale = 1.f * int(colorScale) + 0.5f * (int(colorScale + 0.5) - int(colorScale));
+        colorScale        = colorScaleX > colorScaleY ? colorScaleX : colorScaleY;
+        colorScale        = 1.f * int(colorScale) + 0.5f * (int(colorScale + 0.5) - int(colorScale));
     }
     int colorWidth = static_cast<int>(colorScale * uvTables->width);
-    // TODO: step decimation factor: 1, 2, ..., 8
-    for(int yValue = 0; yValue < uvTables->height; yValue+=step) {
-        for(int xValue = 0; xValue < uvTables->width; xValue+=step) {
-            int i = yValue * uvTables->width + xValue;
-
-			uint16_t depthValue = dImageData[i];
-			if(isDepthImageY12C4) {
-				depthValue = depthValue >> 4;
-				if(depthValue == 0x0FFF) {
-					depthValue = 0xFFFF;
-				}
-			}
-			if(!std::isnan(uvTables->xTable[i]) && depthValue != 65535) {
-				z = (float)depthValue;
-				x = ((xValue - rgbIntrinsic.cx) / rgbIntrinsic.fx) * (float)z;
-				y = ((yValue - rgbIntrinsic.cy) / rgbIntrinsic.fy) * (float)z * coordinateSystemCoefficient;
-
-				z *= positionDataScale;
-				x *= positionDataScale;
-				y *= positionDataScale;
-
-				int u_rgb   = (int)(uvTables->xTable[i] * colorScale + 0.5f);
-				int v_rgb   = (int)(uvTables->yTable[i] * colorScale + 0.5f);
-				int idx_rgb = v_rgb * colorWidth + u_rgb;
-
-				r = cImageData[3 * idx_rgb + 0] / colorDivCoeff;
-				g = cImageData[3 * idx_rgb + 1] / colorDivCoeff;
-				b = cImageData[3 * idx_rgb + 2] / colorDivCoeff;
-			}
-			else {
-				x = 0.0;
-				y = 0.0;
-				z = 0.0;
-				r = 0.0;
-				g = 0.0;
-				b = 0.0;
-			}
-
-			if(!outputZeroPoint && x == 0.0f && y == 0.0f && z == 0.0f && r == 0.0f && g == 0.0f && b == 0.0f) {
-				continue;
-			}
-
-            if(!outputZeroPoint) {
-                xyzrgbData[6 * validCount + 0] = x;
-                xyzrgbData[6 * validCount + 1] = y;
-                xyzrgbData[6 * validCount + 2] = z;
-                xyzrgbData[6 * validCount + 3] = r;
-                xyzrgbData[6 * validCount + 4] = g;
-                xyzrgbData[6 * validCount + 5] = b;
-                validCount++;
-            }
-            else {
-                uint32_t pid            = yValue / step * width + xValue / step;
-                xyzrgbData[6 * pid + 0] = x;
-                xyzrgbData[6 * pid + 1] = y;
-                xyzrgbData[6 * pid + 2] = z;
-                xyzrgbData[6 * pid + 3] = r;
-                xyzrgbData[6 * pid + 4] = g;
-                xyzrgbData[6 * pid + 5] = b;
+
+    // Point of pixel (h, w): h / step * width + w / step, the points past the width of a row are dropped
+    uint32_t sampledRows = (static_cast<uint32_t>(uvTables->height) + step - 1) / step;
+    uint32_t sampledCols = (static_cast<uint32_t>(uvTables->width) + step - 1) / step;
+    uint32_t rowPoints   = width != 0 ? std::min(width, sampledCols) : sampledCols;
+    uint32_t stride      = width != 0 ? width : sampledCols;
+    if(halfPlaneStride != 0) {
+        sampledRows = std::min<uint32_t>(sampledRows, static_cast<uint32_t>(halfPlaneStride / stride));  // the rows past the planes are dropped
+    }
+
+    auto convertRows = [&](uint32_t rowBegin, uint32_t rowEnd, size_t firstPoint) {
+        uint32_t validCount = 0;
+        for(uint32_t row = rowBegin; row < rowEnd; row++) {
+            int    yValue   = static_cast<int>(row) * step;
+            size_t rowPoint = firstPoint + static_cast<size_t>(row - rowBegin) * stride;
+            for(uint32_t col = 0; col < rowPoints; col++) {
+                int   xValue = static_cast<int>(col) * step;
+                int   i      = yValue * uvTables->width + xValue;
+                float x, y, z;
+                float r, g, b;
+
+                uint16_t depthValue = dImageData[i];
+                if(isDepthImageY12C4) {
+                    depthValue = depthValue >> 4;
+                    if(depthValue == 0x0FFF) {
+                        depthValue = 0xFFFF;
+                    }
+                }
+                if(!std::isnan(uvTables->xTable[i]) && depthValue != 65535) {
+                    z = (float)depthValue;
+                    x = ((xValue - rgbIntrinsic.cx) / rgbIntrinsic.fx) * (float)z;
+                    y = ((yValue - rgbIntrinsic.cy) / rgbIntrinsic.fy) * (float)z * coordinateSystemCoefficient;
+
+                    z *= positionDataScale;
+                    x *= positionDataScale;
+                    y *= positionDataScale;
+
+                    int u_rgb   = (int)(uvTables->xTable[i] * colorScale + 0.5f);
+                    int v_rgb   = (int)(uvTables->yTable[i] * colorScale + 0.5f);
+                    int idx_rgb = v_rgb * colorWidth + u_rgb;
+
+                    r = cImageData[3 * idx_rgb + 0] / colorDivCoeff;
+                    g = cImageData[3 * idx_rgb + 1] / colorDivCoeff;
+                    b = cImageData[3 * idx_rgb + 2] / colorDivCoeff;
+                }
+                else {
+                    x = 0.0;
+                    y = 0.0;
+                    z = 0.0;
+                    r = 0.0;
+                    g = 0.0;
+                    b = 0.0;
+                }
+
+                if(!outputZeroPoint && x == 0.0f && y == 0.0f && z == 0.0f && r == 0.0f && g == 0.0f && b == 0.0f) {
+                    continue;
+                }
+
+                const float point[6] = { x, y, z, r, g, b };
+                output.writePoint(outputZeroPoint ? rowPoint + col : firstPoint + validCount, point);
                 validCount++;
             }
-		}
-    }
+        }
+        return validCount;
+    };
+    uint32_t validCount = convertInRowBands(sampledRows, sampledCols, stride, outputZeroPoint, workerPool, output, convertRows);
 
     if(validPointCount != nullptr) {
         *validPointCount = validCount;
@@ -3,6 +3,7 @@
 
 #pragma once
 #include "libobsensor/h/ObTypes.h"
+#include "WorkerPool.hpp"
 // #include "core/device/IDevice.hpp"
 // #include "core/frame/Frame.hpp"
 #include <memory>
@@ -12,6 +13,9 @@ namespace libobsensor {
 #define EPS 1e-4
 #define FMAX 1e4
 
+// Point clouds from this size on (sampled pixels) are converted in row bands on the worker pool
+#define POINT_CLOUD_PARALLEL_MIN_PIXELS (640 * 400)
+
 class CoordinateUtil {
 public:
     static bool transformation3dTo3d(const OBPoint3f sourcePoint3f, OBD2CTransform transSourceToTarget, OBPoint3f *targetPoint3f);
@@ -45,19 +49,25 @@ public:
     static bool transformationInitAddDistortionUVTables(const OBCameraIntrinsic intrinsic, const OBCameraDistortion distortion, float *data, uint32_t *dataSize,
                                                         OBXYTables *uvTables);
 
+    // The rows are converted in bands on the worker pool if one is given (large images only), with the SIMD kernels of PointCloudKernels.hpp.
+    // With halfPlaneStride != 0, pointCloudData receives planes of half floats halfPlaneStride values apart (x of all points, then y...) instead
+    // of interleaved float points, the sampled rows past the first plane are dropped.
     static void transformationDepthToPointCloud(OBXYTables *xyTables, const void *depthImageData, void *pointCloudData,bool outputZeroPoint = false,uint32_t *validPointCount = nullptr, float positionDataScale = 1.0f,
-                                                OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM, bool isDepthImageY12C4 = false, int step = 1, uint32_t width = 0);
+                                                OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM, bool isDepthImageY12C4 = false, int step = 1, uint32_t width = 0,
+                                                utils::WorkerPool *workerPool = nullptr, size_t halfPlaneStride = 0);
 
     // colorResolution = colorScale * depthResolution
     static void transformationDepthToRGBDPointCloud(OBXYTables *xyTables, const void *depthImageData, const void *colorImageData, void *pointCloudData,
                                                     bool outputZeroPoint = false,uint32_t *validPointCount = nullptr,
                                                     float positionDataScale = 1.0f, OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM, bool colorDataNormalization = false,
-                                                    uint32_t colorWidth = 0, uint32_t colorHeight = 0, bool isDepthImageY12C4 = false, int step = 1, uint32_t width = 0);
+                                                    uint32_t colorWidth = 0, uint32_t colorHeight = 0, bool isDepthImageY12C4 = false, int step = 1, uint32_t width = 0,
+                                                    utils::WorkerPool *workerPool = nullptr, size_t halfPlaneStride = 0);
 
     // colorResolution = colorScale * depthResolution
     static void transformationDepthToRGBDPointCloudByUVTables(const OBCameraIntrinsic rgbIntrinsic, OBXYTables *uvTables, const void *depthImageData,
                                                               const void *colorImageData, void *pointCloudData,bool outputZeroPoint = false,
                                                               uint32_t *validPointCount = nullptr,float positionDataScale = 1.0f,
-                                                              OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM, bool colorDataNormalization = false, bool isDepthImageY12C4 = false, int step = 1, uint32_t width = 0);
+                                                              OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM, bool colorDataNormalization = false, bool isDepthImageY12C4 = false, int step = 1, uint32_t width = 0,
+                                                              utils::WorkerPool *workerPool = nullptr, size_t halfPlaneStride = 0);
 };
 }  // namespace libobsensor
@@ -0,0 +1,92 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "CpuFeatures.hpp"
+
+#include <atomic>
+#include <stdint.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define OB_CPUID_MSVC
+#elif(defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define OB_CPUID_GNU
+#endif
+
+namespace libobsensor {
+namespace utils {
+
+#if defined(OB_CPUID_MSVC) || defined(OB_CPUID_GNU)
+static void cpuid(uint32_t leaf, uint32_t subLeaf, uint32_t regs[4]) {
+#if defined(OB_CPUID_MSVC)
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subLeaf));
+    for(int i = 0; i < 4; i++) {
+        regs[i] = static_cast<uint32_t>(info[i]);
+    }
+#else
+    __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static uint64_t xgetbv0() {
+#if defined(OB_CPUID_MSVC)
+    return _xgetbv(0);
+#else
+    uint32_t lo, hi;
+    __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+}
+#endif
+
+static SimdLevel detectSimdLevel() {
+#if defined(OB_CPUID_MSVC) || defined(OB_CPUID_GNU)
+    uint32_t regs[4];
+    cpuid(0, 0, regs);
+    uint32_t maxLeaf = regs[0];
+    if(maxLeaf < 1) {
+        return SIMD_LEVEL_NONE;
+    }
+
+    cpuid(1, 0, regs);
+    bool sse41   = (regs[2] & (1u << 19)) != 0;
+    bool osxsave = (regs[2] & (1u << 27)) != 0;
+    bool avx     = (regs[2] & (1u << 28)) != 0;
+    if(!sse41) {
+        return SIMD_LEVEL_NONE;
+    }
+
+    // AVX needs the OS to save the YMM registers on context switches (XCR0 bits 1 and 2)
+    if(!osxsave || !avx || (xgetbv0() & 0x6) != 0x6 || maxLeaf < 7) {
+        return SIMD_LEVEL_SSE4_1;
+    }
+
+    cpuid(7, 0, regs);
+    bool avx2 = (regs[1] & (1u << 5)) != 0;
+    return avx2 ? SIMD_LEVEL_AVX2 : SIMD_LEVEL_SSE4_1;
+#else
+    return SIMD_LEVEL_NONE;
+#endif
+}
+
+static std::atomic<int> simdLevelLimit(SIMD_LEVEL_AVX2);
+
+SimdLevel getCpuSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+SimdLevel getSimdLevel() {
+    int level = static_cast<int>(getCpuSimdLevel());
+    int limit = simdLevelLimit.load(std::memory_order_relaxed);
+    return static_cast<SimdLevel>(level < limit ? level : limit);
+}
+
+void setSimdLevelLimit(SimdLevel level) {
+    simdLevelLimit.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+}  // namespace utils
+}  // namespace libobsensor
@@ -0,0 +1,34 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+namespace libobsensor {
+namespace utils {
+
+/**
+ * @brief SIMD instruction set levels that have a runtime-dispatched code path in the SDK, in increasing order
+ */
+typedef enum {
+    SIMD_LEVEL_NONE   = 0,
+    SIMD_LEVEL_SSE4_1 = 1,
+    SIMD_LEVEL_AVX2   = 2,
+} SimdLevel;
+
+/**
+ * @brief Highest SIMD level supported by the CPU and the OS, detected once with cpuid
+ */
+SimdLevel getCpuSimdLevel();
+
+/**
+ * @brief SIMD level the dispatched kernels should use: the CPU level, capped by setSimdLevelLimit()
+ */
+SimdLevel getSimdLevel();
+
+/**
+ * @brief Cap the SIMD level used by the dispatched kernels, e.g. to compare the code paths against each other in tests
+ */
+void setSimdLevelLimit(SimdLevel level);
+
+}  // namespace utils
+}  // namespace libobsensor
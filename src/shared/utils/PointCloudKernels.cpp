@@ -0,0 +1,341 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "PointCloudKernels.hpp"
+#include "CpuFeatures.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OB_POINT_CLOUD_SSE2
+#elif defined(__NEON__)
+#include <arm_neon.h>
+#define OB_POINT_CLOUD_NEON
+#endif
+
+namespace libobsensor {
+namespace utils {
+
+namespace {
+
+// The scalar code of CoordinateUtil::transformationDepthToPointCloud and transformationDepthToRGBDPointCloud for one pixel
+inline bool depthPixelToPoint(const PointCloudRow &row, const PointCloudRowColor *color, uint32_t j, bool outputZeroPoint, float *dst) {
+    float    x, y, z;
+    float    r = 0.0f, g = 0.0f, b = 0.0f;
+    float    x_tab      = row.xTable[j];
+    uint16_t depthValue = row.depth[j];
+    if(row.y12c4) {
+        depthValue = depthValue >> 4;
+        if(depthValue == 0x0FFF) {
+            depthValue = 0xFFFF;
+        }
+    }
+    if(!std::isnan(x_tab) && depthValue != 65535) {
+        z = (float)depthValue;
+        x = x_tab * z;
+        y = row.yTable[j] * z * row.yCoeff;
+
+        z *= row.scale;
+        x *= row.scale;
+        y *= row.scale;
+
+        if(color) {
+            int icc = static_cast<int>(color->offset + static_cast<int>(j) * color->scale);
+            r       = color->rgb[3 * icc + 0] / color->divCoeff;
+            g       = color->rgb[3 * icc + 1] / color->divCoeff;
+            b       = color->rgb[3 * icc + 2] / color->divCoeff;
+        }
+    }
+    else {
+        x = 0.0f;
+        y = 0.0f;
+        z = 0.0f;
+    }
+
+    if(!outputZeroPoint && x == 0.0f && y == 0.0f && z == 0.0f && r == 0.0f && g == 0.0f && b == 0.0f) {
+        return false;
+    }
+    dst[0] = x;
+    dst[1] = y;
+    dst[2] = z;
+    if(color) {
+        dst[3] = r;
+        dst[4] = g;
+        dst[5] = b;
+    }
+    return true;
+}
+
+// Writes the lanes of a chunk one by one: the lanes with zero points are skipped or the points have colors
+inline uint32_t storeLanes(const PointCloudRowColor *color, uint32_t j, int lanes, const float *x, const float *y, const float *z, uint32_t validMask,
+                           bool outputZeroPoint, float *dst) {
+    uint32_t stride  = color ? 6 : 3;
+    uint32_t written = 0;
+    for(int k = 0; k < lanes; k++) {
+        float r = 0.0f, g = 0.0f, b = 0.0f;
+        if(color && (validMask & (1u << k))) {
+            int icc = static_cast<int>(color->offset + static_cast<int>(j + k) * color->scale);
+            r       = color->rgb[3 * icc + 0] / color->divCoeff;
+            g       = color->rgb[3 * icc + 1] / color->divCoeff;
+            b       = color->rgb[3 * icc + 2] / color->divCoeff;
+        }
+        if(!outputZeroPoint && x[k] == 0.0f && y[k] == 0.0f && z[k] == 0.0f && r == 0.0f && g == 0.0f && b == 0.0f) {
+            continue;
+        }
+        float *point = dst + written * stride;
+        point[0]     = x[k];
+        point[1]     = y[k];
+        point[2]     = z[k];
+        if(color) {
+            point[3] = r;
+            point[4] = g;
+            point[5] = b;
+        }
+        written++;
+    }
+    return written;
+}
+
+#if defined(OB_POINT_CLOUD_SSE2)
+
+// x0 x1 x2 x3, y0 y1 y2 y3, z0 z1 z2 z3 -> x0 y0 z0 x1 y1 z1 x2 y2 z2 x3 y3 z3
+inline void storeInterleavedSSE(float *dst, __m128 x, __m128 y, __m128 z) {
+    __m128 xy01 = _mm_unpacklo_ps(x, y);                              // x0 y0 x1 y1
+    __m128 xy23 = _mm_unpackhi_ps(x, y);                              // x2 y2 x3 y3
+    __m128 z0x1 = _mm_shuffle_ps(z, xy01, _MM_SHUFFLE(2, 2, 0, 0));  // z0 z0 x1 x1
+    __m128 y1z1 = _mm_shuffle_ps(xy01, z, _MM_SHUFFLE(1, 1, 3, 3));  // y1 y1 z1 z1
+    __m128 z2x3 = _mm_shuffle_ps(z, xy23, _MM_SHUFFLE(2, 2, 2, 2));  // z2 z2 x3 x3
+    __m128 xyz3 = _mm_shuffle_ps(xy23, z, _MM_SHUFFLE(3, 3, 3, 2));  // x3 y3 z3 z3
+    _mm_storeu_ps(dst + 0, _mm_shuffle_ps(xy01, z0x1, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(dst + 4, _mm_shuffle_ps(y1z1, xy23, _MM_SHUFFLE(1, 0, 2, 0)));
+    _mm_storeu_ps(dst + 8, _mm_shuffle_ps(z2x3, xyz3, _MM_SHUFFLE(2, 1, 2, 0)));
+}
+
+uint32_t depthRowToPointsSSE2(const PointCloudRow &row, const PointCloudRowColor *color, uint32_t begin, uint32_t count, bool outputZeroPoint,
+                              float *dst, uint32_t *written) {
+    const __m128i zeroI   = _mm_setzero_si128();
+    const __m128i allOnes = _mm_set1_epi32(-1);
+    const __m128i invalid = _mm_set1_epi32(row.y12c4 ? 0x0FFF : 0xFFFF);
+    const __m128  zero    = _mm_setzero_ps();
+    const __m128  scale   = _mm_set1_ps(row.scale);
+    const __m128  yCoeff  = _mm_set1_ps(row.yCoeff);
+    const int     stride  = color ? 6 : 3;
+
+    uint32_t n = 0;
+    uint32_t j = begin;
+    for(; j + 4 <= count; j += 4) {
+        __m128i depth = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(row.depth + j)), zeroI);
+        if(row.y12c4) {
+            depth = _mm_srli_epi32(depth, 4);
+        }
+        __m128 xTab  = _mm_loadu_ps(row.xTable + j);
+        __m128 valid = _mm_and_ps(_mm_cmpord_ps(xTab, xTab), _mm_castsi128_ps(_mm_xor_si128(_mm_cmpeq_epi32(depth, invalid), allOnes)));
+
+        __m128 z = _mm_cvtepi32_ps(depth);
+        __m128 x = _mm_mul_ps(xTab, z);
+        __m128 y = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(row.yTable + j), z), yCoeff);
+        z        = _mm_and_ps(_mm_mul_ps(z, scale), valid);
+        x        = _mm_and_ps(_mm_mul_ps(x, scale), valid);
+        y        = _mm_and_ps(_mm_mul_ps(y, scale), valid);
+
+        if(!color) {
+            int zeroMask = outputZeroPoint ? 0 : _mm_movemask_ps(_mm_and_ps(_mm_and_ps(_mm_cmpeq_ps(x, zero), _mm_cmpeq_ps(y, zero)), _mm_cmpeq_ps(z, zero)));
+            if(zeroMask == 0) {
+                storeInterleavedSSE(dst + n * stride, x, y, z);
+                n += 4;
+                continue;
+            }
+        }
+
+        float xs[4], ys[4], zs[4];
+        _mm_storeu_ps(xs, x);
+        _mm_storeu_ps(ys, y);
+        _mm_storeu_ps(zs, z);
+        n += storeLanes(color, j, 4, xs, ys, zs, static_cast<uint32_t>(_mm_movemask_ps(valid)), outputZeroPoint, dst + n * stride);
+    }
+    *written = n;
+    return j;
+}
+
+#elif defined(OB_POINT_CLOUD_NEON)
+
+inline bool anyLane(uint32x4_t mask) {
+    uint32x2_t folded = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+    return (vget_lane_u32(folded, 0) | vget_lane_u32(folded, 1)) != 0;
+}
+
+inline uint32_t laneMask(uint32x4_t mask) {
+    return (vgetq_lane_u32(mask, 0) & 1u) | (vgetq_lane_u32(mask, 1) & 2u) | (vgetq_lane_u32(mask, 2) & 4u) | (vgetq_lane_u32(mask, 3) & 8u);
+}
+
+uint32_t depthRowToPointsNEON(const PointCloudRow &row, const PointCloudRowColor *color, uint32_t begin, uint32_t count, bool outputZeroPoint,
+                              float *dst, uint32_t *written) {
+    const uint32x4_t invalid = vdupq_n_u32(row.y12c4 ? 0x0FFF : 0xFFFF);
+    const float32x4_t zero   = vdupq_n_f32(0.0f);
+    const float32x4_t scale  = vdupq_n_f32(row.scale);
+    const float32x4_t yCoeff = vdupq_n_f32(row.yCoeff);
+    const int         stride = color ? 6 : 3;
+
+    uint32_t n = 0;
+    uint32_t j = begin;
+    for(; j + 4 <= count; j += 4) {
+        uint32x4_t depth = vmovl_u16(vld1_u16(row.depth + j));
+        if(row.y12c4) {
+            depth = vshrq_n_u32(depth, 4);
+        }
+        float32x4_t xTab  = vld1q_f32(row.xTable + j);
+        uint32x4_t  valid = vandq_u32(vceqq_f32(xTab, xTab), vmvnq_u32(vceqq_u32(depth, invalid)));
+
+        float32x4_t z = vcvtq_f32_u32(depth);
+        float32x4_t x = vmulq_f32(xTab, z);
+        float32x4_t y = vmulq_f32(vmulq_f32(vld1q_f32(row.yTable + j), z), yCoeff);
+        z             = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vmulq_f32(z, scale)), valid));
+        x             = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vmulq_f32(x, scale)), valid));
+        y             = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vmulq_f32(y, scale)), valid));
+
+        if(!color) {
+            bool hasZero = !outputZeroPoint && anyLane(vandq_u32(vandq_u32(vceqq_f32(x, zero), vceqq_f32(y, zero)), vceqq_f32(z, zero)));
+            if(!hasZero) {
+                float32x4x3_t xyz = { { x, y, z } };
+                vst3q_f32(dst + n * stride, xyz);
+                n += 4;
+                continue;
+            }
+        }
+
+        float xs[4], ys[4], zs[4];
+        vst1q_f32(xs, x);
+        vst1q_f32(ys, y);
+        vst1q_f32(zs, z);
+        n += storeLanes(color, j, 4, xs, ys, zs, laneMask(valid), outputZeroPoint, dst + n * stride);
+    }
+    *written = n;
+    return j;
+}
+
+#endif
+
+}  // namespace
+
+uint32_t depthRowToPointsScalar(const PointCloudRow &row, const PointCloudRowColor *color, uint32_t begin, uint32_t count, int step, bool outputZeroPoint,
+                                float *dst) {
+    uint32_t stride  = color ? 6 : 3;
+    uint32_t written = 0;
+    for(uint32_t j = begin; j < count; j += step) {
+        if(depthPixelToPoint(row, color, j, outputZeroPoint, dst + written * stride)) {
+            written++;
+        }
+    }
+    return written;
+}
+
+namespace {
+
+// depthRowToPoints for columns [begin, end), begin is a multiple of step
+uint32_t depthRangeToPoints(const PointCloudRow &row, const PointCloudRowColor *color, uint32_t begin, uint32_t end, int step, bool outputZeroPoint,
+                            float *dst) {
+    if(step != 1) {
+        return depthRowToPointsScalar(row, color, begin, end, step, outputZeroPoint, dst);
+    }
+
+    uint32_t done    = begin;
+    uint32_t written = 0;
+    uint32_t stride  = color ? 6 : 3;
+    auto     level   = getSimdLevel();
+    if(level >= SIMD_LEVEL_AVX2) {
+        done = depthRowToPointsAVX2(row, color, begin, end, outputZeroPoint, dst, &written);
+    }
+#if defined(OB_POINT_CLOUD_SSE2)
+    if(level >= SIMD_LEVEL_SSE4_1) {  // the lowest dispatched level, SSE2 is all this kernel needs
+        uint32_t sseWritten = 0;
+        done = depthRowToPointsSSE2(row, color, done, end, outputZeroPoint, dst + written * stride, &sseWritten);
+        written += sseWritten;
+    }
+#elif defined(OB_POINT_CLOUD_NEON)
+    uint32_t neonWritten = 0;
+    done = depthRowToPointsNEON(row, color, done, end, outputZeroPoint, dst + written * stride, &neonWritten);
+    written += neonWritten;
+#endif
+    return written + depthRowToPointsScalar(row, color, done, end, 1, outputZeroPoint, dst + written * stride);
+}
+
+}  // namespace
+
+uint32_t depthRowToPoints(const PointCloudRow &row, const PointCloudRowColor *color, uint32_t count, int step, bool outputZeroPoint, float *dst) {
+    return depthRangeToPoints(row, color, 0, count, step, outputZeroPoint, dst);
+}
+
+uint32_t depthRowToHalfPlanes(const PointCloudRow &row, const PointCloudRowColor *color, uint32_t count, int step, bool outputZeroPoint, uint16_t *planes,
+                              size_t planeStride) {
+    // The points of a block stay in the L1 cache between the kernel and the conversion
+    const uint32_t BLOCK_POINTS = 64;
+    float          block[BLOCK_POINTS * 6];
+    uint32_t       channels  = color ? 6 : 3;
+    uint32_t       blockSize = BLOCK_POINTS * static_cast<uint32_t>(step);
+    uint32_t       written   = 0;
+    for(uint32_t begin = 0; begin < count; begin += blockSize) {
+        uint32_t end = count - begin > blockSize ? begin + blockSize : count;
+        uint32_t n   = depthRangeToPoints(row, color, begin, end, step, outputZeroPoint, block);
+        for(uint32_t c = 0; c < channels; c++) {
+            uint16_t    *plane = planes + c * planeStride + written;
+            const float *value = block + c;
+            for(uint32_t i = 0; i < n; i++, value += channels) {
+                plane[i] = floatToHalf(*value);
+            }
+        }
+        written += n;
+    }
+    return written;
+}
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign     = (bits >> 16) & 0x8000u;
+    uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if(exponent == 0xFFu) {  // inf, nan (kept quiet)
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u | (mantissa >> 13) : 0u));
+    }
+    int32_t halfExponent = static_cast<int32_t>(exponent) - 127 + 15;
+    if(halfExponent >= 0x1F) {  // overflow
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+    if(halfExponent <= 0) {  // subnormal half or zero
+        if(halfExponent < -10) {
+            return static_cast<uint16_t>(sign);
+        }
+        mantissa |= 0x800000u;
+        uint32_t shift     = static_cast<uint32_t>(14 - halfExponent);
+        uint32_t half      = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway   = 1u << (shift - 1);
+        if(remainder > halfway || (remainder == halfway && (half & 1u))) {
+            half++;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    uint32_t half      = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1FFFu;
+    if(remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+        half++;  // may carry into the exponent, up to inf
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+void pointsToHalfPlanes(const float *points, uint32_t pointCount, uint32_t channels, uint16_t *planes) {
+    for(uint32_t c = 0; c < channels; c++) {
+        uint16_t    *plane = planes + static_cast<size_t>(c) * pointCount;
+        const float *value = points + c;
+        for(uint32_t i = 0; i < pointCount; i++, value += channels) {
+            plane[i] = floatToHalf(*value);
+        }
+    }
+}
+
+}  // namespace utils
+}  // namespace libobsensor
@@ -0,0 +1,94 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+namespace libobsensor {
+namespace utils {
+
+/**
+ * @brief One row of depth pixels to convert to points, see CoordinateUtil::transformationDepthToPointCloud
+ */
+typedef struct {
+    const uint16_t *depth;   // first depth pixel of the row
+    const float    *xTable;  // xy tables at the first pixel of the row
+    const float    *yTable;
+    float           scale;   // position data scale
+    float           yCoeff;  // -1 for the left hand coordinate system, 1 otherwise
+    bool            y12c4;   // the depth pixels are Y12C4
+} PointCloudRow;
+
+/**
+ * @brief Colors of the points of a row: the point of column j takes the color of pixel (int)(offset + j * scale) of the RGB888 image,
+ * see CoordinateUtil::transformationDepthToRGBDPointCloud
+ */
+typedef struct {
+    const uint8_t *rgb;
+    int            offset;
+    float          scale;
+    float          divCoeff;  // 255 if the colors are normalized to [0, 1], 1 otherwise
+} PointCloudRowColor;
+
+/**
+ * @brief Convert a row of depth pixels to OBPoint (color == nullptr) or OBColorPoint, with the fastest kernel of the CPU (utils::getSimdLevel())
+ * @brief All kernels compute the values with the same operations in the same order as the scalar code, so their output is bit-exact.
+ *
+ * @param[in] row depth pixels and xy tables of the row
+ * @param[in] color colors of the row, nullptr for points without color
+ * @param[in] count number of pixels in the row
+ * @param[in] step column step (decimation factor), only step 1 runs on the SIMD kernels
+ * @param[in] outputZeroPoint false to skip the points where all values are 0, true to write a point for each sampled pixel
+ * @param[out] dst points, written one after the other
+ *
+ * @return number of points written
+ */
+uint32_t depthRowToPoints(const PointCloudRow &row, const PointCloudRowColor *color, uint32_t count, int step, bool outputZeroPoint, float *dst);
+
+/**
+ * @brief depthRowToPoints writing the values straight to planes of half floats (see floatToHalf), in blocks of a few points converted while
+ * they are in the L1 cache
+ *
+ * @param[out] planes first value of the row in the first plane, value c of point i goes to planes[c * planeStride + i]
+ * @param[in] planeStride distance between the planes, in values
+ *
+ * @return number of points written
+ */
+uint32_t depthRowToHalfPlanes(const PointCloudRow &row, const PointCloudRowColor *color, uint32_t count, int step, bool outputZeroPoint, uint16_t *planes,
+                              size_t planeStride);
+
+/**
+ * @brief Scalar kernel of depthRowToPoints, from column begin on, also used for the tails of the SIMD kernels
+ */
+uint32_t depthRowToPointsScalar(const PointCloudRow &row, const PointCloudRowColor *color, uint32_t begin, uint32_t count, int step, bool outputZeroPoint,
+                                float *dst);
+
+/**
+ * @brief AVX2 kernel of depthRowToPoints for step 1 from column begin on, built in its own translation unit. Only processes whole chunks of
+ * 8 pixels.
+ *
+ * @param[out] written number of points written
+ *
+ * @return first column not processed, begin if the library is built without the AVX2 kernels
+ */
+uint32_t depthRowToPointsAVX2(const PointCloudRow &row, const PointCloudRowColor *color, uint32_t begin, uint32_t count, bool outputZeroPoint, float *dst,
+                              uint32_t *written);
+
+/**
+ * @brief IEEE 754 half float of a float, rounded to nearest even
+ */
+uint16_t floatToHalf(float value);
+
+/**
+ * @brief Convert interleaved points (OBPoint, OBColorPoint) to planes of half floats: the first value of all points, then the second one...
+ *
+ * @param[in] points interleaved points
+ * @param[in] pointCount number of points
+ * @param[in] channels number of values per point, 3 or 6
+ * @param[out] planes channels * pointCount half floats
+ */
+void pointsToHalfPlanes(const float *points, uint32_t pointCount, uint32_t channels, uint16_t *planes);
+
+}  // namespace utils
+}  // namespace libobsensor
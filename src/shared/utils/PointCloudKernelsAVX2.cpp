@@ -0,0 +1,133 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Built with AVX2 enabled and only called after a runtime check of the CPU (utils::getSimdLevel()). Nothing inline or templated from the
+// C++ headers is used here, so no AVX2 copy of a shared function can be picked by the linker for the code running on older CPUs.
+// No FMA: the kernels only multiply, in the order of the scalar code.
+
+#include "PointCloudKernels.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace libobsensor {
+namespace utils {
+
+#if defined(__AVX2__)
+
+namespace {
+
+// x0 x1 x2 x3, y0 y1 y2 y3, z0 z1 z2 z3 -> x0 y0 z0 x1 y1 z1 x2 y2 z2 x3 y3 z3
+inline void storeInterleaved4(float *dst, __m128 x, __m128 y, __m128 z) {
+    __m128 xy01 = _mm_unpacklo_ps(x, y);                              // x0 y0 x1 y1
+    __m128 xy23 = _mm_unpackhi_ps(x, y);                              // x2 y2 x3 y3
+    __m128 z0x1 = _mm_shuffle_ps(z, xy01, _MM_SHUFFLE(2, 2, 0, 0));  // z0 z0 x1 x1
+    __m128 y1z1 = _mm_shuffle_ps(xy01, z, _MM_SHUFFLE(1, 1, 3, 3));  // y1 y1 z1 z1
+    __m128 z2x3 = _mm_shuffle_ps(z, xy23, _MM_SHUFFLE(2, 2, 2, 2));  // z2 z2 x3 x3
+    __m128 xyz3 = _mm_shuffle_ps(xy23, z, _MM_SHUFFLE(3, 3, 3, 2));  // x3 y3 z3 z3
+    _mm_storeu_ps(dst + 0, _mm_shuffle_ps(xy01, z0x1, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(dst + 4, _mm_shuffle_ps(y1z1, xy23, _MM_SHUFFLE(1, 0, 2, 0)));
+    _mm_storeu_ps(dst + 8, _mm_shuffle_ps(z2x3, xyz3, _MM_SHUFFLE(2, 1, 2, 0)));
+}
+
+// The lanes one by one, as the scalar code: the lanes with zero points are skipped or the points have colors
+uint32_t storeLanes(const PointCloudRowColor *color, uint32_t j, const float *x, const float *y, const float *z, uint32_t validMask, bool outputZeroPoint,
+                    float *dst) {
+    uint32_t stride  = color ? 6 : 3;
+    uint32_t written = 0;
+    for(int k = 0; k < 8; k++) {
+        float r = 0.0f, g = 0.0f, b = 0.0f;
+        if(color && (validMask & (1u << k))) {
+            int icc = static_cast<int>(color->offset + static_cast<int>(j + k) * color->scale);
+            r       = color->rgb[3 * icc + 0] / color->divCoeff;
+            g       = color->rgb[3 * icc + 1] / color->divCoeff;
+            b       = color->rgb[3 * icc + 2] / color->divCoeff;
+        }
+        if(!outputZeroPoint && x[k] == 0.0f && y[k] == 0.0f && z[k] == 0.0f && r == 0.0f && g == 0.0f && b == 0.0f) {
+            continue;
+        }
+        float *point = dst + written * stride;
+        point[0]     = x[k];
+        point[1]     = y[k];
+        point[2]     = z[k];
+        if(color) {
+            point[3] = r;
+            point[4] = g;
+            point[5] = b;
+        }
+        written++;
+    }
+    return written;
+}
+
+}  // namespace
+
+uint32_t depthRowToPointsAVX2(const PointCloudRow &row, const PointCloudRowColor *color, uint32_t begin, uint32_t count, bool outputZeroPoint, float *dst,
+                              uint32_t *written) {
+    const __m256i invalid = _mm256_set1_epi32(row.y12c4 ? 0x0FFF : 0xFFFF);
+    const __m256  zero    = _mm256_setzero_ps();
+    const __m256  scale   = _mm256_set1_ps(row.scale);
+    const __m256  yCoeff  = _mm256_set1_ps(row.yCoeff);
+    const int     stride  = color ? 6 : 3;
+
+    uint32_t n = 0;
+    uint32_t j = begin;
+    for(; j + 8 <= count; j += 8) {
+        __m256i depth = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row.depth + j)));
+        if(row.y12c4) {
+            depth = _mm256_srli_epi32(depth, 4);
+        }
+        __m256 xTab  = _mm256_loadu_ps(row.xTable + j);
+        __m256 valid = _mm256_andnot_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(depth, invalid)), _mm256_cmp_ps(xTab, xTab, _CMP_ORD_Q));
+
+        __m256 z = _mm256_cvtepi32_ps(depth);
+        __m256 x = _mm256_mul_ps(xTab, z);
+        __m256 y = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(row.yTable + j), z), yCoeff);
+        z        = _mm256_and_ps(_mm256_mul_ps(z, scale), valid);
+        x        = _mm256_and_ps(_mm256_mul_ps(x, scale), valid);
+        y        = _mm256_and_ps(_mm256_mul_ps(y, scale), valid);
+
+        if(!color) {
+            int zeroMask = 0;
+            if(!outputZeroPoint) {
+                __m256 isZero = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(x, zero, _CMP_EQ_OQ), _mm256_cmp_ps(y, zero, _CMP_EQ_OQ)),
+                                              _mm256_cmp_ps(z, zero, _CMP_EQ_OQ));
+                zeroMask      = _mm256_movemask_ps(isZero);
+            }
+            if(zeroMask == 0) {
+                float *point = dst + n * stride;
+                storeInterleaved4(point, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+                storeInterleaved4(point + 12, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+                n += 8;
+                continue;
+            }
+        }
+
+        float xs[8], ys[8], zs[8];
+        _mm256_storeu_ps(xs, x);
+        _mm256_storeu_ps(ys, y);
+        _mm256_storeu_ps(zs, z);
+        n += storeLanes(color, j, xs, ys, zs, static_cast<uint32_t>(_mm256_movemask_ps(valid)), outputZeroPoint, dst + n * stride);
+    }
+    *written = n;
+    return j;
+}
+
+#else
+
+uint32_t depthRowToPointsAVX2(const PointCloudRow &row, const PointCloudRowColor *color, uint32_t begin, uint32_t count, bool outputZeroPoint, float *dst,
+                              uint32_t *written) {
+    (void)row;
+    (void)color;
+    (void)count;
+    (void)outputZeroPoint;
+    (void)dst;
+    *written = 0;
+    return begin;
+}
+
+#endif  // __AVX2__
+
+}  // namespace utils
+}  // namespace libobsensor
@@ -5,7 +5,12 @@
 #include "logger/Logger.hpp"
 #include "logger/LoggerInterval.hpp"
 
+#include <spdlog/fmt/fmt.h>
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <map>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846 /* pi */
@@ -54,85 +59,272 @@ inline float computePointsDistance(const Vertex &v1, const Vertex &v2) {
     return std::sqrt(diffX * diffX + diffY * diffY + diffZ * diffZ);
 }
 
-void savePointCloud(const char *fileName, MeshData meshData, bool useMesh, bool colorPointCloud, bool saveBinary) {
-    std::ofstream plyOut(fileName);
-    if(!plyOut) {
-        std::cerr << "Error: Cannot open file " << fileName << " for writing!" << std::endl;
-        return;
+#define PLY_WRITE_BUFFER_SIZE (4 * 1024 * 1024)
+#define PLY_BLOCK_POINTS 16384      // points formatted per reserve() of the buffer
+#define PLY_MAX_VERTEX_SIZE 128     // bytes of the longest ASCII vertex line(s)
+
+// Output file with its own large buffer: the PLY data is formatted straight into the buffer, which is written in large blocks
+class PlyFileWriter {
+public:
+    explicit PlyFileWriter(const char *fileName) : file_(fopen(fileName, "wb")), buffer_(PLY_WRITE_BUFFER_SIZE), used_(0), failed_(false) {
+        if(file_) {
+            setvbuf(file_, nullptr, _IONBF, 0);
+        }
     }
 
-    plyOut << "ply\n";
-    if(saveBinary) {
-        plyOut << "format binary_little_endian 1.0\n";
+    ~PlyFileWriter() noexcept {
+        close();
     }
-    else {
-        plyOut << "format ascii 1.0\n";
+
+    bool isOpen() const {
+        return file_ != nullptr;
     }
 
-    plyOut << "comment Generated by mesh generation code\n";
-    plyOut << "element vertex " << meshData.vertices.size() << "\n";
-    plyOut << "property float x\n";
-    plyOut << "property float y\n";
-    plyOut << "property float z\n";
-    if(colorPointCloud) {
-        plyOut << "property uchar red\n";
-        plyOut << "property uchar green\n";
-        plyOut << "property uchar blue\n";
+    // Room for at least size bytes (up to PLY_WRITE_BUFFER_SIZE), commit() the bytes actually written
+    char *reserve(size_t size) {
+        if(buffer_.size() - used_ < size) {
+            flush();
+        }
+        return buffer_.data() + used_;
+    }
+
+    void commit(size_t size) {
+        used_ += size;
+    }
+
+    void write(const std::string &str) {
+        memcpy(reserve(str.size()), str.data(), str.size());
+        commit(str.size());
     }
 
+    // false if a write failed
+    bool close() {
+        if(file_) {
+            flush();
+            failed_ = fclose(file_) != 0 || failed_;
+            file_   = nullptr;
+        }
+        return !failed_;
+    }
+
+private:
+    void flush() {
+        if(used_ > 0 && fwrite(buffer_.data(), 1, used_, file_) != used_) {
+            failed_ = true;
+        }
+        used_ = 0;
+    }
+
+    FILE             *file_;
+    std::vector<char> buffer_;
+    size_t            used_;
+    bool              failed_;
+};
+
+void writePlyHeader(PlyFileWriter &writer, PlyEncoding encoding, size_t vertexCount, bool colorPointCloud, bool useMesh, size_t faceCount,
+                    float quantizationStep) {
+    std::string header = "ply\n";
+    header += encoding == PLY_ENCODING_ASCII ? "format ascii 1.0\n" : "format binary_little_endian 1.0\n";
+    header += "comment Generated by mesh generation code\n";
+    if(encoding == PLY_ENCODING_BINARY_QUANTIZED) {
+        header += fmt::format("comment quantization step {}\n", quantizationStep);
+    }
+    header += fmt::format("element vertex {}\n", vertexCount);
+    const char *coordType = encoding == PLY_ENCODING_BINARY_QUANTIZED ? "short" : "float";
+    header += fmt::format("property {} x\nproperty {} y\nproperty {} z\n", coordType, coordType, coordType);
+    if(colorPointCloud) {
+        header += "property uchar red\n";
+        header += "property uchar green\n";
+        header += "property uchar blue\n";
+    }
     if(useMesh) {
-        plyOut << "element face " << meshData.faces.size() << "\n";
-        plyOut << "property list uchar int vertex_indices\n";
+        header += fmt::format("element face {}\n", faceCount);
+        header += "property list uchar int vertex_indices\n";
+    }
+    header += "end_header\n";
+    writer.write(header);
+}
+
+bool savePointCloud(const char *fileName, const MeshData &meshData, bool useMesh, bool colorPointCloud, bool saveBinary) {
+    PlyFileWriter writer(fileName);
+    if(!writer.isOpen()) {
+        LOG_WARN("Cannot open file {} for writing!", fileName);
+        return false;
     }
 
-    plyOut << "end_header\n";
+    writePlyHeader(writer, saveBinary ? PLY_ENCODING_BINARY : PLY_ENCODING_ASCII, meshData.vertices.size(), colorPointCloud, useMesh, meshData.faces.size(), 0);
 
     if(saveBinary) {
-        plyOut.close();
-        plyOut.open(fileName, std::ios_base::app | std::ios_base::binary);
-        for(size_t i = 0; i < meshData.vertices.size(); i++) {
+        for(const auto &vertex: meshData.vertices) {
             // write vertices
-            plyOut.write(reinterpret_cast<const char *>(&(meshData.vertices[i].x)), sizeof(float));
-            plyOut.write(reinterpret_cast<const char *>(&(meshData.vertices[i].y)), sizeof(float));
-            plyOut.write(reinterpret_cast<const char *>(&(meshData.vertices[i].z)), sizeof(float));
-
+            char *dst = writer.reserve(3 * sizeof(float) + 3);
+            memcpy(dst, &vertex.x, sizeof(float));
+            memcpy(dst + 4, &vertex.y, sizeof(float));
+            memcpy(dst + 8, &vertex.z, sizeof(float));
             if(colorPointCloud) {
-                plyOut.write(reinterpret_cast<const char *>(&meshData.vertices[i].color[0]), sizeof(uint8_t));
-                plyOut.write(reinterpret_cast<const char *>(&meshData.vertices[i].color[1]), sizeof(uint8_t));
-                plyOut.write(reinterpret_cast<const char *>(&meshData.vertices[i].color[2]), sizeof(uint8_t));
+                memcpy(dst + 12, vertex.color, 3);
             }
+            writer.commit(colorPointCloud ? 15 : 12);
         }
 
         // write faces
         if(useMesh) {
-            for(size_t i = 0; i < meshData.faces.size(); i++) {
-                static const int three = 3;
-                plyOut.write(reinterpret_cast<const char *>(&three), sizeof(uint8_t));
-                plyOut.write(reinterpret_cast<const char *>(&meshData.faces[i].x), sizeof(int));
-                plyOut.write(reinterpret_cast<const char *>(&meshData.faces[i].y), sizeof(int));
-                plyOut.write(reinterpret_cast<const char *>(&meshData.faces[i].z), sizeof(int));
+            for(const auto &face: meshData.faces) {
+                char *dst = writer.reserve(1 + 3 * sizeof(int));
+                dst[0]    = 3;
+                memcpy(dst + 1, &face.x, sizeof(int));
+                memcpy(dst + 5, &face.y, sizeof(int));
+                memcpy(dst + 9, &face.z, sizeof(int));
+                writer.commit(1 + 3 * sizeof(int));
             }
         }
     }
     else {
         // write vertices
-        for(size_t i = 0; i < meshData.vertices.size(); i++) {
-            plyOut << meshData.vertices[i].x << " " << meshData.vertices[i].y << " " << meshData.vertices[i].z << "\n";
+        for(const auto &vertex: meshData.vertices) {
+            char *dst = writer.reserve(PLY_MAX_VERTEX_SIZE);
+            char *end = fmt::format_to_n(dst, PLY_MAX_VERTEX_SIZE, "{:g} {:g} {:g}\n", vertex.x, vertex.y, vertex.z).out;
             if(colorPointCloud) {
-                plyOut << static_cast<int>(meshData.vertices[i].color[0]) << " " << static_cast<int>(meshData.vertices[i].color[1]) << " "
-                       << static_cast<int>(meshData.vertices[i].color[2]) << "\n";
+                end = fmt::format_to_n(end, PLY_MAX_VERTEX_SIZE - (end - dst), "{} {} {}\n", vertex.color[0], vertex.color[1], vertex.color[2]).out;
             }
+            writer.commit(end - dst);
         }
 
         // write faces
         if(useMesh) {
-            for(size_t i = 0; i < meshData.faces.size(); i++) {
-                plyOut << "3 " << meshData.faces[i].x << " " << meshData.faces[i].y << " " << meshData.faces[i].z << "\n";
+            for(const auto &face: meshData.faces) {
+                char *dst = writer.reserve(PLY_MAX_VERTEX_SIZE);
+                writer.commit(fmt::format_to_n(dst, PLY_MAX_VERTEX_SIZE, "3 {} {} {}\n", face.x, face.y, face.z).size);
             }
         }
     }
 
-    plyOut.close();
+    if(!writer.close()) {
+        LOG_WARN("Write point cloud to {} failed!", fileName);
+        return false;
+    }
+    return true;
+}
+
+inline bool isValidPoint(const OBPoint &pt) {
+    return std::fabs(pt.z) >= minPointValue;
+}
+
+inline bool isValidPoint(const OBColorPoint &pt) {
+    return std::fabs(pt.z) >= minPointValue;
+}
+
+inline int16_t quantize(float value, float invStep) {
+    float q = std::min(std::max(value * invStep, -32768.0f), 32767.0f);
+    return static_cast<int16_t>(std::lrint(q));
+}
+
+// Color of a vertex, nothing for OBPoint
+inline char *writeBinaryColor(char *dst, const OBPoint &) {
+    return dst;
+}
+
+inline char *writeBinaryColor(char *dst, const OBColorPoint &pt) {
+    dst[0] = static_cast<char>(static_cast<uint8_t>(pt.r));
+    dst[1] = static_cast<char>(static_cast<uint8_t>(pt.g));
+    dst[2] = static_cast<char>(static_cast<uint8_t>(pt.b));
+    return dst + 3;
+}
+
+inline char *writeAsciiColor(char *dst, size_t, const OBPoint &) {
+    return dst;
+}
+
+inline char *writeAsciiColor(char *dst, size_t size, const OBColorPoint &pt) {
+    return fmt::format_to_n(dst, size, "{} {} {}\n", static_cast<uint8_t>(pt.r), static_cast<uint8_t>(pt.g), static_cast<uint8_t>(pt.b)).out;
+}
+
+// Same vertices as the MeshData path of savePointCloudToPly, formatted block by block into the writer buffer
+template <typename T> void writePlyVertices(PlyFileWriter &writer, const T *points, size_t pointCount, PlyEncoding encoding, float quantizationStep) {
+    const float invStep = 1.0f / quantizationStep;
+    for(size_t blockBegin = 0; blockBegin < pointCount; blockBegin += PLY_BLOCK_POINTS) {
+        size_t blockEnd = std::min(pointCount, blockBegin + PLY_BLOCK_POINTS);
+        char  *start    = writer.reserve(PLY_BLOCK_POINTS * PLY_MAX_VERTEX_SIZE);
+        char  *dst      = start;
+        for(size_t i = blockBegin; i < blockEnd; i++) {
+            const T &pt = points[i];
+            if(!isValidPoint(pt)) {
+                continue;
+            }
+            switch(encoding) {
+            case PLY_ENCODING_BINARY:
+                memcpy(dst, &pt.x, sizeof(float));
+                memcpy(dst + 4, &pt.y, sizeof(float));
+                memcpy(dst + 8, &pt.z, sizeof(float));
+                dst = writeBinaryColor(dst + 12, pt);
+                break;
+            case PLY_ENCODING_BINARY_QUANTIZED: {
+                int16_t xyz[3] = { quantize(pt.x, invStep), quantize(pt.y, invStep), quantize(pt.z, invStep) };
+                memcpy(dst, xyz, sizeof(xyz));
+                dst = writeBinaryColor(dst + sizeof(xyz), pt);
+                break;
+            }
+            default:
+                dst = fmt::format_to_n(dst, PLY_MAX_VERTEX_SIZE, "{:g} {:g} {:g}\n", pt.x, pt.y, pt.z).out;
+                dst = writeAsciiColor(dst, PLY_MAX_VERTEX_SIZE / 2, pt);
+                break;
+            }
+        }
+        writer.commit(dst - start);
+    }
+}
+
+template <typename T>
+bool streamPoints(const char *fileName, const T *points, size_t pointCount, bool colorPointCloud, PlyEncoding encoding, float quantizationStep) {
+    size_t vertexCount = 0;
+    for(size_t i = 0; i < pointCount; i++) {
+        vertexCount += isValidPoint(points[i]) ? 1 : 0;
+    }
+    if(vertexCount == 0) {
+        LOG_WARN("vertices is zero");
+        return false;
+    }
+
+    PlyFileWriter writer(fileName);
+    if(!writer.isOpen()) {
+        LOG_WARN("Cannot open file {} for writing!", fileName);
+        return false;
+    }
+    writePlyHeader(writer, encoding, vertexCount, colorPointCloud, false, 0, quantizationStep);
+    writePlyVertices(writer, points, pointCount, encoding, quantizationStep);
+    if(!writer.close()) {
+        LOG_WARN("Write point cloud to {} failed!", fileName);
+        return false;
+    }
+    return true;
+}
+
+bool PointCloudSaveUtil::streamPointCloudToPly(const char *fileName, std::shared_ptr<Frame> frame, PlyEncoding encoding, float quantizationStep) {
+    if(!frame) {
+        LOG_WARN("depth point cloud frame is null");
+        return false;
+    }
+    if(encoding == PLY_ENCODING_BINARY_QUANTIZED && !(quantizationStep > 0.0f)) {
+        LOG_WARN("Invalid quantization step: {}", quantizationStep);
+        return false;
+    }
+
+    auto pointCloudFrame = frame->as<libobsensor::PointsFrame>();
+    auto pointCloudType  = pointCloudFrame->getFormat();
+    // Without the zero points (outputZeroPoint off) the frame holds fewer than width * height points
+    size_t maxPointCount = static_cast<size_t>(pointCloudFrame->getWidth()) * pointCloudFrame->getHeight();
+
+    if(pointCloudType == OB_FORMAT_POINT) {
+        size_t pointCount = std::min(maxPointCount, pointCloudFrame->getDataSize() / sizeof(OBPoint));
+        return streamPoints(fileName, reinterpret_cast<const OBPoint *>(pointCloudFrame->getData()), pointCount, false, encoding, quantizationStep);
+    }
+    if(pointCloudType == OB_FORMAT_RGB_POINT) {
+        size_t pointCount = std::min(maxPointCount, pointCloudFrame->getDataSize() / sizeof(OBColorPoint));
+        return streamPoints(fileName, reinterpret_cast<const OBColorPoint *>(pointCloudFrame->getData()), pointCount, true, encoding, quantizationStep);
+    }
+
+    LOG_WARN("point cloud format invalid");
+    return false;
 }
 
 bool PointCloudSaveUtil::savePointCloudToPly(const char *fileName, std::shared_ptr<Frame> frame, bool saveBinary, bool useMesh, float meshThreshold) {
@@ -149,6 +341,10 @@ bool PointCloudSaveUtil::savePointCloudToPly(const char *fileName, std::shared_p
         return false;
     }
 
+    if(!useMesh) {
+        return streamPointCloudToPly(fileName, frame, saveBinary ? PLY_ENCODING_BINARY : PLY_ENCODING_ASCII);
+    }
+
     MeshData meshData;
     uint32_t width  = pointCloudFrame->getWidth();
     uint32_t height = pointCloudFrame->getHeight();
@@ -262,8 +458,7 @@ bool PointCloudSaveUtil::savePointCloudToPly(const char *fileName, std::shared_p
     meshData.vertices.swap(vertices);
 
     bool colorPointCloud = (pointCloudType == OB_FORMAT_RGB_POINT);
-    savePointCloud(fileName, meshData, useMesh, colorPointCloud, saveBinary);
-    return true;
+    return savePointCloud(fileName, meshData, useMesh, colorPointCloud, saveBinary);
 }
 
 bool PointCloudSaveUtil::saveLiDARPointCloudToPly(const char *fileName, std::shared_ptr<Frame> frame, bool saveBinary) {
@@ -361,7 +556,6 @@ bool PointCloudSaveUtil::saveLiDARPointCloudToPly(const char *fileName, std::sha
     vertices.shrink_to_fit();
     meshData.vertices.swap(vertices);
 
-    savePointCloud(fileName, meshData, false, false, saveBinary);
-    return true;
+    return savePointCloud(fileName, meshData, false, false, saveBinary);
 }
 }  // namespace libobsensor
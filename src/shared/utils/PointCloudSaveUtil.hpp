@@ -7,11 +7,25 @@
 
 namespace libobsensor {
 
+typedef enum {
+    PLY_ENCODING_ASCII,
+    PLY_ENCODING_BINARY,
+    PLY_ENCODING_BINARY_QUANTIZED,  // binary, x y z as int16 in units of the quantization step
+} PlyEncoding;
+
 class PointCloudSaveUtil {
 public:
     static bool savePointCloudToPly(const char *fileName, std::shared_ptr<Frame> frame, bool saveBinary = false, bool useMesh = false,
                                     float meshThreshold = 50.0);
 
+    /**
+     * @brief Write the points of a point cloud frame (OB_FORMAT_POINT or OB_FORMAT_RGB_POINT) to a PLY file straight from the frame data, without
+     * the zero points. The file is written in large blocks of an own buffer.
+     *
+     * @param[in] quantizationStep coordinate unit of PLY_ENCODING_BINARY_QUANTIZED, the coordinates are rounded to it and clamped to the int16 range
+     */
+    static bool streamPointCloudToPly(const char *fileName, std::shared_ptr<Frame> frame, PlyEncoding encoding, float quantizationStep = 1.0f);
+
     static bool saveLiDARPointCloudToPly(const char *fileName, std::shared_ptr<Frame> frame, bool saveBinary = false);
 };
 }  // namespace libobsensor
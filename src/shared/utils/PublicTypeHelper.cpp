@@ -59,6 +59,12 @@ bool getBytesPerPixelNoexcept(OBFormat format, float &bytesPerPixel) {
     case OB_FORMAT_RGB_POINT:
         bytesPerPixel = 24.f;
         break;
+    case OB_FORMAT_POINT_SOA_F16:
+        bytesPerPixel = 6.f;
+        break;
+    case OB_FORMAT_RGB_POINT_SOA_F16:
+        bytesPerPixel = 12.f;
+        break;
     default:
         return false;
     }
@@ -392,7 +398,8 @@ const std::map<OBFrameType, std::string> Frame_Str_Map = { { OB_FRAME_UNKNOWN, "
                                                            { OB_FRAME_IR_RIGHT, "Right IR" },
                                                            { OB_FRAME_RAW_PHASE, "RawPhase" },
                                                            { OB_FRAME_CONFIDENCE, "Confidence" },
-                                                           { OB_FRAME_LIDAR_POINTS, "LiDAR Points" } };
+                                                           { OB_FRAME_LIDAR_POINTS, "LiDAR Points" },
+                                                           { OB_FRAME_IMU_BATCH, "IMU Batch" } };
 
 const std::map<OBStreamType, std::string> Stream_Str_Map = { { OB_STREAM_UNKNOWN, "Unknown" },
                                                              { OB_STREAM_VIDEO, "Video" },
@@ -480,6 +487,8 @@ const std::map<OBFormat, std::string> Format_Str_Map = {
     { OB_FORMAT_LIDAR_SPHERE_POINT, "LIDAR_SPHERE_POINT" },
     { OB_FORMAT_LIDAR_SCAN, "LIDAR_SCAN" },
     { OB_FORMAT_LIDAR_CALIBRATION, "LIDAR_CALIBRATION" },
+    { OB_FORMAT_POINT_SOA_F16, "POINT_SOA_F16" },
+    { OB_FORMAT_RGB_POINT_SOA_F16, "RGB_POINT_SOA_F16" },
     { OB_FORMAT_UNKNOWN, "UNKNOWN" },
 };
 
@@ -15,9 +15,11 @@
 #else
 #include <unistd.h>
 #include <arpa/inet.h>
+#include <sys/mman.h>
 #endif
 
 #include <chrono>
+#include <iomanip>
 #include <logger/Logger.hpp>
 
 namespace libobsensor {
@@ -59,6 +61,47 @@ void sleepMs(uint64_t msec) {
 #endif
 }
 
+std::string PhaseTimer::toString() {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    for(const auto &phase: phases_) {
+        ss << phase.first << " " << phase.second / 1000.0 << "ms, ";
+    }
+    ss << "total " << totalUs() / 1000.0 << "ms";
+    return ss.str();
+}
+
+bool lockMemory(void *ptr, size_t size) {
+#ifdef WIN32
+    return VirtualLock(ptr, size) != 0;
+#else
+    return mlock(ptr, size) == 0;
+#endif
+}
+
+void unlockMemory(void *ptr, size_t size) {
+#ifdef WIN32
+    VirtualUnlock(ptr, size);
+#else
+    munlock(ptr, size);
+#endif
+}
+
+void adviseHugePages(void *ptr, size_t size) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // madvise requires a page aligned address, only advise the pages fully inside the block
+    const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t       begin    = (reinterpret_cast<uintptr_t>(ptr) + pageSize - 1) & ~(pageSize - 1);
+    uintptr_t       end      = (reinterpret_cast<uintptr_t>(ptr) + size) & ~(pageSize - 1);
+    if(end > begin) {
+        madvise(reinterpret_cast<void *>(begin), end - begin, MADV_HUGEPAGE);
+    }
+#else
+    unusedVar(ptr);
+    unusedVar(size);
+#endif
+}
+
 bool checkJpgImageData(const uint8_t *data, size_t dataLen) {
     bool validImage = dataLen >= 2 && data[0] == 0xFF && data[1] == 0xD8;
     if(validImage) {
@@ -23,6 +23,12 @@ uint64_t getSteadyTimeMs();
 uint64_t getSteadyTimeUs();
 void     sleepMs(uint64_t msec);
 
+// Pin the pages of a memory block in physical memory, returns false if the OS refused (e.g. exceeds RLIMIT_MEMLOCK)
+bool lockMemory(void *ptr, size_t size);
+void unlockMemory(void *ptr, size_t size);
+// Advise the OS to back a large memory block with (transparent) huge pages, no-op on unsupported platforms
+void adviseHugePages(void *ptr, size_t size);
+
 /**
  * @brief Timer class to measure time intervals between calls
  */
@@ -76,6 +82,35 @@ private:
     std::chrono::steady_clock::time_point start_;
 };
 
+/**
+ * @brief Durations of the successive phases of a task (e.g. the initialization of a device), for the log
+ */
+class PhaseTimer {
+public:
+    /**
+     * @brief End the current phase, which started at the previous call (or at the construction of the timer)
+     */
+    void mark(const std::string &phase) {
+        phases_.emplace_back(phase, timer_.touchUs());
+    }
+
+    /**
+     * @brief Returns microseconds elapsed since the construction of the timer
+     */
+    uint64_t totalUs() {
+        return timer_.touchUs(false);
+    }
+
+    /**
+     * @brief The phases and their durations, e.g. "initProperties 1.2ms, fetchDeviceInfo 8.5ms, total 9.8ms"
+     */
+    std::string toString();
+
+private:
+    Timer                                         timer_;
+    std::vector<std::pair<std::string, uint64_t>> phases_;  // name, duration in us
+};
+
 /**
  * @brief Represents a time span measured via steady clock
  * @note A value of 0 indicates the timestamp is unrecorded or invalid
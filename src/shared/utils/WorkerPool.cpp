@@ -0,0 +1,105 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "WorkerPool.hpp"
+
+namespace libobsensor {
+namespace utils {
+
+WorkerPool::WorkerPool(uint32_t threadCount)
+    : stopped_(false), generation_(0), busyWorkers_(0), task_(nullptr), taskCount_(0), nextTask_(0) {
+    for(uint32_t i = 1; i < threadCount; i++) {
+        workers_.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() noexcept {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+    workCv_.notify_all();
+    for(auto &worker: workers_) {
+        if(worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void WorkerPool::run(uint32_t taskCount, const std::function<void(uint32_t)> &task) {
+    if(taskCount == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(runMutex_);
+    if(workers_.empty() || taskCount == 1) {
+        for(uint32_t i = 0; i < taskCount; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        task_        = &task;
+        taskCount_   = taskCount;
+        exception_   = nullptr;
+        busyWorkers_ = static_cast<uint32_t>(workers_.size());
+        nextTask_.store(0);
+        generation_++;
+    }
+    workCv_.notify_all();
+
+    runTasks();
+
+    std::exception_ptr exception;
+    {
+        // Wait for every worker to leave this generation, so that the next run() can safely reuse the task state
+        std::unique_lock<std::mutex> lock(mutex_);
+        doneCv_.wait(lock, [this]() { return busyWorkers_ == 0; });
+        task_ = nullptr;
+        std::swap(exception, exception_);
+    }
+    if(exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void WorkerPool::runTasks() {
+    uint32_t index;
+    while((index = nextTask_.fetch_add(1)) < taskCount_) {
+        try {
+            (*task_)(index);
+        }
+        catch(...) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if(!exception_) {
+                exception_ = std::current_exception();
+            }
+        }
+    }
+}
+
+void WorkerPool::workerLoop() {
+    uint64_t lastGeneration = 0;
+    while(true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            workCv_.wait(lock, [&]() { return stopped_ || generation_ != lastGeneration; });
+            if(stopped_) {
+                break;
+            }
+            lastGeneration = generation_;
+        }
+
+        runTasks();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if(--busyWorkers_ == 0) {
+            doneCv_.notify_one();
+        }
+    }
+}
+
+}  // namespace utils
+}  // namespace libobsensor
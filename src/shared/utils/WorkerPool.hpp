@@ -0,0 +1,66 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "SteadyCondVar.hpp"
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+namespace libobsensor {
+namespace utils {
+
+/**
+ * @brief Fixed size pool of worker threads to split a per-frame computation into tasks (e.g. image tiles)
+ * @brief The calling thread takes part in the work, so a pool of N threads starts N-1 worker threads.
+ */
+class WorkerPool {
+public:
+    explicit WorkerPool(uint32_t threadCount);
+    ~WorkerPool() noexcept;
+
+    WorkerPool(const WorkerPool &)            = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /**
+     * @brief Number of threads running the tasks, including the calling thread
+     */
+    uint32_t getThreadCount() const {
+        return static_cast<uint32_t>(workers_.size() + 1);
+    }
+
+    /**
+     * @brief Run task(index) for every index in [0, taskCount) and return once all of them are done
+     * @brief If tasks throw, the first exception is rethrown on the calling thread after all the tasks are done.
+     */
+    void run(uint32_t taskCount, const std::function<void(uint32_t)> &task);
+
+private:
+    void workerLoop();
+    void runTasks();
+
+private:
+    std::vector<std::thread> workers_;
+
+    std::mutex    runMutex_;  // serializes run() calls
+    std::mutex    mutex_;
+    SteadyCondVar workCv_;
+    SteadyCondVar doneCv_;
+    bool          stopped_;
+    uint64_t      generation_;
+    uint32_t      busyWorkers_;
+
+    const std::function<void(uint32_t)> *task_;
+    uint32_t                             taskCount_;
+    std::atomic<uint32_t>                nextTask_;
+    std::exception_ptr                   exception_;
+};
+
+}  // namespace utils
+}  // namespace libobsensor
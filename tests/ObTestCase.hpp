@@ -0,0 +1,29 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdio>
+
+// Case reporting of the tests of the SDK internal modules: each case calls obtest::report(), main returns obtest::result().
+namespace obtest {
+
+inline int &failedCases() {
+    static int count = 0;
+    return count;
+}
+
+inline void report(const char *name, bool pass) {
+    std::printf("[CASE][%s] %s\n", pass ? "PASS" : "FAIL", name);
+    if(!pass) {
+        failedCases()++;
+    }
+}
+
+// Prints the number of failed cases, returns the exit code of the test
+inline int result() {
+    std::printf("%d case(s) failed\n", failedCases());
+    return failedCases() == 0 ? 0 : 1;
+}
+
+}  // namespace obtest
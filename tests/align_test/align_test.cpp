@@ -10,7 +10,6 @@
 #include <map>
 #include <sstream>
 #include <string>
-#include <windows.h>
 
 #include "get_time.h"
 
@@ -315,7 +314,7 @@ int main(int argc, char *argv[]) {
         return -1;
     }
     libobsensor::AlignImpl *impl = new libobsensor::AlignImpl();
-    impl->initialize(depth_intr, depth_disto, color_intr, color_disto, transform, 1, true, is_copy1);
+    impl->initialize(depth_intr, depth_disto, color_intr, color_disto, transform, 1, true, is_copy1, false, OB_FORMAT_Y16, 0xFFFF);
 
     ob_error *err = nullptr;
 
@@ -338,7 +337,7 @@ int main(int argc, char *argv[]) {
         swap_endianness = bool(std::atoi(argv[6]));
     if(swap_endianness) {
         for(int i = 0; i < depth_intr.width * depth_intr.height; i++) {
-            depth_data[i] = _byteswap_ushort(depth_data[i]);
+            depth_data[i] = static_cast<uint16_t>((depth_data[i] >> 8) | (depth_data[i] << 8));
         }
     }
 
@@ -0,0 +1,203 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Multi-threaded (tiled) alignment of AlignImpl. Each case aligns the same synthetic depth frame with 1 thread, then with 2, 3, 4, 8 and 16
+// threads, and compares the outputs byte for byte: the aligned depth and the coordinate map of D2C, the aligned color of C2D. The cases cover
+// the scalar and SSE paths, both gap fillings, the target distortion models, a frame height that is not a multiple of the tile row step and
+// the scaled-down alignment. The time per thread count is measured by ob_align_tile_benchmark.
+//
+// usage: align_tile_test
+
+#include "publicfilters/AlignImpl.hpp"
+#include "ObTestCase.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(__ARM_NEON__) || defined(__NEON__) || defined(__SSSE3__)
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t THREAD_COUNTS[] = { 2, 3, 4, 8, 16 };
+
+// Deterministic pseudo random input, a failure always reproduces
+uint32_t nextRandom(uint32_t &state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+OBCameraIntrinsic makeIntrinsic(int width, int height, float focal) {
+    OBCameraIntrinsic intrinsic;
+    intrinsic.fx     = focal;
+    intrinsic.fy     = focal * 1.002f;
+    intrinsic.cx     = width * 0.5f + 1.3f;
+    intrinsic.cy     = height * 0.5f - 2.1f;
+    intrinsic.width  = static_cast<int16_t>(width);
+    intrinsic.height = static_cast<int16_t>(height);
+    return intrinsic;
+}
+
+OBCameraDistortion makeDistortion(OBCameraDistortionModel model) {
+    OBCameraDistortion distortion;
+    memset(&distortion, 0, sizeof(distortion));
+    distortion.model = model;
+    if(model == OB_DISTORTION_BROWN_CONRADY) {
+        distortion.k1 = 0.08f;
+        distortion.k2 = -0.2f;
+        distortion.k3 = 0.09f;
+        distortion.p1 = 0.0006f;
+        distortion.p2 = -0.0004f;
+    }
+    else if(model == OB_DISTORTION_BROWN_CONRADY_K6) {
+        distortion.k1 = 0.52f;
+        distortion.k2 = -0.11f;
+        distortion.k3 = 0.012f;
+        distortion.k4 = 0.47f;
+        distortion.k5 = -0.083f;
+        distortion.k6 = 0.0081f;
+        distortion.p1 = 0.0002f;
+        distortion.p2 = 0.0003f;
+    }
+    else if(model == OB_DISTORTION_KANNALA_BRANDT4) {
+        distortion.k1 = 0.021f;
+        distortion.k2 = -0.0043f;
+        distortion.k3 = 0.0012f;
+        distortion.k4 = -0.0002f;
+    }
+    return distortion;
+}
+
+struct AlignCase {
+    const char             *name;
+    int                     depthWidth, depthHeight;
+    int                     colorWidth, colorHeight;
+    OBCameraDistortionModel model;
+    bool                    addTargetDistortion;
+    bool                    gapFillCopy;
+    bool                    useScale;
+    bool                    withSSE;
+};
+
+// Slanted planes from 0.3m to 5m with a few holes and invalid values, and depth steps so that pixels of different tiles collide on the target
+std::vector<uint16_t> makeDepth(int width, int height) {
+    uint32_t              seed = 7;
+    std::vector<uint16_t> depth(width * height);
+    for(int v = 0; v < height; v++) {
+        for(int u = 0; u < width; u++) {
+            uint32_t r     = nextRandom(seed);
+            uint16_t value = static_cast<uint16_t>(300 + (u * 7 + v * 3) % 4000 + r % 16);
+            if((v / 24) % 3 == 1 && (u / 40) % 2 == 0) {
+                value = static_cast<uint16_t>(value / 3);  // foreground occluding the background of the next tile
+            }
+            if(r % 29 == 0) {
+                value = 0;
+            }
+            else if(r % 97 == 0) {
+                value = 65535;
+            }
+            depth[v * width + u] = value;
+        }
+    }
+    return depth;
+}
+
+struct AlignOutput {
+    std::vector<uint16_t> depth;
+    std::vector<int>      map;
+    std::vector<uint8_t>  color;
+
+    bool operator==(const AlignOutput &other) const {
+        return depth == other.depth && map == other.map && color == other.color;
+    }
+};
+
+AlignOutput alignOnce(AlignImpl &impl, const AlignCase &alignCase, const std::vector<uint16_t> &depth, const std::vector<uint8_t> &color) {
+    AlignOutput output;
+    output.depth.assign(alignCase.colorWidth * alignCase.colorHeight, 0);
+    output.map.assign(2 * alignCase.depthWidth * alignCase.depthHeight, -1);
+    output.color.assign(3 * alignCase.depthWidth * alignCase.depthHeight, 0);
+    impl.D2C(depth.data(), alignCase.depthWidth, alignCase.depthHeight, output.depth.data(), alignCase.colorWidth, alignCase.colorHeight,
+             output.map.data(), alignCase.withSSE);
+    if(!alignCase.useScale) {
+        impl.C2D(depth.data(), alignCase.depthWidth, alignCase.depthHeight, color.data(), output.color.data(), alignCase.colorWidth,
+                 alignCase.colorHeight, OB_FORMAT_RGB, alignCase.withSSE);
+    }
+    return output;
+}
+
+void testAlignCase(const AlignCase &alignCase) {
+    OBCameraDistortion depthDisto;
+    memset(&depthDisto, 0, sizeof(depthDisto));
+    OBExtrinsic extrinsic = { { 0.9999f, -0.0087f, 0.0102f, 0.0088f, 0.9999f, -0.0041f, -0.0101f, 0.0042f, 0.9999f }, { -25.1f, 0.4f, 1.7f } };
+
+    AlignImpl impl;
+    impl.initialize(makeIntrinsic(alignCase.depthWidth, alignCase.depthHeight, 475.0f), depthDisto,
+                    makeIntrinsic(alignCase.colorWidth, alignCase.colorHeight, 690.0f * alignCase.colorWidth / 1280), makeDistortion(alignCase.model),
+                    extrinsic, 1.0f, alignCase.addTargetDistortion, alignCase.gapFillCopy, alignCase.useScale, OB_FORMAT_Y16, 65535);
+
+    auto                 depth = makeDepth(alignCase.depthWidth, alignCase.depthHeight);
+    uint32_t             seed  = 11;
+    std::vector<uint8_t> color(3 * alignCase.colorWidth * alignCase.colorHeight);
+    for(auto &value: color) {
+        value = static_cast<uint8_t>(nextRandom(seed));
+    }
+
+    auto reference = alignOnce(impl, alignCase, depth, color);
+    // not trivially equal: the target pixels get the depth of most of the depth pixels
+    size_t aligned = 0;
+    for(auto value: reference.depth) {
+        aligned += value != 0;
+    }
+    bool pass = aligned > depth.size() / 2;
+
+    for(auto threadCount: THREAD_COUNTS) {
+        impl.setThreadCount(threadCount);
+        auto tiled = alignOnce(impl, alignCase, depth, color);
+        if(!(tiled == reference)) {
+            std::printf("%s: %u threads differ from 1 thread\n", alignCase.name, threadCount);
+            pass = false;
+        }
+    }
+
+    // back to the calling thread
+    impl.setThreadCount(1);
+    pass = pass && alignOnce(impl, alignCase, depth, color) == reference;
+    obtest::report(alignCase.name, pass);
+}
+
+}  // namespace
+
+int main() {
+    const AlignCase cases[] = {
+        { "linear, gap fill copy, scalar", 640, 480, 1280, 720, OB_DISTORTION_NONE, false, true, false, false },
+        { "linear, gap fill nearest, scalar", 640, 480, 1280, 720, OB_DISTORTION_NONE, false, false, false, false },
+        { "K3, gap fill copy, scalar", 640, 480, 1280, 720, OB_DISTORTION_BROWN_CONRADY, true, true, false, false },
+        { "linear, gap fill copy, SSE", 640, 480, 1280, 720, OB_DISTORTION_NONE, false, true, false, true },
+        { "linear, gap fill nearest, SSE", 640, 480, 1280, 720, OB_DISTORTION_NONE, false, false, false, true },
+        { "K3, gap fill copy, SSE", 640, 480, 1280, 720, OB_DISTORTION_BROWN_CONRADY, true, true, false, true },
+        { "K3, gap fill nearest, SSE", 640, 480, 1280, 720, OB_DISTORTION_BROWN_CONRADY, true, false, false, true },
+        { "K6, gap fill nearest, SSE", 640, 480, 1280, 720, OB_DISTORTION_BROWN_CONRADY_K6, true, false, false, true },
+        { "KB4, gap fill nearest, SSE", 640, 480, 1280, 720, OB_DISTORTION_KANNALA_BRANDT4, true, false, false, true },
+        { "848x360 depth, K3, gap fill nearest, SSE", 848, 360, 1280, 720, OB_DISTORTION_BROWN_CONRADY, true, false, false, true },
+        { "848x360 depth, K3, gap fill nearest, scalar", 848, 360, 1280, 720, OB_DISTORTION_BROWN_CONRADY, true, false, false, false },
+        { "scaled down, gap fill copy, SSE", 640, 400, 1920, 1200, OB_DISTORTION_NONE, false, true, true, true },
+    };
+
+    for(const auto &alignCase: cases) {
+        testAlignCase(alignCase);
+    }
+
+    return obtest::result();
+}
+
+#else
+
+int main() {
+    std::printf("[CASE][SKIP] the tiled alignment is built with SSSE3 or NEON only\n");
+    return 0;
+}
+
+#endif  // __ARM_NEON__ || __NEON__ || __SSSE3__
@@ -0,0 +1,211 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Calibration snapshot (CalibrationSnapshot): the first cases check that the extrinsics, intrinsics and distortion read from the snapshot
+// by the stream profiles are the ones of the managers, that a registration is seen by the next read and that the snapshot is not rebuilt
+// otherwise, also with leaves of the extrinsics graph added and dropped between the snapshots and with reader threads running during the
+// registrations. The time per call is measured by ob_calibration_snapshot_benchmark.
+//
+// usage: calibration_snapshot_test
+
+#include "stream/CalibrationSnapshot.hpp"
+#include "stream/StreamExtrinsicsManager.hpp"
+#include "stream/StreamProfileFactory.hpp"
+#include "exception/ObException.hpp"
+#include "ObTestCase.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+std::shared_ptr<VideoStreamProfile> createProfile(OBStreamType type, uint32_t width) {
+    return StreamProfileFactory::createVideoStreamProfile(type, OB_FORMAT_Y16, width, 480, 30);
+}
+
+OBExtrinsic translation(float x, float y, float z) {
+    OBExtrinsic extrinsic = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { x, y, z } };
+    return extrinsic;
+}
+
+bool nearlyEqual(const OBExtrinsic &a, const OBExtrinsic &b) {
+    for(int i = 0; i < 9; i++) {
+        if(std::fabs(a.rot[i] - b.rot[i]) > 1e-5f) {
+            return false;
+        }
+    }
+    for(int i = 0; i < 3; i++) {
+        if(std::fabs(a.trans[i] - b.trans[i]) > 1e-3f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Depth -> color -> IR, left IR -> depth with a rotation, right IR same as left IR, an accel stream with no extrinsics
+struct Graph {
+    std::vector<std::shared_ptr<VideoStreamProfile>> profiles;
+    std::shared_ptr<VideoStreamProfile>              isolated;
+};
+
+Graph createGraph() {
+    Graph graph;
+    for(uint32_t i = 0; i < 5; i++) {
+        graph.profiles.push_back(createProfile(OB_STREAM_DEPTH, 640 + i));
+    }
+    auto       &p        = graph.profiles;
+    OBExtrinsic rotation = { { 0, -1, 0, 1, 0, 0, 0, 0, 1 }, { 1.5f, -2.0f, 3.0f } };
+    p[0]->bindExtrinsicTo(p[1], translation(10, 0, 0));
+    p[1]->bindExtrinsicTo(p[2], translation(0, 10, 0));
+    p[3]->bindExtrinsicTo(p[0], rotation);
+    p[4]->bindSameExtrinsicTo(p[3]);
+    graph.isolated = createProfile(OB_STREAM_COLOR, 1280);
+    graph.isolated->bindIntrinsic({ 1, 1, 1, 1, 1280, 480 });
+    return graph;
+}
+
+void testSameAsManager() {
+    auto graph   = createGraph();
+    auto manager = StreamExtrinsicsManager::getInstance();
+    bool pass    = true;
+    for(auto &from: graph.profiles) {
+        for(auto &to: graph.profiles) {
+            auto snapshotExtrinsic = from->getExtrinsicTo(to);
+            auto managerExtrinsic  = manager->getExtrinsics(from, to);
+            pass                   = pass && nearlyEqual(snapshotExtrinsic, managerExtrinsic);
+        }
+    }
+
+    OBCameraIntrinsic  intrinsic  = { 500.0f, 501.0f, 320.0f, 240.0f, 640, 480 };
+    OBCameraDistortion distortion = { 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.01f, 0.02f, OB_DISTORTION_BROWN_CONRADY };
+    graph.profiles[0]->bindIntrinsic(intrinsic);
+    graph.profiles[0]->bindDistortion(distortion);
+    auto readIntrinsic  = graph.profiles[0]->getIntrinsic();
+    auto readDistortion = graph.profiles[0]->getDistortion();
+    pass = pass && memcmp(&readIntrinsic, &intrinsic, sizeof(intrinsic)) == 0 && memcmp(&readDistortion, &distortion, sizeof(distortion)) == 0;
+
+    bool thrown = false;
+    try {
+        graph.profiles[0]->getExtrinsicTo(graph.isolated);
+    }
+    catch(const libobsensor_exception &) {
+        thrown = true;
+    }
+    pass   = pass && thrown;
+    thrown = false;
+    try {
+        graph.profiles[1]->getDistortion();
+    }
+    catch(const libobsensor_exception &) {
+        thrown = true;
+    }
+    obtest::report("profiles read the calibration of the managers, missing calibration still throws", pass && thrown);
+}
+
+void testRegistrationSeen() {
+    auto graph   = createGraph();
+    auto version = CalibrationSnapshot::get()->getVersion();
+    graph.profiles[0]->getExtrinsicTo(graph.profiles[2]);
+    graph.profiles[0]->getExtrinsicTo(graph.profiles[2]);
+    bool pass = CalibrationSnapshot::get()->getVersion() == version;  // reads do not rebuild the snapshot
+
+    // A new registration replaces all the extrinsics of the profile (StreamExtrinsicsManager), depth -> color is registered again
+    graph.profiles[0]->bindExtrinsicTo(graph.profiles[1], translation(20, 0, 0));
+    auto extrinsic = graph.profiles[0]->getExtrinsicTo(graph.profiles[2]);
+    pass           = pass && CalibrationSnapshot::get()->getVersion() != version && nearlyEqual(extrinsic, translation(20, 10, 0));
+
+    graph.profiles[2]->bindIntrinsic({ 1, 2, 3, 4, 640, 480 });
+    graph.profiles[2]->bindIntrinsic({ 5, 6, 7, 8, 640, 480 });
+    pass = pass && graph.profiles[2]->getIntrinsic().fx == 5;
+    obtest::report("registrations are seen by the next read, reads alone do not rebuild the snapshot", pass);
+}
+
+// Leaves added, dropped and bound again between the reads only update their rows and columns of the extrinsics table of the snapshot
+void testLeafChanges() {
+    auto                                             graph = createGraph();
+    std::vector<std::shared_ptr<VideoStreamProfile>> leaves;
+    for(uint32_t i = 0; i < 6; i++) {
+        leaves.push_back(createProfile(OB_STREAM_IR, 200 + i));
+        leaves.back()->bindExtrinsicTo(graph.profiles[i % 4], translation(static_cast<float>(i), 1, 0));
+        leaves.back()->getExtrinsicTo(graph.profiles[2]);  // a snapshot per registration
+    }
+    leaves[1].reset();
+    leaves[3].reset();
+    auto clone = graph.profiles[2]->clone();  // cleans the dropped leaves up
+    clone->getExtrinsicTo(graph.profiles[0]);
+    leaves[0]->bindExtrinsicTo(graph.profiles[1], translation(0, 0, 7));
+
+    std::vector<std::shared_ptr<const StreamProfile>> profiles(graph.profiles.begin(), graph.profiles.end());
+    for(auto &leaf: leaves) {
+        if(leaf) {
+            profiles.push_back(leaf);
+        }
+    }
+    profiles.push_back(clone);
+
+    // All the snapshot reads first, the extrinsics manager adds the edges it computed to the graph
+    std::vector<OBExtrinsic> snapshotExtrinsics;
+    for(auto &from: profiles) {
+        for(auto &to: profiles) {
+            snapshotExtrinsics.push_back(from->getExtrinsicTo(to));
+        }
+    }
+    auto   manager = StreamExtrinsicsManager::getInstance();
+    bool   pass    = true;
+    size_t index   = 0;
+    for(auto &from: profiles) {
+        for(auto &to: profiles) {
+            pass = pass && nearlyEqual(snapshotExtrinsics[index++], manager->getExtrinsics(from, to));
+        }
+    }
+    pass = pass && nearlyEqual(leaves[0]->getExtrinsicTo(graph.profiles[1]), translation(0, 0, 7));
+    obtest::report("leaves added, dropped and bound again update the snapshot", pass);
+}
+
+void testConcurrentReaders() {
+    auto graph = createGraph();
+    auto from  = graph.profiles[3];
+    auto to    = graph.profiles[2];
+    auto first = from->getExtrinsicTo(to);
+
+    std::atomic<bool>     stop(false);
+    std::atomic<uint32_t> wrong(0);
+    std::vector<std::thread> readers;
+    for(int i = 0; i < 3; i++) {
+        readers.emplace_back([&]() {
+            while(!stop.load()) {
+                if(!nearlyEqual(from->getExtrinsicTo(to), first)) {
+                    wrong++;
+                }
+            }
+        });
+    }
+    // Unrelated registrations rebuild the snapshot while the readers run
+    for(uint32_t i = 0; i < 200; i++) {
+        auto profile = createProfile(OB_STREAM_IR, 100 + i);
+        profile->bindIntrinsic({ 1, 1, 1, 1, 100, 100 });
+        profile->bindExtrinsicTo(graph.profiles[1], translation(static_cast<float>(i), 0, 0));
+    }
+    stop = true;
+    for(auto &reader: readers) {
+        reader.join();
+    }
+    obtest::report("reader threads see consistent extrinsics during registrations", wrong == 0);
+}
+
+}  // namespace
+
+int main() {
+    testSameAsManager();
+    testRegistrationSeen();
+    testLeafChanges();
+    testConcurrentReaders();
+
+    return obtest::result();
+}
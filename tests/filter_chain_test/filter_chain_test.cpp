@@ -0,0 +1,184 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// In place filter chains (FilterChain): the output of a chain of threshold, pixel value scaler and offset, mirror and flip filters must be
+// the same as the output of the filters called one after the other, for the formats the filters process in place. A probe filter then
+// checks that the in-place path is only taken for the frames held by the chain alone.
+//
+// usage: filter_chain_test
+
+#include "FilterChain.hpp"
+#include "FilterDecorator.hpp"
+#include "publicfilters/FramePixelValueProcess.hpp"
+#include "publicfilters/FrameGeometricTransform.hpp"
+#include "frame/FrameFactory.hpp"
+#include "stream/StreamProfileFactory.hpp"
+#include "ObTestCase.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t WIDTH  = 64;
+const uint32_t HEIGHT = 48;
+
+template <typename T> std::shared_ptr<IFilter> createFilter(const char *name) {
+    auto filter = std::make_shared<FilterDecorator>(name, std::make_shared<T>());
+    filter->enable(true);
+    return filter;
+}
+
+std::shared_ptr<Frame> createFrame(OBFrameType type, OBFormat format) {
+    auto frame      = FrameFactory::createVideoFrame(type, format, WIDTH, HEIGHT, 0);
+    auto streamType = type == OB_FRAME_DEPTH ? OB_STREAM_DEPTH : (type == OB_FRAME_IR ? OB_STREAM_IR : OB_STREAM_COLOR);
+    frame->setStreamProfile(StreamProfileFactory::createVideoStreamProfile(streamType, format, WIDTH, HEIGHT, 30));
+    auto data  = frame->getDataMutable();
+    for(size_t i = 0; i < frame->getDataSize(); i++) {
+        data[i] = static_cast<uint8_t>(i * 7 + i / 13);
+    }
+    return frame;
+}
+
+std::shared_ptr<Frame> processOneByOne(const std::vector<std::shared_ptr<IFilter>> &filters, std::shared_ptr<const Frame> frame) {
+    std::shared_ptr<Frame> result = std::const_pointer_cast<Frame>(frame);
+    for(const auto &filter: filters) {
+        result = filter->process(result);
+    }
+    return result;
+}
+
+bool sameFrames(std::shared_ptr<const Frame> a, std::shared_ptr<const Frame> b) {
+    if(!a || !b || a == b || a->getDataSize() != b->getDataSize() || memcmp(a->getData(), b->getData(), a->getDataSize()) != 0) {
+        return false;
+    }
+    auto va = a->tryAs<VideoFrame>();
+    auto vb = b->tryAs<VideoFrame>();
+    if(va->getPixelAvailableBitSize() != vb->getPixelAvailableBitSize()) {
+        return false;
+    }
+    auto da = a->tryAs<DepthFrame>();
+    auto db = b->tryAs<DepthFrame>();
+    return !da || da->getValueScale() == db->getValueScale();
+}
+
+void testDepthChain() {
+    auto threshold = createFilter<ThresholdFilter>("ThresholdFilter");
+    auto scaler    = createFilter<PixelValueScaler>("PixelValueScaler");
+    auto offset    = createFilter<PixelValueOffset>("PixelValueOffset");
+    threshold->setConfigValueSync("min", 100);
+    threshold->setConfigValueSync("max", 12000);
+    scaler->setConfigValueSync("scale", 0.5);
+    offset->setConfigValueSync("offset", 1);
+    std::vector<std::shared_ptr<IFilter>> filters = { threshold, scaler, offset, createFilter<FrameMirror>("FrameMirror"),
+                                                      createFilter<FrameFlip>("FrameFlip") };
+
+    auto depth    = createFrame(OB_FRAME_DEPTH, OB_FORMAT_Y16);
+    auto original = FrameFactory::createFrameFromOtherFrame(depth, true);
+    auto chained  = FilterChain::process(filters, depth);
+    bool pass     = sameFrames(chained, processOneByOne(filters, depth));
+    pass          = pass && memcmp(depth->getData(), original->getData(), depth->getDataSize()) == 0;
+    obtest::report("depth Y16 chain matches the filters called one by one and keeps the input", pass);
+}
+
+void testGeometricChain() {
+    std::vector<std::shared_ptr<IFilter>> filters = { createFilter<FrameMirror>("FrameMirror"), createFilter<FrameFlip>("FrameFlip"),
+                                                      createFilter<FrameMirror>("FrameMirror") };
+    struct {
+        OBFrameType type;
+        OBFormat    format;
+    } cases[] = { { OB_FRAME_IR, OB_FORMAT_Y8 },      { OB_FRAME_DEPTH, OB_FORMAT_Y12C4 }, { OB_FRAME_COLOR, OB_FORMAT_RGB },
+                  { OB_FRAME_COLOR, OB_FORMAT_BGRA }, { OB_FRAME_COLOR, OB_FORMAT_YUYV },  { OB_FRAME_COLOR, OB_FORMAT_UYVY },
+                  { OB_FRAME_IR, OB_FORMAT_YUYV } };
+    bool pass = true;
+    for(const auto &c: cases) {
+        auto frame = createFrame(c.type, c.format);
+        if(!sameFrames(FilterChain::process(filters, frame), processOneByOne(filters, frame))) {
+            std::printf("mirror/flip chain differs for frame type %d format %d\n", static_cast<int>(c.type), static_cast<int>(c.format));
+            pass = false;
+        }
+    }
+    obtest::report("mirror and flip chains match the filters called one by one for all formats", pass);
+}
+
+// Counts the calls, processes nothing
+class ProbeFilter : public IFilterBase {
+public:
+    void updateConfig(std::vector<std::string> &params) override {
+        (void)params;
+    }
+    void setConfigData(void *data, uint32_t size) override {
+        (void)data;
+        (void)size;
+    }
+    const std::string &getConfigSchema() const override {
+        static const std::string schema = "";
+        return schema;
+    }
+    void reset() override {}
+    bool isInPlaceCapable() const override {
+        return true;
+    }
+    std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override {
+        processCount++;
+        return FrameFactory::createFrameFromOtherFrame(frame, true);
+    }
+    bool processInPlace(std::shared_ptr<Frame> frame) override {
+        (void)frame;
+        inPlaceCount++;
+        return true;
+    }
+
+    int processCount = 0;
+    int inPlaceCount = 0;
+};
+
+// Keeps its last output, as SequenceIdFilter does
+class HoldingFilter : public ProbeFilter {
+public:
+    bool isInPlaceCapable() const override {
+        return false;
+    }
+    std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override {
+        last = FrameFactory::createFrameFromOtherFrame(frame, true);
+        return last;
+    }
+
+    std::shared_ptr<Frame> last;
+};
+
+void testInPlaceOnlyForUnsharedFrames() {
+    auto probe     = std::make_shared<ProbeFilter>();
+    auto probeExt  = std::make_shared<FilterDecorator>("Probe", probe);
+    auto threshold = createFilter<ThresholdFilter>("ThresholdFilter");
+    auto holding   = std::make_shared<FilterDecorator>("Holding", std::make_shared<HoldingFilter>());
+    auto depth     = createFrame(OB_FRAME_DEPTH, OB_FORMAT_Y16);
+
+    FilterChain::process({ probeExt }, depth);
+    bool pass = probe->processCount == 1 && probe->inPlaceCount == 0;  // the input frame is the caller's
+
+    FilterChain::process({ threshold, probeExt }, depth);
+    pass = pass && probe->processCount == 1 && probe->inPlaceCount == 1;
+
+    FilterChain::process({ holding, probeExt }, depth);
+    pass = pass && probe->processCount == 2 && probe->inPlaceCount == 1;  // the output of holding is also held by it
+
+    probeExt->enable(false);
+    auto result = FilterChain::process({ threshold, probeExt }, depth);
+    pass        = pass && probe->processCount == 2 && probe->inPlaceCount == 1 && result;
+    obtest::report("filters run in place only on the frames held by the chain alone, disabled filters are skipped", pass);
+}
+
+}  // namespace
+
+int main() {
+    testDepthChain();
+    testGeometricChain();
+    testInPlaceOnlyForUnsharedFrames();
+
+    return obtest::result();
+}
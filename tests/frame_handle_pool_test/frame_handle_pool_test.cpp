@@ -0,0 +1,116 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Frame handles (ob_frame) and frame objects of the c++ wrapper (ob::makeFrame): a depth and color frameset is delivered the way the
+// pipeline does (frameset handle, ob::FrameSet, the depth and color frames taken and converted with as<T>()) and the heap allocations
+// of the process are counted (global operator new of this program). The cases check that no allocation is left per delivered frameset
+// once the free lists are filled, also when the frames are released on another thread. The allocations and the time per frameset are
+// measured by ob_frame_handle_pool_benchmark.
+//
+// usage: frame_handle_pool_test
+
+#include "libobsensor/ObSensor.hpp"
+#include "ObTestCase.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+std::atomic<uint64_t> allocationCount(0);
+}  // namespace
+
+void *operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void *ptr = std::malloc(size ? size : 1);
+    if(!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+const uint32_t WARM_UP_FRAMESETS = 64;
+
+struct DeliveredFrameSet {
+    std::shared_ptr<ob::FrameSet>   frameSet;
+    std::shared_ptr<ob::DepthFrame> depth;
+    std::shared_ptr<ob::ColorFrame> color;
+};
+
+// frameset: the internal frameset, a new handle of it is delivered as ob_pipeline_wait_for_frameset does
+DeliveredFrameSet deliver(ob_frame *frameset) {
+    ob_frame_add_ref(frameset, nullptr);
+
+    DeliveredFrameSet delivered;
+    delivered.frameSet = ob::makeFrame<ob::FrameSet>(frameset);
+    delivered.depth    = delivered.frameSet->getFrame(OB_FRAME_DEPTH)->as<ob::DepthFrame>();
+    delivered.color    = delivered.frameSet->getFrame(OB_FRAME_COLOR)->as<ob::ColorFrame>();
+    return delivered;
+}
+
+double allocationsPerFrameSet(ob_frame *frameset, uint32_t count) {
+    for(uint32_t i = 0; i < WARM_UP_FRAMESETS; i++) {
+        deliver(frameset);
+    }
+    uint64_t before = allocationCount.load();
+    for(uint32_t i = 0; i < count; i++) {
+        deliver(frameset);
+    }
+    return static_cast<double>(allocationCount.load() - before) / count;
+}
+
+}  // namespace
+
+int main() {
+    ob_frame *frameset = ob_create_frameset(nullptr);
+    ob_frame *depth    = ob_create_video_frame(OB_FRAME_DEPTH, OB_FORMAT_Y16, 640, 480, 0, nullptr);
+    ob_frame *color    = ob_create_video_frame(OB_FRAME_COLOR, OB_FORMAT_RGB, 1280, 720, 0, nullptr);
+    ob_frameset_push_frame(frameset, depth, nullptr);
+    ob_frameset_push_frame(frameset, color, nullptr);
+    ob_delete_frame(depth, nullptr);
+    ob_delete_frame(color, nullptr);
+
+    {
+        auto delivered = deliver(frameset);
+        obtest::report("delivered frames", delivered.depth->getWidth() == 640 && delivered.depth->getHeight() == 480
+                                               && delivered.color->getWidth() == 1280 && delivered.color->getHeight() == 720
+                                               && delivered.frameSet->getCount() == 2);
+    }
+
+    obtest::report("no allocation per delivered frameset", allocationsPerFrameSet(frameset, 1000) == 0.0);
+
+    {
+        // Frames kept by the user and released on another thread: the free lists are shared by all the threads
+        std::vector<DeliveredFrameSet> kept;
+        for(uint32_t i = 0; i < 32; i++) {
+            kept.push_back(deliver(frameset));
+        }
+        std::thread releaser([&kept]() { kept.clear(); });
+        releaser.join();
+
+        uint64_t before = allocationCount.load();
+        for(uint32_t i = 0; i < 32; i++) {
+            kept.push_back(deliver(frameset));
+        }
+        obtest::report("frames released on another thread are reused", allocationCount.load() == before);
+        kept.clear();
+    }
+
+    ob_delete_frame(frameset, nullptr);
+
+    return obtest::result();
+}
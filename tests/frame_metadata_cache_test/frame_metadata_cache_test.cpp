@@ -0,0 +1,105 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Cached frame metadata: the parsers of a FrameMetadataParserContainer count their calls, the cases check that each type is parsed once per
+// frame, that the cache is reset when the metadata changes, that the errors of the former uncached lookups are kept and that
+// getAllMetadataValue() returns the same values as getMetadataValue().
+//
+// usage: frame_metadata_cache_test
+
+#include "FrameMetadataParserContainer.hpp"
+#include "frame/FrameFactory.hpp"
+#include "ObTestCase.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+using namespace libobsensor;
+
+namespace {
+
+// Value: the metadata byte at offset, supported if the metadata reaches it
+class CountingParser : public IFrameMetadataParser {
+public:
+    explicit CountingParser(size_t offset) : offset_(offset), calls(0) {}
+
+    int64_t getValue(const uint8_t *metadata, size_t dataSize) override {
+        calls++;
+        if(!isSupported(metadata, dataSize)) {
+            THROW_UNSUPPORTED_OPERATION_EXCEPTION("unsupported metadata");
+        }
+        return metadata[offset_];
+    }
+
+    bool isSupported(const uint8_t *metadata, size_t dataSize) override {
+        (void)metadata;
+        return dataSize > offset_;
+    }
+
+private:
+    size_t offset_;
+
+public:
+    int calls;
+};
+
+bool throwsOnGet(std::shared_ptr<Frame> frame, OBFrameMetadataType type) {
+    try {
+        frame->getMetadataValue(type);
+    }
+    catch(const libobsensor_exception &) {
+        return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+int main() {
+    auto container = std::make_shared<FrameMetadataParserContainer>(nullptr);
+    auto timestamp = std::make_shared<CountingParser>(0);
+    auto exposure  = std::make_shared<CountingParser>(1);
+    auto gain      = std::make_shared<CountingParser>(8);  // past the metadata of the frame
+    container->registerParser(OB_FRAME_METADATA_TYPE_TIMESTAMP, timestamp);
+    container->registerParser(OB_FRAME_METADATA_TYPE_EXPOSURE, exposure);
+    container->registerParser(OB_FRAME_METADATA_TYPE_GAIN, gain);
+
+    auto          frame      = FrameFactory::createFrame(OB_FRAME_DEPTH, OB_FORMAT_Y16, 16);
+    const uint8_t metadata[] = { 10, 20, 30, 40 };
+    frame->updateMetadata(metadata, sizeof(metadata));
+    frame->registerMetadataParsers(container);
+
+    bool pass = true;
+    for(int i = 0; i < 10; i++) {
+        pass = pass && frame->hasMetadata(OB_FRAME_METADATA_TYPE_TIMESTAMP) && frame->getMetadataValue(OB_FRAME_METADATA_TYPE_TIMESTAMP) == 10
+               && frame->getMetadataValue(OB_FRAME_METADATA_TYPE_EXPOSURE) == 20;
+    }
+    obtest::report("values parsed once per frame", pass && timestamp->calls == 1 && exposure->calls == 1);
+
+    pass = !frame->hasMetadata(OB_FRAME_METADATA_TYPE_GAIN) && !frame->hasMetadata(OB_FRAME_METADATA_TYPE_WHITE_BALANCE)
+           && throwsOnGet(frame, OB_FRAME_METADATA_TYPE_GAIN) && throwsOnGet(frame, OB_FRAME_METADATA_TYPE_WHITE_BALANCE) && gain->calls == 0;
+    obtest::report("unregistered and absent types", pass);
+
+    int64_t  values[OB_FRAME_METADATA_TYPE_COUNT];
+    uint64_t mask     = frame->getAllMetadataValue(values, OB_FRAME_METADATA_TYPE_COUNT);
+    uint64_t expected = (1ull << OB_FRAME_METADATA_TYPE_TIMESTAMP) | (1ull << OB_FRAME_METADATA_TYPE_EXPOSURE);
+    pass              = mask == expected && values[OB_FRAME_METADATA_TYPE_TIMESTAMP] == 10 && values[OB_FRAME_METADATA_TYPE_EXPOSURE] == 20
+           && values[OB_FRAME_METADATA_TYPE_GAIN] == 0;
+    obtest::report("all values at once", pass && timestamp->calls == 1);
+
+    const uint8_t newMetadata[] = { 11, 21, 31, 41, 51, 61, 71, 81, 91 };
+    frame->updateMetadata(newMetadata, sizeof(newMetadata));
+    obtest::report("cache reset on metadata update", frame->getMetadataValue(OB_FRAME_METADATA_TYPE_TIMESTAMP) == 11
+                                                         && frame->getMetadataValue(OB_FRAME_METADATA_TYPE_GAIN) == 91 && timestamp->calls == 2);
+
+    frame->getMetadataMutable()[0] = 12;
+    obtest::report("cache reset on mutable metadata access", frame->getMetadataValue(OB_FRAME_METADATA_TYPE_TIMESTAMP) == 12);
+
+    auto copy = FrameFactory::createFrame(OB_FRAME_DEPTH, OB_FORMAT_Y16, 16);
+    copy->copyInfoFromOther(frame);
+    obtest::report("copied frame", copy->getMetadataValue(OB_FRAME_METADATA_TYPE_EXPOSURE) == 21
+                                       && copy->getAllMetadataValue(values, OB_FRAME_METADATA_TYPE_EXPOSURE + 1) == expected);
+
+    return obtest::result();
+}
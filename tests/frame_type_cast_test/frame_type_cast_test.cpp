@@ -0,0 +1,79 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Frame::is<T>() / as<T>() on the class bits: the class bits of the frames of each type must give the same answers as a dynamic_cast, as<T>()
+// must share the ownership of the frame and throw for the other classes.
+//
+// usage: frame_type_cast_test
+
+#include "frame/FrameFactory.hpp"
+#include "frame/Frame.hpp"
+#include "ObTestCase.hpp"
+
+#include <cstdio>
+#include <memory>
+
+using namespace libobsensor;
+
+namespace {
+
+template <typename T> bool sameAsDynamicCast(const std::shared_ptr<Frame> &frame) {
+    bool expected = dynamic_cast<const T *>(frame.get()) != nullptr;
+    if(frame->is<T>() != expected || frame->is<const T>() != expected) {
+        return false;
+    }
+    if((frame->tryAs<T>() != nullptr) != expected || (frame->tryAs<T>() != nullptr && frame->tryAs<T>() != dynamic_cast<T *>(frame.get()))) {
+        return false;
+    }
+    std::shared_ptr<const Frame> constFrame = frame;
+    return (constFrame->tryAs<T>() != nullptr) == expected;
+}
+
+bool allClassesMatch(const std::shared_ptr<Frame> &frame) {
+    return sameAsDynamicCast<Frame>(frame) && sameAsDynamicCast<VideoFrame>(frame) && sameAsDynamicCast<ColorFrame>(frame)
+           && sameAsDynamicCast<ColorLeftFrame>(frame) && sameAsDynamicCast<ColorRightFrame>(frame) && sameAsDynamicCast<DepthFrame>(frame)
+           && sameAsDynamicCast<ConfidenceFrame>(frame) && sameAsDynamicCast<IRFrame>(frame) && sameAsDynamicCast<IRLeftFrame>(frame)
+           && sameAsDynamicCast<IRRightFrame>(frame) && sameAsDynamicCast<PointsFrame>(frame) && sameAsDynamicCast<AccelFrame>(frame)
+           && sameAsDynamicCast<GyroFrame>(frame) && sameAsDynamicCast<ImuBatchFrame>(frame) && sameAsDynamicCast<LiDARPointsFrame>(frame)
+           && sameAsDynamicCast<FrameSet>(frame);
+}
+
+void testClassBits() {
+    const OBFrameType types[] = { OB_FRAME_VIDEO,      OB_FRAME_IR,        OB_FRAME_COLOR,     OB_FRAME_DEPTH,     OB_FRAME_ACCEL,
+                                  OB_FRAME_SET,        OB_FRAME_POINTS,    OB_FRAME_GYRO,      OB_FRAME_IR_LEFT,   OB_FRAME_IR_RIGHT,
+                                  OB_FRAME_CONFIDENCE, OB_FRAME_COLOR_LEFT, OB_FRAME_COLOR_RIGHT, OB_FRAME_IMU_BATCH, OB_FRAME_LIDAR_POINTS };
+    bool pass = true;
+    for(auto type: types) {
+        auto frame = FrameFactory::createFrame(type, OB_FORMAT_UNKNOWN, 64);
+        if(!allClassesMatch(frame)) {
+            std::printf("class bits of frame type %d differ from dynamic_cast\n", static_cast<int>(type));
+            pass = false;
+        }
+    }
+    obtest::report("is<T>() and tryAs<T>() match dynamic_cast for all frame types and classes", pass);
+}
+
+void testAs() {
+    auto depth      = FrameFactory::createFrame(OB_FRAME_DEPTH, OB_FORMAT_Y16, 64);
+    auto video      = depth->as<VideoFrame>();
+    bool pass       = video.get() == dynamic_cast<VideoFrame *>(depth.get()) && depth.use_count() == 2;
+    bool threw      = false;
+    try {
+        depth->as<AccelFrame>();
+    }
+    catch(const libobsensor_exception &) {
+        threw = true;
+    }
+    std::shared_ptr<const Frame> constDepth = depth;
+    pass = pass && threw && constDepth->as<DepthFrame>().get() == depth.get();
+    obtest::report("as<T>() shares the frame ownership and throws for other classes", pass);
+}
+
+}  // namespace
+
+int main() {
+    testClassBits();
+    testAs();
+
+    return obtest::result();
+}
@@ -0,0 +1,140 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Frame views (FrameFactory::createFrameView): the view reads the data of its source frame in place and keeps it alive, has its own
+// metadata, and copies the data on its first getDataMutable() or replaces it on updateData() without touching the source frame. A view of a
+// view holds the frame owning the data, not the middle view.
+//
+// usage: frame_view_test
+
+#include "frame/FrameFactory.hpp"
+#include "frame/Frame.hpp"
+#include "ObTestCase.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t WIDTH  = 64;
+const uint32_t HEIGHT = 48;
+
+std::shared_ptr<Frame> createDepthFrame(uint8_t fill) {
+    auto frame = FrameFactory::createVideoFrame(OB_FRAME_DEPTH, OB_FORMAT_Y16, WIDTH, HEIGHT, 0);
+    memset(frame->getDataMutable(), fill, frame->getDataSize());
+    frame->setNumber(7);
+    frame->setTimeStampUsec(123456);
+    frame->as<DepthFrame>()->setValueScale(0.5f);
+    const uint8_t metadata[] = { 1, 2, 3, 4 };
+    frame->updateMetadata(metadata, sizeof(metadata));
+    return frame;
+}
+
+void testSharesData() {
+    auto source = createDepthFrame(0x11);
+    auto view   = FrameFactory::createFrameView(source);
+    bool pass   = view->getData() == source->getData() && view->isDataShared() && view->getDataSize() == source->getDataSize();
+    pass        = pass && view->is<DepthFrame>() && view->getNumber() == 7 && view->getTimeStampUsec() == 123456;
+    pass        = pass && view->as<DepthFrame>()->getValueScale() == 0.5f && view->as<VideoFrame>()->getWidth() == WIDTH;
+    pass        = pass && view->as<VideoFrame>()->getStride() == source->as<VideoFrame>()->getStride();
+    pass        = pass && view->getStreamProfile() == source->getStreamProfile();
+    obtest::report("view reads the data of the source frame and has its info", pass);
+}
+
+void testOwnMetadata() {
+    auto          source     = createDepthFrame(0x11);
+    auto          view       = FrameFactory::createFrameView(source);
+    const uint8_t metadata[] = { 9, 9 };
+    view->updateMetadata(metadata, sizeof(metadata));
+    view->setNumber(8);
+    bool pass = source->getMetadataSize() == 4 && source->getMetadata()[0] == 1 && source->getNumber() == 7 && view->isDataShared();
+    obtest::report("metadata and info changes of the view do not copy the data nor change the source", pass);
+}
+
+void testCopyOnWrite() {
+    auto source = createDepthFrame(0x11);
+    auto view   = FrameFactory::createFrameView(source);
+    auto data   = view->getDataMutable();
+    bool pass   = data != source->getData() && !view->isDataShared() && data[0] == 0x11 && data[view->getDataSize() - 1] == 0x11;
+    memset(data, 0x22, view->getDataSize());
+    pass = pass && source->getData()[0] == 0x11 && view->getData()[0] == 0x22 && view->getDataMutable() == data;
+    obtest::report("getDataMutable() copies the data once and leaves the source unchanged", pass);
+}
+
+void testUpdateData() {
+    auto                 source = createDepthFrame(0x11);
+    auto                 view   = FrameFactory::createFrameView(source);
+    std::vector<uint8_t> data(16, 0x33);
+    view->updateData(data.data(), data.size());
+    bool pass = !view->isDataShared() && view->getDataSize() == 16 && view->getData()[15] == 0x33 && source->getData()[0] == 0x11;
+    obtest::report("updateData() replaces the shared data without changing the source", pass);
+}
+
+void testKeepsSourceAlive() {
+    auto                 source     = createDepthFrame(0x44);
+    std::weak_ptr<Frame> weakSource = source;
+    auto                 view       = FrameFactory::createFrameView(source);
+    source.reset();
+    bool pass = !weakSource.expired() && view->getData()[0] == 0x44;
+    auto shared = view->getData();
+    view->getDataMutable();
+    pass = pass && !weakSource.expired() && shared[0] == 0x44 && view->getData() != shared && view->getData()[0] == 0x44;
+    view.reset();
+    pass = pass && weakSource.expired();
+    obtest::report("view keeps the source frame while it lives, also after copying the data", pass);
+}
+
+void testViewOfView() {
+    bool reclaimed = false;
+    auto buffer    = new uint8_t[WIDTH * HEIGHT * 2];
+    memset(buffer, 0x66, WIDTH * HEIGHT * 2);
+    auto source = FrameFactory::createVideoFrameFromUserBuffer(OB_FRAME_DEPTH, OB_FORMAT_Y16, WIDTH, HEIGHT, 0, buffer, WIDTH * HEIGHT * 2,
+                                                               [buffer, &reclaimed]() {
+                                                                   delete[] buffer;
+                                                                   reclaimed = true;
+                                                               });
+    auto middle = FrameFactory::createFrameView(source);
+    auto child  = FrameFactory::createFrameView(middle);
+    source.reset();
+
+    // The middle view copies its data and drops its reference: the child must still hold the buffer of the source
+    memset(middle->getDataMutable(), 0x77, middle->getDataSize());
+    bool pass = child->getData() == buffer && child->isDataShared() && !reclaimed && child->getData()[0] == 0x66;
+    middle.reset();
+    pass = pass && !reclaimed && child->getData()[WIDTH * HEIGHT * 2 - 1] == 0x66;
+    child.reset();
+    pass = pass && reclaimed;
+    obtest::report("view of a view holds the owner of the data when the middle view copies it", pass);
+}
+
+void testFrameSet() {
+    auto frameSet = FrameFactory::createFrameSet();
+    auto depth    = createDepthFrame(0x55);
+    auto color    = FrameFactory::createVideoFrame(OB_FRAME_COLOR, OB_FORMAT_RGB, WIDTH, HEIGHT, 0);
+    frameSet->pushFrame(depth);
+    frameSet->pushFrame(color);
+    auto view      = FrameFactory::createFrameView(frameSet)->as<FrameSet>();
+    auto viewDepth = view->getFrame(OB_FRAME_DEPTH);
+    auto viewColor = view->getFrame(OB_FRAME_COLOR);
+    bool pass      = view->getCount() == 2 && viewDepth && viewColor && viewDepth != depth && viewDepth->getData() == depth->getData()
+                && viewColor->getData() == color->getData() && viewDepth->isDataShared();
+    obtest::report("frameset view holds views of the frames", pass);
+}
+
+}  // namespace
+
+int main() {
+    testSharesData();
+    testOwnMetadata();
+    testCopyOnWrite();
+    testUpdateData();
+    testKeepsSourceAlive();
+    testViewOfView();
+    testFrameSet();
+
+    return obtest::result();
+}
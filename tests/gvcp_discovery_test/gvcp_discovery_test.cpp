@@ -0,0 +1,297 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Device discovery of the GVCP discovery engine (GVCPDiscoveryEngine). A loopback responder plays the network devices: it answers each
+// discovery command with one discovery ack per device, optionally repeated and with foreign manufacturers. The engine sends the discovery to
+// the responder from two local sockets (two "interfaces") and collects the replies on one thread. The cases check the parsed devices, the
+// deduplication of repeated replies and of a device seen from both interfaces, the filtering of foreign devices, the change events between
+// two discoveries and the duration of a discovery of many devices.
+//
+// usage: gvcp_discovery_test
+
+#include "ethernet/gvcp/GVCPDiscoveryEngine.hpp"
+#include "common/DeviceSeriesInfo.hpp"
+#include "common/CommonFields.hpp"
+#include "utils/Utils.hpp"
+#include "ObTestCase.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint16_t RESPONDER_PORT  = 26500;
+const char    *LOOPBACK        = "127.0.0.1";
+const char    *MANUFACTURER    = "Orbbec";
+const char    *DEVICE_SUBNET   = "192.168.1.";
+const uint32_t IDLE_TIMEOUT_MS = 200;
+
+struct Device {
+    uint8_t     id;
+    std::string manufacturer;
+};
+
+std::string deviceMac(uint8_t id) {
+    char mac[18];
+    snprintf(mac, sizeof(mac), "54:14:FD:00:00:%02X", id);
+    return mac;
+}
+
+std::string deviceIp(uint8_t id) {
+    return DEVICE_SUBNET + std::to_string(10 + id);
+}
+
+std::string deviceSn(uint8_t id) {
+    return "CP" + std::to_string(1000 + id);
+}
+
+uint32_t devicePid(uint8_t id) {
+    return 0x0800u + id;
+}
+
+// The string fields of the ack are zero padded, not zero terminated when full
+template <size_t N> void copyField(char (&field)[N], const std::string &value) {
+    memcpy(field, value.c_str(), std::min(N, value.size()));
+}
+
+std::vector<Device> orbbecDevices(uint8_t first, uint8_t count) {
+    std::vector<Device> devices;
+    for(uint8_t id = first; id < first + count; id++) {
+        devices.push_back({ id, MANUFACTURER });
+    }
+    return devices;
+}
+
+// Answers the discovery commands on 127.0.0.1:RESPONDER_PORT with one ack per device
+class LoopbackGVCPResponder {
+public:
+    LoopbackGVCPResponder() : stop_(false), repeat_(1) {
+        socket_ = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port   = htons(RESPONDER_PORT);
+        inet_pton(AF_INET, LOOPBACK, &addr.sin_addr);
+        bind(socket_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+        thread_ = std::thread(&LoopbackGVCPResponder::run, this);
+    }
+
+    ~LoopbackGVCPResponder() {
+        stop_ = true;
+        thread_.join();
+        closesocket(socket_);
+    }
+
+    void setDevices(const std::vector<Device> &devices, int repeat = 1) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        devices_ = devices;
+        repeat_  = repeat;
+    }
+
+private:
+    void run() {
+        while(!stop_) {
+            fd_set readfs;
+            FD_ZERO(&readfs);
+            FD_SET(socket_, &readfs);
+            timeval timeout{ 0, 50000 };
+            if(select(static_cast<int>(socket_) + 1, &readfs, nullptr, nullptr, &timeout) <= 0) {
+                continue;
+            }
+
+            gvcp_discover_cmd cmd;
+            sockaddr_in       src{};
+            socklen_t         srcLen = sizeof(src);
+            auto size = recvfrom(socket_, reinterpret_cast<char *>(&cmd), sizeof(cmd), 0, reinterpret_cast<sockaddr *>(&src), &srcLen);
+            if(size != static_cast<int>(sizeof(cmd)) || ntohs(cmd.header.wCmd) != GVCP_DISCOVERY_CMD) {
+                continue;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            for(int n = 0; n < repeat_; n++) {
+                for(auto &device: devices_) {
+                    auto ack = makeAck(device, cmd.header.wReqID);
+                    sendto(socket_, reinterpret_cast<const char *>(&ack), sizeof(ack), 0, reinterpret_cast<const sockaddr *>(&src), srcLen);
+                }
+            }
+        }
+    }
+
+    static gvcp_discover_ack makeAck(const Device &device, uint16_t reqID) {
+        gvcp_discover_ack ack;
+        memset(&ack, 0, sizeof(ack));
+        ack.header.wStatus = htons(GEV_STATUS_SUCCESS);
+        ack.header.wAck    = htons(GVCP_DISCOVERY_ACK);
+        ack.header.wLen    = htons(sizeof(ack.payload));
+        ack.header.wReqID  = reqID;
+
+        auto &payload = ack.payload;
+        uint8_t mac[8] = { 0, 0, 0x54, 0x14, 0xFD, 0, 0, device.id };
+        memcpy(payload.Mac, mac, sizeof(mac));
+        inet_pton(AF_INET, deviceIp(device.id).c_str(), &payload.CurIP[12]);
+        inet_pton(AF_INET, "255.255.255.0", &payload.SubMask[12]);
+        inet_pton(AF_INET, "192.168.1.1", &payload.Gateway[12]);
+        payload.dwPID      = htonl(devicePid(device.id));
+        payload.dwCurIpSet = htonl(0x05);
+        copyField(payload.szFacName, device.manufacturer);
+        copyField(payload.szModelName, "Orbbec Test Camera");
+        copyField(payload.szDevVer, "1.2.3");
+        copyField(payload.szSerial, deviceSn(device.id));
+        copyField(payload.szUserName, "user");
+        return ack;
+    }
+
+    SOCKET              socket_;
+    std::thread         thread_;
+    std::atomic<bool>   stop_;
+    std::mutex          mutex_;
+    std::vector<Device> devices_;
+    int                 repeat_;
+};
+
+// Two local sockets: a loopback "interface" and one on the subnet of the devices, both reach the responder over the loopback
+class Interfaces {
+public:
+    Interfaces() {
+        infos_.push_back(open(LOOPBACK, 8, "lo"));
+        infos_.push_back(open("192.168.1.2", 24, "eth0"));
+    }
+
+    ~Interfaces() {
+        for(auto &info: infos_) {
+            closesocket(info.sock);
+        }
+    }
+
+    const std::vector<GVCPSocketInfo> &infos() const {
+        return infos_;
+    }
+
+private:
+    static GVCPSocketInfo open(const char *address, uint8_t subnetLength, const char *name) {
+        GVCPSocketInfo info;
+        info.sock = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        inet_pton(AF_INET, LOOPBACK, &addr.sin_addr);
+        bind(info.sock, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+        info.address          = address;
+        info.subnetLength     = subnetLength;
+        info.netInterfaceName = name;
+        return info;
+    }
+
+    std::vector<GVCPSocketInfo> infos_;
+};
+
+std::vector<GVCPDeviceInfo> discover(GVCPDiscoveryEngine &engine, const Interfaces &interfaces) {
+    uint32_t destAddress = 0;
+    inet_pton(AF_INET, LOOPBACK, &destAddress);
+    return engine.discover(interfaces.infos(), RESPONDER_PORT, destAddress);
+}
+
+bool checkDevice(const GVCPDeviceInfo &info, uint8_t id) {
+    return info.mac == deviceMac(id) && info.ip == deviceIp(id) && info.mask == "255.255.255.0" && info.gateway == "192.168.1.1"
+           && info.sn == deviceSn(id) && info.pid == devicePid(id) && info.vid == ORBBEC_DEVICE_VID && info.devVersion == "1.2.3"
+           && info.curIpConfig == 0x05 && info.userName == "user" && info.localIp == "192.168.1.2" && info.netInterfaceName == "eth0";
+}
+
+bool checkDevices(const std::vector<GVCPDeviceInfo> &infos, uint8_t first, uint8_t count) {
+    if(infos.size() != count) {
+        return false;
+    }
+    for(uint8_t i = 0; i < count; i++) {
+        if(!checkDevice(infos[i], static_cast<uint8_t>(first + i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testDiscover(LoopbackGVCPResponder &responder, const Interfaces &interfaces) {
+    GVCPDiscoveryEngine engine;
+    engine.setIdleTimeout(IDLE_TIMEOUT_MS);
+    responder.setDevices(orbbecDevices(1, 3));
+    // each device replies to both interfaces, the one on its subnet is kept
+    obtest::report("discover devices from two interfaces", checkDevices(discover(engine, interfaces), 1, 3));
+}
+
+void testDuplicate(LoopbackGVCPResponder &responder, const Interfaces &interfaces) {
+    GVCPDiscoveryEngine engine;
+    engine.setIdleTimeout(IDLE_TIMEOUT_MS);
+    responder.setDevices(orbbecDevices(1, 3), 3);
+    obtest::report("repeated replies", checkDevices(discover(engine, interfaces), 1, 3));
+}
+
+void testForeign(LoopbackGVCPResponder &responder, const Interfaces &interfaces) {
+    GVCPDiscoveryEngine engine;
+    engine.setIdleTimeout(IDLE_TIMEOUT_MS);
+    auto devices = orbbecDevices(1, 2);
+    devices.push_back({ 3, "Foreign Vendor" });
+    responder.setDevices(devices);
+    obtest::report("foreign manufacturer", checkDevices(discover(engine, interfaces), 1, 2));
+}
+
+void testChangeEvents(LoopbackGVCPResponder &responder, const Interfaces &interfaces) {
+    GVCPDiscoveryEngine         engine;
+    std::vector<GVCPDeviceInfo> removed;
+    std::vector<GVCPDeviceInfo> added;
+    int                         events = 0;
+    engine.setIdleTimeout(IDLE_TIMEOUT_MS);
+    engine.setDeviceChangedCallback([&](const std::vector<GVCPDeviceInfo> &removedDevices, const std::vector<GVCPDeviceInfo> &addedDevices) {
+        removed = removedDevices;
+        added   = addedDevices;
+        events++;
+    });
+
+    responder.setDevices(orbbecDevices(1, 3));
+    discover(engine, interfaces);
+    bool pass = events == 1 && removed.empty() && added.size() == 3;
+
+    discover(engine, interfaces);
+    pass = pass && events == 1;  // no change, no event
+
+    auto devices = orbbecDevices(1, 2);
+    devices.push_back({ 4, MANUFACTURER });
+    responder.setDevices(devices);
+    auto infos = discover(engine, interfaces);
+    pass       = pass && events == 2 && removed.size() == 1 && checkDevice(removed[0], 3) && added.size() == 1 && checkDevice(added[0], 4);
+    pass       = pass && infos.size() == 3 && checkDevice(infos[2], 4);
+    obtest::report("change events", pass);
+}
+
+void testManyDevices(LoopbackGVCPResponder &responder, const Interfaces &interfaces) {
+    const uint8_t       count = 64;
+    GVCPDiscoveryEngine engine;
+    engine.setIdleTimeout(IDLE_TIMEOUT_MS);
+    responder.setDevices(orbbecDevices(1, count));
+
+    utils::Timer timer;
+    auto         infos = discover(engine, interfaces);
+    auto         ms    = timer.touchMs();
+    std::printf("discovered %u devices in %u ms (idle timeout %u ms)\n", static_cast<uint32_t>(infos.size()), static_cast<uint32_t>(ms), IDLE_TIMEOUT_MS);
+    obtest::report("many devices", checkDevices(infos, 1, count));
+}
+
+}  // namespace
+
+int main() {
+    manufacturerVidMap[MANUFACTURER] = ORBBEC_DEVICE_VID;
+
+    LoopbackGVCPResponder responder;
+    Interfaces            interfaces;
+    testDiscover(responder, interfaces);
+    testDuplicate(responder, interfaces);
+    testForeign(responder, interfaces);
+    testChangeEvents(responder, interfaces);
+    testManyDevices(responder, interfaces);
+
+    return obtest::result();
+}
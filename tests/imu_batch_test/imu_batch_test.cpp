@@ -0,0 +1,198 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Per-sample versus batched delivery of the IMU samples (ImuStreamer). A fake data stream port plays the device and hands HID packets of
+// accel and gyro samples to the streamer, which either delivers one accel and one gyro frame per sample or one ImuBatchFrame per packet and
+// stream. Both paths must deliver the same values. The CPU time of both paths is measured by ob_imu_batch_benchmark.
+//
+// usage: imu_batch_test
+
+#include "ImuStreamer.hpp"
+#include "stream/StreamProfileFactory.hpp"
+#include "frame/Frame.hpp"
+#include "ObTestCase.hpp"
+
+#include <cstdio>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t LEADING_SAMPLES = 8;  // discarded by the streamer at start
+
+class FakeImuPort : public IDataStreamPort {
+public:
+    std::shared_ptr<const SourcePortInfo> getSourcePortInfo() const override {
+        return nullptr;
+    }
+
+    void startStream(MutableFrameCallback callback) override {
+        callback_ = callback;
+    }
+
+    void stopStream() override {
+        callback_ = nullptr;
+    }
+
+    void push(std::shared_ptr<Frame> packet) {
+        if(callback_) {
+            callback_(packet);
+        }
+    }
+
+private:
+    MutableFrameCallback callback_;
+};
+
+// HID packet of sampleCount samples, wrapped in a frame as the data stream port delivers it
+class Packet {
+public:
+    explicit Packet(uint32_t sampleCount) : buffer_(sizeof(OBImuHeader) + sampleCount * sizeof(OBImuOriginData)) {
+        auto header        = reinterpret_cast<OBImuHeader *>(buffer_.data());
+        header->reportId   = 1;
+        header->sampleRate = OB_SAMPLE_RATE_1_KHZ;
+        header->groupLen   = sizeof(OBImuOriginData);
+        header->groupCount = static_cast<uint8_t>(sampleCount);
+        frame_             = std::make_shared<Frame>(buffer_.data(), buffer_.size(), []() {});  // the buffer belongs to the packet
+        frame_->setDataSize(buffer_.size());
+        fill(0);
+    }
+
+    void fill(uint64_t firstTimestamp) {
+        auto header  = reinterpret_cast<OBImuHeader *>(buffer_.data());
+        auto samples = reinterpret_cast<OBImuOriginData *>(buffer_.data() + sizeof(OBImuHeader));
+        for(int i = 0; i < header->groupCount; i++) {
+            auto    &sample     = samples[i];
+            uint64_t ts         = firstTimestamp + i * 1000;
+            sample.groupId      = static_cast<int16_t>(i);
+            sample.accelX       = static_cast<int16_t>(100 + i);
+            sample.accelY       = static_cast<int16_t>(-200 - i);
+            sample.accelZ       = static_cast<int16_t>(16384 - i);
+            sample.gyroX        = static_cast<int16_t>(30 * i);
+            sample.gyroY        = static_cast<int16_t>(-40 * i);
+            sample.gyroZ        = static_cast<int16_t>(5 + i);
+            sample.temperature  = static_cast<int16_t>(1000 + i);
+            sample.timestamp[0] = static_cast<uint32_t>(ts);
+            sample.timestamp[1] = static_cast<uint32_t>(ts >> 32);
+        }
+    }
+
+    std::shared_ptr<Frame> frame() const {
+        return frame_;
+    }
+
+private:
+    std::vector<uint8_t>   buffer_;
+    std::shared_ptr<Frame> frame_;
+};
+
+// A delivered sample, identified by its stream and timestamp
+struct Sample {
+    OBStreamType type;
+    uint64_t     timestamp;
+    float        x, y, z, temperature;
+};
+
+struct Streamer {
+    std::shared_ptr<FakeImuPort>              port;
+    std::shared_ptr<ImuStreamer>              streamer;
+    std::shared_ptr<const AccelStreamProfile> accelProfile;
+    std::shared_ptr<const GyroStreamProfile>  gyroProfile;
+
+    explicit Streamer(bool batched, MutableFrameCallback callback) : port(std::make_shared<FakeImuPort>()) {
+        std::vector<std::shared_ptr<IFilter>> filters;
+        streamer     = std::make_shared<ImuStreamer>(nullptr, port, filters);
+        accelProfile = StreamProfileFactory::createAccelStreamProfile(OB_ACCEL_FS_4g, OB_SAMPLE_RATE_1_KHZ);
+        gyroProfile  = StreamProfileFactory::createGyroStreamProfile(OB_GYRO_FS_1000dps, OB_SAMPLE_RATE_1_KHZ);
+        if(batched) {
+            streamer->startBatchStream(accelProfile, callback);
+            streamer->startBatchStream(gyroProfile, callback);
+        }
+        else {
+            streamer->startStream(accelProfile, callback);
+            streamer->startStream(gyroProfile, callback);
+        }
+
+        // the first samples are discarded
+        Packet leading(LEADING_SAMPLES);
+        port->push(leading.frame());
+    }
+
+    ~Streamer() {
+        streamer->stopStream(accelProfile);
+        streamer->stopStream(gyroProfile);
+    }
+};
+
+void collect(std::vector<Sample> &samples, const std::shared_ptr<Frame> &frame) {
+    auto type = frame->getStreamProfile()->getType();
+    if(frame->getType() == OB_FRAME_IMU_BATCH) {
+        auto batch = frame->as<ImuBatchFrame>()->getBatchData();
+        for(uint32_t i = 0; i < batch.count; i++) {
+            samples.push_back({ type, batch.timestamp[i], batch.x[i], batch.y[i], batch.z[i], batch.temperature[i] });
+        }
+    }
+    else if(frame->getType() == OB_FRAME_ACCEL) {
+        auto accel = frame->as<AccelFrame>();
+        samples.push_back({ type, frame->getTimeStampUsec(), accel->value().x, accel->value().y, accel->value().z, accel->temperature() });
+    }
+    else if(frame->getType() == OB_FRAME_GYRO) {
+        auto gyro = frame->as<GyroFrame>();
+        samples.push_back({ type, frame->getTimeStampUsec(), gyro->value().x, gyro->value().y, gyro->value().z, gyro->temperature() });
+    }
+}
+
+bool sameSamples(const std::vector<Sample> &a, const std::vector<Sample> &b) {
+    if(a.size() != b.size()) {
+        return false;
+    }
+    // per-sample frames interleave accel and gyro, batches deliver them stream by stream
+    for(const auto &sa: a) {
+        bool found = false;
+        for(const auto &sb: b) {
+            if(sa.type == sb.type && sa.timestamp == sb.timestamp) {
+                found = sa.x == sb.x && sa.y == sb.y && sa.z == sb.z && sa.temperature == sb.temperature;
+                break;
+            }
+        }
+        if(!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testSameValues() {
+    std::vector<Sample> perSample, batched;
+    {
+        Streamer streamer(false, [&](std::shared_ptr<Frame> frame) { collect(perSample, frame); });
+        Packet   packet(16);
+        packet.fill(1000000);
+        streamer.port->push(packet.frame());
+    }
+    {
+        Streamer streamer(true, [&](std::shared_ptr<Frame> frame) { collect(batched, frame); });
+        Packet   packet(16);
+        packet.fill(1000000);
+        streamer.port->push(packet.frame());
+    }
+    obtest::report("batched and per-sample delivery carry the same samples", perSample.size() == 32 && sameSamples(perSample, batched));
+}
+
+void testEmptyPacket() {
+    std::vector<std::shared_ptr<Frame>> frames;
+    Streamer                            streamer(true, [&](std::shared_ptr<Frame> frame) { frames.push_back(frame); });
+    Packet                              packet(0);
+    streamer.port->push(packet.frame());
+    obtest::report("a packet without samples delivers no batch", frames.empty());
+}
+
+}  // namespace
+
+int main() {
+    testSameValues();
+    testEmptyPacket();
+
+    return obtest::result();
+}
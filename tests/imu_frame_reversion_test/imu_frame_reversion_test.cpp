@@ -0,0 +1,105 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Axis reversion of the IMU samples (IMUFrameReversion), which the Femto Bolt, Mega and Mega I IMU streamers run ahead of IMUCorrector. The
+// x, y and z values of the accel and gyro batch frames (OB_FRAME_IMU_BATCH) must be negated like the ones of the per-sample frame sets, the
+// timestamps and temperatures kept, and the input frame left unchanged.
+//
+// usage: imu_frame_reversion_test
+
+#include "publicfilters/IMUFrameReversion.hpp"
+#include "frame/FrameFactory.hpp"
+#include "stream/StreamProfileFactory.hpp"
+#include "ObTestCase.hpp"
+
+#include <cstdio>
+#include <memory>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t SAMPLE_COUNT = 16;
+
+float sampleValue(uint32_t index, uint32_t axis) {
+    return static_cast<float>(index) * 0.25f + static_cast<float>(axis) - 1.5f;
+}
+
+std::shared_ptr<ImuBatchFrame> createBatch(std::shared_ptr<const StreamProfile> sp) {
+    auto batch  = FrameFactory::createImuBatchFrame(sp, SAMPLE_COUNT);
+    auto arrays = batch->getArraysMutable();
+    for(uint32_t i = 0; i < SAMPLE_COUNT; i++) {
+        arrays.timestamp[i]   = 1000 + i;
+        arrays.x[i]           = sampleValue(i, 0);
+        arrays.y[i]           = sampleValue(i, 1);
+        arrays.z[i]           = sampleValue(i, 2);
+        arrays.temperature[i] = 30.0f + static_cast<float>(i);
+    }
+    batch->setSampleCount(SAMPLE_COUNT);
+    return batch;
+}
+
+bool checkBatch(std::shared_ptr<const Frame> frame, float sign) {
+    if(!frame || frame->getType() != OB_FRAME_IMU_BATCH) {
+        return false;
+    }
+    auto data = frame->as<ImuBatchFrame>()->getBatchData();
+    if(data.count != SAMPLE_COUNT) {
+        return false;
+    }
+    for(uint32_t i = 0; i < SAMPLE_COUNT; i++) {
+        if(data.timestamp[i] != 1000 + i || data.temperature[i] != 30.0f + static_cast<float>(i) || data.x[i] != sign * sampleValue(i, 0)
+           || data.y[i] != sign * sampleValue(i, 1) || data.z[i] != sign * sampleValue(i, 2)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testBatch(const char *name, std::shared_ptr<const StreamProfile> sp) {
+    std::shared_ptr<IFilterBase> reversion = std::make_shared<IMUFrameReversion>();
+    auto                         batch     = createBatch(sp);
+    auto                         reversed  = reversion->process(batch);
+    obtest::report(name, checkBatch(reversed, -1.0f) && checkBatch(batch, 1.0f));
+}
+
+// The first sample of a batch must come out of the filter like the same sample in a per-sample frame set
+void testSameAsFrameSet() {
+    std::shared_ptr<IFilterBase> reversion = std::make_shared<IMUFrameReversion>();
+    auto accelProfile = StreamProfileFactory::createAccelStreamProfile(OB_ACCEL_FS_4g, OB_SAMPLE_RATE_1_KHZ);
+    auto gyroProfile  = StreamProfileFactory::createGyroStreamProfile(OB_GYRO_FS_1000dps, OB_SAMPLE_RATE_1_KHZ);
+
+    auto frameSet   = FrameFactory::createFrameSet();
+    auto accelFrame = FrameFactory::createFrameFromStreamProfile(accelProfile);
+    auto gyroFrame  = FrameFactory::createFrameFromStreamProfile(gyroProfile);
+    auto accelData  = reinterpret_cast<AccelFrame::Data *>(accelFrame->getDataMutable());
+    auto gyroData   = reinterpret_cast<GyroFrame::Data *>(gyroFrame->getDataMutable());
+    accelData->value = { sampleValue(0, 0), sampleValue(0, 1), sampleValue(0, 2) };
+    gyroData->value  = { sampleValue(0, 0), sampleValue(0, 1), sampleValue(0, 2) };
+    frameSet->pushFrame(std::shared_ptr<const Frame>(accelFrame));
+    frameSet->pushFrame(std::shared_ptr<const Frame>(gyroFrame));
+
+    auto reversedSet   = reversion->process(frameSet)->as<FrameSet>();
+    auto reversedAccel = reversedSet->getFrame(OB_FRAME_ACCEL)->as<AccelFrame>()->value();
+    auto reversedGyro  = reversedSet->getFrame(OB_FRAME_GYRO)->as<GyroFrame>()->value();
+
+    // the arrays belong to the frames, which must stay alive
+    auto accelBatchFrame = reversion->process(createBatch(accelProfile));
+    auto gyroBatchFrame  = reversion->process(createBatch(gyroProfile));
+    auto accelBatch      = accelBatchFrame->as<ImuBatchFrame>()->getBatchData();
+    auto gyroBatch       = gyroBatchFrame->as<ImuBatchFrame>()->getBatchData();
+
+    bool pass = reversedAccel.x == accelBatch.x[0] && reversedAccel.y == accelBatch.y[0] && reversedAccel.z == accelBatch.z[0];
+    pass      = pass && reversedGyro.x == gyroBatch.x[0] && reversedGyro.y == gyroBatch.y[0] && reversedGyro.z == gyroBatch.z[0];
+    obtest::report("batch same as frame set", pass);
+}
+
+}  // namespace
+
+int main() {
+    testBatch("accel batch", StreamProfileFactory::createAccelStreamProfile(OB_ACCEL_FS_4g, OB_SAMPLE_RATE_1_KHZ));
+    testBatch("gyro batch", StreamProfileFactory::createGyroStreamProfile(OB_GYRO_FS_1000dps, OB_SAMPLE_RATE_1_KHZ));
+    testSameAsFrameSet();
+
+    return obtest::result();
+}
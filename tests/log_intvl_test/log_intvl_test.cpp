@@ -0,0 +1,200 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Rate limiting of the interval controlled logs (LOG_INTVL). The logs go to a capturing logger: the first call of an interval is output, the
+// suppressed calls are output by the flusher thread with their count, the tags of a call site are limited separately, no call is lost from
+// the counts while several threads log and the flusher runs, and the logger can be replaced and released while threads are logging, also
+// from a thread that is logging.
+//
+// usage: log_intvl_test
+
+#include "logger/LoggerInterval.hpp"
+#include "ObTestCase.hpp"
+
+#include <spdlog/sinks/base_sink.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class CaptureSink : public spdlog::sinks::base_sink<std::mutex> {
+public:
+    std::vector<std::string> takeLines() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::string>    lines;
+        lines.swap(lines_);
+        return lines;
+    }
+
+protected:
+    void sink_it_(const spdlog::details::log_msg &msg) override {
+        lines_.emplace_back(msg.payload.data(), msg.payload.size());
+    }
+    void flush_() override {}
+
+private:
+    std::vector<std::string> lines_;
+};
+
+std::shared_ptr<CaptureSink> sink = std::make_shared<CaptureSink>();
+
+std::shared_ptr<spdlog::logger> createLogger() {
+    auto logger = std::make_shared<spdlog::logger>("log_intvl_test", sink);
+    logger->set_level(spdlog::level::trace);
+    return logger;
+}
+
+// Number of calls a line stands for: "... [**N logs in ...**]" or a single call
+uint64_t callCount(const std::string &line) {
+    auto pos = line.find("[**");
+    return pos == std::string::npos ? 1 : std::strtoull(line.c_str() + pos + 3, nullptr, 10);
+}
+
+uint64_t callCount(const std::vector<std::string> &lines) {
+    uint64_t count = 0;
+    for(auto &line: lines) {
+        count += callCount(line);
+    }
+    return count;
+}
+
+void logSuppressed(uint64_t tag) {
+    LOG_INTVL(tag, 10000, spdlog::level::info, "suppressed log {}", tag);
+}
+
+void testSuppressed() {
+    log_intvl_start_flusher();
+    for(int i = 0; i < 100; i++) {
+        logSuppressed(1);
+    }
+    auto firstLines = sink->takeLines();
+    log_intvl_stop_flusher();  // outputs the pending messages
+    auto flushedLines = sink->takeLines();
+
+    bool pass = firstLines.size() == 1 && firstLines[0] == "suppressed log 1" && flushedLines.size() == 1
+                && flushedLines[0].find("suppressed log 1 [**99 logs in") == 0;
+    obtest::report("suppressed calls output by the flusher", pass);
+}
+
+void logTagged(uint64_t tag) {
+    LOG_INTVL(tag, 10000, spdlog::level::info, "tagged log {}", tag);
+}
+
+void testTags() {
+    log_intvl_start_flusher();
+    for(int i = 0; i < 10; i++) {
+        logTagged(1);
+        logTagged(2);
+    }
+    log_intvl_stop_flusher();
+    auto lines = sink->takeLines();
+    bool pass  = lines.size() == 4 && lines[0] == "tagged log 1" && lines[1] == "tagged log 2" && callCount(lines) == 20;
+    obtest::report("tags limited separately", pass);
+}
+
+void logContended() {
+    LOG_INTVL(7, 1, spdlog::level::info, "contended log");
+}
+
+void testContended() {
+    const int threadCount = 4;
+    const int callsCount  = 50000;
+
+    log_intvl_start_flusher();
+    std::vector<std::thread> threads;
+    for(int t = 0; t < threadCount; t++) {
+        threads.emplace_back([]() {
+            for(int i = 0; i < callsCount; i++) {
+                logContended();
+                if(i % 1000 == 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));  // let the flusher run between the bursts
+                }
+            }
+        });
+    }
+    for(auto &thread: threads) {
+        thread.join();
+    }
+    log_intvl_stop_flusher();
+    auto lines = sink->takeLines();
+    auto count = callCount(lines);
+    std::printf("%llu calls in %u lines\n", static_cast<unsigned long long>(count), static_cast<uint32_t>(lines.size()));
+    obtest::report("no call lost under contention", count == static_cast<uint64_t>(threadCount) * callsCount);
+}
+
+void logUnlimited() {
+    LOG_INTVL(0, 0, spdlog::level::info, "unlimited log");
+}
+
+void testLoggerReplaced() {
+    const int         threadCount = 2;
+    std::atomic<int>  calls(0);
+    std::atomic<bool> stop(false);
+
+    auto logger = createLogger();
+    log_intvl_set_logger(logger);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&]() {
+            while(!stop) {
+                logUnlimited();
+                calls++;
+            }
+        });
+    }
+    for(int i = 0; i < 200; i++) {
+        auto next = createLogger();
+        log_intvl_set_logger(next);
+        logger = next;  // releases the previous logger, the threads still using it keep it alive
+    }
+    stop = true;
+    for(auto &thread: threads) {
+        thread.join();
+    }
+    auto lines = sink->takeLines();
+    obtest::report("logger replaced while logging", lines.size() == static_cast<size_t>(calls.load()));
+    log_intvl_set_logger(nullptr);
+}
+
+// Replaces the logger of the interval controlled logs from its sink, on the thread that is logging
+class ReplacingSink : public spdlog::sinks::base_sink<std::mutex> {
+protected:
+    void sink_it_(const spdlog::details::log_msg &) override {
+        log_intvl_set_logger(createLogger());
+    }
+    void flush_() override {}
+};
+
+void testLoggerReplacedWhileLogging() {
+    auto replacing = std::make_shared<spdlog::logger>("log_intvl_test", std::make_shared<ReplacingSink>());
+    log_intvl_set_logger(replacing);
+    replacing.reset();  // only the interval controlled logs hold it now
+    logUnlimited();     // replaces (and releases) the logger it is output by
+    logUnlimited();
+    auto lines = sink->takeLines();
+    obtest::report("logger replaced by a logging thread", lines.size() == 1 && lines[0] == "unlimited log");
+    log_intvl_set_logger(nullptr);
+}
+
+}  // namespace
+
+int main() {
+    auto logger = createLogger();
+    log_intvl_set_logger(logger);
+
+    testSuppressed();
+    testTags();
+    testContended();
+    testLoggerReplaced();
+    testLoggerReplacedWhileLogging();
+
+    return obtest::result();
+}
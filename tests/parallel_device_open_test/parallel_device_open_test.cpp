@@ -0,0 +1,309 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Parallel opening of devices, with fake devices (FakeDeviceEnumInfo creates a FakeDevice after a delay) and fake source ports. The cases
+// check the source port map of the pals (SourcePortMap): a port opened once by concurrent callers, different ports opened in parallel, a
+// failed or released port opened again; the device manager: concurrent creations of the same device (same uid) waiting for the first one,
+// different devices created in parallel, a failed creation retried, the creations fanned out on a bounded worker pool; and
+// ob_device_list_get_devices of the SDK library, called on a device list of fake enum infos: a device or an error per index.
+//
+// usage: parallel_device_open_test
+
+#include "SourcePortMap.hpp"
+#include "context/Context.hpp"
+#include "devicemanager/DeviceEnumInfoBase.hpp"
+#include "DeviceBase.hpp"
+#include "ImplTypes.hpp"
+#include "exception/ObException.hpp"
+#include "utils/Utils.hpp"
+#include "utils/WorkerPool.hpp"
+
+#include "libobsensor/h/Device.h"
+#include "libobsensor/h/Error.h"
+#include "ObTestCase.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t OPEN_DELAY_MS = 100;
+
+void sleepMs(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// Runs func(i) on count threads at the same time, returns the elapsed time in ms
+template <typename Func> uint64_t runConcurrently(uint32_t count, Func func) {
+    utils::Timer             timer;
+    std::vector<std::thread> threads;
+    for(uint32_t i = 0; i < count; i++) {
+        threads.emplace_back([&func, i]() { func(i); });
+    }
+    for(auto &thread: threads) {
+        thread.join();
+    }
+    return timer.touchMs();
+}
+
+struct FakePortInfo : public SourcePortInfo {
+    explicit FakePortInfo(int id) : SourcePortInfo(SOURCE_PORT_UNKNOWN), id(id) {}
+
+    bool equal(std::shared_ptr<const SourcePortInfo> cmpInfo) const override {
+        auto fakeInfo = std::dynamic_pointer_cast<const FakePortInfo>(cmpInfo);
+        return fakeInfo && fakeInfo->id == id;
+    }
+
+    int id;
+};
+
+class FakePort : public ISourcePort {
+public:
+    explicit FakePort(std::shared_ptr<const SourcePortInfo> info) : info_(info) {}
+
+    std::shared_ptr<const SourcePortInfo> getSourcePortInfo() const override {
+        return info_;
+    }
+
+private:
+    std::shared_ptr<const SourcePortInfo> info_;
+};
+
+// Opens a FakePort after OPEN_DELAY_MS, counting the opens
+struct FakePortOpener {
+    std::atomic<int> openCount{ 0 };
+    std::atomic<int> failCount{ 0 };  // number of opens to fail first
+
+    std::shared_ptr<ISourcePort> open(std::shared_ptr<const SourcePortInfo> info) {
+        sleepMs(OPEN_DELAY_MS);
+        openCount++;
+        if(failCount.fetch_sub(1) > 0) {
+            THROW_IO_EXCEPTION("fake port open failed");
+        }
+        return std::make_shared<FakePort>(info);
+    }
+};
+
+void testSamePort() {
+    SourcePortMap                             portMap;
+    FakePortOpener                            opener;
+    auto                                      info = std::make_shared<FakePortInfo>(1);
+    std::vector<std::shared_ptr<ISourcePort>> ports(8);
+    runConcurrently(8, [&](uint32_t i) {
+        // another info object of the same port
+        auto portInfo = i % 2 ? std::make_shared<FakePortInfo>(1) : info;
+        ports[i]      = portMap.getOrOpen(portInfo, [&]() { return opener.open(portInfo); });
+    });
+    bool pass = opener.openCount == 1;
+    for(auto &port: ports) {
+        pass = pass && port && port == ports[0];
+    }
+    obtest::report("same port opened once by concurrent callers", pass);
+}
+
+void testDifferentPorts() {
+    SourcePortMap                             portMap;
+    FakePortOpener                            opener;
+    std::vector<std::shared_ptr<ISourcePort>> ports(4);
+    auto                                      ms = runConcurrently(4, [&](uint32_t i) {
+        auto portInfo = std::make_shared<FakePortInfo>(static_cast<int>(i));
+        ports[i]      = portMap.getOrOpen(portInfo, [&]() { return opener.open(portInfo); });
+    });
+    std::printf("4 ports opened in %u ms (%u ms per port)\n", static_cast<uint32_t>(ms), OPEN_DELAY_MS);
+    std::set<std::shared_ptr<ISourcePort>> distinctPorts(ports.begin(), ports.end());
+    obtest::report("different ports opened in parallel", opener.openCount == 4 && distinctPorts.size() == 4 && ms < 2 * OPEN_DELAY_MS);
+}
+
+void testReopen() {
+    SourcePortMap  portMap;
+    FakePortOpener opener;
+    auto           info = std::make_shared<FakePortInfo>(1);
+    auto           open = [&]() { return opener.open(info); };
+
+    opener.failCount = 1;
+    bool failed      = false;
+    try {
+        portMap.getOrOpen(info, open);
+    }
+    catch(const libobsensor_exception &) {
+        failed = true;
+    }
+    auto port  = portMap.getOrOpen(info, open);
+    bool pass  = failed && port && opener.openCount == 2;
+    pass       = pass && portMap.getOrOpen(info, open) == port && opener.openCount == 2;
+    port.reset();  // released by all its users
+    pass = pass && portMap.getOrOpen(info, open) && opener.openCount == 3;
+    obtest::report("failed or released port opened again", pass);
+}
+
+class FakeDevice : public DeviceBase {
+public:
+    explicit FakeDevice(const std::shared_ptr<const IDeviceEnumInfo> &info) : DeviceBase(info) {}
+
+    void init() override {}
+    void postInitialize() override {}
+};
+
+// Creates a FakeDevice after OPEN_DELAY_MS, counting the creations
+class FakeDeviceEnumInfo : public DeviceEnumInfoBase {
+public:
+    FakeDeviceEnumInfo(const std::string &uid, bool fail = false) : DeviceEnumInfoBase(0x0800, 0x2bc5, uid, "USB3.2", "Fake Device", uid, {}), fail_(fail) {}
+
+    std::shared_ptr<IDevice> createDevice(OBDeviceAccessMode) const override {
+        sleepMs(OPEN_DELAY_MS);
+        createCount++;
+        if(fail_) {
+            THROW_IO_EXCEPTION("fake device creation failed");
+        }
+        return std::make_shared<FakeDevice>(self_.lock());
+    }
+
+    static std::shared_ptr<FakeDeviceEnumInfo> create(const std::string &uid, bool fail = false) {
+        auto info   = std::make_shared<FakeDeviceEnumInfo>(uid, fail);
+        info->self_ = info;
+        return info;
+    }
+
+    mutable std::atomic<int> createCount{ 0 };
+
+private:
+    bool                                    fail_;
+    std::weak_ptr<const FakeDeviceEnumInfo> self_;
+};
+
+void testSameDevice() {
+    auto                                  info = FakeDeviceEnumInfo::create("fake-same");
+    std::vector<std::shared_ptr<IDevice>> devices(4);
+    runConcurrently(4, [&](uint32_t i) { devices[i] = info->getDeviceManager()->createDevice(info, OB_DEVICE_DEFAULT_ACCESS); });
+    bool pass = info->createCount == 1;
+    for(auto &device: devices) {
+        pass = pass && device && device == devices[0];
+    }
+    obtest::report("same device created once by concurrent callers", pass);
+}
+
+void testDifferentDevices() {
+    std::vector<std::shared_ptr<FakeDeviceEnumInfo>> infos;
+    for(int i = 0; i < 4; i++) {
+        infos.push_back(FakeDeviceEnumInfo::create("fake-different-" + std::to_string(i)));
+    }
+    std::vector<std::shared_ptr<IDevice>> devices(infos.size());
+    auto ms = runConcurrently(4, [&](uint32_t i) { devices[i] = infos[i]->getDeviceManager()->createDevice(infos[i], OB_DEVICE_DEFAULT_ACCESS); });
+    std::printf("4 devices created in %u ms (%u ms per device)\n", static_cast<uint32_t>(ms), OPEN_DELAY_MS);
+    bool pass = ms < 2 * OPEN_DELAY_MS;
+    for(size_t i = 0; i < infos.size(); i++) {
+        pass = pass && infos[i]->createCount == 1 && devices[i] && devices[i]->getInfo()->uid_ == infos[i]->getUid();
+    }
+    obtest::report("different devices created in parallel", pass);
+}
+
+void testFailedDevice() {
+    auto             info    = FakeDeviceEnumInfo::create("fake-failed", true);
+    auto             manager = info->getDeviceManager();
+    std::atomic<int> failures(0);
+    runConcurrently(2, [&](uint32_t) {
+        try {
+            manager->createDevice(info, OB_DEVICE_DEFAULT_ACCESS);
+        }
+        catch(const libobsensor_exception &) {
+            failures++;
+        }
+    });
+    // the second caller waits for the first one, then fails on its own creation: the uid is not left as being created
+    obtest::report("failed device creation retried by the next caller", failures == 2 && info->createCount == 2);
+}
+
+void testWorkerPoolFanOut() {
+    std::vector<std::shared_ptr<FakeDeviceEnumInfo>> infos;
+    for(int i = 0; i < 4; i++) {
+        infos.push_back(FakeDeviceEnumInfo::create("fake-pool-" + std::to_string(i)));
+    }
+
+    // 4 devices on 2 threads (the calling thread is one of them): 2 rounds of creations
+    std::vector<std::shared_ptr<IDevice>> devices(infos.size());
+    utils::WorkerPool                     pool(2);
+    utils::Timer                          timer;
+    pool.run(4, [&](uint32_t i) { devices[i] = infos[i]->getDeviceManager()->createDevice(infos[i], OB_DEVICE_DEFAULT_ACCESS); });
+    auto ms = timer.touchMs();
+    std::printf("4 devices created on 2 threads in %u ms (%u ms per device)\n", static_cast<uint32_t>(ms), OPEN_DELAY_MS);
+    bool pass = ms >= 2 * OPEN_DELAY_MS && ms < 3 * OPEN_DELAY_MS;
+    for(size_t i = 0; i < infos.size(); i++) {
+        pass = pass && infos[i]->createCount == 1 && devices[i];
+    }
+
+    // the same devices again while they are held: no creation
+    std::vector<std::shared_ptr<IDevice>> again(infos.size());
+    pool.run(4, [&](uint32_t i) { again[i] = infos[i]->getDeviceManager()->createDevice(infos[i], OB_DEVICE_DEFAULT_ACCESS); });
+    for(size_t i = 0; i < infos.size(); i++) {
+        pass = pass && infos[i]->createCount == 1 && again[i] == devices[i];
+    }
+    obtest::report("device creations fanned out on a bounded worker pool", pass);
+}
+
+void testGetDevices() {
+    auto okInfo     = FakeDeviceEnumInfo::create("fake-list-0");
+    auto otherInfo  = FakeDeviceEnumInfo::create("fake-list-1");
+    auto failedInfo = FakeDeviceEnumInfo::create("fake-list-2", true);
+
+    ob_device_list list;
+    list.list    = { okInfo, otherInfo, failedInfo };
+    list.manager = okInfo->getDeviceManager();
+
+    const uint32_t indices[] = { 0, 1, 2, 0 };
+    ob_device     *devices[4];
+    ob_error      *deviceErrors[4];
+    ob_error      *error   = nullptr;
+    utils::Timer   timer;
+    auto           created = ob_device_list_get_devices(&list, indices, 4, OB_DEVICE_DEFAULT_ACCESS, 0, devices, deviceErrors, &error);
+    auto           ms      = timer.touchMs();
+    std::printf("ob_device_list_get_devices: 4 devices in %u ms (%u ms per device)\n", static_cast<uint32_t>(ms), OPEN_DELAY_MS);
+
+    bool pass = !error && created == 3 && ms < 2 * OPEN_DELAY_MS;
+    pass      = pass && devices[0] && devices[1] && !devices[2] && devices[3] && devices[3]->device == devices[0]->device;
+    pass      = pass && !deviceErrors[0] && !deviceErrors[1] && deviceErrors[2] && !deviceErrors[3];
+    pass      = pass && okInfo->createCount == 1 && otherInfo->createCount == 1 && failedInfo->createCount == 1;
+    for(uint32_t i = 0; i < 4; i++) {
+        if(devices[i]) {
+            ob_delete_device(devices[i], &error);
+        }
+        if(deviceErrors[i]) {
+            ob_delete_error(deviceErrors[i]);
+        }
+    }
+
+    // invalid index: nothing created
+    const uint32_t badIndices[] = { 0, 3 };
+    created                     = ob_device_list_get_devices(&list, badIndices, 2, OB_DEVICE_DEFAULT_ACCESS, 1, devices, nullptr, &error);
+    pass                        = pass && created == 0 && error && okInfo->createCount == 1;
+    if(error) {
+        ob_delete_error(error);
+    }
+    obtest::report("ob_device_list_get_devices", pass);
+}
+
+}  // namespace
+
+int main() {
+    testSamePort();
+    testDifferentPorts();
+    testReopen();
+
+    // the device enum infos only hold a weak reference to the context of their device manager
+    auto context = Context::getInstance();
+    testSameDevice();
+    testDifferentDevices();
+    testFailedDevice();
+    testWorkerPoolFanOut();
+    testGetDevices();
+
+    return obtest::result();
+}
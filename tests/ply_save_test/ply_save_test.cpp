@@ -0,0 +1,195 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// PLY export of point cloud frames: the streaming writer of PointCloudSaveUtil against the std::ofstream writer it replaced (copied below as
+// the reference). Both must write the same ASCII and binary files and the quantized file must read back within half a quantization step. The
+// time per save is measured by ob_ply_save_benchmark.
+//
+// usage: ply_save_test [output directory]
+
+#include "utils/PointCloudSaveUtil.hpp"
+#include "frame/FrameFactory.hpp"
+#include "ObTestCase.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t POINTS_WIDTH = 1280;
+
+// Deterministic pseudo random input, a failure always reproduces
+uint32_t nextRandom(uint32_t &state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// Dense point cloud (one point per pixel) with 20% zero points, coordinates in millimeters
+std::shared_ptr<Frame> makePointsFrame(bool color, uint32_t pointCount) {
+    uint32_t width  = POINTS_WIDTH;
+    uint32_t height = (pointCount + width - 1) / width;
+    size_t   floats = color ? 6 : 3;
+    auto     frame  = FrameFactory::createFrame(OB_FRAME_POINTS, color ? OB_FORMAT_RGB_POINT : OB_FORMAT_POINT, width * height * floats * sizeof(float));
+    frame->as<PointsFrame>()->setWidth(width);
+    frame->as<PointsFrame>()->setHeight(height);
+
+    uint32_t seed   = 5;
+    float   *values = reinterpret_cast<float *>(const_cast<uint8_t *>(frame->getData()));
+    for(size_t i = 0; i < static_cast<size_t>(width) * height; i++) {
+        float   *pt  = values + i * floats;
+        uint32_t rnd = nextRandom(seed);
+        if(rnd % 5 == 0) {
+            memset(pt, 0, floats * sizeof(float));
+            continue;
+        }
+        pt[2] = 300.0f + static_cast<float>(rnd % 9000) * 0.37f;
+        pt[0] = (static_cast<float>(i % width) - width * 0.5f) * pt[2] / 600.0f;
+        pt[1] = (static_cast<float>(i / width) - height * 0.5f) * pt[2] / 600.0f;
+        if(color) {
+            pt[3] = static_cast<float>(rnd & 0xFF);
+            pt[4] = static_cast<float>((rnd >> 8) & 0xFF);
+            pt[5] = static_cast<float>((rnd >> 16) & 0xFF);
+        }
+    }
+    return frame;
+}
+
+// The non-mesh path of PointCloudSaveUtil::savePointCloudToPly before the streaming writer: the valid points are copied to a vertex vector,
+// then written with std::ofstream
+struct LegacyVertex {
+    float   x, y, z;
+    uint8_t color[3];
+};
+
+bool legacySavePointCloudToPly(const char *fileName, std::shared_ptr<Frame> frame, bool saveBinary) {
+    auto pointCloudFrame = frame->as<PointsFrame>();
+    bool colorPointCloud = pointCloudFrame->getFormat() == OB_FORMAT_RGB_POINT;
+    auto width           = pointCloudFrame->getWidth();
+    auto height          = pointCloudFrame->getHeight();
+
+    std::vector<LegacyVertex> vertices;
+    vertices.reserve(static_cast<size_t>(width) * height);
+    const float *values = reinterpret_cast<const float *>(pointCloudFrame->getData());
+    size_t       floats = colorPointCloud ? 6 : 3;
+    for(size_t i = 0; i < static_cast<size_t>(width) * height; i++) {
+        const float *pt = values + i * floats;
+        if(std::fabs(pt[2]) >= 1e-6f) {
+            LegacyVertex vertex = { pt[0], pt[1], pt[2], { 0, 0, 0 } };
+            if(colorPointCloud) {
+                vertex.color[0] = static_cast<uint8_t>(pt[3]);
+                vertex.color[1] = static_cast<uint8_t>(pt[4]);
+                vertex.color[2] = static_cast<uint8_t>(pt[5]);
+            }
+            vertices.push_back(vertex);
+        }
+    }
+
+    std::ofstream plyOut(fileName);
+    if(!plyOut) {
+        return false;
+    }
+    plyOut << "ply\n";
+    plyOut << (saveBinary ? "format binary_little_endian 1.0\n" : "format ascii 1.0\n");
+    plyOut << "comment Generated by mesh generation code\n";
+    plyOut << "element vertex " << vertices.size() << "\n";
+    plyOut << "property float x\n";
+    plyOut << "property float y\n";
+    plyOut << "property float z\n";
+    if(colorPointCloud) {
+        plyOut << "property uchar red\n";
+        plyOut << "property uchar green\n";
+        plyOut << "property uchar blue\n";
+    }
+    plyOut << "end_header\n";
+
+    if(saveBinary) {
+        plyOut.close();
+        plyOut.open(fileName, std::ios_base::app | std::ios_base::binary);
+        for(const auto &vertex: vertices) {
+            plyOut.write(reinterpret_cast<const char *>(&vertex.x), sizeof(float));
+            plyOut.write(reinterpret_cast<const char *>(&vertex.y), sizeof(float));
+            plyOut.write(reinterpret_cast<const char *>(&vertex.z), sizeof(float));
+            if(colorPointCloud) {
+                plyOut.write(reinterpret_cast<const char *>(vertex.color), 3);
+            }
+        }
+    }
+    else {
+        for(const auto &vertex: vertices) {
+            plyOut << vertex.x << " " << vertex.y << " " << vertex.z << "\n";
+            if(colorPointCloud) {
+                plyOut << static_cast<int>(vertex.color[0]) << " " << static_cast<int>(vertex.color[1]) << " " << static_cast<int>(vertex.color[2])
+                       << "\n";
+            }
+        }
+    }
+    return true;
+}
+
+std::string readFile(const std::string &fileName) {
+    std::ifstream in(fileName, std::ios_base::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void testSameFiles(const std::string &dir, bool color) {
+    auto        frame     = makePointsFrame(color, 64 * 1024);
+    std::string refFile   = dir + "/ply_save_test_ref.ply";
+    std::string testFile  = dir + "/ply_save_test_out.ply";
+    const char *cloudName = color ? "rgbd" : "depth";
+    char        name[128];
+
+    for(int binary = 0; binary < 2; binary++) {
+        bool saved = legacySavePointCloudToPly(refFile.c_str(), frame, binary != 0);
+        saved      = PointCloudSaveUtil::savePointCloudToPly(testFile.c_str(), frame, binary != 0) && saved;
+        std::snprintf(name, sizeof(name), "%s, %s, same file as the ofstream writer", cloudName, binary ? "binary" : "ascii");
+        obtest::report(name, saved && readFile(refFile) == readFile(testFile));
+    }
+
+    // The quantized file is the binary file with int16 coordinates: compare both vertex by vertex
+    const float step  = 0.5f;
+    bool        saved = PointCloudSaveUtil::streamPointCloudToPly(refFile.c_str(), frame, PLY_ENCODING_BINARY, 1.0f)
+                 && PointCloudSaveUtil::streamPointCloudToPly(testFile.c_str(), frame, PLY_ENCODING_BINARY_QUANTIZED, step);
+    std::string ref          = readFile(refFile);
+    std::string quantized    = readFile(testFile);
+    size_t      refBody      = ref.find("end_header\n") + 11;
+    size_t      quantBody    = quantized.find("end_header\n") + 11;
+    size_t      colorSize    = color ? 3 : 0;
+    size_t      vertexCount  = (ref.size() - refBody) / (12 + colorSize);
+    bool        pass         = saved && quantized.size() - quantBody == vertexCount * (6 + colorSize);
+    for(size_t i = 0; pass && i < vertexCount; i++) {
+        const char *refVertex   = ref.data() + refBody + i * (12 + colorSize);
+        const char *quantVertex = quantized.data() + quantBody + i * (6 + colorSize);
+        for(int k = 0; k < 3; k++) {
+            float   value;
+            int16_t q;
+            memcpy(&value, refVertex + 4 * k, sizeof(float));
+            memcpy(&q, quantVertex + 2 * k, sizeof(int16_t));
+            pass = pass && std::fabs(q * step - value) <= step * 0.5f;
+        }
+        pass = pass && memcmp(refVertex + 12, quantVertex + 6, colorSize) == 0;
+    }
+    std::snprintf(name, sizeof(name), "%s, quantized within half a step", cloudName);
+    obtest::report(name, pass);
+
+    std::remove(refFile.c_str());
+    std::remove(testFile.c_str());
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    std::string dir = argc > 1 ? argv[1] : ".";
+
+    testSameFiles(dir, false);
+    testSameFiles(dir, true);
+
+    return obtest::result();
+}
@@ -0,0 +1,317 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Bit-exactness of the point cloud generation of CoordinateUtil. Each case runs the same synthetic input through the scalar code
+// (SIMD disabled, no worker pool) and through the SSE and AVX2 kernels and the row bands on a worker pool, and compares the points and the
+// valid point counts byte for byte. The SIMD levels the CPU does not support are skipped. The half float planes written by the kernels are
+// compared with the float points converted afterwards.
+//
+// usage: point_cloud_simd_test
+
+#include "utils/CoordinateUtil.hpp"
+#include "utils/CpuFeatures.hpp"
+#include "utils/PointCloudKernels.hpp"
+#include "utils/WorkerPool.hpp"
+#include "ObTestCase.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+// not a multiple of 8, so the rows end with the SSE and scalar tails; large enough to be converted in row bands
+const int DEPTH_WIDTH  = 643;
+const int DEPTH_HEIGHT = 481;
+
+// Deterministic pseudo random input, a failure always reproduces
+uint32_t nextRandom(uint32_t &state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+OBCameraIntrinsic makeIntrinsic(int width, int height, float focal) {
+    OBCameraIntrinsic intrinsic;
+    intrinsic.fx     = focal;
+    intrinsic.fy     = focal * 1.002f;
+    intrinsic.cx     = width * 0.5f + 1.3f;
+    intrinsic.cy     = height * 0.5f - 2.1f;
+    intrinsic.width  = static_cast<int16_t>(width);
+    intrinsic.height = static_cast<int16_t>(height);
+    return intrinsic;
+}
+
+// Depth with invalid (0xFFFF / 0x0FFF), zero and valid pixels
+std::vector<uint16_t> makeDepth(bool y12c4) {
+    uint32_t              seed = 7;
+    std::vector<uint16_t> depth(DEPTH_WIDTH * DEPTH_HEIGHT);
+    for(auto &value: depth) {
+        uint32_t rnd = nextRandom(seed);
+        switch(rnd % 10) {
+        case 0:
+            value = y12c4 ? static_cast<uint16_t>(0xFFF0 | (rnd & 0xF)) : 0xFFFF;
+            break;
+        case 1:
+            value = 0;
+            break;
+        default:
+            value = static_cast<uint16_t>((rnd >> 4) % 12000);
+            if(y12c4) {
+                value = static_cast<uint16_t>(((value & 0x0FFF) << 4) | (rnd & 0xF));
+            }
+            break;
+        }
+    }
+    return depth;
+}
+
+struct XYTables {
+    std::vector<float> data;
+    OBXYTables         tables;
+};
+
+// Undistorted tables with a few NaN pixels, as out of range pixels of distorted tables
+void makeXYTables(XYTables &xyTables) {
+    OBCameraDistortion distortion;
+    memset(&distortion, 0, sizeof(distortion));
+    uint32_t dataSize = DEPTH_WIDTH * DEPTH_HEIGHT * 2;
+    xyTables.data.resize(dataSize);
+    CoordinateUtil::transformationInitXYTables(makeIntrinsic(DEPTH_WIDTH, DEPTH_HEIGHT, 520.0f), distortion, xyTables.data.data(), &dataSize, &xyTables.tables);
+
+    uint32_t seed = 3;
+    for(int i = 0; i < 500; i++) {
+        xyTables.tables.xTable[nextRandom(seed) % (DEPTH_WIDTH * DEPTH_HEIGHT)] = std::numeric_limits<float>::quiet_NaN();
+    }
+}
+
+struct PointCloudCase {
+    const char            *name;
+    bool                   color;
+    bool                   outputZeroPoint;
+    bool                   y12c4;
+    OBCoordinateSystemType coordinateSystem;
+    int                    step;
+    int                    colorScale;  // color image size / depth image size
+};
+
+struct Output {
+    std::vector<float> points;
+    uint32_t           validCount;
+
+    bool operator==(const Output &other) const {
+        return validCount == other.validCount && points.size() == other.points.size()
+               && memcmp(points.data(), other.points.data(), points.size() * sizeof(float)) == 0;
+    }
+};
+
+// Compacted points past the valid count are undefined (the row bands leave their points there)
+void dropInvalidPoints(bool outputZeroPoint, uint32_t pointFloats, Output &out) {
+    if(!outputZeroPoint) {
+        out.points.resize(static_cast<size_t>(out.validCount) * pointFloats);
+    }
+}
+
+// Padded width of PointCloudFilter for the dense layout
+uint32_t pointsWidth(int step) {
+    return (DEPTH_WIDTH / step + 3) / 4 * 4;
+}
+
+void convertOnce(const PointCloudCase &pcCase, XYTables &xyTables, const std::vector<uint16_t> &depth, const std::vector<uint8_t> &rgb, utils::SimdLevel level,
+                 utils::WorkerPool *workerPool, Output &out) {
+    utils::setSimdLevelLimit(level);
+    uint32_t width      = pointsWidth(pcCase.step);
+    uint32_t pointCount = width * ((DEPTH_HEIGHT + pcCase.step - 1) / pcCase.step);
+    out.points.assign(static_cast<size_t>(pointCount) * (pcCase.color ? 6 : 3), 0.0f);
+    out.validCount = 0;
+    if(pcCase.color) {
+        CoordinateUtil::transformationDepthToRGBDPointCloud(&xyTables.tables, depth.data(), rgb.data(), out.points.data(), pcCase.outputZeroPoint,
+                                                            &out.validCount, 0.1f, pcCase.coordinateSystem, true, DEPTH_WIDTH * pcCase.colorScale,
+                                                            DEPTH_HEIGHT * pcCase.colorScale, pcCase.y12c4, pcCase.step, width, workerPool);
+    }
+    else {
+        CoordinateUtil::transformationDepthToPointCloud(&xyTables.tables, depth.data(), out.points.data(), pcCase.outputZeroPoint, &out.validCount, 0.1f,
+                                                        pcCase.coordinateSystem, pcCase.y12c4, pcCase.step, width, workerPool);
+    }
+    dropInvalidPoints(pcCase.outputZeroPoint, pcCase.color ? 6 : 3, out);
+}
+
+void testPointCloud(utils::WorkerPool &workerPool) {
+    const PointCloudCase cases[] = {
+        { "depth, dense", false, true, false, OB_RIGHT_HAND_COORDINATE_SYSTEM, 1, 1 },
+        { "depth, compact", false, false, false, OB_RIGHT_HAND_COORDINATE_SYSTEM, 1, 1 },
+        { "depth, compact, Y12C4, left hand", false, false, true, OB_LEFT_HAND_COORDINATE_SYSTEM, 1, 1 },
+        { "depth, dense, step 3", false, true, false, OB_RIGHT_HAND_COORDINATE_SYSTEM, 3, 1 },
+        { "depth, compact, step 2", false, false, false, OB_LEFT_HAND_COORDINATE_SYSTEM, 2, 1 },
+        { "rgbd, dense", true, true, false, OB_RIGHT_HAND_COORDINATE_SYSTEM, 1, 1 },
+        { "rgbd, compact, Y12C4", true, false, true, OB_RIGHT_HAND_COORDINATE_SYSTEM, 1, 1 },
+        { "rgbd, compact, color 2x, left hand", true, false, false, OB_LEFT_HAND_COORDINATE_SYSTEM, 1, 2 },
+        { "rgbd, compact, step 3", true, false, false, OB_RIGHT_HAND_COORDINATE_SYSTEM, 3, 1 },
+    };
+
+    XYTables xyTables;
+    makeXYTables(xyTables);
+
+    for(const auto &pcCase: cases) {
+        auto depth = makeDepth(pcCase.y12c4);
+
+        uint32_t             seed = 11;
+        std::vector<uint8_t> rgb(static_cast<size_t>(DEPTH_WIDTH * DEPTH_HEIGHT) * pcCase.colorScale * pcCase.colorScale * 3);
+        for(auto &value: rgb) {
+            value = static_cast<uint8_t>(nextRandom(seed));
+        }
+
+        Output ref, out;
+        convertOnce(pcCase, xyTables, depth, rgb, utils::SIMD_LEVEL_NONE, nullptr, ref);
+
+        char name[128];
+        if(utils::getCpuSimdLevel() >= utils::SIMD_LEVEL_SSE4_1) {
+            convertOnce(pcCase, xyTables, depth, rgb, utils::SIMD_LEVEL_SSE4_1, nullptr, out);
+            std::snprintf(name, sizeof(name), "%s, SSE", pcCase.name);
+            obtest::report(name, ref == out);
+        }
+        if(utils::getCpuSimdLevel() >= utils::SIMD_LEVEL_AVX2) {
+            convertOnce(pcCase, xyTables, depth, rgb, utils::SIMD_LEVEL_AVX2, nullptr, out);
+            std::snprintf(name, sizeof(name), "%s, AVX2", pcCase.name);
+            obtest::report(name, ref == out);
+        }
+        convertOnce(pcCase, xyTables, depth, rgb, utils::getCpuSimdLevel(), &workerPool, out);
+        std::snprintf(name, sizeof(name), "%s, worker pool", pcCase.name);
+        obtest::report(name, ref == out);
+    }
+    utils::setSimdLevelLimit(utils::SIMD_LEVEL_AVX2);
+}
+
+// The half float planes written by the kernels are the float points converted afterwards (pointsToHalfPlanes)
+void testHalfPlanes(utils::WorkerPool &workerPool) {
+    const PointCloudCase cases[] = {
+        { "depth, dense, half planes", false, true, false, OB_RIGHT_HAND_COORDINATE_SYSTEM, 1, 1 },
+        { "depth, compact, step 2, half planes", false, false, false, OB_LEFT_HAND_COORDINATE_SYSTEM, 2, 1 },
+        { "rgbd, compact, Y12C4, half planes", true, false, true, OB_RIGHT_HAND_COORDINATE_SYSTEM, 1, 1 },
+    };
+
+    XYTables xyTables;
+    makeXYTables(xyTables);
+    std::vector<uint8_t> rgb(static_cast<size_t>(DEPTH_WIDTH * DEPTH_HEIGHT) * 3);
+    uint32_t             seed = 17;
+    for(auto &value: rgb) {
+        value = static_cast<uint8_t>(nextRandom(seed));
+    }
+
+    for(const auto &pcCase: cases) {
+        auto     depth       = makeDepth(pcCase.y12c4);
+        uint32_t pointFloats = pcCase.color ? 6 : 3;
+        Output   ref;
+        convertOnce(pcCase, xyTables, depth, rgb, utils::getCpuSimdLevel(), nullptr, ref);
+        uint32_t              refCount = static_cast<uint32_t>(ref.points.size() / pointFloats);
+        std::vector<uint16_t> expected(ref.points.size());
+        utils::pointsToHalfPlanes(ref.points.data(), refCount, pointFloats, expected.data());
+
+        // planes as far apart as the dense layout, the compacted points leave the end of each plane unused
+        uint32_t              width       = pointsWidth(pcCase.step);
+        size_t                planeStride = static_cast<size_t>(width) * ((DEPTH_HEIGHT + pcCase.step - 1) / pcCase.step);
+        std::vector<uint16_t> planes(planeStride * pointFloats, 0);
+        uint32_t              validCount  = 0;
+        if(pcCase.color) {
+            CoordinateUtil::transformationDepthToRGBDPointCloud(&xyTables.tables, depth.data(), rgb.data(), planes.data(), pcCase.outputZeroPoint, &validCount,
+                                                                0.1f, pcCase.coordinateSystem, true, DEPTH_WIDTH, DEPTH_HEIGHT, pcCase.y12c4, pcCase.step,
+                                                                width, &workerPool, planeStride);
+        }
+        else {
+            CoordinateUtil::transformationDepthToPointCloud(&xyTables.tables, depth.data(), planes.data(), pcCase.outputZeroPoint, &validCount, 0.1f,
+                                                            pcCase.coordinateSystem, pcCase.y12c4, pcCase.step, width, &workerPool, planeStride);
+        }
+
+        bool pass = validCount == ref.validCount;
+        for(uint32_t c = 0; pass && c < pointFloats; c++) {
+            pass = memcmp(planes.data() + c * planeStride, expected.data() + c * refCount, refCount * sizeof(uint16_t)) == 0;
+        }
+        obtest::report(pcCase.name, pass);
+    }
+}
+
+void testUVTablesPointCloud(utils::WorkerPool &workerPool) {
+    XYTables uvTables;
+    makeXYTables(uvTables);
+    // uv tables hold color image coordinates
+    for(int i = 0; i < DEPTH_WIDTH * DEPTH_HEIGHT; i++) {
+        if(!std::isnan(uvTables.tables.xTable[i])) {
+            uvTables.tables.xTable[i] = static_cast<float>(i % DEPTH_WIDTH);
+            uvTables.tables.yTable[i] = static_cast<float>(i / DEPTH_WIDTH);
+        }
+    }
+
+    auto                 depth = makeDepth(false);
+    uint32_t             seed  = 13;
+    std::vector<uint8_t> rgb(DEPTH_WIDTH * DEPTH_HEIGHT * 3);
+    for(auto &value: rgb) {
+        value = static_cast<uint8_t>(nextRandom(seed));
+    }
+
+    auto intrinsic = makeIntrinsic(DEPTH_WIDTH, DEPTH_HEIGHT, 520.0f);
+    for(int outputZeroPoint = 0; outputZeroPoint < 2; outputZeroPoint++) {
+        Output ref, out;
+        for(int pass = 0; pass < 2; pass++) {
+            Output &dst = pass == 0 ? ref : out;
+            dst.points.assign(static_cast<size_t>(pointsWidth(1)) * DEPTH_HEIGHT * 6, 0.0f);
+            dst.validCount = 0;
+            CoordinateUtil::transformationDepthToRGBDPointCloudByUVTables(intrinsic, &uvTables.tables, depth.data(), rgb.data(), dst.points.data(),
+                                                                          outputZeroPoint != 0, &dst.validCount, 0.1f, OB_RIGHT_HAND_COORDINATE_SYSTEM,
+                                                                          false, false, 1, pointsWidth(1), pass == 0 ? nullptr : &workerPool);
+            dropInvalidPoints(outputZeroPoint != 0, 6, dst);
+        }
+        obtest::report(outputZeroPoint ? "rgbd by uv tables, dense, worker pool" : "rgbd by uv tables, compact, worker pool", ref == out);
+    }
+}
+
+void testHalfFloat() {
+    struct {
+        float    value;
+        uint16_t half;
+    } values[] = {
+        { 0.0f, 0x0000 },
+        { -0.0f, 0x8000 },
+        { 1.0f, 0x3C00 },
+        { -2.0f, 0xC000 },
+        { 0.1f, 0x2E66 },
+        { 65504.0f, 0x7BFF },           // largest half
+        { 65520.0f, 0x7C00 },           // rounded to infinity
+        { 1e-8f, 0x0000 },              // underflow
+        { 5.9604645e-8f, 0x0001 },      // smallest subnormal
+        { 6.1035156e-5f, 0x0400 },      // smallest normal
+        { 1.00048828125f, 0x3C00 },     // tie, to even
+        { 1.00146484375f, 0x3C02 },     // tie, to even
+    };
+    bool pass = true;
+    for(const auto &value: values) {
+        if(utils::floatToHalf(value.value) != value.half) {
+            std::printf("floatToHalf(%g) = 0x%04X, expected 0x%04X\n", value.value, utils::floatToHalf(value.value), value.half);
+            pass = false;
+        }
+    }
+    uint16_t nan = utils::floatToHalf(std::numeric_limits<float>::quiet_NaN());
+    pass         = pass && (nan & 0x7C00) == 0x7C00 && (nan & 0x03FF) != 0;
+    obtest::report("float to half", pass);
+
+    const float points[] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+    uint16_t    planes[6];
+    utils::pointsToHalfPlanes(points, 2, 3, planes);
+    const uint16_t expected[] = { 0x3C00, 0x4400, 0x4000, 0x4500, 0x4200, 0x4600 };  // 1 4, 2 5, 3 6
+    obtest::report("points to half planes", memcmp(planes, expected, sizeof(planes)) == 0);
+}
+
+}  // namespace
+
+int main() {
+    utils::WorkerPool workerPool(4);
+
+    testPointCloud(workerPool);
+    testHalfPlanes(workerPool);
+    testUVTablesPointCloud(workerPool);
+    testHalfFloat();
+
+    return obtest::result();
+}
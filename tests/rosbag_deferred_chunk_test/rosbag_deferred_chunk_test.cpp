@@ -0,0 +1,140 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Deferred chunk mode of rosbag::Bag, as used by the recording writer: write() only serializes the messages, the finished chunks are
+// compressed on other threads and written back in order with writeDeferredChunk(), the last chunk is written by close(). Each case writes
+// image messages of several sizes on two topics, reads the file back with a View and checks every message byte for byte.
+//
+// usage: rosbag_deferred_chunk_test [output directory]
+
+#include "rosbag/bag.h"
+#include "rosbag/view.h"
+#include "sensor_msgs/Image.h"
+#include "ObTestCase.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const uint32_t MESSAGE_COUNT = 120;
+
+std::string topicOf(uint32_t index) {
+    return index % 3 == 0 ? "/test/depth" : "/test/color";
+}
+
+orbbecRosbag::Time timeOf(uint32_t index) {
+    return orbbecRosbag::Time(1000 + index / 30, (index % 30) * 33333333);
+}
+
+// Sizes from a few bytes (below the chunk threshold) to several chunks worth, with compressible and noisy data
+sensor_msgs::Image makeImage(uint32_t index) {
+    sensor_msgs::Image image;
+    image.header.stamp = timeOf(index);
+    image.width        = index;
+    image.number       = index;
+    image.encoding     = "Y16";
+
+    uint32_t size = (index % 7 == 0) ? 1500000 + index : 1 + (index * 7919) % 200000;
+    image.data.resize(size);
+    uint32_t seed = index * 2654435761u;
+    for(uint32_t i = 0; i < size; i++) {
+        if(i % 4 == 0) {
+            seed = seed * 1103515245u + 12345u;
+        }
+        image.data[i] = (index % 2) ? static_cast<uint8_t>(seed >> 24) : static_cast<uint8_t>(i / 64);
+    }
+    return image;
+}
+
+bool writeBag(const std::string &path, rosbag::CompressionType compression, size_t *chunkCount) {
+    rosbag::Bag bag;
+    bag.open(path, rosbag::bagmode::Write);
+    bag.setCompression(compression);
+
+    std::vector<std::shared_ptr<rosbag::Bag::DeferredChunk>> chunks;
+    bag.setDeferredChunkCallback([&chunks](std::shared_ptr<rosbag::Bag::DeferredChunk> chunk) { chunks.push_back(chunk); });
+
+    size_t written = 0;
+    for(uint32_t i = 0; i < MESSAGE_COUNT; i++) {
+        bag.write(topicOf(i), timeOf(i), makeImage(i));
+
+        // Compress the chunks collected so far on two threads each taking every other chunk, then write them in order
+        if(chunks.size() - written >= 4 || i + 1 == MESSAGE_COUNT) {
+            std::vector<std::thread> threads;
+            for(size_t t = 0; t < 2; t++) {
+                threads.emplace_back([&chunks, written, t] {
+                    for(size_t c = written + t; c < chunks.size(); c += 2) {
+                        rosbag::Bag::compressDeferredChunk(*chunks[c]);
+                    }
+                });
+            }
+            for(auto &thread: threads) {
+                thread.join();
+            }
+            for(; written < chunks.size(); written++) {
+                bag.writeDeferredChunk(*chunks[written]);
+            }
+        }
+    }
+    bag.close();
+    *chunkCount = chunks.size() + 1;
+    return written == chunks.size();
+}
+
+bool readBag(const std::string &path) {
+    rosbag::Bag bag;
+    bag.open(path, rosbag::bagmode::Read);
+    rosbag::View view(bag);
+
+    uint32_t count = 0;
+    for(rosbag::MessageInstance const &msg: view) {
+        auto image = msg.instantiate<sensor_msgs::Image>();
+        if(!image) {
+            std::printf("  message %u is not an image\n", count);
+            return false;
+        }
+        uint32_t index    = image->number;
+        auto     expected = makeImage(index);
+        if(msg.getTopic() != topicOf(index) || msg.getTime() != timeOf(index) || image->width != index || image->encoding != expected.encoding
+           || image->data != expected.data) {
+            std::printf("  message %u (%s) differs\n", index, msg.getTopic().c_str());
+            return false;
+        }
+        count++;
+    }
+    if(count != MESSAGE_COUNT) {
+        std::printf("  %u of %u messages read back\n", count, MESSAGE_COUNT);
+        return false;
+    }
+    return true;
+}
+
+void testRoundTrip(const std::string &dir, const char *name, rosbag::CompressionType compression) {
+    std::string path   = dir + "/deferred_" + name + ".bag";
+    bool        pass   = false;
+    size_t      chunks = 0;
+    try {
+        pass = writeBag(path, compression, &chunks) && readBag(path);
+    }
+    catch(const std::exception &e) {
+        std::printf("  exception: %s\n", e.what());
+    }
+    std::printf("  %s: %zu chunks\n", name, chunks);
+    std::remove(path.c_str());
+    obtest::report(name, pass && chunks > 1);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    std::string dir = argc > 1 ? argv[1] : ".";
+
+    testRoundTrip(dir, "uncompressed", rosbag::compression::Uncompressed);
+    testRoundTrip(dir, "lz4", rosbag::compression::LZ4);
+
+    return obtest::result();
+}
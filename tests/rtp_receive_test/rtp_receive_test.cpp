@@ -0,0 +1,328 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Frame assembly of the RTP receiver (ObRTPUDPClient). A local UDP sender plays the device: it packetizes Y16 depth frames the way the
+// network cameras do (96 bytes of big endian metadata ahead of big endian pixels, 1460 payload bytes per packet, marker bit on the last one)
+// and sends them to the receiver over the loopback interface, in order, reordered, with a lost packet, with duplicates, with frames running
+// into each other and from a foreign address. Each case checks the delivered frames byte for byte and the packet counters of the receiver.
+//
+// usage: rtp_receive_test
+
+#include "ethernet/rtp/ObRTPUDPClient.hpp"
+#include "stream/StreamProfileFactory.hpp"
+#include "frame/Frame.hpp"
+#include "ObTestCase.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t WIDTH           = 160;
+const uint32_t HEIGHT          = 120;
+const uint32_t METADATA_SIZE   = ObRTPPacketProcessor::RTP_FIX_METADATA_SIZE;
+const uint32_t PAYLOAD_SIZE    = ObRTPPacketProcessor::RTP_PAYLOAD_SIZE;
+const uint16_t RECEIVER_PORT   = 26400;
+const char    *DEVICE_ADDRESS  = "127.0.0.1";
+const char    *FOREIGN_ADDRESS = "127.0.0.2";
+const int      WAIT_TIMEOUT_MS = 3000;
+
+struct Packet {
+    std::vector<uint8_t> data;
+};
+
+// Pixel values and metadata of frame n, as the host sees them after the byte swaps
+uint16_t pixelValue(uint32_t frameIndex, uint32_t pixel) {
+    return static_cast<uint16_t>(pixel * 7 + frameIndex * 131);
+}
+
+uint32_t metadataValue(uint32_t frameIndex, uint32_t word) {
+    return 0x01020300u + word + (frameIndex << 24);
+}
+
+std::vector<Packet> packetizeFrame(uint32_t frameIndex) {
+    std::vector<uint8_t> stream(METADATA_SIZE + WIDTH * HEIGHT * 2);
+    for(uint32_t i = 0; i < METADATA_SIZE / 4; i++) {
+        uint32_t value = htonl(metadataValue(frameIndex, i));
+        memcpy(&stream[i * 4], &value, 4);
+    }
+    for(uint32_t i = 0; i < WIDTH * HEIGHT; i++) {
+        uint16_t value = pixelValue(frameIndex, i);
+        stream[METADATA_SIZE + i * 2]     = static_cast<uint8_t>(value >> 8);
+        stream[METADATA_SIZE + i * 2 + 1] = static_cast<uint8_t>(value & 0xFF);
+    }
+
+    std::vector<Packet> packets;
+    uint32_t            count = static_cast<uint32_t>((stream.size() + PAYLOAD_SIZE - 1) / PAYLOAD_SIZE);
+    for(uint32_t n = 0; n < count; n++) {
+        uint32_t size = std::min<uint32_t>(PAYLOAD_SIZE, static_cast<uint32_t>(stream.size()) - n * PAYLOAD_SIZE);
+        Packet   packet;
+        packet.data.resize(ObRTPPacketProcessor::RTP_HEADER_SIZE + size);
+        RTPHeader *header      = reinterpret_cast<RTPHeader *>(packet.data.data());
+        header->version        = 2;
+        header->marker         = (n + 1 == count) ? 1 : 0;
+        header->sequenceNumber = htons(static_cast<uint16_t>(n));
+        header->timestamp      = 1000 + frameIndex;
+        memcpy(packet.data.data() + ObRTPPacketProcessor::RTP_HEADER_SIZE, &stream[n * PAYLOAD_SIZE], size);
+        packets.push_back(packet);
+    }
+    return packets;
+}
+
+class Sender {
+public:
+    explicit Sender(const char *address) {
+        socket_ = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        inet_pton(AF_INET, address, &addr.sin_addr);
+        bind(socket_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    }
+
+    ~Sender() {
+        closesocket(socket_);
+    }
+
+    // Sends the first packet on its own, then the rest in bursts of 8 or all at once, so the receiver sees both single packets and batches
+    void send(const std::vector<Packet> &packets, uint16_t port, bool burst = false) {
+        sockaddr_in dest{};
+        dest.sin_family = AF_INET;
+        dest.sin_port   = htons(port);
+        inet_pton(AF_INET, DEVICE_ADDRESS, &dest.sin_addr);
+        for(size_t i = 0; i < packets.size(); i++) {
+            sendto(socket_, reinterpret_cast<const char *>(packets[i].data.data()), static_cast<int>(packets[i].data.size()), 0,
+                   reinterpret_cast<const sockaddr *>(&dest), sizeof(dest));
+            if(i == 0 || (!burst && i % 8 == 0)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+private:
+    SOCKET socket_;
+};
+
+class Receiver {
+public:
+    Receiver() : client_(DEVICE_ADDRESS, DEVICE_ADDRESS, RECEIVER_PORT) {
+        auto profile = StreamProfileFactory::createVideoStreamProfile(OB_STREAM_DEPTH, OB_FORMAT_Y16, WIDTH, HEIGHT, 30);
+        client_.start(profile, [this](std::shared_ptr<Frame> frame) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            frames_.push_back(frame);
+        });
+    }
+
+    ~Receiver() {
+        client_.close();
+    }
+
+    uint16_t getPort() {
+        return client_.getPort();
+    }
+
+    RTPStreamStats getStats() {
+        return client_.getStats();
+    }
+
+    // Waits until the receiver has seen the given number of packets and delivered the given number of frames
+    std::vector<std::shared_ptr<Frame>> waitFrames(size_t frameCount, uint64_t packetCount) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(WAIT_TIMEOUT_MS);
+        while(std::chrono::steady_clock::now() < deadline) {
+            auto stats = client_.getStats();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                uint64_t seen = stats.packets + stats.duplicatePackets + stats.foreignPackets + stats.discardedPackets;
+                if(frames_.size() >= frameCount && seen >= packetCount) {
+                    break;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        return frames_;
+    }
+
+private:
+    ObRTPUDPClient                      client_;
+    std::mutex                          mutex_;
+    std::vector<std::shared_ptr<Frame>> frames_;
+};
+
+bool checkFrame(const std::shared_ptr<Frame> &frame, uint32_t frameIndex) {
+    if(frame->getDataSize() != WIDTH * HEIGHT * 2 || frame->getTimeStampUsec() != 1000 + frameIndex) {
+        return false;
+    }
+    const uint16_t *pixels = reinterpret_cast<const uint16_t *>(frame->getData());
+    for(uint32_t i = 0; i < WIDTH * HEIGHT; i++) {
+        if(pixels[i] != pixelValue(frameIndex, i)) {
+            return false;
+        }
+    }
+    // 12 reserved bytes ahead of the metadata words
+    const uint8_t *metadata = frame->getMetadata();
+    for(uint32_t i = 0; i < METADATA_SIZE / 4; i++) {
+        uint32_t value;
+        memcpy(&value, metadata + 12 + i * 4, 4);
+        if(value != metadataValue(frameIndex, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t countPackets(const std::vector<std::vector<Packet>> &frames) {
+    uint64_t count = 0;
+    for(const auto &packets: frames) {
+        count += packets.size();
+    }
+    return count;
+}
+
+void sendFrames(Sender &sender, Receiver &receiver, const std::vector<std::vector<Packet>> &frames, bool burst = false) {
+    for(const auto &packets: frames) {
+        sender.send(packets, receiver.getPort(), burst);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+void testInOrder() {
+    Receiver                         receiver;
+    Sender                           sender(DEVICE_ADDRESS);
+    std::vector<std::vector<Packet>> frames;
+    for(uint32_t i = 0; i < 4; i++) {
+        frames.push_back(packetizeFrame(i));
+    }
+    sendFrames(sender, receiver, frames);
+
+    auto received = receiver.waitFrames(frames.size(), countPackets(frames));
+    bool pass     = received.size() == frames.size();
+    for(size_t i = 0; pass && i < received.size(); i++) {
+        pass = checkFrame(received[i], static_cast<uint32_t>(i)) && received[i]->getNumber() == i + 1;
+    }
+    auto stats = receiver.getStats();
+    pass       = pass && stats.framesCompleted == frames.size() && stats.framesDropped == 0 && stats.lostPackets == 0;
+    // the first packet of a frame carries the metadata and is always copied, most of the others must land in place
+    pass = pass && stats.copiedPackets < stats.packets;
+    std::printf("    %llu packets, %llu copied\n", static_cast<unsigned long long>(stats.packets), static_cast<unsigned long long>(stats.copiedPackets));
+    obtest::report("in order", pass);
+}
+
+void testReordered() {
+    Receiver                         receiver;
+    Sender                           sender(DEVICE_ADDRESS);
+    std::vector<std::vector<Packet>> frames;
+    for(uint32_t i = 0; i < 3; i++) {
+        auto packets = packetizeFrame(i);
+        // swap two packets in the middle and let the marker packet overtake the two before it
+        std::swap(packets[5], packets[9]);
+        std::rotate(packets.end() - 3, packets.end() - 1, packets.end());
+        frames.push_back(packets);
+    }
+    // in one burst, so the swapped packets are likely received in the same batch
+    sendFrames(sender, receiver, frames, true);
+
+    auto received = receiver.waitFrames(frames.size(), countPackets(frames));
+    bool pass     = received.size() == frames.size();
+    for(size_t i = 0; pass && i < received.size(); i++) {
+        pass = checkFrame(received[i], static_cast<uint32_t>(i));
+    }
+    auto stats = receiver.getStats();
+    pass       = pass && stats.framesDropped == 0 && stats.reorderedPackets >= 3 * frames.size();
+    obtest::report("reordered packets", pass);
+}
+
+void testLoss() {
+    Receiver                         receiver;
+    Sender                           sender(DEVICE_ADDRESS);
+    std::vector<std::vector<Packet>> frames;
+    for(uint32_t i = 0; i < 3; i++) {
+        frames.push_back(packetizeFrame(i));
+    }
+    frames[1].erase(frames[1].begin() + 11);
+    sendFrames(sender, receiver, frames);
+
+    auto received = receiver.waitFrames(2, countPackets(frames));
+    auto stats    = receiver.getStats();
+    bool pass     = received.size() == 2 && checkFrame(received[0], 0) && checkFrame(received[1], 2);
+    pass          = pass && stats.framesDropped == 1 && stats.lostPackets == 1;
+    obtest::report("lost packet", pass);
+}
+
+void testDuplicate() {
+    Receiver                         receiver;
+    Sender                           sender(DEVICE_ADDRESS);
+    std::vector<std::vector<Packet>> frames;
+    for(uint32_t i = 0; i < 2; i++) {
+        auto packets = packetizeFrame(i);
+        packets.insert(packets.begin() + 4, packets[3]);
+        packets.insert(packets.begin() + 8, packets[2]);
+        frames.push_back(packets);
+    }
+    sendFrames(sender, receiver, frames);
+
+    auto received = receiver.waitFrames(frames.size(), countPackets(frames));
+    auto stats    = receiver.getStats();
+    bool pass     = received.size() == frames.size() && checkFrame(received[0], 0) && checkFrame(received[1], 1);
+    pass          = pass && stats.framesDropped == 0 && stats.duplicatePackets == 4;
+    obtest::report("duplicate packets", pass);
+}
+
+void testTimestampChange() {
+    Receiver                         receiver;
+    Sender                           sender(DEVICE_ADDRESS);
+    std::vector<std::vector<Packet>> frames;
+    for(uint32_t i = 0; i < 4; i++) {
+        frames.push_back(packetizeFrame(i));
+    }
+    // frame 1 loses its end and frame 2 its first packet: the packets of frame 2 must not complete frame 1
+    frames[1].erase(frames[1].end() - 3, frames[1].end());
+    frames[2].erase(frames[2].begin());
+    sendFrames(sender, receiver, frames);
+
+    auto received = receiver.waitFrames(2, countPackets(frames));
+    auto stats    = receiver.getStats();
+    bool pass     = received.size() == 2 && checkFrame(received[0], 0) && checkFrame(received[1], 3);
+    pass          = pass && stats.framesDropped == 1 && stats.discardedPackets == frames[2].size();
+    obtest::report("timestamp change", pass);
+}
+
+void testForeign() {
+    Receiver receiver;
+    Sender   device(DEVICE_ADDRESS);
+    Sender   foreign(FOREIGN_ADDRESS);
+
+    // a frame from another host in the middle of the device frames must not end up in them
+    auto packets = packetizeFrame(0);
+    for(size_t i = 0; i < packets.size(); i++) {
+        device.send(std::vector<Packet>(1, packets[i]), receiver.getPort());
+        if(i == 6) {
+            auto other = packetizeFrame(9);
+            foreign.send(std::vector<Packet>(other.begin() + 7, other.begin() + 12), receiver.getPort());
+        }
+    }
+
+    auto received = receiver.waitFrames(1, packets.size() + 5);
+    auto stats    = receiver.getStats();
+    bool pass     = received.size() == 1 && checkFrame(received[0], 0) && stats.foreignPackets == 5;
+    obtest::report("foreign source address", pass);
+}
+
+}  // namespace
+
+int main() {
+    testInOrder();
+    testReordered();
+    testLoss();
+    testDuplicate();
+    testTimestampChange();
+    testForeign();
+
+    return obtest::result();
+}
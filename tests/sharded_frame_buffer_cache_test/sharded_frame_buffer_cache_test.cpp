@@ -0,0 +1,168 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Size class sharded frame buffer cache (ShardedFrameBufferCache) on top of the frame memory allocator. The cases check the rounding of the
+// requested sizes to the size classes, the reuse of the reclaimed buffers, the memory budget of the allocator covering the in-use and the
+// cached buffers, the pre-allocation of idle buffers (also through a frame buffer manager, as the pipeline does before starting the
+// streams) and the cache once detached from its allocator.
+//
+// usage: sharded_frame_buffer_cache_test
+
+#include "frame/ShardedFrameBufferCache.hpp"
+#include "frame/FrameBufferManager.hpp"
+#include "frame/FrameMemoryPool.hpp"
+#include "ObTestCase.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint64_t BUDGET_MB   = 100;
+const size_t   BUFFER_SIZE = 8 * 1024 * 1024;  // a size class of its own
+
+void testSizeClasses() {
+    bool   pass         = ShardedFrameBufferCache::sizeClassOf(1) == 0 && ShardedFrameBufferCache::classSizeOf(0) == 256;
+    size_t maxClassSize = 0;
+    size_t maxSize      = static_cast<size_t>(1) << (ShardedFrameBufferCache::kMaxClassSizeShift + 1);
+    for(size_t size = 1; size <= maxSize; size = size * 17 / 16 + 1) {
+        int sizeClass = ShardedFrameBufferCache::sizeClassOf(size);
+        if(sizeClass < 0 || static_cast<size_t>(sizeClass) >= ShardedFrameBufferCache::kSizeClassCount) {
+            pass = false;
+            break;
+        }
+        auto classSize = ShardedFrameBufferCache::classSizeOf(sizeClass);
+        // large enough, at most 12.5% wasted above the smallest class, and growing with the size
+        pass = pass && classSize >= size && (size <= 256 || classSize - size <= size / 8) && classSize >= maxClassSize;
+        // the class size is served by its own class
+        pass         = pass && ShardedFrameBufferCache::sizeClassOf(classSize) == sizeClass;
+        maxClassSize = classSize;
+    }
+    pass = pass && ShardedFrameBufferCache::sizeClassOf(maxSize) == static_cast<int>(ShardedFrameBufferCache::kSizeClassCount - 1);
+    pass = pass && ShardedFrameBufferCache::sizeClassOf(maxSize + 1) == ShardedFrameBufferCache::kInvalidSizeClass;
+    obtest::report("size classes", pass);
+}
+
+void testReuse(std::shared_ptr<FrameMemoryAllocator> allocator) {
+    auto cache = std::make_shared<ShardedFrameBufferCache>(allocator.get());
+
+    // a small buffer comes back from the thread magazine, a large one from the shared free list
+    auto small = cache->acquire(1000);
+    cache->reclaim(small, 1000);
+    bool pass  = cache->acquire(1000) == small;
+    auto large = cache->acquire(BUFFER_SIZE);
+    cache->reclaim(large, BUFFER_SIZE);
+    pass = pass && cache->acquire(BUFFER_SIZE - 1000) == large;
+
+    FrameMemoryAllocatorStats stats{};
+    cache->getStats(stats);
+    pass = pass && stats.magazineHits == 1 && stats.depotHits == 1 && stats.misses == 2;
+
+    cache->reclaim(small, 1000);
+    cache->reclaim(large, BUFFER_SIZE);
+    cache->detach();
+    obtest::report("reclaimed buffers reused", pass);
+}
+
+void testBudget(std::shared_ptr<FrameMemoryAllocator> allocator) {
+    auto cache    = std::make_shared<ShardedFrameBufferCache>(allocator.get());
+    auto maxSize  = BUDGET_MB * 1024 * 1024;
+    auto maxCount = static_cast<size_t>(maxSize / BUFFER_SIZE);
+
+    std::vector<uint8_t *> buffers;
+    while(buffers.size() <= maxCount) {
+        auto ptr = cache->acquire(BUFFER_SIZE);
+        if(!ptr) {
+            break;
+        }
+        buffers.push_back(ptr);
+    }
+    auto stats = allocator->getStats();
+    bool pass  = buffers.size() == maxCount && stats.usedSize == maxCount * BUFFER_SIZE && stats.maxSize == maxSize;
+
+    // the cached buffers are still accounted, and served again without allocation
+    for(auto ptr: buffers) {
+        cache->reclaim(ptr, BUFFER_SIZE);
+    }
+    pass = pass && allocator->getStats().usedSize == maxCount * BUFFER_SIZE;
+    for(auto &ptr: buffers) {
+        ptr = cache->acquire(BUFFER_SIZE);
+        pass = pass && ptr != nullptr;
+    }
+    pass = pass && cache->acquire(BUFFER_SIZE) == nullptr;
+    for(auto ptr: buffers) {
+        cache->reclaim(ptr, BUFFER_SIZE);
+    }
+
+    cache->releaseAllIdle();
+    pass = pass && allocator->getStats().usedSize == 0;
+    cache->detach();
+    obtest::report("memory budget", pass);
+}
+
+void testReserve(std::shared_ptr<FrameMemoryAllocator> allocator) {
+    auto cache     = std::make_shared<ShardedFrameBufferCache>(allocator.get());
+    auto smallSize = cache->classSizeOf(cache->sizeClassOf(1000));
+    auto maxCount  = static_cast<size_t>(BUDGET_MB * 1024 * 1024 / BUFFER_SIZE);
+
+    // capped at the capacity of the free list, already idle buffers are counted
+    bool pass = cache->reserve(1000, ShardedFrameBufferCache::kDepotCapacity + 10) == ShardedFrameBufferCache::kDepotCapacity;
+    pass      = pass && allocator->getStats().usedSize == ShardedFrameBufferCache::kDepotCapacity * smallSize;
+    pass      = pass && cache->reserve(1000, 10) == 10 && allocator->getStats().usedSize == ShardedFrameBufferCache::kDepotCapacity * smallSize;
+    cache->releaseAllIdle();
+
+    // limited by the memory budget
+    pass = pass && cache->reserve(BUFFER_SIZE, maxCount + 4) == maxCount && allocator->getStats().usedSize == maxCount * BUFFER_SIZE;
+    cache->releaseAllIdle();
+    cache->detach();
+    obtest::report("reserve idle buffers", pass);
+}
+
+void testBufferManagerReserve(std::shared_ptr<FrameMemoryAllocator> allocator) {
+    // sharded or not depending on the configuration (Memory.ShardedAllocator)
+    auto bufMgr    = FrameMemoryPool::getInstance()->createFrameBufferManager(OB_FRAME_DEPTH, 640 * 480 * 2);
+    auto totalSize = bufMgr->getFrameBufferTotalSize();
+    auto usedSize  = allocator->getStats().usedSize;
+
+    bool pass = totalSize > bufMgr->getFrameDataBufferSize() && bufMgr->reserveBuffers(5) == 5;
+    pass      = pass && allocator->getStats().usedSize == usedSize + 5 * totalSize;
+    pass      = pass && bufMgr->reserveBuffers(3) == 3 && allocator->getStats().usedSize == usedSize + 5 * totalSize;
+    bufMgr->releaseIdleBuffer();
+    pass = pass && allocator->getStats().usedSize == usedSize;
+    obtest::report("frame buffer manager reserve", pass);
+}
+
+void testDetach(std::shared_ptr<FrameMemoryAllocator> allocator) {
+    auto cache  = std::make_shared<ShardedFrameBufferCache>(allocator.get());
+    auto small  = cache->acquire(1000);
+    auto large  = cache->acquire(BUFFER_SIZE);
+    auto cached = cache->acquire(BUFFER_SIZE);
+    cache->reclaim(cached, BUFFER_SIZE);
+    cache->detach();
+
+    // the cached buffer is returned to the allocator, the buffers still in use are freed on reclaim without the allocator
+    bool pass = allocator->getStats().usedSize == cache->classSizeOf(cache->sizeClassOf(1000)) + BUFFER_SIZE;
+    pass      = pass && cache->acquire(1000) == nullptr && cache->acquire(BUFFER_SIZE) == nullptr && cache->reserve(BUFFER_SIZE, 1) == 0;
+    cache->reclaim(small, 1000);
+    cache->reclaim(large, BUFFER_SIZE);
+    obtest::report("detached cache", pass);
+}
+
+}  // namespace
+
+int main() {
+    auto allocator = FrameMemoryAllocator::getInstance();
+    allocator->setMaxFrameMemorySize(BUDGET_MB);
+
+    testSizeClasses();
+    testReuse(allocator);
+    testBudget(allocator);
+    testReserve(allocator);
+    testBufferManagerReserve(allocator);
+    testDetach(allocator);
+
+    return obtest::result();
+}
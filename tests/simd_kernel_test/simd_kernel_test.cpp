@@ -0,0 +1,196 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Bit-exactness of the runtime-dispatched SIMD kernels. Each case runs the same synthetic input through a reference path and the AVX2 path
+// and compares the outputs byte for byte:
+//   - alignment: the SSE kernels of AlignImpl are the reference (AlignImplGeneric has no D2C implementation yet)
+//   - undistortion: UnDistortionImplGeneric is the reference for UnDistortionImplSSE, run with the SSE and with the AVX2 kernels
+// The cases are skipped on CPUs without AVX2.
+//
+// usage: simd_kernel_test
+
+#include "AlignImpl.hpp"
+#include "UnDistortionImplSSE.hpp"
+#include "utils/CpuFeatures.hpp"
+#include "ObTestCase.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const int DEPTH_WIDTH  = 640;
+const int DEPTH_HEIGHT = 480;
+const int COLOR_WIDTH  = 1280;
+const int COLOR_HEIGHT = 720;
+
+// not a multiple of 8, so the rows end with the SSE and scalar tails
+const int IMAGE_WIDTH  = 643;
+const int IMAGE_HEIGHT = 481;
+
+// Deterministic pseudo random input, a failure always reproduces
+uint32_t nextRandom(uint32_t &state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+OBCameraIntrinsic makeIntrinsic(int width, int height, float focal) {
+    OBCameraIntrinsic intrinsic;
+    intrinsic.fx     = focal;
+    intrinsic.fy     = focal * 1.002f;
+    intrinsic.cx     = width * 0.5f + 1.3f;
+    intrinsic.cy     = height * 0.5f - 2.1f;
+    intrinsic.width  = static_cast<int16_t>(width);
+    intrinsic.height = static_cast<int16_t>(height);
+    return intrinsic;
+}
+
+OBCameraDistortion makeDistortion(OBCameraDistortionModel model) {
+    OBCameraDistortion distortion;
+    memset(&distortion, 0, sizeof(distortion));
+    distortion.model = model;
+    switch(model) {
+    case OB_DISTORTION_BROWN_CONRADY:
+        distortion.k1 = 0.08f;
+        distortion.k2 = -0.2f;
+        distortion.k3 = 0.09f;
+        distortion.p1 = 0.0006f;
+        distortion.p2 = -0.0004f;
+        break;
+    case OB_DISTORTION_BROWN_CONRADY_K6:
+        distortion.k1 = 0.52f;
+        distortion.k2 = -0.11f;
+        distortion.k3 = 0.012f;
+        distortion.k4 = 0.47f;
+        distortion.k5 = -0.083f;
+        distortion.k6 = 0.0081f;
+        distortion.p1 = 0.0002f;
+        distortion.p2 = 0.0003f;
+        break;
+    case OB_DISTORTION_KANNALA_BRANDT4:
+        distortion.k1 = 0.021f;
+        distortion.k2 = -0.0043f;
+        distortion.k3 = 0.0012f;
+        distortion.k4 = -0.0002f;
+        break;
+    default:
+        break;
+    }
+    return distortion;
+}
+
+struct AlignCase {
+    const char             *name;
+    bool                    addTargetDistortion;
+    OBCameraDistortionModel model;
+    bool                    gapFillCopy;
+    OBFormat                format;
+};
+
+void alignOnce(const AlignCase &alignCase, utils::SimdLevel level, const std::vector<uint16_t> &depth, std::vector<uint16_t> &out, std::vector<int> &map) {
+    OBCameraDistortion depthDisto;
+    memset(&depthDisto, 0, sizeof(depthDisto));
+    OBExtrinsic extrinsic = { { 0.9999f, -0.0087f, 0.0102f, 0.0088f, 0.9999f, -0.0041f, -0.0101f, 0.0042f, 0.9999f }, { -25.1f, 0.4f, 1.7f } };
+
+    utils::setSimdLevelLimit(level);
+    AlignImpl impl;
+    impl.initialize(makeIntrinsic(DEPTH_WIDTH, DEPTH_HEIGHT, 475.0f), depthDisto, makeIntrinsic(COLOR_WIDTH, COLOR_HEIGHT, 690.0f),
+                    makeDistortion(alignCase.model), extrinsic, 1.0f, alignCase.addTargetDistortion, alignCase.gapFillCopy, false, alignCase.format, 65535);
+    out.assign(COLOR_WIDTH * COLOR_HEIGHT, 0);
+    map.assign(2 * DEPTH_WIDTH * DEPTH_HEIGHT, -1);
+    impl.D2C(depth.data(), DEPTH_WIDTH, DEPTH_HEIGHT, out.data(), COLOR_WIDTH, COLOR_HEIGHT, map.data(), true);
+}
+
+void testAlign() {
+    const AlignCase cases[] = {
+        { "align linear, gap fill copy", false, OB_DISTORTION_NONE, true, OB_FORMAT_Y16 },
+        { "align linear, gap fill nearest", false, OB_DISTORTION_NONE, false, OB_FORMAT_Y16 },
+        { "align linear Y12C4", false, OB_DISTORTION_NONE, true, OB_FORMAT_Y12C4 },
+        { "align K3, gap fill copy", true, OB_DISTORTION_BROWN_CONRADY, true, OB_FORMAT_Y16 },
+        { "align K3, gap fill nearest", true, OB_DISTORTION_BROWN_CONRADY, false, OB_FORMAT_Y16 },
+        { "align K6, gap fill copy", true, OB_DISTORTION_BROWN_CONRADY_K6, true, OB_FORMAT_Y16 },
+        { "align K6, gap fill nearest", true, OB_DISTORTION_BROWN_CONRADY_K6, false, OB_FORMAT_Y16 },
+        { "align K6 Y12C4", true, OB_DISTORTION_BROWN_CONRADY_K6, false, OB_FORMAT_Y12C4 },
+        { "align KB4, gap fill copy", true, OB_DISTORTION_KANNALA_BRANDT4, true, OB_FORMAT_Y16 },
+        { "align KB4, gap fill nearest", true, OB_DISTORTION_KANNALA_BRANDT4, false, OB_FORMAT_Y16 },
+    };
+
+    for(const auto &alignCase: cases) {
+        // depth from 0.3m to 5m with a few holes; Y12C4 keeps 4 low bits next to the 12-bit depth
+        uint32_t              seed = 7;
+        std::vector<uint16_t> depth(DEPTH_WIDTH * DEPTH_HEIGHT);
+        for(auto &value: depth) {
+            uint32_t r = nextRandom(seed);
+            if(alignCase.format == OB_FORMAT_Y12C4) {
+                value = (r % 16 == 0) ? 0 : static_cast<uint16_t>(((300 + r % 3700) << 4) | (r >> 16 & 0xF));
+            }
+            else {
+                value = (r % 16 == 0) ? 0 : static_cast<uint16_t>(300 + r % 4700);
+            }
+        }
+
+        std::vector<uint16_t> refOut, avx2Out;
+        std::vector<int>      refMap, avx2Map;
+        alignOnce(alignCase, utils::SIMD_LEVEL_SSE4_1, depth, refOut, refMap);
+        alignOnce(alignCase, utils::SIMD_LEVEL_AVX2, depth, avx2Out, avx2Map);
+        obtest::report(alignCase.name, refOut == avx2Out && refMap == avx2Map);
+    }
+}
+
+void undistortOnce(UnDistortionImplGeneric &impl, OBFormat format, const std::vector<uint8_t> &src, std::vector<uint8_t> &dst) {
+    impl.initialize(makeIntrinsic(IMAGE_WIDTH, IMAGE_HEIGHT, 520.0f), makeDistortion(OB_DISTORTION_BROWN_CONRADY), nullptr, format, UNDIST_INTERP_BILINEAR);
+    dst.assign(src.size(), 0);
+    impl.undistort(src.data(), dst.data(), IMAGE_WIDTH, IMAGE_HEIGHT, format);
+}
+
+void testUnDistortion() {
+    const struct {
+        const char *name;
+        OBFormat    format;
+        int         bytesPerPixel;
+    } cases[] = {
+        { "undistortion Y8", OB_FORMAT_Y8, 1 },
+        { "undistortion RGB", OB_FORMAT_RGB, 3 },
+        { "undistortion RGBA", OB_FORMAT_RGBA, 4 },
+    };
+
+    for(const auto &undistCase: cases) {
+        uint32_t             seed = 11;
+        std::vector<uint8_t> src(IMAGE_WIDTH * IMAGE_HEIGHT * undistCase.bytesPerPixel);
+        for(auto &value: src) {
+            value = static_cast<uint8_t>(nextRandom(seed));
+        }
+
+        std::vector<uint8_t>    refDst, sseDst, avx2Dst;
+        UnDistortionImplGeneric generic;
+        UnDistortionImplSSE     sse;
+        undistortOnce(generic, undistCase.format, src, refDst);
+        utils::setSimdLevelLimit(utils::SIMD_LEVEL_SSE4_1);
+        undistortOnce(sse, undistCase.format, src, sseDst);
+        utils::setSimdLevelLimit(utils::SIMD_LEVEL_AVX2);
+        undistortOnce(sse, undistCase.format, src, avx2Dst);
+
+        char name[128];
+        std::snprintf(name, sizeof(name), "%s, SSE", undistCase.name);
+        obtest::report(name, refDst == sseDst);
+        std::snprintf(name, sizeof(name), "%s, AVX2", undistCase.name);
+        obtest::report(name, refDst == avx2Dst);
+    }
+}
+
+}  // namespace
+
+int main() {
+    if(utils::getCpuSimdLevel() < utils::SIMD_LEVEL_AVX2) {
+        std::printf("[CASE][SKIP] the CPU does not support AVX2\n");
+        return 0;
+    }
+
+    testAlign();
+    testUnDistortion();
+
+    return obtest::result();
+}
@@ -0,0 +1,166 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Vendor data port answering the vendor protocol (protocol/Protocol.hpp) from memory: structure data, v1.1 structure data lists and raw
+// data per property id. Counts the control transfers, each one takes transferDelayUs to simulate the device round-trip.
+
+#pragma once
+
+#include "ISourcePort.hpp"
+#include "protocol/Protocol.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace libobsensor {
+
+class MockVendorPort : public IVendorDataPort {
+public:
+    explicit MockVendorPort(uint32_t transferDelayUs = 0) : transferDelayUs_(transferDelayUs), transferCount_(0) {}
+
+    std::shared_ptr<const SourcePortInfo> getSourcePortInfo() const override {
+        return nullptr;
+    }
+
+    void setStructureData(uint32_t propertyId, const std::vector<uint8_t> &data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        structureData_[propertyId] = data;
+    }
+
+    void setStructureDataList(uint32_t propertyId, uint16_t cmdVersion, const std::vector<uint8_t> &data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        structureDataLists_[propertyId] = std::make_pair(cmdVersion, data);
+    }
+
+    void setRawData(uint32_t propertyId, const std::vector<uint8_t> &data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rawData_[propertyId] = data;
+    }
+
+    uint32_t getTransferCount() const {
+        return transferCount_;
+    }
+
+    uint32_t sendAndReceive(const uint8_t *sendData, uint32_t sendLen, uint8_t *recvData, uint32_t exceptedRecvLen, utils::TransferTiming *timing) override {
+        (void)sendLen;
+        (void)timing;
+        transferCount_++;
+        if(transferDelayUs_) {
+            std::this_thread::sleep_for(std::chrono::microseconds(transferDelayUs_));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        protocol::ReqHeader         reqHeader;
+        memcpy(&reqHeader, sendData, sizeof(reqHeader));
+        uint32_t propertyId = 0;
+        memcpy(&propertyId, sendData + sizeof(reqHeader), sizeof(propertyId));
+
+        std::vector<uint8_t> payload;
+        uint16_t             errorCode = protocol::HP_RESP_OK;
+        switch(reqHeader.opcode) {
+        case protocol::OPCODE_GET_STRUCTURE_DATA: {
+            auto iter = structureData_.find(propertyId);
+            if(iter == structureData_.end()) {
+                errorCode = protocol::HP_RESP_ERROR_UNKNOWN;
+                break;
+            }
+            payload = iter->second;
+        } break;
+        case protocol::OPCODE_SET_STRUCTURE_DATA_V1_1:
+            break;
+        case protocol::OPCODE_INIT_READ_STRUCT_DATA_LIST_V1_1: {
+            auto iter = structureDataLists_.find(propertyId);
+            if(iter == structureDataLists_.end()) {
+                errorCode = protocol::HP_RESP_ERROR_UNKNOWN;
+                break;
+            }
+            append(payload, iter->second.first);
+            append(payload, static_cast<uint32_t>(iter->second.second.size()));
+        } break;
+        case protocol::OPCODE_READ_STRUCT_DATA_LIST_V1_1: {
+            auto iter = structureDataLists_.find(propertyId);
+            if(iter == structureDataLists_.end()) {
+                errorCode = protocol::HP_RESP_ERROR_UNKNOWN;
+                break;
+            }
+            payload = slice(sendData, iter->second.second);
+        } break;
+        case protocol::OPCODE_INIT_READ_RAW_DATA: {
+            auto iter = rawData_.find(propertyId);
+            if(iter == rawData_.end()) {
+                errorCode = protocol::HP_RESP_ERROR_UNKNOWN;
+                break;
+            }
+            append(payload, static_cast<uint32_t>(iter->second.size()));
+        } break;
+        case protocol::OPCODE_READ_RAW_DATA: {
+            auto iter = rawData_.find(propertyId);
+            if(iter == rawData_.end()) {
+                errorCode = protocol::HP_RESP_ERROR_UNKNOWN;
+                break;
+            }
+            payload = slice(sendData, iter->second);
+        } break;
+        case protocol::OPCODE_FINISH_READ_STRUCT_DATA_LIST_V1_1:
+        case protocol::OPCODE_FINISH_READ_RAW_DATA:
+            break;
+        default:
+            errorCode = protocol::HP_RESP_ERROR_UNKNOWN;
+            break;
+        }
+
+        if(payload.size() % 2) {
+            payload.push_back(0);  // the response size is in half words
+        }
+        protocol::RespHeader respHeader;
+        respHeader.magic           = HP_RESPONSE_MAGIC;
+        respHeader.sizeInHalfWords = static_cast<uint16_t>((payload.size() + sizeof(respHeader.errorCode)) / 2);
+        respHeader.opcode          = reqHeader.opcode;
+        respHeader.requestId       = reqHeader.requestId;
+        respHeader.errorCode       = errorCode;
+
+        uint32_t respSize = static_cast<uint32_t>(sizeof(respHeader) + payload.size());
+        if(respSize > exceptedRecvLen) {
+            respSize = exceptedRecvLen;
+        }
+        memcpy(recvData, &respHeader, sizeof(respHeader));
+        if(!payload.empty() && respSize > sizeof(respHeader)) {
+            memcpy(recvData + sizeof(respHeader), payload.data(), respSize - sizeof(respHeader));
+        }
+        return respSize;
+    }
+
+private:
+    template <typename T> static void append(std::vector<uint8_t> &payload, T value) {
+        auto begin = reinterpret_cast<const uint8_t *>(&value);
+        payload.insert(payload.end(), begin, begin + sizeof(value));
+    }
+
+    // offset and size of a GetStructureDataListReq or ReadRawDataReq
+    static std::vector<uint8_t> slice(const uint8_t *sendData, const std::vector<uint8_t> &data) {
+        uint32_t offset = 0, size = 0;
+        memcpy(&offset, sendData + sizeof(protocol::ReqHeader) + sizeof(uint32_t), sizeof(offset));
+        memcpy(&size, sendData + sizeof(protocol::ReqHeader) + 2 * sizeof(uint32_t), sizeof(size));
+        if(offset >= data.size()) {
+            return {};
+        }
+        size = std::min<uint32_t>(size, static_cast<uint32_t>(data.size()) - offset);
+        return std::vector<uint8_t>(data.begin() + offset, data.begin() + offset + size);
+    }
+
+    uint32_t              transferDelayUs_;
+    std::atomic<uint32_t> transferCount_;
+    std::mutex            mutex_;
+
+    std::map<uint32_t, std::vector<uint8_t>>                      structureData_;
+    std::map<uint32_t, std::pair<uint16_t, std::vector<uint8_t>>> structureDataLists_;  // command version, data
+    std::map<uint32_t, std::vector<uint8_t>>                      rawData_;
+};
+
+}  // namespace libobsensor
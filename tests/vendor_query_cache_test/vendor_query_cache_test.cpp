@@ -0,0 +1,203 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Device open cache (VendorQueryCache) on a mock vendor port (MockVendorPort): the calibration of a device is read through
+// VendorPropertyAccessor as G330Device does at open (depth and align calibration lists, IMU calibration raw data, D2C profile list). The
+// cases check the data and the control transfers: all the queries without cache, the version data and the head of the depth calibration
+// list more at the first open with the cache with the file written once at the end of the open, only these at the next open, the queries
+// again when the version data of the device changed, when the device was calibrated again or the cache file is corrupted, and the
+// properties not cacheable always queried. Then the time of the queries is reported with and without the cache for a round-trip of 1 ms
+// per control transfer.
+//
+// usage: vendor_query_cache_test [transfer delay in us]
+
+#include "MockVendorPort.hpp"
+#include "property/InternalProperty.hpp"
+#include "property/VendorPropertyAccessor.hpp"
+#include "property/VendorQueryCache.hpp"
+#include "InternalTypes.hpp"
+#include "ObTestCase.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t    DEFAULT_TRANSFER_DELAY_US = 1000;
+// Not named after the executable: run from the bin directory, a relative directory of the same name would collide with it
+const char *const CACHE_DIR                 = "vendor_query_cache_test_data/";
+const char *const CACHE_FILE                = "vendor_query_cache_test_data/CP1234567890_1.2.30.bin";
+
+std::vector<uint8_t> pattern(size_t size, uint8_t seed) {
+    std::vector<uint8_t> data(size);
+    for(size_t i = 0; i < size; i++) {
+        data[i] = static_cast<uint8_t>(seed + i * 7);
+    }
+    return data;
+}
+
+std::vector<uint8_t> versionData(const char *hardwareVersion) {
+    OBVersionInfo version;
+    memset(&version, 0, sizeof(version));
+    strcpy(version.firmwareVersion, "1.2.30");
+    strcpy(version.hardwareVersion, hardwareVersion);
+    strcpy(version.serialNumber, "CP1234567890");
+    strcpy(version.deviceName, "Gemini 335");
+    auto begin = reinterpret_cast<const uint8_t *>(&version);
+    return std::vector<uint8_t>(begin, begin + sizeof(version));
+}
+
+std::shared_ptr<MockVendorPort> createPort(uint32_t transferDelayUs, uint8_t seed, const char *hardwareVersion, uint8_t depthCalibSeed = 0) {
+    auto port = std::make_shared<MockVendorPort>(transferDelayUs);
+    port->setStructureData(OB_STRUCT_VERSION, versionData(hardwareVersion));
+    port->setStructureDataList(OB_RAW_DATA_DEPTH_CALIB_PARAM, 1, pattern(1800, depthCalibSeed ? depthCalibSeed : seed));
+    port->setStructureDataList(OB_RAW_DATA_ALIGN_CALIB_PARAM, 0, pattern(2400, seed + 1));
+    port->setStructureDataList(OB_RAW_DATA_D2C_ALIGN_SUPPORT_PROFILE_LIST, 0, pattern(300, seed + 2));
+    port->setStructureDataList(OB_RAW_DATA_DEPTH_ALG_MODE_LIST, 0, pattern(200, seed + 3));
+    port->setRawData(OB_RAW_DATA_IMU_CALIB_PARAM, pattern(1000, seed + 4));
+    return port;
+}
+
+struct DeviceCalibration {
+    std::vector<uint8_t> depthCalib;
+    std::vector<uint8_t> alignCalib;
+    std::vector<uint8_t> d2cProfiles;
+    std::vector<uint8_t> depthModes;
+    std::vector<uint8_t> imuCalib;
+
+    bool operator==(const DeviceCalibration &other) const {
+        return depthCalib == other.depthCalib && alignCalib == other.alignCalib && d2cProfiles == other.d2cProfiles && depthModes == other.depthModes
+               && imuCalib == other.imuCalib;
+    }
+};
+
+// The queries of an open, through a new accessor and the given cache (nullptr: disabled)
+DeviceCalibration openDevice(std::shared_ptr<MockVendorPort> port, std::shared_ptr<VendorQueryCache> cache) {
+    auto accessor = std::make_shared<VendorPropertyAccessor>(nullptr, port);
+    accessor->setQueryCache(cache);
+
+    DeviceCalibration calibration;
+    calibration.depthCalib  = accessor->getStructureDataListProtoV1_1(OB_RAW_DATA_DEPTH_CALIB_PARAM, 1);
+    calibration.alignCalib  = accessor->getStructureDataListProtoV1_1(OB_RAW_DATA_ALIGN_CALIB_PARAM, 0);
+    calibration.d2cProfiles = accessor->getStructureDataListProtoV1_1(OB_RAW_DATA_D2C_ALIGN_SUPPORT_PROFILE_LIST, 0);
+    calibration.depthModes  = accessor->getStructureDataListProtoV1_1(OB_RAW_DATA_DEPTH_ALG_MODE_LIST, 0);
+    accessor->getRawData(OB_RAW_DATA_IMU_CALIB_PARAM, [&calibration](OBDataTranState state, OBDataChunk *dataChunk) {
+        if(state == DATA_TRAN_STAT_TRANSFERRING) {
+            calibration.imuCalib.insert(calibration.imuCalib.end(), dataChunk->data, dataChunk->data + dataChunk->size);
+        }
+    });
+    return calibration;
+}
+
+// Through a new cache, written to the file when released, as a new process would do
+DeviceCalibration openDevice(std::shared_ptr<MockVendorPort> port, bool useCache) {
+    return openDevice(port, useCache ? std::make_shared<VendorQueryCache>(CACHE_DIR) : nullptr);
+}
+
+bool cacheFileExists() {
+    return std::ifstream(CACHE_FILE).good();
+}
+
+// Transfers of the not cacheable depth mode list query (start, 1 packet, finish)
+const uint32_t DEPTH_MODE_LIST_TRANSFERS = 3;
+// Transfers of the cache checks at open: the version data, the head of the depth calibration list (start, 1 packet, finish)
+const uint32_t OPEN_CHECK_TRANSFERS = 1 + 3;
+// Transfers of an open reading the cache
+const uint32_t CACHED_OPEN_TRANSFERS = OPEN_CHECK_TRANSFERS + DEPTH_MODE_LIST_TRANSFERS;
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    uint32_t transferDelayUs = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : DEFAULT_TRANSFER_DELAY_US;
+    std::remove(CACHE_FILE);
+
+    auto              referencePort = createPort(0, 10, "1.0.0");
+    DeviceCalibration reference     = openDevice(referencePort, false);
+    uint32_t          uncached      = referencePort->getTransferCount();
+    obtest::report("queries without cache", reference.depthCalib == pattern(1800, 10) && reference.imuCalib == pattern(1000, 14) && uncached > 10);
+
+    {
+        auto port        = createPort(0, 10, "1.0.0");
+        auto cache       = std::make_shared<VendorQueryCache>(CACHE_DIR);
+        auto calibration = openDevice(port, cache);
+        bool pass        = calibration == reference && port->getTransferCount() == uncached + OPEN_CHECK_TRANSFERS;
+        // the entries are written at once at the end of the open
+        pass = pass && !cacheFileExists();
+        cache->flush();
+        obtest::report("first open with cache queries the device", pass && cacheFileExists());
+    }
+
+    {
+        auto port        = createPort(0, 10, "1.0.0");
+        auto calibration = openDevice(port, true);
+        obtest::report("next open reads the cache", calibration == reference && port->getTransferCount() == CACHED_OPEN_TRANSFERS);
+    }
+
+    {
+        // Same version data, other calibration: the cache file is rewritten
+        auto port        = createPort(0, 10, "1.0.0", 90);
+        auto calibration = openDevice(port, true);
+        bool pass        = calibration.depthCalib == pattern(1800, 90) && port->getTransferCount() == uncached + OPEN_CHECK_TRANSFERS;
+
+        auto nextPort        = createPort(0, 10, "1.0.0", 90);
+        auto nextCalibration = openDevice(nextPort, true);
+        pass                 = pass && nextCalibration == calibration && nextPort->getTransferCount() == CACHED_OPEN_TRANSFERS;
+        obtest::report("device calibrated again", pass);
+    }
+
+    {
+        // Same serial number and firmware version, other version data (and calibration): the cache file is rewritten
+        auto port        = createPort(0, 50, "1.0.1");
+        auto calibration = openDevice(port, true);
+        bool pass        = calibration.depthCalib == pattern(1800, 50) && calibration.imuCalib == pattern(1000, 54)
+                    && port->getTransferCount() == uncached + OPEN_CHECK_TRANSFERS;
+
+        auto nextPort        = createPort(0, 50, "1.0.1");
+        auto nextCalibration = openDevice(nextPort, true);
+        pass                 = pass && nextCalibration == calibration && nextPort->getTransferCount() == CACHED_OPEN_TRANSFERS;
+        obtest::report("version data changed", pass);
+    }
+
+    {
+        {
+            std::fstream file(CACHE_FILE, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(100);
+            file.put('\x5a');
+        }
+        auto port        = createPort(0, 50, "1.0.1");
+        auto calibration = openDevice(port, true);
+        bool pass        = calibration.depthCalib == pattern(1800, 50) && port->getTransferCount() == uncached + OPEN_CHECK_TRANSFERS;
+        obtest::report("corrupted cache file ignored", pass);
+    }
+
+    {
+        auto port     = createPort(0, 50, "1.0.1");
+        auto accessor = std::make_shared<VendorPropertyAccessor>(nullptr, port);
+        accessor->setQueryCache(std::make_shared<VendorQueryCache>(CACHE_DIR));
+        accessor->setStructureDataProtoV1_1(OB_RAW_DATA_DEPTH_CALIB_PARAM, pattern(16, 0), 1);
+        uint32_t before = port->getTransferCount();
+        accessor->getStructureDataListProtoV1_1(OB_RAW_DATA_DEPTH_CALIB_PARAM, 1);
+        obtest::report("written property queried again", port->getTransferCount() > before);
+    }
+
+    std::remove(CACHE_FILE);
+    auto start = std::chrono::steady_clock::now();
+    openDevice(createPort(transferDelayUs, 10, "1.0.0"), false);
+    auto uncachedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    openDevice(createPort(transferDelayUs, 10, "1.0.0"), true);  // writes the cache file
+    start = std::chrono::steady_clock::now();
+    openDevice(createPort(transferDelayUs, 10, "1.0.0"), true);
+    auto cachedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("calibration queries: %u transfers, %.1f ms without cache, %u transfers, %.1f ms with cache\n", uncached, uncachedMs,
+                CACHED_OPEN_TRANSFERS, cachedMs);
+    std::remove(CACHE_FILE);
+
+    return obtest::result();
+}
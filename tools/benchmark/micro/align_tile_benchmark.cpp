@@ -0,0 +1,112 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Micro benchmark of the multi-threaded (tiled) alignment of AlignImpl: the time per frame of D2C and C2D of a synthetic 848x480 depth frame
+// to a 1280x720 color frame with 1, 2, 4, 8 and 16 threads, and the speedup over 1 thread. The outputs are compared with the ones of 1 thread
+// by align_tile_test.
+//
+// usage: ob_align_tile_benchmark [iteration count]
+
+#include "publicfilters/AlignImpl.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(__ARM_NEON__) || defined(__NEON__) || defined(__SSSE3__)
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t DEFAULT_ITERATIONS = 100;
+const uint32_t THREAD_COUNTS[]    = { 1, 2, 4, 8, 16 };
+
+const int DEPTH_WIDTH  = 848;
+const int DEPTH_HEIGHT = 480;
+const int COLOR_WIDTH  = 1280;
+const int COLOR_HEIGHT = 720;
+
+OBCameraIntrinsic makeIntrinsic(int width, int height, float focal) {
+    return { focal, focal, width * 0.5f, height * 0.5f, static_cast<int16_t>(width), static_cast<int16_t>(height) };
+}
+
+void benchmark(uint32_t iterations, bool withSSE, bool gapFillCopy) {
+    OBCameraDistortion depthDisto;
+    memset(&depthDisto, 0, sizeof(depthDisto));
+    OBCameraDistortion colorDisto = depthDisto;
+    colorDisto.model              = OB_DISTORTION_BROWN_CONRADY;
+    colorDisto.k1                 = 0.08f;
+    colorDisto.k2                 = -0.2f;
+    colorDisto.k3                 = 0.09f;
+    OBExtrinsic extrinsic         = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { -25.0f, 0.0f, 0.0f } };
+
+    AlignImpl impl;
+    impl.initialize(makeIntrinsic(DEPTH_WIDTH, DEPTH_HEIGHT, 420.0f), depthDisto, makeIntrinsic(COLOR_WIDTH, COLOR_HEIGHT, 690.0f), colorDisto, extrinsic,
+                    1.0f, true, gapFillCopy, false, OB_FORMAT_Y16, 65535);
+
+    std::vector<uint16_t> depth(DEPTH_WIDTH * DEPTH_HEIGHT);
+    uint32_t              seed = 7;
+    for(auto &value: depth) {
+        seed  = seed * 1103515245 + 12345;
+        value = static_cast<uint16_t>(300 + (seed >> 8) % 4700);
+    }
+    std::vector<uint8_t>  color(3 * COLOR_WIDTH * COLOR_HEIGHT, 0x80);
+    std::vector<uint16_t> alignedDepth(COLOR_WIDTH * COLOR_HEIGHT);
+    std::vector<uint8_t>  alignedColor(3 * DEPTH_WIDTH * DEPTH_HEIGHT);
+
+    std::printf("%dx%d depth to %dx%d color, %s, gap fill %s, %u frames\n", DEPTH_WIDTH, DEPTH_HEIGHT, COLOR_WIDTH, COLOR_HEIGHT, withSSE ? "SSE" : "scalar",
+                gapFillCopy ? "copy" : "nearest", iterations);
+    double d2cSingle = 0, c2dSingle = 0;
+    for(auto threadCount: THREAD_COUNTS) {
+        impl.setThreadCount(threadCount);
+        // warm-up: the worker threads and the tile buffers are set up on the first frame
+        impl.D2C(depth.data(), DEPTH_WIDTH, DEPTH_HEIGHT, alignedDepth.data(), COLOR_WIDTH, COLOR_HEIGHT, nullptr, withSSE);
+
+        auto start = std::chrono::steady_clock::now();
+        for(uint32_t i = 0; i < iterations; i++) {
+            impl.D2C(depth.data(), DEPTH_WIDTH, DEPTH_HEIGHT, alignedDepth.data(), COLOR_WIDTH, COLOR_HEIGHT, nullptr, withSSE);
+        }
+        auto d2c = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+        start = std::chrono::steady_clock::now();
+        for(uint32_t i = 0; i < iterations; i++) {
+            impl.C2D(depth.data(), DEPTH_WIDTH, DEPTH_HEIGHT, color.data(), alignedColor.data(), COLOR_WIDTH, COLOR_HEIGHT, OB_FORMAT_RGB, withSSE);
+        }
+        auto c2d = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+        if(threadCount == 1) {
+            d2cSingle = d2c;
+            c2dSingle = c2d;
+        }
+        std::printf("  %2u threads: D2C %8.1f us/frame (x%.2f), C2D %8.1f us/frame (x%.2f)\n", threadCount, d2c, d2cSingle / d2c, c2d, c2dSingle / c2d);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    uint32_t iterations = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : DEFAULT_ITERATIONS;
+    if(iterations == 0) {
+        iterations = DEFAULT_ITERATIONS;
+    }
+
+    // no speedup is expected beyond the number of cores
+    std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+    benchmark(iterations, true, false);
+    benchmark(iterations, true, true);
+    benchmark(iterations, false, false);
+    return 0;
+}
+
+#else
+
+int main() {
+    std::printf("the tiled alignment is built with SSSE3 or NEON only\n");
+    return 0;
+}
+
+#endif  // __ARM_NEON__ || __NEON__ || __SSSE3__
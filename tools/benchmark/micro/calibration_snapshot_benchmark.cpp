@@ -0,0 +1,118 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Micro benchmark of the calibration snapshot (CalibrationSnapshot): the time per getExtrinsicTo() call on the snapshot and on the extrinsics
+// graph search of StreamExtrinsicsManager, then the time per frame of a filter cloning the profile of each frame (as UnDistortionFilter does)
+// and reading its extrinsics, which registers the clone and updates the snapshot, for graphs of a growing number of profiles.
+//
+// usage: ob_calibration_snapshot_benchmark [iteration count]
+
+#include "stream/StreamExtrinsicsManager.hpp"
+#include "stream/StreamProfileFactory.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t DEFAULT_ITERATIONS = 1000000;
+
+std::shared_ptr<VideoStreamProfile> createProfile(OBStreamType type, uint32_t width) {
+    return StreamProfileFactory::createVideoStreamProfile(type, OB_FORMAT_Y16, width, 480, 30);
+}
+
+OBExtrinsic translation(float x, float y, float z) {
+    OBExtrinsic extrinsic = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { x, y, z } };
+    return extrinsic;
+}
+
+// Depth -> color -> IR, left IR -> depth with a rotation, right IR same as left IR, an accel stream with no extrinsics
+struct Graph {
+    std::vector<std::shared_ptr<VideoStreamProfile>> profiles;
+    std::shared_ptr<VideoStreamProfile>              isolated;
+};
+
+Graph createGraph() {
+    Graph graph;
+    for(uint32_t i = 0; i < 5; i++) {
+        graph.profiles.push_back(createProfile(OB_STREAM_DEPTH, 640 + i));
+    }
+    auto       &p        = graph.profiles;
+    OBExtrinsic rotation = { { 0, -1, 0, 1, 0, 0, 0, 0, 1 }, { 1.5f, -2.0f, 3.0f } };
+    p[0]->bindExtrinsicTo(p[1], translation(10, 0, 0));
+    p[1]->bindExtrinsicTo(p[2], translation(0, 10, 0));
+    p[3]->bindExtrinsicTo(p[0], rotation);
+    p[4]->bindSameExtrinsicTo(p[3]);
+    graph.isolated = createProfile(OB_STREAM_COLOR, 1280);
+    graph.isolated->bindIntrinsic({ 1, 1, 1, 1, 1280, 480 });
+    return graph;
+}
+
+void benchmark(uint32_t iterations) {
+    auto graph   = createGraph();
+    auto manager = StreamExtrinsicsManager::getInstance();
+    auto from    = graph.profiles[4];
+    auto to      = graph.profiles[2];
+    auto sum     = 0.0f;
+
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < iterations; i++) {
+        sum += manager->getExtrinsics(from, to).trans[0];
+    }
+    auto managerNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < iterations; i++) {
+        sum += from->getExtrinsicTo(to).trans[0];
+    }
+    auto snapshotNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    std::printf("getExtrinsicTo() over 3 edges, %u calls (checksum %g)\n", iterations, sum);
+    std::printf("  extrinsics manager: %8.1f ns/call\n", managerNs);
+    std::printf("  snapshot:           %8.1f ns/call\n", snapshotNs);
+}
+
+// Per frame: clone the profile of the frame and read the extrinsics of the clone, with extraLeaves more profiles bound to the graph
+void benchmarkClonePerFrame(uint32_t frames, uint32_t extraLeaves) {
+    auto                                             graph = createGraph();
+    std::vector<std::shared_ptr<VideoStreamProfile>> leaves;
+    for(uint32_t i = 0; i < extraLeaves; i++) {
+        leaves.push_back(createProfile(OB_STREAM_IR, 100 + i));
+        leaves.back()->bindExtrinsicTo(graph.profiles[i % graph.profiles.size()], translation(static_cast<float>(i), 0, 0));
+    }
+    auto from = graph.profiles[4];
+    auto to   = graph.profiles[2];
+    auto sum  = 0.0f;
+
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < frames; i++) {
+        auto clone = from->clone();
+        sum += clone->getExtrinsicTo(to).trans[0];
+    }
+    auto frameUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / frames;
+    std::printf("  %3u profiles: %8.2f us/frame (checksum %g)\n", static_cast<uint32_t>(graph.profiles.size() + extraLeaves), frameUs, sum);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    uint32_t iterations = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : DEFAULT_ITERATIONS;
+    if(iterations == 0) {
+        iterations = DEFAULT_ITERATIONS;
+    }
+
+    benchmark(iterations);
+
+    uint32_t frames = std::max(iterations / 100, 1u);
+    std::printf("profile clone per frame, then getExtrinsicTo() on the clone, %u frames\n", frames);
+    for(uint32_t extraLeaves: { 0u, 16u, 64u }) {
+        benchmarkClonePerFrame(frames, extraLeaves);
+    }
+    return 0;
+}
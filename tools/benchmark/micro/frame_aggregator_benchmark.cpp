@@ -0,0 +1,191 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Micro benchmark of the pipeline frame aggregator engines (OBFrameAggregateEngine).
+// Each stream is fed by its own producer thread with synthetic frames, the producers pace the frames on the stream timestamps (speed up by
+// the given factor, 0 for no pacing). The benchmark reports the time spent in pushFrame on the producer threads and the framesets output.
+//
+// usage: ob_frame_aggregator_benchmark [simulated_seconds] [speed]
+
+#include "FrameAggregator.hpp"
+#include "LockFreeFrameAggregator.hpp"
+#include "frame/FrameFactory.hpp"
+#include "stream/StreamProfileFactory.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+struct StreamDesc {
+    OBStreamType type;
+    uint32_t     fps;
+};
+
+struct TestCase {
+    const char             *name;
+    std::vector<StreamDesc> streams;
+};
+
+struct ProducerResult {
+    uint64_t pushed;
+    uint64_t totalPushNs;
+    uint64_t maxPushNs;
+};
+
+struct RunResult {
+    uint64_t pushed;
+    double   avgPushNs;
+    double   maxPushUs;
+    uint64_t framesets;
+    uint64_t completeFramesets;
+    double   wallMs;
+};
+
+std::shared_ptr<const StreamProfile> createProfile(const StreamDesc &desc) {
+    if(desc.type == OB_STREAM_ACCEL) {
+        return StreamProfileFactory::createAccelStreamProfile(OB_ACCEL_FS_4g, OB_SAMPLE_RATE_200_HZ);
+    }
+    if(desc.type == OB_STREAM_GYRO) {
+        return StreamProfileFactory::createGyroStreamProfile(OB_GYRO_FS_1000dps, OB_SAMPLE_RATE_200_HZ);
+    }
+    // Small frames, the benchmark measures the aggregation and not the memory bandwidth
+    return StreamProfileFactory::createVideoStreamProfile(desc.type, OB_FORMAT_Y16, 64, 48, desc.fps);
+}
+
+uint32_t getFps(const StreamDesc &desc) {
+    return (desc.type == OB_STREAM_ACCEL || desc.type == OB_STREAM_GYRO) ? 200 : desc.fps;
+}
+
+RunResult runOnce(OBFrameAggregateEngine engine, const TestCase &testCase, FrameSyncMode syncMode, uint32_t simulatedSec, uint32_t speed) {
+    auto config = std::make_shared<Config>();
+    config->setFrameAggregateOutputMode(OB_FRAME_AGGREGATE_OUTPUT_ANY_SITUATION);
+    std::vector<std::shared_ptr<const StreamProfile>> profiles;
+    for(auto &desc: testCase.streams) {
+        profiles.push_back(createProfile(desc));
+        config->enableStream(profiles.back());
+    }
+
+    std::shared_ptr<IFrameAggregator> aggregator;
+    if(engine == OB_FRAME_AGGREGATE_ENGINE_LOCK_FREE) {
+        aggregator = std::make_shared<LockFreeFrameAggregator>();
+    }
+    else {
+        aggregator = std::make_shared<FrameAggregator>();
+    }
+
+    std::atomic<uint64_t> framesets(0);
+    std::atomic<uint64_t> completeFramesets(0);
+    std::atomic<uint64_t> outputFrames(0);
+    const uint32_t        streamCount = static_cast<uint32_t>(testCase.streams.size());
+    aggregator->setCallback([&](std::shared_ptr<const Frame> frame) {
+        auto count = frame->as<const FrameSet>()->getCount();
+        framesets++;
+        outputFrames += count;
+        if(count == streamCount) {
+            completeFramesets++;
+        }
+    });
+    aggregator->enableFrameSync(syncMode);
+    aggregator->updateConfig(config, true);
+
+    std::vector<ProducerResult> results(streamCount);
+    std::vector<std::thread>    producers;
+    auto                        start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < streamCount; i++) {
+        producers.emplace_back([&, i]() {
+            auto          &result   = results[i];
+            auto           profile  = profiles[i];
+            uint64_t       interval = 1000000ull / getFps(testCase.streams[i]);
+            uint64_t       count    = static_cast<uint64_t>(simulatedSec) * getFps(testCase.streams[i]);
+            ProducerResult res      = { 0, 0, 0 };
+            for(uint64_t n = 0; n < count; n++) {
+                uint64_t tsp = 1000000ull + n * interval + i * 50;  // small skew between the streams
+                if(speed > 0) {
+                    std::this_thread::sleep_until(start + std::chrono::microseconds((tsp - 1000000ull) / speed));
+                }
+                auto frame = FrameFactory::createFrameFromStreamProfile(profile);
+                frame->setNumber(n);
+                frame->setTimeStampUsec(tsp);
+                frame->setSystemTimeStampUsec(tsp);
+
+                auto begin = std::chrono::steady_clock::now();
+                aggregator->pushFrame(frame);
+                auto ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+                res.pushed++;
+                res.totalPushNs += ns;
+                res.maxPushNs = (std::max)(res.maxPushNs, ns);
+            }
+            result = res;
+        });
+    }
+    for(auto &producer: producers) {
+        producer.join();
+    }
+
+    // Wait for the matcher thread of the lock-free engine to drain its input
+    uint64_t pushed = 0;
+    for(auto &res: results) {
+        pushed += res.pushed;
+    }
+    uint64_t lastOutput = outputFrames.load();
+    while(true) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        uint64_t output = outputFrames.load();
+        if(output == lastOutput) {
+            break;
+        }
+        lastOutput = output;
+    }
+    auto end = std::chrono::steady_clock::now();
+    aggregator.reset();
+
+    RunResult run = {};
+    run.pushed    = pushed;
+    for(auto &res: results) {
+        run.avgPushNs += static_cast<double>(res.totalPushNs);
+        run.maxPushUs = (std::max)(run.maxPushUs, res.maxPushNs / 1000.0);
+    }
+    run.avgPushNs         = pushed ? run.avgPushNs / pushed : 0;
+    run.framesets         = framesets.load();
+    run.completeFramesets = completeFramesets.load();
+    run.wallMs            = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+    return run;
+}
+
+void printResult(const char *engineName, const RunResult &run) {
+    std::printf("  %-10s pushed=%-8llu push avg=%8.0fns max=%9.1fus framesets=%-8llu complete=%-8llu wall=%.1fms\n", engineName,
+                static_cast<unsigned long long>(run.pushed), run.avgPushNs, run.maxPushUs, static_cast<unsigned long long>(run.framesets),
+                static_cast<unsigned long long>(run.completeFramesets), run.wallMs);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    uint32_t simulatedSec = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 10;
+    uint32_t speed        = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 10;
+
+    const std::vector<TestCase> testCases = {
+        { "depth+color", { { OB_STREAM_DEPTH, 30 }, { OB_STREAM_COLOR, 30 } } },
+        { "depth+color+ir_left+ir_right", { { OB_STREAM_DEPTH, 30 }, { OB_STREAM_COLOR, 30 }, { OB_STREAM_IR_LEFT, 30 }, { OB_STREAM_IR_RIGHT, 30 } } },
+        { "depth+color+accel+gyro", { { OB_STREAM_DEPTH, 60 }, { OB_STREAM_COLOR, 30 }, { OB_STREAM_ACCEL, 200 }, { OB_STREAM_GYRO, 200 } } },
+    };
+
+    std::printf("Frame aggregator benchmark, %us of stream time per run, speed x%u%s\n", simulatedSec, speed, speed == 0 ? " (no pacing)" : "");
+    for(auto &testCase: testCases) {
+        for(auto syncMode: { FrameSyncModeDisable, FrameSyncModeSyncAccordingFrameTimestamp }) {
+            std::printf("%s, frame sync %s\n", testCase.name, syncMode == FrameSyncModeDisable ? "off" : "on");
+            printResult("default", runOnce(OB_FRAME_AGGREGATE_ENGINE_DEFAULT, testCase, syncMode, simulatedSec, speed));
+            printResult("lock-free", runOnce(OB_FRAME_AGGREGATE_ENGINE_LOCK_FREE, testCase, syncMode, simulatedSec, speed));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Micro benchmark of the frame handles (ob_frame) and frame objects of the c++ wrapper (ob::makeFrame): a depth and color frameset is
+// delivered the way the pipeline does (frameset handle, ob::FrameSet, the depth and color frames taken and converted with as<T>()). The
+// heap allocations (global operator new of this program) and the time per frameset are reported for the wrapper objects allocated by
+// std::make_shared and by ob::makeFrame.
+//
+// usage: ob_frame_handle_pool_benchmark [iteration count]
+
+#include "libobsensor/ObSensor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+namespace {
+std::atomic<uint64_t> allocationCount(0);
+}  // namespace
+
+void *operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void *ptr = std::malloc(size ? size : 1);
+    if(!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+const uint32_t DEFAULT_ITERATIONS = 200000;
+const uint32_t WARM_UP_FRAMESETS  = 64;
+
+struct DeliveredFrameSet {
+    std::shared_ptr<ob::FrameSet>   frameSet;
+    std::shared_ptr<ob::DepthFrame> depth;
+    std::shared_ptr<ob::ColorFrame> color;
+};
+
+// frameset: the internal frameset, a new handle of it is delivered as ob_pipeline_wait_for_frameset does
+DeliveredFrameSet deliver(ob_frame *frameset, bool pooled) {
+    ob_frame_add_ref(frameset, nullptr);
+
+    DeliveredFrameSet delivered;
+    if(pooled) {
+        delivered.frameSet = ob::makeFrame<ob::FrameSet>(frameset);
+        delivered.depth    = delivered.frameSet->getFrame(OB_FRAME_DEPTH)->as<ob::DepthFrame>();
+        delivered.color    = delivered.frameSet->getFrame(OB_FRAME_COLOR)->as<ob::ColorFrame>();
+    }
+    else {
+        // The wrapper objects allocated as before ob::makeFrame
+        delivered.frameSet = std::make_shared<ob::FrameSet>(frameset);
+        auto depth         = std::make_shared<ob::Frame>(ob_frameset_get_frame(frameset, OB_FRAME_DEPTH, nullptr));
+        auto color         = std::make_shared<ob::Frame>(ob_frameset_get_frame(frameset, OB_FRAME_COLOR, nullptr));
+        ob_frame_add_ref(depth->getImpl(), nullptr);
+        ob_frame_add_ref(color->getImpl(), nullptr);
+        delivered.depth = std::make_shared<ob::DepthFrame>(depth->getImpl());
+        delivered.color = std::make_shared<ob::ColorFrame>(color->getImpl());
+    }
+    return delivered;
+}
+
+double allocationsPerFrameSet(ob_frame *frameset, bool pooled, uint32_t count) {
+    for(uint32_t i = 0; i < WARM_UP_FRAMESETS; i++) {
+        deliver(frameset, pooled);
+    }
+    uint64_t before = allocationCount.load();
+    for(uint32_t i = 0; i < count; i++) {
+        deliver(frameset, pooled);
+    }
+    return static_cast<double>(allocationCount.load() - before) / count;
+}
+
+double nsPerFrameSet(ob_frame *frameset, bool pooled, uint32_t iterations) {
+    uint64_t checksum = 0;
+    auto     start    = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < iterations; i++) {
+        auto delivered = deliver(frameset, pooled);
+        checksum += delivered.depth->getWidth() + delivered.color->getHeight();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    if(checksum != static_cast<uint64_t>(iterations) * (640 + 720)) {
+        std::printf("unexpected frame size\n");
+    }
+    return elapsed / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    uint32_t iterations = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : DEFAULT_ITERATIONS;
+
+    ob_frame *frameset = ob_create_frameset(nullptr);
+    ob_frame *depth    = ob_create_video_frame(OB_FRAME_DEPTH, OB_FORMAT_Y16, 640, 480, 0, nullptr);
+    ob_frame *color    = ob_create_video_frame(OB_FRAME_COLOR, OB_FORMAT_RGB, 1280, 720, 0, nullptr);
+    ob_frameset_push_frame(frameset, depth, nullptr);
+    ob_frameset_push_frame(frameset, color, nullptr);
+    ob_delete_frame(depth, nullptr);
+    ob_delete_frame(color, nullptr);
+
+    double sharedAllocations = allocationsPerFrameSet(frameset, false, 1000);
+    double pooledAllocations = allocationsPerFrameSet(frameset, true, 1000);
+    double sharedNs          = nsPerFrameSet(frameset, false, iterations);
+    double pooledNs          = nsPerFrameSet(frameset, true, iterations);
+    std::printf("std::make_shared wrappers: %.1f allocations, %.1f ns per frameset\n", sharedAllocations, sharedNs);
+    std::printf("ob::makeFrame wrappers:    %.1f allocations, %.1f ns per frameset\n", pooledAllocations, pooledNs);
+
+    ob_delete_frame(frameset, nullptr);
+    return 0;
+}
@@ -0,0 +1,165 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Micro benchmark of the frame queues: per-frame handoff latency from enqueue on a producer thread to the async dequeue callback.
+// Each stream is fed by its own producer thread. The queues are measured in the two layouts used by the SDK:
+//   - per stream: one queue and one consumer thread per stream (sensor, recorder, playback), FrameQueue vs SpscFrameQueue
+//   - shared: all streams push into one queue (pipeline output, filters), FrameQueue vs MpscFrameQueue
+//
+// usage: ob_frame_queue_benchmark [frames_per_stream] [interval_us]
+
+#include "frame/FrameFactory.hpp"
+#include "frame/FrameQueue.hpp"
+#include "frame/MpscFrameQueue.hpp"
+#include "frame/SpscFrameQueue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const size_t QUEUE_CAPACITY = 16;
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Latencies are recorded in preallocated buffers, one per consumer, so that the measurement does not allocate
+class LatencyRecorder {
+public:
+    explicit LatencyRecorder(size_t capacity) : count_(0), samples_(capacity) {}
+
+    void record(const std::shared_ptr<const Frame> &frame) {
+        auto idx = count_.fetch_add(1);
+        if(idx < samples_.size()) {
+            samples_[idx] = nowNs() - frame->getTimeStampUsec();  // the enqueue time in ns is carried in the timestamp field
+        }
+    }
+
+    size_t count() const {
+        return (std::min)(count_.load(), samples_.size());
+    }
+
+    std::vector<uint64_t> &samples() {
+        samples_.resize(count());
+        return samples_;
+    }
+
+private:
+    std::atomic<size_t>   count_;
+    std::vector<uint64_t> samples_;
+};
+
+template <typename Queue> void produce(Queue &queue, uint32_t frames, uint32_t intervalUs, std::atomic<uint64_t> &dropped) {
+    auto next = std::chrono::steady_clock::now();
+    for(uint32_t n = 0; n < frames; n++) {
+        next += std::chrono::microseconds(intervalUs);
+        std::this_thread::sleep_until(next);
+
+        auto frame = FrameFactory::createFrame(OB_FRAME_DEPTH, OB_FORMAT_Y16, 64);
+        frame->setNumber(n);
+        frame->setTimeStampUsec(nowNs());
+        if(!queue.enqueue(std::move(frame))) {
+            dropped++;
+        }
+    }
+}
+
+struct Result {
+    double   p50Us;
+    double   p99Us;
+    double   maxUs;
+    uint64_t delivered;
+    uint64_t dropped;
+};
+
+Result summarize(std::vector<std::unique_ptr<LatencyRecorder>> &recorders, uint64_t dropped) {
+    std::vector<uint64_t> all;
+    for(auto &recorder: recorders) {
+        auto &samples = recorder->samples();
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    Result result = { 0, 0, 0, all.size(), dropped };
+    if(!all.empty()) {
+        std::sort(all.begin(), all.end());
+        result.p50Us = all[all.size() / 2] / 1000.0;
+        result.p99Us = all[(all.size() * 99) / 100] / 1000.0;
+        result.maxUs = all.back() / 1000.0;
+    }
+    return result;
+}
+
+template <typename Queue> Result runPerStream(uint32_t streams, uint32_t frames, uint32_t intervalUs) {
+    std::vector<std::unique_ptr<Queue>>           queues;
+    std::vector<std::unique_ptr<LatencyRecorder>> recorders;
+    std::atomic<uint64_t>                         dropped(0);
+    for(uint32_t i = 0; i < streams; i++) {
+        queues.emplace_back(new Queue(QUEUE_CAPACITY));
+        recorders.emplace_back(new LatencyRecorder(frames));
+        auto recorder = recorders.back().get();
+        queues.back()->start([recorder](std::shared_ptr<const Frame> frame) { recorder->record(frame); });
+    }
+
+    std::vector<std::thread> producers;
+    for(uint32_t i = 0; i < streams; i++) {
+        auto queue = queues[i].get();
+        producers.emplace_back([&, queue]() { produce(*queue, frames, intervalUs, dropped); });
+    }
+    for(auto &producer: producers) {
+        producer.join();
+    }
+    for(auto &queue: queues) {
+        queue->flush();
+    }
+    return summarize(recorders, dropped.load());
+}
+
+template <typename Queue> Result runShared(uint32_t streams, uint32_t frames, uint32_t intervalUs) {
+    Queue                                         queue(QUEUE_CAPACITY * streams);
+    std::vector<std::unique_ptr<LatencyRecorder>> recorders;
+    std::atomic<uint64_t>                         dropped(0);
+    recorders.emplace_back(new LatencyRecorder(static_cast<size_t>(frames) * streams));
+    auto recorder = recorders.back().get();
+    queue.start([recorder](std::shared_ptr<const Frame> frame) { recorder->record(frame); });
+
+    std::vector<std::thread> producers;
+    for(uint32_t i = 0; i < streams; i++) {
+        producers.emplace_back([&]() { produce(queue, frames, intervalUs, dropped); });
+    }
+    for(auto &producer: producers) {
+        producer.join();
+    }
+    queue.flush();
+    return summarize(recorders, dropped.load());
+}
+
+void printResult(const char *name, const Result &result) {
+    std::printf("  %-32s p50=%8.1fus p99=%8.1fus max=%9.1fus delivered=%-8llu dropped=%llu\n", name, result.p50Us, result.p99Us, result.maxUs,
+                static_cast<unsigned long long>(result.delivered), static_cast<unsigned long long>(result.dropped));
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    uint32_t frames     = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 2000;
+    uint32_t intervalUs = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 500;
+
+    std::printf("Frame queue handoff latency, %u frames per stream, one frame every %uus per stream\n", frames, intervalUs);
+    for(uint32_t streams = 1; streams <= 8; streams *= 2) {
+        std::printf("%u stream(s)\n", streams);
+        printResult("per stream FrameQueue", runPerStream<FrameQueue<const Frame>>(streams, frames, intervalUs));
+        printResult("per stream SpscFrameQueue", runPerStream<SpscFrameQueue<const Frame>>(streams, frames, intervalUs));
+        printResult("shared FrameQueue", runShared<FrameQueue<const Frame>>(streams, frames, intervalUs));
+        printResult("shared MpscFrameQueue", runShared<MpscFrameQueue<const Frame>>(streams, frames, intervalUs));
+    }
+    return 0;
+}
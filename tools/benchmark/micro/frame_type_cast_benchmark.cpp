@@ -0,0 +1,80 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Micro benchmark of Frame::is<T>() / as<T>() on the class bits versus the former dynamic_pointer_cast on shared_from_this(): the time per
+// frame of the usual "is<T>() then as<T>()" sequence for the former and the new implementation, and for the raw pointer accessor tryAs<T>().
+//
+// usage: ob_frame_type_cast_benchmark [iteration count]
+
+#include "frame/FrameFactory.hpp"
+#include "frame/Frame.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t DEFAULT_ITERATIONS = 10000000;
+
+// The former is<T>() followed by as<T>()
+template <typename T> std::shared_ptr<T> legacyAs(const std::shared_ptr<Frame> &frame) {
+    if(std::dynamic_pointer_cast<const T>(frame->shared_from_this()) == nullptr) {
+        return nullptr;
+    }
+    return std::dynamic_pointer_cast<T>(frame->shared_from_this());
+}
+
+template <typename Func> double nsPerFrame(uint32_t iterations, Func func) {
+    auto     begin = std::chrono::steady_clock::now();
+    uint64_t sum   = 0;
+    for(uint32_t i = 0; i < iterations; i++) {
+        sum += func(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    if(sum == 0) {
+        std::printf("(no frame matched)\n");
+    }
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    uint32_t iterations = DEFAULT_ITERATIONS;
+    if(argc > 1) {
+        iterations = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    // The frames of a pipeline: mostly video frames of different classes
+    std::vector<std::shared_ptr<Frame>> frames = { FrameFactory::createFrame(OB_FRAME_DEPTH, OB_FORMAT_Y16, 64),
+                                                   FrameFactory::createFrame(OB_FRAME_COLOR, OB_FORMAT_RGB, 64),
+                                                   FrameFactory::createFrame(OB_FRAME_IR_LEFT, OB_FORMAT_Y8, 64),
+                                                   FrameFactory::createFrame(OB_FRAME_ACCEL, OB_FORMAT_ACCEL, 64) };
+    const uint32_t mask = static_cast<uint32_t>(frames.size() - 1);
+
+    std::printf("\n%-36s %s\n", "cast to VideoFrame", "ns/frame");
+    double legacyNs = nsPerFrame(iterations, [&](uint32_t i) {
+        auto video = legacyAs<VideoFrame>(frames[i & mask]);
+        return video ? video->getDataSize() : 0;
+    });
+    std::printf("%-36s %.2f\n", "dynamic_pointer_cast (former)", legacyNs);
+    double asNs = nsPerFrame(iterations, [&](uint32_t i) {
+        auto &frame = frames[i & mask];
+        if(!frame->is<VideoFrame>()) {
+            return static_cast<size_t>(0);
+        }
+        return frame->as<VideoFrame>()->getDataSize();
+    });
+    std::printf("%-36s %.2f\n", "is<T>() + as<T>() on class bits", asNs);
+    double tryAsNs = nsPerFrame(iterations, [&](uint32_t i) {
+        auto video = frames[i & mask]->tryAs<VideoFrame>();
+        return video ? video->getDataSize() : 0;
+    });
+    std::printf("%-36s %.2f\n", "tryAs<T>() raw pointer", tryAsNs);
+    return 0;
+}
@@ -0,0 +1,161 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Micro benchmark of the per-sample versus batched delivery of the IMU samples (ImuStreamer). A fake data stream port plays the device and
+// hands HID packets of accel and gyro samples to the streamer, which either delivers one accel and one gyro frame per sample or one
+// ImuBatchFrame per packet and stream. The CPU time per 1000 samples of both paths is reported for a few packet sizes.
+//
+// usage: ob_imu_batch_benchmark [sample count]
+
+#include "ImuStreamer.hpp"
+#include "stream/StreamProfileFactory.hpp"
+#include "frame/Frame.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t DEFAULT_SAMPLE_COUNT = 200000;
+const uint32_t LEADING_SAMPLES      = 8;  // discarded by the streamer at start
+
+class FakeImuPort : public IDataStreamPort {
+public:
+    std::shared_ptr<const SourcePortInfo> getSourcePortInfo() const override {
+        return nullptr;
+    }
+
+    void startStream(MutableFrameCallback callback) override {
+        callback_ = callback;
+    }
+
+    void stopStream() override {
+        callback_ = nullptr;
+    }
+
+    void push(std::shared_ptr<Frame> packet) {
+        if(callback_) {
+            callback_(packet);
+        }
+    }
+
+private:
+    MutableFrameCallback callback_;
+};
+
+// HID packet of sampleCount samples, wrapped in a frame as the data stream port delivers it
+class Packet {
+public:
+    explicit Packet(uint32_t sampleCount) : buffer_(sizeof(OBImuHeader) + sampleCount * sizeof(OBImuOriginData)) {
+        auto header        = reinterpret_cast<OBImuHeader *>(buffer_.data());
+        header->reportId   = 1;
+        header->sampleRate = OB_SAMPLE_RATE_1_KHZ;
+        header->groupLen   = sizeof(OBImuOriginData);
+        header->groupCount = static_cast<uint8_t>(sampleCount);
+        frame_             = std::make_shared<Frame>(buffer_.data(), buffer_.size(), []() {});  // the buffer belongs to the packet
+        frame_->setDataSize(buffer_.size());
+        fill(0);
+    }
+
+    void fill(uint64_t firstTimestamp) {
+        auto header  = reinterpret_cast<OBImuHeader *>(buffer_.data());
+        auto samples = reinterpret_cast<OBImuOriginData *>(buffer_.data() + sizeof(OBImuHeader));
+        for(int i = 0; i < header->groupCount; i++) {
+            auto    &sample     = samples[i];
+            uint64_t ts         = firstTimestamp + i * 1000;
+            sample.groupId      = static_cast<int16_t>(i);
+            sample.accelX       = static_cast<int16_t>(100 + i);
+            sample.accelY       = static_cast<int16_t>(-200 - i);
+            sample.accelZ       = static_cast<int16_t>(16384 - i);
+            sample.gyroX        = static_cast<int16_t>(30 * i);
+            sample.gyroY        = static_cast<int16_t>(-40 * i);
+            sample.gyroZ        = static_cast<int16_t>(5 + i);
+            sample.temperature  = static_cast<int16_t>(1000 + i);
+            sample.timestamp[0] = static_cast<uint32_t>(ts);
+            sample.timestamp[1] = static_cast<uint32_t>(ts >> 32);
+        }
+    }
+
+    std::shared_ptr<Frame> frame() const {
+        return frame_;
+    }
+
+private:
+    std::vector<uint8_t>   buffer_;
+    std::shared_ptr<Frame> frame_;
+};
+
+struct Streamer {
+    std::shared_ptr<FakeImuPort>              port;
+    std::shared_ptr<ImuStreamer>              streamer;
+    std::shared_ptr<const AccelStreamProfile> accelProfile;
+    std::shared_ptr<const GyroStreamProfile>  gyroProfile;
+
+    explicit Streamer(bool batched, MutableFrameCallback callback) : port(std::make_shared<FakeImuPort>()) {
+        std::vector<std::shared_ptr<IFilter>> filters;
+        streamer     = std::make_shared<ImuStreamer>(nullptr, port, filters);
+        accelProfile = StreamProfileFactory::createAccelStreamProfile(OB_ACCEL_FS_4g, OB_SAMPLE_RATE_1_KHZ);
+        gyroProfile  = StreamProfileFactory::createGyroStreamProfile(OB_GYRO_FS_1000dps, OB_SAMPLE_RATE_1_KHZ);
+        if(batched) {
+            streamer->startBatchStream(accelProfile, callback);
+            streamer->startBatchStream(gyroProfile, callback);
+        }
+        else {
+            streamer->startStream(accelProfile, callback);
+            streamer->startStream(gyroProfile, callback);
+        }
+
+        // the first samples are discarded
+        Packet leading(LEADING_SAMPLES);
+        port->push(leading.frame());
+    }
+
+    ~Streamer() {
+        streamer->stopStream(accelProfile);
+        streamer->stopStream(gyroProfile);
+    }
+};
+
+// CPU time of the streamer thread (here: the caller) per 1000 samples, in microseconds
+double measure(bool batched, uint32_t samplesPerPacket, uint32_t packetCount, uint64_t &frameCount) {
+    frameCount = 0;
+    Streamer streamer(batched, [&](std::shared_ptr<Frame> frame) {
+        frameCount++;
+        (void)frame;
+    });
+    Packet packet(samplesPerPacket);
+
+    std::clock_t begin = std::clock();
+    for(uint32_t i = 0; i < packetCount; i++) {
+        streamer.port->push(packet.frame());
+    }
+    std::clock_t end = std::clock();
+
+    double cpuUs = static_cast<double>(end - begin) * 1000000.0 / CLOCKS_PER_SEC;
+    return cpuUs * 1000.0 / (static_cast<double>(samplesPerPacket) * packetCount);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    uint32_t sampleCount = DEFAULT_SAMPLE_COUNT;
+    if(argc > 1) {
+        sampleCount = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    std::printf("%-18s %-24s %-24s %s\n", "samples/packet", "per-sample us/1000", "batched us/1000", "frames (per-sample/batched)");
+    const uint32_t samplesPerPacket[] = { 1, 8, 32, 128 };
+    for(auto count: samplesPerPacket) {
+        uint64_t perSampleFrames = 0, batchedFrames = 0;
+        uint32_t packetCount     = sampleCount / count + 1;
+        double   perSampleUs     = measure(false, count, packetCount, perSampleFrames);
+        double   batchedUs       = measure(true, count, packetCount, batchedFrames);
+        std::printf("%-18u %-24.1f %-24.1f %llu/%llu\n", count, perSampleUs, batchedUs, static_cast<unsigned long long>(perSampleFrames),
+                    static_cast<unsigned long long>(batchedFrames));
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Micro benchmark of the fused per-pixel depth post-processing (PixelOpProgram run by FilterChain): the time per frame of threshold, pixel
+// value scale and offset and mirror filters called one after the other and fused in one pass.
+//
+// usage: ob_pixel_op_fusion_benchmark [iteration count]
+
+#include "FilterChain.hpp"
+#include "FilterDecorator.hpp"
+#include "publicfilters/FramePixelValueProcess.hpp"
+#include "publicfilters/FrameGeometricTransform.hpp"
+#include "frame/FrameFactory.hpp"
+#include "stream/StreamProfileFactory.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t DEFAULT_ITERATIONS = 200;
+
+template <typename T> std::shared_ptr<IFilter> createFilter(const char *name) {
+    auto filter = std::make_shared<FilterDecorator>(name, std::make_shared<T>());
+    filter->enable(true);
+    return filter;
+}
+
+std::shared_ptr<Frame> createDepthFrame(uint32_t width, uint32_t height) {
+    auto frame   = FrameFactory::createVideoFrame(OB_FRAME_DEPTH, OB_FORMAT_Y16, width, height, 0);
+    auto profile = StreamProfileFactory::createVideoStreamProfile(OB_STREAM_DEPTH, OB_FORMAT_Y16, width, height, 30);
+    profile->bindIntrinsic({ 500.0f, 500.0f, width / 2.0f, height / 2.0f, static_cast<int16_t>(width), static_cast<int16_t>(height) });
+    frame->setStreamProfile(profile);
+    frame->as<DepthFrame>()->setValueScale(1.0f);
+
+    auto     data = reinterpret_cast<uint16_t *>(frame->getDataMutable());
+    uint32_t seed = width * 7919 + height;
+    for(uint32_t i = 0; i < width * height; i++) {
+        seed    = seed * 1103515245 + 12345;
+        data[i] = static_cast<uint16_t>((seed >> 8) % 16000);
+    }
+    return frame;
+}
+
+std::shared_ptr<Frame> processOneByOne(const std::vector<std::shared_ptr<IFilter>> &filters, std::shared_ptr<const Frame> frame) {
+    std::shared_ptr<Frame> result = std::const_pointer_cast<Frame>(frame);
+    for(const auto &filter: filters) {
+        if(filter->isEnabled()) {
+            result = filter->process(result);
+        }
+    }
+    return result;
+}
+
+struct Chain {
+    std::shared_ptr<IFilter>              threshold;
+    std::shared_ptr<IFilter>              scaler;
+    std::shared_ptr<IFilter>              offset;
+    std::vector<std::shared_ptr<IFilter>> filters;
+};
+
+Chain createChain(uint32_t min, uint32_t max, double scale, int offset) {
+    Chain chain;
+    chain.threshold = createFilter<ThresholdFilter>("ThresholdFilter");
+    chain.scaler    = createFilter<PixelValueScaler>("PixelValueScaler");
+    chain.offset    = createFilter<PixelValueOffset>("PixelValueOffset");
+    chain.threshold->setConfigValueSync("min", min);
+    chain.threshold->setConfigValueSync("max", max);
+    chain.scaler->setConfigValueSync("scale", scale);
+    chain.offset->setConfigValueSync("offset", offset);
+    return chain;
+}
+
+void benchmark(uint32_t iterations) {
+    const uint32_t width  = 1280;
+    const uint32_t height = 800;
+    auto           chain  = createChain(100, 12000, 0.5, 1);
+    auto           frame  = createDepthFrame(width, height);
+    std::vector<std::shared_ptr<IFilter>> filters = { chain.threshold, chain.scaler, chain.offset, createFilter<FrameMirror>("FrameMirror") };
+
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < iterations; i++) {
+        processOneByOne(filters, frame);
+    }
+    auto oneByOne = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < iterations; i++) {
+        FilterChain::process(filters, frame);
+    }
+    auto fused = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    std::printf("%ux%u Y16 depth, threshold + scale + offset + mirror, %u frames\n", width, height, iterations);
+    std::printf("  filters one by one: %8.1f us/frame\n", oneByOne);
+    std::printf("  fused chain:        %8.1f us/frame (x%.2f)\n", fused, oneByOne / fused);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    uint32_t iterations = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : DEFAULT_ITERATIONS;
+    if(iterations == 0) {
+        iterations = DEFAULT_ITERATIONS;
+    }
+
+    benchmark(iterations);
+    return 0;
+}
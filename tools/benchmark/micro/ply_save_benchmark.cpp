@@ -0,0 +1,194 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Micro benchmark of the PLY export of point cloud frames: the time per save and the throughput of the streaming writer of PointCloudSaveUtil
+// and of the std::ofstream writer it replaced (copied below), for depth and RGBD point clouds.
+//
+// usage: ob_ply_save_benchmark [point count] [output directory]
+
+#include "utils/PointCloudSaveUtil.hpp"
+#include "frame/FrameFactory.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace libobsensor;
+
+namespace {
+
+const uint32_t DEFAULT_POINT_COUNT = 1280 * 800;
+const uint32_t POINTS_WIDTH        = 1280;
+const int      SAVE_REPEAT         = 3;
+
+// Deterministic pseudo random input, a failure always reproduces
+uint32_t nextRandom(uint32_t &state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// Dense point cloud (one point per pixel) with 20% zero points, coordinates in millimeters
+std::shared_ptr<Frame> makePointsFrame(bool color, uint32_t pointCount) {
+    uint32_t width  = POINTS_WIDTH;
+    uint32_t height = (pointCount + width - 1) / width;
+    size_t   floats = color ? 6 : 3;
+    auto     frame  = FrameFactory::createFrame(OB_FRAME_POINTS, color ? OB_FORMAT_RGB_POINT : OB_FORMAT_POINT, width * height * floats * sizeof(float));
+    frame->as<PointsFrame>()->setWidth(width);
+    frame->as<PointsFrame>()->setHeight(height);
+
+    uint32_t seed   = 5;
+    float   *values = reinterpret_cast<float *>(const_cast<uint8_t *>(frame->getData()));
+    for(size_t i = 0; i < static_cast<size_t>(width) * height; i++) {
+        float   *pt  = values + i * floats;
+        uint32_t rnd = nextRandom(seed);
+        if(rnd % 5 == 0) {
+            memset(pt, 0, floats * sizeof(float));
+            continue;
+        }
+        pt[2] = 300.0f + static_cast<float>(rnd % 9000) * 0.37f;
+        pt[0] = (static_cast<float>(i % width) - width * 0.5f) * pt[2] / 600.0f;
+        pt[1] = (static_cast<float>(i / width) - height * 0.5f) * pt[2] / 600.0f;
+        if(color) {
+            pt[3] = static_cast<float>(rnd & 0xFF);
+            pt[4] = static_cast<float>((rnd >> 8) & 0xFF);
+            pt[5] = static_cast<float>((rnd >> 16) & 0xFF);
+        }
+    }
+    return frame;
+}
+
+// The non-mesh path of PointCloudSaveUtil::savePointCloudToPly before the streaming writer: the valid points are copied to a vertex vector,
+// then written with std::ofstream
+struct LegacyVertex {
+    float   x, y, z;
+    uint8_t color[3];
+};
+
+bool legacySavePointCloudToPly(const char *fileName, std::shared_ptr<Frame> frame, bool saveBinary) {
+    auto pointCloudFrame = frame->as<PointsFrame>();
+    bool colorPointCloud = pointCloudFrame->getFormat() == OB_FORMAT_RGB_POINT;
+    auto width           = pointCloudFrame->getWidth();
+    auto height          = pointCloudFrame->getHeight();
+
+    std::vector<LegacyVertex> vertices;
+    vertices.reserve(static_cast<size_t>(width) * height);
+    const float *values = reinterpret_cast<const float *>(pointCloudFrame->getData());
+    size_t       floats = colorPointCloud ? 6 : 3;
+    for(size_t i = 0; i < static_cast<size_t>(width) * height; i++) {
+        const float *pt = values + i * floats;
+        if(std::fabs(pt[2]) >= 1e-6f) {
+            LegacyVertex vertex = { pt[0], pt[1], pt[2], { 0, 0, 0 } };
+            if(colorPointCloud) {
+                vertex.color[0] = static_cast<uint8_t>(pt[3]);
+                vertex.color[1] = static_cast<uint8_t>(pt[4]);
+                vertex.color[2] = static_cast<uint8_t>(pt[5]);
+            }
+            vertices.push_back(vertex);
+        }
+    }
+
+    std::ofstream plyOut(fileName);
+    if(!plyOut) {
+        return false;
+    }
+    plyOut << "ply\n";
+    plyOut << (saveBinary ? "format binary_little_endian 1.0\n" : "format ascii 1.0\n");
+    plyOut << "comment Generated by mesh generation code\n";
+    plyOut << "element vertex " << vertices.size() << "\n";
+    plyOut << "property float x\n";
+    plyOut << "property float y\n";
+    plyOut << "property float z\n";
+    if(colorPointCloud) {
+        plyOut << "property uchar red\n";
+        plyOut << "property uchar green\n";
+        plyOut << "property uchar blue\n";
+    }
+    plyOut << "end_header\n";
+
+    if(saveBinary) {
+        plyOut.close();
+        plyOut.open(fileName, std::ios_base::app | std::ios_base::binary);
+        for(const auto &vertex: vertices) {
+            plyOut.write(reinterpret_cast<const char *>(&vertex.x), sizeof(float));
+            plyOut.write(reinterpret_cast<const char *>(&vertex.y), sizeof(float));
+            plyOut.write(reinterpret_cast<const char *>(&vertex.z), sizeof(float));
+            if(colorPointCloud) {
+                plyOut.write(reinterpret_cast<const char *>(vertex.color), 3);
+            }
+        }
+    }
+    else {
+        for(const auto &vertex: vertices) {
+            plyOut << vertex.x << " " << vertex.y << " " << vertex.z << "\n";
+            if(colorPointCloud) {
+                plyOut << static_cast<int>(vertex.color[0]) << " " << static_cast<int>(vertex.color[1]) << " " << static_cast<int>(vertex.color[2])
+                       << "\n";
+            }
+        }
+    }
+    return true;
+}
+
+// Wall time per save in milliseconds (the writes are part of the cost) and the size of the file
+double measure(const std::string &fileName, const std::function<bool()> &save, size_t &fileSize) {
+    auto begin = std::chrono::steady_clock::now();
+    for(int i = 0; i < SAVE_REPEAT; i++) {
+        if(!save()) {
+            std::printf("save to %s failed\n", fileName.c_str());
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::ifstream in(fileName, std::ios_base::binary | std::ios_base::ate);
+    fileSize = static_cast<size_t>(in.tellg());
+    std::remove(fileName.c_str());
+    return std::chrono::duration<double, std::milli>(end - begin).count() / SAVE_REPEAT;
+}
+
+void benchmark(const std::string &dir, bool color, uint32_t pointCount) {
+    auto        frame    = makePointsFrame(color, pointCount);
+    std::string fileName = dir + "/ply_save_benchmark.ply";
+    const char *file     = fileName.c_str();
+
+    struct {
+        const char           *name;
+        std::function<bool()> save;
+    } paths[] = {
+        { "ofstream ascii", [&]() { return legacySavePointCloudToPly(file, frame, false); } },
+        { "ofstream binary", [&]() { return legacySavePointCloudToPly(file, frame, true); } },
+        { "stream ascii", [&]() { return PointCloudSaveUtil::streamPointCloudToPly(file, frame, PLY_ENCODING_ASCII); } },
+        { "stream binary", [&]() { return PointCloudSaveUtil::streamPointCloudToPly(file, frame, PLY_ENCODING_BINARY); } },
+        { "stream quantized", [&]() { return PointCloudSaveUtil::streamPointCloudToPly(file, frame, PLY_ENCODING_BINARY_QUANTIZED, 1.0f); } },
+    };
+
+    std::printf("\n%s, %u points\n%-20s %-12s %-12s %s\n", color ? "rgbd" : "depth", pointCount, "path", "ms/save", "MB/s", "file MB");
+    for(const auto &path: paths) {
+        size_t fileSize = 0;
+        double ms       = measure(fileName, path.save, fileSize);
+        double mb       = fileSize / (1024.0 * 1024.0);
+        std::printf("%-20s %-12.1f %-12.1f %.1f\n", path.name, ms, mb * 1000.0 / ms, mb);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    uint32_t    pointCount = DEFAULT_POINT_COUNT;
+    std::string dir        = ".";
+    if(argc > 1) {
+        pointCount = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+    if(argc > 2) {
+        dir = argv[2];
+    }
+
+    benchmark(dir, false, pointCount);
+    benchmark(dir, true, pointCount);
+    return 0;
+}